@@ -165,6 +165,19 @@ macro(pism_find_prerequisites)
     pism_find_library(PROJ "proj>=6.0")
   endif()
 
+  if (Pism_USE_FFTW_MPI)
+    # FFTW's MPI interface does not come with pkg-config metadata: look for it next to
+    # the serial FFTW library found above.
+    find_library (FFTW_MPI_LIBRARY NAMES fftw3_mpi HINTS ${FFTW_LIBRARY_DIRS})
+    find_path (FFTW_MPI_INCLUDE_DIR NAMES fftw3-mpi.h HINTS ${FFTW_INCLUDE_DIRS})
+
+    if (NOT FFTW_MPI_LIBRARY OR NOT FFTW_MPI_INCLUDE_DIR)
+      message (FATAL_ERROR "Failed to find FFTW's MPI library (fftw3_mpi)")
+    endif()
+
+    mark_as_advanced (FFTW_MPI_LIBRARY FFTW_MPI_INCLUDE_DIR)
+  endif()
+
   if (Pism_USE_YAC)
     if (NOT Pism_USE_PROJ)
       message(FATAL_ERROR "Please build PISM with PROJ to use YAC for interpolation")
@@ -196,6 +209,10 @@ macro(pism_set_dependencies)
     include_directories (BEFORE SYSTEM ${PNETCDF_INCLUDE_DIRS})
   endif()
 
+  if (Pism_USE_FFTW_MPI)
+    include_directories (BEFORE SYSTEM ${FFTW_MPI_INCLUDE_DIR})
+  endif()
+
   # Hide distracting CMake variables
   mark_as_advanced(file_cmd MPI_LIBRARY MPI_EXTRA_LIBRARY
     CMAKE_OSX_ARCHITECTURES CMAKE_OSX_DEPLOYMENT_TARGET CMAKE_OSX_SYSROOT
@@ -99,8 +99,6 @@ def randVectorS(grid, scale, stencil_width=None):
       :param scale: Standard deviation of normal distribution.
       :param stencil_width: Ghost stencil width for the vector. Use ``None`` to indicate
                             an unghosted vector.
-
-    This function is not efficiently implemented.
     """
 
     if stencil_width is None:
@@ -110,13 +108,9 @@ def randVectorS(grid, scale, stencil_width=None):
     elif stencil_width == 2:
         rv = PISM.Scalar2(grid, 'rand vec')
 
-    shape = (grid.xm(), grid.ym())
     import numpy as np
 
-    r = np.random.normal(scale=scale, size=rv.shape())
-    with Access(nocomm=rv):
-        for (i, j) in grid.points():
-            rv[i, j] = r[j - grid.ys(), i - grid.xs()]
+    rv.owned_part()[:] = np.random.normal(scale=scale, size=(grid.ym(), grid.xm()))
 
     if stencil_width is not None:
         rv.update_ghosts()
@@ -131,8 +125,6 @@ def randVectorV(grid, scale, stencil_width=None):
       :param scale: Standard deviation of normal distribution.
       :param stencil_width: Ghost stencil width for the vector. Use ``None`` to indicate
                             an unghosted vector.
-
-    This function is not efficiently implemented.
     """
 
     if stencil_width is None:
@@ -149,12 +141,7 @@ def randVectorV(grid, scale, stencil_width=None):
 
     import numpy as np
 
-    r_u = np.random.normal(scale=scale, size=rv.shape()[:-1])
-    r_v = np.random.normal(scale=scale, size=rv.shape()[:-1])
-    with Access(nocomm=rv):
-        for (i, j) in grid.points():
-            rv[i, j].u = r_u[j - grid.ys(), i - grid.xs()]
-            rv[i, j].v = r_v[j - grid.ys(), i - grid.xs()]
+    rv.owned_part()[:] = np.random.normal(scale=scale, size=(grid.ym(), grid.xm(), 2))
 
     if stencil_width is not None:
         rv.update_ghosts()
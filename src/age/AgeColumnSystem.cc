@@ -127,11 +127,9 @@ void AgeColumnSystem::solve(std::vector<double> &x) {
     throw;
   }
 
-  // x[k] contains age for k=0,...,ks, but set age of ice above (and
-  // at) surface to zero years
-  for (unsigned int k = m_ks + 1; k < x.size(); k++) {
-    x[k] = 0.0;
-  }
+  // x[k] contains age for k=0,...,ks; x[k] for k > ks (i.e. above the ice) is
+  // not modified: use the fine_to_coarse() overload taking an above-ice value
+  // to transfer the column
 }
 
 } // end of namespace pism
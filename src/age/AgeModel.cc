@@ -148,8 +148,9 @@ void AgeModel::update(double t, double dt, const AgeModelInputs &inputs) {
         // solve the system for this column; call checks that params set
         system.solve(x);
 
-        // put solution in array::Array3D
-        system.fine_to_coarse(x, i, j, m_work);
+        // put solution in array::Array3D (the age of the ice above the surface
+        // is zero years)
+        system.fine_to_coarse(x, i, j, system.ks(), 0.0, m_work);
 
         // Ensure that the age of the ice is non-negative.
         //
@@ -175,6 +176,17 @@ const array::Array3D & AgeModel::age() const {
   return m_ice_age;
 }
 
+//! 3D working space filled by the fused age+energy column pass.
+array::Array3D & AgeModel::work() {
+  return m_work;
+}
+
+//! @brief Complete a fused age+energy update: move the new age of the ice (computed by
+//! the energy model; see EnthalpyModel::update_impl()) into the age field.
+void AgeModel::finish_fused_update() {
+  m_ice_age.copy_from(m_work);
+}
+
 MaxTimestep AgeModel::max_timestep_impl(double /*t*/) const {
 
   if (m_stress_balance == nullptr) {
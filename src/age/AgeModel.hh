@@ -51,6 +51,12 @@ public:
   void init(const InputOptions &opts);
 
   const array::Array3D & age() const;
+
+  // These two support the fused age+energy column pass (see
+  // EnthalpyModel::update_impl() and energy::Inputs::ice_age): the energy model writes
+  // the new age into work() and finish_fused_update() moves it into the age field.
+  array::Array3D & work();
+  void finish_fused_update();
 protected:
   MaxTimestep max_timestep_impl(double t) const;
 
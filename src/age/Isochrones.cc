@@ -33,6 +33,7 @@
 #include "pism/util/array/Array3D.hh"
 #include "pism/util/array/Scalar.hh"
 #include "pism/util/Interpolation1D.hh"
+#include "pism/util/pism_utilities.hh" // GlobalMax()
 #include "pism/util/petscwrappers/Vec.hh"
 #include "pism/util/Logger.hh"
 #include "pism/util/io/LocalInterpCtx.hh"
@@ -50,6 +51,10 @@ static const char *times_parameter = "isochrones.deposition_times";
 static const char *N_max_parameter = "isochrones.max_n_layers";
 static const char *N_boot_parameter = "isochrones.bootstrapping.n_layers";
 
+static const char *merge_parameter = "isochrones.merge.enabled";
+static const char *merge_age_parameter = "isochrones.merge.min_age";
+static const char *merge_thickness_parameter = "isochrones.merge.min_thickness";
+
 
 //! Checks if a vector of doubles is not decreasing.
 static bool non_decreasing(const std::vector<double> &a) {
@@ -136,10 +141,15 @@ allocate_layer_thickness(const array::Array3D &input, double T_start,
   }
   auto N_layers_to_copy = deposition_times.size();
 
-  double last_kept_time = deposition_times.back();
-  for (auto t : requested_times) {
-    if (t > last_kept_time) {
-      deposition_times.push_back(t);
+  // If merging of thin layers is enabled, storage contains only deposited layers and is
+  // grown as the model reaches requested deposition times; otherwise allocate storage for
+  // all requested times up front.
+  if (not grid->ctx()->config()->get_flag(merge_parameter)) {
+    double last_kept_time = deposition_times.back();
+    for (auto t : requested_times) {
+      if (t > last_kept_time) {
+        deposition_times.push_back(t);
+      }
     }
   }
 
@@ -273,8 +283,9 @@ static std::shared_ptr<array::Array3D> regrid_layer_thickness(std::shared_ptr<co
   }
 
   petsc::VecArray tmp(result->vec());
+  std::vector<double> buffer;
   io::regrid_spatial_variable(metadata, *grid, lic, file,
-                              *grid->ctx()->log(),
+                              *grid->ctx()->log(), buffer,
                               tmp.get());
 
   return result;
@@ -376,8 +387,14 @@ Isochrones::Isochrones(std::shared_ptr<const Grid> grid,
   m_layer_thickness = details::allocate_layer_thickness(m_grid, { time->current() });
   m_tmp             = m_layer_thickness->duplicate(array::WITH_GHOSTS);
 
+  m_deposition_times = { time->current() };
+
   auto n_layers = details::n_active_layers(m_layer_thickness->levels(), time->start());
   m_top_layer_index = n_layers > 0 ? n_layers - 1 : 0;
+
+  m_merge_enabled       = m_config->get_flag(details::merge_parameter);
+  m_merge_min_age       = m_config->get_number(details::merge_age_parameter, "seconds");
+  m_merge_min_thickness = m_config->get_number(details::merge_thickness_parameter);
 }
 
 /*!
@@ -439,6 +456,14 @@ void Isochrones::bootstrap(const array::Scalar &ice_thickness) {
         deposition_times.push_back(t);
       }
 
+      m_deposition_times = deposition_times;
+
+      if (m_merge_enabled) {
+        // allocate storage for the bootstrapping layers only; it is grown as requested
+        // deposition times are reached
+        deposition_times.resize(N_bootstrap);
+      }
+
       // re-allocate storage
       m_layer_thickness = allocate_layer_thickness(m_grid, deposition_times);
       m_tmp             = m_layer_thickness->duplicate(array::WITH_GHOSTS);
@@ -457,7 +482,16 @@ void Isochrones::bootstrap(const array::Scalar &ice_thickness) {
       }
     } else {
 
-      m_layer_thickness = allocate_layer_thickness(m_grid, requested_times);
+      m_deposition_times = requested_times;
+
+      auto storage_times = requested_times;
+      if (m_merge_enabled) {
+        // allocate storage for the first layer only; it is grown as requested deposition
+        // times are reached
+        storage_times.resize(1);
+      }
+
+      m_layer_thickness = allocate_layer_thickness(m_grid, storage_times);
       m_tmp             = m_layer_thickness->duplicate(array::WITH_GHOSTS);
 
       array::AccessScope scope{ &ice_thickness, m_layer_thickness.get() };
@@ -472,7 +506,7 @@ void Isochrones::bootstrap(const array::Scalar &ice_thickness) {
     m_top_layer_index = n_layers > 0 ? n_layers - 1 : 0;
     {
       std::vector<std::string> dates;
-      for (auto t : m_layer_thickness->levels()) {
+      for (auto t : m_deposition_times) {
         dates.push_back(time->date(t));
       }
       m_log->message(3, "Deposition times: %s\n", join(dates, ", ").c_str());
@@ -511,8 +545,21 @@ void Isochrones::initialize(const File &input_file, int record, bool use_interpo
         tmp = read_layer_thickness(m_grid, input_file, record);
       }
 
-      m_layer_thickness =
-          allocate_layer_thickness(*tmp, time->start(), deposition_times(*m_config, *time));
+      auto requested_times = deposition_times(*m_config, *time);
+
+      m_layer_thickness = allocate_layer_thickness(*tmp, time->start(), requested_times);
+
+      // the full schedule: deposited layers we kept, then requested times that have not
+      // been reached yet
+      m_deposition_times = m_layer_thickness->levels();
+      if (m_merge_enabled) {
+        double last_kept_time = m_deposition_times.back();
+        for (auto t : requested_times) {
+          if (t > last_kept_time) {
+            m_deposition_times.push_back(t);
+          }
+        }
+      }
     }
     m_tmp = m_layer_thickness->duplicate(array::WITH_GHOSTS);
 
@@ -522,7 +569,7 @@ void Isochrones::initialize(const File &input_file, int record, bool use_interpo
 
     {
       std::vector<std::string> dates;
-      for (auto t : m_layer_thickness->levels()) {
+      for (auto t : m_deposition_times) {
         dates.push_back(time->date(t));
       }
       m_log->message(3, "Deposition times: %s\n", join(dates, ", ").c_str());
@@ -708,7 +755,7 @@ void Isochrones::update(double t, double dt, const array::Array3D &u, const arra
   // add one more layer if we reached the next deposition time
   {
     double T                     = t + dt;
-    const auto &deposition_times = m_layer_thickness->levels();
+    const auto &deposition_times = m_deposition_times;
     size_t N                     = deposition_times.size();
 
     // Find the index k such that deposition_times[k] <= T
@@ -721,15 +768,57 @@ void Isochrones::update(double t, double dt, const array::Array3D &u, const arra
 
     double T_k = deposition_times[k];
 
-    double top_layer_deposition_time = deposition_times.at(m_top_layer_index);
+    double top_layer_deposition_time = m_layer_thickness->levels().at(m_top_layer_index);
     if (T_k > top_layer_deposition_time) {
       // we reached the next requested deposition time
 
-      if (m_top_layer_index < N - 1) {
+      const auto &time = m_grid->ctx()->time();
+
+      if (m_merge_enabled) {
+        // Storage contains only deposited layers: merge thin old layers, then grow
+        // storage to start the new layer.
+        merge_thin_layers(T);
+
+        auto N_max        = (int)m_config->get_number(details::N_max_parameter);
+        auto storage_times = m_layer_thickness->levels();
+
+        if ((int)storage_times.size() < N_max) {
+          storage_times.push_back(T_k);
+
+          auto result = details::allocate_layer_thickness(m_grid, storage_times);
+          {
+            size_t N_old = storage_times.size() - 1;
+
+            array::AccessScope scope{ m_layer_thickness.get(), result.get() };
+
+            for (auto p : m_grid->points()) {
+              const int i = p.i(), j = p.j();
+
+              const double *in = m_layer_thickness->get_column(i, j);
+              double *out      = result->get_column(i, j);
+
+              for (size_t m = 0; m < N_old; ++m) {
+                out[m] = in[m];
+              }
+              out[N_old] = 0.0;
+            }
+          }
+          m_layer_thickness = result;
+          m_tmp             = m_layer_thickness->duplicate(array::WITH_GHOSTS);
+          m_top_layer_index = storage_times.size() - 1;
+
+          m_log->message(2, "  New isochronal layer %d at %s\n", (int)m_top_layer_index,
+                         time->date(T).c_str());
+        } else {
+          // we have as many layers as we can handle: keep adding to the top layer
+          m_log->message(2,
+                         "Isochrone tracking: reached isochrones.max_n_layers and can't add more.\n"
+                         "  SMB will contribute to the current top layer.");
+        }
+      } else if (m_top_layer_index < N - 1) {
         // not too many layers yet: add one more
         m_top_layer_index += 1;
 
-        const auto &time = m_grid->ctx()->time();
         m_log->message(2, "  New isochronal layer %d at %s\n", (int)m_top_layer_index,
                        time->date(T).c_str());
       } else {
@@ -742,6 +831,94 @@ void Isochrones::update(double t, double dt, const array::Array3D &u, const arra
   }
 }
 
+/*!
+ * Merge thin "old" layers into the layers below them.
+ *
+ * A layer is merged if it was deposited at least `isochrones.merge.min_age` before the
+ * current time `T` and its thickness does not exceed `isochrones.merge.min_thickness`
+ * anywhere in the domain, i.e. if the isochrone at its bottom stays within
+ * `isochrones.merge.min_thickness` of the isochrone right above it. The bottom layer and
+ * the top (currently accumulating) layer are never merged.
+ *
+ * This bounds the number of stored layers (and so the memory footprint of isochrone
+ * tracking) in long runs.
+ */
+void Isochrones::merge_thin_layers(double T) {
+  const auto &times = m_layer_thickness->levels();
+  size_t N          = times.size();
+
+  if (m_top_layer_index < 2) {
+    return;
+  }
+
+  // compute the maximum thickness of each merge candidate over the whole domain
+  std::vector<double> max_thickness(N, 0.0);
+  {
+    std::vector<double> local_max(N, 0.0);
+
+    array::AccessScope scope{ m_layer_thickness.get() };
+
+    for (auto p : m_grid->points()) {
+      const int i = p.i(), j = p.j();
+
+      const double *H = m_layer_thickness->get_column(i, j);
+      for (size_t k = 1; k < m_top_layer_index; ++k) {
+        local_max[k] = std::max(local_max[k], H[k]);
+      }
+    }
+
+    GlobalMax(m_grid->com, local_max.data(), max_thickness.data(), (int)N);
+  }
+
+  // mark layers to merge; each merged layer goes into the nearest kept layer below it
+  std::vector<double> kept_times;
+  std::vector<size_t> destination(N);
+  size_t n_merged = 0;
+  for (size_t k = 0; k < N; ++k) {
+    bool merge = (k > 0 and k < m_top_layer_index and
+                  times[k] <= T - m_merge_min_age and
+                  max_thickness[k] <= m_merge_min_thickness);
+
+    if (merge) {
+      destination[k] = kept_times.size() - 1;
+      n_merged += 1;
+    } else {
+      destination[k] = kept_times.size();
+      kept_times.push_back(times[k]);
+    }
+  }
+
+  if (n_merged == 0) {
+    return;
+  }
+
+  auto result = details::allocate_layer_thickness(m_grid, kept_times);
+  {
+    array::AccessScope scope{ m_layer_thickness.get(), result.get() };
+
+    for (auto p : m_grid->points()) {
+      const int i = p.i(), j = p.j();
+
+      const double *in = m_layer_thickness->get_column(i, j);
+      double *out      = result->get_column(i, j);
+
+      for (size_t k = 0; k < kept_times.size(); ++k) {
+        out[k] = 0.0;
+      }
+      for (size_t k = 0; k < N; ++k) {
+        out[destination[k]] += in[k];
+      }
+    }
+  }
+
+  m_layer_thickness = result;
+  m_tmp             = m_layer_thickness->duplicate(array::WITH_GHOSTS);
+  m_top_layer_index -= n_merged;
+
+  m_log->message(2, "  Merged %d thin isochronal layers (%d stored layers remaining)\n",
+                 (int)n_merged, (int)kept_times.size());
+}
+
 MaxTimestep Isochrones::max_timestep_impl(double t) const {
   return std::min(max_timestep_deposition_times(t), max_timestep_cfl());
 }
@@ -763,7 +940,7 @@ MaxTimestep Isochrones::max_timestep_cfl() const {
  * We can go up to the next deposition time.
  */
 MaxTimestep Isochrones::max_timestep_deposition_times(double t) const {
-  auto deposition_times = m_layer_thickness->levels();
+  const auto &deposition_times = m_deposition_times;
 
   double t0 = deposition_times[0];
   if (t < t0) {
@@ -807,6 +984,12 @@ const array::Array3D &Isochrones::layer_thicknesses() const {
   return *m_layer_thickness;
 }
 
+//! Deposition times of all the layers this run may create (including requested times
+//! that have not been reached yet).
+const std::vector<double> &Isochrones::deposition_times() const {
+  return m_deposition_times;
+}
+
 namespace diagnostics {
 
 /*! @brief Report isochrone depth below surface, in meters */
@@ -818,7 +1001,7 @@ public:
     const auto &time = m_grid->ctx()->time();
 
     m_vars = { { m_sys, isochrone_depth_variable_name, *m_grid,
-                 model->layer_thicknesses().levels() } };
+                 model->deposition_times() } };
 
     auto description = pism::printf("depth below surface of isochrones for times in '%s'",
                                     deposition_time_variable_name);
@@ -837,11 +1020,35 @@ protected:
   std::shared_ptr<array::Array> compute_impl() const {
 
     const auto &layer_thicknesses = model->layer_thicknesses();
-
-    auto result         = layer_thicknesses.duplicate();
+    const auto &schedule          = model->deposition_times();
+    const auto &stored_times      = layer_thicknesses.levels();
+
+    // This diagnostic is defined using the full schedule of deposition times so that its
+    // size does not change during the run even if thin layers get merged (see
+    // isochrones.merge.enabled).
+    auto result = std::make_shared<array::Array3D>(m_grid, isochrone_depth_variable_name,
+                                                   array::WITHOUT_GHOSTS, schedule);
     result->metadata(0) = m_vars[0];
 
-    size_t N = result->levels().size();
+    size_t N = schedule.size();
+
+    // Map schedule entries to stored layers. Stored deposition times form a subsequence
+    // of the schedule: merging removes entries and times after the current top layer have
+    // not been reached yet. A schedule entry without a stored layer maps to -1; the
+    // corresponding isochrone coincides with the one right above it (merged layers) or
+    // with the ice surface (times that have not been reached).
+    std::vector<int> source(N, -1);
+    {
+      size_t q = 0;
+      for (size_t s = 0; s < stored_times.size(); ++s) {
+        while (q < N and schedule[q] < stored_times[s]) {
+          ++q;
+        }
+        assert(q < N);
+        source[q] = (int)s;
+        ++q;
+      }
+    }
 
     array::AccessScope scope{ &layer_thicknesses, result.get() };
 
@@ -853,7 +1060,9 @@ protected:
 
       double total_depth = 0.0;
       for (int k = (int)N - 1; k >= 0; --k) {
-        total_depth += d[k];
+        if (source[k] >= 0) {
+          total_depth += d[source[k]];
+        }
         column[k] = total_depth;
       }
     }
@@ -54,6 +54,8 @@ public:
 
   const array::Array3D& layer_thicknesses() const;
 
+  const std::vector<double>& deposition_times() const;
+
 private:
   MaxTimestep max_timestep_impl(double t) const;
 
@@ -69,6 +71,8 @@ private:
 
   void initialize(const File &input_file, int record, bool use_interpolation);
 
+  void merge_thin_layers(double T);
+
   //! isochronal layer thicknesses
   std::shared_ptr<array::Array3D> m_layer_thickness;
 
@@ -78,6 +82,20 @@ private:
   //! The index of the topmost isochronal layer.
   size_t m_top_layer_index;
 
+  //! Deposition times of all the layers this run may create: deposition times of layers
+  //! kept from an input file (or created during bootstrapping), then requested times that
+  //! have not been reached yet. If merging of thin layers is disabled this is the same as
+  //! the list of levels of m_layer_thickness.
+  std::vector<double> m_deposition_times;
+
+  //! True if the merging of thin old layers is enabled. Set using
+  //! :config:`isochrones.merge.enabled`.
+  bool m_merge_enabled;
+  //! Minimum age of a layer that may be merged into the layer below it.
+  double m_merge_min_age;
+  //! A layer may be merged if its thickness does not exceed this value anywhere.
+  double m_merge_min_thickness;
+
   std::shared_ptr<const stressbalance::StressBalance> m_stress_balance;
 };
 
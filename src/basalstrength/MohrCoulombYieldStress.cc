@@ -90,7 +90,11 @@ read-in-from-file state or with a default constant value from the config file.
 */
 MohrCoulombYieldStress::MohrCoulombYieldStress(std::shared_ptr<const Grid> grid)
   : YieldStress(grid),
-  m_till_phi(m_grid, "tillphi") {
+  m_till_phi(m_grid, "tillphi"),
+  m_water_last(m_grid, "water_input_last"),
+  m_overburden_last(m_grid, "overburden_input_last"),
+  m_phi_last(m_grid, "tillphi_input_last"),
+  m_cache_filled(false) {
 
   m_name = "Mohr-Coulomb yield stress model";
 
@@ -131,6 +135,8 @@ MohrCoulombYieldStress::MohrCoulombYieldStress(std::shared_ptr<const Grid> grid)
     m_delta->metadata()
         .long_name("minimum effective pressure on till as a fraction of overburden pressure")
         .units("1");
+
+    m_delta_last = std::make_shared<array::Scalar>(m_grid, "delta_input_last");
   }
 }
 
@@ -262,6 +268,16 @@ till.
 If `basal_yield_stress.add_transportable_water` is yes then @f$ s @f$ in the above formula
 becomes @f$ s = (W + W_{till}) / W_{till}^{max} @f$,
 that is, the water amount is the sum @f$ W+W_{till} @f$.
+
+To avoid evaluating the (relatively expensive) formula for @f$ N_{till} @f$ in cells
+where nothing changed, the effective inputs of the computation (water amount, overburden
+pressure, till friction angle, and @f$ \delta @f$ if it is a forcing) are saved in each
+cell. If all of them match the values used in the last computation -- water amount and
+overburden pressure to within the relative tolerance
+`basal_yield_stress.mohr_coulomb.update_tolerance`, the rest exactly -- the saved yield
+stress is kept. Note that the water amount compared is the one including the
+`slippery_grounding_lines` and `add_transportable_water` adjustments, so changes coming
+in through those code paths are caught as well.
  */
 void MohrCoulombYieldStress::update_impl(const YieldStressInputs &inputs,
                                          double t, double dt) {
@@ -278,7 +294,8 @@ void MohrCoulombYieldStress::update_impl(const YieldStressInputs &inputs,
   const double high_tauc  = m_config->get_number("basal_yield_stress.ice_free_bedrock"),
                W_till_max = m_config->get_number("hydrology.tillwat_max"),
                delta      = m_config->get_number("basal_yield_stress.mohr_coulomb.till_effective_fraction_overburden"),
-               tlftw      = m_config->get_number("basal_yield_stress.mohr_coulomb.till_log_factor_transportable_water");
+               tlftw      = m_config->get_number("basal_yield_stress.mohr_coulomb.till_log_factor_transportable_water"),
+               tolerance  = m_config->get_number("basal_yield_stress.mohr_coulomb.update_tolerance");
 
   MohrCoulombPointwise mc(m_config);
 
@@ -292,7 +309,8 @@ void MohrCoulombYieldStress::update_impl(const YieldStressInputs &inputs,
   const auto &sea_level      = inputs.geometry->sea_level_elevation;
 
   array::AccessScope list{&W_till, &m_till_phi, &m_basal_yield_stress, &cell_type,
-                               &bed_topography, &sea_level, &ice_thickness};
+                               &bed_topography, &sea_level, &ice_thickness,
+                               &m_water_last, &m_overburden_last, &m_phi_last};
 
   if (add_transportable_water) {
     list.add(W_subglacial);
@@ -302,13 +320,19 @@ void MohrCoulombYieldStress::update_impl(const YieldStressInputs &inputs,
     m_delta->update(t, dt);
     m_delta->average(t, dt);
     list.add(*m_delta);
+    list.add(*m_delta_last);
   }
 
+  const bool use_cache = m_cache_filled;
+
   for (auto p : m_grid->points()) {
     const int i = p.i(), j = p.j();
 
     if (cell_type.ice_free(i, j)) {
       m_basal_yield_stress(i, j) = high_tauc;  // large yield stress if ice-free
+      // an impossible (negative) water amount, so that this cell is recomputed as soon
+      // as it becomes icy again
+      m_water_last(i, j) = -1.0;
     } else { // grounded and there is some ice
 
       // user can ask that marine grounding lines get special treatment
@@ -324,10 +348,31 @@ void MohrCoulombYieldStress::update_impl(const YieldStressInputs &inputs,
 
       double P_overburden = ice_density * standard_gravity * ice_thickness(i, j);
 
-      m_basal_yield_stress(i, j) = mc.yield_stress(m_delta ? (*m_delta)(i, j) : delta,
-                                                   P_overburden, water, m_till_phi(i, j));
+      double delta_ij = m_delta ? (*m_delta)(i, j) : delta;
+
+      bool unchanged = (use_cache and
+                        m_water_last(i, j) >= 0.0 and
+                        fabs(water - m_water_last(i, j)) <= tolerance * m_water_last(i, j) and
+                        fabs(P_overburden - m_overburden_last(i, j)) <= tolerance * m_overburden_last(i, j) and
+                        m_till_phi(i, j) == m_phi_last(i, j) and
+                        (not m_delta or delta_ij == (*m_delta_last)(i, j)));
+
+      if (not unchanged) {
+        m_basal_yield_stress(i, j) = mc.yield_stress(delta_ij, P_overburden, water,
+                                                     m_till_phi(i, j));
+
+        // save the inputs this yield stress was computed from; skipped cells keep the
+        // values from their last computation, so errors do not accumulate
+        m_water_last(i, j)      = water;
+        m_overburden_last(i, j) = P_overburden;
+        m_phi_last(i, j)        = m_till_phi(i, j);
+        if (m_delta) {
+          (*m_delta_last)(i, j) = delta_ij;
+        }
+      }
     }
   }
+  m_cache_filled = true;
 
   m_basal_yield_stress.update_ghosts();
 }
@@ -50,6 +50,15 @@ protected:
 
   std::shared_ptr<array::Forcing> m_delta;
 private:
+  //! Till water amount, overburden pressure, and till friction angle used in the last
+  //! yield stress computation; update_impl() skips cells whose inputs did not change.
+  array::Scalar m_water_last, m_overburden_last, m_phi_last;
+  //! Same, for the space- and time-dependent `delta` (allocated only if that forcing
+  //! is in use).
+  std::shared_ptr<array::Scalar> m_delta_last;
+  //! True if the caches above hold values from a completed update.
+  bool m_cache_filled;
+
   void till_friction_angle(const array::Scalar &bed_topography,
                            array::Scalar &result);
 
@@ -235,28 +235,38 @@ void OptTillphiYieldStress::update_tillphi(const array::Scalar &ice_surface_elev
   array::AccessScope list
     { &m_till_phi, &m_usurf_target, &m_usurf_difference, &m_mask, &ice_surface_elevation, &bed_topography, &cell_type };
 
-  m_mask.set(0.0);
-
   double slope = (m_phi0_max - m_phi0_min) / (m_topg_max - m_topg_min);
 
+  // The lower bound of the till friction angle (the value for "b > topg_max" is
+  // m_phi0_max). Evaluated only at locations that are actually adjusted: most cells fail
+  // the convergence test below and do not need it.
+  auto phi0 = [&](double b) {
+    if (b <= m_topg_min) {
+      return m_phi0_min;
+    }
+    if (b <= m_topg_max) {
+      return m_phi0_min + (b - m_topg_min) * slope;
+    }
+    return m_phi0_max;
+  };
+
+  // The convergence threshold m_dhdt_min expressed as a change of the surface elevation
+  // mismatch over one update interval (avoids a division per cell):
+  double dh_min = m_dhdt_min * m_update_interval;
+
+  // Note: the mask is cleared as a part of the loop below (it visits every owned cell)
+  // instead of a separate pass over the array.
   for (auto p : m_grid->points()) {
     const int i = p.i(), j = p.j();
 
-    // Compute the lower bound of the till friction angle (default value corresponds
-    // to "bed_topography(i, j) > topg_max"):
-    double phi0 = m_phi0_max;
-    if (bed_topography(i, j) <= m_topg_min) {
-      phi0 = m_phi0_min;
-    } else if (bed_topography(i, j) <= m_topg_max) {
-      phi0 = m_phi0_min + (bed_topography(i, j) - m_topg_min) * slope;
-    }
+    m_mask(i, j) = 0.0;
 
     if (cell_type.grounded_ice(i, j)) {
       double dh_previous       = m_usurf_difference(i, j);
       m_usurf_difference(i, j) = m_usurf_target(i, j) - ice_surface_elevation(i, j);
       double dh_change         = std::abs(m_usurf_difference(i, j) - dh_previous);
 
-      if (dh_change / m_update_interval > m_dhdt_min) {
+      if (dh_change > dh_min) {
         // Update tillphi if the rate of change of the surface elevation mismatch since
         // the last iteration is greater than the convergence threshold m_dhdt_min.
 
@@ -269,12 +279,12 @@ void OptTillphiYieldStress::update_tillphi(const array::Scalar &ice_surface_elev
 
         // Update (and clip) the till friction angle:
         m_till_phi(i, j) += dphi;
-        m_till_phi(i, j) = pism::clip(m_till_phi(i, j), phi0, m_phi_max);
+        m_till_phi(i, j) = pism::clip(m_till_phi(i, j), phi0(bed_topography(i, j)), m_phi_max);
       }
     } else if (cell_type.ocean(i, j)) {
       // Floating and ice free ocean: use the bed-elevation-dependent lower bound of
       // tillphi:
-      m_till_phi(i, j) = phi0;
+      m_till_phi(i, j) = phi0(bed_topography(i, j));
     }
   } // end of the loop over grid points
 }
@@ -68,6 +68,42 @@ void IceBasalResistancePlasticLaw::drag_with_derivative(double tauc, double vx,
   }
 }
 
+//! Compute the drag coefficient at `n` points at once.
+/*!
+  Equivalent to calling drag() in a loop, but avoids the per-point virtual dispatch and
+  hoists velocity-independent factors out of the loop, leaving a tight loop over
+  contiguous spans that the compiler can vectorize. Used in stress balance assembly, where
+  coefficients at the quadrature points of an element (or an element face) are stored
+  contiguously.
+ */
+void IceBasalResistancePlasticLaw::drag_n(const double *tauc, const Vector2d *velocity,
+                                          unsigned int n, double *beta) const {
+  const double eps2 = square(m_plastic_regularize);
+
+  for (unsigned int k = 0; k < n; ++k) {
+    beta[k] = tauc[k] / sqrt(eps2 + square(velocity[k].u) + square(velocity[k].v));
+  }
+}
+
+//! Compute the drag coefficient and its derivative at `n` points at once.
+/*!
+  The batch version of drag_with_derivative(); see drag_n(). Unlike the pointwise
+  version, both output arrays are required.
+ */
+void IceBasalResistancePlasticLaw::drag_with_derivative_n(const double *tauc,
+                                                          const Vector2d *velocity,
+                                                          unsigned int n, double *beta,
+                                                          double *dbeta) const {
+  const double eps2 = square(m_plastic_regularize);
+
+  for (unsigned int k = 0; k < n; ++k) {
+    const double magreg2 = eps2 + square(velocity[k].u) + square(velocity[k].v);
+
+    beta[k]  = tauc[k] / sqrt(magreg2);
+    dbeta[k] = -1 * beta[k] / magreg2;
+  }
+}
+
 /* Pseudo-plastic */
 
 IceBasalResistancePseudoPlasticLaw::IceBasalResistancePseudoPlasticLaw(const Config &config)
@@ -189,6 +225,48 @@ void IceBasalResistancePseudoPlasticLaw::drag_with_derivative(double tauc, doubl
 
 }
 
+//! Compute the drag coefficient at `n` points at once. See drag_n() in the base class.
+void IceBasalResistancePseudoPlasticLaw::drag_n(const double *tauc, const Vector2d *velocity,
+                                                unsigned int n, double *beta) const {
+  const double
+    eps2     = square(m_plastic_regularize),
+    exponent = 0.5 * (m_q - 1);
+
+  double C = m_u_threshold_factor;
+  if (m_sliding_scale_factor_reduces_tauc > 0.0) {
+    C /= pow(m_sliding_scale_factor_reduces_tauc, m_q);
+  }
+
+  for (unsigned int k = 0; k < n; ++k) {
+    const double magreg2 = eps2 + square(velocity[k].u) + square(velocity[k].v);
+
+    beta[k] = C * tauc[k] * pow(magreg2, exponent);
+  }
+}
+
+//! Compute the drag coefficient and its derivative at `n` points at once. See
+//! drag_with_derivative_n() in the base class.
+void IceBasalResistancePseudoPlasticLaw::drag_with_derivative_n(const double *tauc,
+                                                                const Vector2d *velocity,
+                                                                unsigned int n, double *beta,
+                                                                double *dbeta) const {
+  const double
+    eps2     = square(m_plastic_regularize),
+    exponent = 0.5 * (m_q - 1);
+
+  double C = m_u_threshold_factor;
+  if (m_sliding_scale_factor_reduces_tauc > 0.0) {
+    C /= pow(m_sliding_scale_factor_reduces_tauc, m_q);
+  }
+
+  for (unsigned int k = 0; k < n; ++k) {
+    const double magreg2 = eps2 + square(velocity[k].u) + square(velocity[k].v);
+
+    beta[k]  = C * tauc[k] * pow(magreg2, exponent);
+    dbeta[k] = (m_q - 1) * beta[k] / magreg2;
+  }
+}
+
 /* Regularized Coulomb */
 
 IceBasalResistanceRegularizedLaw::IceBasalResistanceRegularizedLaw(const Config &config)
@@ -247,5 +325,45 @@ void IceBasalResistanceRegularizedLaw::drag_with_derivative(double tauc, double
   }
 }
 
+//! Compute the drag coefficient at `n` points at once. See drag_n() in the base class.
+void IceBasalResistanceRegularizedLaw::drag_n(const double *tauc, const Vector2d *velocity,
+                                              unsigned int n, double *beta) const {
+  const double eps2 = square(m_plastic_regularize);
+
+  double C = 1.0;
+  if (m_sliding_scale_factor_reduces_tauc > 0.0) {
+    C /= pow(m_sliding_scale_factor_reduces_tauc, m_q);
+  }
+
+  for (unsigned int k = 0; k < n; ++k) {
+    const double magreg2sqr = sqrt(eps2 + square(velocity[k].u) + square(velocity[k].v));
+
+    beta[k] = C * tauc[k] * pow(magreg2sqr, (m_q - 1)) * pow((magreg2sqr + m_u_threshold), -m_q);
+  }
+}
+
+//! Compute the drag coefficient and its derivative at `n` points at once. See
+//! drag_with_derivative_n() in the base class.
+void IceBasalResistanceRegularizedLaw::drag_with_derivative_n(const double *tauc,
+                                                              const Vector2d *velocity,
+                                                              unsigned int n, double *beta,
+                                                              double *dbeta) const {
+  const double eps2 = square(m_plastic_regularize);
+
+  double C = 1.0;
+  if (m_sliding_scale_factor_reduces_tauc > 0.0) {
+    C /= pow(m_sliding_scale_factor_reduces_tauc, m_q);
+  }
+
+  for (unsigned int k = 0; k < n; ++k) {
+    const double
+      magreg2    = eps2 + square(velocity[k].u) + square(velocity[k].v),
+      magreg2sqr = sqrt(magreg2);
+
+    beta[k]  = C * tauc[k] * pow(magreg2sqr, (m_q - 1)) * pow((magreg2sqr + m_u_threshold), -m_q);
+    dbeta[k] = (((m_q - 1) / magreg2) - (m_q / (magreg2sqr * (magreg2sqr + m_u_threshold)))) * beta[k];
+  }
+}
+
 
 } // end of namespace pism
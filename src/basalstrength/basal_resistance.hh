@@ -20,6 +20,7 @@
 #define __basal_resistance_hh
 
 #include "pism/util/Units.hh"
+#include "pism/util/Vector2d.hh"
 
 namespace pism {
 
@@ -39,6 +40,10 @@ public:
   virtual double drag(double tauc, double vx, double vy) const;
   virtual void drag_with_derivative(double tauc, double vx, double vy,
                                     double *drag, double *ddrag) const;
+  virtual void drag_n(const double *tauc, const Vector2d *velocity, unsigned int n,
+                      double *drag) const;
+  virtual void drag_with_derivative_n(const double *tauc, const Vector2d *velocity, unsigned int n,
+                                      double *drag, double *ddrag) const;
 protected:
   double m_plastic_regularize;
 };
@@ -51,6 +56,10 @@ public:
   virtual double drag(double tauc, double vx, double vy) const;
   virtual void drag_with_derivative(double tauc, double vx, double vy,
                                     double *drag, double *ddrag) const;
+  virtual void drag_n(const double *tauc, const Vector2d *velocity, unsigned int n,
+                      double *drag) const;
+  virtual void drag_with_derivative_n(const double *tauc, const Vector2d *velocity, unsigned int n,
+                                      double *drag, double *ddrag) const;
 protected:
   double m_q, m_u_threshold, m_sliding_scale_factor_reduces_tauc, m_u_threshold_factor;
 };
@@ -63,6 +72,10 @@ public:
   virtual double drag(double tauc, double vx, double vy) const;
   virtual void drag_with_derivative(double tauc, double vx, double vy,
                                     double *drag, double *ddrag) const;
+  virtual void drag_n(const double *tauc, const Vector2d *velocity, unsigned int n,
+                      double *drag) const;
+  virtual void drag_with_derivative_n(const double *tauc, const Vector2d *velocity, unsigned int n,
+                                      double *drag, double *ddrag) const;
 protected:
   double m_q, m_u_threshold, m_sliding_scale_factor_reduces_tauc;
 };
@@ -69,6 +69,7 @@ protected:
   virtual void write_state_impl(const OutputFile &output) const;
 
   virtual MaxTimestep max_timestep_impl(double my_t) const;
+  virtual void prefetch_impl(double t, double dt) const;
 
   virtual const array::Scalar& precipitation_impl() const;
   virtual const array::Scalar& air_temperature_impl() const;
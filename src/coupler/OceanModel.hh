@@ -63,6 +63,7 @@ protected:
   // provides default (pass-through) implementations for "modifiers"
   virtual void update_impl(const Inputs &inputs, double t, double dt);
   virtual MaxTimestep max_timestep_impl(double t) const;
+  virtual void prefetch_impl(double t, double dt) const;
 
   virtual std::set<VariableMetadata> state_impl() const;
   virtual void write_state_impl(const OutputFile &output) const;
@@ -79,6 +79,7 @@ protected:
   virtual void write_state_impl(const OutputFile &output) const;
 
   virtual MaxTimestep max_timestep_impl(double my_t) const;
+  virtual void prefetch_impl(double t, double dt) const;
 
   virtual DiagnosticList spatial_diagnostics_impl() const;
   virtual TSDiagnosticList scalar_diagnostics_impl() const;
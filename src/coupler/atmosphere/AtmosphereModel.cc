@@ -198,6 +198,12 @@ MaxTimestep AtmosphereModel::max_timestep_impl(double my_t) const {
   return MaxTimestep("atmosphere model");
 }
 
+void AtmosphereModel::prefetch_impl(double t, double dt) const {
+  if (m_input_model) {
+    m_input_model->prefetch(t, dt);
+  }
+}
+
 DiagnosticList AtmosphereModel::spatial_diagnostics_impl() const {
   using namespace diagnostics;
 
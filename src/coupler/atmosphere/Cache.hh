@@ -0,0 +1,59 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef PISM_ATMOSPHERE_CACHE_H
+#define PISM_ATMOSPHERE_CACHE_H
+
+#include "pism/coupler/AtmosphereModel.hh"
+#include "pism/coupler/util/caching.hh"
+
+namespace pism {
+namespace atmosphere {
+
+//! Update an expensive atmosphere model on a coarse cadence, serving cached fields in
+//! between.
+/*!
+ * The pointwise time-series interface (begin_pointwise_access(), temp_time_series(),
+ * etc) is passed through to the input model, so time series sample the input model's
+ * state as of its most recent (coarse cadence) update.
+ */
+class Cache : public AtmosphereModel {
+public:
+  Cache(std::shared_ptr<const Grid> g, std::shared_ptr<AtmosphereModel> in);
+  virtual ~Cache() = default;
+
+private:
+  void init_impl(const Geometry &geometry);
+  void update_impl(const Geometry &geometry, double t, double dt);
+
+  MaxTimestep max_timestep_impl(double t) const;
+
+  const array::Scalar& precipitation_impl() const;
+  const array::Scalar& air_temperature_impl() const;
+
+  CacheTimer m_timer;
+
+  std::shared_ptr<array::Scalar> m_precipitation;
+  std::shared_ptr<array::Scalar> m_temperature;
+};
+
+} // end of namespace atmosphere
+} // end of namespace pism
+
+#endif /* PISM_ATMOSPHERE_CACHE_H */
@@ -21,7 +21,6 @@
 #include <cmath>                // std::exp()
 
 #include "pism/coupler/util/options.hh"
-#include "pism/coupler/util/lapse_rates.hh"
 #include "pism/geometry/Geometry.hh"
 #include "pism/util/array/Forcing.hh"
 #include "pism/util/Logger.hh"
@@ -115,41 +114,42 @@ void ElevationChange::update_impl(const Geometry &geometry, double t, double dt)
 
   const auto &reference_surface = *m_reference_surface;
 
-  // temperature
-  {
-    m_temperature->copy_from(m_input_model->air_temperature());
+  m_temperature->copy_from(m_input_model->air_temperature());
+  m_precipitation->copy_from(m_input_model->precipitation());
 
-    lapse_rate_correction(m_surface, reference_surface,
-                          m_temp_lapse_rate, *m_temperature);
-  }
+  // Apply both corrections in one pass over the grid: the elevation difference driving
+  // them is the same, so this reads the surface and the reference surface once per cell.
+  array::AccessScope list{ &m_surface, &reference_surface, m_temperature.get(),
+                           m_precipitation.get() };
 
-  // precipitation
-  {
-    m_precipitation->copy_from(m_input_model->precipitation());
+  switch (m_precip_method) {
+  case SCALE:
+    {
+      double C = -m_precip_exp_factor * m_precip_temp_lapse_rate;
 
-    switch (m_precip_method) {
-    case SCALE:
-      {
-        array::AccessScope list{&m_surface, &reference_surface, m_precipitation.get()};
+      for (auto p : m_grid->points()) {
+        const int i = p.i(), j = p.j();
 
-        for (auto p : m_grid->points()) {
-          const int i = p.i(), j = p.j();
+        double dh = m_surface(i, j) - reference_surface(i, j);
 
-          double dT = -m_precip_temp_lapse_rate * (m_surface(i, j) - reference_surface(i, j));
+        (*m_temperature)(i, j)   -= m_temp_lapse_rate * dh;
+        (*m_precipitation)(i, j) *= std::exp(C * dh);
+      }
+    }
+    break;
+  case SHIFT:
+  default:
+    {
+      for (auto p : m_grid->points()) {
+        const int i = p.i(), j = p.j();
 
-          (*m_precipitation)(i, j) *= std::exp(m_precip_exp_factor * dT);
-        }
+        double dh = m_surface(i, j) - reference_surface(i, j);
 
+        (*m_temperature)(i, j)   -= m_temp_lapse_rate * dh;
+        (*m_precipitation)(i, j) -= m_precip_lapse_rate * dh;
       }
-      break;
-    case SHIFT:
-    default:
-      {
-        lapse_rate_correction(m_surface, *m_reference_surface,
-                              m_precip_lapse_rate, *m_precipitation);
-      }
-      break;
     }
+    break;
   }
 }
 
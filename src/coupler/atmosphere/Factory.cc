@@ -20,6 +20,7 @@
 #include "pism/coupler/atmosphere/Factory.hh"
 
 // atmosphere models:
+#include "pism/coupler/atmosphere/Cache.hh"
 #include "pism/coupler/atmosphere/GivenClimate.hh"
 #include "pism/coupler/atmosphere/ElevationChange.hh"
 #include "pism/coupler/atmosphere/SeariseGreenland.hh"
@@ -50,6 +51,7 @@ Factory::Factory(std::shared_ptr<const Grid> g)
   add_model<Uniform>("uniform");
 
   add_modifier<Anomaly>("anomaly");
+  add_modifier<Cache>("cache");
   add_modifier<PrecipitationScaling>("precip_scaling");
   add_modifier<Frac_P>("frac_P");
   add_modifier<Delta_P>("delta_P");
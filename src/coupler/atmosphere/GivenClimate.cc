@@ -99,6 +99,11 @@ void Given::update_impl(const Geometry &geometry, double t, double dt) {
   m_air_temp->average(t, dt);
 }
 
+void Given::prefetch_impl(double t, double dt) const {
+  m_precipitation->prefetch(t, dt);
+  m_air_temp->prefetch(t, dt);
+}
+
 const array::Scalar& Given::precipitation_impl() const {
   return *m_precipitation;
 }
@@ -35,6 +35,7 @@ public:
 private:
   void init_impl(const Geometry &geometry);
   void update_impl(const Geometry &geometry, double t, double dt);
+  void prefetch_impl(double t, double dt) const;
 
   const array::Scalar& precipitation_impl() const;
   const array::Scalar& air_temperature_impl() const;
@@ -19,6 +19,7 @@
 #include "pism/coupler/atmosphere/OrographicPrecipitation.hh"
 
 #include "pism/coupler/atmosphere/OrographicPrecipitationSerial.hh"
+#include "pism/coupler/util/caching.hh"
 #include "pism/coupler/util/options.hh"
 #include "pism/geometry/Geometry.hh"
 #include "pism/util/Config.hh"
@@ -30,7 +31,9 @@ namespace atmosphere {
 
 OrographicPrecipitation::OrographicPrecipitation(std::shared_ptr<const Grid> grid,
                                                  std::shared_ptr<AtmosphereModel> in)
-    : AtmosphereModel(grid, in) {
+    : AtmosphereModel(grid, in),
+      m_old_surface_elevation(grid, "old_surface_elevation"),
+      m_precipitation_valid(false) {
 
   m_precipitation = allocate_precipitation(grid);
 
@@ -83,6 +86,15 @@ void OrographicPrecipitation::init_impl(const Geometry &geometry) {
 void OrographicPrecipitation::update_impl(const Geometry &geometry, double t, double dt) {
   m_input_model->update(geometry, t, dt);
 
+  // The precipitation computed below depends on the ice surface elevation only (plus
+  // configuration constants), so we can skip the gather to rank 0, both FFTs, and the
+  // scatter if the surface did not change since the last update.
+  bool changed = update_cached_field(geometry.ice_surface_elevation, m_old_surface_elevation);
+  if (m_precipitation_valid and not changed) {
+    return;
+  }
+  m_precipitation_valid = true;
+
   geometry.ice_surface_elevation.put_on_proc0(*m_work0);
 
   ParallelSection rank0(m_grid->com);
@@ -56,6 +56,11 @@ protected:
 
   //! Serial orographic precipitation model.
   std::unique_ptr<OrographicPrecipitationSerial> m_serial_model;
+
+  //! Copy of the ice surface elevation used during the last update (used to avoid
+  //! re-computing precipitation when the surface did not change).
+  array::Scalar m_old_surface_elevation;
+  bool m_precipitation_valid;
 };
 
 } // end of namespace atmosphere
@@ -0,0 +1,56 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef PISM_FRONTALMELT_CACHE_H
+#define PISM_FRONTALMELT_CACHE_H
+
+#include "pism/coupler/FrontalMelt.hh"
+#include "pism/coupler/util/caching.hh"
+
+namespace pism {
+namespace frontalmelt {
+
+//! Update an expensive frontal melt model on a coarse cadence, serving a cached melt
+//! rate in between.
+/*!
+ * Note: the retreat rate is re-computed (cheaply) every time step using the cached melt
+ * rate and the current geometry; see FrontalMelt::update().
+ */
+class Cache : public FrontalMelt {
+public:
+  Cache(std::shared_ptr<const Grid> g, std::shared_ptr<FrontalMelt> in);
+  virtual ~Cache() = default;
+
+private:
+  void init_impl(const Geometry &geometry);
+  void update_impl(const FrontalMeltInputs &inputs, double t, double dt);
+
+  MaxTimestep max_timestep_impl(double t) const;
+
+  const array::Scalar& frontal_melt_rate_impl() const;
+
+  CacheTimer m_timer;
+
+  array::Scalar m_frontal_melt_rate;
+};
+
+} // end of namespace frontalmelt
+} // end of namespace pism
+
+#endif /* PISM_FRONTALMELT_CACHE_H */
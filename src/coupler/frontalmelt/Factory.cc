@@ -20,6 +20,7 @@
 #include "pism/coupler/frontalmelt/Factory.hh"
 
 // frontal melt models:
+#include "pism/coupler/frontalmelt/Cache.hh"
 #include "pism/coupler/frontalmelt/Constant.hh"
 #include "pism/coupler/frontalmelt/DischargeGiven.hh"
 #include "pism/coupler/frontalmelt/DischargeRouting.hh"
@@ -35,6 +36,8 @@ Factory::Factory(std::shared_ptr<const Grid> g)
   add_model<DischargeGiven>("discharge_given");
   add_model<DischargeRouting>("routing");
   add_model<Given>("given");
+
+  add_modifier<Cache>("cache");
 }
 
 } // end of namespace frontalmelt
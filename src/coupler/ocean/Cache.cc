@@ -1,4 +1,4 @@
-/* Copyright (C) 2013, 2014, 2015, 2016, 2017, 2018, 2020, 2021, 2023, 2025 PISM Authors
+/* Copyright (C) 2013, 2014, 2015, 2016, 2017, 2018, 2020, 2021, 2023, 2025, 2026 PISM Authors
  *
  * This file is part of PISM.
  *
@@ -18,34 +18,19 @@
  */
 
 #include <algorithm>            // std::min
-#include <cassert>
-#include <cmath>
 
 #include "pism/coupler/ocean/Cache.hh"
 #include "pism/util/Grid.hh"
 #include "pism/util/MaxTimestep.hh"
 #include "pism/util/Time.hh"
-#include "pism/util/error_handling.hh"
 #include "pism/util/Logger.hh"
 
 namespace pism {
 namespace ocean {
 
 Cache::Cache(std::shared_ptr<const Grid> g, std::shared_ptr<OceanModel> in)
-  : OceanModel(g, in) {
-
-  m_next_update_time = time().current();
-  m_update_interval_years = m_config->get_number("ocean.cache.update_interval", "seconds");
-
-  // use the current year length (according to the selected calendar) to convert update
-  // interval length into years
-  m_update_interval_years = time().convert_time_interval(m_update_interval_years, "years");
-
-  if (m_update_interval_years <= 0.0) {
-    throw RuntimeError::formatted(PISM_ERROR_LOCATION,
-                                  "ocean.cache.update_interval has to be strictly positive (got %f)",
-                                  m_update_interval_years);
-  }
+  : OceanModel(g, in),
+    m_timer(time(), *m_config, "ocean") {
 
   {
     m_shelf_base_temperature = allocate_shelf_base_temperature(g);
@@ -60,7 +45,7 @@ void Cache::init_impl(const Geometry &geometry) {
   m_log->message(2,
                  "* Initializing the 'caching' ocean model modifier...\n");
 
-  m_next_update_time = time().current();
+  m_timer.reset(time().current());
 }
 
 void Cache::update_impl(const Inputs &inputs, double t, double dt) {
@@ -68,46 +53,25 @@ void Cache::update_impl(const Inputs &inputs, double t, double dt) {
   // an input model
   (void) dt;
 
-  double time_resolution = m_config->get_number("time_stepping.resolution", "seconds");
-
-  if (t >= m_next_update_time or
-      fabs(t - m_next_update_time) < time_resolution) {
-
-    double
-      one_year_from_now = time().increment_date(t, 1.0),
-      update_dt         = one_year_from_now - t;
-
-    assert(update_dt > 0.0);
+  if (not m_timer.expired(t)) {
+    return;
+  }
 
-    m_input_model->update(inputs, t, update_dt);
+  m_input_model->update(inputs, t, m_timer.update_dt(t));
 
-    m_next_update_time = time().increment_date(m_next_update_time,
-                                                               m_update_interval_years);
+  m_timer.advance();
 
-    m_water_column_pressure->copy_from(m_input_model->average_water_column_pressure());
+  // Store outputs of the input model, leaving fields that did not change (and their state
+  // counters) untouched.
+  update_cached_field(m_input_model->average_water_column_pressure(), *m_water_column_pressure);
 
-    m_shelf_base_temperature->copy_from(m_input_model->shelf_base_temperature());
+  update_cached_field(m_input_model->shelf_base_temperature(), *m_shelf_base_temperature);
 
-    m_shelf_base_mass_flux->copy_from(m_input_model->shelf_base_mass_flux());
-  }
+  update_cached_field(m_input_model->shelf_base_mass_flux(), *m_shelf_base_mass_flux);
 }
 
 MaxTimestep Cache::max_timestep_impl(double t) const {
-  double dt = m_next_update_time - t;
-
-  double time_resolution = m_config->get_number("time_stepping.resolution", "seconds");
-
-  // if we got very close to the next update time, set time step
-  // length to the interval between updates
-  if (dt < time_resolution) {
-    double update_time_after_next = time().increment_date(m_next_update_time,
-                                                                m_update_interval_years);
-
-    dt = update_time_after_next - m_next_update_time;
-    assert(dt > 0.0);
-  }
-
-  MaxTimestep cache_dt(dt, "ocean cache");
+  MaxTimestep cache_dt = m_timer.max_timestep(t, "ocean cache");
 
   MaxTimestep input_max_timestep = m_input_model->max_timestep(t);
   if (input_max_timestep.finite()) {
@@ -21,6 +21,7 @@
 #define _POCACHE_H_
 
 #include "pism/coupler/OceanModel.hh"
+#include "pism/coupler/util/caching.hh"
 
 namespace pism {
 namespace ocean {
@@ -40,8 +41,7 @@ protected:
   const array::Scalar& shelf_base_mass_flux_impl() const;
   const array::Scalar& average_water_column_pressure_impl() const;
 private:
-  double m_next_update_time;
-  double m_update_interval_years;
+  CacheTimer m_timer;
 
   // storage for average_water_column_pressure is inherited from OceanModel
   std::shared_ptr<array::Scalar> m_shelf_base_temperature;
@@ -121,6 +121,11 @@ MaxTimestep Given::max_timestep_impl(double t) const {
   return MaxTimestep("ocean th");
 }
 
+void Given::prefetch_impl(double t, double dt) const {
+  m_shelfbmassflux->prefetch(t, dt);
+  m_shelfbtemp->prefetch(t, dt);
+}
+
 const array::Scalar& Given::shelf_base_temperature_impl() const {
   return *m_shelf_base_temperature;
 }
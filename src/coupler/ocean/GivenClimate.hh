@@ -34,6 +34,7 @@ private:
   void update_impl(const Inputs &inputs, double t, double dt);
   void init_impl(const Geometry &geometry);
   MaxTimestep max_timestep_impl(double t) const;
+  void prefetch_impl(double t, double dt) const;
 
   const array::Scalar& shelf_base_temperature_impl() const;
   const array::Scalar& shelf_base_mass_flux_impl() const;
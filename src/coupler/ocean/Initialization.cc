@@ -45,9 +45,18 @@ InitializationHelper::InitializationHelper(std::shared_ptr<const Grid> g, std::s
 void InitializationHelper::update_impl(const Inputs &inputs, double t, double dt) {
   OceanModel::update_impl(inputs, t, dt);
 
-  m_water_column_pressure->copy_from(m_input_model->average_water_column_pressure());
-  m_shelf_base_temperature->copy_from(m_input_model->shelf_base_temperature());
-  m_shelf_base_mass_flux->copy_from(m_input_model->shelf_base_mass_flux());
+  const array::Scalar
+    &water_column_pressure = m_input_model->average_water_column_pressure(),
+    &temperature           = m_input_model->shelf_base_temperature(),
+    &mass_flux             = m_input_model->shelf_base_mass_flux();
+
+  // Skip the copies if the input model reports (via state counters) that its outputs did
+  // not change since the last update.
+  if (m_input_revisions.changed({ &water_column_pressure, &temperature, &mass_flux })) {
+    m_water_column_pressure->copy_from(water_column_pressure);
+    m_shelf_base_temperature->copy_from(temperature);
+    m_shelf_base_mass_flux->copy_from(mass_flux);
+  }
 }
 
 void InitializationHelper::init_impl(const Geometry &geometry) {
@@ -55,6 +55,9 @@ private:
   // storage for average_water_column_pressure is inherited from OceanModel
   std::shared_ptr<array::Scalar> m_shelf_base_temperature;
   std::shared_ptr<array::Scalar> m_shelf_base_mass_flux;
+
+  // revisions of the input model's outputs (used to skip the copies in update_impl())
+  InputRevisions m_input_revisions;
 };
 
 } // end of namespace ocean
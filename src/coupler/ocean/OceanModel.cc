@@ -119,6 +119,12 @@ MaxTimestep OceanModel::max_timestep_impl(double t) const {
   throw RuntimeError::formatted(PISM_ERROR_LOCATION, "no input model");
 }
 
+void OceanModel::prefetch_impl(double t, double dt) const {
+  if (m_input_model) {
+    m_input_model->prefetch(t, dt);
+  }
+}
+
 std::set<VariableMetadata> OceanModel::state_impl() const {
   if (m_input_model) {
     return m_input_model->state();
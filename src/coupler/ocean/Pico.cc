@@ -317,11 +317,17 @@ void Pico::update_impl(const Inputs &inputs, double t, double dt) {
                     m_Toc,
                     m_Soc);
 
+    // Compute areas of all the boxes of all the shelves in one pass (and one reduction)
+    // instead of one box at a time.
+    std::vector<std::vector<double> > box_areas;
+    compute_box_areas(m_geometry.ice_shelf_mask(), m_geometry.box_mask(), box_areas);
+
     // In ice shelves, replace Beckmann-Goosse values using the Olbers and Hellmer model.
     process_box1(physics,
                  ice_thickness,                             // input
                  m_geometry.ice_shelf_mask(),               // input
                  m_geometry.box_mask(),                     // input
+                 box_areas[1],                              // input
                  m_Toc_box0,                                // input
                  m_Soc_box0,                                // input
                  m_basal_melt_rate,
@@ -335,6 +341,7 @@ void Pico::update_impl(const Inputs &inputs, double t, double dt) {
                         ice_thickness,               // input
                         m_geometry.ice_shelf_mask(), // input
                         m_geometry.box_mask(),       // input
+                        box_areas,                   // input
                         m_basal_melt_rate,
                         *m_shelf_base_temperature,
                         m_T_star,
@@ -377,18 +384,15 @@ void Pico::compute_ocean_input_per_basin(const PicoPhysics &physics,
                                          const array::Scalar &theta_ocean,
                                          std::vector<double> &temperature,
                                          std::vector<double> &salinity) const {
-  std::vector<int> count(m_n_basins, 0);
-  // additional vectors to allreduce efficiently with IntelMPI
-  std::vector<int> countr(m_n_basins, 0);
-  std::vector<double> salinityr(m_n_basins);
-  std::vector<double> temperaturer(m_n_basins);
-
   temperature.resize(m_n_basins);
   salinity.resize(m_n_basins);
-  for (int basin_id = 0; basin_id < m_n_basins; basin_id++) {
-    temperature[basin_id] = 0.0;
-    salinity[basin_id]    = 0.0;
-  }
+
+  // Pack per-basin sums of salinity and temperature and cell counts (stored as doubles)
+  // into one buffer so that one reduction is enough:
+  m_work.assign(3 * m_n_basins, 0.0);
+  double *salinity_sum    = &m_work[0 * m_n_basins];
+  double *temperature_sum = &m_work[1 * m_n_basins];
+  double *count           = &m_work[2 * m_n_basins];
 
   array::AccessScope list{ &theta_ocean, &salinity_ocean, &basin_mask, &continental_shelf_mask };
 
@@ -401,9 +405,9 @@ void Pico::compute_ocean_input_per_basin(const PicoPhysics &physics,
     if (continental_shelf_mask.as_int(i, j) == 2) {
       int basin_id = basin_mask.as_int(i, j);
 
-      count[basin_id] += 1;
-      salinity[basin_id] += salinity_ocean(i, j);
-      temperature[basin_id] += theta_ocean(i, j);
+      count[basin_id] += 1.0;
+      salinity_sum[basin_id] += salinity_ocean(i, j);
+      temperature_sum[basin_id] += theta_ocean(i, j);
     }
   }
 
@@ -411,14 +415,12 @@ void Pico::compute_ocean_input_per_basin(const PicoPhysics &physics,
   // ocean_contshelf_mask values intersect with the basin, count is zero. In such case,
   // use dummy temperature and salinity. This could happen, for example, if the ice shelf
   // front advances beyond the continental shelf break.
-  GlobalSum(m_grid->com, count.data(), countr.data(), m_n_basins);
-  GlobalSum(m_grid->com, salinity.data(), salinityr.data(), m_n_basins);
-  GlobalSum(m_grid->com, temperature.data(), temperaturer.data(), m_n_basins);
+  m_work_global.resize(3 * m_n_basins);
+  GlobalSum(m_grid->com, m_work.data(), m_work_global.data(), 3 * m_n_basins);
 
-  // copy values
-  count       = countr;
-  salinity    = salinityr;
-  temperature = temperaturer;
+  salinity_sum    = &m_work_global[0 * m_n_basins];
+  temperature_sum = &m_work_global[1 * m_n_basins];
+  count           = &m_work_global[2 * m_n_basins];
 
   // "dummy" basin
   {
@@ -428,9 +430,9 @@ void Pico::compute_ocean_input_per_basin(const PicoPhysics &physics,
 
   for (int basin_id = 1; basin_id < m_n_basins; basin_id++) {
 
-    if (count[basin_id] != 0) {
-      salinity[basin_id] /= count[basin_id];
-      temperature[basin_id] /= count[basin_id];
+    if (count[basin_id] > 0.0) {
+      salinity[basin_id]    = salinity_sum[basin_id] / count[basin_id];
+      temperature[basin_id] = temperature_sum[basin_id] / count[basin_id];
 
       m_log->message(5, "  %d: temp =%.3f, salinity=%.3f\n", basin_id, temperature[basin_id], salinity[basin_id]);
     } else {
@@ -469,13 +471,13 @@ void Pico::set_ocean_input_fields(const PicoPhysics &physics,
   
   array::AccessScope list{ &ice_thickness, &basin_mask, &Soc_box0, &Toc_box0, &mask, &shelf_mask };
 
-  std::vector<int> n_shelf_cells_per_basin(m_n_shelves * m_n_basins, 0);
-  std::vector<int> n_shelf_cells(m_n_shelves, 0);
-  std::vector<int> cfs_in_basins_per_shelf(m_n_shelves * m_n_basins, 0);
-  // additional vectors to allreduce efficiently with IntelMPI
-  std::vector<int> n_shelf_cells_per_basinr(m_n_shelves * m_n_basins, 0);
-  std::vector<int> n_shelf_cellsr(m_n_shelves, 0);
-  std::vector<int> cfs_in_basins_per_shelfr(m_n_shelves * m_n_basins, 0);
+  // Pack the three per-shelf counts (stored as doubles) into one buffer so that one
+  // reduction is enough:
+  int NB = m_n_shelves * m_n_basins;
+  m_work.assign(2 * NB + m_n_shelves, 0.0);
+  double *n_shelf_cells_per_basin = &m_work[0];
+  double *cfs_in_basins_per_shelf = &m_work[NB];
+  double *n_shelf_cells           = &m_work[2 * NB];
 
   // 1) count the number of cells in each shelf
   // 2) count the number of cells in the intersection of each shelf with all the basins
@@ -484,8 +486,8 @@ void Pico::set_ocean_input_fields(const PicoPhysics &physics,
       const int i = p.i(), j = p.j();
       int s = shelf_mask.as_int(i, j);
       int b = basin_mask.as_int(i, j);
-      n_shelf_cells_per_basin[s*m_n_basins+b]++;
-      n_shelf_cells[s]++;
+      n_shelf_cells_per_basin[s * m_n_basins + b] += 1.0;
+      n_shelf_cells[s] += 1.0;
 
       // find all basins b, in which the ice shelf s has a calving front with potential ocean water intrusion
       if (mask.as_int(i, j) == MASK_FLOATING) {
@@ -501,24 +503,20 @@ void Pico::set_ocean_input_fields(const PicoPhysics &physics,
       }
     }
     
-    GlobalSum(m_grid->com, n_shelf_cells.data(),
-              n_shelf_cellsr.data(), m_n_shelves);
-    GlobalSum(m_grid->com, n_shelf_cells_per_basin.data(),
-              n_shelf_cells_per_basinr.data(), m_n_shelves*m_n_basins);
-    GlobalSum(m_grid->com, cfs_in_basins_per_shelf.data(),
-              cfs_in_basins_per_shelfr.data(), m_n_shelves*m_n_basins);
-    // copy data
-    n_shelf_cells = n_shelf_cellsr;
-    n_shelf_cells_per_basin = n_shelf_cells_per_basinr;
-    cfs_in_basins_per_shelf = cfs_in_basins_per_shelfr;
+    m_work_global.resize(2 * NB + m_n_shelves);
+    GlobalSum(m_grid->com, m_work.data(), m_work_global.data(), 2 * NB + m_n_shelves);
+
+    n_shelf_cells_per_basin = &m_work_global[0];
+    cfs_in_basins_per_shelf = &m_work_global[NB];
+    n_shelf_cells           = &m_work_global[2 * NB];
 
     for (int s = 0; s < m_n_shelves; s++) {
       for (int b = 0; b < m_n_basins; b++) {
         int sb = s * m_n_basins + b;
         // remove ice shelf parts from the count that do not have a calving front in that basin
-        if (n_shelf_cells_per_basin[sb] > 0 and cfs_in_basins_per_shelf[sb] == 0) {
+        if (n_shelf_cells_per_basin[sb] > 0.0 and cfs_in_basins_per_shelf[sb] == 0.0) {
           n_shelf_cells[s] -= n_shelf_cells_per_basin[sb];
-          n_shelf_cells_per_basin[sb] = 0;
+          n_shelf_cells_per_basin[sb] = 0.0;
         }
       }
     }
@@ -539,8 +537,8 @@ void Pico::set_ocean_input_fields(const PicoPhysics &physics,
     if (mask.as_int(i, j) == MASK_FLOATING and s > 0) {
       // note: shelf_mask = 0 in lakes
 
-      assert(n_shelf_cells[s] > 0);
-      double N = std::max(n_shelf_cells[s], 1); // protect from division by zero
+      assert(n_shelf_cells[s] > 0.0);
+      double N = std::max(n_shelf_cells[s], 1.0); // protect from division by zero
 
       // weighted input depending on the number of shelf cells in each basin
       for (int b = 1; b < m_n_basins; b++) { //Note: b=0 yields nan
@@ -628,6 +626,7 @@ void Pico::process_box1(const PicoPhysics &physics,
                         const array::Scalar &ice_thickness,
                         const array::Scalar &shelf_mask,
                         const array::Scalar &box_mask,
+                        const std::vector<double> &box1_area,
                         const array::Scalar &Toc_box0,
                         const array::Scalar &Soc_box0,
                         array::Scalar &basal_melt_rate,
@@ -637,10 +636,6 @@ void Pico::process_box1(const PicoPhysics &physics,
                         array::Scalar &Soc,
                         array::Scalar &overturning) {
 
-  std::vector<double> box1_area(m_n_shelves);
-
-  compute_box_area(1, shelf_mask, box_mask, box1_area);
-
   array::AccessScope list{ &ice_thickness, &shelf_mask, &box_mask,    &T_star,          &Toc_box0,          &Toc,
                                 &Soc_box0,      &Soc,        &overturning, &basal_melt_rate, &basal_temperature };
 
@@ -697,6 +692,7 @@ void Pico::process_other_boxes(const PicoPhysics &physics,
                                const array::Scalar &ice_thickness,
                                const array::Scalar &shelf_mask,
                                const array::Scalar &box_mask,
+                               const std::vector<std::vector<double> > &box_areas,
                                array::Scalar &basal_melt_rate,
                                array::Scalar &basal_temperature,
                                array::Scalar &T_star,
@@ -707,19 +703,34 @@ void Pico::process_other_boxes(const PicoPhysics &physics,
   std::vector<double> salinity(m_n_shelves, 0.0);
   std::vector<double> temperature(m_n_shelves, 0.0);
 
-  // get average overturning from box 1 that is used as input later
-  compute_box_average(1, m_overturning, shelf_mask, box_mask, overturning);
-
   std::vector<bool> use_beckmann_goosse(m_n_shelves);
 
+  // number of cells that fell back to the Beckmann-Goosse parameterization, per box
+  // (reduced once, after the loop over boxes)
+  std::vector<int> n_beckmann_goosse_cells(m_n_boxes + 1, 0);
+
+  // Cells belonging to some shelf. Shelves cover a small part of the domain, so the
+  // per-box passes below iterate these runs instead of scanning the whole sub-domain
+  // once per box. (The box mask is zero away from shelves, so this visits every cell
+  // with a non-zero box id.)
+  auto shelf_runs = mask::compute_runs(shelf_mask, [](int M) { return M > 0; });
+
   array::AccessScope list{ &ice_thickness, &shelf_mask,      &box_mask,           &T_star,   &Toc,
                                 &Soc,           &basal_melt_rate, &basal_temperature };
 
   // Iterate over all boxes i for i > 1
   for (int box = 2; box <= m_n_boxes; ++box) {
 
-    compute_box_average(box - 1, Toc, shelf_mask, box_mask, temperature);
-    compute_box_average(box - 1, Soc, shelf_mask, box_mask, salinity);
+    // Average the inputs from the previous box, batching fields to reduce the number of
+    // collective operations. The average overturning in box 1 is used as input for all
+    // the later boxes, so it is included in the first batch.
+    if (box == 2) {
+      compute_box_averages(box - 1, { &Toc, &Soc, &m_overturning }, shelf_runs, shelf_mask,
+                           box_mask, { &temperature, &salinity, &overturning });
+    } else {
+      compute_box_averages(box - 1, { &Toc, &Soc }, shelf_runs, shelf_mask, box_mask,
+                           { &temperature, &salinity });
+    }
 
     // find all the shelves where we should fall back to the Beckmann-Goosse
     // parameterization
@@ -729,20 +740,21 @@ void Pico::process_other_boxes(const PicoPhysics &physics,
                                 overturning[s] == 0.0);
     }
 
-    std::vector<double> box_area;
-    compute_box_area(box, shelf_mask, box_mask, box_area);
+    const std::vector<double> &box_area = box_areas[box];
 
-    int n_beckmann_goosse_cells = 0;
+    for (const auto &r : shelf_runs) {
+      const int j = r.j;
+      for (int i = r.i_first; i <= r.i_last; ++i) {
 
-    for (auto p : m_grid->points()) {
-      const int i = p.i(), j = p.j();
-
-      int shelf_id = shelf_mask.as_int(i, j);
+        if (box_mask.as_int(i, j) != box) {
+          continue;
+        }
 
-      if (box_mask.as_int(i, j) == box and shelf_id > 0) {
+        // positive for all cells in shelf_runs
+        int shelf_id = shelf_mask.as_int(i, j);
 
         if (use_beckmann_goosse[shelf_id]) {
-          n_beckmann_goosse_cells += 1;
+          n_beckmann_goosse_cells[box] += 1;
           continue;
         }
 
@@ -765,18 +777,25 @@ void Pico::process_other_boxes(const PicoPhysics &physics,
           basal_temperature(i, j) = physics.T_pm(Soc(i, j), pressure);
         }
       }
-    } // loop over grid points
+    } // loop over shelf runs
+  } // loop over boxes
 
-    n_beckmann_goosse_cells = GlobalSum(m_grid->com, n_beckmann_goosse_cells);
-    if (n_beckmann_goosse_cells > 0) {
-      m_log->message(
-          2,
-          "PICO WARNING: [box %d]: switched to the Beckmann Goosse (2003) model at %d locations\n"
-          "              (no boundary data from the previous box)\n",
-          box, n_beckmann_goosse_cells);
+  // report cells that switched to the Beckmann-Goosse parameterization (one reduction for
+  // all boxes)
+  {
+    std::vector<int> tmp(m_n_boxes + 1, 0);
+    GlobalSum(m_grid->com, n_beckmann_goosse_cells.data(), tmp.data(), m_n_boxes + 1);
+
+    for (int box = 2; box <= m_n_boxes; ++box) {
+      if (tmp[box] > 0) {
+        m_log->message(
+            2,
+            "PICO WARNING: [box %d]: switched to the Beckmann Goosse (2003) model at %d locations\n"
+            "              (no boundary data from the previous box)\n",
+            box, tmp[box]);
+      }
     }
-
-  } // loop over boxes
+  }
 }
 
 
@@ -803,68 +822,85 @@ DiagnosticList Pico::spatial_diagnostics_impl() const {
 }
 
 /*!
- * For each shelf, compute average of a given field over the box with id `box_id`.
+ * For each shelf, compute averages of the given `fields` over the box with id `box_id`.
  *
  * This method is used to get inputs from a previous box for the next one.
+ *
+ * All the fields share one pass over the grid and one reduction: sums of all the fields
+ * and the cell count (stored as a double) are packed into one buffer, replacing a pair of
+ * collective operations per field.
+ *
+ * `shelf_runs` is the run list of shelf cells (see process_other_boxes()); since the box
+ * mask is zero away from shelves, iterating it visits every cell of the box `box_id`.
  */
-void Pico::compute_box_average(int box_id,
-                               const array::Scalar &field,
-                               const array::Scalar &shelf_mask,
-                               const array::Scalar &box_mask,
-                               std::vector<double> &result) const {
+void Pico::compute_box_averages(int box_id,
+                                const std::vector<const array::Scalar *> &fields,
+                                const std::vector<mask::Run> &shelf_runs,
+                                const array::Scalar &shelf_mask,
+                                const array::Scalar &box_mask,
+                                const std::vector<std::vector<double> *> &results) const {
+  assert(fields.size() == results.size());
 
-  array::AccessScope list{ &field, &shelf_mask, &box_mask };
+  int n_fields = static_cast<int>(fields.size());
+  // one block of m_n_shelves values per field, plus one for cell counts:
+  int n_values = (n_fields + 1) * m_n_shelves;
 
-  // fill results with zeros
-  result.resize(m_n_shelves);
-  for (int s = 0; s < m_n_shelves; ++s) {
-    result[s] = 0.0;
-  }
+  m_work.assign(n_values, 0.0);
 
-  // compute the sum of field in each shelf's box box_id
-  std::vector<int> n_cells(m_n_shelves);
-  {
-    std::vector<int> n_cells_per_box(m_n_shelves, 0);
-    for (auto p : m_grid->points()) {
-      const int i = p.i(), j = p.j();
+  array::AccessScope list{ &shelf_mask, &box_mask };
+  for (int f = 0; f < n_fields; ++f) {
+    list.add(*fields[f]);
+  }
 
-      int shelf_id = shelf_mask.as_int(i, j);
+  // compute sums of all the fields in each shelf's box box_id
+  for (const auto &r : shelf_runs) {
+    const int j = r.j;
+    for (int i = r.i_first; i <= r.i_last; ++i) {
 
       if (box_mask.as_int(i, j) == box_id) {
-        n_cells_per_box[shelf_id] += 1;
-        result[shelf_id] += field(i, j);
+        int shelf_id = shelf_mask.as_int(i, j);
+
+        for (int f = 0; f < n_fields; ++f) {
+          m_work[f * m_n_shelves + shelf_id] += (*fields[f])(i, j);
+        }
+        m_work[n_fields * m_n_shelves + shelf_id] += 1.0;
       }
     }
-    GlobalSum(m_grid->com, n_cells_per_box.data(), n_cells.data(), m_n_shelves);
   }
 
-  {
-    std::vector<double> tmp(m_n_shelves);
-    GlobalSum(m_grid->com, result.data(), tmp.data(), m_n_shelves);
-    // copy data
-    result = tmp;
-  }
+  m_work_global.resize(n_values);
+  GlobalSum(m_grid->com, m_work.data(), m_work_global.data(), n_values);
 
-  for (int s = 0; s < m_n_shelves; ++s) {
-    if (n_cells[s] > 0) {
-      result[s] /= static_cast<double>(n_cells[s]);
+  const double *count = &m_work_global[n_fields * m_n_shelves];
+  for (int f = 0; f < n_fields; ++f) {
+    std::vector<double> &result = *results[f];
+
+    result.assign(m_n_shelves, 0.0);
+    for (int s = 0; s < m_n_shelves; ++s) {
+      if (count[s] > 0.0) {
+        result[s] = m_work_global[f * m_n_shelves + s] / count[s];
+      }
     }
   }
 }
 
 /*!
- * For all shelves compute areas of boxes with id `box_id`.
+ * For all shelves compute areas of all the boxes.
  *
- * @param[in] box_mask box index mask
- * @param[out] result resulting box areas.
+ * `result[b][s]` is the area (in square meters) of the box `b` of the shelf `s`.
  *
  * Note: shelf and box indexes start from 1.
+ *
+ * Areas of all the boxes are computed in one pass over the grid and reduced with one
+ * collective operation (instead of one per box).
  */
-void Pico::compute_box_area(int box_id,
-                            const array::Scalar &shelf_mask,
-                            const array::Scalar &box_mask,
-                            std::vector<double> &result) const {
-  result.resize(m_n_shelves);
+void Pico::compute_box_areas(const array::Scalar &shelf_mask,
+                             const array::Scalar &box_mask,
+                             std::vector<std::vector<double> > &result) const {
+  int n_values = (m_n_boxes + 1) * m_n_shelves;
+
+  m_work.assign(n_values, 0.0);
+
   array::AccessScope list{ &shelf_mask, &box_mask };
 
   auto cell_area = m_grid->cell_area();
@@ -873,18 +909,20 @@ void Pico::compute_box_area(int box_id,
     const int i = p.i(), j = p.j();
 
     int shelf_id = shelf_mask.as_int(i, j);
+    int box_id   = box_mask.as_int(i, j);
 
-    if (shelf_id > 0 and box_mask.as_int(i, j) == box_id) {
-      result[shelf_id] += cell_area;
+    if (shelf_id > 0 and box_id >= 1 and box_id <= m_n_boxes) {
+      m_work[box_id * m_n_shelves + shelf_id] += cell_area;
     }
   }
-  
-  // compute GlobalSum from index 1 to index m_n_shelves-1
-  std::vector<double> result1(m_n_shelves);
-  GlobalSum(m_grid->com, &result[1], &result1[1], m_n_shelves-1);
-  // copy data
-  for (int i = 1; i < m_n_shelves; i++) {
-    result[i] = result1[i];
+
+  m_work_global.resize(n_values);
+  GlobalSum(m_grid->com, m_work.data(), m_work_global.data(), n_values);
+
+  result.resize(m_n_boxes + 1);
+  for (int b = 1; b <= m_n_boxes; ++b) {
+    const double *areas = &m_work_global[b * m_n_shelves];
+    result[b].assign(areas, areas + m_n_shelves);
   }
 }
 
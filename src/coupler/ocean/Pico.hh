@@ -28,6 +28,10 @@ namespace pism {
 
 class VariableMetadata;
 
+namespace mask {
+struct Run;
+}
+
 namespace ocean {
 
 class PicoPhysics;
@@ -84,6 +88,7 @@ private:
                     const array::Scalar &ice_thickness,
                     const array::Scalar &shelf_mask,
                     const array::Scalar &box_mask,
+                    const std::vector<double> &box1_area,
                     const array::Scalar &Toc_box0,
                     const array::Scalar &Soc_box0,
                     array::Scalar &basal_melt_rate,
@@ -97,6 +102,7 @@ private:
                            const array::Scalar &ice_thickness,
                            const array::Scalar &shelf_mask,
                            const array::Scalar &box_mask,
+                           const std::vector<std::vector<double> > &box_areas,
                            array::Scalar &basal_melt_rate,
                            array::Scalar &basal_temperature,
                            array::Scalar &T_star,
@@ -114,18 +120,22 @@ private:
                        array::Scalar &Toc,
                        array::Scalar &Soc);
 
-  void compute_box_average(int box_id,
-                           const array::Scalar &field,
-                           const array::Scalar &shelf_mask,
-                           const array::Scalar &box_mask,
-                           std::vector<double> &result) const;
+  void compute_box_averages(int box_id,
+                            const std::vector<const array::Scalar *> &fields,
+                            const std::vector<mask::Run> &shelf_runs,
+                            const array::Scalar &shelf_mask,
+                            const array::Scalar &box_mask,
+                            const std::vector<std::vector<double> *> &results) const;
 
-  void compute_box_area(int box_id,
-                        const array::Scalar &shelf_mask,
-                        const array::Scalar &box_mask,
-                        std::vector<double> &result) const;
+  void compute_box_areas(const array::Scalar &shelf_mask,
+                         const array::Scalar &box_mask,
+                         std::vector<std::vector<double> > &result) const;
 
   int m_n_basins, m_n_boxes, m_n_shelves;
+
+  //! scratch space for packed reductions (members to avoid re-allocating them every time
+  //! step)
+  mutable std::vector<double> m_work, m_work_global;
 };
 
 } // end of namespace ocean
@@ -24,6 +24,7 @@
 #include "pism/util/array/CellType.hh"
 #include "pism/util/pism_utilities.hh"
 
+#include "pism/coupler/util/caching.hh"
 #include "pism/coupler/util/options.hh"
 #include "pism/util/Interpolation1D.hh"
 #include "pism/util/Profiling.hh"
@@ -44,7 +45,11 @@ PicoGeometry::PicoGeometry(std::shared_ptr<const Grid> grid)
       m_ocean_mask(grid, "pico_ocean_mask"),
       m_lake_mask(grid, "pico_lake_mask"),
       m_ice_rises(grid, "pico_ice_rise_mask"),
-      m_tmp(grid, "temporary_storage") {
+      m_tmp(grid, "temporary_storage"),
+      m_old_bed_elevation(grid, "old_bed_elevation"),
+      m_old_cell_type(grid, "old_cell_type"),
+      m_distance_gl_seeds(grid, "pico_distance_gl_seeds"),
+      m_distance_cf_seeds(grid, "pico_distance_cf_seeds") {
 
   m_continental_shelf.set_interpolation_type(NEAREST);
   m_boxes.set_interpolation_type(NEAREST);
@@ -65,6 +70,7 @@ PicoGeometry::PicoGeometry(std::shared_ptr<const Grid> grid)
 
   m_basin_mask.metadata(0).long_name("mask determines basins for PICO");
   m_n_basins = 0;
+  m_outputs_valid = false;
 }
 
 const array::Scalar &PicoGeometry::continental_shelf_mask() const {
@@ -101,10 +107,33 @@ void PicoGeometry::init() {
  *
  * After this call box_mask(), ice_shelf_mask(), and continental_shelf_mask() will be up
  * to date.
+ *
+ * All of the quantities computed here depend only on the inputs of this method (plus
+ * configuration parameters and the basin mask read during initialization), so the
+ * expensive connected-component and distance passes below run only if the inputs changed
+ * since the last call.
  */
 void PicoGeometry::update(const array::Scalar &bed_elevation,
                           const array::CellType1 &cell_type) {
 
+  double continental_shelf_depth = m_config->get_number("ocean.pico.continental_shelf_depth");
+
+  // Check if the inputs changed since the last call. Note: both calls have to happen
+  // (they save the copies used by the next call), so don't short-circuit.
+  bool bed_changed  = update_cached_field(bed_elevation, m_old_bed_elevation);
+  bool mask_changed = update_cached_field(cell_type, m_old_cell_type);
+
+  if (m_outputs_valid and not mask_changed) {
+    // Everything below depends on the cell type mask; the only output that also depends
+    // on the bed elevation is the continental shelf mask.
+    if (bed_changed) {
+      compute_continental_shelf_mask(bed_elevation, m_ice_rises, continental_shelf_depth,
+                                     m_continental_shelf);
+    }
+    return;
+  }
+  m_outputs_valid = true;
+
   // Update basin adjacency.
   //
   // basin_neighbors() below uses the cell type mask to find
@@ -167,8 +196,6 @@ void PicoGeometry::update(const array::Scalar &bed_elevation,
                       most_shelf_cells_in_basin, cfs_in_basins_per_shelf, n_shelves,
                       m_ice_shelves);
 
-    double continental_shelf_depth = m_config->get_number("ocean.pico.continental_shelf_depth");
-
     compute_continental_shelf_mask(bed_elevation, m_ice_rises, continental_shelf_depth,
                                    m_continental_shelf);
   }
@@ -752,49 +779,60 @@ void PicoGeometry::compute_distances_gl(const array::Scalar &ocean_mask,
                                         bool exclude_ice_rises,
                                         array::Scalar1 &result) {
 
-  array::AccessScope list{ &ice_rises, &ocean_mask, &result };
+  // Build the "seed" field of the Eikonal solve in m_tmp.
+  {
+    array::AccessScope list{ &ice_rises, &ocean_mask, &m_tmp };
 
-  result.set(-1);
+    m_tmp.set(-1);
 
-  // Find the grounding line and the ice front and set result to 1 if ice shelf cell is
-  // next to the grounding line, Ice holes within the shelf are treated like ice shelf
-  // cells, if exclude_ice_rises is set then ice rises are also treated as ice shelf cells.
+    // Find the grounding line and the ice front and set m_tmp to 1 if ice shelf cell is
+    // next to the grounding line, Ice holes within the shelf are treated like ice shelf
+    // cells, if exclude_ice_rises is set then ice rises are also treated as ice shelf cells.
 
-  ParallelSection loop(m_grid->com);
-  try {
-    for (auto p : m_grid->points()) {
-      const int i = p.i(), j = p.j();
+    ParallelSection loop(m_grid->com);
+    try {
+      for (auto p : m_grid->points()) {
+        const int i = p.i(), j = p.j();
 
-      if (ice_rises.as_int(i, j) == FLOATING or
-          ocean_mask.as_int(i, j) == 1 or
-          (exclude_ice_rises and ice_rises.as_int(i, j) == RISE)) {
-        // if this is an ice shelf cell (or an ice rise) or a hole in an ice shelf
-
-        // label the shelf cells adjacent to the grounding line with 1
-        bool neighbor_to_land =
-          (ice_rises(i, j + 1) == CONTINENTAL or
-           ice_rises(i, j - 1) == CONTINENTAL or
-           ice_rises(i + 1, j) == CONTINENTAL or
-           ice_rises(i - 1, j) == CONTINENTAL or
-           ice_rises(i + 1, j + 1) == CONTINENTAL or
-           ice_rises(i + 1, j - 1) == CONTINENTAL or
-           ice_rises(i - 1, j + 1) == CONTINENTAL or
-           ice_rises(i - 1, j - 1) == CONTINENTAL);
-
-        if (neighbor_to_land) {
-          // i.e. there is a grounded neighboring cell (which is not an ice rise!)
-          result(i, j) = 1;
-        } else {
-          result(i, j) = 0;
+        if (ice_rises.as_int(i, j) == FLOATING or
+            ocean_mask.as_int(i, j) == 1 or
+            (exclude_ice_rises and ice_rises.as_int(i, j) == RISE)) {
+          // if this is an ice shelf cell (or an ice rise) or a hole in an ice shelf
+
+          // label the shelf cells adjacent to the grounding line with 1
+          bool neighbor_to_land =
+            (ice_rises(i, j + 1) == CONTINENTAL or
+             ice_rises(i, j - 1) == CONTINENTAL or
+             ice_rises(i + 1, j) == CONTINENTAL or
+             ice_rises(i - 1, j) == CONTINENTAL or
+             ice_rises(i + 1, j + 1) == CONTINENTAL or
+             ice_rises(i + 1, j - 1) == CONTINENTAL or
+             ice_rises(i - 1, j + 1) == CONTINENTAL or
+             ice_rises(i - 1, j - 1) == CONTINENTAL);
+
+          if (neighbor_to_land) {
+            // i.e. there is a grounded neighboring cell (which is not an ice rise!)
+            m_tmp(i, j) = 1;
+          } else {
+            m_tmp(i, j) = 0;
+          }
         }
       }
+    } catch (...) {
+      loop.failed();
     }
-  } catch (...) {
-    loop.failed();
+    loop.check();
+  }
+
+  // The distances are a function of the seeds alone: if the seeds did not change since
+  // the last update, `result` still holds the solution and we can skip the solve. (The
+  // cell type mask may have changed far away from all ice shelves, e.g. at a
+  // land-terminating margin.)
+  if (not update_cached_field(m_tmp, m_distance_gl_seeds)) {
+    return;
   }
-  loop.check();
 
-  result.update_ghosts();
+  result.copy_from(m_tmp);      // copies owned values and updates ghosts
 
   profiling().begin("ocean.eikonal_equation");
   eikonal_equation(result);
@@ -809,37 +847,45 @@ void PicoGeometry::compute_distances_cf(const array::Scalar1 &ocean_mask,
                                         bool exclude_ice_rises,
                                         array::Scalar1 &result) {
 
-  array::AccessScope list{ &ice_rises, &ocean_mask, &result };
+  // Build the "seed" field of the Eikonal solve in m_tmp.
+  {
+    array::AccessScope list{ &ice_rises, &ocean_mask, &m_tmp };
 
-  result.set(-1);
+    m_tmp.set(-1);
 
-  ParallelSection loop(m_grid->com);
-  try {
-    for (auto p : m_grid->points()) {
-      const int i = p.i(), j = p.j();
+    ParallelSection loop(m_grid->com);
+    try {
+      for (auto p : m_grid->points()) {
+        const int i = p.i(), j = p.j();
 
-      if (ice_rises.as_int(i, j) == FLOATING or
-          ocean_mask.as_int(i, j) == 1 or
-          (exclude_ice_rises and ice_rises.as_int(i, j) == RISE)) {
-        // if this is an ice shelf cell (or an ice rise) or a hole in an ice shelf
+        if (ice_rises.as_int(i, j) == FLOATING or
+            ocean_mask.as_int(i, j) == 1 or
+            (exclude_ice_rises and ice_rises.as_int(i, j) == RISE)) {
+          // if this is an ice shelf cell (or an ice rise) or a hole in an ice shelf
 
-        // label the shelf cells adjacent to the ice front with 1
-        auto M = ocean_mask.star(i, j);
+          // label the shelf cells adjacent to the ice front with 1
+          auto M = ocean_mask.star(i, j);
 
-        if (M.n == 2 or M.e == 2 or M.s == 2 or M.w == 2) {
-          // i.e. there is a neighboring open ocean cell
-          result(i, j) = 1;
-        } else {
-          result(i, j) = 0;
+          if (M.n == 2 or M.e == 2 or M.s == 2 or M.w == 2) {
+            // i.e. there is a neighboring open ocean cell
+            m_tmp(i, j) = 1;
+          } else {
+            m_tmp(i, j) = 0;
+          }
         }
       }
+    } catch (...) {
+      loop.failed();
     }
-  } catch (...) {
-    loop.failed();
+    loop.check();
+  }
+
+  // See the matching check in compute_distances_gl().
+  if (not update_cached_field(m_tmp, m_distance_cf_seeds)) {
+    return;
   }
-  loop.check();
 
-  result.update_ghosts();
+  result.copy_from(m_tmp);      // copies owned values and updates ghosts
 
   profiling().begin("ocean.eikonal_equation");
   eikonal_equation(result);
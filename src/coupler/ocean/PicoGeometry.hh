@@ -115,6 +115,17 @@ private:
   // temporary storage (ghosted to use with the connected component labeling code)
   array::Scalar1 m_tmp;
 
+  // copies of the inputs used during the last update (used to avoid re-computing masks
+  // when the ice geometry did not change)
+  array::Scalar m_old_bed_elevation;
+  array::Scalar m_old_cell_type;
+  bool m_outputs_valid;
+
+  // "seed" fields used by the last distance computations (used to skip the Eikonal solves
+  // when the grounding line and the calving front did not move)
+  array::Scalar m_distance_gl_seeds;
+  array::Scalar m_distance_cf_seeds;
+
   int m_n_basins;
   std::vector<std::set<int> > m_basin_neighbors;
 };
@@ -0,0 +1,77 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <algorithm>            // std::min
+
+#include "pism/coupler/ocean/sea_level/Cache.hh"
+#include "pism/util/Grid.hh"
+#include "pism/util/MaxTimestep.hh"
+#include "pism/util/Time.hh"
+#include "pism/util/Logger.hh"
+
+namespace pism {
+namespace ocean {
+namespace sea_level {
+
+Cache::Cache(std::shared_ptr<const Grid> grid, std::shared_ptr<SeaLevel> in)
+  : SeaLevel(grid, in),
+    m_timer(time(), *m_config, "sea_level") {
+  // empty
+}
+
+void Cache::init_impl(const Geometry &geometry) {
+  m_input_model->init(geometry);
+
+  m_log->message(2,
+                 "* Initializing the 'caching' sea level forcing modifier...\n");
+
+  m_timer.reset(time().current());
+}
+
+void Cache::update_impl(const Geometry &geometry, double t, double dt) {
+  // ignore dt and always use 1 year long time-steps when updating
+  // an input model
+  (void) dt;
+
+  if (not m_timer.expired(t)) {
+    return;
+  }
+
+  m_input_model->update(geometry, t, m_timer.update_dt(t));
+
+  m_timer.advance();
+
+  // Store the output of the input model, leaving it (and its state counter) untouched if
+  // it did not change.
+  update_cached_field(m_input_model->elevation(), m_sea_level);
+}
+
+MaxTimestep Cache::max_timestep_impl(double t) const {
+  MaxTimestep cache_dt = m_timer.max_timestep(t, "sea level cache");
+
+  MaxTimestep input_max_timestep = m_input_model->max_timestep(t);
+  if (input_max_timestep.finite()) {
+    return std::min(input_max_timestep, cache_dt);
+  }
+  return cache_dt;
+}
+
+} // end of namespace sea_level
+} // end of namespace ocean
+} // end of namespace pism
@@ -0,0 +1,52 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef PISM_SEA_LEVEL_CACHE_H
+#define PISM_SEA_LEVEL_CACHE_H
+
+#include "pism/coupler/SeaLevel.hh"
+#include "pism/coupler/util/caching.hh"
+
+namespace pism {
+namespace ocean {
+namespace sea_level {
+
+//! Update an expensive sea level forcing on a coarse cadence, serving a cached sea level
+//! elevation in between.
+class Cache : public SeaLevel {
+public:
+  Cache(std::shared_ptr<const Grid> g, std::shared_ptr<SeaLevel> in);
+  virtual ~Cache() = default;
+
+private:
+  void init_impl(const Geometry &geometry);
+  void update_impl(const Geometry &geometry, double t, double dt);
+
+  MaxTimestep max_timestep_impl(double t) const;
+
+  CacheTimer m_timer;
+
+  // cached sea level elevation is stored in m_sea_level (inherited from SeaLevel)
+};
+
+} // end of namespace sea_level
+} // end of namespace ocean
+} // end of namespace pism
+
+#endif /* PISM_SEA_LEVEL_CACHE_H */
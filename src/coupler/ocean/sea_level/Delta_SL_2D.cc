@@ -29,7 +29,11 @@ namespace ocean {
 namespace sea_level {
 
 Delta_SL_2D::Delta_SL_2D(std::shared_ptr<const Grid> grid, std::shared_ptr<SeaLevel> in)
-  : SeaLevel(grid, in) {
+  : SeaLevel(grid, in),
+    m_update_tolerance(m_config->get_number("ocean.delta_sl_2d.update_tolerance")),
+    m_t_last(0.0),
+    m_dt_last(0.0),
+    m_interval_set(false) {
 
   ForcingOptions opt(*m_grid->ctx(), "ocean.delta_sl_2d");
 
@@ -66,8 +70,22 @@ void Delta_SL_2D::init_impl(const Geometry &geometry) {
 void Delta_SL_2D::update_impl(const Geometry &geometry, double t, double dt) {
   m_input_model->update(geometry, t, dt);
 
-  m_forcing->update(t, dt);
-  m_forcing->average(t, dt);
+  // Skip re-reading and re-interpolating the offsets if they are guaranteed to be
+  // within the tolerance of the ones computed during the last actual update. (Note that
+  // the comparison is always with the *last computed* offsets, so errors do not
+  // accumulate.) This check has to happen before the update() call below: update() uses
+  // the 2D part of m_forcing as scratch space when it refills the buffer.
+  bool skip = (m_update_tolerance > 0.0 and m_interval_set and
+               m_forcing->max_change(m_t_last, m_dt_last, t, dt) <= m_update_tolerance);
+
+  if (not skip) {
+    m_forcing->update(t, dt);
+    m_forcing->average(t, dt);
+
+    m_t_last       = t;
+    m_dt_last      = dt;
+    m_interval_set = true;
+  }
 
   m_input_model->elevation().add(1.0, *m_forcing, m_sea_level);
 }
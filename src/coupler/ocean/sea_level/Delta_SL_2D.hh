@@ -42,6 +42,15 @@ private:
   void update_impl(const Geometry &geometry, double t, double dt);
 
   std::shared_ptr<array::Forcing> m_forcing;
+
+  //! tolerance used to skip re-interpolation of slowly-varying offsets; see
+  //! ocean.delta_sl_2d.update_tolerance
+  double m_update_tolerance;
+
+  //! interval passed to the last actual update of m_forcing (valid if
+  //! m_interval_set is true)
+  double m_t_last, m_dt_last;
+  bool m_interval_set;
 };
 
 } // end of namespace sea_level
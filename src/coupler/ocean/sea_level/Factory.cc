@@ -21,6 +21,7 @@
 
 // ocean models:
 #include "pism/coupler/SeaLevel.hh"
+#include "pism/coupler/ocean/sea_level/Cache.hh"
 #include "pism/coupler/ocean/sea_level/Delta_SL.hh"
 #include "pism/coupler/ocean/sea_level/Delta_SL_2D.hh"
 
@@ -33,6 +34,7 @@ Factory::Factory(std::shared_ptr<const Grid> grid)
 
   add_model<SeaLevel>("constant");
 
+  add_modifier<Cache>("cache");
   add_modifier<Delta_SL>("delta_sl");
   add_modifier<Delta_SL_2D>("delta_sl_2d");
 }
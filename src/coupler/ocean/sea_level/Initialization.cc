@@ -37,7 +37,13 @@ InitializationHelper::InitializationHelper(std::shared_ptr<const Grid> grid,
 void InitializationHelper::update_impl(const Geometry &geometry, double t, double dt) {
   SeaLevel::update_impl(geometry, t, dt);
 
-  m_sea_level.copy_from(m_input_model->elevation());
+  const array::Scalar &sea_level = m_input_model->elevation();
+
+  // Skip the copy if the input model reports (via state counters) that its output did not
+  // change since the last update.
+  if (m_input_revisions.changed({ &sea_level })) {
+    m_sea_level.copy_from(sea_level);
+  }
 }
 
 void InitializationHelper::init_impl(const Geometry &geometry) {
@@ -44,6 +44,9 @@ private:
   void init_impl(const Geometry &geometry);
 
   const array::Scalar& sea_level_elevation_impl() const;
+
+  // revision of the input model's output (used to skip the copy in update_impl())
+  InputRevisions m_input_revisions;
 };
 
 } // end of namespace sea_level
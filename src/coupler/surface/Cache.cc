@@ -1,4 +1,4 @@
-/* Copyright (C) 2013, 2014, 2015, 2016, 2017, 2018, 2019, 2020, 2021, 2022, 2023, 2025 PISM Authors
+/* Copyright (C) 2013, 2014, 2015, 2016, 2017, 2018, 2019, 2020, 2021, 2022, 2023, 2025, 2026 PISM Authors
  *
  * This file is part of PISM.
  *
@@ -17,14 +17,12 @@
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
-#include <cmath>                // fabs()
 #include <cassert>
 #include <algorithm>            // for std::min()
 
 #include "pism/coupler/surface/Cache.hh"
 #include "pism/util/Time.hh"
 #include "pism/util/Grid.hh"
-#include "pism/util/error_handling.hh"
 #include "pism/util/MaxTimestep.hh"
 #include "pism/util/Logger.hh"
 
@@ -32,19 +30,8 @@ namespace pism {
 namespace surface {
 
 Cache::Cache(std::shared_ptr<const Grid> grid, std::shared_ptr<SurfaceModel> in)
-  : SurfaceModel(grid, in) {
-
-  m_next_update_time = time().current();
-  m_update_interval_years = m_config->get_number("surface.cache.update_interval", "seconds");
-
-  // use the current year length (according to the selected calendar) to convert update
-  // interval length into years
-  m_update_interval_years = time().convert_time_interval(m_update_interval_years, "years");
-
-  if (m_update_interval_years <= 0) {
-    throw RuntimeError::formatted(PISM_ERROR_LOCATION,
-                                  "surface.cache.update_interval has to be strictly positive.");
-  }
+  : SurfaceModel(grid, in),
+    m_timer(time(), *m_config, "surface") {
 
   {
     m_mass_flux             = allocate_mass_flux(grid);
@@ -63,7 +50,7 @@ void Cache::init_impl(const Geometry &geometry) {
 
   m_log->message(2, "* Initializing the 'caching' surface model modifier...\n");
 
-  m_next_update_time = time().current();
+  m_timer.reset(time().current());
 }
 
 void Cache::update_impl(const Geometry &geometry, double t, double dt) {
@@ -71,50 +58,30 @@ void Cache::update_impl(const Geometry &geometry, double t, double dt) {
   // the input model
   (void) dt;
 
-  double time_resolution = m_config->get_number("time_stepping.resolution", "seconds");
-  if (t >= m_next_update_time or fabs(t - m_next_update_time) < time_resolution) {
-
-    double
-      one_year_from_now = time().increment_date(t, 1.0),
-      update_dt         = one_year_from_now - t;
-
-    assert(update_dt > 0.0);
+  if (not m_timer.expired(t)) {
+    return;
+  }
 
-    m_input_model->update(geometry, t, update_dt);
+  m_input_model->update(geometry, t, m_timer.update_dt(t));
 
-    m_next_update_time = time().increment_date(m_next_update_time,
-                                                               m_update_interval_years);
+  m_timer.advance();
 
-    // store outputs of the input model
-    m_mass_flux->copy_from(m_input_model->mass_flux());
-    m_temperature->copy_from(m_input_model->temperature());
-    m_liquid_water_fraction->copy_from(m_input_model->liquid_water_fraction());
-    m_layer_mass->copy_from(m_input_model->layer_mass());
-    m_layer_thickness->copy_from(m_input_model->layer_thickness());
-    m_accumulation->copy_from(m_input_model->accumulation());
-    m_melt->copy_from(m_input_model->melt());
-    m_runoff->copy_from(m_input_model->runoff());
-  }
+  // Store outputs of the input model, leaving fields that did not change (and their state
+  // counters) untouched.
+  update_cached_field(m_input_model->mass_flux(), *m_mass_flux);
+  update_cached_field(m_input_model->temperature(), *m_temperature);
+  update_cached_field(m_input_model->liquid_water_fraction(), *m_liquid_water_fraction);
+  update_cached_field(m_input_model->layer_mass(), *m_layer_mass);
+  update_cached_field(m_input_model->layer_thickness(), *m_layer_thickness);
+  update_cached_field(m_input_model->accumulation(), *m_accumulation);
+  update_cached_field(m_input_model->melt(), *m_melt);
+  update_cached_field(m_input_model->runoff(), *m_runoff);
 }
 
 MaxTimestep Cache::max_timestep_impl(double t) const {
-  double dt = m_next_update_time - t;
-
-  double time_resolution = m_config->get_number("time_stepping.resolution", "seconds");
-
-  // if we got very close to the next update time, set time step
-  // length to the interval between updates
-  if (dt < time_resolution) {
-    double update_time_after_next = time().increment_date(m_next_update_time,
-                                                                          m_update_interval_years);
-
-    dt = update_time_after_next - m_next_update_time;
-    assert(dt > 0.0);
-  }
-
   assert(m_input_model != NULL);
 
-  MaxTimestep cache_dt(dt, "surface cache");
+  MaxTimestep cache_dt = m_timer.max_timestep(t, "surface cache");
 
   MaxTimestep input_max_timestep = m_input_model->max_timestep(t);
   if (input_max_timestep.finite()) {
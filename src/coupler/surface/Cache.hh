@@ -21,6 +21,7 @@
 #define _PSCACHE_H_
 
 #include "pism/coupler/SurfaceModel.hh"
+#include "pism/coupler/util/caching.hh"
 
 namespace pism {
 namespace surface {
@@ -49,8 +50,7 @@ protected:
   std::shared_ptr<array::Scalar> m_mass_flux;
   std::shared_ptr<array::Scalar> m_temperature;
 
-  double m_next_update_time;
-  double m_update_interval_years;
+  CacheTimer m_timer;
 };
 
 } // end of namespace surface
@@ -281,6 +281,7 @@ void DEBMSimple::update_impl(const Geometry &geometry, double t, double dt) {
   const double dtseries = dt / N;
   std::vector<double> ts(N), T(N), S(N), P(N), Alb(N);
   std::vector<DEBMSimpleOrbitalParameters> orbital(N);
+  std::vector<DEBMSimpleMelt> factors(N);
 
   for (int k = 0; k < N; ++k) {
     ts[k] = t + k * dtseries;
@@ -396,6 +397,14 @@ void DEBMSimple::update_impl(const Geometry &geometry, double t, double dt) {
 
         auto cell_type = static_cast<MaskValue>(mask.as_int(i, j));
 
+        bool ice_free_ocean = mask::ice_free_ocean(cell_type);
+        if (not ice_free_ocean) {
+          // pre-compute the albedo-independent parts of the melt equation for all
+          // substeps at this location (this pulls the expensive transcendental math out
+          // of the substep loop below)
+          m_model.melt_factors(orbital, dtseries, S, T, surfelev, latitude, factors);
+        }
+
         double
           A   = 0.0,            // accumulation
           M   = 0.0,            // melt
@@ -419,16 +428,10 @@ void DEBMSimple::update_impl(const Geometry &geometry, double t, double dt) {
           auto accumulation = P[k] * dtseries;
 
           DEBMSimpleMelt melt_info{};
-          if (not mask::ice_free_ocean(cell_type)) {
-
-            melt_info = m_model.melt(orbital[k].solar_declination,
-                                     orbital[k].distance_factor,
-                                     dtseries,
-                                     S[k],
-                                     T[k],
-                                     surfelev,
-                                     latitude,
-                                     (bool)m_input_albedo ? Alb[k] : albedo);
+          if (not ice_free_ocean) {
+            melt_info = m_model.finalize_melt(factors[k],
+                                              T[k],
+                                              (bool)m_input_albedo ? Alb[k] : albedo);
           }
 
           auto changes = m_model.step(ice_thickness,
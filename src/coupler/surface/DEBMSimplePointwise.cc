@@ -409,7 +409,7 @@ DEBMSimpleOrbitalParameters DEBMSimplePointwise::orbital_parameters(double time)
     distance_factor   = distance_factor_present_day(year_fraction);
   }
 
-  return { solar_declination, distance_factor };
+  return { solar_declination, distance_factor, sin(solar_declination), cos(solar_declination) };
 }
 
 
@@ -490,6 +490,110 @@ DEBMSimpleMelt DEBMSimplePointwise::melt(double declination,
   return result;
 }
 
+/*!
+ * Pre-compute the albedo-independent parts of the melt equation for all substeps at one
+ * map-plane location.
+ *
+ * For each substep `k` this sets `result[k].temperature_melt` and `result[k].offset_melt`
+ * to the corresponding melt amounts and `result[k].insolation_melt` to the
+ * insolation-driven melt *per unit* `1 - albedo`; `result[k].total_melt` is left at zero.
+ * Use finalize_melt() to apply the albedo at a substep and compute the total.
+ *
+ * Calling this once per location and then finalize_melt() once per substep is equivalent
+ * to calling melt() once per substep, but pulls the expensive transcendental math out of
+ * the sequential substep loop: the albedo at a substep depends on the melt during the
+ * previous one (see DEBMSimple::update_impl()), while the quantities computed here do
+ * not, so the loop below has no dependencies between iterations.
+ *
+ * @param[in] orbital orbital parameters, one entry per substep (see orbital_parameters())
+ * @param[in] dt substep length (seconds)
+ * @param[in] T_std_deviation standard deviations of the near-surface air temperature (kelvin)
+ * @param[in] T near-surface air temperatures (kelvin)
+ * @param[in] surface_elevation surface elevation (meters)
+ * @param[in] latitude latitude (degrees north)
+ * @param[out] result melt factors, one entry per substep
+ */
+void DEBMSimplePointwise::melt_factors(const std::vector<DEBMSimpleOrbitalParameters> &orbital,
+                                       double dt,
+                                       const std::vector<double> &T_std_deviation,
+                                       const std::vector<double> &T,
+                                       double surface_elevation,
+                                       double latitude,
+                                       std::vector<DEBMSimpleMelt> &result) const {
+  assert(dt > 0.0);
+
+  size_t N = orbital.size();
+  assert(T_std_deviation.size() >= N and T.size() >= N);
+
+  result.resize(N);
+
+  const double degrees_to_radians = M_PI / 180.0;
+  double latitude_rad = latitude * degrees_to_radians;
+
+  // quantities that depend on the location and not on the substep:
+  double transmissivity = atmosphere_transmissivity(surface_elevation);
+  double sin_phi        = sin(m_phi);
+  double sin_lat        = sin(latitude_rad);
+  double cos_lat        = cos(latitude_rad);
+
+  const double eps = 1.0e-4;
+
+  for (size_t k = 0; k < N; ++k) {
+    // hour_angle(), using sines and cosines of the declination tabulated once per substep
+    // in orbital_parameters():
+    double cos_h_phi = ((sin_phi - sin_lat * orbital[k].sin_declination) /
+                        (cos_lat * orbital[k].cos_declination));
+    double h_phi     = acos(pism::clip(cos_h_phi, -1.0, 1.0));
+
+    // insolation(), written in terms of the same tabulated values:
+    double insolation = 0.0;
+    if (h_phi != 0.0) {
+      insolation = ((m_solar_constant / h_phi) * orbital[k].distance_factor *
+                    (h_phi * sin_lat * orbital[k].sin_declination +
+                     cos_lat * orbital[k].cos_declination * sin(h_phi)));
+    }
+
+    double Teff = CalovGreveIntegrand(T_std_deviation[k],
+                                      T[k] - m_positive_threshold_temperature);
+    if (Teff < eps) {
+      Teff = 0;
+    }
+
+    // Note that in the line below we replace "Delta_t_Phi / Delta_t" with "h_Phi / pi".
+    // See equations 1 and 2 in Zeitz et al.
+    double A = dt * (h_phi / M_PI / (m_water_density * m_L));
+
+    result[k].insolation_melt  = A * transmissivity * insolation; // see finalize_melt()
+    result[k].temperature_melt = A * m_melt_c1 * Teff;
+    result[k].offset_melt      = A * m_melt_c2;
+    result[k].total_melt       = 0.0;
+  }
+}
+
+/*!
+ * Combine pre-computed melt factors (see melt_factors()) with the current albedo to get
+ * the melt amount and its components over a substep.
+ *
+ * The result is equivalent to the one produced by melt().
+ */
+DEBMSimpleMelt DEBMSimplePointwise::finalize_melt(const DEBMSimpleMelt &factors, double T,
+                                                  double albedo) const {
+  DEBMSimpleMelt result = factors;
+
+  result.insolation_melt *= (1.0 - albedo);
+
+  double total_melt = (result.insolation_melt + result.temperature_melt +
+                       result.offset_melt);
+  // this model should not produce negative melt rates
+  result.total_melt = std::max(total_melt, 0.0);
+
+  if (T < m_melt_threshold_temp) {
+    result.total_melt = 0.0;
+  }
+
+  return result;
+}
+
 /*! @brief Compute the surface mass balance at a location from the amount of melted snow
  *  and the solid accumulation amount in a time interval.
  *
@@ -21,6 +21,7 @@
 
 #include <memory>
 #include <array>
+#include <vector>
 
 #include "pism/util/Mask.hh"
 #include "pism/util/ScalarForcing.hh"
@@ -59,6 +60,10 @@ struct DEBMSimpleOrbitalParameters {
   // Square of the ratio of the mean sun-earth distance to the current sun-earth distance
   // (d_bar / d)^2
   double distance_factor;
+  // Sine and cosine of the solar declination, tabulated here so that per-location code
+  // (see DEBMSimplePointwise::melt_factors()) does not have to re-compute them.
+  double sin_declination;
+  double cos_declination;
 };
 
 //! A dEBM-simple implementation
@@ -86,6 +91,16 @@ public:
                       double lat,
                       double albedo) const;
 
+  void melt_factors(const std::vector<DEBMSimpleOrbitalParameters> &orbital,
+                    double dt,
+                    const std::vector<double> &T_std_deviation,
+                    const std::vector<double> &T,
+                    double surface_elevation,
+                    double lat,
+                    std::vector<DEBMSimpleMelt> &result) const;
+
+  DEBMSimpleMelt finalize_melt(const DEBMSimpleMelt &factors, double T, double albedo) const;
+
   DEBMSimpleChanges step(double ice_thickness, double max_melt, double snow_depth,
                          double accumulation) const;
 
@@ -18,7 +18,6 @@
 
 #include "pism/coupler/surface/ElevationChange.hh"
 #include "pism/coupler/util/options.hh"
-#include "pism/coupler/util/lapse_rates.hh"
 #include "pism/geometry/Geometry.hh"
 #include "pism/util/array/Forcing.hh"
 #include "pism/util/Logger.hh"
@@ -107,30 +106,37 @@ void ElevationChange::update_impl(const Geometry &geometry, double t, double dt)
   const array::Scalar &surface = geometry.ice_surface_elevation;
 
   m_temperature->copy_from(m_input_model->temperature());
-  lapse_rate_correction(surface, *m_reference_surface,
-                        m_temp_lapse_rate, *m_temperature);
-
   m_mass_flux->copy_from(m_input_model->mass_flux());
 
+  // Apply both corrections in one pass over the grid: the elevation difference driving
+  // them is the same, so this reads the surface and the reference surface once per cell.
+  array::AccessScope list{ &surface, m_reference_surface.get(), m_temperature.get(),
+                           m_mass_flux.get() };
+
   switch (m_smb_method) {
   case SCALE:
     {
-      array::AccessScope list{&surface, m_reference_surface.get(), m_mass_flux.get()};
-
       for (auto p : m_grid->points()) {
         const int i = p.i(), j = p.j();
 
         double dT = -m_temp_lapse_rate * (surface(i, j) - (*m_reference_surface)(i, j));
 
-        (*m_mass_flux)(i, j) *= exp(m_smb_exp_factor * dT);
+        (*m_temperature)(i, j) += dT;
+        (*m_mass_flux)(i, j)   *= exp(m_smb_exp_factor * dT);
       }
     }
     break;
   default:
   case SHIFT:
     {
-      lapse_rate_correction(surface, *m_reference_surface,
-                            m_smb_lapse_rate, *m_mass_flux);
+      for (auto p : m_grid->points()) {
+        const int i = p.i(), j = p.j();
+
+        double dh = surface(i, j) - (*m_reference_surface)(i, j);
+
+        (*m_temperature)(i, j) -= m_temp_lapse_rate * dh;
+        (*m_mass_flux)(i, j)   -= m_smb_lapse_rate * dh;
+      }
     }
     break;
   }
@@ -104,6 +104,11 @@ void Given::update_impl(const Geometry &geometry, double t, double dt) {
 
 }
 
+void Given::prefetch_impl(double t, double dt) const {
+  m_mass_flux->prefetch(t, dt);
+  m_temperature->prefetch(t, dt);
+}
+
 const array::Scalar &Given::mass_flux_impl() const {
   return *m_mass_flux;
 }
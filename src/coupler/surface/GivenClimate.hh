@@ -31,6 +31,7 @@ public:
 protected:
   void init_impl(const Geometry &geometry);
   void update_impl(const Geometry &geometry, double t, double dt);
+  void prefetch_impl(double t, double dt) const;
 
   const array::Scalar &temperature_impl() const;
   const array::Scalar &mass_flux_impl() const;
@@ -169,6 +169,16 @@ void ISMIP6::update_impl(const Geometry &geometry, double t, double dt) {
 
   // get time-dependent input fields at the current time
   {
+    // If prefetching is enabled, this schedules reads of the records needed by all four
+    // fields at once, so their prefetch threads load them concurrently and the blocking
+    // update() calls below find most records in memory already. All four variables come
+    // from the same file and share its time axis, so these requests cover the same
+    // records.
+    aT.prefetch(t, dt);
+    aSMB.prefetch(t, dt);
+    dTdz.prefetch(t, dt);
+    dSMBdz.prefetch(t, dt);
+
     aT.update(t, dt);
     aSMB.update(t, dt);
     dTdz.update(t, dt);
@@ -188,8 +198,10 @@ void ISMIP6::update_impl(const Geometry &geometry, double t, double dt) {
   for (auto p : m_grid->points()) {
     const int i = p.i(), j = p.j();
 
-    SMB(i, j) = SMB_ref(i, j) + aSMB(i, j) + dSMBdz(i, j) * (h(i, j) - h_ref(i, j));
-    T(i, j)   = T_ref(i, j) + aT(i, j) + dTdz(i, j) * (h(i, j) - h_ref(i, j));
+    const double dh = h(i, j) - h_ref(i, j);
+
+    SMB(i, j) = SMB_ref(i, j) + aSMB(i, j) + dSMBdz(i, j) * dh;
+    T(i, j)   = T_ref(i, j) + aT(i, j) + dTdz(i, j) * dh;
   }
 
   dummy_accumulation(SMB, *m_accumulation);
@@ -197,6 +209,13 @@ void ISMIP6::update_impl(const Geometry &geometry, double t, double dt) {
   dummy_runoff(SMB, *m_runoff);
 }
 
+void ISMIP6::prefetch_impl(double t, double dt) const {
+  m_temperature_anomaly->prefetch(t, dt);
+  m_temperature_gradient->prefetch(t, dt);
+  m_mass_flux_anomaly->prefetch(t, dt);
+  m_mass_flux_gradient->prefetch(t, dt);
+}
+
 MaxTimestep ISMIP6::max_timestep_impl(double t) const {
   using std::min;
 
@@ -126,15 +126,30 @@ void InitializationHelper::init_impl(const Geometry &geometry) {
 void InitializationHelper::update_impl(const Geometry &geometry, double t, double dt) {
   m_input_model->update(geometry, t, dt);
 
-  // store outputs of the input model
-  m_mass_flux.copy_from(m_input_model->mass_flux());
-  m_temperature.copy_from(m_input_model->temperature());
-  m_liquid_water_fraction->copy_from(m_input_model->liquid_water_fraction());
-  m_layer_mass->copy_from(m_input_model->layer_mass());
-  m_layer_thickness->copy_from(m_input_model->layer_thickness());
-  m_accumulation->copy_from(m_input_model->accumulation());
-  m_melt->copy_from(m_input_model->melt());
-  m_runoff->copy_from(m_input_model->runoff());
+  const array::Scalar
+    &mass_flux             = m_input_model->mass_flux(),
+    &temperature           = m_input_model->temperature(),
+    &liquid_water_fraction = m_input_model->liquid_water_fraction(),
+    &layer_mass            = m_input_model->layer_mass(),
+    &layer_thickness       = m_input_model->layer_thickness(),
+    &accumulation          = m_input_model->accumulation(),
+    &melt                  = m_input_model->melt(),
+    &runoff                = m_input_model->runoff();
+
+  // Store outputs of the input model, skipping the copies if it reports (via state
+  // counters) that its outputs did not change since the last update.
+  if (m_input_revisions.changed({ &mass_flux, &temperature, &liquid_water_fraction,
+                                  &layer_mass, &layer_thickness, &accumulation, &melt,
+                                  &runoff })) {
+    m_mass_flux.copy_from(mass_flux);
+    m_temperature.copy_from(temperature);
+    m_liquid_water_fraction->copy_from(liquid_water_fraction);
+    m_layer_mass->copy_from(layer_mass);
+    m_layer_thickness->copy_from(layer_thickness);
+    m_accumulation->copy_from(accumulation);
+    m_melt->copy_from(melt);
+    m_runoff->copy_from(runoff);
+  }
 }
 
 const array::Scalar &InitializationHelper::layer_thickness_impl() const {
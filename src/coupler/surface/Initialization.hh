@@ -64,6 +64,9 @@ private:
   array::Scalar m_mass_flux;
   array::Scalar m_temperature;
   // the rest of the field are inherited from SurfaceModel
+
+  // revisions of the input model's outputs (used to skip the copies in update_impl())
+  InputRevisions m_input_revisions;
 };
 
 } // end of namespace surface
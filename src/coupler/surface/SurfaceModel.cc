@@ -351,6 +351,16 @@ MaxTimestep SurfaceModel::max_timestep_impl(double t) const {
   return MaxTimestep("surface model");
 }
 
+void SurfaceModel::prefetch_impl(double t, double dt) const {
+  if (m_atmosphere) {
+    m_atmosphere->prefetch(t, dt);
+  }
+
+  if (m_input_model) {
+    m_input_model->prefetch(t, dt);
+  }
+}
+
 /*!
  * Use the surface mass balance to compute dummy accumulation.
  *
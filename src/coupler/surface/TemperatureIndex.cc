@@ -238,6 +238,10 @@ void TemperatureIndex::update_impl(const Geometry &geometry, double t, double dt
   // change during the call
   FaustoGrevePDDObject *fausto_greve = m_faustogreve.get();
 
+  // non-NULL if the stochastic PDD scheme is in use; its counter-based RNG has to be
+  // told the grid cell and the time step it is sampling for
+  auto *randomized = dynamic_cast<PDDrandMassBalance*>(m_mbscheme.get());
+
   // update to ensure that temperature and precipitation time series are correct:
   m_atmosphere->update(geometry, t, dt);
 
@@ -359,6 +363,11 @@ void TemperatureIndex::update_impl(const Geometry &geometry, double t, double dt
           PDDs[k] = 0.0;
         }
       } else {
+        if (randomized != nullptr) {
+          // key the RNG on the global cell number and the time step start so that
+          // results do not depend on the domain decomposition
+          randomized->set_sample_location((uint64_t)j * m_grid->Mx() + i, t);
+        }
         m_mbscheme->get_PDDs(dtseries, S, T, // inputs
                              PDDs);          // output
       }
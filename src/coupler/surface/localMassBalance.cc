@@ -17,11 +17,11 @@
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include <cassert>
+#include <cstdint>              // uint64_t
+#include <cstring>              // memcpy(), used to get at the bits of a double
 #include <ctime>  // for time(), used to initialize random number gen
-#include <gsl/gsl_rng.h>
-#include <gsl/gsl_randist.h>
 #include <gsl/gsl_math.h>       // M_PI
-#include <cmath>                // for erfc() in CalovGreveIntegrand()
+#include <cmath>                // for exp(), sqrt(), etc in CalovGreveIntegrand()
 #include <algorithm>
 
 #include "pism/util/Config.hh"
@@ -90,15 +90,40 @@ This integral is used for the expected number of positive degree days. The user
 \f$\sigma\f$ by option `-pdd_std_dev`. Note that the integral is over a time interval of
 length `dt` instead of a whole year as stated in \ref CalovGreve05 . If `sigma` is zero,
 return the positive part of `TacC`.
- */
-static double CalovGreveIntegrand(double sigma, double TacC) {
 
-  if (sigma == 0) {
-    return std::max(TacC, 0.0);
+The complementary error function is evaluated using the polynomial approximation 7.1.26
+from Abramowitz and Stegun (1964); its maximum absolute error is 1.5e-7, i.e. orders of
+magnitude below the uncertainty of the PDD scheme itself. Unlike a libm erfc() call this
+is branch-free (ternaries compile to selects), so the loop in get_PDDs() calling this can
+be vectorized; the only remaining transcendental is one exp(), shared by both terms of
+the integrand.
+ */
+static inline double CalovGreveIntegrand(double sigma, double TacC) {
+
+  // Keep the computation below well-defined when sigma == 0; the result for that case
+  // is selected at the end.
+  const double s = sigma > 0.0 ? sigma : 1.0;
+
+  const double Z = TacC / (sqrt(2.0) * s);
+  const double E = exp(-Z * Z);
+
+  // erfc(|Z|) = P(1 / (1 + p |Z|)) * exp(-Z^2) (Abramowitz and Stegun, 7.1.26):
+  double erfc_abs = 0.0;
+  {
+    const double t = 1.0 / (1.0 + 0.3275911 * fabs(Z));
+    erfc_abs = t * (0.254829592 +
+               t * (-0.284496736 +
+               t * (1.421413741 +
+               t * (-1.453152027 +
+               t * 1.061405429)))) * E;
   }
+  // the approximation above is valid for non-negative arguments; use the symmetry
+  // erfc(-Z) = 2 - erfc(Z) to get erfc(-Z):
+  const double erfc_mZ = Z > 0.0 ? 2.0 - erfc_abs : erfc_abs;
 
-  const double Z = TacC / (sqrt(2.0) * sigma);
-  return (sigma / sqrt(2.0 * M_PI)) * exp(-Z*Z) + (TacC / 2.0) * erfc(-Z);
+  const double expectation = (sigma / sqrt(2.0 * M_PI)) * E + (TacC / 2.0) * erfc_mZ;
+
+  return sigma > 0.0 ? expectation : std::max(TacC, 0.0);
 }
 
 
@@ -289,21 +314,63 @@ PDDMassBalance::Changes PDDMassBalance::step(const DegreeDayFactors &ddf,
 }
 
 struct PDDrandMassBalance::Impl {
-  gsl_rng *rng;
+  //! RNG seed (0 in the repeatable case, wall clock time otherwise)
+  uint64_t seed;
+  //! global (decomposition-independent) number of the current grid cell
+  uint64_t cell;
+  //! start of the current time step, in seconds
+  double time;
 };
 
+//! The Threefry-2x64 block cipher from [\ref Salmon2011], used as a counter-based RNG.
 /*!
-Initializes the random number generator (RNG).  The RNG is GSL's recommended default,
-which seems to be "mt19937" and is DIEHARD (whatever that means ...). Seed with
-wall clock time in seconds in non-repeatable case, and with 0 in repeatable case.
+Maps a 128-bit counter `(c0, c1)` and a 128-bit key `(k0, k1)` to 128 pseudo-random bits
+`(r0, r1)`. Unlike a conventional RNG it keeps no state: a sample is a pure function of
+its counter and key, so samples can be drawn in any order (and on any MPI rank) with
+identical results. Uses the full 20 rounds recommended in [\ref Salmon2011].
+ */
+static inline void threefry2x64(uint64_t c0, uint64_t c1, uint64_t k0, uint64_t k1,
+                                uint64_t &r0, uint64_t &r1) {
+  static const unsigned int rotation[8] = {16, 42, 12, 31, 16, 32, 24, 21};
+
+  const uint64_t ks[3] = {k0, k1, k0 ^ k1 ^ 0x1BD11BDAA9FC1A22ULL};
+
+  uint64_t x0 = c0 + ks[0];
+  uint64_t x1 = c1 + ks[1];
+
+  for (unsigned int round = 0; round < 20; ++round) {
+    const unsigned int r = rotation[round % 8];
+
+    x0 += x1;
+    x1 = (x1 << r) | (x1 >> (64 - r));
+    x1 ^= x0;
+
+    if (round % 4 == 3) {
+      const unsigned int s = round / 4 + 1;
+      x0 += ks[s % 3];
+      x1 += ks[(s + 1) % 3] + s;
+    }
+  }
+
+  r0 = x0;
+  r1 = x1;
+}
+
+/*!
+Initializes the random number generator (RNG). The RNG is counter-based: instead of
+advancing a shared stream it computes every sample from (seed, grid cell, time), so
+results do not depend on the domain decomposition or on the order in which cells are
+processed. Seed with wall clock time in seconds in non-repeatable case, and with 0 in
+repeatable case.
  */
 PDDrandMassBalance::PDDrandMassBalance(std::shared_ptr<const Config> config, units::System::Ptr system,
                                        Kind kind)
   : PDDMassBalance(config, system),
     m_impl(new Impl)
 {
-  m_impl->rng = gsl_rng_alloc(gsl_rng_default);  // so m_impl->rng != NULL now
-  gsl_rng_set(m_impl->rng, kind == REPEATABLE ? 0 : time(0));
+  m_impl->seed = (kind == REPEATABLE ? 0 : time(0));
+  m_impl->cell = 0;
+  m_impl->time = 0.0;
 
   m_method = (kind == NOT_REPEATABLE
               ? "simulation of a random process"
@@ -312,13 +379,18 @@ PDDrandMassBalance::PDDrandMassBalance(std::shared_ptr<const Config> config, uni
 
 
 PDDrandMassBalance::~PDDrandMassBalance() {
-  if (m_impl->rng != NULL) {
-    gsl_rng_free(m_impl->rng);
-    m_impl->rng = NULL;
-  }
   delete m_impl;
 }
 
+//! Set the grid cell and the time step start used to key the RNG in get_PDDs().
+/*! `cell` has to be a decomposition-independent cell number (for example `j * Mx + i`
+  using global grid indexes) and `t` the start of the current time step, in seconds.
+ */
+void PDDrandMassBalance::set_sample_location(uint64_t cell, double t) {
+  m_impl->cell = cell;
+  m_impl->time = t;
+}
+
 
 /*! We need to compute simulated random temperature each actual \e
   day, or at least as close as we can reasonably get. Output `N` is
@@ -335,12 +407,19 @@ unsigned int PDDrandMassBalance::get_timeseries_length(double dt) {
   return std::max(static_cast<size_t>(ceil(dt / m_seconds_per_day)), (size_t)2);
 }
 
-/** 
+/**
  * Computes
  * \f[
  * \text{PDD} = \sum_{i=0}^{N-1} h_{\text{days}} \cdot \text{max}(T_i-T_{\text{threshold}}, 0).
  * \f]
- * 
+ *
+ * The temperature in each sub-interval is perturbed by N(0, S[k]) noise drawn with the
+ * counter-based RNG keyed on the (cell, time step) pair set by set_sample_location();
+ * the counter is (bit pattern of the sub-interval start time, k). All key and counter
+ * components are identical on every MPI rank, so this produces the same PDDs for any
+ * domain decomposition. Normal deviates are obtained from 128 Threefry output bits via
+ * the Box-Muller transform.
+ *
  * @param S \f$\sigma\f$ (standard deviation for daily temperature excursions)
  * @param dt_series time-series step, in seconds
  * @param T air temperature
@@ -358,12 +437,24 @@ void PDDrandMassBalance::get_PDDs(double dt_series,
   const size_t N = S.size();
 
   for (unsigned int k = 0; k < N; ++k) {
-    // average temperature in k-th interval
-    double T_k = T[k] + gsl_ran_gaussian(m_impl->rng, S[k]); // add random: N(0,sigma)
-
-    if (T_k > pdd_threshold_temp) {
-      PDDs[k] = h_days * (T_k - pdd_threshold_temp);
+    uint64_t time_bits = 0;
+    {
+      const double t_k = m_impl->time + k * dt_series;
+      memcpy(&time_bits, &t_k, sizeof(time_bits));
     }
+
+    uint64_t r0 = 0, r1 = 0;
+    threefry2x64(time_bits, k, m_impl->seed, m_impl->cell, r0, r1);
+
+    // convert the top 53 bits of each output word to uniform deviates: u1 in (0, 1]
+    // (safe as an argument of log()), u2 in [0, 1)
+    const double u1 = 1.0 - (r0 >> 11) * (1.0 / 9007199254740992.0);
+    const double u2 = (r1 >> 11) * (1.0 / 9007199254740992.0);
+
+    // average temperature in k-th interval: add random N(0, S[k]) noise
+    const double T_k = T[k] + S[k] * sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+
+    PDDs[k] = h_days * std::max(T_k - pdd_threshold_temp, 0.0);
   }
 }
 
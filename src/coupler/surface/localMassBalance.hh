@@ -19,6 +19,8 @@
 #ifndef __localMassBalance_hh
 #define __localMassBalance_hh
 
+#include <cstdint>              // uint64_t
+
 #include "pism/util/array/Scalar.hh"  // only needed for FaustoGrevePDDObject
 #include "pism/util/Config.hh"
 
@@ -166,14 +168,15 @@ protected:
 
 //! An alternative PDD implementation which simulates a random process to get the number of PDDs.
 /*!
-  Uses a GSL random number generator.  Significantly slower because new random numbers are
-  generated for each grid point.
+  Uses a counter-based (Threefry-style) random number generator: every sample is a pure
+  function of (seed, grid cell, sub-interval time), so results are bitwise identical for
+  any number of MPI ranks and the sampling loop over sub-intervals can be vectorized.
 
   The way the number of positive degree-days are used to produce a surface mass balance
   is identical to the base class PDDMassBalance.
 
   \note
-  A more realistic pattern for the variability of surface melting might have correlation 
+  A more realistic pattern for the variability of surface melting might have correlation
   with appropriate spatial and temporal ranges.
 */
 class PDDrandMassBalance : public PDDMassBalance {
@@ -188,6 +191,8 @@ public:
 
   virtual unsigned int get_timeseries_length(double dt);
 
+  void set_sample_location(uint64_t cell, double t);
+
   virtual void get_PDDs(double dt_series,
                         const std::vector<double> &S,
                         const std::vector<double> &T,
@@ -0,0 +1,130 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <cassert>
+#include <cmath>                // fabs()
+
+#include "pism/coupler/util/caching.hh"
+#include "pism/util/Config.hh"
+#include "pism/util/Grid.hh"
+#include "pism/util/Time.hh"
+#include "pism/util/array/Scalar.hh"
+#include "pism/util/error_handling.hh"
+#include "pism/util/pism_utilities.hh" // GlobalMax()
+
+namespace pism {
+
+CacheTimer::CacheTimer(const Time &time, const Config &config, const std::string &prefix)
+  : m_time(&time) {
+
+  m_next_update_time = time.current();
+  m_update_interval_years = config.get_number(prefix + ".cache.update_interval", "seconds");
+
+  // use the current year length (according to the selected calendar) to convert update
+  // interval length into years
+  m_update_interval_years = time.convert_time_interval(m_update_interval_years, "years");
+
+  if (m_update_interval_years <= 0.0) {
+    throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                  "%s.cache.update_interval has to be strictly positive (got %f)",
+                                  prefix.c_str(), m_update_interval_years);
+  }
+
+  m_time_resolution = config.get_number("time_stepping.resolution", "seconds");
+}
+
+//! Start the update schedule at the time `t` (usually the current time, in init()).
+void CacheTimer::reset(double t) {
+  m_next_update_time = t;
+}
+
+//! True if the input model should be updated at the time `t`.
+bool CacheTimer::expired(double t) const {
+  return t >= m_next_update_time or fabs(t - m_next_update_time) < m_time_resolution;
+}
+
+//! Length of the time step used to update the input model (one year, regardless of the
+//! length of the time step of the model using the cache).
+double CacheTimer::update_dt(double t) const {
+  double one_year_from_now = m_time->increment_date(t, 1.0);
+  double dt = one_year_from_now - t;
+
+  assert(dt > 0.0);
+
+  return dt;
+}
+
+//! Advance the next update time by one update interval.
+void CacheTimer::advance() {
+  m_next_update_time = m_time->increment_date(m_next_update_time, m_update_interval_years);
+}
+
+//! Maximum time step allowed by the update schedule at the time `t`.
+MaxTimestep CacheTimer::max_timestep(double t, const std::string &description) const {
+  double dt = m_next_update_time - t;
+
+  // if we got very close to the next update time, set time step
+  // length to the interval between updates
+  if (dt < m_time_resolution) {
+    double update_time_after_next = m_time->increment_date(m_next_update_time,
+                                                           m_update_interval_years);
+
+    dt = update_time_after_next - m_next_update_time;
+    assert(dt > 0.0);
+  }
+
+  return MaxTimestep(dt, description);
+}
+
+//! Copy `source` into `destination`, skipping the copy if the two fields are identical.
+/*!
+ * Returns true (and increments the state counter of `destination`) if `destination` was
+ * modified and false otherwise. This way consumers of fields served by a "cache" modifier
+ * can use the state counter mechanism (see array::Array) to skip work when a cached field
+ * did not change.
+ */
+bool update_cached_field(const array::Scalar &source, array::Scalar &destination) {
+  auto grid = source.grid();
+
+  int changed = 0;
+  {
+    array::AccessScope list{ &source, &destination };
+
+    for (auto p : grid->points()) {
+      const int i = p.i(), j = p.j();
+
+      if (destination(i, j) != source(i, j)) {
+        destination(i, j) = source(i, j);
+        changed = 1;
+      }
+    }
+  }
+
+  // make sure all ranks agree, so that update_ghosts() below is collective
+  changed = GlobalMax(grid->com, changed);
+
+  if (changed != 0) {
+    destination.update_ghosts();
+    destination.inc_state_counter();
+  }
+
+  return changed != 0;
+}
+
+} // end of namespace pism
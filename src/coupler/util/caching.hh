@@ -0,0 +1,66 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef PISM_COUPLER_CACHING_H
+#define PISM_COUPLER_CACHING_H
+
+#include <string>
+
+#include "pism/util/MaxTimestep.hh"
+
+namespace pism {
+
+class Time;
+class Config;
+
+namespace array {
+class Scalar;
+}
+
+//! Update cadence shared by the "cache" modifiers (`-ocean ...,cache`, etc).
+/*!
+ * Keeps track of the next time an expensive input model should be updated. The update
+ * interval is read from `<prefix>.cache.update_interval`.
+ */
+class CacheTimer {
+public:
+  CacheTimer(const Time &time, const Config &config, const std::string &prefix);
+
+  void reset(double t);
+
+  bool expired(double t) const;
+
+  double update_dt(double t) const;
+
+  void advance();
+
+  MaxTimestep max_timestep(double t, const std::string &description) const;
+
+private:
+  const Time *m_time;
+  double m_next_update_time;
+  double m_update_interval_years;
+  double m_time_resolution;
+};
+
+bool update_cached_field(const array::Scalar &source, array::Scalar &destination);
+
+} // end of namespace pism
+
+#endif /* PISM_COUPLER_CACHING_H */
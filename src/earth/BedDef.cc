@@ -45,6 +45,7 @@ BedDef::BedDef(std::shared_ptr<const Grid> grid, const std::string &model_name)
 {
   m_update_interval = m_config->get_number("bed_deformation.update_interval", "seconds");
   m_t_eps           = m_config->get_number("time_stepping.resolution", "seconds");
+  m_extrapolate     = m_config->get_flag("bed_deformation.extrapolate_between_updates");
 
   m_topg.metadata(0)
       .long_name("bedrock surface elevation")
@@ -241,6 +242,12 @@ void BedDef::update(const array::Scalar &ice_thickness, const array::Scalar &sea
       m_uplift.scale(1.0 / dt_beddef);
     }
     m_topg_last.copy_from(m_topg);
+  } else if (m_extrapolate and m_update_interval > 0.0) {
+    // Advance the bed using the uplift rate computed during the last full update. This
+    // does not affect results at update times: update_impl() re-computes the bed from the
+    // model state and the load is accumulated using m_topg_last, which is left untouched
+    // here. (Note: m_topg.add() updates ghosts and increments the state counter.)
+    m_topg.add(dt, m_uplift);
   }
 }
 
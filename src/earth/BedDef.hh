@@ -93,6 +93,9 @@ protected:
   //! Temporal resolution to use when checking whether it's time to update
   double m_t_eps;
 
+  //! If true, advance the bed between full updates using the last computed uplift rate
+  bool m_extrapolate;
+
   //! Name of the variable used to store the last update time.
   std::string m_time_name;
 
@@ -20,6 +20,7 @@
 #include "pism/earth/Given.hh"
 #include "pism/util/array/Forcing.hh"
 #include "pism/util/io/IO_Flags.hh"
+#include "pism/util/Time.hh"
 
 namespace pism {
 namespace bed {
@@ -63,6 +64,11 @@ void Given::init_impl(const InputOptions & /*opts*/, const array::Scalar & /*ice
     auto filename   = m_config->get_string("bed_deformation.given.file");
     bool periodic_p = false;
     m_topg_delta->init(filename, periodic_p);
+
+    // Fill the buffer now: this way the first update_impl() call finds the records it
+    // needs already in memory and later refills are read ahead of time (see
+    // input.forcing.prefetch) instead of blocking the run on NetCDF reads.
+    m_topg_delta->update(time().current(), 0.0);
   }
 }
 
@@ -83,5 +89,9 @@ void Given::update_impl(const array::Scalar & /*load*/, double t, double dt) {
   m_topg.inc_state_counter();
 }
 
+void Given::prefetch_impl(double t, double dt) const {
+  m_topg_delta->prefetch(t, dt);
+}
+
 } // end of namespace bed
 } // end of namespace pism
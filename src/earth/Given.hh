@@ -43,6 +43,8 @@ protected:
 
   void update_impl(const array::Scalar &load, double t, double dt);
 
+  void prefetch_impl(double t, double dt) const;
+
   array::Scalar m_topg_reference;
 
   std::shared_ptr<array::Forcing> m_topg_delta;
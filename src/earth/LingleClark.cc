@@ -26,6 +26,7 @@
 #include "pism/util/pism_utilities.hh"
 #include "pism/util/fftw_utilities.hh"
 #include "pism/earth/LingleClarkSerial.hh"
+#include "pism/earth/LingleClarkMPI.hh"
 #include "pism/util/Context.hh"
 #include <memory>
 
@@ -38,15 +39,11 @@ LingleClark::LingleClark(std::shared_ptr<const Grid> grid)
     m_relief(m_grid, "bed_relief"),
     m_elastic_displacement(grid, "elastic_bed_displacement") {
 
-  // A work vector. This storage is used to put thickness change on rank 0 and to get the plate
-  // displacement change back.
   m_total_displacement.metadata(0)
       .long_name(
           "total (viscous and elastic) displacement in the Lingle-Clark bed deformation model")
       .units("meters");
 
-  m_work0 = m_total_displacement.allocate_proc0_copy();
-
   m_relief.metadata(0)
       .long_name("bed relief relative to the modeled bed displacement")
       .units("meters");
@@ -57,7 +54,6 @@ LingleClark::LingleClark(std::shared_ptr<const Grid> grid)
       .long_name(
           "elastic part of the displacement in the Lingle-Clark bed deformation model; see :cite:`BLKfastearth`")
       .units("meters");
-  m_elastic_displacement0 = m_elastic_displacement.allocate_proc0_copy();
 
   const int
     Mx = m_grid->Mx(),
@@ -87,6 +83,18 @@ LingleClark::LingleClark(std::shared_ptr<const Grid> grid)
   // do not point to auxiliary coordinates "lon" and "lat".
   m_viscous_displacement->metadata()["coordinates"] = "";
 
+  if (m_config->get_flag("bed_deformation.lc.fftw_mpi")) {
+    // Distributed model: all ranks share the spectral work and there is no need for
+    // rank 0 copies of model fields.
+    m_mpi_model.reset(new LingleClarkMPI(m_log, *m_config, use_elastic_model,
+                                         m_grid, m_extended_grid));
+    return;
+  }
+
+  // Rank 0 storage used to pass the load to the serial deformation model and get bed
+  // displacement back.
+  m_work0                 = m_total_displacement.allocate_proc0_copy();
+  m_elastic_displacement0 = m_elastic_displacement.allocate_proc0_copy();
   m_viscous_displacement0 = m_viscous_displacement->allocate_proc0_copy();
 
   ParallelSection rank0(m_grid->com);
@@ -105,7 +113,8 @@ LingleClark::LingleClark(std::shared_ptr<const Grid> grid)
 
 LingleClark::~LingleClark() {
   // empty, but implemented here instead of using "= default" in the header to be able to
-  // use the forward declaration of LingleClarkSerial in LingleClark.hh
+  // use the forward declarations of LingleClarkSerial and LingleClarkMPI in
+  // LingleClark.hh
 }
 
 /*!
@@ -122,6 +131,18 @@ void LingleClark::bootstrap_impl(const array::Scalar &bed_elevation,
                                  const array::Scalar &ice_thickness,
                                  const array::Scalar &sea_level_elevation) {
 
+  if (m_mpi_model) {
+    m_load.set(0.0);
+    accumulate_load(bed_elevation, ice_thickness, sea_level_elevation, 1.0, m_load);
+
+    m_mpi_model->bootstrap(m_load, bed_uplift, *m_viscous_displacement,
+                           m_elastic_displacement, m_total_displacement);
+
+    // compute bed relief
+    m_topg.add(-1.0, m_total_displacement, m_relief);
+    return;
+  }
+
   auto load_proc0 = m_load.allocate_proc0_copy();
 
   auto &total_displacement = *m_work0;
@@ -175,6 +196,11 @@ void LingleClark::bootstrap_impl(const array::Scalar &bed_elevation,
 std::shared_ptr<array::Scalar> LingleClark::elastic_load_response_matrix() const {
   std::shared_ptr<array::Scalar> result(new array::Scalar(m_extended_grid, "lrm"));
 
+  if (m_mpi_model) {
+    m_mpi_model->compute_load_response_matrix(*result);
+    return result;
+  }
+
   int
     Nx = m_extended_grid->Mx(),
     Ny = m_extended_grid->My();
@@ -230,6 +256,17 @@ void LingleClark::init_impl(const InputOptions &opts, const array::Scalar &ice_t
   regrid("Lingle-Clark bed deformation model",
          m_elastic_displacement, REGRID_WITHOUT_REGRID_VARS);
 
+  if (m_mpi_model) {
+    // Now that viscous displacement and elastic displacement are finally initialized,
+    // compute the total displacement.
+    m_mpi_model->init(*m_viscous_displacement, m_elastic_displacement,
+                      m_total_displacement);
+
+    // compute bed relief
+    m_topg.add(-1.0, m_total_displacement, m_relief);
+    return;
+  }
+
   // Now that viscous displacement and elastic displacement are finally initialized,
   // put them on rank 0 and initialize the serial model itself.
   {
@@ -280,6 +317,15 @@ const array::Scalar& LingleClark::relief() const {
 void LingleClark::step(const array::Scalar &load_thickness,
                        double dt) {
 
+  if (m_mpi_model) {
+    m_mpi_model->step(dt, load_thickness, *m_viscous_displacement,
+                      m_elastic_displacement, m_total_displacement);
+
+    // Update bed elevation using bed displacement and relief.
+    m_total_displacement.add(1.0, m_relief, m_topg);
+    return;
+  }
+
   load_thickness.put_on_proc0(*m_work0);
 
   ParallelSection rank0(m_grid->com);
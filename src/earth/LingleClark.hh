@@ -28,8 +28,10 @@ namespace pism {
 namespace bed {
 
 class LingleClarkSerial;
+class LingleClarkMPI;
 
-//! A wrapper class around LingleClarkSerial.
+//! A wrapper class around LingleClarkSerial (and its distributed counterpart
+//! LingleClarkMPI, used if bed_deformation.lc.fftw_mpi is set).
 class LingleClark : public BedDef {
 public:
   LingleClark(std::shared_ptr<const Grid> g);
@@ -71,9 +73,15 @@ protected:
   //! Bed relief relative to the bed displacement.
   array::Scalar m_relief;
 
-  //! Serial viscoelastic bed deformation model.
+  //! Serial viscoelastic bed deformation model. Allocated on rank 0 only, unless the
+  //! distributed model is used.
   std::unique_ptr<LingleClarkSerial> m_serial_model;
 
+  //! Distributed (FFTW-MPI) viscoelastic bed deformation model. Allocated only if
+  //! bed_deformation.lc.fftw_mpi is set; in this case the serial model and the rank 0
+  //! copies of model fields are not allocated.
+  std::unique_ptr<LingleClarkMPI> m_mpi_model;
+
   //! extended grid for the viscous plate displacement
   std::shared_ptr<Grid> m_extended_grid;
 
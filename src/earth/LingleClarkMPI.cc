@@ -0,0 +1,756 @@
+// Copyright (C) 2025, 2026 PISM Authors
+//
+// This file is part of PISM.
+//
+// PISM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the Free Software
+// Foundation; either version 3 of the License, or (at your option) any later
+// version.
+//
+// PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License
+// along with PISM; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include <cmath>                // sqrt
+#include <cstdlib>              // abs
+#include <cstring>              // memcpy
+#include <gsl/gsl_math.h>       // M_PI
+
+#include "pism/pism_config.hh"  // Pism_USE_FFTW_MPI
+
+#if (Pism_USE_FFTW_MPI == 1)
+#include <fftw3-mpi.h>
+#endif
+
+#include "pism/earth/LingleClarkMPI.hh"
+#include "pism/earth/greens.hh"
+#include "pism/earth/matlablike.hh"
+
+#include "pism/util/Config.hh"
+#include "pism/util/Grid.hh"
+#include "pism/util/array/Scalar.hh"
+#include "pism/util/error_handling.hh"
+#include "pism/util/fftw_utilities.hh"
+#include "pism/util/petscwrappers/DM.hh"
+#include "pism/util/petscwrappers/IS.hh"
+#include "pism/util/pism_utilities.hh"
+
+namespace pism {
+namespace bed {
+
+#if (Pism_USE_FFTW_MPI == 1)
+
+/*!
+ * @param[in] log logger
+ * @param[in] config configuration database
+ * @param[in] include_elastic include elastic deformation component
+ * @param[in] grid the physical (PISM) grid
+ * @param[in] extended_grid the extended (spectral) grid
+ */
+LingleClarkMPI::LingleClarkMPI(std::shared_ptr<const Logger> log,
+                               const Config &config,
+                               bool include_elastic,
+                               std::shared_ptr<const Grid> grid,
+                               std::shared_ptr<const Grid> extended_grid)
+  : m_t_infty(1e16),            // around 317 million years
+    m_log(log) {
+
+  // set parameters
+  m_include_elastic = include_elastic;
+
+  if (include_elastic) {
+    // check if the extended grid is large enough (it has to be at least twice the size of
+    // the physical grid so that the load in one corner of the domain affects the grid
+    // point in the opposite corner).
+
+    if (config.get_number("bed_deformation.lc.grid_size_factor") < 2) {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                    "bed_deformation.lc.elastic_model"
+                                    " requires bed_deformation.lc.grid_size_factor > 1");
+    }
+  }
+
+  // grid parameters
+  m_grid          = grid;
+  m_extended_grid = extended_grid;
+  m_com           = grid->com;
+
+  m_Mx = (int)grid->Mx();
+  m_My = (int)grid->My();
+  m_dx = grid->dx();
+  m_dy = grid->dy();
+  m_Nx = (int)extended_grid->Mx();
+  m_Ny = (int)extended_grid->My();
+
+  m_load_density   = config.get_number("constants.ice.density");
+  m_mantle_density = config.get_number("bed_deformation.mantle_density");
+  m_eta            = config.get_number("bed_deformation.mantle_viscosity");
+  m_D              = config.get_number("bed_deformation.lithosphere_flexural_rigidity");
+
+  m_standard_gravity = config.get_number("constants.standard_gravity");
+
+  // derive more parameters
+  m_Lx        = 0.5 * (m_Nx - 1.0) * m_dx;
+  m_Ly        = 0.5 * (m_Ny - 1.0) * m_dy;
+  m_i0_offset = (m_Nx - m_Mx) / 2;
+  m_j0_offset = (m_Ny - m_My) / 2;
+
+  // setup fftw stuff: FFTW distributes the extended grid by blocks of contiguous rows
+  // (x indices)
+  fftw_mpi_init();
+
+  ptrdiff_t local_n0 = 0, local_0_start = 0;
+  ptrdiff_t alloc_local = fftw_mpi_local_size_2d(m_Nx, m_Ny, m_com,
+                                                 &local_n0, &local_0_start);
+  m_xs = (int)local_0_start;
+  m_xm = (int)local_n0;
+
+  m_fftw_input  = fftw_alloc_complex(alloc_local);
+  m_fftw_output = fftw_alloc_complex(alloc_local);
+  m_loadhat     = fftw_alloc_complex(alloc_local);
+  m_lrm_hat     = fftw_alloc_complex(alloc_local);
+
+  m_dft_forward = fftw_mpi_plan_dft_2d(m_Nx, m_Ny, m_fftw_input, m_fftw_output,
+                                       m_com, FFTW_FORWARD, FFTW_ESTIMATE);
+  m_dft_inverse = fftw_mpi_plan_dft_2d(m_Nx, m_Ny, m_fftw_input, m_fftw_output,
+                                       m_com, FFTW_BACKWARD, FFTW_ESTIMATE);
+
+  // Note: FFTW is weird. If a malloc() call fails it will just call
+  // abort() on you without giving you a chance to recover or tell the
+  // user what happened. This is why we don't check return values of
+  // fftw_alloc_complex() and fftw_mpi_plan_dft_2d() calls here...
+
+  // memory allocation: work vectors used to move data between PISM's domain
+  // decomposition and FFTW's slab distribution
+  PetscErrorCode ierr = 0;
+
+  ierr = VecCreateMPI(m_com, m_xm * m_Ny, m_Nx * m_Ny, m_slab.rawptr());
+  PISM_CHK(ierr, "VecCreateMPI");
+
+  ierr = DMDACreateNaturalVector(*grid->get_dm(1, 0), m_natural.rawptr());
+  PISM_CHK(ierr, "DMDACreateNaturalVector");
+
+  ierr = DMDACreateNaturalVector(*extended_grid->get_dm(1, 0),
+                                 m_natural_extended.rawptr());
+  PISM_CHK(ierr, "DMDACreateNaturalVector");
+
+  create_scatter(m_natural, m_Mx, m_My, m_i0_offset, m_j0_offset, m_scatter_center);
+  create_scatter(m_natural, m_Mx, m_My, 0, 0, m_scatter_corner);
+  create_scatter(m_natural, m_Mx, m_My, m_Nx / 2, m_Ny / 2, m_scatter_shifted);
+  create_scatter(m_natural_extended, m_Nx, m_Ny, 0, 0, m_scatter_extended);
+
+  precompute_coefficients();
+}
+
+LingleClarkMPI::~LingleClarkMPI() {
+  fftw_destroy_plan(m_dft_forward);
+  fftw_destroy_plan(m_dft_inverse);
+  fftw_free(m_fftw_input);
+  fftw_free(m_fftw_output);
+  fftw_free(m_loadhat);
+  fftw_free(m_lrm_hat);
+}
+
+/*!
+ * Create a scatter from a vector in PETSc's natural ordering (sub-domain size Mx*My) to
+ * m_slab, placing the sub-domain in the extended grid using offsets `i0` and `j0`.
+ *
+ * A vector in the natural ordering stores the value at (i, j) at the index j * Mx + i;
+ * m_slab stores the value at (i, j) of the extended grid at the index i * m_Ny + j,
+ * matching the layout of FFTW's arrays. (These layouts are transposes of each other;
+ * compare VecArray2D and FFTWArray.)
+ */
+void LingleClarkMPI::create_scatter(petsc::Vec &source, int Mx, int My, int i0, int j0,
+                                    petsc::VecScatter &result) {
+  (void) My;
+
+  PetscErrorCode ierr = 0;
+
+  PetscInt r0 = 0, r1 = 0;
+  ierr = VecGetOwnershipRange(source, &r0, &r1);
+  PISM_CHK(ierr, "VecGetOwnershipRange");
+
+  std::vector<PetscInt> indices(r1 - r0);
+  for (PetscInt n = r0; n < r1; ++n) {
+    PetscInt i = n % Mx, j = n / Mx;
+
+    indices[n - r0] = (i + i0) * m_Ny + (j + j0);
+  }
+
+  petsc::IS is_from, is_to;
+
+  ierr = ISCreateStride(m_com, r1 - r0, r0, 1, is_from.rawptr());
+  PISM_CHK(ierr, "ISCreateStride");
+
+  ierr = ISCreateGeneral(m_com, (PetscInt)indices.size(), indices.data(),
+                         PETSC_COPY_VALUES, is_to.rawptr());
+  PISM_CHK(ierr, "ISCreateGeneral");
+
+  ierr = VecScatterCreate(source, is_from, m_slab, is_to, result.rawptr());
+  PISM_CHK(ierr, "VecScatterCreate");
+}
+
+/*!
+ * Copy `input` into m_fftw_input (real part, scaled by `normalization`), embedding it in
+ * the extended grid using the provided scatter. Areas of the extended grid not covered
+ * by `input` are set to zero.
+ */
+void LingleClarkMPI::set_real_part(const array::Scalar &input, double normalization,
+                                   ::VecScatter scatter) {
+  PetscErrorCode ierr = 0;
+
+  auto grid = input.grid();
+  auto dm   = grid->get_dm(1, 0);
+
+  petsc::Vec &natural = grid == m_extended_grid ? m_natural_extended : m_natural;
+
+  ierr = DMDAGlobalToNaturalBegin(*dm, input.vec(), INSERT_VALUES, natural);
+  PISM_CHK(ierr, "DMDAGlobalToNaturalBegin");
+  ierr = DMDAGlobalToNaturalEnd(*dm, input.vec(), INSERT_VALUES, natural);
+  PISM_CHK(ierr, "DMDAGlobalToNaturalEnd");
+
+  ierr = VecSet(m_slab, 0.0);
+  PISM_CHK(ierr, "VecSet");
+
+  ierr = VecScatterBegin(scatter, natural, m_slab, INSERT_VALUES, SCATTER_FORWARD);
+  PISM_CHK(ierr, "VecScatterBegin");
+  ierr = VecScatterEnd(scatter, natural, m_slab, INSERT_VALUES, SCATTER_FORWARD);
+  PISM_CHK(ierr, "VecScatterEnd");
+
+  petsc::VecArray slab(m_slab);
+  const double *s = slab.get();
+
+  for (int k = 0; k < m_xm * m_Ny; ++k) {
+    m_fftw_input[k][0] = s[k] * normalization;
+    m_fftw_input[k][1] = 0.0;
+  }
+}
+
+/*!
+ * Copy the real part of `buffer` (this rank's part of a FFTW array, scaled by
+ * `normalization`) into m_slab.
+ */
+void LingleClarkMPI::buffer_to_slab(const fftw_complex *buffer, double normalization) {
+  petsc::VecArray slab(m_slab);
+  double *s = slab.get();
+
+  for (int k = 0; k < m_xm * m_Ny; ++k) {
+    s[k] = buffer[k][0] * normalization;
+  }
+}
+
+/*!
+ * Extract a part of the extended grid from m_slab (selected by the provided scatter) and
+ * copy it into `output`.
+ */
+void LingleClarkMPI::slab_to_grid(array::Scalar &output, ::VecScatter scatter) {
+  PetscErrorCode ierr = 0;
+
+  auto grid = output.grid();
+  auto dm   = grid->get_dm(1, 0);
+
+  petsc::Vec &natural = grid == m_extended_grid ? m_natural_extended : m_natural;
+
+  ierr = VecScatterBegin(scatter, m_slab, natural, INSERT_VALUES, SCATTER_REVERSE);
+  PISM_CHK(ierr, "VecScatterBegin");
+  ierr = VecScatterEnd(scatter, m_slab, natural, INSERT_VALUES, SCATTER_REVERSE);
+  PISM_CHK(ierr, "VecScatterEnd");
+
+  ierr = DMDANaturalToGlobalBegin(*dm, natural, INSERT_VALUES, output.vec());
+  PISM_CHK(ierr, "DMDANaturalToGlobalBegin");
+  ierr = DMDANaturalToGlobalEnd(*dm, natural, INSERT_VALUES, output.vec());
+  PISM_CHK(ierr, "DMDANaturalToGlobalEnd");
+
+  output.inc_state_counter();
+}
+
+/*!
+ * Compute this rank's rows of the load response matrix.
+ *
+ * The serial version computes the top left quarter of the matrix and obtains the rest
+ * using its symmetry. Mirroring in the x direction would require values owned by other
+ * ranks, so here each owned row is computed directly: the distances |Nx/2 - i| and
+ * |Ny/2 - j| determine the integrand in all four quarters.
+ */
+void LingleClarkMPI::fill_load_response_matrix(fftw_complex *output) {
+
+  FFTWArray LRM(output, m_xm, m_Ny);
+
+  greens_elastic G;
+  ge_data ge_data {m_dx, m_dy, 0, 0, &G};
+
+  int Nx2 = m_Nx / 2;
+  int Ny2 = m_Ny / 2;
+
+  for (int i = 0; i < m_xm; ++i) {
+    ge_data.p = std::abs(Nx2 - (m_xs + i));
+
+    // Left half of the row
+    for (int j = 0; j <= Ny2; ++j) {
+      ge_data.q = Ny2 - j;
+
+      LRM(i, j) = dblquad_cubature(ge_integrand,
+                                   -m_dx / 2, m_dx / 2,
+                                   -m_dy / 2, m_dy / 2,
+                                   1.0e-8, &ge_data);
+    }
+
+    // Right half: mirror values computed above (this is local to a row, i.e. to this
+    // rank). See the comments in LingleClarkSerial::compute_load_response_matrix() for
+    // why 0 <= 2 * Ny2 - j <= Ny2 - 1 both for even and odd m_Ny.
+    for (int j = Ny2 + 1; j < m_Ny; ++j) {
+      LRM(i, j) = LRM(i, 2 * Ny2 - j);
+    }
+  }
+}
+
+/**
+ * Pre-compute coefficients used by the model.
+ */
+void LingleClarkMPI::precompute_coefficients() {
+
+  // Coefficients for Fourier spectral method Laplacian
+  // MATLAB version:  cx=(pi/Lx)*[0:Nx/2 Nx/2-1:-1:1]
+  m_cx = fftfreq(m_Nx, m_Lx / (m_Nx * M_PI));
+  m_cy = fftfreq(m_Ny, m_Ly / (m_Ny * M_PI));
+
+  // compare geforconv.m
+  if (m_include_elastic) {
+    m_log->message(2, "     computing spherical elastic load response matrix ...");
+    {
+      fill_load_response_matrix(m_fftw_input);
+      // Compute fft2(LRM) and save this rank's part of it in m_lrm_hat
+      fftw_execute(m_dft_forward);
+      memcpy(m_lrm_hat, m_fftw_output, m_xm * m_Ny * sizeof(fftw_complex));
+    }
+    m_log->message(2, " done\n");
+  }
+}
+
+/*!
+ * Return the load response matrix for the elastic response (on the extended grid).
+ *
+ * This method is used for testing only.
+ */
+void LingleClarkMPI::compute_load_response_matrix(array::Scalar &result) {
+  fill_load_response_matrix(m_fftw_input);
+
+  buffer_to_slab(m_fftw_input, 1.0);
+
+  slab_to_grid(result, m_scatter_extended);
+}
+
+/*!
+ * Solve
+ *
+ * @f$ 2 \nu |\nabla| \diff{u}{t} + \rho_r g U + D\nabla^4 U = \sigma_{zz}@f$
+ *
+ * for @f$ U @f$, treating @f$ \diff{u}{t} @f$ and @f$ \sigma_{zz} @f$ as known.
+ *
+ * @param[in] load_thickness load thickness, meters
+ * @param[in] bed_uplift bed uplift, m/second
+ * @param[out] output viscous plate displacement on the extended grid
+ *
+ * Compare LingleClarkSerial::uplift_problem().
+ */
+void LingleClarkMPI::uplift_problem(const array::Scalar &load_thickness,
+                                    const array::Scalar &bed_uplift,
+                                    array::Scalar &output) {
+
+  // Compute fft2(-load_density * g * load_thickness)
+  {
+    set_real_part(load_thickness, - m_load_density * m_standard_gravity,
+                  m_scatter_center);
+    fftw_execute(m_dft_forward);
+    // Save this rank's part of fft2(-load_density * g * load_thickness) in loadhat.
+    memcpy(m_loadhat, m_fftw_output, m_xm * m_Ny * sizeof(fftw_complex));
+  }
+
+  // fft2(uplift)
+  {
+    set_real_part(bed_uplift, 1.0, m_scatter_center);
+    fftw_execute(m_dft_forward);
+  }
+
+  {
+    FFTWArray
+      u0_hat(m_fftw_input, m_xm, m_Ny),
+      load_hat(m_loadhat, m_xm, m_Ny),
+      uplift_hat(m_fftw_output, m_xm, m_Ny);
+
+    for (int i = 0; i < m_xm; i++) {
+      const double cx = m_cx[m_xs + i];
+      for (int j = 0; j < m_Ny; j++) {
+        const double
+          C = cx*cx + m_cy[j]*m_cy[j],
+          A = - 2.0 * m_eta * sqrt(C),
+          B = m_mantle_density * m_standard_gravity + m_D * C * C;
+
+        u0_hat(i, j) = (load_hat(i, j) + A * uplift_hat(i, j)) / B;
+      }
+    }
+  }
+
+  fftw_execute(m_dft_inverse);
+  buffer_to_slab(m_fftw_output, 1.0 / (m_Nx * m_Ny));
+
+  tweak(load_thickness, m_slab);
+
+  slab_to_grid(output, m_scatter_extended);
+}
+
+/*! Initialize using provided load thickness and the bed uplift rate.
+ *
+ * Here we solve:
+ *
+ *   rho_r g U + D grad^4 U = -rho g H - 2 eta |grad| uplift
+ *
+ * Compare equation (16) in Bueler, Lingle, Brown (2007) "Fast computation of a
+ * viscoelastic deformable Earth model for ice sheet simulations", Ann. Glaciol. 46,
+ * 97--105
+ *
+ * This initialization method is used to "bootstrap" the model. It should not be used to
+ * re-start a stopped modeling run.
+ *
+ * @param[in] thickness load thickness, meters
+ * @param[in] uplift initial bed uplift on the PISM grid
+ * @param[out] viscous_displacement viscous plate displacement on the extended grid
+ * @param[out] elastic_displacement elastic plate displacement on the PISM grid
+ * @param[out] total_displacement total plate displacement on the PISM grid
+ */
+void LingleClarkMPI::bootstrap(const array::Scalar &thickness,
+                               const array::Scalar &uplift,
+                               array::Scalar &viscous_displacement,
+                               array::Scalar &elastic_displacement,
+                               array::Scalar &total_displacement) {
+
+  // compute viscous displacement
+  uplift_problem(thickness, uplift, viscous_displacement);
+
+  if (m_include_elastic) {
+    compute_elastic_response(thickness, elastic_displacement);
+  } else {
+    elastic_displacement.set(0.0);
+  }
+
+  update_displacement(viscous_displacement, elastic_displacement, total_displacement);
+}
+
+/*!
+ * Initialize using provided plate displacement.
+ *
+ * @param[in] viscous_displacement initial viscous plate displacement (meters) on the
+ *                                 extended grid
+ * @param[in,out] elastic_displacement initial elastic plate displacement (meters) on the
+ *                                     regular grid; set to zero if the elastic model is
+ *                                     not used
+ * @param[out] total_displacement total plate displacement on the PISM grid
+ */
+void LingleClarkMPI::init(const array::Scalar &viscous_displacement,
+                          array::Scalar &elastic_displacement,
+                          array::Scalar &total_displacement) {
+  if (not m_include_elastic) {
+    elastic_displacement.set(0.0);
+  }
+
+  update_displacement(viscous_displacement, elastic_displacement, total_displacement);
+}
+
+/*!
+ * Perform a time step.
+ *
+ * @param[in] dt time step length
+ * @param[in] H load thickness on the physical (Mx*My) grid
+ * @param[in,out] viscous_displacement viscous plate displacement on the extended grid
+ * @param[in,out] elastic_displacement elastic plate displacement on the PISM grid
+ * @param[out] total_displacement total plate displacement on the PISM grid
+ */
+void LingleClarkMPI::step(double dt, const array::Scalar &H,
+                          array::Scalar &viscous_displacement,
+                          array::Scalar &elastic_displacement,
+                          array::Scalar &total_displacement) {
+  // solves:
+  //     (2 eta |grad| U^{n+1}) + (dt/2) * (rho_r g U^{n+1} + D grad^4 U^{n+1})
+  //   = (2 eta |grad| U^n) - (dt/2) * (rho_r g U^n + D grad^4 U^n) - dt * rho g H_start
+  // where U=plate displacement; see equation (7) in
+  // Bueler, Lingle, Brown (2007) "Fast computation of a viscoelastic
+  // deformable Earth model for ice sheet simulations", Ann. Glaciol. 46, 97--105
+
+  // Compute viscous displacement if dt > 0 and bypass this computation if dt == 0.
+  //
+  // This makes it easier to test the elastic part of the model.
+  if (dt > 0.0) {
+    // Non-zero time step: include the viscous part of the model.
+
+    // Compute fft2(-load_density * g * dt * H)
+    {
+      set_real_part(H, - m_load_density * m_standard_gravity * dt, m_scatter_center);
+      fftw_execute(m_dft_forward);
+
+      // Save this rank's part of fft2(-load_density * g * H * dt) in loadhat.
+      memcpy(m_loadhat, m_fftw_output, m_xm * m_Ny * sizeof(fftw_complex));
+    }
+
+    // Compute fft2(u).
+    {
+      set_real_part(viscous_displacement, 1.0, m_scatter_extended);
+      fftw_execute(m_dft_forward);
+    }
+
+    // frhs = right.*fft2(uun) + fft2(dt*sszz);
+    // uun1 = real(ifft2(frhs./left));
+    {
+      FFTWArray input(m_fftw_input, m_xm, m_Ny),
+        u_hat(m_fftw_output, m_xm, m_Ny), load_hat(m_loadhat, m_xm, m_Ny);
+      for (int i = 0; i < m_xm; i++) {
+        const double cx = m_cx[m_xs + i];
+        for (int j = 0; j < m_Ny; j++) {
+          const double
+            C     = cx*cx + m_cy[j]*m_cy[j],
+            part1 = 2.0 * m_eta * sqrt(C),
+            part2 = (dt / 2.0) * (m_mantle_density * m_standard_gravity + m_D * C * C),
+            A = part1 - part2,
+            B = part1 + part2;
+
+          input(i, j) = (load_hat(i, j) + A * u_hat(i, j)) / B;
+        }
+      }
+    }
+
+    fftw_execute(m_dft_inverse);
+    buffer_to_slab(m_fftw_output, 1.0 / (m_Nx * m_Ny));
+
+    // Now tweak. (See the "correction" in section 5 of BuelerLingleBrown.)
+    tweak(H, m_slab);
+
+    slab_to_grid(viscous_displacement, m_scatter_extended);
+  } else {
+    // zero time step: viscous displacement is zero
+    viscous_displacement.set(0.0);
+  }
+
+  // now compute elastic response if desired
+  if (m_include_elastic) {
+    compute_elastic_response(H, elastic_displacement);
+  }
+
+  update_displacement(viscous_displacement, elastic_displacement, total_displacement);
+}
+
+/*!
+ * Compute elastic response to the load H
+ *
+ * @param[in] H load thickness (ice equivalent meters)
+ * @param[out] dE elastic plate displacement
+ */
+void LingleClarkMPI::compute_elastic_response(const array::Scalar &H, array::Scalar &dE) {
+
+  // Compute fft2(load_density * H)
+  //
+  // Note that here the load is placed in the corner of the array on the extended grid
+  // (offsets i0 and j0 are zero).
+  {
+    set_real_part(H, m_load_density, m_scatter_corner);
+    fftw_execute(m_dft_forward);
+  }
+
+  // fft2(m_response_matrix) * fft2(load_density*H)
+  //
+  // Compute the product of Fourier transforms of the LRM and the load. This uses C++'s
+  // native support for complex arithmetic.
+  {
+    FFTWArray
+      input(m_fftw_input, m_xm, m_Ny),
+      LRM_hat(m_lrm_hat, m_xm, m_Ny),
+      load_hat(m_fftw_output, m_xm, m_Ny);
+    for (int i = 0; i < m_xm; i++) {
+      for (int j = 0; j < m_Ny; j++) {
+        input(i, j) = LRM_hat(i, j) * load_hat(i, j);
+      }
+    }
+  }
+
+  // Compute the inverse transform and extract the elastic response, using offsets
+  // i0 = m_Nx / 2 and j0 = m_Ny / 2 (the "shifted" scatter).
+  fftw_execute(m_dft_inverse);
+  buffer_to_slab(m_fftw_output, 1.0 / (m_Nx * m_Ny));
+
+  slab_to_grid(dE, m_scatter_shifted);
+}
+
+/*! Compute total displacement by combining viscous and elastic contributions.
+ *
+ * @param[in] viscous_displacement viscous displacement on the extended grid
+ * @param[in] elastic_displacement elastic displacement on the PISM grid
+ * @param[out] total_displacement total displacement on the PISM grid
+ */
+void LingleClarkMPI::update_displacement(const array::Scalar &viscous_displacement,
+                                         const array::Scalar &elastic_displacement,
+                                         array::Scalar &total_displacement) {
+  PetscErrorCode ierr = 0;
+
+  auto dm = m_extended_grid->get_dm(1, 0);
+
+  // Extract the central part of the viscous displacement: extended grid to slab, then
+  // slab to the physical grid.
+  ierr = DMDAGlobalToNaturalBegin(*dm, viscous_displacement.vec(), INSERT_VALUES,
+                                  m_natural_extended);
+  PISM_CHK(ierr, "DMDAGlobalToNaturalBegin");
+  ierr = DMDAGlobalToNaturalEnd(*dm, viscous_displacement.vec(), INSERT_VALUES,
+                                m_natural_extended);
+  PISM_CHK(ierr, "DMDAGlobalToNaturalEnd");
+
+  ierr = VecScatterBegin(m_scatter_extended, m_natural_extended, m_slab,
+                         INSERT_VALUES, SCATTER_FORWARD);
+  PISM_CHK(ierr, "VecScatterBegin");
+  ierr = VecScatterEnd(m_scatter_extended, m_natural_extended, m_slab,
+                       INSERT_VALUES, SCATTER_FORWARD);
+  PISM_CHK(ierr, "VecScatterEnd");
+
+  slab_to_grid(total_displacement, m_scatter_center);
+
+  ierr = VecAXPY(total_displacement.vec(), 1.0, elastic_displacement.vec());
+  PISM_CHK(ierr, "VecAXPY");
+}
+
+/*!
+ * Modify the plate displacement to correct for the effect of imposing periodic boundary
+ * conditions at a finite distance.
+ *
+ * See Section 5 in [@ref BuelerLingleBrown] and LingleClarkSerial::tweak().
+ *
+ * @param[in] load_thickness thickness of the load (used to compute the corresponding
+ *                           disc volume)
+ * @param[in,out] U viscous plate displacement in the slab distribution (see m_slab)
+ */
+void LingleClarkMPI::tweak(const array::Scalar &load_thickness, petsc::Vec &U) {
+  PetscErrorCode ierr = 0;
+
+  // find average value along "distant" boundary of [-Lx, Lx]X[-Ly, Ly]
+  // note domain is periodic, so think of cut locus of torus (!)
+  double average = 0.0;
+  {
+    double my_sum = 0.0;
+    {
+      petsc::VecArray u_array(U);
+      const double *u = u_array.get();
+
+      // contributions of the j = 0 column (rows owned by this rank)
+      for (int i = 0; i < m_xm; ++i) {
+        my_sum += u[i * m_Ny + 0];
+      }
+
+      // the i = 0 row (owned by one rank)
+      if (m_xs == 0 and m_xm > 0) {
+        for (int j = 0; j < m_Ny; ++j) {
+          my_sum += u[j];
+        }
+      }
+    }
+
+    average = GlobalSum(m_com, my_sum) / (double) (m_Nx + m_Ny);
+  }
+
+  double shift = 0.0;
+
+  {
+    // tweak continued: replace far field with value for an equivalent disc load which
+    // has R0=Lx*(2/3)=L/3 (instead of 1000km in MATLAB code: H0 =
+    // dx*dx*sum(sum(H))/(pi*1e6^2); % trapezoid rule)
+    const double L_average = (m_Lx + m_Ly) / 2.0;
+    const double R         = L_average * (2.0 / 3.0);
+
+    double H_sum = 0.0;
+    ierr = VecSum(load_thickness.vec(), &H_sum); PISM_CHK(ierr, "VecSum");
+
+    // compute disc thickness by dividing its volume by the area
+    const double H = (H_sum * m_dx * m_dy) / (M_PI * R * R);
+
+    shift = viscDisc(m_t_infty,                        // time in seconds
+                     H,                                // disc thickness
+                     R,                                // disc radius
+                     L_average,                        // compute deflection at this radius
+                     m_mantle_density, m_load_density, // mantle and load densities
+                     m_standard_gravity,               //
+                     m_D,                              // flexural rigidity
+                     m_eta);                           // mantle viscosity
+  }
+
+  ierr = VecShift(U, shift - average); PISM_CHK(ierr, "VecShift");
+}
+
+#else  // Pism_USE_FFTW_MPI
+
+// PISM was built without FFTW's MPI interface: provide stubs so that LingleClark can be
+// compiled unconditionally.
+
+LingleClarkMPI::LingleClarkMPI(std::shared_ptr<const Logger> log,
+                               const Config &config,
+                               bool include_elastic,
+                               std::shared_ptr<const Grid> grid,
+                               std::shared_ptr<const Grid> extended_grid)
+  : m_t_infty(1e16),
+    m_log(log) {
+  (void) config;
+  (void) include_elastic;
+  (void) grid;
+  (void) extended_grid;
+
+  m_fftw_input  = nullptr;
+  m_fftw_output = nullptr;
+  m_loadhat     = nullptr;
+  m_lrm_hat     = nullptr;
+
+  throw RuntimeError(PISM_ERROR_LOCATION,
+                     "bed_deformation.lc.fftw_mpi requires PISM built with FFTW's"
+                     " MPI interface (-DPism_USE_FFTW_MPI=YES)");
+}
+
+LingleClarkMPI::~LingleClarkMPI() {
+  // empty
+}
+
+void LingleClarkMPI::init(const array::Scalar &viscous_displacement,
+                          array::Scalar &elastic_displacement,
+                          array::Scalar &total_displacement) {
+  (void) viscous_displacement;
+  (void) elastic_displacement;
+  (void) total_displacement;
+}
+
+void LingleClarkMPI::bootstrap(const array::Scalar &thickness,
+                               const array::Scalar &uplift,
+                               array::Scalar &viscous_displacement,
+                               array::Scalar &elastic_displacement,
+                               array::Scalar &total_displacement) {
+  (void) thickness;
+  (void) uplift;
+  (void) viscous_displacement;
+  (void) elastic_displacement;
+  (void) total_displacement;
+}
+
+void LingleClarkMPI::step(double dt, const array::Scalar &H,
+                          array::Scalar &viscous_displacement,
+                          array::Scalar &elastic_displacement,
+                          array::Scalar &total_displacement) {
+  (void) dt;
+  (void) H;
+  (void) viscous_displacement;
+  (void) elastic_displacement;
+  (void) total_displacement;
+}
+
+void LingleClarkMPI::compute_load_response_matrix(array::Scalar &result) {
+  (void) result;
+}
+
+#endif  // Pism_USE_FFTW_MPI
+
+} // end of namespace bed
+} // end of namespace pism
@@ -0,0 +1,180 @@
+// Copyright (C) 2025, 2026 PISM Authors
+//
+// This file is part of PISM.
+//
+// PISM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the Free Software
+// Foundation; either version 3 of the License, or (at your option) any later
+// version.
+//
+// PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License
+// along with PISM; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef LINGLECLARKMPI_H
+#define LINGLECLARKMPI_H
+
+#include <vector>
+#include <fftw3.h>
+
+#include "pism/util/petscwrappers/Vec.hh"
+#include "pism/util/petscwrappers/VecScatter.hh"
+#include "pism/util/Logger.hh"
+
+namespace pism {
+
+class Config;
+class Grid;
+
+namespace array {
+class Scalar;
+} // end of namespace array
+
+namespace bed {
+
+//! Distributed version of the [@ref BLKfastearth] bed deformation solver.
+/*!
+  This class solves the same equations as LingleClarkSerial, but uses FFTW's MPI
+  transforms so that all ranks share the spectral work and no rank has to store the full
+  extended grid. This avoids gathering the load on rank 0 (and the corresponding memory
+  spike) in LingleClark.
+
+  FFTW distributes a 2D transform by blocks of contiguous rows of the first (here: x)
+  dimension. Model inputs and outputs are distributed PISM fields; they are converted to
+  and from this "slab" distribution using PETSc's natural ordering and vector scatters
+  set up in the constructor.
+
+  Unlike LingleClarkSerial, this class does not own the model state: the viscous and
+  elastic displacement fields live in LingleClark and are passed in by reference.
+
+  Only compiled if PISM is built with FFTW's MPI interface (Pism_USE_FFTW_MPI);
+  otherwise the constructor throws an error message.
+*/
+class LingleClarkMPI {
+public:
+  LingleClarkMPI(std::shared_ptr<const Logger> log,
+                 const Config &config,
+                 bool include_elastic,
+                 std::shared_ptr<const Grid> grid,
+                 std::shared_ptr<const Grid> extended_grid);
+  ~LingleClarkMPI();
+
+  void init(const array::Scalar &viscous_displacement,
+            array::Scalar &elastic_displacement,
+            array::Scalar &total_displacement);
+
+  void bootstrap(const array::Scalar &thickness,
+                 const array::Scalar &uplift,
+                 array::Scalar &viscous_displacement,
+                 array::Scalar &elastic_displacement,
+                 array::Scalar &total_displacement);
+
+  void step(double dt_seconds,
+            const array::Scalar &H,
+            array::Scalar &viscous_displacement,
+            array::Scalar &elastic_displacement,
+            array::Scalar &total_displacement);
+
+  void compute_load_response_matrix(array::Scalar &result);
+private:
+  void compute_elastic_response(const array::Scalar &H, array::Scalar &dE);
+
+  void uplift_problem(const array::Scalar &load_thickness,
+                      const array::Scalar &bed_uplift,
+                      array::Scalar &output);
+
+  void precompute_coefficients();
+
+  void update_displacement(const array::Scalar &viscous_displacement,
+                           const array::Scalar &elastic_displacement,
+                           array::Scalar &total_displacement);
+
+  void fill_load_response_matrix(fftw_complex *output);
+
+  void create_scatter(petsc::Vec &source, int Mx, int My, int i0, int j0,
+                      petsc::VecScatter &result);
+
+  void set_real_part(const array::Scalar &input, double normalization,
+                     ::VecScatter scatter);
+
+  void buffer_to_slab(const fftw_complex *buffer, double normalization);
+
+  void slab_to_grid(array::Scalar &output, ::VecScatter scatter);
+
+  void tweak(const array::Scalar &load_thickness, petsc::Vec &U);
+
+  bool m_include_elastic;
+  // grid size
+  int m_Mx;
+  int m_My;
+  // grid spacing
+  double m_dx;
+  double m_dy;
+  //! load density (for computing load from its thickness)
+  double m_load_density;
+  //! mantle density
+  double m_mantle_density;
+  //! mantle viscosity
+  double m_eta;
+  //! lithosphere flexural rigidity
+  double m_D;
+
+  // acceleration due to gravity
+  double m_standard_gravity;
+
+  // size of the extended grid
+  int m_Nx;
+  int m_Ny;
+
+  // indices into extended grid for the corner of the physical grid
+  int m_i0_offset;
+  int m_j0_offset;
+
+  // half-lengths of the extended (FFT, spectral) computational domain
+  double m_Lx;
+  double m_Ly;
+
+  // rows (x indices) of the extended grid owned by this rank in FFTW's slab distribution
+  int m_xs;
+  int m_xm;
+
+  // Coefficients of derivatives in Fourier space
+  std::vector<double> m_cx, m_cy;
+
+  MPI_Comm m_com;
+
+  std::shared_ptr<const Grid> m_grid, m_extended_grid;
+
+  // work vector using FFTW's slab distribution of the extended grid
+  petsc::Vec m_slab;
+  // work vectors in PETSc's natural ordering
+  petsc::Vec m_natural, m_natural_extended;
+
+  // scatters between natural ordering and the slab distribution; "center", "corner" and
+  // "shifted" embed the physical grid in the extended grid using different offsets (see
+  // LingleClarkSerial for the role these offsets play)
+  petsc::VecScatter m_scatter_center, m_scatter_corner, m_scatter_shifted,
+    m_scatter_extended;
+
+  fftw_complex *m_fftw_input;
+  fftw_complex *m_fftw_output;
+  fftw_complex *m_loadhat;
+  fftw_complex *m_lrm_hat;
+
+  fftw_plan m_dft_forward;
+  fftw_plan m_dft_inverse;
+
+  const double m_t_infty;
+
+  std::shared_ptr<const Logger> m_log;
+};
+
+} // end of namespace bed
+} // end of namespace pism
+
+#endif /* LINGLECLARKMPI_H */
@@ -18,6 +18,7 @@
 
 #include <cassert>
 #include <cmath>                // sqrt
+#include <cstdio>               // fopen, fread, fwrite, fclose
 #include <fftw3.h>
 #include <gsl/gsl_math.h>       // M_PI
 
@@ -29,6 +30,7 @@
 #include "pism/util/error_handling.hh"
 #include "pism/util/petscwrappers/Vec.hh"
 #include "pism/util/fftw_utilities.hh"
+#include "pism/util/pism_utilities.hh"
 
 namespace pism {
 namespace bed {
@@ -82,6 +84,8 @@ LingleClarkSerial::LingleClarkSerial(std::shared_ptr<const Logger> log,
 
   m_standard_gravity = config.get_number("constants.standard_gravity");
 
+  m_cache_directory = config.get_string("bed_deformation.lc.cache_directory");
+
   // derive more parameters
   m_Lx        = 0.5 * (m_Nx - 1.0) * m_dx;
   m_Ly        = 0.5 * (m_Ny - 1.0) * m_dy;
@@ -110,10 +114,36 @@ LingleClarkSerial::LingleClarkSerial(std::shared_ptr<const Logger> log,
   m_lrm_hat = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * m_Nx * m_Ny);
 
   clear_fftw_array(m_fftw_input, m_Nx, m_Ny);
+
+  // With caching enabled we can afford FFTW_MEASURE planning: the resulting "wisdom" is
+  // saved and re-used, so its cost is paid once per grid size and transforms get
+  // faster. Without a cache stick to FFTW_ESTIMATE to keep start-up cheap. Note that
+  // FFTW_MEASURE planning overwrites m_fftw_input; this is okay because all transforms
+  // below re-initialize it first.
+  unsigned int flags = FFTW_ESTIMATE;
+  if (not m_cache_directory.empty()) {
+    std::string wisdom_filename = m_cache_directory + "/fftw_wisdom";
+
+    // Ignoring the return value: failure to import just means that this is the first
+    // run using this cache directory.
+    fftw_import_wisdom_from_filename(wisdom_filename.c_str());
+
+    flags = FFTW_MEASURE;
+  }
+
   m_dft_forward = fftw_plan_dft_2d(m_Nx, m_Ny, m_fftw_input, m_fftw_output,
-                                   FFTW_FORWARD, FFTW_ESTIMATE);
+                                   FFTW_FORWARD, flags);
   m_dft_inverse = fftw_plan_dft_2d(m_Nx, m_Ny, m_fftw_input, m_fftw_output,
-                                   FFTW_BACKWARD, FFTW_ESTIMATE);
+                                   FFTW_BACKWARD, flags);
+
+  if (not m_cache_directory.empty()) {
+    std::string wisdom_filename = m_cache_directory + "/fftw_wisdom";
+
+    if (fftw_export_wisdom_to_filename(wisdom_filename.c_str()) == 0) {
+      m_log->message(2, "WARNING: failed to save FFTW wisdom to '%s'\n",
+                     wisdom_filename.c_str());
+    }
+  }
 
   // Note: FFTW is weird. If a malloc() call fails it will just call
   // abort() on you without giving you a chance to recover or tell the
@@ -224,14 +254,115 @@ void LingleClarkSerial::precompute_coefficients() {
 
   // compare geforconv.m
   if (m_include_elastic) {
-    m_log->message(2, "     computing spherical elastic load response matrix ...");
-    {
+    std::string cache_filename;
+    if (not m_cache_directory.empty()) {
+      // The cache file is keyed by the parameters the load response matrix depends on.
+      cache_filename = pism::printf("%s/lrm_%dx%d_%g_%g.bin",
+                                    m_cache_directory.c_str(), m_Nx, m_Ny, m_dx, m_dy);
+    }
+
+    if (cache_filename.empty() or
+        not read_load_response_matrix(cache_filename, m_fftw_input)) {
+      m_log->message(2, "     computing spherical elastic load response matrix ...");
       compute_load_response_matrix(m_fftw_input);
-      // Compute fft2(LRM) and save it in m_lrm_hat
-      fftw_execute(m_dft_forward);
-      copy_fftw_array(m_fftw_output, m_lrm_hat, m_Nx, m_Ny);
+      m_log->message(2, " done\n");
+
+      if (not cache_filename.empty()) {
+        write_load_response_matrix(cache_filename, m_fftw_input);
+      }
+    } else {
+      m_log->message(2, "     read spherical elastic load response matrix from '%s'\n",
+                     cache_filename.c_str());
     }
-    m_log->message(2, " done\n");
+
+    // Compute fft2(LRM) and save it in m_lrm_hat
+    fftw_execute(m_dft_forward);
+    copy_fftw_array(m_fftw_output, m_lrm_hat, m_Nx, m_Ny);
+  }
+}
+
+/*!
+ * Read a cached load response matrix from `filename` into `output` (an FFTW array:
+ * imaginary parts are set to zero).
+ *
+ * Returns true on success. A missing file is not an error (this is the first run using
+ * this cache directory); a file with unexpected grid parameters or size is ignored with
+ * a warning.
+ */
+bool LingleClarkSerial::read_load_response_matrix(const std::string &filename,
+                                                  fftw_complex *output) {
+  FILE *file = fopen(filename.c_str(), "rb");
+  if (file == NULL) {
+    return false;
+  }
+
+  double header[4] = {0.0, 0.0, 0.0, 0.0};
+  std::vector<double> values((size_t)m_Nx * m_Ny);
+
+  bool success = (fread(header, sizeof(double), 4, file) == 4 and
+                  header[0] == (double)m_Nx and
+                  header[1] == (double)m_Ny and
+                  header[2] == m_dx and
+                  header[3] == m_dy and
+                  fread(values.data(), sizeof(double), values.size(), file) == values.size());
+  fclose(file);
+
+  if (not success) {
+    m_log->message(2,
+                   "WARNING: ignoring the load response matrix cache '%s'"
+                   " (wrong size or grid parameters)\n",
+                   filename.c_str());
+    return false;
+  }
+
+  FFTWArray LRM(output, m_Nx, m_Ny);
+  size_t k = 0;
+  for (int i = 0; i < m_Nx; ++i) {
+    for (int j = 0; j < m_Ny; ++j) {
+      LRM(i, j) = values[k];
+      ++k;
+    }
+  }
+
+  return true;
+}
+
+/*!
+ * Save the load response matrix in `input` to the cache file `filename`, prefixed by
+ * the grid parameters it corresponds to.
+ *
+ * Failing to save is not fatal: the matrix will be re-computed by the next run.
+ */
+void LingleClarkSerial::write_load_response_matrix(const std::string &filename,
+                                                   fftw_complex *input) {
+  FILE *file = fopen(filename.c_str(), "wb");
+  if (file == NULL) {
+    m_log->message(2, "WARNING: failed to save the load response matrix to '%s'\n",
+                   filename.c_str());
+    return;
+  }
+
+  double header[4] = {(double)m_Nx, (double)m_Ny, m_dx, m_dy};
+
+  std::vector<double> values((size_t)m_Nx * m_Ny);
+  {
+    FFTWArray LRM(input, m_Nx, m_Ny);
+    size_t k = 0;
+    for (int i = 0; i < m_Nx; ++i) {
+      for (int j = 0; j < m_Ny; ++j) {
+        values[k] = LRM(i, j).real();
+        ++k;
+      }
+    }
+  }
+
+  bool success = (fwrite(header, sizeof(double), 4, file) == 4 and
+                  fwrite(values.data(), sizeof(double), values.size(), file) == values.size());
+  fclose(file);
+
+  if (not success) {
+    m_log->message(2, "WARNING: failed to save the load response matrix to '%s'\n",
+                   filename.c_str());
   }
 }
 
@@ -19,6 +19,7 @@
 #ifndef LINGLECLARKSERIAL_H
 #define LINGLECLARKSERIAL_H
 
+#include <string>
 #include <vector>
 #include <fftw3.h>
 
@@ -82,6 +83,10 @@ private:
 
   void precompute_coefficients();
 
+  bool read_load_response_matrix(const std::string &filename, fftw_complex *output);
+
+  void write_load_response_matrix(const std::string &filename, fftw_complex *input);
+
   void update_displacement(petsc::Vec &V, petsc::Vec &dE, petsc::Vec &dU);
 
   bool m_include_elastic;
@@ -138,6 +143,10 @@ private:
   void tweak(petsc::Vec &load_thickness, petsc::Vec &U, int Nx, int Ny);
   const double m_t_infty;
 
+  // directory used to cache the load response matrix and FFTW wisdom (empty: caching
+  // disabled)
+  std::string m_cache_directory;
+
   std::shared_ptr<const Logger> m_log;
 };
 
@@ -16,6 +16,8 @@
  * along with PISM; if not, write to the Free Software
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 */
+#include <cmath>                // fabs
+
 #include "pism/energy/BTU_Full.hh"
 
 #include "pism/util/io/File.hh"
@@ -82,6 +84,25 @@ BTU_Full::BTU_Full(std::shared_ptr<const Grid> g, const BTUGrid &grid)
   }
 
   m_column = std::make_shared<BedrockColumn>("bedrock_column", *m_config, vertical_spacing(), Mz());
+
+  m_skip_enabled         = m_config->get_flag("energy.bedrock_thermal.skip.enabled");
+  m_skip_tolerance       = m_config->get_number("energy.bedrock_thermal.skip.tolerance");
+  m_skip_update_interval = m_config->get_number("energy.bedrock_thermal.skip.update_interval",
+                                                "seconds");
+  m_skip_info_valid      = false;
+
+  if (m_skip_enabled) {
+    m_skip_top_temperature = std::make_shared<array::Scalar>(m_grid, "btu_skip_top_temperature");
+    m_skip_top_temperature->metadata(0)
+        .long_name("temperature at the top surface of the bedrock thermal layer"
+                   " at the last time a column was updated")
+        .units("kelvin");
+
+    m_skip_time_interval = std::make_shared<array::Scalar>(m_grid, "btu_skip_time_interval");
+    m_skip_time_interval->metadata(0)
+        .long_name("length of time since the last time a bedrock column was updated")
+        .units("seconds");
+  }
 }
 
 
@@ -117,6 +138,12 @@ void BTU_Full::init_impl(const InputOptions &opts) {
     }
   }
 
+  // (Re-)initializing invalidates per-column skipping info: all columns have to be
+  // updated during the next time step. Note that this also covers changes of the
+  // geothermal flux through the bottom surface of the layer: it is fixed between calls
+  // to init().
+  m_skip_info_valid = false;
+
   update_flux_through_top_surface();
 }
 
@@ -153,6 +180,16 @@ MaxTimestep BTU_Full::max_timestep_impl(double t) const {
 
 
 /** Perform a step of the bedrock thermal model.
+
+    If energy.bedrock_thermal.skip.enabled is set, columns whose top surface temperature
+    did not change appreciably since the last time they were updated are deferred: their
+    accumulated time step grows instead. (This is common under ice-free ocean and ice-free
+    land, where bedrock is in equilibrium with a nearly-constant boundary condition.) A
+    deferred column is advanced using its accumulated time step once its boundary
+    condition changes or the accumulated time step reaches
+    energy.bedrock_thermal.skip.update_interval, whichever comes first, so no time is
+    lost. This is possible because the time-discretization is unconditionally stable and
+    does not restrict the time step length.
 */
 void BTU_Full::update_impl(const array::Scalar &bedrock_top_temperature,
                            double t, double dt) {
@@ -168,15 +205,42 @@ void BTU_Full::update_impl(const array::Scalar &bedrock_top_temperature,
   }
 
   array::AccessScope list{m_temp.get(), &m_bottom_surface_flux, &bedrock_top_temperature};
+  if (m_skip_enabled) {
+    list.add(*m_skip_top_temperature);
+    list.add(*m_skip_time_interval);
+  }
 
   ParallelSection loop(m_grid->com);
   try {
     for (auto p : m_grid->points()) {
       const int i = p.i(), j = p.j();
 
+      double column_dt = dt;
+
+      if (m_skip_enabled) {
+        const double T_top = bedrock_top_temperature(i, j);
+
+        if (m_skip_info_valid) {
+          const double time_elapsed = (*m_skip_time_interval)(i, j) + dt;
+
+          if (time_elapsed < m_skip_update_interval and
+              fabs(T_top - (*m_skip_top_temperature)(i, j)) <= m_skip_tolerance) {
+            // defer the update of this column
+            (*m_skip_time_interval)(i, j) = time_elapsed;
+            continue;
+          }
+
+          // advance this column by the accumulated time step
+          column_dt = time_elapsed;
+        }
+
+        (*m_skip_time_interval)(i, j)   = 0.0;
+        (*m_skip_top_temperature)(i, j) = T_top;
+      }
+
       double *T = m_temp->get_column(i, j);
 
-      m_column->solve(dt, m_bottom_surface_flux(i, j), bedrock_top_temperature(i, j),
+      m_column->solve(column_dt, m_bottom_surface_flux(i, j), bedrock_top_temperature(i, j),
                       T,  // input
                       T); // output
 
@@ -194,6 +258,8 @@ void BTU_Full::update_impl(const array::Scalar &bedrock_top_temperature,
   }
   loop.check();
 
+  m_skip_info_valid = true;
+
   update_flux_through_top_surface();
 }
 
@@ -127,6 +127,21 @@ protected:
   void update_flux_through_top_surface();
 
   std::shared_ptr<BedrockColumn> m_column;
+
+  //! if true, defer updating columns whose top surface boundary condition did not change
+  //! (see energy.bedrock_thermal.skip.enabled)
+  bool m_skip_enabled;
+  //! maximum change of the top surface temperature allowing a column update to be deferred
+  double m_skip_tolerance;
+  //! maximum length of time a column update can be deferred for, in seconds
+  double m_skip_update_interval;
+  //! true if the per-column info below was set by an update (it is invalid right after
+  //! initialization)
+  bool m_skip_info_valid;
+  //! temperature at the top surface of the bedrock layer at the last time a column was updated
+  std::shared_ptr<array::Scalar> m_skip_top_temperature;
+  //! length of time since the last time a column was updated, in seconds
+  std::shared_ptr<array::Scalar> m_skip_time_interval;
 };
 
 } // end of namespace energy
@@ -27,7 +27,8 @@ namespace energy {
 
 BedrockColumn::BedrockColumn(const std::string& prefix,
                              const Config& config, double dz, unsigned int M)
-  : m_dz(dz), m_M(M), m_system(M, prefix) {
+  : m_dz(dz), m_M(M), m_dt(-1.0), m_R(0.0), m_pivot(M), m_multiplier(M) {
+  (void) prefix;
 
   assert(M > 1);
 
@@ -39,6 +40,42 @@ BedrockColumn::BedrockColumn(const std::string& prefix,
   m_D   = m_k / (rho * c);
 }
 
+/*!
+ * Compute the LU factorization of the matrix corresponding to the time step `dt`.
+ *
+ * The matrix is
+ *
+ * - row `0`: `D = 1 + 2R`, `U = -2R` (Neumann BC at the bottom surface),
+ * - rows `1...N-1`: `L = -R`, `D = 1 + 2R`, `U = -R`,
+ * - row `N`: `L = 0`, `D = 1` (Dirichlet BC at the top surface),
+ *
+ * where `R = D dt / dz^2`. It is strictly diagonally dominant, so the elimination sweep
+ * of the Thomas algorithm (see TridiagonalSystem::solve()) cannot produce a zero pivot.
+ */
+void BedrockColumn::factorize(double dt) {
+  double R = m_D * dt / (m_dz * m_dz);
+
+  unsigned int N = m_M - 1;
+
+  double b = 1.0 + 2.0 * R;
+
+  m_pivot[0] = b;
+  for (unsigned int k = 1; k < N; ++k) {
+    m_multiplier[k] = (k == 1 ? -2.0 * R : -R) / b; // U(k - 1) / pivot(k - 1)
+
+    b = (1.0 + 2.0 * R) - (-R) * m_multiplier[k];
+
+    m_pivot[k] = b;
+  }
+
+  // the last row: L = 0, D = 1
+  m_multiplier[N] = (N == 1 ? -2.0 * R : -R) / b;
+  m_pivot[N]      = 1.0;
+
+  m_R  = R;
+  m_dt = dt;
+}
+
 /*!
  * Advance the heat equation in time.
  *
@@ -53,29 +90,28 @@ BedrockColumn::BedrockColumn(const std::string& prefix,
 void BedrockColumn::solve(double dt, double Q_bottom, double T_top,
                           const double *T_old, double *T_new) {
 
-  double R = m_D * dt / (m_dz * m_dz);
-  double G = -Q_bottom / m_k;
+  if (dt != m_dt) {
+    factorize(dt);
+  }
 
-  m_system.L(0)   = 0.0;                 // not used
-  m_system.D(0)   = 1.0 + 2.0 * R;
-  m_system.U(0)   = -2.0 * R;
-  m_system.RHS(0) = T_old[0] - 2.0 * G * m_dz * R;
+  const double
+    R = m_R,
+    G = -Q_bottom / m_k;
 
   unsigned int N = m_M - 1;
 
+  // forward substitution (the right hand side is T_old, except in the first and last
+  // rows)
+  T_new[0] = (T_old[0] - 2.0 * G * m_dz * R) / m_pivot[0];
   for (unsigned int k = 1; k < N; ++k) {
-    m_system.L(k)   = -R;
-    m_system.D(k)   = 1.0 + 2.0 * R;
-    m_system.U(k)   = -R;
-    m_system.RHS(k) = T_old[k];
+    T_new[k] = (T_old[k] + R * T_new[k - 1]) / m_pivot[k]; // L(k) == -R
   }
+  T_new[N] = T_top;             // L(N) == 0, D(N) == 1
 
-  m_system.L(N)   = 0.0;
-  m_system.D(N)   = 1.0;
-  m_system.U(N)   = 0.0;                 // not used
-  m_system.RHS(N) = T_top;
-
-  m_system.solve(m_M, T_new);
+  // backward substitution
+  for (int k = static_cast<int>(N) - 1; k >= 0; --k) {
+    T_new[k] -= m_multiplier[k + 1] * T_new[k + 1];
+  }
 }
 
 /*!
@@ -19,7 +19,8 @@
 #ifndef BEDROCK_COLUMN_HH
 #define BEDROCK_COLUMN_HH
 
-#include "pism/util/ColumnSystem.hh"
+#include <string>
+#include <vector>
 
 namespace pism {
 
@@ -35,6 +36,11 @@ namespace energy {
  *
  * The implementation uses a second-order discretization in space and the backward-Euler
  * (first-order, fully implicit) time-discretization.
+ *
+ * The matrix of the system depends on the time step length only (coefficients and the
+ * grid are constant), so its LU factorization is computed once per time step and re-used
+ * by all the columns of the bedrock layer; solve() performs forward and backward
+ * substitution only.
  */
 class BedrockColumn {
 public:
@@ -50,6 +56,8 @@ public:
              std::vector<double> &result);
 
 private:
+  void factorize(double dt);
+
   // temperature diffusivity coefficient
   double m_D;
   // thermal conductivity
@@ -59,7 +67,14 @@ private:
   // system size
   unsigned int m_M;
 
-  TridiagonalSystem m_system;
+  // time step length the cached factorization below corresponds to (negative
+  // until the first solve() call)
+  double m_dt;
+  // R = D dt / dz^2 for the cached factorization
+  double m_R;
+  // LU factorization of the matrix: pivots and multipliers of the elimination
+  // sweep (see TridiagonalSystem::solve())
+  std::vector<double> m_pivot, m_multiplier;
 };
 
 } // end of namespace energy
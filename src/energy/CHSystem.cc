@@ -17,6 +17,7 @@
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 #include <algorithm>            // std::max
+#include <cmath>                // fabs
 
 #include "pism/energy/CHSystem.hh"
 #include "pism/energy/enthSystem.hh"
@@ -62,6 +63,23 @@ CHSystem::CHSystem(std::shared_ptr<const Grid> grid,
   m_ice_enthalpy.set_name("ch_enthalpy");
   m_ice_enthalpy.metadata().set_name("ch_enthalpy");
   m_ice_enthalpy.metadata()["long_name"] = "enthalpy of the cryo-hydrologic system";
+
+  m_skip_enabled    = m_config->get_flag("energy.ch_warming.skip.enabled");
+  m_skip_tolerance  = m_config->get_number("energy.ch_warming.skip.tolerance");
+  m_skip_info_valid = false;
+
+  if (m_skip_enabled) {
+    m_skip_steady = std::make_shared<array::Scalar>(m_grid, "ch_skip_steady");
+    m_skip_steady->metadata(0)
+        .long_name("1 if the cryo-hydrologic column did not change during the last"
+                   " full update, 0 otherwise");
+
+    m_skip_surface_enthalpy = std::make_shared<array::Scalar>(m_grid, "ch_skip_surface_enthalpy");
+    m_skip_surface_enthalpy->metadata(0)
+        .long_name("surface enthalpy boundary condition used by the last full update"
+                   " of a cryo-hydrologic column")
+        .units("J kg^-1");
+  }
 }
 
 void CHSystem::restart_impl(const File &input_file, int record) {
@@ -69,6 +87,8 @@ void CHSystem::restart_impl(const File &input_file, int record) {
   m_log->message(2, "* Restarting the cryo-hydrologic system from %s...\n",
                  input_file.name().c_str());
 
+  m_skip_info_valid = false;
+
   init_enthalpy(input_file, false, record);
 
   regrid_enthalpy();
@@ -83,6 +103,8 @@ void CHSystem::bootstrap_impl(const File &input_file,
   m_log->message(2, "* Bootstrapping the cryo-hydrologic warming model from %s...\n",
                  input_file.name().c_str());
 
+  m_skip_info_valid = false;
+
   int enthalpy_revision = m_ice_enthalpy.state_counter();
   regrid_enthalpy();
 
@@ -101,6 +123,8 @@ void CHSystem::initialize_impl(const array::Scalar &basal_melt_rate,
 
   m_log->message(2, "* Bootstrapping the cryo-hydrologic warming model...\n");
 
+  m_skip_info_valid = false;
+
   int enthalpy_revision = m_ice_enthalpy.state_counter();
   regrid_enthalpy();
 
@@ -113,6 +137,11 @@ void CHSystem::initialize_impl(const array::Scalar &basal_melt_rate,
 //! Update the enthalpy of the cryo-hydrologic system.
 /*!
   This method updates array::Array3D m_work. No communication of ghosts is done.
+
+  If :config:`energy.ch_warming.skip.enabled` is set, columns that reached a steady state
+  during a previous update are not re-solved as long as their surface boundary condition
+  does not change: outside the melt season most CH columns are inert and re-solving them
+  reproduces the stored state.
 */
 void CHSystem::update_impl(double t, double dt, const Inputs &inputs) {
   // current time does not matter here
@@ -151,6 +180,10 @@ void CHSystem::update_impl(double t, double dt, const Inputs &inputs) {
       &ice_thickness, &basal_frictional_heating, &basal_heat_flux,
       &cell_type, &u3, &v3, &w3, &volumetric_heat, &m_ice_enthalpy,
       &m_work};
+  if (m_skip_enabled) {
+    list.add(*m_skip_steady);
+    list.add(*m_skip_surface_enthalpy);
+  }
 
   double
     margin_threshold = m_config->get_number("energy.margin_ice_thickness_limit"),
@@ -180,6 +213,10 @@ void CHSystem::update_impl(double t, double dt, const Inputs &inputs) {
                                      residual_water_fraction,
                                      P);
         }
+        if (m_skip_enabled) {
+          // liquid water input: the column has to be re-solved once the melt season ends
+          (*m_skip_steady)(i, j) = 0.0;
+        }
         continue;
       }
 
@@ -191,6 +228,18 @@ void CHSystem::update_impl(double t, double dt, const Inputs &inputs) {
       const double Enth_ks = EC->enthalpy_permissive(ice_surface_temp(i, j),
                                                      surface_liquid_fraction(i, j), p_ks);
 
+      if (m_skip_enabled and m_skip_info_valid and
+          (*m_skip_steady)(i, j) > 0.5 and
+          not cell_type.ocean(i, j) and
+          fabs(Enth_ks - (*m_skip_surface_enthalpy)(i, j)) <= m_skip_tolerance) {
+        // This column was in steady state at the end of the last full update and its
+        // surface boundary condition did not change: solving would reproduce the stored
+        // state, so carry it over. (Ocean cells are excluded: their basal boundary
+        // condition comes from an ocean model and may change between updates.)
+        m_work.set_column(i, j, m_ice_enthalpy.get_column(i, j));
+        continue;
+      }
+
       system.init(i, j,
                   marginal(ice_thickness, i, j, margin_threshold),
                   H);
@@ -200,6 +249,10 @@ void CHSystem::update_impl(double t, double dt, const Inputs &inputs) {
       // deal completely with columns with no ice
       if (ice_free_column) {
         m_work.set_column(i, j, Enth_ks);
+        if (m_skip_enabled) {
+          // ice-free columns are cheap; keep them out of the fast path
+          (*m_skip_steady)(i, j) = 0.0;
+        }
         continue;
       } // end of if (ice_free_column)
 
@@ -225,12 +278,28 @@ void CHSystem::update_impl(double t, double dt, const Inputs &inputs) {
         system.solve(Enthnew);
       }
 
-      system.fine_to_coarse(Enthnew, i, j, m_work);
+      system.fine_to_coarse(Enthnew, i, j, system.ks(), Enth_ks, m_work);
+
+      if (m_skip_enabled) {
+        // compare the new state of the column to the old one to detect steady state
+        const double
+          *E_old = m_ice_enthalpy.get_column(i, j),
+          *E_new = m_work.get_column(i, j);
+        double dE_max = 0.0;
+        for (unsigned int k = 0; k < Mz; ++k) {
+          dE_max = std::max(dE_max, fabs(E_new[k] - E_old[k]));
+        }
+
+        (*m_skip_steady)(i, j)           = dE_max <= m_skip_tolerance ? 1.0 : 0.0;
+        (*m_skip_surface_enthalpy)(i, j) = Enth_ks;
+      }
     }
   } catch (...) {
     loop.failed();
   }
   loop.check();
+
+  m_skip_info_valid = true;
 }
 
 std::set<VariableMetadata> CHSystem::state_impl() const {
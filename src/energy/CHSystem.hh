@@ -52,6 +52,18 @@ protected:
   void write_state_impl(const OutputFile &output) const;
 
   DiagnosticList spatial_diagnostics_impl() const;
+
+  //! True if the steady-state fast path is enabled. Set using
+  //! :config:`energy.ch_warming.skip.enabled`.
+  bool m_skip_enabled;
+  //! Maximum change of the enthalpy in a column (per time step) treated as "no change".
+  double m_skip_tolerance;
+  //! True if m_skip_steady and m_skip_surface_enthalpy contain valid data.
+  bool m_skip_info_valid;
+  //! 1 if the last full solve left the column unchanged (up to m_skip_tolerance), 0 otherwise.
+  std::shared_ptr<array::Scalar> m_skip_steady;
+  //! Surface enthalpy boundary condition used by the last full solve in a column.
+  std::shared_ptr<array::Scalar> m_skip_surface_enthalpy;
 };
 
 void cryo_hydrologic_warming_flux(double k,
@@ -31,6 +31,11 @@ DummyEnergyModel::DummyEnergyModel(
   // empty
 }
 
+bool DummyEnergyModel::can_update_age() const {
+  // update_impl() below does not process ice columns at all
+  return false;
+}
+
 void DummyEnergyModel::restart_impl(const File &input_file, int record) {
   EnthalpyModel::restart_impl(input_file, record);
 
@@ -56,6 +56,13 @@ public:
 
   // inputs used by regional models
   const array::Scalar *no_model_mask;
+
+  // Age model fields used to fuse the age update into the energy update, feeding both
+  // column systems from a single load of the velocity columns. Both are NULL if the age
+  // of the ice is not modeled or is updated separately; see
+  // EnergyModel::can_update_age().
+  const array::Array3D *ice_age;
+  array::Array3D *ice_age_output;
 };
 
 class EnergyModelStats {
@@ -64,7 +71,7 @@ public:
 
   EnergyModelStats& operator+=(const EnergyModelStats &other);
 
-  void sum(MPI_Comm com);
+  void sum(MPI_Comm intra_node, MPI_Comm inter_node);
 
   unsigned int bulge_counter;
   unsigned int reduced_accuracy_counter;
@@ -99,6 +106,10 @@ public:
 
   void update(double t, double dt, const Inputs &inputs);
 
+  /*! @brief True if update() can update the age of the ice in the same column traversal
+    as the energy update (see Inputs::ice_age). */
+  virtual bool can_update_age() const;
+
   const EnergyModelStats& stats() const;
 
   const array::Array3D & enthalpy() const;
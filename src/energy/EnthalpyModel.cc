@@ -17,12 +17,24 @@
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <algorithm>            // std::min, std::max
+#include <exception>            // std::exception_ptr
+#include <memory>               // std::unique_ptr
+
+#include "pism/pism_config.hh"  // Pism_USE_OPENMP
+
+#if Pism_USE_OPENMP
+#include <omp.h>
+#endif
+
+#include "pism/age/AgeColumnSystem.hh"
 #include "pism/energy/EnthalpyModel.hh"
 #include "pism/energy/DrainageCalculator.hh"
 #include "pism/energy/enthSystem.hh"
 #include "pism/energy/utilities.hh"
 #include "pism/util/Context.hh"
 #include "pism/util/EnthalpyConverter.hh"
+#include "pism/util/OrderedAccumulator.hh"
 #include "pism/util/array/CellType.hh"
 #include "pism/util/io/File.hh"
 #include "pism/util/Logger.hh"
@@ -37,6 +49,10 @@ EnthalpyModel::EnthalpyModel(std::shared_ptr<const Grid> grid,
   // empty
 }
 
+bool EnthalpyModel::can_update_age() const {
+  return true;
+}
+
 void EnthalpyModel::restart_impl(const File &input_file, int record) {
 
   m_log->message(2, "* Restarting the enthalpy-based energy balance model from %s...\n",
@@ -101,7 +117,8 @@ AschwandenBuelerKhroulevBlatter].
 This method updates array::Array3D m_work and array::Scalar basal_melt_rate.
 No communication of ghosts is done for any of these fields.
 
-We use an instance of enthSystemCtx.
+We use an instance of enthSystemCtx per thread: when PISM is built with
+OpenMP, rows of the sub-domain are processed by different threads.
 
 Regarding drainage, see [\ref AschwandenBuelerKhroulevBlatter] and references therein.
  */
@@ -140,17 +157,80 @@ void EnthalpyModel::update_impl(double t, double dt, const Inputs &inputs) {
 
   const array::Scalar1 &ice_thickness = *inputs.ice_thickness;
 
-  energy::enthSystemCtx system(m_grid->z(), "energy.enthalpy", m_grid->dx(), m_grid->dy(), dt,
-                               *m_config, m_ice_enthalpy, u3, v3, w3, strain_heating3, EC);
+  // In regional setups columns in the no-model strip are reset to stored values right
+  // after this update (see EnthalpyModel_Regional), so the column solves there are
+  // wasted work and are skipped. The mask is absent in whole-sheet runs.
+  const array::Scalar *no_model_mask = inputs.no_model_mask;
+
+  // If the age model fields are provided, update the age of the ice in the same
+  // traversal, feeding both column systems from a single load of the velocity columns.
+  const bool update_age = (inputs.ice_age != nullptr and inputs.ice_age_output != nullptr);
+
+#if Pism_USE_OPENMP
+  const int n_threads = omp_get_max_threads();
+#else
+  const int n_threads = 1;
+#endif
+
+  // Rows of the sub-domain are distributed among threads (when OpenMP is
+  // enabled) and enthSystemCtx is stateful, so each thread gets its own
+  // solver context. These are allocated up front: the constructor reads from
+  // the configuration database, which is not thread-safe.
+  std::vector<std::unique_ptr<energy::enthSystemCtx> > systems(n_threads);
+  for (int n = 0; n < n_threads; ++n) {
+    systems[n].reset(new energy::enthSystemCtx(m_grid->z(), "energy.enthalpy", m_grid->dx(),
+                                               m_grid->dy(), dt, *m_config, m_ice_enthalpy,
+                                               u3, v3, w3, strain_heating3, EC));
+  }
 
-  const size_t Mz_fine = system.z().size();
-  const double dz = system.dz();
-  std::vector<double> Enthnew(Mz_fine); // new enthalpy in column
+  // Age systems (one per thread, matching `systems` above; empty otherwise). The age
+  // system uses the same fine vertical grid as the enthalpy system.
+  std::vector<std::unique_ptr<AgeColumnSystem> > age_systems(n_threads);
+  if (update_age) {
+    for (int n = 0; n < n_threads; ++n) {
+      age_systems[n].reset(new AgeColumnSystem(m_grid->z(), "age", m_grid->dx(), m_grid->dy(),
+                                               dt, *inputs.ice_age, u3, v3, w3));
+    }
+  }
+
+  const size_t Mz_fine = systems[0]->z().size();
+  const double dz = systems[0]->dz();
+  const unsigned int Mz_coarse = m_grid->Mz();
+
+  // Neighboring columns are processed in blocks: the vertical systems are
+  // assembled per column and then solved together, with the tridiagonal
+  // sweeps running across the block (see TridiagonalSystemBatch). Results do
+  // not depend on the block size.
+  const int batch_width =
+      std::max(static_cast<int>(m_config->get_number("energy.enthalpy.column_batch_size")), 1);
+
+  // Per-thread scratch storage: the new enthalpy in a column, the batch of
+  // tridiagonal systems, and per-column values stashed by the assembly pass
+  // for the post-processing pass.
+  std::vector<std::vector<double> > Enthnew_store(n_threads, std::vector<double>(Mz_fine));
+  std::vector<TridiagonalSystemBatch>
+      batch_store(n_threads, TridiagonalSystemBatch((unsigned int)Mz_fine,
+                                                    (unsigned int)batch_width));
+  std::vector<std::vector<unsigned int> > lane_ks_store(n_threads,
+                                                        std::vector<unsigned int>(batch_width));
+  std::vector<std::vector<double> >
+      lane_H_store(n_threads, std::vector<double>(batch_width)),
+      lane_Enth_ks_store(n_threads, std::vector<double>(batch_width)),
+      lane_Enth_s_store(n_threads, std::vector<double>(batch_width * Mz_fine));
+  std::vector<std::vector<double> > age_x_store(n_threads,
+                                                std::vector<double>(update_age ? Mz_fine : 0));
 
   array::AccessScope list{&ice_surface_temp, &shelf_base_temp, &surface_liquid_fraction,
       &ice_thickness, &basal_frictional_heating, &basal_heat_flux, &till_water_thickness,
       &cell_type, &u3, &v3, &w3, &strain_heating3, &m_basal_melt_rate, &m_ice_enthalpy,
       &m_work};
+  if (update_age) {
+    list.add(*inputs.ice_age);
+    list.add(*inputs.ice_age_output);
+  }
+  if (no_model_mask != nullptr) {
+    list.add(*no_model_mask);
+  }
 
   double margin_threshold = m_config->get_number("energy.margin_ice_thickness_limit");
 
@@ -158,186 +238,345 @@ void EnthalpyModel::update_impl(double t, double dt, const Inputs &inputs) {
 
   ParallelSection loop(m_grid->com);
   try {
-    for (auto pt : m_grid->points()) {
-      const int i = pt.i(), j = pt.j();
+    const int
+      xs = m_grid->xs(), xm = m_grid->xm(),
+      ys = m_grid->ys(), ym = m_grid->ym();
+
+    // Per-row statistics (liquified, reduced accuracy and bulge counts), indexed by the
+    // row so that the combined result does not depend on the number of threads or on the
+    // scheduling of the loop below.
+    OrderedAccumulator row_stats(ym, 3);
+
+    // Exceptions must not propagate out of an OpenMP parallel region: stash
+    // the first one thrown by a thread and re-throw it after the loop.
+    std::exception_ptr exception = nullptr;
+
+#if Pism_USE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int j = ys; j < ys + ym; ++j) {
+#if Pism_USE_OPENMP
+      const int thread = omp_get_thread_num();
+#else
+      const int thread = 0;
+#endif
+      energy::enthSystemCtx &system = *systems[thread];
+      AgeColumnSystem *age_system = update_age ? age_systems[thread].get() : nullptr;
+      std::vector<double> &age_x = age_x_store[thread];
+      TridiagonalSystemBatch &batch = batch_store[thread];
+      std::vector<double> &Enthnew = Enthnew_store[thread];
+      std::vector<unsigned int> &lane_ks = lane_ks_store[thread];
+      std::vector<double>
+        &lane_H       = lane_H_store[thread],
+        &lane_Enth_ks = lane_Enth_ks_store[thread],
+        &lane_Enth_s  = lane_Enth_s_store[thread];
+
+      // statistics gathered while processing this row
+      unsigned int row_liquified = 0, row_reduced_accuracy = 0, row_bulge = 0;
+
+      try {
+        for (int i0 = xs; i0 < xs + xm; i0 += batch_width) {
+          const int block_width = std::min(batch_width, xs + xm - i0);
+
+          for (int n = 0; n < batch_width; ++n) {
+            batch.set_size(n, 0);   // mark all lanes as unused
+          }
+          int assembled = 0;
+
+          // First pass: per-column setup, boundary conditions, and assembly.
+          for (int n = 0; n < block_width; ++n) {
+            const int i = i0 + n;
+
+            if (no_model_mask != nullptr and (*no_model_mask)(i, j) > 0.5) {
+              // Held column: copy the current state so that m_work (and the age output,
+              // if present) are initialized, then skip the column solves.
+              m_work.set_column(i, j, m_ice_enthalpy.get_column(i, j));
+              if (update_age) {
+                inputs.ice_age_output->set_column(i, j, inputs.ice_age->get_column(i, j));
+              }
+              continue;
+            }
 
-      const double H = ice_thickness(i, j);
+            const double H = ice_thickness(i, j);
+
+            if (update_age) {
+              // Update the age of the ice in this column first: the enthalpy system
+              // below re-uses the velocity columns loaded here.
+              age_system->init(i, j, H);
+
+              if (age_system->ks() == 0) {
+                // if no ice, set the entire column to zero age
+                inputs.ice_age_output->set_column(i, j, 0.0);
+              } else {
+                age_system->solve(age_x);
+
+                age_system->fine_to_coarse(age_x, i, j, age_system->ks(), 0.0,
+                                           *inputs.ice_age_output);
+
+                // Ensure that the age of the ice is non-negative (see the FIXME in
+                // AgeModel::update()).
+                double *age_column = inputs.ice_age_output->get_column(i, j);
+                for (unsigned int k = 0; k < Mz_coarse; ++k) {
+                  if (age_column[k] < 0.0) {
+                    age_column[k] = 0.0;
+                  }
+                }
+              }
+            }
 
-      system.init(i, j,
-                  marginal(ice_thickness, i, j, margin_threshold),
-                  H);
+            system.init(i, j,
+                        marginal(ice_thickness, i, j, margin_threshold),
+                        H,
+                        age_system);
 
-      // enthalpy and pressures at top of ice
-      const double
-        depth_ks = H - system.ks() * dz,
-        p_ks     = EC->pressure(depth_ks); // FIXME issue #15
+            // enthalpy and pressures at top of ice
+            const double
+              depth_ks = H - system.ks() * dz,
+              p_ks     = EC->pressure(depth_ks); // FIXME issue #15
 
-      const double Enth_ks = EC->enthalpy_permissive(ice_surface_temp(i, j),
-                                                     surface_liquid_fraction(i, j), p_ks);
+            const double Enth_ks = EC->enthalpy_permissive(ice_surface_temp(i, j),
+                                                           surface_liquid_fraction(i, j), p_ks);
 
-      const bool ice_free_column = (system.ks() == 0);
+            const bool ice_free_column = (system.ks() == 0);
 
-      // deal completely with columns with no ice; enthalpy and basal_melt_rate need setting
-      if (ice_free_column) {
-        m_work.set_column(i, j, Enth_ks);
-        // The floating basal melt rate will be set later; cover this
-        // case and set to zero for now. Also, there is no basal melt
-        // rate on ice free land and ice free ocean
-        m_basal_melt_rate(i, j) = 0.0;
-        continue;
-      } // end of if (ice_free_column)
+            // deal completely with columns with no ice; enthalpy and basal_melt_rate need setting
+            if (ice_free_column) {
+              m_work.set_column(i, j, Enth_ks);
+              // The floating basal melt rate will be set later; cover this
+              // case and set to zero for now. Also, there is no basal melt
+              // rate on ice free land and ice free ocean
+              m_basal_melt_rate(i, j) = 0.0;
+              continue;
+            } // end of if (ice_free_column)
 
-      if (system.lambda() < 1.0) {
-        m_stats.reduced_accuracy_counter += 1; // count columns with lambda < 1
-      }
+            if (system.lambda() < 1.0) {
+              row_reduced_accuracy += 1; // count columns with lambda < 1
+            }
 
-      const bool
-        is_floating        = cell_type.ocean(i, j),
-        base_is_warm       = system.Enth(0) >= system.Enth_s(0),
-        above_base_is_warm = system.Enth(1) >= system.Enth_s(1);
+            const bool
+              is_floating        = cell_type.ocean(i, j),
+              base_is_warm       = system.Enth(0) >= system.Enth_s(0),
+              above_base_is_warm = system.Enth(1) >= system.Enth_s(1);
+
+            // set boundary conditions and update enthalpy
+            {
+              system.set_surface_dirichlet_bc(Enth_ks);
+
+              // determine lowest-level equation at bottom of ice; see
+              // decision chart in the source code browser and page
+              // documenting BOMBPROOF
+              if (is_floating) {
+                // floating base: Dirichlet application of known temperature from ocean
+                //   coupler; assumes base of ice shelf has zero liquid fraction
+                double Enth0 = EC->enthalpy_permissive(shelf_base_temp(i, j), 0.0, EC->pressure(H));
+
+                system.set_basal_dirichlet_bc(Enth0);
+              } else {
+                // grounded ice warm and wet
+                if (base_is_warm && (till_water_thickness(i, j) > 0.0)) {
+                  if (above_base_is_warm) {
+                    // temperate layer at base (Neumann) case:  q . n = 0  (K0 grad E . n = 0)
+                    system.set_basal_heat_flux(0.0);
+                  } else {
+                    // only the base is warm: E = E_s(p) (Dirichlet)
+                    // ( Assumes ice has zero liquid fraction. Is this a valid assumption here?
+                    system.set_basal_dirichlet_bc(system.Enth_s(0));
+                  }
+                } else {
+                  // (Neumann) case:  q . n = q_lith . n + F_b
+                  // a) cold and dry base, or
+                  // b) base that is still warm from the last time step, but without basal water
+                  system.set_basal_heat_flux(basal_heat_flux(i, j) + basal_frictional_heating(i, j));
+                }
+              }
+
+              // add this column's system to the batch
+              system.add_to_batch(batch, (unsigned int)n);
+              assembled += 1;
+            }
 
-      // set boundary conditions and update enthalpy
-      {
-        system.set_surface_dirichlet_bc(Enth_ks);
-
-        // determine lowest-level equation at bottom of ice; see
-        // decision chart in the source code browser and page
-        // documenting BOMBPROOF
-        if (is_floating) {
-          // floating base: Dirichlet application of known temperature from ocean
-          //   coupler; assumes base of ice shelf has zero liquid fraction
-          double Enth0 = EC->enthalpy_permissive(shelf_base_temp(i, j), 0.0, EC->pressure(H));
-
-          system.set_basal_dirichlet_bc(Enth0);
-        } else {
-          // grounded ice warm and wet
-          if (base_is_warm && (till_water_thickness(i, j) > 0.0)) {
-            if (above_base_is_warm) {
-              // temperate layer at base (Neumann) case:  q . n = 0  (K0 grad E . n = 0)
-              system.set_basal_heat_flux(0.0);
-            } else {
-              // only the base is warm: E = E_s(p) (Dirichlet)
-              // ( Assumes ice has zero liquid fraction. Is this a valid assumption here?
-              system.set_basal_dirichlet_bc(system.Enth_s(0));
+            // stash per-column values needed by the post-processing pass
+            lane_ks[n]      = system.ks();
+            lane_H[n]       = H;
+            lane_Enth_ks[n] = Enth_ks;
+            for (unsigned int k = 0; k <= system.ks(); ++k) {
+              lane_Enth_s[n * Mz_fine + k] = system.Enth_s(k);
             }
-          } else {
-            // (Neumann) case:  q . n = q_lith . n + F_b
-            // a) cold and dry base, or
-            // b) base that is still warm from the last time step, but without basal water
-            system.set_basal_heat_flux(basal_heat_flux(i, j) + basal_frictional_heating(i, j));
-          }
-        }
 
-        // solve the system
-        system.solve(Enthnew);
+          } // end of the first (assembly) pass
 
-      }
+          if (assembled == 0) {
+            continue;             // all columns in this block are ice-free
+          }
 
-      // post-process (drainage and bulge-limiting)
-      double Hdrainedtotal = 0.0;
-      {
-        // drain ice segments by mechanism in [\ref AschwandenBuelerKhroulevBlatter],
-        //   using DrainageCalculator dc
-        for (unsigned int k=0; k < system.ks(); k++) {
-          if (Enthnew[k] > system.Enth_s(k)) { // avoid doing any more work if cold
+          // Solve all systems in the block with one pair of sweeps.
+          try {
+            batch.solve();
+          } catch (RuntimeError &e) {
+            e.add_context("solving tri-diagonal systems (enthSystemCtx) in the block of columns\n"
+                          "at i = %d..%d, j = %d", i0, i0 + block_width - 1, j);
+            throw;
+          }
 
-            const double
-              depth = H - k * dz,
-              p     = EC->pressure(depth), // FIXME issue #15
-              T_m   = EC->melting_temperature(p),
-              L     = EC->L(T_m);
-
-            if (Enthnew[k] >= system.Enth_s(k) + 0.5 * L) {
-              liquifiedCount++; // count these rare events...
-              Enthnew[k] = system.Enth_s(k) + 0.5 * L; //  but lose the energy
+          // Second pass: drainage, bulge-limiting, and the basal melt rate.
+          for (int n = 0; n < block_width; ++n) {
+            if (batch.size(n) == 0) {
+              continue;           // ice-free column; dealt with above
             }
 
-            double omega = EC->water_fraction(Enthnew[k], p);
+            const int i = i0 + n;
 
-            if (omega > target_water_fraction) {
-              double fractiondrained = dc.get_drainage_rate(omega) * dt; // pure number
+            const unsigned int ks = lane_ks[n];
+            const double
+              H       = lane_H[n],
+              Enth_ks = lane_Enth_ks[n];
+            const double *Enth_s = &lane_Enth_s[n * Mz_fine];
+
+            const bool is_floating = cell_type.ocean(i, j);
 
-              fractiondrained  = std::min(fractiondrained,
-                                          omega - target_water_fraction);
-              Hdrainedtotal   += fractiondrained * dz; // always a positive contribution
-              Enthnew[k]      -= fractiondrained * L;
+            // copy the solution for this column; the air above the ice is
+            // handled by fine_to_coarse() below
+            for (unsigned int k = 0; k <= ks; ++k) {
+              Enthnew[k] = batch.x(k, n);
             }
-          }
-        }
 
-        // apply bulge limiter
-        const double lowerEnthLimit = Enth_ks - bulgeEnthMax;
-        for (unsigned int k=0; k < system.ks(); k++) {
-          if (Enthnew[k] < lowerEnthLimit) {
-            // Count grid points which have very large cold limit advection bulge... enthalpy not
-            // too low.
-            m_stats.bulge_counter += 1;
-            Enthnew[k] = lowerEnthLimit;
+            // post-process (drainage and bulge-limiting)
+            double Hdrainedtotal = 0.0;
+            {
+              // drain ice segments by mechanism in [\ref AschwandenBuelerKhroulevBlatter],
+              //   using DrainageCalculator dc
+              for (unsigned int k=0; k < ks; k++) {
+                if (Enthnew[k] > Enth_s[k]) { // avoid doing any more work if cold
+
+                  const double
+                    depth = H - k * dz,
+                    p     = EC->pressure(depth), // FIXME issue #15
+                    T_m   = EC->melting_temperature(p),
+                    L     = EC->L(T_m);
+
+                  if (Enthnew[k] >= Enth_s[k] + 0.5 * L) {
+                    row_liquified++; // count these rare events...
+                    Enthnew[k] = Enth_s[k] + 0.5 * L; //  but lose the energy
+                  }
+
+                  double omega = EC->water_fraction(Enthnew[k], p);
+
+                  if (omega > target_water_fraction) {
+                    double fractiondrained = dc.get_drainage_rate(omega) * dt; // pure number
+
+                    fractiondrained  = std::min(fractiondrained,
+                                                omega - target_water_fraction);
+                    Hdrainedtotal   += fractiondrained * dz; // always a positive contribution
+                    Enthnew[k]      -= fractiondrained * L;
+                  }
+                }
+              }
+
+              // apply bulge limiter
+              const double lowerEnthLimit = Enth_ks - bulgeEnthMax;
+              for (unsigned int k=0; k < ks; k++) {
+                if (Enthnew[k] < lowerEnthLimit) {
+                  // Count grid points which have very large cold limit advection bulge... enthalpy not
+                  // too low.
+                  row_bulge += 1;
+                  Enthnew[k] = lowerEnthLimit;
+                }
+              }
+
+              // if there is subglacial water, don't allow ice base enthalpy to be below
+              // pressure-melting; that is, assume subglacial water is at the pressure-
+              // melting temperature and enforce continuity of temperature
+              if (till_water_thickness(i, j) > 0.0) {
+                Enthnew[0] = std::max(Enthnew[0], Enth_s[0]);
+              }
+            } // end of post-processing
+
+            // compute basal melt rate
+            {
+              bool base_is_cold = (Enthnew[0] < Enth_s[0]) && (till_water_thickness(i,j) == 0.0);
+              // Determine melt rate, but only preliminarily because of
+              // drainage, from heat flux out of bedrock, heat flux into
+              // ice, and frictional heating
+              if (is_floating) {
+                // The floating basal melt rate will be set later; cover
+                // this case and set to zero for now. Note that
+                // Hdrainedtotal is discarded (the ocean model determines
+                // the basal melt).
+                m_basal_melt_rate(i, j) = 0.0;
+              } else {
+                if (base_is_cold) {
+                  m_basal_melt_rate(i, j) = 0.0;  // zero melt rate if cold base
+                } else {
+                  const double
+                    p_0 = EC->pressure(H),
+                    p_1 = EC->pressure(H - dz), // FIXME issue #15
+                    Tpmp_0 = EC->melting_temperature(p_0);
+
+                  const bool k1_istemperate = EC->is_temperate(Enthnew[1], p_1); // level  z = + \Delta z
+                  double hf_up = 0.0;
+                  if (k1_istemperate) {
+                    const double
+                      Tpmp_1 = EC->melting_temperature(p_1);
+
+                    hf_up = -system.k_from_T(Tpmp_0) * (Tpmp_1 - Tpmp_0) / dz;
+                  } else {
+                    double T_0 = EC->temperature(Enthnew[0], p_0);
+                    const double K_0 = system.k_from_T(T_0) / EC->c();
+
+                    hf_up = -K_0 * (Enthnew[1] - Enthnew[0]) / dz;
+                  }
+
+                  // compute basal melt rate from flux balance:
+                  //
+                  // basal_melt_rate = - Mb / rho in [\ref AschwandenBuelerKhroulevBlatter];
+                  //
+                  // after we compute it we make sure there is no refreeze if
+                  // there is no available basal water
+                  m_basal_melt_rate(i, j) = (basal_frictional_heating(i, j) + basal_heat_flux(i, j) - hf_up) / (ice_density * EC->L(Tpmp_0));
+
+                  if (till_water_thickness(i, j) <= 0 && m_basal_melt_rate(i, j) < 0) {
+                    m_basal_melt_rate(i, j) = 0.0;
+                  }
+                }
+
+                // Add drained water from the column to basal melt rate.
+                m_basal_melt_rate(i, j) += Hdrainedtotal / dt;
+              } // end of the grounded case
+            } // end of the basal melt rate computation
+
+            system.fine_to_coarse(Enthnew, i, j, ks, Enth_ks, m_work);
+          } // end of the second (post-processing) pass
+        } // end of the loop over blocks
+      } catch (...) {
+#if Pism_USE_OPENMP
+#pragma omp critical (pism_enthalpy_exception)
+#endif
+        {
+          if (exception == nullptr) {
+            exception = std::current_exception();
           }
         }
+      }
 
-        // if there is subglacial water, don't allow ice base enthalpy to be below
-        // pressure-melting; that is, assume subglacial water is at the pressure-
-        // melting temperature and enforce continuity of temperature
-        if (till_water_thickness(i, j) > 0.0) {
-          Enthnew[0] = std::max(Enthnew[0], system.Enth_s(0));
-        }
-      } // end of post-processing
-
-      // compute basal melt rate
       {
-        bool base_is_cold = (Enthnew[0] < system.Enth_s(0)) && (till_water_thickness(i,j) == 0.0);
-        // Determine melt rate, but only preliminarily because of
-        // drainage, from heat flux out of bedrock, heat flux into
-        // ice, and frictional heating
-        if (is_floating) {
-          // The floating basal melt rate will be set later; cover
-          // this case and set to zero for now. Note that
-          // Hdrainedtotal is discarded (the ocean model determines
-          // the basal melt).
-          m_basal_melt_rate(i, j) = 0.0;
-        } else {
-          if (base_is_cold) {
-            m_basal_melt_rate(i, j) = 0.0;  // zero melt rate if cold base
-          } else {
-            const double
-              p_0 = EC->pressure(H),
-              p_1 = EC->pressure(H - dz), // FIXME issue #15
-              Tpmp_0 = EC->melting_temperature(p_0);
-
-            const bool k1_istemperate = EC->is_temperate(Enthnew[1], p_1); // level  z = + \Delta z
-            double hf_up = 0.0;
-            if (k1_istemperate) {
-              const double
-                Tpmp_1 = EC->melting_temperature(p_1);
-
-              hf_up = -system.k_from_T(Tpmp_0) * (Tpmp_1 - Tpmp_0) / dz;
-            } else {
-              double T_0 = EC->temperature(Enthnew[0], p_0);
-              const double K_0 = system.k_from_T(T_0) / EC->c();
-
-              hf_up = -K_0 * (Enthnew[1] - Enthnew[0]) / dz;
-            }
-
-            // compute basal melt rate from flux balance:
-            //
-            // basal_melt_rate = - Mb / rho in [\ref AschwandenBuelerKhroulevBlatter];
-            //
-            // after we compute it we make sure there is no refreeze if
-            // there is no available basal water
-            m_basal_melt_rate(i, j) = (basal_frictional_heating(i, j) + basal_heat_flux(i, j) - hf_up) / (ice_density * EC->L(Tpmp_0));
+        double *stats = row_stats.bucket(j - ys);
+        stats[0] = row_liquified;
+        stats[1] = row_reduced_accuracy;
+        stats[2] = row_bulge;
+      }
+    } // end of the loop over rows
 
-            if (till_water_thickness(i, j) <= 0 && m_basal_melt_rate(i, j) < 0) {
-              m_basal_melt_rate(i, j) = 0.0;
-            }
-          }
+    if (exception != nullptr) {
+      std::rethrow_exception(exception);
+    }
 
-          // Add drained water from the column to basal melt rate.
-          m_basal_melt_rate(i, j) += Hdrainedtotal / dt;
-        } // end of the grounded case
-      } // end of the basal melt rate computation
+    {
+      double totals[3];
+      row_stats.total(totals);
 
-      system.fine_to_coarse(Enthnew, i, j, m_work);
+      liquifiedCount                   += (unsigned int)totals[0];
+      m_stats.reduced_accuracy_counter += (unsigned int)totals[1];
+      m_stats.bulge_counter            += (unsigned int)totals[2];
     }
   } catch (...) {
     loop.failed();
@@ -31,6 +31,8 @@ public:
   EnthalpyModel(std::shared_ptr<const Grid> grid,
                 std::shared_ptr<const stressbalance::StressBalance> stress_balance);
 
+  virtual bool can_update_age() const;
+
 protected:
   virtual void restart_impl(const File &input_file, int record);
 
@@ -59,6 +61,8 @@ public:
   DummyEnergyModel(std::shared_ptr<const Grid> grid,
                    std::shared_ptr<const stressbalance::StressBalance> stress_balance);
 
+  bool can_update_age() const;
+
 protected:
   MaxTimestep max_timestep_impl(double t) const;
 
@@ -327,13 +327,11 @@ void TemperatureModel::update_impl(double t, double dt, const Inputs &inputs) {
         }
       }
 
-      // set to air temp above ice
-      for (unsigned int k = ks; k < Mz_fine; k++) {
-        Tnew[k] = T_surface;
-      }
+      // set to air temp at and above the ice surface
+      Tnew[ks] = T_surface;
 
       // transfer column into m_work; communication later
-      system.fine_to_coarse(Tnew, i, j, m_work);
+      system.fine_to_coarse(Tnew, i, j, ks, T_surface, m_work);
 
       // basal_melt_rate(i,j) is rate of mass loss at bottom of ice
       if (ocean(mask)) {
@@ -20,6 +20,9 @@
 #ifndef BOOTSTRAPPING_H
 #define BOOTSTRAPPING_H
 
+#include <algorithm>            // std::min
+#include <cmath>                // sqrt, erf, M_PI
+
 #include "pism/util/EnthalpyConverter.hh"
 
 namespace pism {
@@ -41,10 +44,24 @@ namespace energy {
  * @param[in] T_surface surface temperature, in kelvin
  * @param[in] G upward basal heat flux, in `W / meter^2`
  * @param[in] ice_k thermal conductivity of ice
+ *
+ * Defined in the header so that calls in bootstrapping loops can be inlined.
  */
-double ice_temperature_guess(EnthalpyConverter &EC,
-                             double H, double z, double T_surface,
-                             double G, double ice_k);
+inline double ice_temperature_guess(EnthalpyConverter &EC,
+                                    double H, double z, double T_surface,
+                                    double G, double ice_k) {
+
+  const double
+    depth = H - z,
+    d2    = depth * depth,
+    Tpmp  = EC.melting_temperature(EC.pressure(depth));
+
+  const double
+    beta = (4.0/21.0) * (G / (2.0 * ice_k * H * H * H)),
+    alpha = (G / (2.0 * H * ice_k)) - 2.0 * H * H * beta;
+
+  return std::min(Tpmp, T_surface + alpha * d2 + beta * d2 * d2);
+}
 
 /*!
  * A heuristic formula for the temperature distribution within a column of ice. Used during
@@ -60,9 +77,22 @@ double ice_temperature_guess(EnthalpyConverter &EC,
  *              ice specific heat capacity
  * @param[in] SMB surface mass balance in `m / second`
  */
-double ice_temperature_guess_smb(EnthalpyConverter &EC,
-                                 double H, double z, double T_surface,
-                                 double G, double ice_k, double K, double SMB);
+inline double ice_temperature_guess_smb(EnthalpyConverter &EC, double H, double z,
+                                        double T_surface, double G, double ice_k,
+                                        double K, double SMB) {
+  const double depth = H - z, Tpmp = EC.melting_temperature(EC.pressure(depth));
+
+  if (SMB <= 0.0) {
+    // negative or zero surface mass balance: linear temperature profile
+    return std::min(Tpmp, G / ice_k * depth + T_surface);
+  }
+
+  // positive surface mass balance
+  const double C0     = (G * sqrt(M_PI * H * K)) / (ice_k * sqrt(2.0 * SMB)),
+               gamma0 = sqrt(SMB * H / (2.0 * K));
+
+  return std::min(Tpmp, T_surface + C0 * (erf(gamma0) - erf(gamma0 * z / H)));
+}
 
 } // end of namespace energy
 } // end of namespace pism
@@ -60,7 +60,6 @@ enthSystemCtx::enthSystemCtx(const std::vector<double>& storage_grid,
   m_ice_density = config.get_number("constants.ice.density");
   m_ice_c   = config.get_number("constants.ice.specific_heat_capacity");
   m_ice_k   = config.get_number("constants.ice.thermal_conductivity");
-  m_p_air   = config.get_number("surface.pressure");
 
   m_margin_exclude_horizontal_advection = config.get_flag("energy.margin_exclude_horizontal_advection");
   m_margin_exclude_vertical_advection   = config.get_flag("energy.margin_exclude_vertical_advection");
@@ -107,7 +106,13 @@ double enthSystemCtx::k_from_T(double T) const {
   return m_ice_k;
 }
 
-void enthSystemCtx::init(int i, int j, bool marginal, double ice_thickness) {
+/*!
+  If `velocity_source` is not NULL, the velocity columns it interpolated onto the fine
+  grid (for the same `i`, `j`) are re-used instead of interpolating them again; see
+  columnSystemCtx::copy_velocity_columns().
+*/
+void enthSystemCtx::init(int i, int j, bool marginal, double ice_thickness,
+                         const columnSystemCtx *velocity_source) {
   m_ice_thickness = ice_thickness;
 
   m_marginal = marginal;
@@ -118,15 +123,21 @@ void enthSystemCtx::init(int i, int j, bool marginal, double ice_thickness) {
     return;
   }
 
-  coarse_to_fine(m_u3, m_i, m_j, m_u.data());
-  coarse_to_fine(m_v3, m_i, m_j, m_v.data());
+  if (velocity_source != nullptr) {
+    copy_velocity_columns(*velocity_source);
+  } else {
+    coarse_to_fine(m_u3, m_i, m_j, m_u.data());
+    coarse_to_fine(m_v3, m_i, m_j, m_v.data());
+
+    if (not (m_marginal and m_margin_exclude_vertical_advection)) {
+      coarse_to_fine(m_w3, m_i, m_j, m_w.data());
+    }
+  }
 
   if (m_marginal and m_margin_exclude_vertical_advection) {
     for (unsigned int k = 0; k < m_w.size(); ++k) {
       m_w[k] = 0.0;
     }
-  } else {
-    coarse_to_fine(m_w3, m_i, m_j, m_w.data());
   }
 
   coarse_to_fine(m_strain_heating3, m_i, m_j, m_strain_heating.data());
@@ -157,10 +168,12 @@ void enthSystemCtx::compute_enthalpy_CTS() {
     m_Enth_s[k] = m_EC->enthalpy_cts(p);
   }
 
-  const double Es_air = m_EC->enthalpy_cts(m_p_air);
+  // Enth_s[k] for k > m_ks are never used
+#if (Pism_DEBUG==1)
   for (unsigned int k = m_ks+1; k < m_Enth_s.size(); k++) {
-    m_Enth_s[k] = Es_air;
+    m_Enth_s[k] = NAN;
   }
+#endif
 }
 
 //! Compute the lambda for BOMBPROOF.
@@ -496,43 +509,9 @@ void enthSystemCtx::solve(std::vector<double> &result) {
   S.U(0)   = m_U0;
   S.RHS(0) = m_B0;
 
-  const double
-    one_over_rho = 1.0 / m_ice_density,
-    Dx = 1.0 / m_dx,
-    Dy = 1.0 / m_dy;
-
-  const bool include_horizontal_advection = not (m_marginal and m_margin_exclude_horizontal_advection);
-  const bool include_strain_heating       = not (m_marginal and m_margin_exclude_strain_heat);
-
   // generic ice segment in k location (if any; only runs if m_ks >= 2)
   for (unsigned int k = 1; k < m_ks; k++) {
-    const double
-      Rminus = 0.5 * (m_R[k-1] + m_R[k]),   // R_{k-1/2}
-      Rplus  = 0.5 * (m_R[k]   + m_R[k+1]), // R_{k+1/2}
-      nu_w   = m_nu * m_w[k];
-
-    const double
-      A_l = m_w[k] >= 0.0 ? 0.5 * m_lambda - 1.0 : -0.5 * m_lambda,
-      A_d = m_w[k] >= 0.0 ? 1.0 - m_lambda : m_lambda - 1.0,
-      A_u = m_w[k] >= 0.0 ? 0.5 * m_lambda : 1.0 - 0.5 * m_lambda;
-
-    S.L(k) = - Rminus + nu_w * A_l;
-    S.D(k) = 1.0 + Rminus + Rplus + nu_w * A_d;
-    S.U(k) = - Rplus + nu_w * A_u;
-
-    // horizontal velocity and strain heating
-    double upwind_u = 0.0;
-    double upwind_v = 0.0;
-    if (include_horizontal_advection) {
-      upwind_u = upwind(m_u[k], m_E_w[k], m_Enth[k], m_E_e[k], Dx);
-      upwind_v = upwind(m_v[k], m_E_s[k], m_Enth[k], m_E_n[k], Dy);
-    }
-    double Sigma    = 0.0;
-    if (include_strain_heating) {
-      Sigma    = m_strain_heating[k];
-    }
-
-    S.RHS(k) = m_Enth[k] + m_dt * (one_over_rho * Sigma - upwind_u - upwind_v);
+    assemble_interior_row(k, S.L(k), S.D(k), S.U(k), S.RHS(k));
   }
 
   // Assemble the top surface equation. Values m_{L,D,U,B}_ks are set using set_surface_dirichlet()
@@ -557,10 +536,8 @@ void enthSystemCtx::solve(std::vector<double> &result) {
     throw;
   }
 
-  // air above
-  for (unsigned int k = m_ks+1; k < result.size(); k++) {
-    result[k] = m_B_ks;
-  }
+  // result[k] for k > m_ks (i.e. above the ice) is not modified: use the
+  // fine_to_coarse() overload taking an above-ice value to transfer the column
 
 #if (Pism_DEBUG==1)
   // if success, mark column as done by making scheme params and b.c. coeffs invalid
@@ -575,6 +552,100 @@ void enthSystemCtx::solve(std::vector<double> &result) {
 #endif
 }
 
+//! Assemble the equation corresponding to a generic interior level `k` (0 < k < ks).
+/*!
+  This is the loop body of the assembly in solve(), shared with the batched
+  path (add_to_batch()). See solve() for the discretization.
+ */
+void enthSystemCtx::assemble_interior_row(unsigned int k,
+                                          double &L, double &D, double &U, double &B) const {
+  const double
+    Rminus = 0.5 * (m_R[k-1] + m_R[k]),   // R_{k-1/2}
+    Rplus  = 0.5 * (m_R[k]   + m_R[k+1]), // R_{k+1/2}
+    nu_w   = m_nu * m_w[k];
+
+  const double
+    A_l = m_w[k] >= 0.0 ? 0.5 * m_lambda - 1.0 : -0.5 * m_lambda,
+    A_d = m_w[k] >= 0.0 ? 1.0 - m_lambda : m_lambda - 1.0,
+    A_u = m_w[k] >= 0.0 ? 0.5 * m_lambda : 1.0 - 0.5 * m_lambda;
+
+  L = - Rminus + nu_w * A_l;
+  D = 1.0 + Rminus + Rplus + nu_w * A_d;
+  U = - Rplus + nu_w * A_u;
+
+  const bool include_horizontal_advection = not (m_marginal and m_margin_exclude_horizontal_advection);
+  const bool include_strain_heating       = not (m_marginal and m_margin_exclude_strain_heat);
+
+  // horizontal velocity and strain heating
+  double upwind_u = 0.0;
+  double upwind_v = 0.0;
+  if (include_horizontal_advection) {
+    upwind_u = upwind(m_u[k], m_E_w[k], m_Enth[k], m_E_e[k], 1.0 / m_dx);
+    upwind_v = upwind(m_v[k], m_E_s[k], m_Enth[k], m_E_n[k], 1.0 / m_dy);
+  }
+  double Sigma = 0.0;
+  if (include_strain_heating) {
+    Sigma = m_strain_heating[k];
+  }
+
+  B = m_Enth[k] + m_dt * (Sigma / m_ice_density - upwind_u - upwind_v);
+}
+
+//! \brief Add this column's system to a batch solved by TridiagonalSystemBatch.
+/*!
+  Performs the same assembly as solve() but stores the coefficients in lane
+  `lane` of `batch` instead of solving immediately, so that several columns
+  can be solved together. The batch solve produces the same solution as the
+  per-column path.
+
+  Boundary condition rows have to be set (see solve()) before this call.
+ */
+void enthSystemCtx::add_to_batch(TridiagonalSystemBatch &batch, unsigned int lane) {
+#if (Pism_DEBUG==1)
+  checkReadyToSolve();
+  if (std::isnan(m_D0) || std::isnan(m_U0) || std::isnan(m_B0)) {
+    throw RuntimeError(PISM_ERROR_LOCATION,
+                       "add_to_batch() should only be called after\n"
+                       "  setting basal boundary condition in enthSystemCtx");
+  }
+#endif
+
+  // k=0 equation is already established
+  batch.D(0, lane)   = m_D0;
+  batch.U(0, lane)   = m_U0;
+  batch.RHS(0, lane) = m_B0;
+
+  // generic ice segment in k location (if any; only runs if m_ks >= 2)
+  for (unsigned int k = 1; k < m_ks; k++) {
+    assemble_interior_row(k, batch.L(k, lane), batch.D(k, lane),
+                          batch.U(k, lane), batch.RHS(k, lane));
+  }
+
+  // the top surface equation
+  if (m_ks > 0) {
+    batch.L(m_ks, lane) = m_L_ks;
+  }
+  batch.D(m_ks, lane) = m_D_ks;
+  if (m_ks < m_z.size() - 1) {
+    batch.U(m_ks, lane) = m_U_ks;
+  }
+  batch.RHS(m_ks, lane) = m_B_ks;
+
+  batch.set_size(lane, m_ks + 1);
+
+#if (Pism_DEBUG==1)
+  // mark column as done by making scheme params and b.c. coeffs invalid
+  m_lambda = -1.0;
+  m_D0     = NAN;
+  m_U0     = NAN;
+  m_B0     = NAN;
+  m_L_ks = NAN;
+  m_D_ks = NAN;
+  m_U_ks = NAN;
+  m_B_ks = NAN;
+#endif
+}
+
 void enthSystemCtx::save_system(std::ostream &output, unsigned int system_size) const {
   m_solver->save_system(output, system_size);
   pism::TridiagonalSystem::save_vector(output, m_R, system_size, m_solver->prefix() + "_R");
@@ -50,7 +50,8 @@ public:
                 std::shared_ptr<EnthalpyConverter> EC);
   ~enthSystemCtx() = default;
 
-  void init(int i, int j, bool ismarginal, double ice_thickness);
+  void init(int i, int j, bool ismarginal, double ice_thickness,
+            const columnSystemCtx *velocity_source = nullptr);
 
   double k_from_T(double T) const;
 
@@ -66,6 +67,8 @@ public:
 
   void solve(std::vector<double> &result);
 
+  void add_to_batch(TridiagonalSystemBatch &batch, unsigned int lane);
+
   double lambda() const {
     return m_lambda;
   }
@@ -93,7 +96,7 @@ protected:
   //! values of @f$ k \Delta t / (\rho c \Delta x^2) @f$
   std::vector<double> m_R;
 
-  double m_ice_density, m_ice_c, m_ice_k, m_p_air,
+  double m_ice_density, m_ice_c, m_ice_k,
     m_nu, m_R_cold, m_R_temp, m_R_factor;
 
   double m_ice_thickness,
@@ -113,6 +116,7 @@ protected:
   double compute_lambda();
 
   void assemble_R();
+  void assemble_interior_row(unsigned int k, double &L, double &D, double &U, double &B) const;
   void checkReadyToSolve() const;
 };
 
@@ -17,9 +17,12 @@
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <exception>            // std::exception_ptr
+
 #include "pism/energy/utilities.hh"
 
 #include "pism/energy/bootstrapping.hh"
+#include "pism/pism_config.hh"  // Pism_USE_OPENMP
 #include "pism/util/Config.hh"
 #include "pism/util/Context.hh"
 #include "pism/util/EnthalpyConverter.hh"
@@ -360,72 +363,102 @@ void bootstrap_ice_temperature(const array::Scalar &ice_thickness,
   array::AccessScope list{&ice_surface_temp, &surface_mass_balance,
       &ice_thickness, &basal_heat_flux, &result};
 
+  // Used in error messages below; fetched before the loop because the configuration
+  // database is not thread-safe.
+  const std::string flux_units = basal_heat_flux.metadata()["units"];
+  const int Mbz = (int)config->get_number("grid.Mbz");
+
   ParallelSection loop(grid->com);
   try {
-    for (auto p : grid->points()) {
-      const int i = p.i(), j = p.j();
-
-      const double
-        T_surface = std::min(ice_surface_temp(i, j), T_melting),
-        H         = ice_thickness(i, j),
-        G         = basal_heat_flux(i, j);
-
-      const unsigned int ks = grid->kBelowHeight(H);
-
-      if (G < 0.0 and ks > 0) {
-        std::string units = basal_heat_flux.metadata()["units"];
-        int Mbz = config->get_number("grid.Mbz");
-        const char *quantity = (Mbz > 0 ?
-                                "temperature of the bedrock thermal layer" :
-                                "geothermal flux");
-        throw RuntimeError::formatted(PISM_ERROR_LOCATION,
-                                      "Negative upward heat flux (%f %s) through the bottom of the ice column\n"
-                                      "is not allowed by PISM's ice temperature bootstrapping method.\n"
-                                      "Please check the %s at i=%d, j=%d.",
-                                      G, units.c_str(), quantity, i, j);
-      }
-
-      if (T_surface < T_min) {
-        throw RuntimeError::formatted(PISM_ERROR_LOCATION,
-                                      "T_surface(%d,%d) = %f < T_min = %f kelvin",
-                                      i, j, T_surface, T_min);
-      }
-
-      double *T = result.get_column(i, j);
-
-      // within ice
-      if (use_smb) { // method 1:  includes surface mass balance in estimate
-
-        // Convert SMB from "kg m-2 s-1" to "m second-1".
-        const double SMB = surface_mass_balance(i, j) / ice_density;
-
-        for (unsigned int k = 0; k < ks; k++) {
-          const double z = grid->z(k);
-          T[k] = ice_temperature_guess_smb(*EC, H, z, T_surface, G, ice_k, K, SMB);
-        }
-
-      } else { // method 2: a quartic guess; does not use SMB
-
-        for (unsigned int k = 0; k < ks; k++) {
-          const double z = grid->z(k);
-          T[k] = ice_temperature_guess(*EC, H, z, T_surface, G, ice_k);
+    const int
+      xs = grid->xs(), xm = grid->xm(),
+      ys = grid->ys(), ym = grid->ym();
+
+    // Exceptions must not propagate out of an OpenMP parallel region: stash the first
+    // one thrown by a thread and re-throw it after the loop.
+    std::exception_ptr exception = nullptr;
+
+#if Pism_USE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int j = ys; j < ys + ym; ++j) {
+      try {
+        for (int i = xs; i < xs + xm; ++i) {
+
+          const double
+            T_surface = std::min(ice_surface_temp(i, j), T_melting),
+            H         = ice_thickness(i, j),
+            G         = basal_heat_flux(i, j);
+
+          const unsigned int ks = grid->kBelowHeight(H);
+
+          if (G < 0.0 and ks > 0) {
+            const char *quantity = (Mbz > 0 ?
+                                    "temperature of the bedrock thermal layer" :
+                                    "geothermal flux");
+            throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                          "Negative upward heat flux (%f %s) through the bottom of the ice column\n"
+                                          "is not allowed by PISM's ice temperature bootstrapping method.\n"
+                                          "Please check the %s at i=%d, j=%d.",
+                                          G, flux_units.c_str(), quantity, i, j);
+          }
+
+          if (T_surface < T_min) {
+            throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                          "T_surface(%d,%d) = %f < T_min = %f kelvin",
+                                          i, j, T_surface, T_min);
+          }
+
+          double *T = result.get_column(i, j);
+
+          // within ice
+          if (use_smb) { // method 1:  includes surface mass balance in estimate
+
+            // Convert SMB from "kg m-2 s-1" to "m second-1".
+            const double SMB = surface_mass_balance(i, j) / ice_density;
+
+            for (unsigned int k = 0; k < ks; k++) {
+              const double z = grid->z(k);
+              T[k] = ice_temperature_guess_smb(*EC, H, z, T_surface, G, ice_k, K, SMB);
+            }
+
+          } else { // method 2: a quartic guess; does not use SMB
+
+            for (unsigned int k = 0; k < ks; k++) {
+              const double z = grid->z(k);
+              T[k] = ice_temperature_guess(*EC, H, z, T_surface, G, ice_k);
+            }
+
+          }
+
+          // Make sure that resulting temperatures are not too low.
+          for (unsigned int k = 0; k < ks; k++) {
+            if (T[k] < T_min) {
+              throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                            "T(%d,%d,%d) = %f < T_min = %f kelvin",
+                                            i, j, k, T[k], T_min);
+            }
+          }
+
+          // above ice
+          for (unsigned int k = ks; k < grid->Mz(); k++) {
+            T[k] = T_surface;
+          }
         }
-
-      }
-
-      // Make sure that resulting temperatures are not too low.
-      for (unsigned int k = 0; k < ks; k++) {
-        if (T[k] < T_min) {
-          throw RuntimeError::formatted(PISM_ERROR_LOCATION,
-                                        "T(%d,%d,%d) = %f < T_min = %f kelvin",
-                                        i, j, k, T[k], T_min);
+      } catch (...) {
+#if Pism_USE_OPENMP
+#pragma omp critical (pism_bootstrap_exception)
+#endif
+        {
+          if (exception == nullptr) {
+            exception = std::current_exception();
+          }
         }
       }
+    }
 
-      // above ice
-      for (unsigned int k = ks; k < grid->Mz(); k++) {
-        T[k] = T_surface;
-      }
+    if (exception != nullptr) {
+      std::rethrow_exception(exception);
     }
   } catch (...) {
     loop.failed();
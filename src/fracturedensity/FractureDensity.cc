@@ -42,7 +42,6 @@ FractureDensity::FractureDensity(std::shared_ptr<const Grid> grid,
       m_toughness(grid, "fracture_toughness"),
       m_strain_rates(grid, "strain_rates", array::WITHOUT_GHOSTS),
       m_deviatoric_stresses(grid, "sigma", array::WITHOUT_GHOSTS, 3),
-      m_velocity(grid, "ghosted_velocity"),
       m_flow_law(flow_law) {
 
   m_density.metadata(0).long_name("fracture density in ice shelf").units("1");
@@ -130,7 +129,7 @@ void FractureDensity::write_state_impl(const OutputFile &output) const {
 
 void FractureDensity::update(double dt,
                              const Geometry &geometry,
-                             const array::Vector &velocity,
+                             const array::Vector1 &velocity,
                              const array::Scalar &hardness,
                              const array::Scalar &bc_mask) {
   using std::pow;
@@ -149,19 +148,17 @@ void FractureDensity::update(double dt,
     &D_new = m_density_new,
     &A_new = m_age_new;
 
-  m_velocity.copy_from(velocity);
-
-  stressbalance::compute_2D_principal_strain_rates(m_velocity,
-                                                   geometry.cell_type,
-                                                   m_strain_rates);
-
-  stressbalance::compute_2D_stresses(*m_flow_law,
-                                     m_velocity,
-                                     hardness,
-                                     geometry.cell_type,
-                                     m_deviatoric_stresses);
-
-  array::AccessScope list{&m_velocity, &m_strain_rates, &m_deviatoric_stresses,
+  // one pass over the grid computes both the principal strain rates and the deviatoric
+  // stresses; `velocity` is ghosted (see ShallowStressBalance::velocity()), so no
+  // ghosted copy is needed here
+  stressbalance::compute_2D_strain_rates_and_stresses(*m_flow_law,
+                                                      velocity,
+                                                      hardness,
+                                                      geometry.cell_type,
+                                                      m_strain_rates,
+                                                      m_deviatoric_stresses);
+
+  array::AccessScope list{&velocity, &m_strain_rates, &m_deviatoric_stresses,
                                &D, &D_new, &geometry.cell_type, &bc_mask, &A, &A_new,
                                &m_growth_rate, &m_healing_rate, &m_flow_enhancement,
                                &m_toughness, &hardness, &geometry.ice_thickness};
@@ -231,8 +228,8 @@ void FractureDensity::update(double dt,
 
     double tempFD = 0.0;
 
-    double u = m_velocity(i, j).u;
-    double v = m_velocity(i, j).v;
+    double u = velocity(i, j).u;
+    double v = velocity(i, j).v;
 
     if (fd2d_scheme) {
       if (u >= dx * v / dy and v >= 0.0) { //1
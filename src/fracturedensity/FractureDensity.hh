@@ -43,7 +43,7 @@ public:
 
   void update(double dt,
               const Geometry &geometry,
-              const array::Vector &velocity,
+              const array::Vector1 &velocity,
               const array::Scalar &hardness,
               const array::Scalar &inflow_boundary_mask);
 
@@ -76,9 +76,6 @@ private:
   //! components of horizontal stress tensor along axes and shear stress (temporary storage)
   array::Array2D<stressbalance::DeviatoricStresses> m_deviatoric_stresses;
 
-  //! Ghosted copy of the ice velocity
-  array::Vector1 m_velocity;
-
   std::shared_ptr<const rheology::FlowLaw> m_flow_law;
 };
 
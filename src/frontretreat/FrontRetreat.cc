@@ -16,9 +16,12 @@
  * along with PISM; if not, write to the Free Software
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
+#include <cmath>                // std::ceil
+
 #include "pism/frontretreat/FrontRetreat.hh"
 
 #include "pism/util/array/CellType.hh"
+#include "pism/util/Mask.hh"    // GeometryCalculator
 #include "pism/util/MaxTimestep.hh"
 #include "pism/util/pism_utilities.hh"
 #include "pism/geometry/part_grid_threshold_thickness.hh"
@@ -31,10 +34,14 @@ namespace pism {
 FrontRetreat::FrontRetreat(std::shared_ptr<const Grid> g)
   : Component(g),
     m_cell_type(m_grid, "cell_type"),
-    m_tmp(m_grid, "temporary_storage") {
+    m_tmp(m_grid, "temporary_storage"),
+    m_surface(m_grid, "surface_elevation"),
+    m_retreat_rate(m_grid, "retreat_rate") {
 
   m_tmp.metadata(0).long_name("additional mass loss at points near the front").units("m");
   m_cell_type.metadata(0).long_name("cell type mask");
+  m_surface.metadata(0).long_name("ice surface elevation").units("m");
+  m_retreat_rate.metadata(0).long_name("horizontal retreat rate").units("m s^-1");
 }
 
 /*!
@@ -68,6 +75,10 @@ void FrontRetreat::compute_modified_mask(const array::CellType1 &input,
 
 /*!
  * Compute the maximum time step length provided a horizontal retreat rate.
+ *
+ * Note: update_geometry() sub-cycles internally, so this restriction is not required for
+ * the retreat to be applied correctly. It is used only if
+ * geometry.front_retreat.use_cfl is set.
  */
 MaxTimestep FrontRetreat::max_timestep(const array::CellType1 &cell_type,
                                        const array::Scalar &bc_mask,
@@ -135,6 +146,15 @@ MaxTimestep FrontRetreat::max_timestep(const array::CellType1 &cell_type,
  * This code applies a horizontal retreat rate at "partially-filled" cells that are next
  * to icy cells.
  *
+ * One application of the retreat rate (see retreat_step()) can move the front by at most
+ * one grid cell, so instead of requiring a global time step restriction (see
+ * max_timestep()) we sub-cycle: the interval `dt` is split into sub-steps short enough
+ * for the fastest-retreating cell and the retreat step is applied repeatedly, updating
+ * the cell type mask and the surface elevation in between. This way a quickly-retreating
+ * fjord affects the cost of this update, but not the time step of the whole model. Cells
+ * exposed by retreat during sub-cycling inherit the retreat rate of their ice-free ocean
+ * neighbors (models compute rates at the original front only).
+ *
  * Models providing the "retreat rate" should set this field to zero in areas where a
  * particular parameterization does not apply. (For example: some calving models apply at
  * shelf calving fronts, others may apply at grounded termini but not at ice shelves,
@@ -149,9 +169,10 @@ void FrontRetreat::update_geometry(double dt,
 
   const array::Scalar1 &bed = geometry.bed_elevation;
   const array::Scalar1 &sea_level = geometry.sea_level_elevation;
-  const array::Scalar1 &surface_elevation = geometry.ice_surface_elevation;
 
-  if (m_config->get_flag("geometry.front_retreat.wrap_around")) {
+  bool wrap_around = m_config->get_flag("geometry.front_retreat.wrap_around");
+
+  if (wrap_around) {
     m_cell_type.copy_from(geometry.cell_type);
   } else {
     // compute the modified mask needed to prevent front retreat from "wrapping around"
@@ -159,13 +180,124 @@ void FrontRetreat::update_geometry(double dt,
     compute_modified_mask(geometry.cell_type, m_cell_type);
   }
 
+  m_surface.copy_from(geometry.ice_surface_elevation);
+  m_retreat_rate.copy_from(retreat_rate);
+
+  // Choose the number of sub-steps so that during each sub-step the front retreats by at
+  // most (roughly) one grid cell. The minimum allowed sub-step length bounds the cost of
+  // sub-cycling.
+  unsigned int N_steps = 1;
+  {
+    double rate_max = 0.0;
+    {
+      array::AccessScope list{&m_cell_type, &bc_mask, &m_retreat_rate};
+
+      for (auto pt : m_grid->points()) {
+        const int i = pt.i(), j = pt.j();
+
+        if (m_cell_type.ice_free_ocean(i, j) and
+            m_cell_type.next_to_ice(i, j) and
+            bc_mask(i, j) < 0.5) {
+          rate_max = std::max(m_retreat_rate(i, j), rate_max);
+        }
+      }
+    }
+    rate_max = GlobalMax(m_grid->com, rate_max);
+
+    if (rate_max > 0.0) {
+      double dt_min = m_config->get_number("geometry.front_retreat.minimum_time_step",
+                                           "seconds");
+      double sub_dt = std::max(m_grid->dx() / rate_max, dt_min);
+
+      N_steps = std::max(1, (int)std::ceil(dt / sub_dt));
+    }
+  }
+
+  double sub_dt = dt / N_steps;
+
+  GeometryCalculator gc(*m_config);
+
+  std::vector<std::pair<int, int> > newly_exposed;
+
+  for (unsigned int n = 0; n < N_steps; ++n) {
+
+    newly_exposed.clear();
+
+    retreat_step(sub_dt, bc_mask, bed, sea_level, Href, ice_thickness, newly_exposed);
+
+    if (n + 1 == N_steps) {
+      break;
+    }
+
+    // Prepare for the next sub-step: the front may have moved, so the cell type mask,
+    // the surface elevation, and retreat rates at the new front location have to be
+    // updated.
+
+    ice_thickness.update_ghosts();
+
+    gc.compute_mask(sea_level, bed, ice_thickness, m_cell_type);
+    if (not wrap_around) {
+      // re-apply the modification preventing wrap-around (this is a point-wise
+      // operation, so using the same array as the input and the output is safe)
+      compute_modified_mask(m_cell_type, m_cell_type);
+    }
+    gc.compute_surface(sea_level, bed, ice_thickness, m_surface);
+
+    // A cell exposed during this sub-step was an icy interior cell when retreat rates
+    // were computed, so the rate there is not set. Let the front keep retreating through
+    // it using the highest rate among its ice-free ocean neighbors (one of which drove
+    // the retreat into this cell). New rates are gathered first and applied after to
+    // make the result independent of the traversal order.
+    {
+      array::AccessScope list{&m_cell_type, &m_retreat_rate};
+
+      std::vector<double> new_rates(newly_exposed.size());
+
+      for (size_t k = 0; k < newly_exposed.size(); ++k) {
+        const int i = newly_exposed[k].first, j = newly_exposed[k].second;
+
+        double R = 0.0;
+        for (int p = -1; p < 2; p += 2) {
+          if (m_cell_type.ice_free_ocean(i + p, j)) {
+            R = std::max(R, m_retreat_rate(i + p, j));
+          }
+          if (m_cell_type.ice_free_ocean(i, j + p)) {
+            R = std::max(R, m_retreat_rate(i, j + p));
+          }
+        }
+        new_rates[k] = R;
+      }
+
+      for (size_t k = 0; k < newly_exposed.size(); ++k) {
+        m_retreat_rate(newly_exposed[k].first, newly_exposed[k].second) = new_rates[k];
+      }
+    }
+    m_retreat_rate.update_ghosts();
+  }
+}
+
+/*!
+ * Apply the horizontal retreat rate stored in `m_retreat_rate` over the interval `dt`.
+ *
+ * Records cells converted from icy to "partially-filled" in `newly_exposed`.
+ *
+ * Requires up to date `m_cell_type` and `m_surface` (including ghosts).
+ */
+void FrontRetreat::retreat_step(double dt,
+                                const array::Scalar1 &bc_mask,
+                                const array::Scalar1 &bed,
+                                const array::Scalar1 &sea_level,
+                                array::Scalar &Href,
+                                array::Scalar1 &ice_thickness,
+                                std::vector<std::pair<int, int> > &newly_exposed) {
+
   const double dx = m_grid->dx();
 
   m_tmp.set(0.0);
 
   array::AccessScope list{&ice_thickness, &bc_mask,
-      &bed, &sea_level, &m_cell_type, &Href, &m_tmp, &retreat_rate,
-      &surface_elevation};
+      &bed, &sea_level, &m_cell_type, &Href, &m_tmp, &m_retreat_rate,
+      &m_surface};
 
   // Step 1: Apply the computed horizontal retreat rate:
   for (auto pt : m_grid->points()) {
@@ -178,13 +310,13 @@ void FrontRetreat::update_geometry(double dt,
       // NB: this condition has to match the one in max_timestep()
 
       const double
-        rate     = retreat_rate(i, j),
+        rate     = m_retreat_rate(i, j),
         Href_old = Href(i, j);
 
       // Compute the number of floating neighbors and the neighbor-averaged ice thickness:
       double H_threshold = part_grid_threshold_thickness(m_cell_type.star_int(i, j),
                                                          ice_thickness.star(i, j),
-                                                         surface_elevation.star(i, j),
+                                                         m_surface.star(i, j),
                                                          bed(i, j));
 
       // Calculate mass loss with respect to the associated ice thickness and the grid size:
@@ -253,6 +385,7 @@ void FrontRetreat::update_geometry(double dt,
       if (delta_H < 0.0) {
         Href(i, j) = ice_thickness(i, j) + delta_H; // in m
         ice_thickness(i, j) = 0.0;
+        newly_exposed.emplace_back(i, j);
       }
 
       // Stop retreat if the current cell does not have enough ice to absorb the loss.
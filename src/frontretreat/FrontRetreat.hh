@@ -20,6 +20,9 @@
 #ifndef FRONTRETREAT_H
 #define FRONTRETREAT_H
 
+#include <utility>              // std::pair
+#include <vector>
+
 #include "pism/util/Component.hh"
 #include "pism/util/array/CellType.hh"
 #include "pism/util/MaxTimestep.hh"
@@ -53,6 +56,14 @@ private:
   void compute_modified_mask(const array::CellType1 &input,
                              array::CellType1 &output) const;
 
+  void retreat_step(double dt,
+                    const array::Scalar1 &bc_mask,
+                    const array::Scalar1 &bed,
+                    const array::Scalar1 &sea_level,
+                    array::Scalar &Href,
+                    array::Scalar1 &ice_thickness,
+                    std::vector<std::pair<int, int> > &newly_exposed);
+
   // Ghosted cell type mask
   //
   // We make a copy here because frontal retreat code uses a modified mask if
@@ -61,6 +72,12 @@ private:
   // Temporary storage for distributing ice loss to "full" (as opposed to "partially
   // filled") cells near the front
   array::Scalar1 m_tmp;
+  // Working copy of the ice surface elevation, updated between sub-steps (see
+  // update_geometry())
+  array::Scalar1 m_surface;
+  // Working copy of the retreat rate, extended to cells exposed by the retreating front
+  // during sub-stepping
+  array::Scalar1 m_retreat_rate;
 };
 
 } // end of namespace pism
@@ -22,7 +22,6 @@
 #include "pism/util/Grid.hh"
 #include "pism/util/error_handling.hh"
 #include "pism/util/array/CellType.hh"
-#include "pism/stressbalance/StressBalance.hh"
 #include "pism/util/Logger.hh"
 
 namespace pism {
@@ -64,6 +63,7 @@ void EigenCalving::update(const array::CellType &cell_type,
   // make a copy with a wider stencil
   m_cell_type.copy_from(cell_type);
   assert(m_cell_type.stencil_width() >= 2);
+  m_cell_type_bits.reset(m_cell_type);
 
   // Distance (grid cells) from calving front where strain rate is evaluated
   int offset = m_stencil_width;
@@ -72,9 +72,9 @@ void EigenCalving::update(const array::CellType &cell_type,
   // regime
   const double eigenCalvOffset = 0.0;
 
-  stressbalance::compute_2D_principal_strain_rates(ice_velocity, m_cell_type,
-                                                   m_strain_rates);
-  m_strain_rates.update_ghosts();
+  // Compute strain rates in the marginal band where they are used below (this also
+  // updates ghosts of m_strain_rates).
+  compute_strain_rates(ice_velocity);
 
   array::AccessScope list{&m_cell_type, &m_calving_rate, &m_strain_rates};
 
@@ -84,7 +84,7 @@ void EigenCalving::update(const array::CellType &cell_type,
 
     // Find partially filled or empty grid boxes on the icefree ocean, which
     // have floating ice neighbors after the mass continuity step
-    if (m_cell_type.ice_free_ocean(i, j) and m_cell_type.next_to_floating_ice(i, j)) {
+    if (m_cell_type_bits.ice_free_ocean(i, j) and m_cell_type_bits.next_to_floating_ice(i, j)) {
 
       // Average of strain-rate eigenvalues in adjacent floating grid cells to be used for
       // eigen-calving:
@@ -95,7 +95,9 @@ void EigenCalving::update(const array::CellType &cell_type,
         int N = 0;
         for (int p = -1; p < 2; p += 2) {
           const int I = i + p * offset;
-          if (m_cell_type.floating_ice(I, j) and not m_cell_type.ice_margin(I, j)) {
+          // note: ice_margin() reads the mask one cell beyond `offset`, so it uses
+          // m_cell_type (the packed snapshot does not reach that far)
+          if (m_cell_type_bits.floating_ice(I, j) and not m_cell_type.ice_margin(I, j)) {
             eigen1 += m_strain_rates(I, j).eigen1;
             eigen2 += m_strain_rates(I, j).eigen2;
             N += 1;
@@ -104,7 +106,7 @@ void EigenCalving::update(const array::CellType &cell_type,
 
         for (int q = -1; q < 2; q += 2) {
           const int J = j + q * offset;
-          if (m_cell_type.floating_ice(i, J) and not m_cell_type.ice_margin(i, J)) {
+          if (m_cell_type_bits.floating_ice(i, J) and not m_cell_type.ice_margin(i, J)) {
             eigen1 += m_strain_rates(i, J).eigen1;
             eigen2 += m_strain_rates(i, J).eigen2;
             N += 1;
@@ -19,6 +19,9 @@
 
 #include "pism/frontretreat/calving/StressCalving.hh"
 
+#include "pism/util/Grid.hh"
+#include "pism/util/array/Vector.hh"
+
 namespace pism {
 namespace calving {
 
@@ -53,5 +56,52 @@ const array::Scalar &StressCalving::calving_rate() const {
   return m_calving_rate;
 }
 
+//! Compute 2D principal strain rates in a band of cells along the ice margin.
+/*!
+ * Calving laws derived from this class use strain rates at icy cells a fixed distance
+ * (`m_stencil_width` grid cells, in the x and y directions) away from the calving front.
+ * Values away from this band are never read, so we skip them instead of computing
+ * principal strain rates everywhere; this makes the cost of a calving update proportional
+ * to the length of the front instead of the area of the domain.
+ *
+ * Values of `m_strain_rates` outside the band are left unmodified. Ghosts of
+ * `m_strain_rates` are updated.
+ *
+ * Requires up to date `m_cell_type` (including ghosts) and `m_cell_type_bits`.
+ */
+void StressCalving::compute_strain_rates(const array::Vector1 &ice_velocity) {
+
+  const int r = m_stencil_width;
+
+  const double dx = m_grid->dx(), dy = m_grid->dy();
+
+  array::AccessScope list{ &ice_velocity, &m_cell_type, &m_strain_rates };
+
+  for (auto p : m_grid->points()) {
+    const int i = p.i(), j = p.j();
+
+    if (m_cell_type_bits.ice_free(i, j)) {
+      m_strain_rates(i, j).eigen1 = 0.0;
+      m_strain_rates(i, j).eigen2 = 0.0;
+      continue;
+    }
+
+    // Strain rates at (i, j) are used only if there is a calving front cell `r` cells
+    // away in the x or y direction; checking for ice-free ocean there is a cheap
+    // conservative version of that test.
+    if (not (m_cell_type_bits.ice_free_ocean(i + r, j) or
+             m_cell_type_bits.ice_free_ocean(i - r, j) or
+             m_cell_type_bits.ice_free_ocean(i, j + r) or
+             m_cell_type_bits.ice_free_ocean(i, j - r))) {
+      continue;
+    }
+
+    m_strain_rates(i, j) = stressbalance::principal_strain_rates(
+        ice_velocity.star(i, j), m_cell_type.star_int(i, j), dx, dy);
+  }
+
+  m_strain_rates.update_ghosts();
+}
+
 } // end of namespace calving
 } // end of namespace pism
@@ -39,13 +39,19 @@ public:
   const array::Scalar &calving_rate() const;
 
 protected:
+  void compute_strain_rates(const array::Vector1 &ice_velocity);
+
   const int m_stencil_width;
 
   array::Array2D<stressbalance::PrincipalStrainRates> m_strain_rates;
 
   array::Scalar m_calving_rate;
 
-  array::CellType1 m_cell_type;
+  array::CellType2 m_cell_type;
+
+  // Packed snapshot of m_cell_type used by mask-query-heavy loops; reset after each
+  // m_cell_type update.
+  array::CellTypeBits m_cell_type_bits;
 };
 
 
@@ -32,6 +32,7 @@
 #include "pism/util/Context.hh"
 #include "pism/util/Logger.hh"
 #include "pism/util/io/IO_Flags.hh"
+#include "pism/util/pism_utilities.hh" // pism::printf()
 
 namespace pism {
 namespace calving {
@@ -40,6 +41,7 @@ vonMisesCalving::vonMisesCalving(std::shared_ptr<const Grid> grid,
                                  std::shared_ptr<const rheology::FlowLaw> flow_law)
   : StressCalving(grid, 2),
     m_calving_threshold(m_grid, "vonmises_calving_threshold"),
+    m_hardness(m_grid, "vonmises_hardness"),
     m_flow_law(flow_law)
 {
 
@@ -49,6 +51,10 @@ vonMisesCalving::vonMisesCalving(std::shared_ptr<const Grid> grid,
                                 m_config->get_number("calving.vonmises_calving.Glen_exponent"));
   }
 
+  m_hardness.metadata(0)
+      .long_name("vertically-averaged ice hardness")
+      .set_units_without_validation(pism::printf("Pa s^(1/%f)", m_flow_law->exponent()));
+
   m_calving_rate.metadata().set_name("vonmises_calving_rate");
   m_calving_rate.metadata(0)
       .long_name("horizontal calving rate due to von Mises calving")
@@ -93,6 +99,7 @@ void vonMisesCalving::init() {
   }
 
   m_strain_rates.set(0.0);
+  m_hardness.set(0.0);
 }
 
 //! \brief Uses principal strain rates to apply the "von Mises" calving method
@@ -113,15 +120,56 @@ void vonMisesCalving::update(const array::CellType1 &cell_type,
 
   // make a copy with a wider stencil
   m_cell_type.copy_from(cell_type);
+  m_cell_type_bits.reset(m_cell_type);
 
-  stressbalance::compute_2D_principal_strain_rates(ice_velocity, m_cell_type,
-                                                   m_strain_rates);
-  m_strain_rates.update_ghosts();
+  // Compute strain rates in the marginal band where they are used below (this also
+  // updates ghosts of m_strain_rates).
+  compute_strain_rates(ice_velocity);
 
-  array::AccessScope list{&ice_enthalpy, &ice_thickness, &m_cell_type, &ice_velocity,
-                               &m_strain_rates, &m_calving_rate, &m_calving_threshold};
+  // Compute the vertically-averaged hardness in the same marginal band. This 3D
+  // reduction is expensive, so cached values are re-used as long as the enthalpy field
+  // does not change (hardness varies much more slowly than the geometry; the weak
+  // dependence on the integration depth, i.e. the ice thickness, is ignored while the
+  // cache is warm).
+  {
+    bool enthalpy_changed = m_enthalpy_revisions.changed({ &ice_enthalpy });
+
+    const int r = m_stencil_width;
+
+    array::AccessScope scope{ &ice_enthalpy, &ice_thickness, &m_hardness };
+
+    const double *z = ice_enthalpy.levels().data();
 
-  const double *z = ice_enthalpy.levels().data();
+    for (auto pt : m_grid->points()) {
+      const int i = pt.i(), j = pt.j();
+
+      if (not m_cell_type_bits.icy(i, j)) {
+        // zero marks "not computed": hardness is strictly positive at icy cells
+        m_hardness(i, j) = 0.0;
+        continue;
+      }
+
+      // see StressCalving::compute_strain_rates() for this band test
+      if (not (m_cell_type_bits.ice_free_ocean(i + r, j) or
+               m_cell_type_bits.ice_free_ocean(i - r, j) or
+               m_cell_type_bits.ice_free_ocean(i, j + r) or
+               m_cell_type_bits.ice_free_ocean(i, j - r))) {
+        continue;
+      }
+
+      if (enthalpy_changed or m_hardness(i, j) == 0.0) {
+        double H = ice_thickness(i, j);
+        auto k   = m_grid->kBelowHeight(H);
+
+        m_hardness(i, j) = averaged_hardness(*m_flow_law, H, k, z, ice_enthalpy.get_column(i, j));
+      }
+    }
+
+    m_hardness.update_ghosts();
+  }
+
+  array::AccessScope list{&m_hardness, &ice_velocity,
+                               &m_strain_rates, &m_calving_rate, &m_calving_threshold};
 
   double glen_exponent = m_flow_law->exponent();
 
@@ -130,7 +178,7 @@ void vonMisesCalving::update(const array::CellType1 &cell_type,
 
     // Find partially filled or empty grid boxes on the icefree ocean, which
     // have floating ice neighbors after the mass continuity step
-    if (m_cell_type.ice_free_ocean(i, j) and m_cell_type.next_to_ice(i, j)) {
+    if (m_cell_type_bits.ice_free_ocean(i, j) and m_cell_type_bits.next_to_ice(i, j)) {
 
       double
         velocity_magnitude = 0.0,
@@ -143,13 +191,9 @@ void vonMisesCalving::update(const array::CellType1 &cell_type,
         int N = 0;
         for (int p = -1; p < 2; p += 2) {
           const int I = i + p * offset;
-          if (m_cell_type.icy(I, j)) {
+          if (m_cell_type_bits.icy(I, j)) {
             velocity_magnitude += ice_velocity(I, j).magnitude();
-            {
-              double H = ice_thickness(I, j);
-              auto k = m_grid->kBelowHeight(H);
-              hardness += averaged_hardness(*m_flow_law, H, k, z, ice_enthalpy.get_column(I, j));
-            }
+            hardness += m_hardness(I, j);
             eigen1 += m_strain_rates(I, j).eigen1;
             eigen2 += m_strain_rates(I, j).eigen2;
             N += 1;
@@ -158,13 +202,9 @@ void vonMisesCalving::update(const array::CellType1 &cell_type,
 
         for (int q = -1; q < 2; q += 2) {
           const int J = j + q * offset;
-          if (m_cell_type.icy(i, J)) {
+          if (m_cell_type_bits.icy(i, J)) {
             velocity_magnitude += ice_velocity(i, J).magnitude();
-            {
-              double H = ice_thickness(i, J);
-              auto k = m_grid->kBelowHeight(H);
-              hardness += averaged_hardness(*m_flow_law, H, k, z, ice_enthalpy.get_column(i, J));
-            }
+            hardness += m_hardness(i, J);
             eigen1 += m_strain_rates(i, J).eigen1;
             eigen2 += m_strain_rates(i, J).eigen2;
             N += 1;
@@ -47,9 +47,15 @@ public:
 
 protected:
   DiagnosticList spatial_diagnostics_impl() const;
-  
+
   array::Scalar m_calving_threshold;
 
+  //! vertically-averaged ice hardness in the marginal band (cached; see update())
+  array::Scalar2 m_hardness;
+
+  //! revision of the enthalpy field used to compute m_hardness
+  InputRevisions m_enthalpy_revisions;
+
   std::shared_ptr<const rheology::FlowLaw> m_flow_law;
 };
 
@@ -17,6 +17,8 @@
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <vector>
+
 #include "pism/frontretreat/util/IcebergRemover.hh"
 #include "pism/util/connected_components/label_components.hh"
 #include "pism/util/Mask.hh"
@@ -24,12 +26,20 @@
 #include "pism/util/Grid.hh"
 #include "pism/util/array/CellType.hh"
 #include "pism/util/petscwrappers/Vec.hh"
+#include "pism/util/pism_utilities.hh" // GlobalMax
 
 namespace pism {
 namespace calving {
 
 IcebergRemover::IcebergRemover(std::shared_ptr<const Grid> g)
-    : Component(g), m_iceberg_mask(m_grid, "iceberg_mask") {
+    : Component(g), m_iceberg_mask(m_grid, "iceberg_mask"),
+      m_mask_previous(m_grid, "iceberg_mask_previous") {
+  m_incremental = m_config->get_flag("geometry.iceberg_remover.incremental.enabled");
+  m_full_update_interval =
+      static_cast<int>(m_config->get_number("geometry.iceberg_remover.incremental.full_update_interval"));
+
+  // m_mask_previous is not valid yet, so the first update has to use the full labeling
+  m_updates_since_full_labeling = m_full_update_interval;
 }
 
 /**
@@ -78,7 +88,17 @@ void IcebergRemover::update_impl(const array::Scalar &bc_mask,
     }
   }
 
-  connected_components::label_isolated(m_iceberg_mask, mask_grounded_ice);
+  bool done_incrementally = false;
+  if (m_incremental and m_updates_since_full_labeling < m_full_update_interval) {
+    done_incrementally = update_incremental();
+  }
+
+  if (done_incrementally) {
+    m_updates_since_full_labeling += 1;
+  } else {
+    connected_components::label_isolated(m_iceberg_mask, mask_grounded_ice);
+    m_updates_since_full_labeling = 0;
+  }
 
   // correct ice thickness and the cell type mask using the resulting
   // "iceberg" mask:
@@ -95,11 +115,204 @@ void IcebergRemover::update_impl(const array::Scalar &bc_mask,
     }
   }
 
+  if (m_incremental) {
+    // save cell categories for the next call; note that this happens *after* the
+    // correction above, so removed icebergs are "background" here
+    array::AccessScope list{&cell_type, &bc_mask, &m_mask_previous};
+
+    for (auto p : m_grid->points()) {
+      const int i = p.i(), j = p.j();
+
+      if (cell_type.grounded_ice(i, j) or (bc_mask(i, j) > 0.5 and cell_type.icy(i, j))) {
+        m_mask_previous(i, j) = mask_grounded_ice;
+      } else if (cell_type.floating_ice(i, j)) {
+        m_mask_previous(i, j) = mask_floating_ice;
+      } else {
+        m_mask_previous(i, j) = 0.0;
+      }
+    }
+  }
+
   // update ghosts of the cell_type and the ice thickness (then surface
   // elevation can be updated redundantly)
   cell_type.update_ghosts();
   ice_thickness.update_ghosts();
 }
 
+/*!
+ * Try to find new icebergs by searching locally around cells whose category changed
+ * since the previous update instead of labeling the whole grid.
+ *
+ * On entry `m_iceberg_mask` contains cell categories (`0` background, `1` grounded or
+ * icy Dirichlet, `2` floating) and `m_mask_previous` the categories saved after the
+ * previous update.
+ *
+ * A floating patch that was attached can only become isolated if cells on every path
+ * connecting it to grounded ice lost their ice, or if cells in it un-grounded. In both
+ * cases the patch contains a changed cell or is connected to an icy neighbor of one, so
+ * growing regions from changed cells visits every patch that could have become an
+ * iceberg; all other patches keep their attachment status. Regions stop growing as soon
+ * as they reach grounded ice. A region reaching the edge of the sub-domain cannot be
+ * classified locally; in that case we give up (on all ranks) and the caller falls back
+ * to the full connected-component labeling.
+ *
+ * Returns true on success; `m_iceberg_mask` is then overwritten with `1` in cells
+ * belonging to new icebergs and `0` elsewhere. Returns false if any rank could not
+ * decide; `m_iceberg_mask` is left unchanged in this case.
+ */
+bool IcebergRemover::update_incremental() {
+  const int
+    i_first = m_grid->xs(),
+    i_last  = m_grid->xs() + m_grid->xm() - 1,
+    j_first = m_grid->ys(),
+    j_last  = m_grid->ys() + m_grid->ym() - 1;
+
+  const int xm = m_grid->xm();
+
+  // so that edge regions can look one cell into the neighboring sub-domain:
+  m_iceberg_mask.update_ghosts();
+
+  // Cells scheduled for removal are accumulated in (removal_i, removal_j).
+  std::vector<int> removal_i, removal_j;
+
+  bool failed = false;
+
+  {
+    array::AccessScope list{&m_iceberg_mask, &m_mask_previous};
+
+    auto owned = [&](int i, int j) {
+      return i >= i_first and i <= i_last and j >= j_first and j <= j_last;
+    };
+    auto in_domain = [&](int i, int j) {
+      return i >= 0 and i < (int)m_grid->Mx() and j >= 0 and j < (int)m_grid->My();
+    };
+    auto index = [&](int i, int j) {
+      return (j - j_first) * xm + (i - i_first);
+    };
+
+    std::vector<char> visited(m_grid->xm() * m_grid->ym(), 0);
+    std::vector<int> seeds_i, seeds_j;
+
+    // Find seed cells. Becoming grounded cannot isolate ice, so only three kinds of
+    // changes matter: a cell lost its ice (its icy neighbors may have been cut off),
+    // a cell un-grounded, or floating ice appeared where there was none.
+    for (auto p : m_grid->points()) {
+      const int i = p.i(), j = p.j();
+
+      const int category = m_iceberg_mask.as_int(i, j),
+                previous = m_mask_previous.as_int(i, j);
+
+      if (category == previous) {
+        continue;
+      }
+
+      if (category == 0 and previous > 0) {
+        // ice removed: the patches containing its icy neighbors may be isolated now
+        const int di[4] = {1, -1, 0, 0}, dj[4] = {0, 0, 1, -1};
+        for (int n = 0; n < 4; ++n) {
+          const int ii = i + di[n], jj = j + dj[n];
+          if (not in_domain(ii, jj) or m_iceberg_mask.as_int(ii, jj) == 0) {
+            continue;
+          }
+          if (owned(ii, jj)) {
+            seeds_i.push_back(ii);
+            seeds_j.push_back(jj);
+          } else {
+            // the affected patch may live on a neighboring rank
+            failed = true;
+          }
+        }
+      } else if (category == 2) {
+        // un-grounded or newly-appeared floating ice: its patch may be isolated now
+        seeds_i.push_back(i);
+        seeds_j.push_back(j);
+      }
+    }
+
+    // Grow a region from each seed.
+    std::vector<int> stack_i, stack_j;
+
+    for (size_t s = 0; s < seeds_i.size() and not failed; ++s) {
+      if (m_iceberg_mask.as_int(seeds_i[s], seeds_j[s]) != 2 or
+          visited[index(seeds_i[s], seeds_j[s])] != 0) {
+        // grounded (attached trivially) or already part of a processed region
+        continue;
+      }
+
+      std::vector<int> region_i, region_j;
+      bool attached = false;
+
+      stack_i.clear();
+      stack_j.clear();
+      stack_i.push_back(seeds_i[s]);
+      stack_j.push_back(seeds_j[s]);
+      visited[index(seeds_i[s], seeds_j[s])] = 1;
+
+      while (not stack_i.empty() and not failed) {
+        const int i = stack_i.back(), j = stack_j.back();
+        stack_i.pop_back();
+        stack_j.pop_back();
+
+        region_i.push_back(i);
+        region_j.push_back(j);
+
+        const int di[4] = {1, -1, 0, 0}, dj[4] = {0, 0, 1, -1};
+        for (int n = 0; n < 4; ++n) {
+          const int ii = i + di[n], jj = j + dj[n];
+
+          if (not in_domain(ii, jj)) {
+            continue;
+          }
+
+          const int category = m_iceberg_mask.as_int(ii, jj);
+
+          if (category == 0) {
+            continue;
+          }
+
+          if (not owned(ii, jj)) {
+            if (category == 1) {
+              attached = true;   // grounded ice right across the sub-domain edge
+            } else {
+              failed = true;     // the patch continues on a neighboring rank
+            }
+            continue;
+          }
+
+          if (category == 1) {
+            attached = true;
+          } else if (visited[index(ii, jj)] == 0) {
+            visited[index(ii, jj)] = 1;
+            stack_i.push_back(ii);
+            stack_j.push_back(jj);
+          }
+        }
+      } // end of the loop over the stack
+
+      if (not attached) {
+        removal_i.insert(removal_i.end(), region_i.begin(), region_i.end());
+        removal_j.insert(removal_j.end(), region_j.begin(), region_j.end());
+      }
+    } // end of the loop over seeds
+  }
+
+  // all ranks have to agree to use the incremental result:
+  if (GlobalMax(m_grid->com, failed ? 1 : 0) > 0) {
+    return false;
+  }
+
+  // overwrite categories with the "iceberg" mask (1 in cells to remove, 0 elsewhere),
+  // matching the output of the full labeling:
+  m_iceberg_mask.set(0.0);
+  {
+    array::AccessScope list{&m_iceberg_mask};
+    for (size_t k = 0; k < removal_i.size(); ++k) {
+      m_iceberg_mask(removal_i[k], removal_j[k]) = 1.0;
+    }
+  }
+
+  return true;
+}
+
 } // end of namespace calving
 } // end of namespace pism
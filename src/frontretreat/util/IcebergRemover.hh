@@ -61,6 +61,21 @@ protected:
   // temporary storage: ghosted to use with the connected component labeling code *and*
   // because IcebergRemoverFEM uses ghosts
   array::Scalar1 m_iceberg_mask;
+
+private:
+  bool update_incremental();
+
+  //! cell categories (background, grounded, floating) after the previous update; used
+  //! by the incremental mode to find cells whose type changed
+  array::Scalar m_mask_previous;
+
+  //! if true, try local searches seeded at changed cells before resorting to the full
+  //! connected-component labeling
+  bool m_incremental;
+  //! force a full labeling after this many consecutive incremental updates
+  int m_full_update_interval;
+  //! number of incremental updates since the last full labeling
+  int m_updates_since_full_labeling;
 };
 
 } // end of namespace calving
@@ -90,8 +90,22 @@ void remove_narrow_tongues(const Geometry &geometry,
     //
     // If (i,j) is floating then we will remove it if its neighbors are
     // ice-free, whether ice-free ocean or ice-free ground.
-    auto ice_free =
-        apply(mask.box_int(i, j), mask.grounded_ice(i, j) ? mask::ice_free_ocean : mask::ice_free);
+    auto is_ice_free = mask.grounded_ice(i, j) ? mask::ice_free_ocean : mask::ice_free;
+
+    // The rule below requires at least three ice-free direct neighbors, so cells deeper
+    // in the interior can be rejected by looking at the star stencil only. This keeps
+    // the cost of assembling and testing the full 3x3 neighborhood proportional to the
+    // length of the ice margin instead of the area of the ice cover.
+    {
+      auto star = mask.star_int(i, j);
+
+      if ((int)is_ice_free(star.n) + (int)is_ice_free(star.s) +
+          (int)is_ice_free(star.e) + (int)is_ice_free(star.w) < 3) {
+        continue;
+      }
+    }
+
+    auto ice_free = apply(mask.box_int(i, j), is_ice_free);
 
     if ((not ice_free.w and
          ice_free.nw    and
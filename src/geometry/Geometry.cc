@@ -121,8 +121,14 @@ void Geometry::ensure_consistency(double ice_free_thickness_threshold) {
       &ice_thickness, &ice_area_specific_volume,
       &cell_type, &ice_surface_elevation};
 
-  // first ensure that ice_area_specific_volume is 0 if ice_thickness > 0.
+  // Ensure that ice_area_specific_volume is 0 if ice_thickness > 0, then compute the
+  // cell type and the surface elevation, all in one pass. (Merging
+  // ice_area_specific_volume into ice_thickness only modifies values at the current
+  // point, so the mask and surface elevation can be computed in the same iteration.)
   {
+    GeometryCalculator gc(*config);
+    gc.set_icefree_thickness(ice_free_thickness_threshold);
+
     ParallelSection loop(grid->com);
     try {
       for (auto p : grid->points()) {
@@ -138,22 +144,6 @@ void Geometry::ensure_consistency(double ice_free_thickness_threshold) {
           ice_thickness(i, j) += ice_area_specific_volume(i, j);
           ice_area_specific_volume(i, j) = 0.0;
         }
-      }
-    } catch (...) {
-      loop.failed();
-    }
-    loop.check();
-  }
-
-  // compute cell type and surface elevation
-  {
-    GeometryCalculator gc(*config);
-    gc.set_icefree_thickness(ice_free_thickness_threshold);
-
-    ParallelSection loop(grid->com);
-    try {
-      for (auto p : grid->points()) {
-        const int i = p.i(), j = p.j();
 
         int mask = 0;
         gc.compute(sea_level_elevation(i, j), bed_elevation(i, j), ice_thickness(i, j),
@@ -166,10 +156,9 @@ void Geometry::ensure_consistency(double ice_free_thickness_threshold) {
     loop.check();
   }
 
-  ice_thickness.update_ghosts();
-  ice_area_specific_volume.update_ghosts();
-  cell_type.update_ghosts();
-  ice_surface_elevation.update_ghosts();
+  // one aggregated halo exchange instead of four
+  array::update_ghosts({ &ice_thickness, &ice_area_specific_volume,
+                         &cell_type, &ice_surface_elevation });
 
   const double
     ice_density = config->get_number("constants.ice.density"),
@@ -275,6 +264,11 @@ void ice_bottom_surface(const Geometry &geometry, array::Scalar &result) {
 
 //! Computes the ice volume, in m^3.
 double ice_volume(const Geometry &geometry, double thickness_threshold) {
+  return GlobalSum(geometry.ice_thickness.grid()->com,
+                   ice_volume_local(geometry, thickness_threshold));
+}
+
+double ice_volume_local(const Geometry &geometry, double thickness_threshold) {
   auto grid = geometry.ice_thickness.grid();
   auto config = grid->ctx()->config();
 
@@ -304,7 +298,7 @@ double ice_volume(const Geometry &geometry, double thickness_threshold) {
     }
   }
 
-  return GlobalSum(grid->com, volume);
+  return volume;
 }
 
 double ice_volume_not_displacing_seawater(const Geometry &geometry,
@@ -62,6 +62,9 @@ public:
 void ice_bottom_surface(const Geometry &geometry, array::Scalar &result);
 
 double ice_volume(const Geometry &geometry, double thickness_threshold);
+//! This rank's contribution to ice_volume() (scalar diagnostics sum these in one batched
+//! reduction; see TSDiagnostic::compute_local()).
+double ice_volume_local(const Geometry &geometry, double thickness_threshold);
 double ice_area_floating(const Geometry &geometry, double thickness_threshold);
 double ice_area_grounded(const Geometry &geometry, double thickness_threshold);
 double ice_area(const Geometry &geometry, double thickness_threshold);
@@ -19,6 +19,11 @@
 
 #include "pism/geometry/GeometryEvolution.hh"
 
+#include <algorithm>            // std::sort, std::unique
+#include <cmath>                // std::fabs
+#include <utility>              // std::pair
+#include <vector>
+
 #include "pism/util/Grid.hh"
 #include "pism/util/Mask.hh"
 #include "pism/util/array/CellType.hh"
@@ -57,6 +62,9 @@ struct GeometryEvolution::Impl {
   //! True if the part-grid scheme is enabled.
   bool use_part_grid;
 
+  //! True if the MPDATA corrective pass is enabled (see geometry.advection).
+  bool use_mpdata;
+
   //! Flux divergence (used to track thickness changes due to flow).
   array::Scalar flux_divergence;
 
@@ -76,21 +84,47 @@ struct GeometryEvolution::Impl {
   //! Change in the ice area-specific volume due to flow during the last time step.
   array::Scalar ice_area_specific_volume_change;
 
-  //! Flux through cell interfaces. Ghosted.
+  //! Flux through cell interfaces (after limiting). Ghosted; ghosts are computed by the
+  //! flux limiter (see flow_step()), not communicated.
   array::Staggered1 flux_staggered;
-  //! Temporary storage for the flux limiter.
-  array::Staggered flux_limited;
+  //! Unlimited flux through cell interfaces (input of the flux limiter). Ghosted with
+  //! width 2 so that the limiter can compute limited fluxes in the halo locally.
+  array::Staggered2 flux_unlimited;
 
   // Work space
   array::Vector1 input_velocity;       // a ghosted copy; not modified
   array::Scalar1 bed_elevation;        // a copy; not modified
   array::Scalar1 sea_level;            // a copy; not modified
-  array::Scalar1 ice_thickness;        // updated in place
+  array::Scalar2 ice_thickness;        // updated in place; width 2 (see the flux limiter)
   array::Scalar1 area_specific_volume; // updated in place
   array::Scalar1 surface_elevation;    // updated to maintain consistency
   array::CellType1 cell_type;          // updated to maintain consistency
   array::Scalar1 residual;             // temporary storage
   array::Scalar1 thickness;            // temporary storage
+
+  // Work space of the MPDATA corrective pass (see mpdata_correction())
+  array::Staggered1 interface_velocity;  // advective velocity at cell interfaces
+  array::Scalar1 thickness_provisional;  // ice thickness after the first upwind pass
+
+  //! Cells carrying residual ice volume and cells whose area specific volume (or
+  //! threshold thickness) may have changed: work queues that keep the cost of the
+  //! residual redistribution proportional to the length of the calving front instead of
+  //! the area of the domain.
+  std::vector<std::pair<int, int> > residual_queue;
+  std::vector<std::pair<int, int> > recheck_queue;
+
+  //! @name This rank's contributions to domain totals of reported fields, in meters
+  //! (i.e. not yet multiplied by the cell area).
+  //!
+  //! Accumulated by the sweeps that compute the corresponding fields so that scalar
+  //! mass-accounting diagnostics do not have to traverse the grid again; see
+  //! GeometryEvolution::total_thickness_change_due_to_flow_local() and friends.
+  //! @{
+  double local_flow_change;
+  double local_SMB;
+  double local_BMB;
+  double local_conservation_error;
+  //! @}
 };
 
 GeometryEvolution::Impl::Impl(std::shared_ptr<const Grid> grid)
@@ -102,7 +136,7 @@ GeometryEvolution::Impl::Impl(std::shared_ptr<const Grid> grid)
       thickness_change(grid, "thickness_change"),
       ice_area_specific_volume_change(grid, "ice_area_specific_volume_change"),
       flux_staggered(grid, "flux_staggered"),
-      flux_limited(grid, "flux_limited"),
+      flux_unlimited(grid, "flux_unlimited"),
       input_velocity(grid, "input_velocity"),
       bed_elevation(grid, "bed_elevation"),
       sea_level(grid, "sea_level"),
@@ -111,7 +145,9 @@ GeometryEvolution::Impl::Impl(std::shared_ptr<const Grid> grid)
       surface_elevation(grid, "surface_elevation"),
       cell_type(grid, "cell_type"),
       residual(grid, "residual"),
-      thickness(grid, "thickness") {
+      thickness(grid, "thickness"),
+      interface_velocity(grid, "interface_velocity"),
+      thickness_provisional(grid, "thickness_provisional") {
 
   auto config = grid->ctx()->config();
 
@@ -122,8 +158,14 @@ GeometryEvolution::Impl::Impl(std::shared_ptr<const Grid> grid)
     ice_density   = config->get_number("constants.ice.density");
     use_bmr       = config->get_flag("geometry.update.use_basal_melt_rate");
     use_part_grid = config->get_flag("geometry.part_grid.enabled");
+    use_mpdata    = config->get_string("geometry.advection") == "mpdata2";
   }
 
+  local_flow_change        = 0.0;
+  local_SMB                = 0.0;
+  local_BMB                = 0.0;
+  local_conservation_error = 0.0;
+
   // reported quantities
   {
     // This is the only reported field that is ghosted (we need ghosts to compute flux divergence).
@@ -188,6 +230,17 @@ GeometryEvolution::Impl::Impl(std::shared_ptr<const Grid> grid)
     residual.metadata(0).long_name("residual area specific volume").units("meters^3 / meters^2");
 
     thickness.metadata(0).long_name("thickness (temporary storage)").units("meters");
+
+    interface_velocity.metadata(0)
+        .long_name("advective velocity at cell interfaces (x-offset)")
+        .units("meters / second");
+    interface_velocity.metadata(1)
+        .long_name("advective velocity at cell interfaces (y-offset)")
+        .units("meters / second");
+
+    thickness_provisional.metadata(0)
+        .long_name("ice thickness after the first upwind pass")
+        .units("meters");
   }
 }
 
@@ -210,6 +263,7 @@ void GeometryEvolution::init_impl(const InputOptions &opts) {
 
 void GeometryEvolution::reset() {
   m_impl->conservation_error.set(0.0);
+  m_impl->local_conservation_error = 0.0;
 }
 
 const array::Scalar &GeometryEvolution::flux_divergence() const {
@@ -240,6 +294,23 @@ const array::Scalar &GeometryEvolution::conservation_error() const {
   return m_impl->conservation_error;
 }
 
+double GeometryEvolution::total_thickness_change_due_to_flow_local() const {
+  // m * m^2 = m^3
+  return m_impl->local_flow_change * m_grid->cell_area();
+}
+
+double GeometryEvolution::total_top_surface_mass_balance_local() const {
+  return m_impl->local_SMB * m_grid->cell_area();
+}
+
+double GeometryEvolution::total_bottom_surface_mass_balance_local() const {
+  return m_impl->local_BMB * m_grid->cell_area();
+}
+
+double GeometryEvolution::total_conservation_error_local() const {
+  return m_impl->local_conservation_error * m_grid->cell_area();
+}
+
 /*!
  * @param[in] geometry ice geometry
  * @param[in] dt time step, seconds
@@ -249,12 +320,76 @@ const array::Scalar &GeometryEvolution::conservation_error() const {
  * @param[in] thickness_bc_mask ice thickness Dirichlet B.C. mask
  *
  * Results are stored in internal fields accessible using getters.
+ *
+ * If time_stepping.speculative.enabled is set the time step `dt` may exceed the
+ * conservative diffusivity-based stability bound (see
+ * IceModel::max_timestep_diffusivity()). In this case we attempt the update using the
+ * full step and check a-posteriori stability indicators: if the non-negativity flux
+ * limiter fires at too many locations or the update produces a negative thickness, the
+ * attempt is discarded and the transport problem is re-integrated using shorter
+ * sub-steps (velocities and the diffusive flux are held constant, as they are during
+ * steps skipped by the "-skip" mechanism). Once `sub_steps` reaches
+ * time_stepping.speculative.factor the sub-step length satisfies the conservative bound
+ * and the result is accepted unconditionally, matching the non-speculative code path.
  */
 void GeometryEvolution::flow_step(const Geometry &geometry, double dt,
                                   const array::Vector &advective_velocity,
                                   const array::Staggered &diffusive_flux,
                                   const array::Scalar &thickness_bc_mask) {
 
+  const bool speculative = m_config->get_flag("time_stepping.speculative.enabled");
+  const double factor    = m_config->get_number("time_stepping.speculative.factor");
+
+  unsigned int sub_steps = 1;
+
+  while (true) {
+    // Sub-steps of length dt / factor satisfy the conservative diffusivity bound, so
+    // there is nothing to gain from further subdivision.
+    const bool final_attempt = (not speculative) or (sub_steps >= factor);
+
+    try {
+      if (flow_step_attempt(geometry, dt, sub_steps, not final_attempt,
+                            advective_velocity, diffusive_flux, thickness_bc_mask)) {
+        return;
+      }
+    } catch (RuntimeError &e) {
+      if (final_attempt) {
+        throw;
+      }
+      // a failed speculative attempt (e.g. negative thickness) is not an error: fall
+      // through and retry with shorter sub-steps
+    }
+
+    sub_steps *= 2;
+    m_log->message(2,
+                   "  mass transport: speculative step of %f s looks unstable; "
+                   "retrying with %d sub-steps\n",
+                   dt, sub_steps);
+
+    // Discard the conservation error accumulated by the failed attempt. (The caller
+    // zeroed this field by calling reset() before the step, so re-zeroing it is
+    // correct.)
+    m_impl->conservation_error.set(0.0);
+    m_impl->local_conservation_error = 0.0;
+  }
+}
+
+/*!
+ * Perform one attempt at the transport update, integrating the interval `dt` using
+ * `sub_steps` equal sub-steps. See flow_step() for the retry logic.
+ *
+ * When `check_stability` is set, returns `false` (leaving the model state unmodified) if
+ * the non-negativity flux limiter fires at more than
+ * time_stepping.speculative.limited_cells_fraction of all grid cells during a sub-step;
+ * returns `true` on success.
+ */
+bool GeometryEvolution::flow_step_attempt(const Geometry &geometry, double dt,
+                                          unsigned int sub_steps,
+                                          bool check_stability,
+                                          const array::Vector &advective_velocity,
+                                          const array::Staggered &diffusive_flux,
+                                          const array::Scalar &thickness_bc_mask) {
+
   profiling().begin("ge.update_ghosted_copies");
   {
     // make ghosted copies of input fields
@@ -273,47 +408,83 @@ void GeometryEvolution::flow_step(const Geometry &geometry, double dt,
   }
   profiling().end("ge.update_ghosted_copies");
 
-  // Derived classes can include modifications for regional runs.
-  profiling().begin("ge.interface_fluxes");
-  compute_interface_fluxes(m_impl->cell_type,       // in (uses ghosts)
-                           m_impl->ice_thickness,   // in (uses ghosts)
-                           m_impl->input_velocity,  // in (uses ghosts)
-                           diffusive_flux,          // in
-                           m_impl->flux_staggered); // out
-  profiling().end("ge.interface_fluxes");
+  const double dt_sub = dt / sub_steps;
+
+  // When sub_steps > 1 the loop below re-computes interface fluxes from the updated
+  // working copies, i.e. the transport problem is integrated using a shorter (stable)
+  // time step while the rest of the model takes the long one. Reported fluxes
+  // (flux_staggered(), flux_divergence()) then correspond to the last sub-step, while
+  // thickness and area specific volume changes cover the whole step.
+  for (unsigned int k = 0; k < sub_steps; ++k) {
+
+    if (k > 0) {
+      // the working copies changed during the previous sub-step: refresh their ghosts
+      // and re-compute derived fields
+      m_impl->ice_thickness.update_ghosts();
+      m_impl->area_specific_volume.update_ghosts();
+
+      m_impl->gc.compute(m_impl->sea_level,          // in (uses ghosts)
+                         m_impl->bed_elevation,      // in (uses ghosts)
+                         m_impl->ice_thickness,      // in (uses ghosts)
+                         m_impl->cell_type,          // out (ghosts are updated)
+                         m_impl->surface_elevation); // out (ghosts are updated)
+    }
 
-  m_impl->flux_staggered.update_ghosts();
+    // Derived classes can include modifications for regional runs.
+    profiling().begin("ge.interface_fluxes");
+    compute_interface_fluxes(dt_sub,                  // in
+                             m_impl->cell_type,       // in (uses ghosts)
+                             m_impl->ice_thickness,   // in (uses ghosts)
+                             m_impl->input_velocity,  // in (uses ghosts)
+                             diffusive_flux,          // in
+                             m_impl->flux_unlimited); // out
+    profiling().end("ge.interface_fluxes");
+
+    // This is the only ghost exchange in the flux computation: the limiter below fills
+    // ghosts of flux_staggered by computing limited fluxes in the halo locally, so the flux
+    // divergence can be computed without further communication.
+    m_impl->flux_unlimited.update_ghosts();
+
+    {
+      int limiter_count = make_nonnegative_preserving(dt_sub,
+                                                      m_impl->ice_thickness,   // in (uses ghosts)
+                                                      m_impl->flux_unlimited,  // in (uses ghosts)
+                                                      m_impl->flux_staggered); // out (ghosts are valid)
+      if (limiter_count > 0) {
+        m_log->message(2, "limited ice flux at %d locations\n", limiter_count);
+      }
 
-  {
-    int limiter_count = make_nonnegative_preserving(dt,
-                                                    m_impl->ice_thickness,  // in (uses ghosts)
-                                                    m_impl->flux_staggered, // in (uses ghosts)
-                                                    m_impl->flux_limited);
-    if (limiter_count > 0) {
-      m_log->message(2, "limited ice flux at %d locations\n", limiter_count);
+      if (check_stability) {
+        // Note: limiter_count is a per-rank count, so this decision requires a
+        // reduction. This cost is incurred on speculative attempts only.
+        double total_count = GlobalSum(m_grid->com, (double)limiter_count);
+        double fraction    = m_config->get_number("time_stepping.speculative.limited_cells_fraction");
+
+        if (total_count > fraction * m_grid->Mx() * m_grid->My()) {
+          return false;
+        }
+      }
     }
 
-    m_impl->flux_staggered.copy_from(m_impl->flux_limited);
+    profiling().begin("ge.flux_divergence");
+    compute_flux_divergence(dt_sub,                     // in
+                            m_impl->flux_staggered,     // in (uses ghosts)
+                            thickness_bc_mask,          // in
+                            m_impl->conservation_error, // in/out
+                            m_impl->flux_divergence);   // out
+    profiling().end("ge.flux_divergence");
+
+    // This is where part_grid is implemented.
+    profiling().begin("ge.update_in_place");
+    update_in_place(dt_sub,                        // in
+                    m_impl->bed_elevation,         // in
+                    m_impl->sea_level,             // in
+                    m_impl->flux_divergence,       // in
+                    m_impl->ice_thickness,         // in/out
+                    m_impl->area_specific_volume); // in/out
+    profiling().end("ge.update_in_place");
   }
 
-  profiling().begin("ge.flux_divergence");
-  compute_flux_divergence(dt,                         // in
-                          m_impl->flux_staggered,     // in (uses ghosts)
-                          thickness_bc_mask,          // in
-                          m_impl->conservation_error, // in/out
-                          m_impl->flux_divergence);   // out
-  profiling().end("ge.flux_divergence");
-
-  // This is where part_grid is implemented.
-  profiling().begin("ge.update_in_place");
-  update_in_place(dt,                            // in
-                  m_impl->bed_elevation,         // in
-                  m_impl->sea_level,             // in
-                  m_impl->flux_divergence,       // in
-                  m_impl->ice_thickness,         // in/out
-                  m_impl->area_specific_volume); // in/out
-  profiling().end("ge.update_in_place");
-
   // Compute ice thickness and area specific volume changes.
   profiling().begin("ge.compute_changes");
   {
@@ -344,6 +515,8 @@ void GeometryEvolution::flow_step(const Geometry &geometry, double dt,
   // Href_new = Href_old + ice_area_specific_volume_change.
 
   // calving is a separate issue
+
+  return true;
 }
 
 void GeometryEvolution::source_term_step(const Geometry &geometry, double dt,
@@ -566,25 +739,35 @@ static double limit_diffusive_flux(int current, int neighbor, double flux) {
       PISM_ERROR_LOCATION, "cannot handle the case current=%d, neighbor=%d", current, neighbor);
 }
 
+//! First-order upwind flux through a cell interface.
+static double upwind_flux(double x, double x_n, double u) {
+  return u * (u >= 0.0 ? x : x_n);
+}
+
 /*!
  * Combine advective velocity and the diffusive flux on the staggered grid with the ice thickness to
  * compute the total flux through cell interfaces.
  *
- * Uses first-order upwinding to compute the advective flux.
+ * Uses first-order upwinding to compute the advective flux, optionally followed by one
+ * MPDATA corrective pass (see mpdata_correction() and the geometry.advection
+ * configuration parameter).
  *
  * Limits the diffusive flux to prevent SIA-driven flow in the ocean and ice-free areas.
  */
-void GeometryEvolution::compute_interface_fluxes(const array::CellType1 &cell_type,
+void GeometryEvolution::compute_interface_fluxes(double dt,
+                                                 const array::CellType1 &cell_type,
                                                  const array::Scalar &ice_thickness,
                                                  const array::Vector &velocity,
                                                  const array::Staggered &diffusive_flux,
                                                  array::Staggered &output) {
 
-  array::AccessScope list{ &cell_type, &velocity, &ice_thickness, &diffusive_flux, &output };
+  // compute advective fluxes and put them in output
+  {
+    array::AccessScope list{ &cell_type, &velocity, &ice_thickness, &output };
+    if (m_impl->use_mpdata) {
+      list.add(m_impl->interface_velocity);
+    }
 
-  ParallelSection loop(m_grid->com);
-  try {
-    // compute advective fluxes and put them in output
     for (auto p : m_grid->points()) {
       const int i = p.i(), j = p.j(), M = cell_type.as_int(i, j);
 
@@ -614,33 +797,143 @@ void GeometryEvolution::compute_interface_fluxes(const array::CellType1 &cell_ty
                      Q_advective = v * (v > 0.0 ? H : H_n); // first order upwinding
 
         output(i, j, n) = Q_advective;
+
+        if (m_impl->use_mpdata) {
+          m_impl->interface_velocity(i, j, n) = v;
+        }
       } // end of the loop over neighbors (n)
     }
+  }
 
-    // limit the advective flux and add the diffusive flux to it to get the total
-    for (auto p : m_grid->points()) {
-      const int i = p.i(), j = p.j(), M = cell_type.as_int(i, j);
+  if (m_impl->use_mpdata) {
+    mpdata_correction(dt, ice_thickness, output);
+  }
 
-      for (int n = 0; n < 2; ++n) {
-        const int oi = 1 - n,  // offset in the i direction
-            oj       = n,      // offset in the j direction
-            i_n      = i + oi, // i index of a neighbor
-            j_n      = j + oj; // j index of a neighbor
+  // limit the advective flux and add the diffusive flux to it to get the total
+  {
+    array::AccessScope list{ &cell_type, &diffusive_flux, &output };
 
-        const int M_n = cell_type.as_int(i_n, j_n);
+    ParallelSection loop(m_grid->com);
+    try {
+      for (auto p : m_grid->points()) {
+        const int i = p.i(), j = p.j(), M = cell_type.as_int(i, j);
+
+        for (int n = 0; n < 2; ++n) {
+          const int oi = 1 - n,  // offset in the i direction
+              oj       = n,      // offset in the j direction
+              i_n      = i + oi, // i index of a neighbor
+              j_n      = j + oj; // j index of a neighbor
+
+          const int M_n = cell_type.as_int(i_n, j_n);
 
-        // diffusive flux
-        const double Q_diffusive = limit_diffusive_flux(M, M_n, diffusive_flux(i, j, n)),
-                     Q_advective = limit_advective_flux(M, M_n, output(i, j, n));
+          // diffusive flux
+          const double Q_diffusive = limit_diffusive_flux(M, M_n, diffusive_flux(i, j, n)),
+                       Q_advective = limit_advective_flux(M, M_n, output(i, j, n));
 
-        output(i, j, n) = Q_diffusive + Q_advective;
-      } // end of the loop over n
+          output(i, j, n) = Q_diffusive + Q_advective;
+        } // end of the loop over n
+      }
+    } catch (...) {
+      loop.failed();
     }
+    loop.check();
+  }
+}
 
-  } catch (...) {
-    loop.failed();
+/*!
+ * Add the MPDATA corrective flux to the first-order upwind advective flux computed by
+ * compute_interface_fluxes().
+ *
+ * The first-order upwind flux is stable but diffusive. MPDATA [Smolarkiewicz1983]
+ * interprets the leading error term of the upwind scheme as advection with a
+ * "corrective" velocity and removes most of it by performing a second upwind pass using
+ * this velocity and the provisional (post-first-pass) ice thickness. Performing the
+ * correction in flux form (instead of using MPDATA2::update()) keeps the downstream mass
+ * accounting -- mask-based flux limiting, the non-negativity-preserving limiter, flux
+ * divergence, part-grid -- unchanged.
+ *
+ * Requires `m_impl->interface_velocity` filled by compute_interface_fluxes(). Performs
+ * two ghost exchanges (interface velocities and the provisional thickness).
+ */
+void GeometryEvolution::mpdata_correction(double dt,
+                                          const array::Scalar &ice_thickness,
+                                          array::Staggered &flux) {
+  using std::fabs;
+
+  const double
+    eps = 1e-15,
+    dx  = m_grid->dx(),
+    dy  = m_grid->dy();
+
+  array::Staggered1 &v  = m_impl->interface_velocity;
+  array::Scalar1    &H1 = m_impl->thickness_provisional;
+
+  v.update_ghosts();
+
+  // provisional ice thickness after an upwind step with the first-pass advective flux
+  {
+    array::AccessScope scope{ &v, &ice_thickness, &H1 };
+
+    for (auto p : m_grid->points()) {
+      const int i = p.i(), j = p.j();
+
+      auto u = v.star(i, j);
+
+      const double
+        H   = ice_thickness(i, j),
+        Q_e = upwind_flux(H, ice_thickness(i + 1, j), u.e),
+        Q_w = upwind_flux(ice_thickness(i - 1, j), H, u.w),
+        Q_n = upwind_flux(H, ice_thickness(i, j + 1), u.n),
+        Q_s = upwind_flux(ice_thickness(i, j - 1), H, u.s);
+
+      // Note: the clip below protects the corrective velocity formula (which assumes a
+      // non-negative transported quantity); the actual thickness update is performed
+      // using limited fluxes elsewhere.
+      H1(i, j) = std::max(H - dt * ((Q_e - Q_w) / dx + (Q_n - Q_s) / dy), 0.0);
+    }
+  }
+
+  H1.update_ghosts();
+
+  // compute the corrective velocity (equation (13) in [Smolarkiewicz1983]) and add the
+  // corresponding upwind flux to the first-pass flux
+  {
+    array::AccessScope scope{ &v, &H1, &flux };
+
+    for (auto p : m_grid->points()) {
+      const int i = p.i(), j = p.j();
+
+      auto X = H1.box(i, j);
+
+      // eastern interface
+      {
+        const double
+          u     = v(i, j, 0),
+          v_bar = 0.25 * (v(i + 1, j, 1) + v(i, j, 1) +
+                          v(i, j - 1, 1) + v(i + 1, j - 1, 1));
+
+        const double U = ((fabs(u) * dx - dt * u * u) * (X.e - X.c) / ((X.e + X.c + eps) * dx)
+                          - 0.5 * dt * u * v_bar
+                          * (X.ne - X.se + X.n - X.s) / ((X.ne + X.se + X.n + X.s + eps) * dy));
+
+        flux(i, j, 0) += upwind_flux(X.c, X.e, U);
+      }
+
+      // northern interface
+      {
+        const double
+          w     = v(i, j, 1),
+          u_bar = 0.25 * (v(i, j + 1, 0) + v(i, j, 0) +
+                          v(i - 1, j, 0) + v(i - 1, j + 1, 0));
+
+        const double V = ((fabs(w) * dy - dt * w * w) * (X.n - X.c) / ((X.n + X.c + eps) * dy)
+                          - 0.5 * dt * w * u_bar
+                          * (X.ne - X.nw + X.e - X.w) / ((X.ne + X.nw + X.e + X.w + eps) * dx));
+
+        flux(i, j, 1) += upwind_flux(X.c, X.n, V);
+      }
+    }
   }
-  loop.check();
 }
 
 /*!
@@ -669,6 +962,7 @@ void GeometryEvolution::compute_flux_divergence(double dt, const array::Staggere
         // the thickness change would have been equal to -divQ*dt. By keeping ice
         // thickness fixed we *add* divQ*dt meters of ice.
         conservation_error(i, j) += divQ * dt; // units: meters
+        m_impl->local_conservation_error += divQ * dt;
         output(i, j) = 0.0;
       } else {
         output(i, j) = divQ;
@@ -710,6 +1004,8 @@ void GeometryEvolution::update_in_place(double dt, const array::Scalar &bed_topo
 
   if (m_impl->use_part_grid) {
     m_impl->residual.set(0.0);
+    m_impl->residual_queue.clear();
+    m_impl->recheck_queue.clear();
 
     // Store ice thickness. We need this copy to make sure that modifying ice_thickness in the loop
     // below does not affect the computation of the threshold thickness. (Note that
@@ -750,12 +1046,23 @@ void GeometryEvolution::update_in_place(double dt, const array::Scalar &bed_topo
             ice_thickness(i, j) += threshold;
             m_impl->residual(i, j)     = area_specific_volume(i, j) - threshold;
             area_specific_volume(i, j) = 0.0;
+
+            if (m_impl->residual(i, j) > 0.0) {
+              m_impl->residual_queue.emplace_back(i, j);
+            }
           }
 
           // In this case the flux goes into the area_specific_volume variable and does not directly
           // contribute to ice thickness at this location.
           divQ = 0.0;
         }
+
+        if (area_specific_volume(i, j) > 0.0) {
+          // Partially filled cells need to be re-checked by the first redistribution
+          // iteration: the ice thickness (and so the threshold thickness) changes
+          // everywhere in this loop.
+          m_impl->recheck_queue.emplace_back(i, j);
+        }
       } // end of if (use_part_grid)
 
       ice_thickness(i, j) += -dt * divQ;
@@ -771,7 +1078,10 @@ void GeometryEvolution::update_in_place(double dt, const array::Scalar &bed_topo
   }
   loop.check();
 
-  ice_thickness.update_ghosts();
+  // From this point on only the innermost row of ghosts of the ice thickness is read
+  // (the mask is ghosted with width 1 and the redistribution below works in a one-cell
+  // ring), so exchange a width-1 halo even though the field is allocated with width 2.
+  ice_thickness.update_ghosts(1);
 
   // Compute the mask corresponding to the new thickness.
   m_impl->gc.compute_mask(sea_level, bed_topography, ice_thickness, m_impl->cell_type);
@@ -784,6 +1094,14 @@ void GeometryEvolution::update_in_place(double dt, const array::Scalar &bed_topo
   if (m_impl->use_part_grid) {
     const int max_n_iterations = (int)m_config->get_number("geometry.part_grid.max_iterations");
 
+    // The loop above changed the ice thickness everywhere, so the surface elevation and
+    // the stored copy of the ice thickness are out of date. Bring them up to date once:
+    // the redistribution iterations below maintain them (and the mask) incrementally, at
+    // the cells that change.
+    m_impl->gc.compute_surface(sea_level, bed_topography, ice_thickness,
+                               m_impl->surface_elevation);
+    m_impl->thickness.copy_from(ice_thickness);
+
     bool done = false;
     for (int i = 0; i < max_n_iterations and not done; ++i) {
       m_log->message(4, "redistribution iteration %d\n", i);
@@ -823,6 +1141,14 @@ void GeometryEvolution::update_in_place(double dt, const array::Scalar &bed_topo
   @param[in,out] area_specific_volume area specific volume; updated
   @param[in,out] residual ice volume that still needs to be distributed; updated
   @param[in,out] done result flag: true if this iteration should be the last one
+
+  Residual volume lives in a thin band of cells along the calving front, so this iteration
+  processes work queues (`Impl::residual_queue` and `Impl::recheck_queue`, maintained here
+  and in update_in_place()) instead of scanning the whole grid. The mask, the surface
+  elevation, and the stored copy of the ice thickness are updated point-wise at the cells
+  that change; ghosts of these quantities are re-computed locally in a one-cell-wide ring
+  along the sub-domain boundary (this works because they depend on the ice thickness
+  point-wise).
  */
 void GeometryEvolution::residual_redistribution_iteration(const array::Scalar &bed_topography,
                                                           const array::Scalar &sea_level,
@@ -832,15 +1158,66 @@ void GeometryEvolution::residual_redistribution_iteration(const array::Scalar &b
                                                           array::Scalar &area_specific_volume,
                                                           array::Scalar1 &residual, bool &done) {
 
-  m_impl->gc.compute_mask(sea_level, bed_topography, ice_thickness, cell_type);
+  const int
+    xs = m_grid->xs(), xm = m_grid->xm(),
+    ys = m_grid->ys(), ym = m_grid->ym();
+
+  // Re-compute the mask, the surface elevation, and the copy of the ice thickness in the
+  // ghost ring using ghosts of the ice thickness. These quantities depend on the ice
+  // thickness point-wise, so ghost values can be computed locally, without communication.
+  auto refresh_ghost_ring = [&]() {
+    array::AccessScope scope{ &sea_level, &bed_topography, &ice_thickness, &cell_type,
+                              &ice_surface_elevation, &m_impl->thickness };
+
+    for (auto p : m_grid->points_with_ghosts(1)) {
+      const int i = p.i(), j = p.j();
+
+      if (i >= xs and i < xs + xm and j >= ys and j < ys + ym) {
+        continue;               // owned cells are updated as they change
+      }
+
+      int mask       = 0;
+      double surface = 0.0;
+      m_impl->gc.compute(sea_level(i, j), bed_topography(i, j), ice_thickness(i, j),
+                         &mask, &surface);
+
+      cell_type(i, j)             = mask;
+      ice_surface_elevation(i, j) = surface;
+      m_impl->thickness(i, j)     = ice_thickness(i, j);
+    }
+  };
+
+  // Append owned 4-neighbors of (i, j) to a work queue.
+  auto add_neighbors = [xs, xm, ys, ym](std::vector<std::pair<int, int> > &queue, int i, int j) {
+    const int I[4] = { i, i + 1, i, i - 1 };
+    const int J[4] = { j + 1, j, j - 1, j };
+
+    for (int k = 0; k < 4; ++k) {
+      if (I[k] >= xs and I[k] < xs + xm and J[k] >= ys and J[k] < ys + ym) {
+        queue.emplace_back(I[k], J[k]);
+      }
+    }
+  };
+
+  // The previous iteration may have changed the ice thickness in other sub-domains:
+  refresh_ghost_ring();
+
+  // Cells that may receive redistributed mass during this iteration.
+  std::vector<std::pair<int, int> > receivers;
+  // Cells whose area specific volume or threshold thickness may have changed and so need
+  // to be re-checked. Start with cells recorded during the previous iteration (or by
+  // update_in_place()).
+  std::vector<std::pair<int, int> > recheck;
+  recheck.swap(m_impl->recheck_queue);
 
   // First step: distribute residual mass
   {
     // will be destroyed at the end of the block
-    array::AccessScope list{ &cell_type, &ice_thickness, &area_specific_volume, &residual };
+    array::AccessScope list{ &cell_type, &ice_thickness, &residual, &bed_topography,
+                             &sea_level, &ice_surface_elevation, &m_impl->thickness };
 
-    for (auto p : m_grid->points()) {
-      const int i = p.i(), j = p.j();
+    for (const auto &c : m_impl->residual_queue) {
+      const int i = c.first, j = c.second;
 
       if (residual(i, j) <= 0.0) {
         continue;
@@ -857,53 +1234,101 @@ void GeometryEvolution::residual_redistribution_iteration(const array::Scalar &b
         // Remaining ice mass will be redistributed equally among all adjacent
         // ice-free-ocean cells (is there a more physical way?)
         residual(i, j) /= N;
+
+        add_neighbors(receivers, i, j);
       } else {
         // Conserve mass, but (possibly) create a "ridge" at the shelf
         // front
         ice_thickness(i, j) += residual(i, j);
         residual(i, j) = 0.0;
+
+        // The ice thickness changed here: update dependent quantities and re-check the
+        // neighbors (their threshold thickness may have changed).
+        int mask       = 0;
+        double surface = 0.0;
+        m_impl->gc.compute(sea_level(i, j), bed_topography(i, j), ice_thickness(i, j),
+                           &mask, &surface);
+
+        cell_type(i, j)             = mask;
+        ice_surface_elevation(i, j) = surface;
+        m_impl->thickness(i, j)     = ice_thickness(i, j);
+
+        add_neighbors(recheck, i, j);
       }
     }
+  }
 
-    residual.update_ghosts();
+  residual.update_ghosts();
 
-    // update area_specific_volume using adjusted residuals
-    for (auto p : m_grid->points()) {
-      const int i = p.i(), j = p.j();
+  // Residual mass may arrive from a neighboring sub-domain and remote ice thickness
+  // changes may modify the threshold thickness along the sub-domain boundary: add the
+  // boundary ring to the list of receivers.
+  for (int i = xs; i < xs + xm; ++i) {
+    receivers.emplace_back(i, ys);
+    receivers.emplace_back(i, ys + ym - 1);
+  }
+  for (int j = ys; j < ys + ym; ++j) {
+    receivers.emplace_back(xs, j);
+    receivers.emplace_back(xs + xm - 1, j);
+  }
 
-      auto R = residual.star(i, j);
+  // Remove duplicates so that each cell is updated once.
+  std::sort(receivers.begin(), receivers.end());
+  receivers.erase(std::unique(receivers.begin(), receivers.end()), receivers.end());
+
+  {
+    // will be destroyed at the end of the block
+    array::AccessScope list{ &cell_type, &area_specific_volume, &residual };
+
+    // update area_specific_volume using adjusted residuals
+    for (const auto &c : receivers) {
+      const int i = c.first, j = c.second;
 
       if (cell_type.ice_free_ocean(i, j)) {
+        auto R = residual.star(i, j);
+
         area_specific_volume(i, j) += (R.e + R.w + R.n + R.s);
       }
     }
 
-    residual.set(0.0);
+    // Now all distributed mass is accounted for: clear the queue. (The residual is zero
+    // away from the cells in the queue, so this is equivalent to residual.set(0.0).)
+    for (const auto &c : m_impl->residual_queue) {
+      residual(c.first, c.second) = 0.0;
+    }
+    m_impl->residual_queue.clear();
   }
 
-  ice_thickness.update_ghosts();
-
-  // Store ice thickness. We need this copy to make sure that modifying ice_thickness in the loop
-  // below does not affect the computation of the threshold thickness. (Note that
-  // part_grid_threshold_thickness uses neighboring values of the mask, ice thickness, and surface
-  // elevation.)
-  m_impl->thickness.copy_from(ice_thickness);
-
-  // The loop above updated ice_thickness, so we need to re-calculate the mask and the
-  // surface elevation:
-  m_impl->gc.compute(sea_level, bed_topography, ice_thickness, cell_type, ice_surface_elevation);
+  // "Ridges" built above may have changed the ice thickness near sub-domain boundaries.
+  // Only the one-cell ghost ring is read here (see refresh_ghost_ring()).
+  ice_thickness.update_ghosts(1);
+  refresh_ghost_ring();
 
   double remaining_residual = 0.0;
 
+  // Cells filled during the second step below; dependent quantities at these cells are
+  // updated after the loop so that modifying ice_thickness does not affect the
+  // computation of the threshold thickness. (Note that part_grid_threshold_thickness uses
+  // neighboring values of the mask, ice thickness, and surface elevation.)
+  std::vector<std::pair<int, int> > filled;
+
   // Second step: we need to redistribute residual ice volume if
   // neighbors which gained redistributed ice also become full.
   {
+    // Candidates: cells that may have received mass in this iteration plus cells whose
+    // threshold thickness may have changed.
+    auto &candidates = receivers;
+    candidates.insert(candidates.end(), recheck.begin(), recheck.end());
+
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
     // will be destroyed at the end of the block
     array::AccessScope list{ &m_impl->thickness, &ice_thickness, &ice_surface_elevation,
-                             &bed_topography, &cell_type };
+                             &bed_topography, &cell_type, &area_specific_volume, &residual };
 
-    for (auto p : m_grid->points()) {
-      const int i = p.i(), j = p.j();
+    for (const auto &c : candidates) {
+      const int i = c.first, j = c.second;
 
       if (area_specific_volume(i, j) <= 0.0) {
         continue;
@@ -925,16 +1350,45 @@ void GeometryEvolution::residual_redistribution_iteration(const array::Scalar &b
         area_specific_volume(i, j) = 0.0;
 
         remaining_residual += residual(i, j);
+
+        if (residual(i, j) > 0.0) {
+          m_impl->residual_queue.push_back(c);
+        }
+
+        // The ice thickness changed here: the next iteration has to re-check the
+        // neighbors.
+        filled.push_back(c);
+        add_neighbors(m_impl->recheck_queue, i, j);
       }
     }
   }
 
+  // Update quantities that depend on the ice thickness at the cells filled above.
+  {
+    // will be destroyed at the end of the block
+    array::AccessScope list{ &sea_level, &bed_topography, &ice_thickness, &cell_type,
+                             &ice_surface_elevation, &m_impl->thickness };
+
+    for (const auto &c : filled) {
+      const int i = c.first, j = c.second;
+
+      int mask       = 0;
+      double surface = 0.0;
+      m_impl->gc.compute(sea_level(i, j), bed_topography(i, j), ice_thickness(i, j),
+                         &mask, &surface);
+
+      cell_type(i, j)             = mask;
+      ice_surface_elevation(i, j) = surface;
+      m_impl->thickness(i, j)     = ice_thickness(i, j);
+    }
+  }
+
   // check if redistribution should be run once more
   remaining_residual = GlobalSum(m_grid->com, remaining_residual);
 
   done = remaining_residual <= 0.0;
 
-  ice_thickness.update_ghosts();
+  ice_thickness.update_ghosts(1);
 }
 
 /*!
@@ -960,6 +1414,11 @@ void GeometryEvolution::ensure_nonnegativity(const array::Scalar &ice_thickness,
   array::AccessScope list{ &ice_thickness, &area_specific_volume, &thickness_change,
                            &area_specific_volume_change, &conservation_error };
 
+  // This sweep computes final values of thickness_change and
+  // area_specific_volume_change, so this is where we accumulate their domain total (see
+  // total_thickness_change_due_to_flow_local()).
+  m_impl->local_flow_change = 0.0;
+
   ParallelSection loop(m_grid->com);
   try {
     for (auto p : m_grid->points()) {
@@ -971,6 +1430,7 @@ void GeometryEvolution::ensure_nonnegativity(const array::Scalar &ice_thickness,
       if (H + dH < 0.0) {
         thickness_change(i, j) = -H;
         conservation_error(i, j) += -(H + dH);
+        m_impl->local_conservation_error += -(H + dH);
       }
 
       const double V = area_specific_volume(i, j), dV = area_specific_volume_change(i, j);
@@ -978,7 +1438,10 @@ void GeometryEvolution::ensure_nonnegativity(const array::Scalar &ice_thickness,
       if (V + dV < 0.0) {
         area_specific_volume_change(i, j) = -V;
         conservation_error(i, j) += -(V + dV);
+        m_impl->local_conservation_error += -(V + dV);
       }
+
+      m_impl->local_flow_change += thickness_change(i, j) + area_specific_volume_change(i, j);
     }
   } catch (...) {
     loop.failed();
@@ -1023,6 +1486,12 @@ void GeometryEvolution::compute_surface_and_basal_mass_balance(
   array::AccessScope list{ &ice_thickness,     &surface_mass_flux,      &basal_melt_rate, &cell_type,
                            &thickness_bc_mask, &effective_SMB, &effective_BMB };
 
+  // Accumulate domain totals of the effective mass balances while we compute them (see
+  // total_top_surface_mass_balance_local()). RegionalGeometryEvolution subtracts the
+  // contributions of cells it zeroes out afterwards.
+  m_impl->local_SMB = 0.0;
+  m_impl->local_BMB = 0.0;
+
   ParallelSection loop(m_grid->com);
   try {
     for (auto p : m_grid->points()) {
@@ -1051,6 +1520,9 @@ void GeometryEvolution::compute_surface_and_basal_mass_balance(
 
       effective_SMB(i, j) = dH_SMB;
       effective_BMB(i, j) = dH_BMB;
+
+      m_impl->local_SMB += dH_SMB;
+      m_impl->local_BMB += dH_BMB;
     }
   } catch (...) {
     loop.failed();
@@ -1123,13 +1595,14 @@ void RegionalGeometryEvolution::set_no_model_mask_impl(const array::Scalar &mask
 /*!
  * Disable ice flow in "no model" areas.
  */
-void RegionalGeometryEvolution::compute_interface_fluxes(const array::CellType1 &cell_type,
+void RegionalGeometryEvolution::compute_interface_fluxes(double dt,
+                                                         const array::CellType1 &cell_type,
                                                          const array::Scalar        &ice_thickness,
                                                          const array::Vector        &velocity,
                                                          const array::Staggered     &diffusive_flux,
                                                          array::Staggered           &output) {
 
-  GeometryEvolution::compute_interface_fluxes(cell_type, ice_thickness,
+  GeometryEvolution::compute_interface_fluxes(dt, cell_type, ice_thickness,
                                               velocity, diffusive_flux,
                                               output);
 
@@ -1190,6 +1663,10 @@ void RegionalGeometryEvolution::compute_surface_and_basal_mass_balance(double dt
       const int i = p.i(), j = p.j();
 
       if (m_no_model_mask(i, j) > 0.5) {
+        // keep the accumulated totals consistent with the fields
+        m_impl->local_SMB -= effective_SMB(i, j);
+        m_impl->local_BMB -= effective_BMB(i, j);
+
         effective_SMB(i, j) = 0.0;
         effective_BMB(i, j) = 0.0;
       }
@@ -66,6 +66,18 @@ public:
 
   const array::Scalar& conservation_error() const;
 
+  //! @name This rank's contributions to domain totals of the fields above, in m^3.
+  //!
+  //! Accumulated inside the sweeps that compute the corresponding fields, so scalar
+  //! mass-accounting diagnostics do not need to traverse the grid again; the diagnostics
+  //! sum these contributions in one batched reduction (see TSDiagnostic::compute_local()).
+  //! @{
+  double total_thickness_change_due_to_flow_local() const;
+  double total_top_surface_mass_balance_local() const;
+  double total_bottom_surface_mass_balance_local() const;
+  double total_conservation_error_local() const;
+  //! @}
+
   // diagnostic
   const array::Staggered1& flux_staggered() const;
   const array::Scalar& flux_divergence() const;
@@ -77,6 +89,13 @@ protected:
 
   virtual void init_impl(const InputOptions &opts);
 
+  bool flow_step_attempt(const Geometry &ice_geometry, double dt,
+                         unsigned int sub_steps,
+                         bool check_stability,
+                         const array::Vector    &advective_velocity,
+                         const array::Staggered &diffusive_flux,
+                         const array::Scalar    &thickness_bc_mask);
+
   void update_in_place(double dt,
                        const array::Scalar& bed_topography,
                        const array::Scalar& sea_level,
@@ -93,12 +112,17 @@ protected:
                                          array::Scalar1      &residual,
                                          bool                &done);
 
-  virtual void compute_interface_fluxes(const array::CellType1 &cell_type,
+  virtual void compute_interface_fluxes(double dt,
+                                        const array::CellType1 &cell_type,
                                         const array::Scalar        &ice_thickness,
                                         const array::Vector        &velocity,
                                         const array::Staggered     &diffusive_flux,
                                         array::Staggered           &output);
 
+  void mpdata_correction(double dt,
+                         const array::Scalar &ice_thickness,
+                         array::Staggered &flux);
+
   virtual void compute_flux_divergence(double dt,
                                        const array::Staggered1 &flux,
                                        const array::Scalar &thickness_bc_mask,
@@ -135,7 +159,8 @@ public:
 protected:
   void set_no_model_mask_impl(const array::Scalar &mask);
 
-  void compute_interface_fluxes(const array::CellType1 &cell_type,
+  void compute_interface_fluxes(double dt,
+                                const array::CellType1 &cell_type,
                                 const array::Scalar        &ice_thickness,
                                 const array::Vector        &velocity,
                                 const array::Staggered     &diffusive_flux,
@@ -23,6 +23,8 @@
 #include "pism/geometry/flux_limiter.hh"
 
 #include "pism/util/array/CellType.hh"
+#include "pism/util/error_handling.hh"
+#include "pism/util/pism_utilities.hh" // pism::printf()
 
 /*! References:
  *
@@ -174,10 +176,8 @@ const array::Scalar& UNO::x() const {
 }
 
 UNO::UNO(std::shared_ptr<const Grid> grid, UNOType type)
-  : m_q(grid, "interface_fluxes"),
-    m_q_limited(grid, "limited_interface_fluxes"),
+  : m_q_limited(grid, "limited_interface_fluxes"),
     m_v_ghosted(grid, "velocity"),
-    m_x_ghosted(grid, "old_state"),
     m_x(grid, "new_state")
 {
   switch (type) {
@@ -202,21 +202,29 @@ UNO::UNO(std::shared_ptr<const Grid> grid, UNOType type)
 
 /*!
  * Compute staggered grid (cell interface) fluxes given the domain extent (cell type),
- * regular grid velocities, and the current distribution of the advected quantity.
+ * regular grid velocities, and the current distribution of the advected quantities.
+ *
+ * All tracers in a batch share the velocity field, so interface velocities are computed
+ * once per cell face and applied to the whole batch in one sweep.
  */
 void UNO::compute_interface_fluxes(const array::CellType1 &cell_type,
                                    const array::Vector1 &velocity,
-                                   const array::Scalar2 &x_old,
+                                   const std::vector<std::shared_ptr<array::Scalar2> > &x_old,
                                    double dt,
-                                   array::Staggered &result) const {
+                                   const std::vector<std::shared_ptr<array::Staggered2> > &result) const {
 
   auto grid = cell_type.grid();
 
+  const size_t N = x_old.size();
+
   double
     dx = grid->dx(),
     dy = grid->dy();
 
-  array::AccessScope scope{&cell_type, &velocity, &x_old, &result};
+  array::AccessScope scope{&cell_type, &velocity};
+  for (size_t n = 0; n < N; ++n) {
+    scope.add({x_old[n].get(), result[n].get()});
+  }
 
   // temporary storage for values needed by stencil computations
   double coords[4];
@@ -249,11 +257,18 @@ void UNO::compute_interface_fluxes(const array::CellType1 &cell_type,
       double x0 = i > 0 ? grid->x(i - 1) : grid->x(0) - dx;
       for (int k = 0; k < 4; ++k) {
         coords[k] = x0 + static_cast<double>(k) * dx;
-        values[k] = x_old((i - 1) + k, j);
       }
 
-      // use the 1D "mid-flux" approximation to get the flux
-      result(i, j, 0) = vx * m_approx(coords, values, 1, vx, dx, dt);
+      for (size_t n = 0; n < N; ++n) {
+        const array::Scalar2 &f = *x_old[n];
+
+        for (int k = 0; k < 4; ++k) {
+          values[k] = f((i - 1) + k, j);
+        }
+
+        // use the 1D "mid-flux" approximation to get the flux
+        (*result[n])(i, j, 0) = vx * m_approx(coords, values, 1, vx, dx, dt);
+      }
     }
 
     // north
@@ -263,11 +278,18 @@ void UNO::compute_interface_fluxes(const array::CellType1 &cell_type,
       double y0 = j > 0 ? grid->y(j - 1) : grid->y(0) - dy;
       for (int k = 0; k < 4; ++k) {
         coords[k] = y0 + k * dy;
-        values[k] = x_old(i, (j - 1) + k);
       }
 
-      // use the 1D "mid-flux" approximation to get the flux
-      result(i, j, 1) = vy * m_approx(coords, values, 1, vy, dy, dt);
+      for (size_t n = 0; n < N; ++n) {
+        const array::Scalar2 &f = *x_old[n];
+
+        for (int k = 0; k < 4; ++k) {
+          values[k] = f(i, (j - 1) + k);
+        }
+
+        // use the 1D "mid-flux" approximation to get the flux
+        (*result[n])(i, j, 1) = vy * m_approx(coords, values, 1, vy, dy, dt);
+      }
     }
   } // end of the loop over grid points
 }
@@ -307,22 +329,76 @@ void UNO::update(double dt,
                  const array::Scalar &x,
                  const array::Vector &velocity,
                  bool nonnegative) {
+  update(dt, cell_type, {&x}, velocity, {&m_x}, nonnegative);
+}
+
+/*!
+ * Advect a batch of tracers sharing one velocity field.
+ *
+ * Velocity-dependent quantities (the ghosted copy of `velocity` and interface
+ * velocities) are computed once per batch instead of once per tracer, so advecting N
+ * tracers in one call is cheaper than N single-tracer calls.
+ *
+ * @param[in] dt time step length
+ * @param[in] cell_type cell type mask (defines the domain extent)
+ * @param[in] x current states of advected quantities
+ * @param[in] velocity velocity field shared by all tracers
+ * @param[out] result new states (one per element of `x`)
+ * @param[in] nonnegative if true, limit fluxes to preserve non-negativity
+ */
+void UNO::update(double dt,
+                 const array::CellType1 &cell_type,
+                 const std::vector<const array::Scalar *> &x,
+                 const array::Vector &velocity,
+                 const std::vector<array::Scalar *> &result,
+                 bool nonnegative) {
+
+  if (x.size() != result.size()) {
+    throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                  "the number of inputs (%d) does not match the number of outputs (%d)",
+                                  (int)x.size(), (int)result.size());
+  }
+
+  const size_t N = x.size();
+
+  auto grid = m_x.grid();
+
+  // allocate work space (re-used by subsequent calls)
+  while (m_x_ghosted.size() < N) {
+    auto n = m_x_ghosted.size();
+    m_x_ghosted.push_back(std::make_shared<array::Scalar2>(grid, pism::printf("old_state_%d", (int)n)));
+    m_q.push_back(std::make_shared<array::Staggered2>(grid, pism::printf("interface_fluxes_%d", (int)n)));
+  }
 
   // make ghosted copies:
   m_v_ghosted.copy_from(velocity);
-  m_x_ghosted.copy_from(x);
-
-  compute_interface_fluxes(cell_type, m_v_ghosted, m_x_ghosted, dt, m_q);
+  for (size_t n = 0; n < N; ++n) {
+    m_x_ghosted[n]->copy_from(*x[n]);
+  }
 
-  m_q.update_ghosts();
+  {
+    std::vector<std::shared_ptr<array::Scalar2> > x_old(m_x_ghosted.begin(),
+                                                        m_x_ghosted.begin() + N);
+    std::vector<std::shared_ptr<array::Staggered2> > q(m_q.begin(), m_q.begin() + N);
 
-  // limit fluxes to preserve non-negativity
-  if (nonnegative) {
-    make_nonnegative_preserving(dt, m_x_ghosted, m_q, m_q_limited);
-    m_q.copy_from(m_q_limited);
+    compute_interface_fluxes(cell_type, m_v_ghosted, x_old, dt, q);
   }
 
-  step(dt, m_q, x, m_x);
+  for (size_t n = 0; n < N; ++n) {
+    array::Staggered2 &Q = *m_q[n];
+
+    Q.update_ghosts();
+
+    if (nonnegative) {
+      // limit fluxes to preserve non-negativity; this computes ghosts of m_q_limited, so
+      // no additional communication is needed
+      make_nonnegative_preserving(dt, *m_x_ghosted[n], Q, m_q_limited);
+
+      step(dt, m_q_limited, *x[n], *result[n]);
+    } else {
+      step(dt, Q, *x[n], *result[n]);
+    }
+  }
 }
 
 } // end of namespace pism
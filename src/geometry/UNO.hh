@@ -20,6 +20,9 @@
 #ifndef PISM_UNO_2D_H
 #define PISM_UNO_2D_H
 
+#include <memory>
+#include <vector>
+
 #include "pism/util/array/Scalar.hh"
 #include "pism/util/array/Vector.hh"
 #include "pism/util/array/Staggered.hh"
@@ -54,32 +57,47 @@ public:
               const array::Vector &velocity,
               bool nonnegative = false);
 
+  void update(double dt,
+              const array::CellType1 &cell_type,
+              const std::vector<const array::Scalar *> &x,
+              const array::Vector &velocity,
+              const std::vector<array::Scalar *> &result,
+              bool nonnegative = false);
+
   const array::Scalar& x() const;
 
 private:
   void compute_interface_fluxes(const array::CellType1 &cell_type,
                                 const array::Vector1 &velocity,
-                                const array::Scalar2 &x_old,
+                                const std::vector<std::shared_ptr<array::Scalar2> > &x_old,
                                 double dt,
-                                array::Staggered &result) const;
+                                const std::vector<std::shared_ptr<array::Staggered2> > &result) const;
 
   typedef double (*MidFluxApproximation)(const double *, const double *, size_t, double, double, double);
 
   MidFluxApproximation m_approx;
 
-  // interface fluxes (on the staggered grid; ghosted)
-  array::Staggered1 m_q, m_q_limited;
+  // interface fluxes, one field per tracer (on the staggered grid; ghosted, width=2 as
+  // required by the flux limiter)
+  //
+  // grown on demand to the size of the largest batch processed so far and re-used by
+  // subsequent calls
+  std::vector<std::shared_ptr<array::Staggered2> > m_q;
+
+  // limited interface fluxes (ghosted; shared by all tracers in a batch)
+  array::Staggered1 m_q_limited;
 
   // ghosted copy of the input velocity field used to compute interface velocities
   array::Vector1 m_v_ghosted;
 
-  // temporary storage for the old state of the advected quantity (ghosted, width=2)
+  // temporary storage for the old state of advected quantities, one field per tracer
+  // (ghosted, width=2)
   //
   // used to perform the step using flux divergence *and* to compute interface fluxes
   // (this requires a wide stencil)
-  array::Scalar2 m_x_ghosted;
+  std::vector<std::shared_ptr<array::Scalar2> > m_x_ghosted;
 
-  // resulting advected quantity (not ghosted)
+  // resulting advected quantity of the single-tracer update() (not ghosted)
   array::Scalar m_x;
 };
 
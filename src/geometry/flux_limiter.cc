@@ -24,6 +24,7 @@
 #include <cmath>
 #include <limits>
 
+#include "pism/util/Grid.hh"
 #include "pism/util/array/Scalar.hh"
 #include "pism/util/array/Staggered.hh"
 #include "pism/util/pism_utilities.hh" // GlobalSum()
@@ -195,14 +196,22 @@ std::array<double, 2> flux_limiter(const stencils::Star<double> &Q_c,
 /*! Limit fluxes to preserve non-negativity of a transported quantity.
  *
  * See flux_limiter() for details.
+ *
+ * Iterates over owned grid points *and* one row of ghosts: limited fluxes in the halo are
+ * computed locally (redundantly, from ghosts of `x` and `flux`) instead of being
+ * communicated. This is why `x` and `flux` need two rows of ghosts.
  */
-int make_nonnegative_preserving(double dt, const array::Scalar1 &x, const array::Staggered1 &flux,
-                                array::Staggered &result) {
+int make_nonnegative_preserving(double dt, const array::Scalar2 &x, const array::Staggered2 &flux,
+                                array::Staggered1 &result) {
 
   auto grid = result.grid();
 
   double eps = std::numeric_limits<double>::epsilon(), dx = grid->dx(), dy = grid->dy();
 
+  const int
+    xs = grid->xs(), xm = grid->xm(),
+    ys = grid->ys(), ym = grid->ym();
+
   array::AccessScope list{ &flux, &x, &result };
 
   // flux divergence
@@ -212,9 +221,13 @@ int make_nonnegative_preserving(double dt, const array::Scalar1 &x, const array:
 
   int limiter_count = 0;
 
-  for (auto p : grid->points()) {
+  for (auto p : grid->points_with_ghosts(1)) {
     const int i = p.i(), j = p.j();
 
+    // count owned cells only so that a limited location in the halo of more than one
+    // sub-domain is reported once
+    const bool owned = (i >= xs and i < xs + xm and j >= ys and j < ys + ym);
+
     auto Q   = flux.star(i, j);
     auto Q_n = flux.star(i, j + 1);
     auto Q_e = flux.star(i + 1, j);
@@ -238,7 +251,9 @@ int make_nonnegative_preserving(double dt, const array::Scalar1 &x, const array:
       continue;
     }
 
-    limiter_count += 1;
+    if (owned) {
+      limiter_count += 1;
+    }
 
     auto Q_l = flux_limiter(Q, Q_e, Q_n, x_c, x_e, x_n, dx, dy, dt, eps);
 
@@ -20,9 +20,9 @@
 namespace pism {
 
 namespace array {
-class Scalar1;
-class Staggered;
+class Scalar2;
 class Staggered1;
+class Staggered2;
 } // end of namespace array
 
 /*! Limit fluxes to preserve non-negativity of a transported quantity.
@@ -34,9 +34,15 @@ class Staggered1;
  *
  * Returns the number of grid cells affected by the flux limiter.
  *
- * Does not require communication.
+ * Computes limited fluxes at all owned staggered grid points *and* one row of ghosts, so
+ * ghosts of `result` are valid on return and the caller does not need to communicate
+ * them. This is why `x` and `flux` need two rows of ghosts.
+ *
+ * This function performs no ghost exchanges of its own: it relies on ghosts of `x` and
+ * `flux` exchanged by the caller (one exchange per field per time step). The only
+ * communication here is the reduction used to count cells affected by the limiter.
  */
-int make_nonnegative_preserving(double dt, const array::Scalar1 &x, const array::Staggered1 &flux,
-                                array::Staggered &result);
+int make_nonnegative_preserving(double dt, const array::Scalar2 &x, const array::Staggered2 &flux,
+                                array::Staggered1 &result);
 
 } // end of namespace pism
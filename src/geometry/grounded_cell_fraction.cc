@@ -286,15 +286,31 @@ void compute_grounded_cell_fraction(double ice_density,
         SW----------------S----------------SE
       */
 
-      // compute the floatation function at 8 points surrounding the current grid point
+      // compute the floatation function at the current grid point and its 8 neighbors
+      auto S = sea_level.box(i, j);
+      auto H = ice_thickness.box(i, j);
+      auto B = bed_topography.box(i, j);
+
+      auto x = F(S, B, H, alpha);
+
+      // Cheap classification first: if the floatation function has the same sign at the
+      // current grid point and all 8 of its neighbors, the sub-cell interpolation below
+      // would return exactly 1 (grounded) or 0 (floating). Only cells in a thin band
+      // around the grounding line take the expensive path.
+      if (x.c > 0.0 and x.n > 0.0 and x.nw > 0.0 and x.w > 0.0 and x.sw > 0.0 and
+          x.s > 0.0 and x.se > 0.0 and x.e > 0.0 and x.ne > 0.0) {
+        result(i, j) = 1.0;
+        continue;
+      }
+      if (x.c <= 0.0 and x.n <= 0.0 and x.nw <= 0.0 and x.w <= 0.0 and x.sw <= 0.0 and
+          x.s <= 0.0 and x.se <= 0.0 and x.e <= 0.0 and x.ne <= 0.0) {
+        result(i, j) = 0.0;
+        continue;
+      }
+
+      // interpolate the floatation function to corners and mid-points of cell sides
       stencils::Box<double> f;
       {
-        auto S = sea_level.box(i, j);
-        auto H = ice_thickness.box(i, j);
-        auto B = bed_topography.box(i, j);
-
-        auto x = F(S, B, H, alpha);
-
         f.c = x.c;
         f.sw = 0.25 * (x.sw + x.s + x.c + x.w);
         f.se = 0.25 * (x.s + x.se + x.e + x.c);
@@ -21,6 +21,7 @@
 #include "Routing.hh"
 #include "pism/geometry/Geometry.hh"
 #include "pism/hydrology/Distributed.hh"
+#include "pism/hydrology/ImplicitDiffusion.hh"
 #include "pism/util/array/CellType.hh"
 #include "pism/util/error_handling.hh"
 #include "pism/util/io/File.hh"
@@ -32,7 +33,8 @@ namespace pism {
 namespace hydrology {
 
 Distributed::Distributed(std::shared_ptr<const Grid> g)
-    : Routing(g), m_P(m_grid, "bwp"), m_Pnew(m_grid, "Pnew_internal") {
+    : Routing(g), m_P(m_grid, "bwp"), m_Pnew(m_grid, "Pnew_internal"),
+      m_P_interior_mask(m_grid, "P_interior_mask") {
 
   // additional variables beyond hydrology::Routing
   m_P.metadata(0)
@@ -44,11 +46,23 @@ Distributed::Distributed(std::shared_ptr<const Grid> g)
       .long_name("new transportable subglacial water pressure during update")
       .units("Pa");
   m_Pnew.metadata()["valid_min"] = { 0.0 };
+
+  m_P_interior_mask.metadata(0)
+      .long_name("mask of cells where the water pressure evolves (is not prescribed)");
+
+  m_implicit_pressure = m_config->get_flag("hydrology.distributed.implicit_pressure");
+  if (m_implicit_pressure and not m_diffusion_solver) {
+    m_diffusion_solver.reset(new ImplicitDiffusion(g));
+  }
 }
 
 void Distributed::initialization_message() const {
   m_log->message(2,
                  "* Initializing the distributed, linked-cavities subglacial hydrology model...\n");
+
+  if (m_implicit_pressure) {
+    m_log->message(2, "  ... treating the water pressure diffusion implicitly in time.\n");
+  }
 }
 
 void Distributed::restart_impl(const File &input_file, int record) {
@@ -292,6 +306,119 @@ void Distributed::update_P(double dt,
   } // end of the loop over grid points
 }
 
+//! Linearly-implicit variant of update_P() used if
+//! `hydrology.distributed.implicit_pressure` is set.
+/*!
+  The explicit pressure update is stable only if \f$\Delta t \le 2 \phi_0
+  \Delta t_{diff,W}\f$ (see max_timestep_P_diff()), which for a small regularizing
+  porosity \f$\phi_0\f$ forces time steps much shorter than any other restriction in
+  the model. The stiff mode is the pressure diffusion hidden in the flux divergence:
+  the water velocity is \f$-K \nabla (P + \rho_w g b)\f$, so the flux divergence acts
+  on \f$P\f$ like \f$\nabla \cdot (K W \nabla P)\f$ scaled by \f$\rho_w g \Delta t /
+  \phi_0\f$.
+
+  This method stabilizes the explicit update by adding and subtracting that operator
+  applied implicitly: with \f$\mathcal{L} = (\rho_w g / \phi_0) \nabla \cdot (K W
+  \nabla)\f$ and \f$P^{*}\f$ the explicit candidate computed by update_P(), it solves
+
+  \f[ (I - \Delta t \mathcal{L}) P^{n+1} = P^{*} - \Delta t \mathcal{L} P^{n}. \f]
+
+  Fixed points are unchanged (if \f$P^{n+1} = P^{n}\f$ this reduces to the explicit
+  update), so the scheme is consistent with the same order of accuracy, while the
+  stiff diffusion mode is treated by backward Euler and no longer restricts the time
+  step. Cells where update_P() prescribes the pressure (ice-free, ocean and dry cells)
+  are kept fixed using the solver's Dirichlet mask.
+
+  The projection to \f$0 \le P \le P_o\f$ is re-applied after the solve.
+*/
+void Distributed::update_P_implicit(double dt,
+                                    const array::CellType &cell_type,
+                                    const array::Scalar &sliding_speed,
+                                    const array::Scalar &surface_input_rate,
+                                    const array::Scalar &basal_melt_rate,
+                                    const array::Scalar &P_overburden,
+                                    const array::Scalar &Wtill,
+                                    const array::Scalar &Wtill_new,
+                                    const array::Scalar1 &P,
+                                    const array::Scalar1 &W,
+                                    const array::Staggered1 &Ws,
+                                    const array::Staggered1 &K,
+                                    const array::Staggered1 &Q,
+                                    array::Scalar &P_new) {
+
+  const double phi0 = m_config->get_number("hydrology.regularizing_porosity");
+
+  // the explicit candidate P^{*} (including the prescribed values and the projection)
+  update_P(dt, cell_type, sliding_speed, surface_input_rate, basal_melt_rate,
+           P_overburden, Wtill, Wtill_new, P, W, Ws, K, Q, P_new);
+
+  // the diffusivity (rho_w g / phi0) K W of the pressure diffusion operator, at owned
+  // cells and the west and south edges of the halo (everywhere the matrix assembly
+  // needs it); uses ghosts of K and Ws
+  {
+    array::AccessScope list{&Ws, &K, &m_Dstag};
+
+    const int
+      xs = m_grid->xs(), xm = m_grid->xm(),
+      ys = m_grid->ys(), ym = m_grid->ym();
+
+    for (int j = ys - 1; j < ys + ym; ++j) {
+      for (int i = xs - 1; i < xs + xm; ++i) {
+        for (int o = 0; o < 2; ++o) {
+          m_Dstag(i, j, o) = (m_rg / phi0) * K(i, j, o) * Ws(i, j, o);
+        }
+      }
+    }
+  }
+
+  // the Dirichlet mask and the right hand side P^{*} - dt L P^{n}
+  {
+    const double
+      wux = 1.0 / (m_dx * m_dx),
+      wuy = 1.0 / (m_dy * m_dy);
+
+    array::AccessScope list{&cell_type, &P, &W, &m_Dstag, &m_P_interior_mask, &P_new};
+
+    for (auto p : m_grid->points()) {
+      const int i = p.i(), j = p.j();
+
+      // same condition as in the corresponding branches of update_P()
+      if (cell_type.ice_free_land(i, j) or cell_type.ocean(i, j) or W(i, j) <= 0.0) {
+        m_P_interior_mask(i, j) = 0.0;
+      } else {
+        m_P_interior_mask(i, j) = 1.0;
+
+        const double
+          De = m_Dstag(i, j, 0),
+          Dw = m_Dstag(i - 1, j, 0),
+          Dn = m_Dstag(i, j, 1),
+          Ds = m_Dstag(i, j - 1, 1);
+
+        auto p_s = P.star(i, j);
+        const double LP = (wux * (De * (p_s.e - p_s.c) - Dw * (p_s.c - p_s.w)) +
+                           wuy * (Dn * (p_s.n - p_s.c) - Ds * (p_s.c - p_s.s)));
+
+        P_new(i, j) -= dt * LP;
+      }
+    }
+  }
+
+  m_diffusion_solver->solve(dt, m_Dstag, P_new, &m_P_interior_mask);
+
+  // copy the solution back, re-applying the projection to 0 <= P <= P_o
+  {
+    const array::Scalar &P_solution = m_diffusion_solver->solution();
+
+    array::AccessScope list{&P_solution, &P_overburden, &P_new};
+
+    for (auto p : m_grid->points()) {
+      const int i = p.i(), j = p.j();
+
+      P_new(i, j) = clip(P_solution(i, j), 0.0, P_overburden(i, j));
+    }
+  }
+}
+
 
 //! Update the model state variables W,P by running the subglacial hydrology model.
 /*!
@@ -360,13 +487,15 @@ void Distributed::update_impl(double t, double dt, const Inputs& inputs) {
     {
       const double
         dt_cfl    = max_timestep_W_cfl(),
-        dt_diff_w = max_timestep_W_diff(maxKW),
-        dt_diff_p = max_timestep_P_diff(phi0, dt_diff_w);
+        dt_diff_w = max_timestep_W_diff(maxKW);
 
       hdt = std::min(t_final - ht, dt_max);
       hdt = std::min(hdt, dt_cfl);
       hdt = std::min(hdt, dt_diff_w);
-      hdt = std::min(hdt, dt_diff_p);
+      if (not m_implicit_pressure) {
+        // the linearly-implicit pressure update is not subject to this restriction
+        hdt = std::min(hdt, max_timestep_P_diff(phi0, dt_diff_w));
+      }
     }
 
     m_log->message(3, "  hydrology step %05d, dt = %f s\n", step_counter, hdt);
@@ -388,17 +517,31 @@ void Distributed::update_impl(double t, double dt, const Inputs& inputs) {
                    m_conservation_error_change,
                    m_no_model_mask_change);
 
-    update_P(hdt,
-             inputs.geometry->cell_type,
-             *inputs.ice_sliding_speed,
-             m_surface_input_rate,
-             m_basal_melt_rate,
-             m_Pover,
-             m_Wtill, m_Wtillnew,
-             subglacial_water_pressure(),
-             m_W, m_Wstag,
-             m_Kstag, m_Qstag,
-             m_Pnew);
+    if (m_implicit_pressure) {
+      update_P_implicit(hdt,
+                        inputs.geometry->cell_type,
+                        *inputs.ice_sliding_speed,
+                        m_surface_input_rate,
+                        m_basal_melt_rate,
+                        m_Pover,
+                        m_Wtill, m_Wtillnew,
+                        m_P,
+                        m_W, m_Wstag,
+                        m_Kstag, m_Qstag,
+                        m_Pnew);
+    } else {
+      update_P(hdt,
+               inputs.geometry->cell_type,
+               *inputs.ice_sliding_speed,
+               m_surface_input_rate,
+               m_basal_melt_rate,
+               m_Pover,
+               m_Wtill, m_Wtillnew,
+               subglacial_water_pressure(),
+               m_W, m_Wstag,
+               m_Kstag, m_Qstag,
+               m_Pnew);
+    }
 
     // update Wnew from W, Wtill, Wtillnew, Wstag, Q, input_rate
     update_W(hdt,
@@ -427,8 +570,8 @@ void Distributed::update_impl(double t, double dt, const Inputs& inputs) {
 
   staggered_to_regular(inputs.geometry->cell_type, m_Qstag_average,
                        m_config->get_flag("hydrology.routing.include_floating_ice"),
+                       1.0 / dt, // convert accumulated fluxes into time-averaged ones
                        m_Q);
-  m_Q.scale(1.0 / dt);
 
   m_log->message(2,
                  "  took %d hydrology sub-steps with average dt = %.6f years (%.6f s)\n",
@@ -89,9 +89,30 @@ protected:
                 const array::Staggered1 &K,
                 const array::Staggered1 &Q,
                 array::Scalar &P_new) const;
+
+  void update_P_implicit(double dt,
+                         const array::CellType &cell_type,
+                         const array::Scalar &sliding_speed,
+                         const array::Scalar &surface_input_rate,
+                         const array::Scalar &basal_melt_rate,
+                         const array::Scalar &P_overburden,
+                         const array::Scalar &Wtill,
+                         const array::Scalar &Wtill_new,
+                         const array::Scalar1 &P,
+                         const array::Scalar1 &W,
+                         const array::Staggered1 &Ws,
+                         const array::Staggered1 &K,
+                         const array::Staggered1 &Q,
+                         array::Scalar &P_new);
 protected:
   array::Scalar1 m_P;
   array::Scalar m_Pnew;
+
+  // mask for the implicit pressure update: zero where the pressure is prescribed
+  array::Scalar m_P_interior_mask;
+
+  // true if hydrology.distributed.implicit_pressure is set
+  bool m_implicit_pressure;
 private:
   void initialization_message() const;
 };
@@ -116,6 +116,7 @@ static void effective_water_velocity(const Geometry &geometry,
 EmptyingProblem::EmptyingProblem(std::shared_ptr<const Grid> grid)
   : Component(grid),
     m_potential(grid, "hydraulic_potential"),
+    m_domain_mask_old(grid, "domain_mask_old"),
     m_tmp(grid, "temporary_storage"),
     m_bottom_surface(grid, "ice_bottom_surface"),
     m_W(grid, "remaining_water_thickness"),
@@ -147,6 +148,9 @@ EmptyingProblem::EmptyingProblem(std::shared_ptr<const Grid> grid)
 
   m_domain_mask.metadata(0).long_name("mask defining the domain");
 
+  m_domain_mask_old.metadata(0)
+      .long_name("domain mask at the time of the last hydraulic potential update");
+
   m_Q.metadata(0).long_name("steady state water flux").units("m^2 s^-1");
 
   m_q_sg.metadata(0)
@@ -172,6 +176,26 @@ EmptyingProblem::EmptyingProblem(std::shared_ptr<const Grid> grid)
   m_dx  = m_grid->dx();
   m_dy  = m_grid->dy();
   m_tau = m_config->get_number("hydrology.steady.input_rate_scaling");
+
+  m_reuse_potential    = m_config->get_flag("hydrology.steady.reuse_potential");
+  m_potential_computed = false;
+}
+
+//! Return true if masks `a` and `b` differ at at least one grid point.
+static bool mask_changed(const array::Scalar &a, const array::Scalar &b) {
+  auto grid = a.grid();
+
+  double n = 0.0;
+
+  array::AccessScope list{&a, &b};
+
+  for (auto p : grid->points()) {
+    const int i = p.i(), j = p.j();
+
+    n += static_cast<double>(a(i, j) != b(i, j));
+  }
+
+  return GlobalSum(grid->com, n) > 0.0;
 }
 
 /*!
@@ -201,19 +225,36 @@ void EmptyingProblem::update(const Geometry &geometry,
 
     compute_mask(geometry.cell_type, no_model_mask, m_domain_mask);
 
-    // updates ghosts of m_potential
-    compute_potential(geometry.ice_thickness,
-                      m_bottom_surface,
-                      m_domain_mask,
-                      m_potential);
-
-    // diagnostics
-    {
-      compute_raw_potential(geometry.ice_thickness, m_bottom_surface, m_adjustment);
+    // If hydrology.steady.reuse_potential is set, re-use the potential (and the
+    // velocity derived from it) from the previous call unless the domain mask changed:
+    // the sink-filling iteration in compute_potential() dominates the cost of an
+    // update, while the potential depends on the ice geometry only, which usually
+    // changes little between calls.
+    bool rebuild = ((not m_reuse_potential) or
+                    (not m_potential_computed) or
+                    mask_changed(m_domain_mask, m_domain_mask_old));
+
+    if (rebuild) {
+      // updates ghosts of m_potential
+      compute_potential(geometry.ice_thickness,
+                        m_bottom_surface,
+                        m_domain_mask,
+                        m_potential);
+
+      // diagnostics
+      {
+        compute_raw_potential(geometry.ice_thickness, m_bottom_surface, m_adjustment);
+
+        m_potential.add(-1.0, m_adjustment, m_adjustment);
+
+        diagnostics::compute_sinks(m_domain_mask, m_potential, m_sinks);
+      }
 
-      m_potential.add(-1.0, m_adjustment, m_adjustment);
+      // uses ghosts of m_potential and m_domain_mask, updates ghosts of m_Vstag
+      compute_velocity(m_potential, m_domain_mask, m_Vstag);
 
-      diagnostics::compute_sinks(m_domain_mask, m_potential, m_sinks);
+      m_domain_mask_old.copy_from(m_domain_mask);
+      m_potential_computed = true;
     }
   }
 
@@ -237,9 +278,6 @@ void EmptyingProblem::update(const Geometry &geometry,
   }
   m_W.update_ghosts();
 
-  // uses ghosts of m_potential and m_domain_mask, updates ghosts of m_Vstag
-  compute_velocity(m_potential, m_domain_mask, m_Vstag);
-
   m_Qsum.set(0.0);
 
   // no input means no flux
@@ -307,8 +345,8 @@ void EmptyingProblem::update(const Geometry &geometry,
   m_Qsum.update_ghosts();
   staggered_to_regular(geometry.cell_type, m_Qsum,
                        true,    // include floating ice
+                       1.0 / (m_tau * (1.0 - epsilon)), // fold the scaling into the conversion
                        m_Q);
-  m_Q.scale(1.0 / (m_tau * (1.0 - epsilon)));
 
   diagnostics::effective_water_velocity(geometry, m_Q, m_q_sg);
 }
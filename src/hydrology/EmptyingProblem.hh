@@ -71,6 +71,7 @@ protected:
                     array::Scalar &result) const;
 
   array::Scalar1 m_potential;
+  array::Scalar m_domain_mask_old;
   array::Scalar m_tmp;
   array::Scalar m_bottom_surface;
   array::Scalar1 m_W;
@@ -89,6 +90,11 @@ protected:
   double m_eps_gradient;
   double m_speed;
   double m_tau;
+
+  // true if hydrology.steady.reuse_potential is set
+  bool m_reuse_potential;
+  // true once the potential and the velocity have been computed at least once
+  bool m_potential_computed;
 };
 
 } // end of namespace hydrology
@@ -0,0 +1,260 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "pism/hydrology/ImplicitDiffusion.hh"
+#include "pism/util/error_handling.hh"
+#include "pism/util/Context.hh"
+#include "pism/util/Grid.hh"
+#include "pism/util/petscwrappers/DM.hh"
+#include "pism/util/petscwrappers/Vec.hh"
+
+namespace pism {
+namespace hydrology {
+
+ImplicitDiffusion::ImplicitDiffusion(std::shared_ptr<const Grid> grid)
+  : m_grid(grid),
+    m_log(grid->ctx()->log()),
+    m_x(grid, "implicit_diffusion_x") {
+
+  m_da = m_x.dm();
+
+  // PETSc objects and settings
+  {
+    PetscErrorCode ierr;
+    ierr = DMSetMatType(*m_da, MATAIJ);
+    PISM_CHK(ierr, "DMSetMatType");
+
+    ierr = DMCreateMatrix(*m_da, m_A.rawptr());
+    PISM_CHK(ierr, "DMCreateMatrix");
+
+    ierr = KSPCreate(m_grid->com, m_KSP.rawptr());
+    PISM_CHK(ierr, "KSPCreate");
+
+    ierr = KSPSetOptionsPrefix(m_KSP, "routing_diffusion_");
+    PISM_CHK(ierr, "KSPSetOptionsPrefix");
+
+    // The matrix is symmetric positive definite for any dt > 0 and D >= 0, so the
+    // solution from the previous time step is a good initial guess.
+    ierr = KSPSetInitialGuessNonzero(m_KSP, PETSC_TRUE);
+    PISM_CHK(ierr, "KSPSetInitialGuessNonzero");
+
+    // Process options:
+    ierr = KSPSetFromOptions(m_KSP);
+    PISM_CHK(ierr, "KSPSetFromOptions");
+  }
+}
+
+/*!
+ * Perform one backward Euler step of length `dt` of the diffusion equation with the
+ * edge-centered diffusivity `D`, starting from the water thickness `W`.
+ *
+ * `W` is used as the right hand side and as the initial guess; call solution() to get
+ * the result.
+ *
+ * Uses zero Neumann BC at the edges of the computational domain. Note that the system
+ * matrix is an M-matrix, so the result is non-negative whenever `W` is non-negative.
+ *
+ * Uses ghosts of `D` (west and south only).
+ *
+ * Returns the number of KSP iterations.
+ */
+int ImplicitDiffusion::solve(double dt, const array::Staggered1 &D, const array::Scalar &W) {
+  return solve(dt, D, W, nullptr);
+}
+
+/*!
+ * As above, but with a mask: at locations where `mask` is zero the equation is replaced
+ * by the trivial one, keeping the value of `W` there fixed (Dirichlet BC).
+ */
+int ImplicitDiffusion::solve(double dt, const array::Staggered1 &D, const array::Scalar &W,
+                             const array::Scalar *mask) {
+
+  PetscErrorCode ierr;
+
+  // the diffusivity changes every time step, so the matrix cannot be re-used
+  assemble_matrix(dt, D, mask, m_A);
+
+  ierr = KSPSetOperators(m_KSP, m_A, m_A);
+  PISM_CHK(ierr, "KSPSetOperators");
+
+  // initial guess: the "old" water thickness
+  m_x.copy_from(W);
+
+  // Call PETSc to solve linear system by iterative method.
+  ierr = KSPSolve(m_KSP, W.vec(), m_x.vec());
+  PISM_CHK(ierr, "KSPSolve");
+
+  // Check if diverged
+  KSPConvergedReason reason;
+  ierr = KSPGetConvergedReason(m_KSP, &reason);
+  PISM_CHK(ierr, "KSPGetConvergedReason");
+
+  if (reason < 0) {
+    // KSP diverged
+    m_log->message(1,
+                   "PISM ERROR: KSP iteration failed while performing an implicit\n"
+                   "            diffusion step in the 'routing' hydrology model\n"
+                   "            reason = %d = '%s'\n",
+                   reason, KSPConvergedReasons[reason]);
+
+    throw RuntimeError::formatted(PISM_ERROR_LOCATION, "KSP iteration failed: %s",
+                                  KSPConvergedReasons[reason]);
+  }
+
+  // report on KSP success
+  PetscInt ksp_iterations = 0;
+  ierr = KSPGetIterationNumber(m_KSP, &ksp_iterations);
+  PISM_CHK(ierr, "KSPGetIterationNumber");
+
+  return ksp_iterations;
+}
+
+const array::Scalar& ImplicitDiffusion::solution() const {
+  return m_x;
+}
+
+//! Assemble the matrix of the backward Euler step.
+/*!
+  Discretizing
+
+  \f[ W^{n+1} - \Delta t\, \nabla \cdot (D \nabla W^{n+1}) = W^{n} \f]
+
+  with the standard 5-point stencil gives, for the row corresponding to a cell
+  \f$(i, j)\f$,
+
+  \f[ (1 + C_x (D_e + D_w) + C_y (D_n + D_s)) W_{i,j}
+      - C_x (D_e W_{i+1,j} + D_w W_{i-1,j})
+      - C_y (D_n W_{i,j+1} + D_s W_{i,j-1}), \f]
+
+  where \f$C_x = \Delta t / \Delta x^2\f$, \f$C_y = \Delta t / \Delta y^2\f$ and
+  \f$D_e\f$, etc are diffusivities at the centers of cell edges. Edge diffusivities are
+  set to zero at the edges of the computational domain (zero Neumann BC), matching the
+  treatment in `pism::Poisson`.
+
+  At locations where `mask` is zero (if a mask is provided) the trivial equation is
+  assembled instead (1 on the diagonal, 0 elsewhere), so the right hand side value is
+  kept fixed there.
+*/
+void ImplicitDiffusion::assemble_matrix(double dt, const array::Staggered1 &D,
+                                        const array::Scalar *mask, Mat A) {
+  PetscErrorCode ierr = 0;
+
+  const double
+    dx  = m_grid->dx(),
+    dy  = m_grid->dy(),
+    C_x = dt / (dx * dx),
+    C_y = dt / (dy * dy);
+
+  const int
+    nrow = 1,
+    ncol = 5,
+    Mx   = m_grid->Mx(),
+    My   = m_grid->My();
+
+  ierr = MatZeroEntries(A); PISM_CHK(ierr, "MatZeroEntries");
+
+  array::AccessScope list{&D};
+  if (mask != nullptr) {
+    list.add(*mask);
+  }
+
+  /* matrix assembly loop */
+  ParallelSection loop(m_grid->com);
+  try {
+    MatStencil row, col[ncol];
+    row.c = 0;
+
+    for (int m = 0; m < ncol; m++) {
+      col[m].c = 0;
+    }
+
+    for (auto p : m_grid->points()) {
+      const int i = p.i(), j = p.j();
+
+      /* Order of grid points in the stencil:
+       *
+       *   0
+       * 1 2 3
+       *   4
+       */
+
+      /* i indices */
+      const int I[] = {i, i - 1,  i,  i + 1, i};
+
+      /* j indices */
+      const int J[] = {j + 1, j,  j,  j, j - 1};
+
+      row.i = i;
+      row.j = j;
+
+      for (int m = 0; m < ncol; m++) {
+        col[m].i = I[m];
+        col[m].j = J[m];
+      }
+
+      if (mask != nullptr and mask->as_int(i, j) == 0) {
+        // Dirichlet location: assemble the trivial equation (1 on the diagonal, 0
+        // elsewhere)
+        double T[ncol] = {0.0,
+                          0.0, 1.0, 0.0,
+                          0.0};
+
+        ierr = MatSetValuesStencil(A, nrow, &row, ncol, col, T, INSERT_VALUES);
+        PISM_CHK(ierr, "MatSetValuesStencil");
+
+        continue;
+      }
+
+      double
+        E = D(i, j, 0),
+        W = D(i - 1, j, 0),
+        N = D(i, j, 1),
+        S = D(i, j - 1, 1);
+
+      // Use zero Neumann BC at edges of the computational domain
+      {
+        N = j == My - 1 ? 0.0 : N;
+        E = i == Mx - 1 ? 0.0 : E;
+        W = i == 0      ? 0.0 : W;
+        S = j == 0      ? 0.0 : S;
+      }
+
+      double L[ncol] = {- N * C_y,
+                        - W * C_x, 1.0 + (W + E) * C_x + (N + S) * C_y, - E * C_x,
+                        - S * C_y};
+
+      ierr = MatSetValuesStencil(A, nrow, &row, ncol, col, L, INSERT_VALUES);
+      PISM_CHK(ierr, "MatSetValuesStencil");
+    } // i,j-loop
+  } catch (...) {
+    loop.failed();
+  }
+  loop.check();
+
+  ierr = MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY); PISM_CHK(ierr, "MatAssemblyBegin");
+  ierr = MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY); PISM_CHK(ierr, "MatAssemblyEnd");
+
+#if (Pism_DEBUG==1)
+  ierr = MatSetOption(A, MAT_NEW_NONZERO_LOCATION_ERR, PETSC_TRUE);
+  PISM_CHK(ierr, "MatSetOption");
+#endif
+}
+
+} // end of namespace hydrology
+} // end of namespace pism
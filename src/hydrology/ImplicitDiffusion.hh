@@ -0,0 +1,76 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef IMPLICITDIFFUSION_H
+#define IMPLICITDIFFUSION_H
+
+#include "pism/util/Logger.hh"
+#include "pism/util/array/Scalar.hh"
+#include "pism/util/array/Staggered.hh"
+#include "pism/util/petscwrappers/KSP.hh"
+#include "pism/util/petscwrappers/Mat.hh"
+
+namespace pism {
+
+class Grid;
+
+namespace hydrology {
+
+//! Backward Euler step of the diffusion equation with a variable diffusivity.
+/*!
+  Solves
+
+  \f[ (I - \Delta t\, \nabla \cdot (D \nabla)) W^{n+1} = W^{n} \f]
+
+  for \f$W^{n+1}\f$ given a non-negative diffusivity \f$D\f$ at the centers of cell
+  edges. This is the implicit half of the operator splitting used by hydrology::Routing
+  when `hydrology.routing.implicit_diffusion` is set and by the linearly-implicit
+  pressure update in hydrology::Distributed.
+
+  An optional mask (`1` in the interior, `0` at Dirichlet locations; compare
+  `pism::Poisson`) can be used to keep prescribed values fixed during the solve.
+
+  Modeled on `pism::Poisson` (which is compiled in debug builds only).
+*/
+class ImplicitDiffusion {
+public:
+  ImplicitDiffusion(std::shared_ptr<const Grid> grid);
+
+  int solve(double dt, const array::Staggered1 &D, const array::Scalar &W);
+
+  int solve(double dt, const array::Staggered1 &D, const array::Scalar &W,
+            const array::Scalar *mask);
+
+  const array::Scalar &solution() const;
+private:
+  void assemble_matrix(double dt, const array::Staggered1 &D,
+                       const array::Scalar *mask, Mat A);
+
+  std::shared_ptr<const Grid> m_grid;
+  std::shared_ptr<const Logger> m_log;
+  std::shared_ptr<petsc::DM> m_da;      // dof=1 DA used by the KSP solver
+  petsc::KSP m_KSP;
+  petsc::Mat m_A;
+  array::Scalar m_x;
+};
+
+} // end of namespace hydrology
+} // end of namespace pism
+
+#endif /* IMPLICITDIFFUSION_H */
@@ -20,6 +20,7 @@
 #include <limits>
 
 #include "Hydrology.hh"
+#include "pism/hydrology/ImplicitDiffusion.hh"
 #include "pism/hydrology/Routing.hh"
 #include "pism/util/array/CellType.hh"
 
@@ -254,6 +255,8 @@ Routing::Routing(std::shared_ptr<const Grid> grid)
     m_Vstag(grid, "water_velocity"),
     m_Wstag(grid, "W_staggered"),
     m_Kstag(grid, "K_staggered"),
+    m_Bstag(grid, "K_gradient_factor"),
+    m_Dstag(grid, "D_staggered"),
     m_Wnew(grid, "W_new"),
     m_Wtillnew(grid, "Wtill_new"),
     m_R(grid, "potential_workspace"), /* box stencil used */
@@ -264,6 +267,10 @@ Routing::Routing(std::shared_ptr<const Grid> grid)
   m_rg = (m_config->get_number("constants.fresh_water.density") *
           m_config->get_number("constants.standard_gravity"));
 
+  m_tillwat_max               = m_config->cached_number("hydrology.tillwat_max");
+  m_tillwat_decay_rate        = m_config->cached_number("hydrology.tillwat_decay_rate", "m / second");
+  m_add_surface_input_to_till = m_config->cached_flag("hydrology.add_water_input_to_till_storage");
+
   m_Qstag.metadata(0)
       .long_name("cell face-centered (staggered) components of advective subglacial water flux")
       .units("m^2 s^-1");
@@ -287,6 +294,17 @@ Routing::Routing(std::shared_ptr<const Grid> grid)
       .long_name("cell face-centered (staggered) values of nonlinear conductivity");
   m_Kstag.metadata()["valid_min"] = { 0.0 };
 
+  m_Bstag.metadata(0)
+      .long_name("cell face-centered (staggered) values of the hydraulic potential gradient "
+                 "factor of the nonlinear conductivity");
+  m_Bstag.metadata()["valid_min"] = { 0.0 };
+
+  m_Dstag.metadata(0)
+      .long_name("cell face-centered (staggered) values of the diffusivity of the "
+                 "transportable water layer")
+      .units("m^2 s^-1");
+  m_Dstag.metadata()["valid_min"] = { 0.0 };
+
   m_R.metadata(0)
       .long_name("work space for modeled subglacial water hydraulic potential")
       .units("Pa");
@@ -315,6 +333,11 @@ Routing::Routing(std::shared_ptr<const Grid> grid)
                          "This is not allowed.");
     }
   }
+
+  m_implicit_diffusion = m_config->get_flag("hydrology.routing.implicit_diffusion");
+  if (m_implicit_diffusion) {
+    m_diffusion_solver.reset(new ImplicitDiffusion(grid));
+  }
 }
 
 void Routing::initialization_message() const {
@@ -326,6 +349,10 @@ void Routing::initialization_message() const {
   } else {
     m_log->message(2, "  ... routing subglacial water under grounded ice only.\n");
   }
+
+  if (m_implicit_diffusion) {
+    m_log->message(2, "  ... treating the diffusion of subglacial water implicitly in time.\n");
+  }
 }
 
 void Routing::restart_impl(const File &input_file, int record) {
@@ -687,6 +714,202 @@ void Routing::advective_fluxes(const array::Staggered &V,
   result.update_ghosts();
 }
 
+//! Precompute the \f$|\nabla R|^{\beta-2}\f$ factor of the nonlinear conductivity at the
+//! center of cell edges.
+/*!
+  Here \f$R = P + \rho_w g b\f$ is the simplified hydraulic potential. In this model the
+  water pressure is the overburden pressure, so \f$R\f$ depends on the ice geometry but
+  not on the evolving water amount and this factor can be computed once per update()
+  call instead of once per hydrology sub-step.
+
+  The squared gradient \f$\Pi = |\nabla R|^2\f$ is approximated using the same
+  Mahaffy-like scheme as in compute_conductivity().
+
+  Values are computed at owned cells and at the west and south edges of the halo
+  (locally, using ghosts of `R`, which has to have a stencil width of 2), as required by
+  compute_fluxes().
+
+  Does nothing if \f$\beta = 2\f$: in this case the factor is identically 1 and is not
+  used.
+*/
+void Routing::compute_conductivity_factor(const array::Scalar2 &R,
+                                          array::Staggered1 &result) const {
+  const double
+    beta    = m_config->get_number("hydrology.gradient_power_in_flux"),
+    betapow = (beta - 2.0) / 2.0;
+
+  if (beta == 2.0) {
+    return;
+  }
+
+  // We regularize negative power |\grad psi|^{beta-2} by adding eps because large
+  // head gradient might be 10^7 Pa per 10^4 m or 10^3 Pa/m.
+  const double eps = beta < 2.0 ? 1.0 : 0.0;
+
+  array::AccessScope list{ &R, &result };
+
+  const int
+    xs = m_grid->xs(), xm = m_grid->xm(),
+    ys = m_grid->ys(), ym = m_grid->ym();
+
+  for (int j = ys - 1; j < ys + ym; ++j) {
+    for (int i = xs - 1; i < xs + xm; ++i) {
+      double dRdx, dRdy;
+
+      dRdx = (R(i + 1, j) - R(i, j)) / m_dx;
+      dRdy = (R(i + 1, j + 1) + R(i, j + 1) - R(i + 1, j - 1) - R(i, j - 1)) / (4.0 * m_dy);
+      result(i, j, 0) = pow(dRdx * dRdx + dRdy * dRdy + eps * eps, betapow);
+
+      dRdx = (R(i + 1, j + 1) + R(i + 1, j) - R(i - 1, j + 1) - R(i - 1, j)) / (4.0 * m_dx);
+      dRdy = (R(i, j + 1) - R(i, j)) / m_dy;
+      result(i, j, 1) = pow(dRdx * dRdx + dRdy * dRdy + eps * eps, betapow);
+    }
+  }
+}
+
+//! Compute all staggered-grid quantities needed by one hydrology sub-step in a single
+//! fused sweep.
+/*!
+  Computes the staggered water thickness, the nonlinear conductivity \f$K\f$, the water
+  velocity \f$\mathbf{V}\f$ and the upwinded advective flux \f$\mathbf{Q}\f$ -- see
+  water_thickness_staggered(), compute_conductivity(), compute_velocity() and
+  advective_fluxes() for the individual computations -- storing results in `m_Wstag`,
+  `m_Kstag`, `m_Vstag` and `m_Qstag` and returning the maximum of \f$K W\f$ over cell
+  interfaces.
+
+  The sweep covers owned cells plus the west and south edges of the halo: staggered
+  values stored there are the only ghost values read by W_change_due_to_flow(), and they
+  can be computed locally from ghosts of the inputs, so no ghost exchange of staggered
+  quantities is needed. (`m_Vstag` has no ghosts, so halo values of the velocity are
+  used to compute the flux but not stored.) Together with the once-per-update
+  computation of `m_R` and `m_Bstag` this reduces a sub-step from four sweeps and three
+  ghost exchanges to one sweep and one ghost exchange (the one updating ghosts of the
+  water thickness; see update_impl()).
+
+  Note that \f$\nabla P + \rho_w g \nabla b = \nabla R\f$, so the velocity is computed
+  from the gradient of the precomputed \f$R\f$.
+
+  The maximum of \f$K W\f$ and the maxima of the two water speed components (needed by
+  the diffusion and CFL time step restrictions) are folded into one packed reduction,
+  so a sub-step performs a single collective here.
+
+  Uses ghosts of `cell_type`, `W`, `m_R` and `no_model_mask` (width 1).
+*/
+void Routing::compute_fluxes(const array::CellType1 &cell_type,
+                             const array::Scalar1 &W,
+                             const array::Scalar1 *no_model_mask,
+                             double &KW_max,
+                             double &speed_x_max,
+                             double &speed_y_max) {
+  const double
+    k     = m_config->get_number("hydrology.hydraulic_conductivity"),
+    alpha = m_config->get_number("hydrology.thickness_power_in_flux"),
+    beta  = m_config->get_number("hydrology.gradient_power_in_flux");
+
+  const bool
+    include_floating    = m_config->get_flag("hydrology.routing.include_floating_ice"),
+    use_gradient_factor = beta != 2.0;
+
+  array::AccessScope list{ &cell_type, &W, &m_R, &m_Bstag,
+                           &m_Wstag, &m_Kstag, &m_Vstag, &m_Qstag };
+  if (no_model_mask != nullptr) {
+    list.add(*no_model_mask);
+  }
+
+  // local maxima of K W and of the two water speed components
+  double maxima[3] = {0.0, 0.0, 0.0};
+
+  // conductivity at an interface with no water on either side (zero for alpha > 1);
+  // pre-computed so that the loop below can skip the pow() call on dry interfaces
+  const double K_dry = k * pow(0.0, alpha - 1.0);
+
+  const int
+    xs = m_grid->xs(), xm = m_grid->xm(),
+    ys = m_grid->ys(), ym = m_grid->ym();
+
+  for (int j = ys - 1; j < ys + ym; ++j) {
+    for (int i = xs - 1; i < xs + xm; ++i) {
+
+      for (int o = 0; o < 2; ++o) {
+        const int
+          i_n = i + (1 - o),      // i index of the neighbor across this interface
+          j_n = j + o;            // j index of the neighbor across this interface
+
+        if (W(i, j) == 0.0 and W(i_n, j_n) == 0.0) {
+          // Dry interface: every masking case below gives W_s == 0, so the velocity and
+          // the flux vanish and the conductivity takes its W == 0 value. The maxima are
+          // unaffected (K W_s == 0, |V| == 0). In a continent-scale run most of the
+          // domain is dry most of the time, so this skips the bulk of the pow() calls.
+          double K = K_dry;
+          if (use_gradient_factor) {
+            K *= m_Bstag(i, j, o);
+          }
+
+          m_Wstag(i, j, o) = 0.0;
+          m_Kstag(i, j, o) = K;
+          m_Qstag(i, j, o) = 0.0;
+          if (i >= xs and j >= ys) {
+            m_Vstag(i, j, o) = 0.0;
+          }
+          continue;
+        }
+
+        // water thickness at the interface
+        double W_s = 0.0;
+        {
+          const bool
+            icy_c = include_floating ? cell_type.icy(i, j) : cell_type.grounded_ice(i, j),
+            icy_n = include_floating ? cell_type.icy(i_n, j_n) : cell_type.grounded_ice(i_n, j_n);
+
+          if (icy_c) {
+            W_s = icy_n ? 0.5 * (W(i, j) + W(i_n, j_n)) : W(i, j);
+          } else {
+            W_s = icy_n ? W(i_n, j_n) : 0.0;
+          }
+        }
+
+        // nonlinear conductivity
+        double K = k * pow(W_s, alpha - 1.0);
+        if (use_gradient_factor) {
+          K *= m_Bstag(i, j, o);
+        }
+
+        // water velocity
+        double V = 0.0;
+        if (W_s > 0.0) {
+          V = -K * (m_R(i_n, j_n) - m_R(i, j)) / (o == 0 ? m_dx : m_dy);
+        }
+        if (no_model_mask != nullptr and
+            ((*no_model_mask)(i, j) != 0.0 or (*no_model_mask)(i_n, j_n) != 0.0)) {
+          V = 0.0;
+        }
+
+        // upwinded advective flux
+        const double Q = V * (V >= 0.0 ? W(i, j) : W(i_n, j_n));
+
+        m_Wstag(i, j, o) = W_s;
+        m_Kstag(i, j, o) = K;
+        m_Qstag(i, j, o) = Q;
+        if (i >= xs and j >= ys) {
+          // m_Vstag has no ghosts; owned faces also define the speed maxima (halo
+          // faces are owned by a neighboring rank)
+          m_Vstag(i, j, o) = V;
+          maxima[1 + o] = std::max(maxima[1 + o], std::fabs(V));
+        }
+
+        maxima[0] = std::max(maxima[0], K * W_s);
+      }
+    }
+  }
+
+  double global_maxima[3];
+  GlobalMax(m_grid->com, maxima, global_maxima, 3);
+
+  KW_max      = global_maxima[0];
+  speed_x_max = global_maxima[1];
+  speed_y_max = global_maxima[2];
+}
+
 /*!
  * See equation (51) in Bueler and van Pelt.
  */
@@ -706,11 +929,19 @@ double Routing::max_timestep_W_cfl() const {
   // V could be zero if P is constant and bed is flat
   auto tmp = absmax(m_Vstag);
 
+  return max_timestep_W_cfl(tmp[0], tmp[1]);
+}
+
+/*!
+ * As above, given already-reduced maxima of the water speed components (e.g. the ones
+ * computed by compute_fluxes()), avoiding a second collective reduction.
+ */
+double Routing::max_timestep_W_cfl(double speed_x_max, double speed_y_max) const {
   // add a safety margin
   double alpha = 0.95;
   double eps = 1e-6;
 
-  return alpha * 0.5 / (tmp[0]/m_dx + tmp[1]/m_dy + eps);
+  return alpha * 0.5 / (speed_x_max / m_dx + speed_y_max / m_dy + eps);
 }
 
 
@@ -739,12 +970,12 @@ void Routing::update_Wtill(double dt,
                            const array::Scalar &basal_melt_rate,
                            array::Scalar &Wtill_new) {
   const double
-    tillwat_max = m_config->get_number("hydrology.tillwat_max"),
-    C           = m_config->get_number("hydrology.tillwat_decay_rate", "m / second");
+    tillwat_max = m_tillwat_max,
+    C           = m_tillwat_decay_rate;
 
   array::AccessScope list{&Wtill, &Wtill_new, &basal_melt_rate};
 
-  bool add_surface_input = m_config->get_flag("hydrology.add_water_input_to_till_storage");
+  bool add_surface_input = m_add_surface_input_to_till;
   if (add_surface_input) {
     list.add(surface_input_rate);
   }
@@ -829,6 +1060,102 @@ void Routing::update_W(double dt,
   m_input_change.add(dt, basal_melt_rate);
 }
 
+//! The computation of Wnew with the implicit (backward Euler) treatment of diffusion.
+/*!
+  Operator-split alternative to update_W() used if `hydrology.routing.implicit_diffusion`
+  is set: the advective part of the flux, the water input and the till water exchange are
+  applied explicitly (as in update_W()), then the diffusive part of the flux is applied
+  by performing one backward Euler step
+
+  \f[ (I - \Delta t\, \nabla \cdot (D \nabla)) W^{n+1} = W^{*} \f]
+
+  with the diffusivity \f$D = \rho_w g K W\f$ frozen at the beginning of the step. This
+  removes the diffusion restriction (51) in [\ref BuelervanPelt2015] on the length of
+  hydrology time steps, which are then limited by the advection CFL condition (50) only.
+
+  The system matrix is an M-matrix, so the implicit step preserves non-negativity of
+  \f$W^{*}\f$.
+*/
+void Routing::update_W_implicit(double dt,
+                                const array::Scalar     &surface_input_rate,
+                                const array::Scalar     &basal_melt_rate,
+                                const array::Scalar1    &W,
+                                const array::Staggered1 &Wstag,
+                                const array::Scalar     &Wtill,
+                                const array::Scalar     &Wtill_new,
+                                const array::Staggered1 &K,
+                                const array::Staggered1 &Q,
+                                array::Scalar           &W_new) {
+
+  // explicit advective change (the diffusive part is handled by the implicit step below)
+  {
+    array::AccessScope list{&Q, &m_flow_change_incremental};
+
+    for (auto p : m_grid->points()) {
+      const int i = p.i(), j = p.j();
+
+      auto q = Q.star(i, j);
+      const double divQ = (q.e - q.w) / m_dx + (q.n - q.s) / m_dy;
+
+      m_flow_change_incremental(i, j) = dt * (- divQ);
+    }
+  }
+
+  // W^{*}: apply the advective change, the input rate and the till water exchange
+  {
+    array::AccessScope list{&W, &Wtill, &Wtill_new, &surface_input_rate,
+                            &basal_melt_rate, &m_flow_change_incremental, &W_new};
+
+    for (auto p : m_grid->points()) {
+      const int i = p.i(), j = p.j();
+
+      double input_rate = surface_input_rate(i, j) + basal_melt_rate(i, j);
+
+      double Wtill_change = Wtill_new(i, j) - Wtill(i, j);
+      W_new(i, j) = (W(i, j) + (dt * input_rate - Wtill_change) + m_flow_change_incremental(i, j));
+    }
+  }
+
+  // the diffusivity, frozen at the beginning of the step (at owned cells and the west
+  // and south edges of the halo, i.e. everywhere the matrix assembly needs it)
+  {
+    array::AccessScope list{&Wstag, &K, &m_Dstag};
+
+    const int
+      xs = m_grid->xs(), xm = m_grid->xm(),
+      ys = m_grid->ys(), ym = m_grid->ym();
+
+    for (int j = ys - 1; j < ys + ym; ++j) {
+      for (int i = xs - 1; i < xs + xm; ++i) {
+        for (int o = 0; o < 2; ++o) {
+          m_Dstag(i, j, o) = m_rg * K(i, j, o) * Wstag(i, j, o);
+        }
+      }
+    }
+  }
+
+  int iterations = m_diffusion_solver->solve(dt, m_Dstag, W_new);
+  m_log->message(4, "  implicit diffusion step: %d KSP iterations\n", iterations);
+
+  // apply the implicit diffusive change and add it to the flow accounting
+  {
+    const array::Scalar &W_solution = m_diffusion_solver->solution();
+
+    array::AccessScope list{&W_solution, &m_flow_change_incremental, &W_new};
+
+    for (auto p : m_grid->points()) {
+      const int i = p.i(), j = p.j();
+
+      m_flow_change_incremental(i, j) += W_solution(i, j) - W_new(i, j);
+      W_new(i, j) = W_solution(i, j);
+    }
+  }
+
+  m_flow_change.add(1.0, m_flow_change_incremental);
+  m_input_change.add(dt, surface_input_rate);
+  m_input_change.add(dt, basal_melt_rate);
+}
+
 //! Update the model state variables W and Wtill by applying the subglacial hydrology model equations.
 /*!
   Runs the hydrology model from time t to time t + dt.  Here [t, dt]
@@ -856,6 +1183,13 @@ void Routing::update_impl(double t, double dt, const Inputs& inputs) {
   // make sure W has valid ghosts before starting hydrology steps
   m_W.update_ghosts();
 
+  // In this model the water pressure is the overburden pressure, so the simplified
+  // hydraulic potential R = P + rho_w g b and the |grad R|^{beta-2} factor of the
+  // conductivity depend on the ice geometry only and can be computed once per update
+  // instead of once per sub-step.
+  subglacial_water_pressure().add(m_rg, m_bottom_surface, m_R); // yes, it updates ghosts
+  compute_conductivity_factor(m_R, m_Bstag);
+
   unsigned int step_counter = 0;
   for (; ht < t_final; ht += hdt) {
     step_counter++;
@@ -866,46 +1200,27 @@ void Routing::update_impl(double t, double dt, const Inputs& inputs) {
     check_bounds(m_Wtill, tillwat_max);
 #endif
 
-    // updates ghosts of m_Wstag
-    water_thickness_staggered(m_W,
-                              inputs.geometry->cell_type,
-                              m_Wstag);
-
-    double maxKW = 0.0;
-    // updates ghosts of m_Kstag
-    profiling().begin("routing_conductivity");
-    compute_conductivity(m_Wstag,
-                         subglacial_water_pressure(),
-                         m_bottom_surface,
-                         m_Kstag, maxKW);
-    profiling().end("routing_conductivity");
-
-    // ghosts of m_Vstag are not updated
-    profiling().begin("routing_velocity");
-    compute_velocity(m_Wstag,
-                     subglacial_water_pressure(),
-                     m_bottom_surface,
-                     m_Kstag,
-                     inputs.no_model_mask,
-                     m_Vstag);
-    profiling().end("routing_velocity");
-
-    // to get Q, W needs valid ghosts (ghosts of m_Vstag are not used)
-    // updates ghosts of m_Qstag
-    profiling().begin("routing_flux");
-    advective_fluxes(m_Vstag, m_W, m_Qstag);
-    profiling().end("routing_flux");
+    // computes m_Wstag, m_Kstag, m_Vstag and m_Qstag in one sweep; fills ghosts of the
+    // staggered quantities locally, so no ghost exchanges are needed here (uses ghosts
+    // of m_W)
+    double maxKW = 0.0, max_speed_x = 0.0, max_speed_y = 0.0;
+    profiling().begin("routing_fluxes");
+    compute_fluxes(inputs.geometry->cell_type,
+                   m_W,
+                   inputs.no_model_mask,
+                   maxKW, max_speed_x, max_speed_y);
+    profiling().end("routing_fluxes");
 
     m_Qstag_average.add(hdt, m_Qstag);
 
     {
-      const double
-        dt_cfl    = max_timestep_W_cfl(),
-        dt_diff_w = max_timestep_W_diff(maxKW);
-
       hdt = std::min(t_final - ht, dt_max);
-      hdt = std::min(hdt, dt_cfl);
-      hdt = std::min(hdt, dt_diff_w);
+      hdt = std::min(hdt, max_timestep_W_cfl(max_speed_x, max_speed_y));
+      if (not m_implicit_diffusion) {
+        // the backward Euler treatment of diffusion is unconditionally stable, so the
+        // diffusion restriction applies to the explicit scheme only
+        hdt = std::min(hdt, max_timestep_W_diff(maxKW));
+      }
     }
 
     m_log->message(3, "  hydrology step %05d, dt = %f s\n", step_counter, hdt);
@@ -935,13 +1250,23 @@ void Routing::update_impl(double t, double dt, const Inputs& inputs) {
     // uses ghosts of m_W, m_Wstag, m_Qstag, m_Kstag
     {
       profiling().begin("routing_W");
-      update_W(hdt,
-               m_surface_input_rate,
-               m_basal_melt_rate,
-               m_W, m_Wstag,
-               m_Wtill, m_Wtillnew,
-               m_Kstag, m_Qstag,
-               m_Wnew);
+      if (m_implicit_diffusion) {
+        update_W_implicit(hdt,
+                          m_surface_input_rate,
+                          m_basal_melt_rate,
+                          m_W, m_Wstag,
+                          m_Wtill, m_Wtillnew,
+                          m_Kstag, m_Qstag,
+                          m_Wnew);
+      } else {
+        update_W(hdt,
+                 m_surface_input_rate,
+                 m_basal_melt_rate,
+                 m_W, m_Wstag,
+                 m_Wtill, m_Wtillnew,
+                 m_Kstag, m_Qstag,
+                 m_Wnew);
+      }
       // remove water in ice-free areas and account for changes
       enforce_bounds(inputs.geometry->cell_type,
                      inputs.no_model_mask,
@@ -964,8 +1289,8 @@ void Routing::update_impl(double t, double dt, const Inputs& inputs) {
 
   staggered_to_regular(inputs.geometry->cell_type, m_Qstag_average,
                        m_config->get_flag("hydrology.routing.include_floating_ice"),
+                       1.0 / dt, // convert accumulated fluxes into time-averaged ones
                        m_Q);
-  m_Q.scale(1.0 / dt);
 
   m_log->message(2,
                  "  took %d hydrology sub-steps with average dt = %.6f years (%.3f s or %.3f hours)\n",
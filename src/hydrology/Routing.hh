@@ -20,12 +20,15 @@
 #define _ROUTING_H_
 
 #include "pism/hydrology/Hydrology.hh"
+#include "pism/util/Config.hh"
 #include "pism/util/array/Staggered.hh"
 
 namespace pism {
 
 namespace hydrology {
 
+class ImplicitDiffusion;
+
 //! \brief A subglacial hydrology model which assumes water pressure
 //! equals overburden pressure.
 /*!
@@ -107,6 +110,7 @@ protected:
 
   double max_timestep_W_diff(double KW_max) const;
   double max_timestep_W_cfl() const;
+  double max_timestep_W_cfl(double speed_x_max, double speed_y_max) const;
 protected:
 
   // edge-centered (staggered) advection flux
@@ -123,15 +127,38 @@ protected:
   // edge-centered (staggered) values of nonlinear conductivity
   array::Staggered1 m_Kstag;
 
+  // edge-centered (staggered) values of the |grad R|^{beta-2} factor of the nonlinear
+  // conductivity; depends on the ice geometry but not on the evolving water amount (see
+  // compute_conductivity_factor())
+  array::Staggered1 m_Bstag;
+
+  // edge-centered (staggered) diffusivity D = rho_w g K W used by the implicit
+  // diffusion solver
+  array::Staggered1 m_Dstag;
+
+  // true if hydrology.routing.implicit_diffusion is set
+  bool m_implicit_diffusion;
+
+  // solver performing backward Euler steps of the diffusion part of the water flux;
+  // allocated only if hydrology.routing.implicit_diffusion is set
+  std::shared_ptr<ImplicitDiffusion> m_diffusion_solver;
+
   // work space
   array::Scalar m_Wnew, m_Wtillnew;
 
   // ghosted temporary storage; modified in compute_conductivity and compute_velocity
-  mutable array::Scalar1 m_R;
+  // (width 2: compute_conductivity_factor() computes values in the halo locally)
+  mutable array::Scalar2 m_R;
 
   double m_dx, m_dy;
   double m_rg;
 
+  // parameters used once per sub-step; cached to avoid string lookups (see
+  // Config::cached_number())
+  Config::Number m_tillwat_max;
+  Config::Number m_tillwat_decay_rate;
+  Config::Flag m_add_surface_input_to_till;
+
   array::Scalar1 m_bottom_surface;
 
   void water_thickness_staggered(const array::Scalar &W,
@@ -155,6 +182,16 @@ protected:
                         const array::Scalar &W,
                         array::Staggered &result) const;
 
+  void compute_conductivity_factor(const array::Scalar2 &R,
+                                   array::Staggered1 &result) const;
+
+  void compute_fluxes(const array::CellType1 &cell_type,
+                      const array::Scalar1 &W,
+                      const array::Scalar1 *no_model_mask,
+                      double &KW_max,
+                      double &speed_x_max,
+                      double &speed_y_max);
+
   void W_change_due_to_flow(double dt,
                             const array::Scalar1    &W,
                             const array::Staggered1 &Wstag,
@@ -172,6 +209,17 @@ protected:
                 const array::Staggered1 &Q,
                 array::Scalar           &W_new);
 
+  void update_W_implicit(double dt,
+                         const array::Scalar     &surface_input_rate,
+                         const array::Scalar     &basal_melt_rate,
+                         const array::Scalar1    &W,
+                         const array::Staggered1 &Wstag,
+                         const array::Scalar     &Wtill,
+                         const array::Scalar     &Wtill_new,
+                         const array::Staggered1 &K,
+                         const array::Staggered1 &Q,
+                         array::Scalar           &W_new);
+
   void update_Wtill(double dt,
                     const array::Scalar &Wtill,
                     const array::Scalar &surface_input_rate,
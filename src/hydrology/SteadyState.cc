@@ -89,16 +89,34 @@ void SteadyState::update_impl(double t, double dt, const Inputs& inputs) {
   if (t >= t_next or std::abs(t_next - t) < m_t_eps or
       m_bootstrap) {
 
-    m_log->message(3, " Updating the steady-state subglacial water flux...\n");
-
-    profiling().begin("steady_emptying");
-
-    m_emptying_problem->update(*inputs.geometry,
-                               inputs.no_model_mask,
-                               m_surface_input_rate);
-
-    profiling().end("steady_emptying");
-    m_Q.copy_from(m_emptying_problem->flux());
+    // Skip the (expensive) emptying problem solve if none of its inputs changed since
+    // the flux was last computed. Revision counters are conservative: a field that is
+    // re-computed in place gets a new revision even if its values did not change, so
+    // this fires only when input models report that their outputs are unchanged (e.g.
+    // runs with static ice geometry and time-independent water input).
+    bool inputs_changed =
+        m_input_revisions.changed({ &inputs.geometry->ice_thickness,
+                                    &inputs.geometry->bed_elevation,
+                                    &inputs.geometry->sea_level_elevation,
+                                    &inputs.geometry->cell_type,
+                                    &m_surface_input_rate,
+                                    inputs.no_model_mask });
+
+    if (inputs_changed or m_bootstrap) {
+      m_log->message(3, " Updating the steady-state subglacial water flux...\n");
+
+      profiling().begin("steady_emptying");
+
+      m_emptying_problem->update(*inputs.geometry,
+                                 inputs.no_model_mask,
+                                 m_surface_input_rate);
+
+      profiling().end("steady_emptying");
+      m_Q.copy_from(m_emptying_problem->flux());
+    } else {
+      m_log->message(3, " Steady-state hydrology inputs did not change:"
+                     " re-using the water flux.\n");
+    }
 
     m_t_last = t;
     m_bootstrap = false;
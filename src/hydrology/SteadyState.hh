@@ -75,6 +75,9 @@ protected:
 
   //! Set to true in bootstrap_impl() if update_impl() has to bootstrap m_Q.
   bool m_bootstrap;
+
+  //! Revisions of the inputs at the time of the last water flux computation
+  InputRevisions m_input_revisions;
 };
 
 } // end of namespace hydrology
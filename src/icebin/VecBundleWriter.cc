@@ -10,6 +10,7 @@
 #include "pism/util/io/io_helpers.hh"
 #include "pism/util/Time.hh"
 #include "pism/util/io/SynchronousOutputWriter.hh"
+#include "pism/util/io/ThreadedOutputWriter.hh"
 
 using namespace pism;
 
@@ -20,8 +21,14 @@ VecBundleWriter::VecBundleWriter(std::shared_ptr<pism::Grid> _grid, std::string
                                  std::vector<pism::array::Array const *> &_vecs)
     : m_grid(_grid),
       fname(_fname),
-      vecs(_vecs),
-      output_writer(new SynchronousOutputWriter(m_grid->com, *m_grid->ctx()->config())) {
+      vecs(_vecs) {
+  const auto &config = *m_grid->ctx()->config();
+
+  if (config.get_flag("output.threaded_writer.enabled")) {
+    output_writer = std::make_shared<ThreadedOutputWriter>(m_grid->com, config);
+  } else {
+    output_writer = std::make_shared<SynchronousOutputWriter>(m_grid->com, config);
+  }
   output_writer->initialize({}, true);
 }
 
@@ -14,7 +14,14 @@ class OutputWriter;
 
 namespace icebin {
 
-/** Sets up to easily write out a bundle of PISM variables to a file. */
+/** Sets up to easily write out a bundle of PISM variables to a file.
+ *
+ * If `output.threaded_writer.enabled` is set, writes are performed by a background
+ * thread (see ThreadedOutputWriter) and write() returns as soon as the data are
+ * buffered, taking bundle I/O off the coupled model's critical path: the GCM waits on
+ * PISM, so with the synchronous writer these writes add directly to the coupled time
+ * step. An I/O failure is then reported by a later write() call instead of the one
+ * that requested the failed operation. */
 class VecBundleWriter {
   std::shared_ptr<const pism::Grid> m_grid;
   std::string const fname;                     // Name of the file to write
@@ -17,6 +17,7 @@
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include <cmath>
+#include <cstdio>               // fprintf
 #include <cstring>
 #include <algorithm>
 #include <memory>
@@ -50,6 +51,9 @@
 #include "pism/coupler/util/options.hh" // ForcingOptions
 #include "pism/coupler/ocean/PyOceanModel.hh"
 #include "pism/util/io/SynchronousOutputWriter.hh"
+#include "pism/util/io/ThreadedOutputWriter.hh"
+#include "pism/util/io/ServerOutputWriter.hh"
+#include "pism/util/io/output_server.hh"
 #include "pism/util/io/IO_Flags.hh"
 
 #if (Pism_USE_YAC == 1)
@@ -76,7 +80,8 @@ IceModel::IceModel(std::shared_ptr<Grid> grid, const std::shared_ptr<Context> &c
       m_ice_thickness_bc_mask(grid, "thk_bc_mask"),
       m_step_counter(0),
       m_thickness_change(grid),
-      m_scalar_times(new std::vector<double>()) {
+      m_scalar_times(new std::vector<double>()),
+      m_last_viewer_time(-1.0) {
 
   m_velocity_bc_mask.set_interpolation_type(NEAREST);
   m_ice_thickness_bc_mask.set_interpolation_type(NEAREST);
@@ -135,6 +140,20 @@ IceModel::IceModel(std::shared_ptr<Grid> grid, const std::shared_ptr<Context> &c
   m_snapshot_writer = m_output_writer;
   m_spatial_writer  = m_output_writer;
 
+  if (m_config->get_flag("output.threaded_writer.enabled")) {
+    auto threaded_writer = std::make_shared<ThreadedOutputWriter>(m_grid->com, *m_config);
+
+    m_snapshot_writer = threaded_writer;
+    m_spatial_writer  = threaded_writer;
+  }
+
+  if (io::output_server_enabled()) {
+    auto server_writer = std::make_shared<ServerOutputWriter>(m_grid->com, *m_config);
+
+    m_snapshot_writer = server_writer;
+    m_spatial_writer  = server_writer;
+  }
+
 #if (Pism_USE_YAC == 1)
   if (pism::yac_component_defined("pism_output")) {
     auto yac_writer = std::make_shared<YacOutputWriter>(m_grid->com, *m_config);
@@ -150,10 +169,17 @@ double IceModel::dt() const {
 }
 
 void IceModel::reset_counters() {
-  m_dt_TempAge       = 0.0;
+  m_dt_TempAge     = 0.0;
+  m_dt_hydrology   = 0.0;
   m_dt             = 0.0;
   m_skip_countdown = 0;
 
+  m_steady_state_counter  = 0;
+  m_steady_state_time     = NAN; // updated at the end of the first energy step
+  m_steady_state_volume   = 0.0;
+  m_steady_state_enthalpy = 0.0;
+  m_steady_state_speed    = 0.0;
+
   {
     int year_increment = static_cast<int>(m_config->get_number("time_stepping.hit_multiples"));
 
@@ -177,7 +203,15 @@ void IceModel::reset_counters() {
 
 
 IceModel::~IceModel() {
-  // empty; defined here to be able to use more forward-declared classes in IceModel.hh
+  // Wait for the background checkpoint drain, if one is running. Cannot throw from a
+  // destructor: report errors and move on.
+  try {
+    finish_checkpoint_drain();
+  } catch (std::exception &e) {
+    fprintf(stderr, "PISM ERROR: draining a checkpoint failed: %s\n", e.what());
+  } catch (...) {
+    fprintf(stderr, "PISM ERROR: draining a checkpoint failed\n");
+  }
 }
 
 
@@ -376,6 +410,13 @@ energy::Inputs IceModel::energy_model_inputs() {
   result.v3                       = &m_stress_balance->velocity_v();
   result.w3                       = &m_stress_balance->velocity_w();
 
+  // Fuse the age update into the energy update if the energy model supports that (see
+  // IceModel::step()).
+  if (m_age_model and m_energy_model->can_update_age()) {
+    result.ice_age        = &m_age_model->age();
+    result.ice_age_output = &m_age_model->work();
+  }
+
   result.check();             // make sure all data members were set
 
   return result;
@@ -418,6 +459,18 @@ double IceModel::step(bool do_mass_continuity,
 
   const bool updateAtDepth  = (m_skip_countdown == 0);
 
+  // Even on "at depth" steps the vertical-extension stage of the stress balance update
+  // (3D velocities, vertical velocity, strain heating) can be skipped if nothing in this
+  // run will read its results; see need_3d_velocities().
+  const bool update3DVelocities = updateAtDepth and need_3d_velocities();
+
+  // The subglacial hydrology model can share the cadence of the energy and age
+  // computations: see time_stepping.skip.hydrology. Its state is held constant on skipped
+  // steps and the accumulated time-step length is passed to the model when it is updated,
+  // so water amounts are conserved.
+  const bool updateHydrology = (updateAtDepth or
+                                not m_config->get_flag("time_stepping.skip.hydrology"));
+
   // Combine basal melt rate in grounded (computed during the energy
   // step) and floating (provided by an ocean model) areas.
   //
@@ -430,9 +483,24 @@ double IceModel::step(bool do_mass_continuity,
                             m_basal_melt_rate);
   }
 
+  // Let file-backed inputs (e.g. -surface given, -ocean given) start reading records
+  // covering the upcoming time interval on the forcing prefetch thread (see
+  // input.forcing.prefetch) while the stress balance solve below is running. The
+  // previous time step length is a good enough estimate: this is a hint and does not
+  // need to be exact.
+  if (m_dt > 0.0) {
+    for (auto m : m_submodels) {
+      m.second->prefetch(current_time, m_dt);
+    }
+
+    if (m_surface_input_for_hydrology) {
+      m_surface_input_for_hydrology->prefetch(current_time, m_dt);
+    }
+  }
+
   try {
     profiling.begin("stress_balance");
-    m_stress_balance->update(stress_balance_inputs(), updateAtDepth);
+    m_stress_balance->update(stress_balance_inputs(), update3DVelocities);
     profiling.end("stress_balance");
   } catch (RuntimeError &e) {
     std::string output_file = save_state_on_error("_stressbalance_failed", {});
@@ -445,7 +513,7 @@ double IceModel::step(bool do_mass_continuity,
 
   m_stdout_flags += m_stress_balance->stdout_report();
 
-  m_stdout_flags += (updateAtDepth ? "v" : "V");
+  m_stdout_flags += (update3DVelocities ? "v" : "V");
 
   //! \li determine the time step according to a variety of stability criteria
   auto dt_info = max_timestep(m_skip_countdown);
@@ -469,16 +537,23 @@ double IceModel::step(bool do_mass_continuity,
 
   //! \li update the age of the ice (if appropriate)
   if (m_age_model and updateAtDepth) {
-    AgeModelInputs inputs;
-    inputs.ice_thickness = &m_geometry.ice_thickness;
-    inputs.u3            = &m_stress_balance->velocity_u();
-    inputs.v3            = &m_stress_balance->velocity_v();
-    inputs.w3            = &m_stress_balance->velocity_w();
-
-    profiling.begin("age");
-    m_age_model->update(m_t_TempAge, m_dt_TempAge, inputs);
-    profiling.end("age");
-    m_stdout_flags += "a";
+    if (m_energy_model->can_update_age()) {
+      // The age of the ice is updated as a part of the energy step below (see
+      // energy_model_inputs()): this way both column systems are fed from a single load
+      // of the velocity columns.
+      m_stdout_flags += "a";
+    } else {
+      AgeModelInputs inputs;
+      inputs.ice_thickness = &m_geometry.ice_thickness;
+      inputs.u3            = &m_stress_balance->velocity_u();
+      inputs.v3            = &m_stress_balance->velocity_v();
+      inputs.w3            = &m_stress_balance->velocity_w();
+
+      profiling.begin("age");
+      m_age_model->update(m_t_TempAge, m_dt_TempAge, inputs);
+      profiling.end("age");
+      m_stdout_flags += "a";
+    }
   } else {
     m_stdout_flags += "$";
   }
@@ -621,9 +696,12 @@ double IceModel::step(bool do_mass_continuity,
 
   //! \li update the state variables in the subglacial hydrology model (typically
   //!  water thickness and sometimes pressure)
-  profiling.begin("basal_hydrology");
-  hydrology_step(current_time, dt);
-  profiling.end("basal_hydrology");
+  m_dt_hydrology += dt;
+  if (updateHydrology) {
+    profiling.begin("basal_hydrology");
+    hydrology_step(m_t_hydrology, m_dt_hydrology);
+    profiling.end("basal_hydrology");
+  }
 
   //! \li compute the bed deformation, which depends on current thickness, bed elevation,
   //! and sea level
@@ -662,6 +740,15 @@ double IceModel::step(bool do_mass_continuity,
   if (updateAtDepth) {
     m_t_TempAge  = m_time->current();
     m_dt_TempAge = 0.0;
+
+    // Let the steady-state monitor sample volume, enthalpy, and speed and adjust the
+    // skip cadence; see time_stepping.steady_state.enabled.
+    update_steady_state_monitor();
+  }
+
+  if (updateHydrology) {
+    m_t_hydrology  = m_time->current();
+    m_dt_hydrology = 0.0;
   }
 
   // Check if the ice thickness exceeded the height of the computational box and stop if it did.
@@ -780,6 +867,9 @@ IceModelTerminationReason IceModel::run() {
   m_t_TempAge = m_time->current();
   m_dt_TempAge = 0.0;
 
+  m_t_hydrology = m_time->current();
+  m_dt_hydrology = 0.0;
+
   IceModelTerminationReason termination_reason = PISM_DONE;
   // main loop for time evolution
   // IceModel::step calls Time::step(dt), ensuring that this while loop
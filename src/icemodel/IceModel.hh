@@ -33,9 +33,11 @@
   file containing a complete model state, versus bootstrapping).
 */
 
+#include <exception>            // std::exception_ptr
 #include <map>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 #include <memory>
 
@@ -191,6 +193,7 @@ protected:
   virtual std::map<std::string, Diagnostic::Ptr> allocate_spatial_diagnostics();
   virtual std::map<std::string, TSDiagnostic::Ptr> allocate_scalar_diagnostics();
   void deallocate_unused_diagnostics();
+  bool need_3d_velocities() const;
 
   void init_outputs(InputOptions options, DiagnosticReport report_type);
 
@@ -358,9 +361,21 @@ protected:
   double m_t_TempAge;
   //! enthalpy/temperature and age time-steps
   double m_dt_TempAge;
+  //! time of last update of the subglacial hydrology model
+  double m_t_hydrology;
+  //! subglacial hydrology time-step
+  double m_dt_hydrology;
 
   unsigned int m_skip_countdown;
 
+  //! Steady-state monitor (see time_stepping.steady_state.enabled): the number of
+  //! consecutive energy steps during which all monitored rates of change stayed below
+  //! time_stepping.steady_state.rtol
+  unsigned int m_steady_state_counter;
+  //! quantities sampled by the steady-state monitor at the previous energy step
+  double m_steady_state_time, m_steady_state_volume, m_steady_state_enthalpy,
+    m_steady_state_speed;
+
   std::string m_adaptive_timestep_reason;
 
   std::string m_stdout_flags;
@@ -379,6 +394,7 @@ protected:
 
   virtual MaxTimestep max_timestep_diffusivity();
   virtual unsigned int skip_counter(double input_dt, double input_dt_diffusivity);
+  void update_steady_state_monitor();
 
   // see energy.cc
   virtual void bedrock_thermal_model_step(double t, double dt);
@@ -491,14 +507,57 @@ protected:
   std::vector<double> m_spatial_times;
   unsigned int m_next_spatial_index;
   double m_last_spatial_time;
+  //! number of spatial time-series records written since the last sync() (see
+  //! output.spatial.sync_interval)
+  unsigned int m_spatial_records_since_sync;
   std::set<std::string> m_spatial_vars;
 
   //! set of variables that will be written to extra files
   std::set<VariableMetadata> m_spatial_file_contents;
 
   std::shared_ptr<OutputFile> m_spatial_file;
+
+  // decimated ("adaptive resolution") spatial time-series output; see
+  // init_spatial_decimation()
+  //! block-averaging factor (output.spatial.decimation.factor)
+  unsigned int m_spatial_decimation_factor;
+  //! spatial time-series variables written at the decimated resolution instead of the
+  //! model resolution (output.spatial.decimation.vars)
+  std::set<std::string> m_spatial_decimated_vars;
+  //! set of variables that will be written to the decimated extra file
+  std::set<VariableMetadata> m_spatial_coarse_file_contents;
+  //! output grid of decimated variables
+  std::shared_ptr<Grid> m_spatial_coarse_grid;
+  //! scratch space holding one decimated variable at a time
+  std::shared_ptr<array::Scalar> m_spatial_coarse_scratch;
+  //! dedicated writer for the decimated extra file (decimated variables keep their
+  //! names, so they cannot share a writer with their full-resolution versions)
+  std::shared_ptr<OutputWriter> m_spatial_coarse_writer;
+  std::shared_ptr<OutputFile> m_spatial_coarse_file;
+
+  // windowed ("region of interest") spatial time-series output; see
+  // init_spatial_window()
+  //! spatial time-series variables written over the output window instead of the whole
+  //! domain (output.spatial.window.vars)
+  std::set<std::string> m_spatial_window_vars;
+  //! set of variables that will be written to the windowed extra file
+  std::set<VariableMetadata> m_spatial_window_file_contents;
+  //! output grid of windowed variables (a part of the model grid)
+  std::shared_ptr<Grid> m_spatial_window_grid;
+  //! scratch space holding one windowed variable at a time
+  std::shared_ptr<array::Scalar> m_spatial_window_scratch;
+  //! dedicated writer for the windowed extra file (see m_spatial_coarse_writer)
+  std::shared_ptr<OutputWriter> m_spatial_window_writer;
+  std::shared_ptr<OutputFile> m_spatial_window_file;
+  //! model grid indices of the lower left corner of the output window
+  int m_spatial_window_i0, m_spatial_window_j0;
+
   void init_spatial_diagnostics();
+  void init_spatial_decimation();
+  void init_spatial_window();
   void write_spatial_diagnostics();
+  void write_decimated_diagnostics(double current_time);
+  void write_window_diagnostics(double current_time);
   MaxTimestep spatial_diagnostics_max_timestep(double t);
 
   // automatic checkpoints
@@ -507,8 +566,24 @@ protected:
   std::set<std::string> m_checkpoint_vars;
   //! set of variables that will be written to checkpoint files
   std::set<VariableMetadata> m_checkpoint_file_contents;
+  //! array state counters recorded by the last write to each file of the rolling
+  //! checkpoint file pair (see output.checkpoint.incremental)
+  std::vector<std::shared_ptr<std::map<std::string, int> > > m_checkpoint_counters;
+  //! index (0 or 1) of the checkpoint file to write next in incremental mode
+  unsigned int m_checkpoint_index;
+  //! directory on fast storage that checkpoints are written to before being copied to
+  //! their final location (see output.checkpoint.staging_dir); empty means "write
+  //! checkpoints directly to their final location"
+  std::string m_checkpoint_staging_dir;
+  //! background thread copying ("draining") the most recent checkpoint from the staging
+  //! directory to its final location (see write_checkpoint())
+  std::thread m_checkpoint_drain;
+  //! error reported by the checkpoint drain thread; re-thrown by the next
+  //! write_checkpoint() call (accessed only while m_checkpoint_drain is not running)
+  std::exception_ptr m_checkpoint_drain_failure;
   void init_checkpoints();
   bool write_checkpoint();
+  void finish_checkpoint_drain();
 
   // last time at which PISM hit a multiple of X years, see the configuration parameter
   // time_stepping.hit_multiples
@@ -522,6 +597,9 @@ protected:
 
 private:
   double m_start_time;    // this is used in the wall-clock-time checkpoint code
+  //! wall-clock time of the last runtime viewer redraw (see
+  //! output.runtime.viewer.throttle)
+  double m_last_viewer_time;
 };
 
 MaxTimestep reporting_max_timestep(const std::vector<double> &times,
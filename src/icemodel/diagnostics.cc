@@ -1001,8 +1001,7 @@ CTS::CTS(const IceModel *m) : Diag<IceModel>(m) {
 
 std::shared_ptr<array::Array> CTS::compute_impl() const {
 
-  std::shared_ptr<array::Array3D> result(new array::Array3D(m_grid, "cts", array::WITHOUT_GHOSTS, m_grid->z()));
-  result->metadata() = m_vars[0];
+  auto result = allocate<array::Array3D>("cts", array::WITHOUT_GHOSTS, m_grid->z());
 
   energy::compute_cts(model->energy_balance_model()->enthalpy(), model->geometry().ice_thickness,
                       *result);
@@ -1030,9 +1029,7 @@ Temperature::Temperature(const IceModel *m) : Diag<IceModel>(m) {
 
 std::shared_ptr<array::Array> Temperature::compute_impl() const {
 
-  std::shared_ptr<array::Array3D> result(
-      new array::Array3D(m_grid, "temp", array::WITHOUT_GHOSTS, m_grid->z()));
-  result->metadata() = m_vars[0];
+  auto result = allocate<array::Array3D>("temp", array::WITHOUT_GHOSTS, m_grid->z());
 
   const auto &thickness = model->geometry().ice_thickness;
   const auto &enthalpy  = model->energy_balance_model()->enthalpy();
@@ -1088,8 +1085,7 @@ std::shared_ptr<array::Array> TemperaturePA::compute_impl() const {
   bool cold_mode = set_member(m_config->get_string("energy.model"), {"cold", "none"});
   double melting_point_temp = m_config->get_number("constants.fresh_water.melting_point_temperature");
 
-  auto result = std::make_shared<array::Array3D>(m_grid, "temp_pa", array::WITHOUT_GHOSTS, m_grid->z());
-  result->metadata() = m_vars[0];
+  auto result = allocate<array::Array3D>("temp_pa", array::WITHOUT_GHOSTS, m_grid->z());
 
   const auto &thickness = model->geometry().ice_thickness;
   const auto &enthalpy  = model->energy_balance_model()->enthalpy();
@@ -1412,9 +1408,7 @@ LiquidFraction::LiquidFraction(const IceModel *m) : Diag<IceModel>(m) {
 
 std::shared_ptr<array::Array> LiquidFraction::compute_impl() const {
 
-  std::shared_ptr<array::Array3D> result(
-      new array::Array3D(m_grid, "liqfrac", array::WITHOUT_GHOSTS, m_grid->z()));
-  result->metadata(0) = m_vars[0];
+  auto result = allocate<array::Array3D>("liqfrac", array::WITHOUT_GHOSTS, m_grid->z());
 
   bool cold_mode = set_member(m_config->get_string("energy.model"), {"cold", "none"});
 
@@ -1654,11 +1648,13 @@ public:
 
     set_units("m^3 s^-1", "m^3 year^-1");
     m_variable["long_name"] = "rate of change of the ice volume in glacierized areas";
+
+    m_batchable = true;
   }
 
-  double compute() {
-    return ice_volume(model->geometry(),
-                      m_config->get_number("output.ice_free_thickness_standard"));
+  double compute_local() {
+    return ice_volume_local(model->geometry(),
+                            m_config->get_number("output.ice_free_thickness_standard"));
   }
 };
 
@@ -1670,10 +1666,12 @@ public:
 
     set_units("m^3 s^-1", "m^3 year^-1");
     m_variable["long_name"] = "rate of change of the ice volume, including seasonal cover";
+
+    m_batchable = true;
   }
 
-  double compute() {
-    return ice_volume(model->geometry(), 0.0);
+  double compute_local() {
+    return ice_volume_local(model->geometry(), 0.0);
   }
 };
 
@@ -1763,12 +1761,14 @@ public:
 
     set_units("kg s^-1", "Gt year^-1");
     m_variable["long_name"] = "rate of change of the ice mass in glacierized areas";
+
+    m_batchable = true;
   }
 
-  double compute() {
+  double compute_local() {
     double ice_density         = m_config->get_number("constants.ice.density"),
            thickness_threshold = m_config->get_number("output.ice_free_thickness_standard");
-    return ice_volume(model->geometry(), thickness_threshold) * ice_density;
+    return ice_volume_local(model->geometry(), thickness_threshold) * ice_density;
   }
 };
 
@@ -1785,28 +1785,18 @@ public:
     set_units("kg s^-1", "Gt year^-1");
     m_variable["long_name"] = "rate of change of the mass of ice due to flow"
                               " (i.e. prescribed ice thickness)";
-  }
 
-  double compute() {
+    m_batchable = true;
+  }
 
+  double compute_local() {
     const double ice_density = m_config->get_number("constants.ice.density");
 
-    const array::Scalar &dH = model->geometry_evolution().thickness_change_due_to_flow(),
-                        &dV = model->geometry_evolution().area_specific_volume_change_due_to_flow();
-
-    auto cell_area = m_grid->cell_area();
-
-    array::AccessScope list{ &dH, &dV };
-
-    double volume_change = 0.0;
-    for (auto p : m_grid->points()) {
-      const int i = p.i(), j = p.j();
-      // m * m^2 = m^3
-      volume_change += (dH(i, j) + dV(i, j)) * cell_area;
-    }
+    // the total is accumulated inside the geometry update sweeps; see
+    // GeometryEvolution::total_thickness_change_due_to_flow_local()
 
     // (kg/m^3) * m^3 = kg
-    return ice_density * GlobalSum(m_grid->com, volume_change);
+    return ice_density * model->geometry_evolution().total_thickness_change_due_to_flow_local();
   }
 };
 
@@ -1817,11 +1807,13 @@ public:
 
     set_units("kg s^-1", "Gt year^-1");
     m_variable["long_name"] = "rate of change of the mass of ice, including seasonal cover";
+
+    m_batchable = true;
   }
 
-  double compute() {
+  double compute_local() {
     const double ice_density = m_config->get_number("constants.ice.density");
-    return ice_volume(model->geometry(), 0.0) * ice_density;
+    return ice_volume_local(model->geometry(), 0.0) * ice_density;
   }
 };
 
@@ -2204,13 +2196,44 @@ public:
  * special case used when `term == FLOW`. (Note that surface and basal
  * mass balances do not affect the area specific volume field.)
  */
-double mass_change(const IceModel *model, TermType term, AreaType area) {
+//! This rank's contribution to the mass change; the flux diagnostics below sum these
+//! contributions in one batched reduction (see TSDiagnostic::compute_local()).
+static double mass_change_local(const IceModel *model, TermType term, AreaType area) {
   const Grid &grid     = *model->grid();
   const Config &config = *grid.ctx()->config();
 
   const double ice_density = config.get_number("constants.ice.density"),
                cell_area   = grid.cell_area();
 
+  if (area == BOTH) {
+    // Domain totals are accumulated inside the sweeps that compute the corresponding
+    // fields, so reporting them requires no grid traversal at all; see
+    // GeometryEvolution::total_thickness_change_due_to_flow_local() and friends.
+    const GeometryEvolution &ge = model->geometry_evolution();
+
+    double volume_change = 0.0; // m^3
+    switch (term) {
+    case FLOW:
+      volume_change = ge.total_thickness_change_due_to_flow_local();
+      break;
+    case SMB:
+      volume_change = ge.total_top_surface_mass_balance_local();
+      break;
+    case BMB:
+      volume_change = ge.total_bottom_surface_mass_balance_local();
+      break;
+    case ERROR:
+      volume_change = ge.total_conservation_error_local();
+      break;
+    default:
+      // can't happen
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION, "invalid term type");
+    }
+
+    // (kg / m^3) * m^3 = kg
+    return ice_density * volume_change;
+  }
+
   const auto &cell_type = model->geometry().cell_type;
 
   const array::Scalar *thickness_change = nullptr;
@@ -2257,7 +2280,7 @@ double mass_change(const IceModel *model, TermType term, AreaType area) {
   }
 
   // (kg / m^3) * m^3 = kg
-  return ice_density * GlobalSum(grid.com, volume_change);
+  return ice_density * volume_change;
 }
 
 //! \brief Reports the total bottom surface ice flux.
@@ -2274,10 +2297,12 @@ public:
     m_variable["long_name"]     = "total over ice domain of bottom surface ice mass flux";
     m_variable["standard_name"] = "tendency_of_land_ice_mass_due_to_basal_mass_balance";
     m_variable["comment"]       = "positive means ice gain";
+
+    m_batchable = true;
   }
 
-  double compute() {
-    return mass_change(model, BMB, BOTH);
+  double compute_local() {
+    return mass_change_local(model, BMB, BOTH);
   }
 };
 
@@ -2295,10 +2320,12 @@ public:
     m_variable["long_name"]     = "total over ice domain of top surface ice mass flux";
     m_variable["standard_name"] = "tendency_of_land_ice_mass_due_to_surface_mass_balance";
     m_variable["comment"]       = "positive means ice gain";
+
+    m_batchable = true;
   }
 
-  double compute() {
-    return mass_change(model, SMB, BOTH);
+  double compute_local() {
+    return mass_change_local(model, SMB, BOTH);
   }
 };
 
@@ -2312,10 +2339,12 @@ public:
     m_variable["long_name"]     = "total over grounded ice domain of basal mass flux";
     m_variable["standard_name"] = "tendency_of_land_ice_mass_due_to_basal_mass_balance";
     m_variable["comment"]       = "positive means ice gain";
+
+    m_batchable = true;
   }
 
-  double compute() {
-    return mass_change(model, BMB, GROUNDED);
+  double compute_local() {
+    return mass_change_local(model, BMB, GROUNDED);
   }
 };
 
@@ -2333,10 +2362,12 @@ public:
     m_variable["long_name"]     = "total sub-shelf ice flux";
     m_variable["standard_name"] = "tendency_of_land_ice_mass_due_to_basal_mass_balance";
     m_variable["comment"]       = "positive means ice gain";
+
+    m_batchable = true;
   }
 
-  double compute() {
-    return mass_change(model, BMB, SHELF);
+  double compute_local() {
+    return mass_change_local(model, BMB, SHELF);
   }
 };
 
@@ -2351,10 +2382,12 @@ public:
     m_variable["long_name"] = "total numerical flux needed to preserve non-negativity"
                               " of ice thickness";
     m_variable["comment"]   = "positive means ice gain";
+
+    m_batchable = true;
   }
 
-  double compute() {
-    return mass_change(model, ERROR, BOTH);
+  double compute_local() {
+    return mass_change_local(model, ERROR, BOTH);
   }
 };
 
@@ -2372,9 +2405,11 @@ public:
     m_variable["long_name"]     = "discharge flux (frontal melt, calving, forced retreat)";
     m_variable["standard_name"] = "tendency_of_land_ice_mass_due_to_calving_and_ice_front_melting";
     m_variable["comment"]       = "positive means ice gain";
+
+    m_batchable = true;
   }
 
-  double compute() {
+  double compute_local() {
     const double ice_density = m_config->get_number("constants.ice.density");
 
     const array::Scalar &calving        = model->calving();
@@ -2394,7 +2429,7 @@ public:
     }
 
     // (kg/m^3) * m^3 = kg
-    return ice_density * GlobalSum(m_grid->com, volume_change);
+    return ice_density * volume_change;
   }
 };
 
@@ -2412,9 +2447,11 @@ public:
     m_variable["long_name"]     = "calving flux";
     m_variable["standard_name"] = "tendency_of_land_ice_mass_due_to_calving";
     m_variable["comment"]       = "positive means ice gain";
+
+    m_batchable = true;
   }
 
-  double compute() {
+  double compute_local() {
     const double ice_density = m_config->get_number("constants.ice.density");
 
     const array::Scalar &calving = model->calving();
@@ -2432,7 +2469,7 @@ public:
     }
 
     // (kg/m^3) * m^3 = kg
-    return ice_density * GlobalSum(m_grid->com, volume_change);
+    return ice_density * volume_change;
   }
 };
 
@@ -2561,9 +2598,8 @@ LatLonBounds::LatLonBounds(const IceModel *m, const std::string &var_name,
 }
 
 std::shared_ptr<array::Array> LatLonBounds::compute_impl() const {
-  std::shared_ptr<array::Array3D> result(new array::Array3D(
-      m_grid, m_var_name + "_bnds", array::WITHOUT_GHOSTS, { 0.0, 1.0, 2.0, 3.0 }));
-  result->metadata(0) = m_vars[0];
+  auto result = allocate<array::Array3D>(m_var_name + "_bnds", array::WITHOUT_GHOSTS,
+                                         std::vector<double>{ 0.0, 1.0, 2.0, 3.0 });
 
   if (m_var_name == "lat") {
     compute_lat_bounds(m_proj_string, *result);
@@ -2907,9 +2943,7 @@ IceHardness::IceHardness(const IceModel *m) : Diag<IceModel>(m) {
 
 std::shared_ptr<array::Array> IceHardness::compute_impl() const {
 
-  std::shared_ptr<array::Array3D> result(
-      new array::Array3D(m_grid, "hardness", array::WITHOUT_GHOSTS, m_grid->z()));
-  result->metadata(0) = m_vars[0];
+  auto result = allocate<array::Array3D>("hardness", array::WITHOUT_GHOSTS, m_grid->z());
 
   auto EC = m_grid->ctx()->enthalpy_converter();
 
@@ -2973,11 +3007,10 @@ static inline double square(double x) {
 
 std::shared_ptr<array::Array> IceViscosity::compute_impl() const {
 
-  std::shared_ptr<array::Array3D> result(
-      new array::Array3D(m_grid, "effective_viscosity", array::WITHOUT_GHOSTS, m_grid->z()));
-  result->metadata(0) = m_vars[0];
+  auto result = allocate<array::Array3D>("effective_viscosity", array::WITHOUT_GHOSTS, m_grid->z());
 
-  array::Array3D W(m_grid, "wvel", array::WITH_GHOSTS, m_grid->z());
+  auto W_ptr = scratch<array::Array3D>("wvel", array::WITH_GHOSTS, m_grid->z());
+  array::Array3D &W = *W_ptr;
 
   using mask::ice_free;
 
@@ -3816,13 +3849,18 @@ void IceModel::deallocate_unused_diagnostics() {
   }
 
   auto stop = m_config->get_flag("output.spatial.stop_missing");
-  warn_about_missing(*m_log, m_spatial_vars, "diagnostic", available, stop);
+  warn_about_missing(*m_log,
+                     combine(combine(m_spatial_vars, m_spatial_decimated_vars),
+                             m_spatial_window_vars),
+                     "diagnostic", available, stop);
 
   // get the list of requested diagnostics
   auto requested = set_split(m_config->get_string("output.runtime.viewer.variables"), ',');
   requested = combine(requested, m_output_vars);
   requested = combine(requested, m_snapshot_vars);
   requested = combine(requested, m_spatial_vars);
+  requested = combine(requested, m_spatial_decimated_vars);
+  requested = combine(requested, m_spatial_window_vars);
   requested = combine(requested, m_checkpoint_vars);
 
   // de-allocate diagnostics that were not requested
@@ -3833,6 +3871,52 @@ void IceModel::deallocate_unused_diagnostics() {
   }
 }
 
+/*!
+ * Return true if some part of this run will read the 3D velocity field or the quantities
+ * computed alongside it (vertical velocity, strain heating, 3D CFL numbers).
+ *
+ * This is used to skip the vertical-extension stage of the stress balance update in runs
+ * that use none of its results: energy conservation and the age of the ice are not
+ * modeled, isochrones are not tracked, and no requested diagnostic depends on velocities
+ * at depth. The 2D (vertically-averaged) solve and the diffusive flux driving geometry
+ * evolution are not affected; see StressBalance::update().
+ *
+ * Call this after deallocate_unused_diagnostics() and the initialization of scalar
+ * reporting: the answer is based on the pruned lists of diagnostics.
+ */
+bool IceModel::need_3d_velocities() const {
+  // The energy balance model reads 3D velocities and the strain heating term; the age
+  // model and the isochrone tracking scheme advect their fields using 3D velocities. (The
+  // "none" energy model consumes neither; see DummyEnergyModel.)
+  if (set_member(m_config->get_string("energy.model"), {"cold", "enthalpy"}) or
+      m_age_model or m_isochrones) {
+    return true;
+  }
+
+  // Spatial diagnostics reading velocities at depth, the vertical velocity, or the
+  // strain heating term.
+  static const std::set<std::string> depends_on_3d_velocity =
+    {"velbar", "velmean", "velbar_mag", "flux", "flux_mag",
+     "velbase", "velbase_mag", "velsurf", "velsurf_mag",
+     "uvel", "vvel", "wvel", "wvel_rel",
+     "wvelbase", "wvelsurf", "zvelbase", "zvelsurf",
+     "strainheat", "effective_viscosity"};
+  for (const auto &d : m_available_spatial_diagnostics) {
+    if (set_member(d.first, depends_on_3d_velocity)) {
+      return true;
+    }
+  }
+
+  // Scalar diagnostics reporting the 3D CFL numbers.
+  for (const auto &d : m_available_scalar_diagnostics) {
+    if (set_member(d.first, {"dt_ratio", "max_horizontal_vel"})) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 /*!
  * Update diagnostics.
  *
@@ -3845,8 +3929,32 @@ void IceModel::update_diagnostics(double t, double dt) {
     d.second->update(dt);
   }
 
+  // Scalar diagnostics: let each diagnostic register its per-rank contribution, combine
+  // all of them in one reduction, then finish the updates using global values. This
+  // replaces one allreduce per diagnostic per step with one for the whole set.
+  {
+    ReductionBatch batch;
+
+    for (const auto &d : m_available_scalar_diagnostics) {
+      d.second->update(t - dt, t, batch);
+    }
+
+    batch.reduce(m_ctx->com_intra_node(), m_ctx->com_inter_node());
+
+    for (const auto &d : m_available_scalar_diagnostics) {
+      d.second->finish_update(t - dt, t);
+    }
+  }
+
+  // Flush scalar diagnostics when their buffers fill up (they fill in lockstep: all of
+  // them share requested times and the buffer size). This bounds the memory used by
+  // time-series buffers and writes all the buffered series in one batch, with a single
+  // sync, instead of paying the flush cost per variable.
   for (const auto &d : m_available_scalar_diagnostics) {
-    d.second->update(t - dt, t);
+    if (d.second->buffer_full()) {
+      scalar_diagnostics_flush_buffers();
+      break;
+    }
   }
 }
 
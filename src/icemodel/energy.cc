@@ -20,6 +20,7 @@
 
 #include "pism/icemodel/IceModel.hh"
 
+#include "pism/age/AgeModel.hh"
 #include "pism/energy/BedThermalUnit.hh"
 #include "pism/util/Grid.hh"
 #include "pism/util/Config.hh"
@@ -67,6 +68,11 @@ void IceModel::energy_step(double t, double dt) {
 
   m_energy_model->update(t, dt, energy_model_inputs());
 
+  if (m_age_model and m_energy_model->can_update_age()) {
+    // the energy model updated the age of the ice as well (see energy_model_inputs())
+    m_age_model->finish_fused_update();
+  }
+
   m_stdout_flags = m_energy_model->stdout_flags() + m_stdout_flags;
 }
 
@@ -17,14 +17,138 @@
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <algorithm>            // std::fill
+#include <cstdint>              // uint32_t, uint64_t
+#include <cstdio>               // std::rename
+#include <fstream>
+#include <vector>
+
 #include "pism/icemodel/IceModel.hh"
 
+#include "pism/util/error_handling.hh"
 #include "pism/util/pism_utilities.hh"
 #include "pism/util/Profiling.hh"
 #include "pism/util/io/io_helpers.hh"
 
 namespace pism {
 
+namespace {
+
+//! Streaming version of the Fletcher checksum (see pism::fletcher64()), used to verify
+//! drained checkpoints without holding a whole file in memory.
+class Fletcher64 {
+public:
+  //! Add a chunk of data. `length` is the number of 32-bit words; it has to be small
+  //! enough for the sums below not to overflow (all chunks used here are).
+  void add(const uint32_t *data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+      m_c0 = m_c0 + data[i];
+      m_c1 = m_c1 + m_c0;
+    }
+    m_c0 = m_c0 % UINT32_MAX;
+    m_c1 = m_c1 % UINT32_MAX;
+  }
+
+  uint64_t value() const {
+    return (m_c1 << 32) | m_c0;
+  }
+
+private:
+  uint64_t m_c0 = 0;
+  uint64_t m_c1 = 0;
+};
+
+//! Read `stream` to the end, writing it to `output` (if not null), and return the number
+//! of bytes read; `sum` accumulates the checksum of the data (zero-padded to a multiple
+//! of 4 bytes).
+uint64_t process_stream(std::ifstream &stream, std::ofstream *output, Fletcher64 &sum) {
+  // a multiple of 4 bytes, small enough for Fletcher64::add() above
+  const size_t chunk_size = 1024 * 1024;
+
+  std::vector<char> buffer(chunk_size + 4);
+
+  uint64_t total = 0;
+  while (stream) {
+    stream.read(buffer.data(), chunk_size);
+
+    size_t n_bytes = (size_t)stream.gcount();
+    if (n_bytes == 0) {
+      break;
+    }
+
+    if (output != nullptr) {
+      output->write(buffer.data(), (std::streamsize)n_bytes);
+    }
+    total += n_bytes;
+
+    size_t padded = 4 * ((n_bytes + 3) / 4);
+    std::fill(buffer.begin() + (long)n_bytes, buffer.begin() + (long)padded, 0);
+    sum.add(reinterpret_cast<const uint32_t *>(buffer.data()), padded / 4);
+  }
+
+  return total;
+}
+
+//! Copy a checkpoint from the staging directory to its final location.
+/*!
+ * Writes to a temporary file, re-reads that file to verify the copy, and renames it into
+ * place, so `destination` is either a complete, verified checkpoint or does not exist at
+ * all. (In particular, a restart never sees a partially-drained file: if PISM crashes
+ * before a drain completes, `destination` contains the previous checkpoint and the
+ * staged copy contains the current one.)
+ *
+ * Runs on the checkpoint drain thread; see IceModel::write_checkpoint().
+ */
+void drain_checkpoint(const std::string &source, const std::string &destination) {
+  std::string tmp = destination + ".tmp";
+
+  uint64_t source_size = 0;
+  Fletcher64 source_sum;
+  {
+    std::ifstream input(source, std::ios::binary);
+    if (not input) {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                    "failed to open the staged checkpoint '%s'",
+                                    source.c_str());
+    }
+
+    std::ofstream output(tmp, std::ios::binary | std::ios::trunc);
+    if (not output) {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION, "failed to create '%s'", tmp.c_str());
+    }
+
+    source_size = process_stream(input, &output, source_sum);
+
+    output.close();
+    if (output.fail()) {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION, "failed to write to '%s'", tmp.c_str());
+    }
+  }
+
+  // re-read the copy and verify it before renaming it into place
+  {
+    std::ifstream input(tmp, std::ios::binary);
+    if (not input) {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION, "failed to re-open '%s'", tmp.c_str());
+    }
+
+    Fletcher64 copy_sum;
+    uint64_t copy_size = process_stream(input, nullptr, copy_sum);
+
+    if (copy_size != source_size or copy_sum.value() != source_sum.value()) {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                    "verification of the checkpoint copy '%s' failed", tmp.c_str());
+    }
+  }
+
+  if (std::rename(tmp.c_str(), destination.c_str()) != 0) {
+    throw RuntimeError::formatted(PISM_ERROR_LOCATION, "failed to rename '%s' to '%s'", tmp.c_str(),
+                                  destination.c_str());
+  }
+}
+
+} // end of namespace
+
 //! Initialize checkpointing (snapshot-on-wallclock-time) mechanism.
 void IceModel::init_checkpoints() {
 
@@ -37,6 +161,14 @@ void IceModel::init_checkpoints() {
   m_checkpoint_vars = output_variables(m_config->get_string("output.checkpoint.size"));
   m_last_checkpoint_time = 0.0;
 
+  m_checkpoint_staging_dir = m_config->get_string("output.checkpoint.staging_dir");
+
+  if (m_config->get_flag("output.checkpoint.incremental")) {
+    m_checkpoint_counters = { std::make_shared<std::map<std::string, int> >(),
+                              std::make_shared<std::map<std::string, int> >() };
+  }
+  m_checkpoint_index = 0;
+
   {
     m_checkpoint_file_contents = pism::combine(common_metadata(), state_variables());
     m_checkpoint_file_contents =
@@ -64,31 +196,76 @@ bool IceModel::write_checkpoint() {
 
   const Profiling &profiling = m_ctx->profiling();
 
+  // Wait for the drain of the previous checkpoint if it is still running and report any
+  // error detected by the drain thread.
+  finish_checkpoint_drain();
+
   m_last_checkpoint_time = wall_clock_hours;
 
+  bool incremental = m_config->get_flag("output.checkpoint.incremental");
+
+  std::string filename = m_checkpoint_filename;
+  std::shared_ptr<std::map<std::string, int> > counters;
+  if (incremental) {
+    // Alternate between two files so that a run interrupted in the middle of a
+    // checkpoint leaves the other file intact.
+    filename = filename_add_suffix(m_checkpoint_filename,
+                                   m_checkpoint_index == 0 ? "_1" : "_2", "");
+    counters = m_checkpoint_counters[m_checkpoint_index];
+
+    m_checkpoint_index = (m_checkpoint_index + 1) % 2;
+  }
+
+  // The file the model writes to: the staged copy on fast storage if staging is enabled,
+  // the final location otherwise.
+  std::string staged_filename = filename;
+  if (not m_checkpoint_staging_dir.empty()) {
+    staged_filename =
+        m_checkpoint_staging_dir + "/" + filename.substr(filename.rfind('/') + 1);
+  }
+
   // create a history string:
 
   m_log->message(2,
                  "  [%s] Saving a checkpoint to '%s' (%1.3f hours after the beginning of the run)\n",
-                 timestamp(m_grid->com).c_str(), m_checkpoint_filename.c_str(), wall_clock_hours);
+                 timestamp(m_grid->com).c_str(), staged_filename.c_str(), wall_clock_hours);
 
   double checkpoint_start_time = get_time(m_grid->com);
   profiling.begin("io.checkpoint");
   {
-    OutputFile file(m_output_writer, m_checkpoint_filename);
-    // Ensure that the checkpoint file is closed to force PISM to open a new file every
-    // time we write a checkpoint, moving the old file aside if it exists.
-    file.close();
+    OutputFile file(m_output_writer, staged_filename);
 
-    {
-      // define time dimension *without* time bounds
-      define_time(file);
-      define_variables(file, m_checkpoint_file_contents);
+    // In incremental mode the first write to each file of the pair saves the complete
+    // state; after that only arrays modified since the previous write to this file (as
+    // measured by their state counters) are re-written.
+    bool complete = (not incremental) or counters->empty();
+
+    if (incremental) {
+      file.set_state_counters(counters);
     }
 
-    {
+    if (complete) {
+      // Ensure that the checkpoint file is closed to force PISM to open a new file every
+      // time we write a checkpoint, moving the old file aside if it exists.
+      file.close();
+
+      {
+        // define time dimension *without* time bounds
+        define_time(file);
+        define_variables(file, m_checkpoint_file_contents);
+      }
+
       io::write_config(*m_config, "pism_config", file);
       file.append_time(m_time->current());
+    } else {
+      file.append();
+      // Overwrite the time value of this file's single record in place: appending a new
+      // record would leave "holes" in variables that are not re-written below.
+      file.write_array(m_config->get_string("time.dimension_name"), { 0 }, { 1 },
+                       { m_time->current() });
+    }
+
+    {
       write_state(file);
       write_state_diagnostics(file, m_checkpoint_vars);
       write_diagnostics(file, m_checkpoint_vars);
@@ -98,6 +275,24 @@ bool IceModel::write_checkpoint() {
   profiling.end("io.checkpoint");
   double checkpoint_end_time = get_time(m_grid->com);
 
+  if (staged_filename != filename) {
+    // Wait until the writer is done with the staged file, then copy ("drain") it to its
+    // final location in the background while the model continues stepping. One rank
+    // performs the copy; drain_checkpoint() replaces the destination atomically, so a
+    // restart sees either the previous checkpoint or a complete, verified new one.
+    m_output_writer->flush();
+
+    if (m_grid->rank() == 0) {
+      m_checkpoint_drain = std::thread([this, staged_filename, filename]() {
+        try {
+          drain_checkpoint(staged_filename, filename);
+        } catch (...) {
+          m_checkpoint_drain_failure = std::current_exception();
+        }
+      });
+    }
+  }
+
   // Also flush time-series:
   scalar_diagnostics_flush_buffers();
 
@@ -110,4 +305,18 @@ bool IceModel::write_checkpoint() {
   return m_config->get_flag("output.checkpoint.exit");
 }
 
+//! Wait for the background checkpoint drain (if one is running) and re-throw any error it
+//! reported.
+void IceModel::finish_checkpoint_drain() {
+  if (m_checkpoint_drain.joinable()) {
+    m_checkpoint_drain.join();
+  }
+
+  if (m_checkpoint_drain_failure != nullptr) {
+    auto failure               = m_checkpoint_drain_failure;
+    m_checkpoint_drain_failure = nullptr;
+    std::rethrow_exception(failure);
+  }
+}
+
 } // end of namespace pism
@@ -173,6 +173,9 @@ void IceModel::scalar_diagnostics_flush_buffers() {
     d.second->flush();
   }
 
+  // sync once for the whole batch
+  m_scalar_file->sync();
+
   // FIXME: update run stats
 }
 
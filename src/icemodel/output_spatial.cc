@@ -16,12 +16,19 @@
  * along with PISM; if not, write to the Free Software
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
+#include <algorithm>            // std::min
 #include <memory>
+#include <vector>
 
 #include "pism/icemodel/IceModel.hh"
 
+#include "pism/util/Grid.hh"
+#include "pism/util/VariableMetadata.hh"
+#include "pism/util/array/Scalar.hh"
 #include "pism/util/pism_utilities.hh"
 #include "pism/util/Profiling.hh"
+#include "pism/util/io/IO_Flags.hh"
+#include "pism/util/io/SynchronousOutputWriter.hh"
 #include "pism/util/io/io_helpers.hh"
 
 namespace pism {
@@ -105,6 +112,7 @@ void IceModel::init_spatial_diagnostics() {
 
   m_last_spatial_time = 0;               // will be set in write_extras()
   m_next_spatial_index = 0;
+  m_spatial_records_since_sync = 0;
 
   m_spatial_filename   = m_config->get_string("output.spatial.file");
   std::string times  = m_config->get_string("output.spatial.times");
@@ -173,12 +181,37 @@ void IceModel::init_spatial_diagnostics() {
     m_log->message(2, "  variables requested: %s\n",
                    vars.empty() ? "model state variables" : vars.c_str());
 
-    if (m_spatial_vars.empty()) {
+    // moves variables listed in output.spatial.decimation.vars from m_spatial_vars to
+    // m_spatial_decimated_vars
+    init_spatial_decimation();
+    // same, for output.spatial.window.vars and m_spatial_window_vars
+    init_spatial_window();
+
+    if (m_spatial_vars.empty() and m_spatial_decimated_vars.empty() and
+        m_spatial_window_vars.empty()) {
       m_spatial_file_contents = state_variables();
     } else {
       m_spatial_file_contents = diagnostic_variables(m_spatial_vars);
     }
     m_spatial_file_contents = pism::combine(m_spatial_file_contents, common_metadata());
+
+    // Store spatially-variable diagnostics in single precision (unless a variable
+    // selects a specific storage type, e.g. an integer mask). This halves the output
+    // volume without a meaningful loss of precision; set
+    // output.spatial.storage_type to "double" to disable.
+    if (m_config->get_string("output.spatial.storage_type") == "float") {
+      for (auto *contents : { &m_spatial_file_contents, &m_spatial_coarse_file_contents,
+                              &m_spatial_window_file_contents }) {
+        std::set<VariableMetadata> tmp;
+        for (auto v : *contents) {
+          if (v.get_output_type() == io::PISM_DOUBLE) {
+            v.set_output_type(io::PISM_FLOAT);
+          }
+          tmp.insert(v);
+        }
+        *contents = tmp;
+      }
+    }
   }
 
   m_spatial_file = nullptr;
@@ -218,6 +251,58 @@ void IceModel::init_spatial_diagnostics() {
       define_time(*m_spatial_file, with_time_bounds);
       define_variables(*m_spatial_file, m_spatial_file_contents);
     }
+
+    // The configuration does not change during the run, so one copy per file is enough:
+    // writing it (about a thousand attributes) with every record adds noticeable
+    // blocking time at output times.
+    io::write_config(*m_config, "pism_config", *m_spatial_file);
+  }
+
+  if (not m_spatial_decimated_vars.empty()) {
+    // Decimated variables go to a companion file through a dedicated synchronous writer:
+    // the spatial writer cannot be re-used because writers identify grid information by
+    // variable name and decimated variables keep the names of their full-resolution
+    // versions. The companion file is about factor^2 times smaller than the main one, so
+    // synchronous writing is cheap even if the main file uses an asynchronous writer.
+    m_spatial_coarse_writer = std::make_shared<SynchronousOutputWriter>(m_grid->com, *m_config);
+    m_spatial_coarse_writer->initialize(m_spatial_coarse_file_contents);
+
+    if (not split) {
+      m_spatial_coarse_file = std::make_shared<OutputFile>(
+          m_spatial_coarse_writer, filename_add_suffix(m_spatial_filename, "_decimated", ""));
+
+      if (append) {
+        m_spatial_coarse_file->append();
+      } else {
+        bool with_time_bounds = true;
+        define_time(*m_spatial_coarse_file, with_time_bounds);
+        define_variables(*m_spatial_coarse_file, m_spatial_coarse_file_contents);
+      }
+
+      // one copy of the configuration per file is enough (see above)
+      io::write_config(*m_config, "pism_config", *m_spatial_coarse_file);
+    }
+  }
+
+  if (not m_spatial_window_vars.empty()) {
+    // same as for decimated variables above
+    m_spatial_window_writer = std::make_shared<SynchronousOutputWriter>(m_grid->com, *m_config);
+    m_spatial_window_writer->initialize(m_spatial_window_file_contents);
+
+    if (not split) {
+      m_spatial_window_file = std::make_shared<OutputFile>(
+          m_spatial_window_writer, filename_add_suffix(m_spatial_filename, "_window", ""));
+
+      if (append) {
+        m_spatial_window_file->append();
+      } else {
+        bool with_time_bounds = true;
+        define_time(*m_spatial_window_file, with_time_bounds);
+        define_variables(*m_spatial_window_file, m_spatial_window_file_contents);
+      }
+
+      io::write_config(*m_config, "pism_config", *m_spatial_window_file);
+    }
   }
 
   if (pism::netcdf_version() > 0 and pism::netcdf_version() < 473) {
@@ -325,19 +410,22 @@ void IceModel::write_spatial_diagnostics() {
         define_time(*m_spatial_file, with_time_bounds);
         define_variables(*m_spatial_file, m_spatial_file_contents);
       }
+
+      // one copy of the configuration per file is enough (see also
+      // init_spatial_diagnostics())
+      io::write_config(*m_config, "pism_config", *m_spatial_file);
     }
 
     m_log->message(3, "saving spatial time-series to %s at %s\n", m_spatial_file->name().c_str(),
                    m_time->date(m_time->current()).c_str());
 
     {
-      io::write_config(*m_config, "pism_config", *m_spatial_file);
-
       // use the mid-point of the current reporting interval
       double time = 0.5 * (m_last_spatial_time + current_time);
       m_spatial_file->append_time(time);
 
-      if (m_spatial_vars.empty()) {
+      if (m_spatial_vars.empty() and m_spatial_decimated_vars.empty() and
+          m_spatial_window_vars.empty()) {
         write_state(*m_spatial_file);
       } else {
         write_diagnostics(*m_spatial_file, m_spatial_vars);
@@ -358,13 +446,31 @@ void IceModel::write_spatial_diagnostics() {
       write_run_stats(*m_spatial_file);
     }
 
-    // FIXME: evaluate if we need to "sync" extra files. We should probably do this every
-    // Nth (e.g. 10th) time we write to an extra file. This would accomplish most of what
-    // "sync()" is for, but at a lower cost.
-    //
+    if (not m_spatial_decimated_vars.empty()) {
+      write_decimated_diagnostics(current_time);
+    }
+
+    if (not m_spatial_window_vars.empty()) {
+      write_window_diagnostics(current_time);
+    }
+
     if (not m_spatial_writer->is_async()) {
-      // make sure all changes are written
-      m_spatial_file->sync();
+      // Make sure all changes are written. Syncing after every Nth record (see
+      // output.spatial.sync_interval) accomplishes most of what sync() is for at a lower
+      // cost: at most the last N records are lost if the run is killed.
+      auto interval = (unsigned int)m_config->get_number("output.spatial.sync_interval");
+
+      m_spatial_records_since_sync += 1;
+      if (m_spatial_records_since_sync >= interval) {
+        m_spatial_file->sync();
+        if (m_spatial_coarse_file != nullptr) {
+          m_spatial_coarse_file->sync();
+        }
+        if (m_spatial_window_file != nullptr) {
+          m_spatial_window_file->sync();
+        }
+        m_spatial_records_since_sync = 0;
+      }
     }
   }
   profiling.end("io.spatial_file");
@@ -375,6 +481,16 @@ void IceModel::write_spatial_diagnostics() {
     // each record is saved to a new file, so we can close this one
     m_spatial_file->close();
     m_spatial_file = nullptr;
+
+    if (m_spatial_coarse_file != nullptr) {
+      m_spatial_coarse_file->close();
+      m_spatial_coarse_file = nullptr;
+    }
+
+    if (m_spatial_window_file != nullptr) {
+      m_spatial_window_file->close();
+      m_spatial_window_file = nullptr;
+    }
   }
 
   m_last_spatial_time = current_time;
@@ -385,4 +501,473 @@ void IceModel::write_spatial_diagnostics() {
   }
 }
 
+//! Copy the attributes of `source` to `destination` without touching grid information.
+static void copy_attributes(const VariableMetadata &source, VariableMetadata &destination) {
+  for (const auto &s : source.all_strings()) {
+    destination.set_string(s.first, s.second);
+  }
+  for (const auto &d : source.all_doubles()) {
+    destination.set_numbers(d.first, d.second);
+  }
+  destination.set_time_dependent(source.get_time_dependent());
+  destination.set_output_type(source.get_output_type());
+}
+
+//! Average `input` over blocks of `factor` by `factor` cells of the model grid.
+/*!
+  Each rank accumulates block sums over its part of the model grid; the sums are then
+  combined using one all-reduce of the size of the *output* grid, i.e. `factor^2` times
+  smaller than `input`.
+ */
+static void block_average(const array::Scalar &input, unsigned int factor,
+                          array::Scalar &output) {
+  auto fine   = input.grid();
+  auto coarse = output.grid();
+
+  const int N   = (int)factor;
+  const int Mxc = (int)coarse->Mx();
+  const int Myc = (int)coarse->My();
+
+  std::vector<double> sum((size_t)Mxc * (size_t)Myc, 0.0);
+  std::vector<double> total(sum.size());
+
+  {
+    array::AccessScope list{ &input };
+    for (auto p : fine->points()) {
+      const int i = p.i(), j = p.j();
+
+      sum[(size_t)(j / N) * (size_t)Mxc + (size_t)(i / N)] += input(i, j);
+    }
+  }
+
+  GlobalSum(fine->com, sum.data(), total.data(), (int)total.size());
+
+  {
+    array::AccessScope list{ &output };
+    for (auto p : coarse->points()) {
+      const int i = p.i(), j = p.j();
+
+      // blocks in the last row and column may contain fewer than factor^2 cells
+      int nx = std::min((i + 1) * N, (int)fine->Mx()) - i * N;
+      int ny = std::min((j + 1) * N, (int)fine->My()) - j * N;
+
+      output(i, j) = total[(size_t)j * (size_t)Mxc + (size_t)i] / (nx * ny);
+    }
+  }
+}
+
+//! Initialize decimated ("adaptive resolution") spatial time-series output.
+/*!
+  High-resolution simulations often save many variables that are analyzed at a much
+  coarser resolution than the model grid. Variables listed in
+  output.spatial.decimation.vars are removed from the full-resolution spatial
+  time-series file and written, block-averaged by output.spatial.decimation.factor in
+  each horizontal direction, to a companion file (the spatial time-series file name with
+  the "_decimated" suffix). This reduces the volume and the writing cost of these
+  variables by a factor of about factor^2.
+
+  Block averaging is conservative: every cell of the model grid contributes to exactly
+  one cell of the output grid and all cells have the same area. It treats all values
+  alike, though, so variables using a fill value should be kept at full resolution. Only
+  scalar (one degree of freedom) 2D variables can be decimated.
+ */
+void IceModel::init_spatial_decimation() {
+
+  m_spatial_decimation_factor = 1;
+  m_spatial_decimated_vars.clear();
+  m_spatial_coarse_file_contents.clear();
+  m_spatial_coarse_grid    = nullptr;
+  m_spatial_coarse_scratch = nullptr;
+  m_spatial_coarse_writer  = nullptr;
+  m_spatial_coarse_file    = nullptr;
+
+  auto factor = (unsigned int)m_config->get_number("output.spatial.decimation.factor");
+  auto vars   = m_config->get_string("output.spatial.decimation.vars");
+
+  if (vars.empty()) {
+    return;
+  }
+
+  if (factor < 2) {
+    throw RuntimeError(PISM_ERROR_LOCATION,
+                       "output.spatial.decimation.vars is set but "
+                       "output.spatial.decimation.factor is less than 2");
+  }
+
+  if (m_spatial_vars.empty()) {
+    throw RuntimeError(PISM_ERROR_LOCATION,
+                       "output.spatial.decimation.vars requires an explicit list of "
+                       "variables in output.spatial.vars");
+  }
+
+  m_spatial_decimation_factor = factor;
+  m_spatial_decimated_vars    = set_split(vars, ',');
+
+  // decimated variables are written to the companion file *instead of* the main one
+  for (const auto &v : m_spatial_decimated_vars) {
+    if (m_spatial_vars.find(v) == m_spatial_vars.end()) {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                    "cannot decimate '%s': it is not in output.spatial.vars",
+                                    v.c_str());
+    }
+    m_spatial_vars.erase(v);
+  }
+
+  // the output grid: the model grid block-averaged factor x factor
+  {
+    unsigned int N  = factor;
+    unsigned int Mx = (m_grid->Mx() + N - 1) / N;
+    unsigned int My = (m_grid->My() + N - 1) / N;
+
+    // Pad the domain on the right so that the coordinates of an output grid point
+    // coincide with the center of the corresponding block of the model grid even if N
+    // does not divide the model grid size.
+    double Lx    = 0.5 * (Mx * N) * m_grid->dx();
+    double Ly    = 0.5 * (My * N) * m_grid->dy();
+    double x_min = m_grid->x(0) - 0.5 * m_grid->dx();
+    double y_min = m_grid->y(0) - 0.5 * m_grid->dy();
+
+    m_spatial_coarse_grid = Grid::Shallow(m_grid->ctx(), Lx, Ly, x_min + Lx, y_min + Ly,
+                                          Mx, My, grid::CELL_CENTER, grid::NOT_PERIODIC);
+
+    m_spatial_coarse_scratch = std::make_shared<array::Scalar>(m_spatial_coarse_grid,
+                                                               "decimation_scratch");
+  }
+
+  // metadata of decimated variables on the output grid
+  for (const auto &v : m_spatial_decimated_vars) {
+    auto diag = m_available_spatial_diagnostics.find(v);
+
+    if (diag == m_available_spatial_diagnostics.end()) {
+      // mirror write_diagnostics(): missing variables are reported by
+      // deallocate_unused_diagnostics()
+      continue;
+    }
+
+    const auto &D = diag->second;
+    if (D->n_variables() != 1 or D->metadata(0).n_spatial_dimensions() != 2) {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                    "cannot decimate '%s': only scalar 2D variables can "
+                                    "be decimated", v.c_str());
+    }
+
+    VariableMetadata metadata(m_sys, D->metadata(0).get_name(), *m_spatial_coarse_grid);
+    copy_attributes(D->metadata(0), metadata);
+
+    m_spatial_coarse_file_contents.insert(metadata);
+  }
+  m_spatial_coarse_file_contents = pism::combine(m_spatial_coarse_file_contents,
+                                                 common_metadata());
+
+  m_log->message(2, "  variables decimated %d-fold and saved separately: %s\n",
+                 (int)factor, vars.c_str());
+}
+
+//! Write spatial time-series variables decimated to the coarser output grid.
+/*!
+  Called by write_spatial_diagnostics(); see init_spatial_decimation() for details.
+ */
+void IceModel::write_decimated_diagnostics(double current_time) {
+  bool split = m_config->get_flag("output.spatial.split");
+
+  if (m_spatial_coarse_file == nullptr) {
+    std::string filename;
+    if (split) {
+      auto date_without_spaces = replace_character(m_time->date(m_time->current()), ' ', '_');
+      filename = pism::printf("%s_decimated_%s.nc", m_spatial_filename.c_str(),
+                              date_without_spaces.c_str());
+    } else {
+      filename = filename_add_suffix(m_spatial_filename, "_decimated", "");
+    }
+
+    m_spatial_coarse_file.reset(new OutputFile(m_spatial_coarse_writer, filename));
+
+    if (m_config->get_flag("output.spatial.append")) {
+      m_spatial_coarse_file->append();
+    } else {
+      bool with_time_bounds = true;
+      define_time(*m_spatial_coarse_file, with_time_bounds);
+      define_variables(*m_spatial_coarse_file, m_spatial_coarse_file_contents);
+    }
+
+    // one copy of the configuration per file is enough (see init_spatial_diagnostics())
+    io::write_config(*m_config, "pism_config", *m_spatial_coarse_file);
+  }
+
+  // use the mid-point of the current reporting interval (as in the main file)
+  m_spatial_coarse_file->append_time(0.5 * (m_last_spatial_time + current_time));
+
+  for (const auto &v : m_spatial_decimated_vars) {
+    auto diag = m_available_spatial_diagnostics.find(v);
+
+    if (diag == m_available_spatial_diagnostics.end()) {
+      continue;
+    }
+
+    auto field = std::dynamic_pointer_cast<array::Scalar>(diag->second->compute());
+    if (field == nullptr) {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                    "cannot decimate '%s': not a scalar 2D field",
+                                    v.c_str());
+    }
+
+    // install the metadata prepared in init_spatial_decimation()
+    for (const auto &m : m_spatial_coarse_file_contents) {
+      if (m.get_name() == diag->second->metadata(0).get_name()) {
+        m_spatial_coarse_scratch->metadata(0) = m;
+        break;
+      }
+    }
+
+    block_average(*field, m_spatial_decimation_factor, *m_spatial_coarse_scratch);
+
+    m_spatial_coarse_scratch->write(*m_spatial_coarse_file);
+  }
+
+  // write time bounds
+  {
+    auto time_length = m_spatial_coarse_file->time_dimension_length();
+    auto time_start  = time_length > 0 ? (time_length - 1) : 0;
+
+    auto bounds_name = m_time->variable_name() + "_bounds";
+
+    m_spatial_coarse_file->write_array(bounds_name, { time_start, 0 }, { 1, 2 },
+                                       { m_last_spatial_time, current_time });
+  }
+
+  write_run_stats(*m_spatial_coarse_file);
+}
+
+//! Extract the part of the model grid starting at (`i0`, `j0`) with the size of
+//! `output`'s grid.
+/*!
+  Same communication pattern as in block_average(): each rank fills in the part of the
+  window it owns and one all-reduce of the size of the *window* combines the parts.
+ */
+static void copy_window(const array::Scalar &input, int i0, int j0, array::Scalar &output) {
+  auto fine   = input.grid();
+  auto window = output.grid();
+
+  const int Mxw = (int)window->Mx();
+  const int Myw = (int)window->My();
+
+  std::vector<double> part((size_t)Mxw * (size_t)Myw, 0.0);
+  std::vector<double> total(part.size());
+
+  {
+    array::AccessScope list{ &input };
+    for (auto p : fine->points()) {
+      const int i = p.i(), j = p.j();
+
+      if (i >= i0 and i < i0 + Mxw and j >= j0 and j < j0 + Myw) {
+        part[(size_t)(j - j0) * (size_t)Mxw + (size_t)(i - i0)] = input(i, j);
+      }
+    }
+  }
+
+  GlobalSum(fine->com, part.data(), total.data(), (int)total.size());
+
+  {
+    array::AccessScope list{ &output };
+    for (auto p : window->points()) {
+      const int i = p.i(), j = p.j();
+
+      output(i, j) = total[(size_t)j * (size_t)Mxw + (size_t)i];
+    }
+  }
+}
+
+//! Initialize region-of-interest ("window") spatial time-series output.
+/*!
+  Process studies (e.g. of one outlet glacier) often need high-frequency output over a
+  small part of the modeled domain. Variables listed in output.spatial.window.vars are
+  removed from the full-domain spatial time-series file and written, at the model
+  resolution but restricted to the index range output.spatial.window.{i,j}_{min,max} of
+  the model grid, to a companion file (the spatial time-series file name with the
+  "_window" suffix). This way daily output of a small window does not require
+  full-domain writes.
+
+  The window is fixed for the duration of a run: a NetCDF variable cannot change its
+  coordinates from one record to the next. To follow a moving feature, split the
+  simulation into several runs.
+
+  A variable may appear in both output.spatial.window.vars and
+  output.spatial.decimation.vars; then the companion files contain the full-resolution
+  window and the decimated full domain, respectively. Only scalar 2D variables are
+  supported (see init_spatial_decimation()).
+ */
+void IceModel::init_spatial_window() {
+
+  m_spatial_window_vars.clear();
+  m_spatial_window_file_contents.clear();
+  m_spatial_window_grid    = nullptr;
+  m_spatial_window_scratch = nullptr;
+  m_spatial_window_writer  = nullptr;
+  m_spatial_window_file    = nullptr;
+  m_spatial_window_i0      = 0;
+  m_spatial_window_j0      = 0;
+
+  auto vars = m_config->get_string("output.spatial.window.vars");
+
+  if (vars.empty()) {
+    return;
+  }
+
+  int i_min = (int)m_config->get_number("output.spatial.window.i_min");
+  int i_max = (int)m_config->get_number("output.spatial.window.i_max");
+  int j_min = (int)m_config->get_number("output.spatial.window.j_min");
+  int j_max = (int)m_config->get_number("output.spatial.window.j_max");
+
+  if (i_min >= i_max or j_min >= j_max or
+      i_max >= (int)m_grid->Mx() or j_max >= (int)m_grid->My()) {
+    throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                  "invalid output window i=[%d, %d], j=[%d, %d]"
+                                  " (the grid is %d x %d points)",
+                                  i_min, i_max, j_min, j_max,
+                                  (int)m_grid->Mx(), (int)m_grid->My());
+  }
+
+  if (m_spatial_vars.empty() and m_spatial_decimated_vars.empty()) {
+    throw RuntimeError(PISM_ERROR_LOCATION,
+                       "output.spatial.window.vars requires an explicit list of "
+                       "variables in output.spatial.vars");
+  }
+
+  m_spatial_window_vars = set_split(vars, ',');
+
+  // windowed variables are written to the companion file *instead of* the main one
+  for (const auto &v : m_spatial_window_vars) {
+    if (m_spatial_vars.find(v) != m_spatial_vars.end()) {
+      m_spatial_vars.erase(v);
+    } else if (m_spatial_decimated_vars.find(v) == m_spatial_decimated_vars.end()) {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                    "cannot window '%s': it is not in output.spatial.vars",
+                                    v.c_str());
+    }
+  }
+
+  // the output grid: the model grid restricted to the requested index range (inclusive)
+  {
+    unsigned int Mx = (unsigned int)(i_max - i_min + 1);
+    unsigned int My = (unsigned int)(j_max - j_min + 1);
+
+    double Lx    = 0.5 * Mx * m_grid->dx();
+    double Ly    = 0.5 * My * m_grid->dy();
+    double x_min = m_grid->x((size_t)i_min) - 0.5 * m_grid->dx();
+    double y_min = m_grid->y((size_t)j_min) - 0.5 * m_grid->dy();
+
+    m_spatial_window_grid = Grid::Shallow(m_grid->ctx(), Lx, Ly, x_min + Lx, y_min + Ly,
+                                          Mx, My, grid::CELL_CENTER, grid::NOT_PERIODIC);
+
+    m_spatial_window_scratch = std::make_shared<array::Scalar>(m_spatial_window_grid,
+                                                               "window_scratch");
+
+    m_spatial_window_i0 = i_min;
+    m_spatial_window_j0 = j_min;
+  }
+
+  // metadata of windowed variables on the output grid
+  for (const auto &v : m_spatial_window_vars) {
+    auto diag = m_available_spatial_diagnostics.find(v);
+
+    if (diag == m_available_spatial_diagnostics.end()) {
+      // mirror write_diagnostics(): missing variables are reported by
+      // deallocate_unused_diagnostics()
+      continue;
+    }
+
+    const auto &D = diag->second;
+    if (D->n_variables() != 1 or D->metadata(0).n_spatial_dimensions() != 2) {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                    "cannot window '%s': only scalar 2D variables can "
+                                    "be windowed", v.c_str());
+    }
+
+    VariableMetadata metadata(m_sys, D->metadata(0).get_name(), *m_spatial_window_grid);
+    copy_attributes(D->metadata(0), metadata);
+
+    m_spatial_window_file_contents.insert(metadata);
+  }
+  m_spatial_window_file_contents = pism::combine(m_spatial_window_file_contents,
+                                                 common_metadata());
+
+  m_log->message(2, "  variables restricted to i=[%d, %d], j=[%d, %d] and saved separately: %s\n",
+                 i_min, i_max, j_min, j_max, vars.c_str());
+}
+
+//! Write spatial time-series variables restricted to the output window.
+/*!
+  Called by write_spatial_diagnostics(); see init_spatial_window() for details.
+ */
+void IceModel::write_window_diagnostics(double current_time) {
+  bool split = m_config->get_flag("output.spatial.split");
+
+  if (m_spatial_window_file == nullptr) {
+    std::string filename;
+    if (split) {
+      auto date_without_spaces = replace_character(m_time->date(m_time->current()), ' ', '_');
+      filename = pism::printf("%s_window_%s.nc", m_spatial_filename.c_str(),
+                              date_without_spaces.c_str());
+    } else {
+      filename = filename_add_suffix(m_spatial_filename, "_window", "");
+    }
+
+    m_spatial_window_file.reset(new OutputFile(m_spatial_window_writer, filename));
+
+    if (m_config->get_flag("output.spatial.append")) {
+      m_spatial_window_file->append();
+    } else {
+      bool with_time_bounds = true;
+      define_time(*m_spatial_window_file, with_time_bounds);
+      define_variables(*m_spatial_window_file, m_spatial_window_file_contents);
+    }
+
+    // one copy of the configuration per file is enough (see init_spatial_diagnostics())
+    io::write_config(*m_config, "pism_config", *m_spatial_window_file);
+  }
+
+  // use the mid-point of the current reporting interval (as in the main file)
+  m_spatial_window_file->append_time(0.5 * (m_last_spatial_time + current_time));
+
+  for (const auto &v : m_spatial_window_vars) {
+    auto diag = m_available_spatial_diagnostics.find(v);
+
+    if (diag == m_available_spatial_diagnostics.end()) {
+      continue;
+    }
+
+    auto field = std::dynamic_pointer_cast<array::Scalar>(diag->second->compute());
+    if (field == nullptr) {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                    "cannot window '%s': not a scalar 2D field",
+                                    v.c_str());
+    }
+
+    // install the metadata prepared in init_spatial_window()
+    for (const auto &m : m_spatial_window_file_contents) {
+      if (m.get_name() == diag->second->metadata(0).get_name()) {
+        m_spatial_window_scratch->metadata(0) = m;
+        break;
+      }
+    }
+
+    copy_window(*field, m_spatial_window_i0, m_spatial_window_j0, *m_spatial_window_scratch);
+
+    m_spatial_window_scratch->write(*m_spatial_window_file);
+  }
+
+  // write time bounds
+  {
+    auto time_length = m_spatial_window_file->time_dimension_length();
+    auto time_start  = time_length > 0 ? (time_length - 1) : 0;
+
+    auto bounds_name = m_time->variable_name() + "_bounds";
+
+    m_spatial_window_file->write_array(bounds_name, { time_start, 0 }, { 1, 2 },
+                                       { m_last_spatial_time, current_time });
+  }
+
+  write_run_stats(*m_spatial_window_file);
+}
+
 } // end of namespace pism
@@ -21,6 +21,8 @@
 #include <cassert>
 
 #include "pism/icemodel/IceModel.hh"
+#include "pism/energy/EnergyModel.hh"
+#include "pism/energy/utilities.hh" // energy::total_ice_enthalpy()
 #include "pism/util/Grid.hh"
 #include "pism/util/Config.hh"
 #include "pism/util/Time.hh"
@@ -55,6 +57,16 @@ MaxTimestep IceModel::max_timestep_diffusivity() {
 
   auto dt_diffusivity = ::pism::max_timestep_diffusivity(D_max, dx, dy, adaptive_timestepping_ratio);
 
+  // Optionally exceed the conservative a-priori bound; see
+  // time_stepping.speculative.enabled. GeometryEvolution::flow_step() checks a-posteriori
+  // stability indicators and re-does the transport update using shorter sub-steps if the
+  // longer step turns out to be too aggressive.
+  if (dt_diffusivity.finite() and m_config->get_flag("time_stepping.speculative.enabled")) {
+    dt_diffusivity = MaxTimestep(dt_diffusivity.value() *
+                                 m_config->get_number("time_stepping.speculative.factor"),
+                                 dt_diffusivity.description());
+  }
+
   MaxTimestep dt_max(m_config->get_number("time_stepping.maximum_time_step", "seconds"),
                      "max time step");
 
@@ -78,7 +90,22 @@ unsigned int IceModel::skip_counter(double dt, double dt_diffusivity) {
     return 0;
   }
 
-  const int skip_max = static_cast<int>(m_config->get_number("time_stepping.skip.max"));
+  int skip_max = static_cast<int>(m_config->get_number("time_stepping.skip.max"));
+
+  // Near steady state the monitor (see update_steady_state_monitor()) lets us stretch
+  // the cadence of the energy, age, SSA, and (optionally) hydrology computations beyond
+  // time_stepping.skip.max, up to the bound set by
+  // time_stepping.steady_state.skip_multiplier.
+  if (m_config->get_flag("time_stepping.steady_state.enabled")) {
+    const int
+      multiplier_max = static_cast<int>(m_config->get_number("time_stepping.steady_state.skip_multiplier")),
+      steps          = static_cast<int>(m_config->get_number("time_stepping.steady_state.steps"));
+
+    int multiplier = 1 + std::min(static_cast<int>(m_steady_state_counter) / steps,
+                                  multiplier_max - 1);
+
+    skip_max *= multiplier;
+  }
 
   if (dt_diffusivity > 0.0) {
     const double conservative_factor = 0.95;
@@ -89,6 +116,64 @@ unsigned int IceModel::skip_counter(double dt, double dt_diffusivity) {
   return skip_max;
 }
 
+//! Update the steady-state monitor.
+/*!
+ * Called at the end of every energy ("at depth") step when
+ * time_stepping.steady_state.enabled is set.
+ *
+ * Long spin-ups spend most of their time in near-steady state, where computing energy,
+ * age, SSA, and hydrology at the full cadence is wasted effort. This monitor samples the
+ * total ice volume, the total ice enthalpy, and the maximum horizontal ice speed (the
+ * quantities behind the corresponding scalar diagnostics) and compares their relative
+ * rates of change to time_stepping.steady_state.rtol. While all three rates stay below
+ * the threshold, skip_counter() gradually stretches the skip cadence, up to
+ * time_stepping.steady_state.skip_multiplier times time_stepping.skip.max; the first
+ * sign of a transient resets the cadence to time_stepping.skip.max.
+ *
+ * The volume and enthalpy reductions are cheap compared to an energy step and the
+ * maximum speed is cached by the stress balance, so the monitor adds no extra grid
+ * passes on skipped steps.
+ */
+void IceModel::update_steady_state_monitor() {
+  if (not m_config->get_flag("time_stepping.steady_state.enabled")) {
+    return;
+  }
+
+  const double
+    time     = m_time->current(),
+    volume   = ice_volume(m_geometry, 0.0),
+    enthalpy = energy::total_ice_enthalpy(0.0, m_energy_model->enthalpy(),
+                                          m_geometry.ice_thickness);
+
+  auto cfl = m_stress_balance->max_timestep_cfl_2d();
+  const double speed = std::max(cfl.u_max, cfl.v_max);
+
+  if (not std::isnan(m_steady_state_time)) {
+    const double
+      dt   = time - m_steady_state_time,
+      rtol = m_config->get_number("time_stepping.steady_state.rtol", "second-1");
+
+    auto relative_rate = [dt](double old_value, double new_value) {
+      double scale = std::max(std::fabs(old_value), 1e-16);
+      return std::fabs(new_value - old_value) / (scale * dt);
+    };
+
+    if (dt > 0.0 and
+        relative_rate(m_steady_state_volume, volume) < rtol and
+        relative_rate(m_steady_state_enthalpy, enthalpy) < rtol and
+        relative_rate(m_steady_state_speed, speed) < rtol) {
+      m_steady_state_counter++;
+    } else {
+      m_steady_state_counter = 0;
+    }
+  }
+
+  m_steady_state_time     = time;
+  m_steady_state_volume   = volume;
+  m_steady_state_enthalpy = enthalpy;
+  m_steady_state_speed    = speed;
+}
+
 //! Use various stability criteria to determine the time step for an evolution run.
 /*!
 The main loop in run() approximates many physical processes.  Several of these approximations,
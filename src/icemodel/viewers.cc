@@ -59,6 +59,25 @@ void IceModel::update_viewers() {
 
   auto viewers = set_split(m_config->get_string("output.runtime.viewer.variables"), ',');
 
+  if (viewers.empty()) {
+    return;
+  }
+
+  // Throttle redraws to at most one per output.runtime.viewer.throttle seconds of wall
+  // clock time so that viewers can stay enabled in production runs without slowing down
+  // every step. Ranks have to agree on whether to redraw (drawing is collective), so we
+  // use get_time(), which broadcasts rank 0's clock.
+  double throttle = m_config->get_number("output.runtime.viewer.throttle");
+  if (throttle > 0.0) {
+    double now = get_time(m_grid->com);
+
+    if (m_last_viewer_time >= 0.0 and now - m_last_viewer_time < throttle) {
+      return;
+    }
+
+    m_last_viewer_time = now;
+  }
+
   // map-plane viewers
   for (const auto& v : viewers) {
     if (m_grid->variables().is_available(v)) {
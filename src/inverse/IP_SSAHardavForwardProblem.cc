@@ -21,6 +21,7 @@
 #include "pism/util/Config.hh"
 #include "pism/util/Vars.hh"
 #include "pism/util/error_handling.hh"
+#include "pism/util/pism_utilities.hh"
 #include "pism/rheology/FlowLaw.hh"
 #include "pism/geometry/Geometry.hh"
 #include "pism/stressbalance/StressBalance.hh"
@@ -46,7 +47,9 @@ IP_SSAHardavForwardProblem::IP_SSAHardavForwardProblem(std::shared_ptr<const Gri
     m_hardav(m_grid, "hardav"),
     m_element_index(*m_grid),
     m_element(*m_grid, fem::Q1Quadrature4()),
-    m_rebuild_J_state(true)
+    m_rebuild_J_state(true),
+    m_zeta_prev(m_grid, "zeta_prev"),
+    m_zeta_prev_valid(false)
 {
 
   PetscErrorCode ierr;
@@ -155,16 +158,60 @@ void IP_SSAHardavForwardProblem::set_design(array::Scalar &new_zeta) {
     m_coefficients(i, j).hardness = m_hardav(i, j);
   }
 
+  // Re-compute cached coefficient values at quadrature points.
+  cache_quadrature_values();
+
   // Flag the state jacobian as needing rebuilding.
   m_rebuild_J_state = true;
+
+  // The linearization cached by linearize_at() corresponds to a different design now.
+  m_zeta_prev_valid = false;
+}
+
+//! Returns true if `zeta` coincides with the design used by the last successful linearize_at() call.
+/*! Uses an exact comparison: the goal is to recognize iterates that a line search
+revisits bit-for-bit, not designs that are merely close. The result is the same on all
+processors. */
+bool IP_SSAHardavForwardProblem::design_unchanged(const array::Scalar &zeta) {
+  int differs = 0;
+
+  array::AccessScope list{&zeta, &m_zeta_prev};
+
+  for (auto p : m_grid->points()) {
+    const int i = p.i(), j = p.j();
+    if (zeta(i, j) != m_zeta_prev(i, j)) {
+      differs = 1;
+    }
+  }
+
+  return GlobalMax(m_grid->com, differs) == 0;
 }
 
 //! Sets the current value of the design variable \f$\zeta\f$ and solves the %SSA to find the associated \f$u_{\rm SSA}\f$.
 /* Use this method for inverse methods employing the reduced gradient. Use this method
-in conjuction with apply_linearization and apply_linearization_transpose.*/
+in conjuction with apply_linearization and apply_linearization_transpose.
+
+TAO line searches routinely re-evaluate the forward model at a design it has already
+visited (for example, the accepted iterate at the end of a line search). If `zeta` is
+identical to the design used by the last successful call, the cached solution and
+quadrature values are still current and the nonlinear solve is skipped. Otherwise the
+SNES solve starts from the velocity computed at the previous iterate, which is the
+natural warm start for the slowly-varying designs visited during an inversion. */
 std::shared_ptr<TerminationReason> IP_SSAHardavForwardProblem::linearize_at(array::Scalar &zeta) {
+  if (m_zeta_prev_valid and this->design_unchanged(zeta)) {
+    return GenericTerminationReason::success();
+  }
+
   this->set_design(zeta);
-  return this->solve_nocache();
+
+  auto reason = this->solve_nocache();
+
+  m_zeta_prev_valid = not reason->failed();
+  if (m_zeta_prev_valid) {
+    m_zeta_prev.copy_from(zeta);
+  }
+
+  return reason;
 }
 
 //! Computes the residual function \f$\mathcal{R}(u, \zeta)\f$ as defined in the class-level documentation.
@@ -320,10 +367,11 @@ void IP_SSAHardavForwardProblem::apply_jacobian_design(array::Vector &u,
         // fix dirichlet values, and compute values at quad pts.
         m_element.nodal_values(u.array(), u_e);
         if (dirichletBC) {
-          dirichletBC.constrain(m_element);
-          dirichletBC.enforce(m_element, u_e);
+          dirichletBC.enforce_and_constrain(m_element, u_e);
         }
-        m_element.evaluate(u_e, U, U_x, U_y);
+        // The quadrature is fixed by the constructor (Q1Quadrature4), so the sizes are
+        // compile-time constants here and the evaluation loops fully unroll.
+        m_element.evaluate<4, Nk>(u_e, U, U_x, U_y);
 
         // Compute dzeta at the nodes
         m_element.nodal_values(dzeta_local->array(), dzeta_e);
@@ -337,7 +385,7 @@ void IP_SSAHardavForwardProblem::apply_jacobian_design(array::Vector &u,
           m_design_param.toDesignVariable(zeta_e[k], NULL, dB_e + k);
           dB_e[k]*=dzeta_e[k];
         }
-        m_element.evaluate(dB_e, dB_q);
+        m_element.evaluate<4, Nk>(dB_e, dB_q);
 
         double thickness[Nq_max];
         {
@@ -491,13 +539,14 @@ void IP_SSAHardavForwardProblem::apply_jacobian_design_transpose(array::Vector &
         if (dirichletBC) {
           dirichletBC.enforce_homogeneous(m_element, du_e);
         }
-        m_element.evaluate(du_e, du_q, du_dx_q, du_dy_q);
+        // see apply_jacobian_design(): the sizes are compile-time constants here
+        m_element.evaluate<4, Nk>(du_e, du_q, du_dx_q, du_dy_q);
 
         m_element.nodal_values(u.array(), u_e);
         if (dirichletBC) {
           dirichletBC.enforce(m_element, u_e);
         }
-        m_element.evaluate(u_e, U, U_x, U_y);
+        m_element.evaluate<4, Nk>(u_e, U, U_x, U_y);
 
         // Zero out the element-local residual in prep for updating it.
         for (unsigned int k = 0; k < Nk; k++) {
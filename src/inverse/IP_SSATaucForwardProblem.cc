@@ -22,6 +22,7 @@
 #include "pism/util/Mask.hh"
 #include "pism/util/Vars.hh"
 #include "pism/util/error_handling.hh"
+#include "pism/util/pism_utilities.hh"
 #include "pism/geometry/Geometry.hh"
 #include "pism/stressbalance/StressBalance.hh"
 #include "pism/util/petscwrappers/DM.hh"
@@ -45,7 +46,9 @@ IP_SSATaucForwardProblem::IP_SSATaucForwardProblem(std::shared_ptr<const Grid> g
     m_du_local(m_grid, "linearization work vector (with ghosts)"),
     m_element_index(*m_grid),
     m_element(*m_grid, fem::Q1Quadrature4()),
-    m_rebuild_J_state(true)
+    m_rebuild_J_state(true),
+    m_zeta_prev(m_grid, "zeta_prev"),
+    m_zeta_prev_valid(false)
 {
 
   PetscErrorCode ierr;
@@ -161,16 +164,60 @@ void IP_SSATaucForwardProblem::set_design(array::Scalar &new_zeta) {
     m_coefficients(i, j).tauc = tauc(i, j);
   }
 
+  // Re-compute cached coefficient values at quadrature points.
+  cache_quadrature_values();
+
   // Flag the state jacobian as needing rebuilding.
   m_rebuild_J_state = true;
+
+  // The linearization cached by linearize_at() corresponds to a different design now.
+  m_zeta_prev_valid = false;
+}
+
+//! Returns true if `zeta` coincides with the design used by the last successful linearize_at() call.
+/*! Uses an exact comparison: the goal is to recognize iterates that a line search
+revisits bit-for-bit, not designs that are merely close. The result is the same on all
+processors. */
+bool IP_SSATaucForwardProblem::design_unchanged(const array::Scalar &zeta) {
+  int differs = 0;
+
+  array::AccessScope list{&zeta, &m_zeta_prev};
+
+  for (auto p : m_grid->points()) {
+    const int i = p.i(), j = p.j();
+    if (zeta(i, j) != m_zeta_prev(i, j)) {
+      differs = 1;
+    }
+  }
+
+  return GlobalMax(m_grid->com, differs) == 0;
 }
 
 //! Sets the current value of the design variable \f$\zeta\f$ and solves the %SSA to find the associated \f$u_{\rm SSA}\f$.
 /* Use this method for inverse methods employing the reduced gradient. Use this method
-in conjuction with apply_linearization and apply_linearization_transpose.*/
+in conjuction with apply_linearization and apply_linearization_transpose.
+
+TAO line searches routinely re-evaluate the forward model at a design it has already
+visited (for example, the accepted iterate at the end of a line search). If `zeta` is
+identical to the design used by the last successful call, the cached solution and
+quadrature values are still current and the nonlinear solve is skipped. Otherwise the
+SNES solve starts from the velocity computed at the previous iterate, which is the
+natural warm start for the slowly-varying designs visited during an inversion. */
 std::shared_ptr<TerminationReason> IP_SSATaucForwardProblem::linearize_at(array::Scalar &zeta) {
+  if (m_zeta_prev_valid and this->design_unchanged(zeta)) {
+    return GenericTerminationReason::success();
+  }
+
   this->set_design(zeta);
-  return this->solve_nocache();
+
+  auto reason = this->solve_nocache();
+
+  m_zeta_prev_valid = not reason->failed();
+  if (m_zeta_prev_valid) {
+    m_zeta_prev.copy_from(zeta);
+  }
+
+  return reason;
 }
 
 //! Computes the residual function \f$\mathcal{R}(u, \zeta)\f$ as defined in the class-level documentation.
@@ -311,10 +358,11 @@ void IP_SSATaucForwardProblem::apply_jacobian_design(array::Vector &u,
         // fix dirichlet values, and compute values at quad pts.
         m_element.nodal_values(u.array(), u_e);
         if (dirichletBC) {
-          dirichletBC.constrain(m_element);
-          dirichletBC.enforce(m_element, u_e);
+          dirichletBC.enforce_and_constrain(m_element, u_e);
         }
-        m_element.evaluate(u_e, u_q);
+        // The quadrature is fixed by the constructor (Q1Quadrature4), so the sizes are
+        // compile-time constants here and the evaluation loops fully unroll.
+        m_element.evaluate<4, Nk>(u_e, u_q);
 
         // Compute dzeta at the nodes
         m_element.nodal_values(dzeta_local->array(), dzeta_e);
@@ -328,7 +376,7 @@ void IP_SSATaucForwardProblem::apply_jacobian_design(array::Vector &u,
           m_tauc_param.toDesignVariable(zeta_e[k], NULL, dtauc_e + k);
           dtauc_e[k] *= dzeta_e[k];
         }
-        m_element.evaluate(dtauc_e, dtauc_q);
+        m_element.evaluate<4, Nk>(dtauc_e, dtauc_q);
 
         int mask[Nq_max];
         {
@@ -467,13 +515,14 @@ void IP_SSATaucForwardProblem::apply_jacobian_design_transpose(array::Vector &u,
         if (dirichletBC) {
           dirichletBC.enforce_homogeneous(m_element, du_e);
         }
-        m_element.evaluate(du_e, du_q);
+        // see apply_jacobian_design(): the sizes are compile-time constants here
+        m_element.evaluate<4, Nk>(du_e, du_q);
 
         m_element.nodal_values(u.array(), u_e);
         if (dirichletBC) {
           dirichletBC.enforce(m_element, u_e);
         }
-        m_element.evaluate(u_e, u_q);
+        m_element.evaluate<4, Nk>(u_e, u_q);
 
         // Zero out the element-local residual in prep for updating it.
         for (unsigned int k=0; k<Nk; k++) {
@@ -552,15 +601,20 @@ void IP_SSATaucForwardProblem::apply_linearization(array::Scalar &dzeta, array::
   if (m_rebuild_J_state) {
     this->assemble_jacobian_state(m_velocity, m_J_state);
     m_rebuild_J_state = false;
+
+    // Re-setting the operators here (instead of before every solve) lets the KSP reuse
+    // the preconditioner set-up (e.g. the ILU factorization inside block Jacobi) for all
+    // incremental and adjoint solves at this linearization point. J_state is symmetric,
+    // so the transpose solve in apply_linearization_transpose() uses the same operator.
+    ierr = KSPSetOperators(m_ksp, m_J_state, m_J_state);
+    PISM_CHK(ierr, "KSPSetOperators");
   }
 
   this->apply_jacobian_design(m_velocity, dzeta, m_du_global);
   m_du_global.scale(-1);
 
-  // call PETSc to solve linear system by iterative method.
-  ierr = KSPSetOperators(m_ksp, m_J_state, m_J_state);
-  PISM_CHK(ierr, "KSPSetOperators");
-
+  // call PETSc to solve linear system by iterative method; the operator and the
+  // preconditioner are cached by m_ksp (see above).
   ierr = KSPSolve(m_ksp, m_du_global.vec(), m_du_global.vec());
   PISM_CHK(ierr, "KSPSolve"); // SOLVE
 
@@ -607,6 +661,11 @@ void IP_SSATaucForwardProblem::apply_linearization_transpose(array::Vector &du,
   if (m_rebuild_J_state) {
     this->assemble_jacobian_state(m_velocity, m_J_state);
     m_rebuild_J_state = false;
+
+    // See the comment in apply_linearization(): setting the operators once per
+    // reassembly allows the KSP to keep its preconditioner between solves.
+    ierr = KSPSetOperators(m_ksp, m_J_state, m_J_state);
+    PISM_CHK(ierr, "KSPSetOperators");
   }
 
   // Aliases to help with notation consistency below.
@@ -623,10 +682,8 @@ void IP_SSATaucForwardProblem::apply_linearization_transpose(array::Vector &du,
     dirichletBC.fix_residual_homogeneous(m_du_global.array());
   }
 
-  // call PETSc to solve linear system by iterative method.
-  ierr = KSPSetOperators(m_ksp, m_J_state, m_J_state);
-  PISM_CHK(ierr, "KSPSetOperators");
-
+  // call PETSc to solve linear system by iterative method; the operator and the
+  // preconditioner were set when J_state was last assembled.
   ierr = KSPSolve(m_ksp, m_du_global.vec(), m_du_global.vec());
   PISM_CHK(ierr, "KSPSolve"); // SOLVE
 
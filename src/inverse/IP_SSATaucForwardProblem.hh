@@ -208,6 +208,15 @@ protected:
 
   /// Flag indicating that the state jacobian matrix needs rebuilding.
   bool m_rebuild_J_state;
+
+  /// Returns true if `zeta` coincides with the design used by the last successful
+  /// linearize_at() call.
+  bool design_unchanged(const array::Scalar &zeta);
+
+  /// Copy of the design variable used by the last successful linearize_at() call.
+  array::Scalar m_zeta_prev;
+  /// True if m_zeta_prev and the cached solve results are usable.
+  bool m_zeta_prev_valid;
 };
 
 } // end of namespace inverse
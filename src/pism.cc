@@ -33,8 +33,11 @@ static char help[] =
 #include "pism/util/Context.hh"
 #include "pism/util/Profiling.hh"
 #include "pism/util/error_handling.hh"
+#include "pism/util/io/io_helpers.hh"
+#include "pism/util/io/output_server.hh"
 #include "pism/util/petscwrappers/PetscInitializer.hh"
 #include "pism/util/pism_options.hh"
+#include "pism/util/pism_utilities.hh"
 #include "pism/util/EnthalpyConverter.hh"
 
 #include "pism/regional/IceRegionalModel.hh"
@@ -199,8 +202,47 @@ int main(int argc, char *argv[]) {
 
   com = PETSC_COMM_WORLD;
 
+  if (io::output_server_enabled() and io::is_output_server_rank()) {
+    // This is a reserved I/O rank (see the -io_server option): process output requests
+    // from computational ranks instead of setting up and running the model.
+    io::run_output_server();
+    return 0;
+  }
+
   int exit_code = 0;
   try {
+    // Ensemble mode: run several model instances ("members") side by side in one MPI
+    // job. All members share initialization input: member 0 reads it and broadcasts to
+    // the others (see io::set_input_fork()), so an N-member ensemble restarting from one
+    // spun-up state reads it once instead of N times.
+    int n_members = options::Integer("-ensemble", "number of ensemble members to run side by side", 1);
+
+    MPI_Comm member_com = com;
+    MPI_Comm peer_com   = MPI_COMM_NULL;
+    int member          = 0;
+
+    if (n_members > 1) {
+      int size = 0, rank = 0;
+      MPI_Comm_size(com, &size);
+      MPI_Comm_rank(com, &rank);
+
+      if (size % n_members != 0) {
+        throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                      "-ensemble %d requires a number of MPI ranks divisible by %d",
+                                      n_members, n_members);
+      }
+
+      int member_size = size / n_members;
+      member          = rank / member_size;
+
+      // the communicator this member's model instance runs on
+      MPI_Comm_split(com, member, rank, &member_com);
+      // connects the ranks owning one and the same sub-domain in all members (members
+      // use identical domain decompositions since they have the same size and options);
+      // used to broadcast input data read by member 0
+      MPI_Comm_split(com, rank % member_size, member, &peer_com);
+    }
+
     // Note: EISMINT II experiments G and H are not supported.
     auto eisII = options::Keyword("-eisII",
                                   "EISMINT II experiment name",
@@ -216,9 +258,9 @@ int main(int argc, char *argv[]) {
     std::shared_ptr<Context> ctx;
     if (verification_test.is_set()) {
       char test = verification_test.value()[0];
-      ctx = verification::context(com, "pism", test);
+      ctx = verification::context(member_com, "pism", test);
     } else {
-      ctx = context_from_options(com, "pism");
+      ctx = context_from_options(member_com, "pism");
     }
 
     auto log = ctx->log();
@@ -234,7 +276,7 @@ int main(int argc, char *argv[]) {
       options::String override_filename("-config_override", "Config override file name");
 
       if (override_filename.is_set()) {
-        overrides->read(com, override_filename);
+        overrides->read(member_com, override_filename);
         config->import_from(*overrides);
       }
 
@@ -254,6 +296,47 @@ int main(int argc, char *argv[]) {
                          "Configuration parameter 'input.file' cannot be empty");
     }
 
+    if (n_members > 1) {
+      // apply per-member configuration overrides, if given
+      options::String member_overrides("-ensemble_config_override",
+                                       "Per-member configuration override file name pattern "
+                                       "(printf-style; %d is replaced by the member index)");
+      if (member_overrides.is_set()) {
+        auto overrides = std::make_shared<NetCDFConfig>("pism_overrides", ctx->unit_system());
+        overrides->read(member_com, pism::printf(member_overrides.value().c_str(), member));
+        config->import_from(*overrides);
+        // command-line options override per-member settings
+        set_config_from_options(*config);
+        config->resolve_filenames();
+      }
+
+      // give each member its own output files
+      auto suffix = pism::printf("_member_%d", member);
+      for (const auto *key : { "output.file", "output.checkpoint.file", "output.scalar.file",
+                               "output.snapshot.file", "output.spatial.file" }) {
+        auto filename = config->get_string(key);
+        if (not filename.empty()) {
+          config->set_string(key, filename_add_suffix(filename, suffix, ""));
+        }
+      }
+
+      // reduce terminal noise: only the first member reports at the default level
+      if (member != 0) {
+        ctx->log()->set_threshold(1);
+      }
+    }
+
+    {
+      // copy the input file to fast node-local storage, if requested
+      auto staging_dir = config->get_string("input.staging_dir");
+      auto input_file  = config->get_string("input.file");
+      if (not (staging_dir.empty() or input_file.empty())) {
+        // use `com` (not `member_com`) so that ensemble members sharing a node share one
+        // copy
+        config->set_string("input.file", io::stage_input_file(com, input_file, staging_dir));
+      }
+    }
+
     print_config(*ctx->log(), 3, *config);
 
     std::string usage =
@@ -264,6 +347,8 @@ int main(int argc, char *argv[]) {
       "  -regional                  enable \"regional mode\"\n"
       "  -eisII [experiment]        enable EISMINT II mode\n"
       "  -test  [verification_test] enable verification mode\n"
+      "  -io_server N               reserve N MPI ranks that perform all file output\n"
+      "  -ensemble N                run N ensemble members side by side, sharing initialization input\n"
       "notes:\n"
       "  * option -i is required\n"
       "  * if -bootstrap is used then also '-Mx A -My B -Mz C -Lz D' are required\n";
@@ -277,10 +362,19 @@ int main(int argc, char *argv[]) {
     options::String profiling_log = options::String("-profile",
                                                     "Save detailed profiling data to a file.");
 
+    options::String trace_prefix =
+      options::String("-profile_trace",
+                      "Save a Chrome trace of profiling events and an across-rank summary "
+                      "(argument: output file name prefix).");
+
     if (profiling_log.is_set()) {
       ctx->profiling().start();
     }
 
+    if (trace_prefix.is_set()) {
+      ctx->profiling().trace_start();
+    }
+
     std::shared_ptr<Grid> grid;
     std::shared_ptr<IceModel> model;
     std::shared_ptr<IceCompModel> verification_model;
@@ -310,6 +404,13 @@ int main(int argc, char *argv[]) {
                                       "all,spatial,scalar,json",
                                       "all");
 
+    // Initialization reads are performed by member 0 and broadcast to the other members.
+    // The fork is disabled right after init(): reads performed while the model is
+    // stepping (e.g. of time-dependent forcing) are not synchronized across members.
+    if (peer_com != MPI_COMM_NULL) {
+      io::set_input_fork(peer_com);
+    }
+
     if (list_type.is_set()) {
       auto report = DIAG_NONE;
       auto value = list_type.value();
@@ -323,9 +424,11 @@ int main(int argc, char *argv[]) {
         report = DIAG_ALL;
       }
       model->init(report);
+      io::set_input_fork(MPI_COMM_NULL);
 
     } else {
       model->init(DIAG_NONE);
+      io::set_input_fork(MPI_COMM_NULL);
 
       auto termination_reason = model->run();
 
@@ -357,6 +460,10 @@ int main(int argc, char *argv[]) {
     if (profiling_log.is_set()) {
       ctx->profiling().report(profiling_log);
     }
+
+    if (trace_prefix.is_set()) {
+      ctx->profiling().trace_report(trace_prefix);
+    }
   }
   catch (...) {
     handle_fatal_errors(com);
@@ -0,0 +1,370 @@
+// Copyright (C) 2026 PISM Authors
+//
+// This file is part of PISM.
+//
+// PISM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the Free Software
+// Foundation; either version 3 of the License, or (at your option) any later
+// version.
+//
+// PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License
+// along with PISM; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+static char help[] =
+  "\nPISM_BENCH\n"
+  "  Timed, size-parameterized micro-benchmarks of PISM kernels (SIA stress\n"
+  "  balance, column solves, UNO advection, ghost exchanges) on a synthetic\n"
+  "  dome setup. Writes machine-readable JSON and can compare against a\n"
+  "  baseline file, for tracking performance across compiler and MPI\n"
+  "  upgrades without full model runs.\n\n";
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "pism/geometry/Geometry.hh"
+#include "pism/geometry/UNO.hh"
+#include "pism/rheology/FlowLawFactory.hh"
+#include "pism/stressbalance/ShallowStressBalance.hh"
+#include "pism/stressbalance/StressBalance.hh"
+#include "pism/stressbalance/sia/SIAFD.hh"
+#include "pism/util/ColumnSystem.hh"
+#include "pism/util/Context.hh"
+#include "pism/util/EnthalpyConverter.hh"
+#include "pism/util/Grid.hh"
+#include "pism/util/Logger.hh"
+#include "pism/util/array/CellType.hh"
+#include "pism/util/array/Scalar.hh"
+#include "pism/util/array/Vector.hh"
+#include "pism/util/error_handling.hh"
+#include "pism/util/petscwrappers/PetscInitializer.hh"
+#include "pism/util/pism_options.hh"
+#include "pism/util/pism_utilities.hh"
+
+namespace pism {
+namespace bench {
+
+//! Timing result of one benchmark (seconds per iteration; maxima over ranks, so the
+//! slowest rank determines the reported time).
+struct Result {
+  std::string name;
+  unsigned int iterations;
+  double min;
+  double mean;
+  double max;
+};
+
+//! Run `kernel` `n` times and report per-iteration times.
+/*!
+  One untimed warm-up call precedes the measurement; every timed iteration starts at a
+  barrier so that ranks measure the same work interval.
+ */
+static Result time_kernel(const std::string &name, MPI_Comm com, unsigned int n,
+                          const std::function<void()> &kernel) {
+  kernel();                     // warm-up
+
+  double t_min = 0.0, t_max = 0.0, t_sum = 0.0;
+  for (unsigned int k = 0; k < n; ++k) {
+    MPI_Barrier(com);
+    double start = MPI_Wtime();
+    kernel();
+    double dt = MPI_Wtime() - start;
+
+    t_min = k == 0 ? dt : std::min(t_min, dt);
+    t_max = std::max(t_max, dt);
+    t_sum += dt;
+  }
+
+  Result result;
+  result.name       = name;
+  result.iterations = n;
+  result.min        = GlobalMax(com, t_min);
+  result.mean       = GlobalMax(com, t_sum / n);
+  result.max        = GlobalMax(com, t_max);
+  return result;
+}
+
+//! Fill `geometry` with a parabolic dome centered in the domain.
+static void init_dome(Geometry &geometry, double H_max) {
+  auto grid = geometry.ice_thickness.grid();
+
+  const double R = 0.8 * grid->Lx();
+
+  geometry.bed_elevation.set(0.0);
+  geometry.sea_level_elevation.set(0.0);
+
+  array::AccessScope list{ &geometry.ice_thickness };
+  for (auto p : grid->points()) {
+    const int i = p.i(), j = p.j();
+
+    double r = sqrt(grid->x(i) * grid->x(i) + grid->y(j) * grid->y(j));
+    geometry.ice_thickness(i, j) = H_max * std::max(0.0, 1.0 - (r / R) * (r / R));
+  }
+}
+
+//! Parse the "results" entries of a JSON file written by this program.
+/*!
+  Not a general JSON parser: relies on each result being written on a single line (see
+  write_json()), which is enough to read our own baselines.
+ */
+static std::map<std::string, double> read_baseline(const std::string &filename) {
+  std::ifstream input(filename.c_str());
+  if (not input) {
+    throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                  "failed to open '%s'", filename.c_str());
+  }
+
+  std::map<std::string, double> result;
+  std::string line;
+  while (std::getline(input, line)) {
+    auto name_pos = line.find("\"name\":");
+    auto mean_pos = line.find("\"mean\":");
+    if (name_pos == std::string::npos or mean_pos == std::string::npos) {
+      continue;
+    }
+
+    auto open_quote  = line.find('"', name_pos + 7);
+    auto close_quote = line.find('"', open_quote + 1);
+    if (open_quote == std::string::npos or close_quote == std::string::npos) {
+      continue;
+    }
+
+    std::string name = line.substr(open_quote + 1, close_quote - open_quote - 1);
+    double mean      = atof(line.c_str() + mean_pos + 7);
+
+    result[name] = mean;
+  }
+
+  return result;
+}
+
+static void write_json(const std::string &filename, const Grid &grid,
+                       const std::vector<Result> &results) {
+  std::ofstream output(filename.c_str());
+  if (not output) {
+    throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                  "failed to open '%s'", filename.c_str());
+  }
+
+  int size = 0;
+  MPI_Comm_size(grid.com, &size);
+
+  output << pism::printf("{\n"
+                         "\"mpi_size\": %d,\n"
+                         "\"Mx\": %d, \"My\": %d, \"Mz\": %d,\n"
+                         "\"results\": [\n",
+                         size, (int)grid.Mx(), (int)grid.My(), (int)grid.Mz());
+  for (size_t k = 0; k < results.size(); ++k) {
+    const Result &r = results[k];
+    // one line per result; read_baseline() depends on this
+    output << pism::printf("{\"name\": \"%s\", \"iterations\": %d, "
+                           "\"min\": %.6e, \"mean\": %.6e, \"max\": %.6e}%s\n",
+                           r.name.c_str(), r.iterations, r.min, r.mean, r.max,
+                           k + 1 < results.size() ? "," : "");
+  }
+  output << "]\n}\n";
+}
+
+} // end of namespace bench
+} // end of namespace pism
+
+int main(int argc, char *argv[]) {
+
+  using namespace pism;
+  using namespace pism::bench;
+
+  MPI_Comm com = MPI_COMM_WORLD;
+  petsc::Initializer petsc(argc, argv, help);
+
+  /* This explicit scoping forces destructors to be called before PetscFinalize() */
+  try {
+    std::shared_ptr<Context> ctx = context_from_options(com, "pism_bench");
+    auto config = ctx->config();
+    auto log = ctx->log();
+
+    set_config_from_options(*config);
+    config->resolve_filenames();
+
+    std::string usage = "\n"
+      "usage of PISM_BENCH:\n"
+      "  run pism_bench [-Mx <number> -My <number> -Mz <number>]\n"
+      "                 [-n <iterations>] [-o <output.json>]\n"
+      "                 [-compare <baseline.json> [-tolerance <factor>]]\n"
+      "\n";
+
+    bool stop = maybe_show_usage(*log, "pism_bench", usage);
+    if (stop) {
+      return 0;
+    }
+
+    options::Integer iterations("-n", "number of timed iterations per kernel", 10);
+    options::String output_file("-o", "JSON output file name", "pism_bench.json");
+    options::String baseline_file("-compare",
+                                  "baseline JSON file to compare against");
+    options::Real tolerance(ctx->unit_system(), "-tolerance",
+                            "maximum acceptable mean-time ratio relative to the baseline",
+                            "1", 1.15);
+
+    // grid: domain size fixed, resolution set by -Mx, -My, -Mz
+    grid::Parameters P(*config);
+    P.Lx = 900e3;
+    P.Ly = P.Lx;
+    P.z  = grid::compute_vertical_levels(4000.0, config->get_number("grid.Mz"),
+                                         grid::EQUAL);
+    P.ownership_ranges_from_options(*config, ctx->size());
+
+    auto grid = std::make_shared<Grid>(ctx, P);
+    grid->report_parameters();
+
+    std::shared_ptr<EnthalpyConverter> EC = ctx->enthalpy_converter();
+
+    const int WIDE_STENCIL = config->get_number("grid.max_stencil_width");
+
+    // synthetic inputs shared by the benchmarks
+    Geometry geometry(grid);
+    init_dome(geometry, 3000.0);
+    geometry.ensure_consistency(config->get_number("geometry.ice_free_thickness_standard"));
+
+    array::Array3D enthalpy(grid, "enthalpy", array::WITH_GHOSTS, grid->z(), WIDE_STENCIL),
+        age(grid, "age", array::WITHOUT_GHOSTS, grid->z());
+    enthalpy.metadata(0)
+        .long_name("ice enthalpy (includes sensible heat, latent heat, pressure)")
+        .units("J kg^-1");
+    enthalpy.set(EC->enthalpy(263.15, 0.0, EC->pressure(1000.0)));
+    age.metadata(0).long_name("age of the ice").units("s");
+    age.set(0.0);
+
+    const unsigned int n = iterations;
+    std::vector<Result> results;
+
+    // SIA stress balance (diffusivity, flux and 3D velocities)
+    {
+      auto sia        = std::make_shared<stressbalance::SIAFD>(grid);
+      auto no_sliding = std::make_shared<stressbalance::ZeroSliding>(grid);
+      stressbalance::StressBalance stress_balance(grid, no_sliding, sia);
+      stress_balance.init();
+
+      stressbalance::Inputs inputs;
+      inputs.geometry = &geometry;
+      inputs.enthalpy = &enthalpy;
+      inputs.age      = &age;
+
+      results.push_back(time_kernel("sia_stress_balance", grid->com, n, [&]() {
+        stress_balance.update(inputs, true);
+      }));
+    }
+
+    // column solves (the enthalpy solver reduces to systems of this form)
+    {
+      const unsigned int Mz = grid->Mz();
+      const unsigned int n_columns = grid->xm() * grid->ym();
+
+      TridiagonalSystem system(Mz, "bench");
+      std::vector<double> x(Mz);
+
+      results.push_back(time_kernel("tridiagonal_columns", grid->com, n, [&]() {
+        for (unsigned int c = 0; c < n_columns; ++c) {
+          for (unsigned int k = 0; k < Mz; ++k) {
+            system.L(k)   = -1.0;
+            system.D(k)   = 4.0 + 0.01 * (k % 7);
+            system.U(k)   = -1.0;
+            system.RHS(k) = 1.0 + 0.001 * c;
+          }
+          system.solve(Mz, x);
+        }
+      }));
+    }
+
+    // UNO advection of one tracer
+    {
+      UNO uno(grid, PISM_UNO_2);
+
+      const double v_max = units::convert(ctx->unit_system(), 100.0, "m year^-1", "m second^-1");
+      const double dt    = 0.25 * grid->dx() / v_max;
+
+      array::Vector velocity(grid, "bench_velocity");
+      {
+        array::AccessScope list{ &velocity };
+        for (auto p : grid->points()) {
+          velocity(p.i(), p.j()) = { v_max, 0.0 };
+        }
+      }
+
+      results.push_back(time_kernel("uno2_advection", grid->com, n, [&]() {
+        uno.update(dt, geometry.cell_type, geometry.ice_thickness, velocity);
+      }));
+    }
+
+    // ghost exchanges
+    {
+      array::Scalar1 scalar(grid, "bench_scalar");
+      scalar.set(1.0);
+
+      results.push_back(time_kernel("ghost_exchange_2d", grid->com, n, [&]() {
+        scalar.update_ghosts();
+      }));
+
+      array::Array3D column(grid, "bench_3d", array::WITH_GHOSTS, grid->z());
+      column.set(1.0);
+
+      results.push_back(time_kernel("ghost_exchange_3d", grid->com, n, [&]() {
+        column.update_ghosts();
+      }));
+    }
+
+    // report
+    log->message(2, "# %-24s %12s %12s %12s\n", "kernel", "min (s)", "mean (s)", "max (s)");
+    for (const auto &r : results) {
+      log->message(2, "%-26s %12.6f %12.6f %12.6f\n", r.name.c_str(), r.min, r.mean, r.max);
+    }
+
+    if (grid->rank() == 0) {
+      write_json(output_file, *grid, results);
+    }
+
+    int exit_code = 0;
+    if (baseline_file.is_set()) {
+      auto baseline = read_baseline(baseline_file);
+
+      log->message(2, "# comparison against '%s' (tolerance %.2f):\n",
+                   baseline_file->c_str(), (double)tolerance);
+      for (const auto &r : results) {
+        auto b = baseline.find(r.name);
+        if (b == baseline.end()) {
+          log->message(2, "%-26s not in the baseline\n", r.name.c_str());
+          continue;
+        }
+
+        double ratio = b->second > 0.0 ? r.mean / b->second : 0.0;
+        bool failed  = ratio > tolerance;
+        log->message(2, "%-26s %12.6f -> %12.6f (x%.3f)%s\n", r.name.c_str(), b->second,
+                     r.mean, ratio, failed ? " REGRESSION" : "");
+        if (failed) {
+          exit_code = 1;
+        }
+      }
+    }
+
+    log->flush();
+
+    return exit_code;
+  }
+  catch (...) {
+    handle_fatal_errors(com);
+    return 1;
+  }
+
+  return 0;
+}
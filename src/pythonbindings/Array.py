@@ -37,6 +37,47 @@ def local_part(self):
 
     return self.vec().get().array.reshape(shape)
 
+def owned_part(self):
+    """NumPy array containing the owned (sub-domain) part, excluding ghosts.
+
+    This is not a copy. Modifications have immediate effect, but ghosts of
+    other ranks are *not* updated: call `update_ghosts()` when done modifying
+    a ghosted field.
+    """
+
+    w = self.stencil_width()
+
+    if w == 0:
+        return self.local_part()
+
+    return self.local_part()[w:-w, w:-w]
+
+def region(self, i_first, i_last, j_first, j_last):
+    """NumPy array containing the rectangle `i_first <= i <= i_last`,
+    `j_first <= j <= j_last` (global indices).
+
+    The rectangle has to fit into this rank's sub-domain extended by its
+    ghosts. This is not a copy: use it to read or modify a block of values
+    without an element-wise loop.
+    """
+
+    grid = self.grid()
+    w = self.stencil_width()
+
+    i0 = i_first - (grid.xs() - w)
+    i1 = i_last - (grid.xs() - w)
+    j0 = j_first - (grid.ys() - w)
+    j1 = j_last - (grid.ys() - w)
+
+    if (i0 < 0 or i1 >= grid.xm() + 2 * w or i1 < i0 or
+        j0 < 0 or j1 >= grid.ym() + 2 * w or j1 < j0):
+        raise IndexError("the rectangle [{}, {}] x [{}, {}] does not fit into the sub-domain"
+                         " (including ghosts) of rank {}".format(i_first, i_last,
+                                                                 j_first, j_last,
+                                                                 grid.ctx().rank()))
+
+    return self.local_part()[j0:j1 + 1, i0:i1 + 1]
+
 @property
 def spatial_coords(self):
     """
@@ -70,30 +70,18 @@ void EnthalpyModel_Regional::initialize_impl(const array::Scalar &basal_melt_rat
 void EnthalpyModel_Regional::update_impl(double t, double dt,
                                          const Inputs &inputs) {
 
-  unsigned int Mz = m_grid->Mz();
-
+  // The base class skips the column solves in the no-model strip and carries the old
+  // enthalpy over into m_work, so only the basal melt rate needs to be restored here.
   EnthalpyModel::update_impl(t, dt, inputs);
 
   const array::Scalar &no_model_mask = *inputs.no_model_mask;
 
-  // The update_impl() call above sets m_work; ghosts are communicated
-  // later (in EnergyModel::update()).
-  array::AccessScope list{&no_model_mask, &m_work, &m_ice_enthalpy,
-      &m_basal_melt_rate, &m_basal_melt_rate_stored};
+  array::AccessScope list{&no_model_mask, &m_basal_melt_rate, &m_basal_melt_rate_stored};
 
   for (auto p : m_grid->points()) {
     const int i = p.i(), j = p.j();
 
     if (no_model_mask(i, j) > 0.5) {
-      double *new_enthalpy = m_work.get_column(i, j);
-      double *old_enthalpy = m_ice_enthalpy.get_column(i, j);
-
-      // enthalpy
-      for (unsigned int k = 0; k < Mz; ++k) {
-        new_enthalpy[k] = old_enthalpy[k];
-      }
-
-      // basal melt rate
       m_basal_melt_rate(i, j) = m_basal_melt_rate_stored(i, j);
     }
   }
@@ -29,10 +29,52 @@
 #include "pism/util/Grid.hh"
 
 #include "pism/util/error_handling.hh"
+#include "pism/pism_config.hh"
 
 namespace pism {
 namespace rheology {
 
+#if Pism_FIXED_PHYSICAL_CONSTANTS == 1
+//! Stop if the value of a configuration parameter does not match the value baked in at
+//! compile time.
+static void check_fixed_constant(const char *parameter, double value, double fixed_value) {
+  if (value != fixed_value) {
+    throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                  "%s = %e does not match the value %e PISM was built with\n"
+                                  "(see Pism_FIXED_PHYSICAL_CONSTANTS)",
+                                  parameter, value, fixed_value);
+  }
+}
+
+// With the Glen exponent fixed at compile time the exponents of the power laws below are
+// compile-time constants: for n == 3 the conditions fold away and the pow() calls reduce
+// to a cube root or a multiplication.
+
+//! @f$ A^{-1/n} @f$; see hardness_impl().
+static inline double pow_hardness(double softness) {
+  if (fixed_constants::glen_exponent == 3.0) {
+    return 1.0 / cbrt(softness);
+  }
+  return pow(softness, -1.0 / fixed_constants::glen_exponent);
+}
+
+//! @f$ x^{(1-n)/(2n)} @f$; see effective_viscosity().
+static inline double pow_viscosity(double x) {
+  if (fixed_constants::glen_exponent == 3.0) {
+    return 1.0 / cbrt(x);       // (1 - n) / (2n) == -1/3 for n == 3
+  }
+  return pow(x, (1.0 - fixed_constants::glen_exponent) / (2.0 * fixed_constants::glen_exponent));
+}
+
+//! @f$ \sigma^{n-1} @f$; see flow_impl().
+static inline double pow_stress(double stress) {
+  if (fixed_constants::glen_exponent == 3.0) {
+    return stress * stress;
+  }
+  return pow(stress, fixed_constants::glen_exponent - 1.0);
+}
+#endif
+
 FlowLaw::FlowLaw(double exponent, const Config &config,
                  std::shared_ptr<EnthalpyConverter> ec)
   : m_EC(ec) {
@@ -44,6 +86,13 @@ FlowLaw::FlowLaw(double exponent, const Config &config,
   auto rho = config.get_number("constants.ice.density");
   auto standard_gravity   = config.get_number("constants.standard_gravity");
 
+#if Pism_FIXED_PHYSICAL_CONSTANTS == 1
+  check_fixed_constant("constants.ice.density", rho, fixed_constants::ice_density);
+  check_fixed_constant("constants.standard_gravity", standard_gravity,
+                       fixed_constants::standard_gravity);
+  check_fixed_constant("the Glen flow law exponent", exponent, fixed_constants::glen_exponent);
+#endif
+
   m_ideal_gas_constant = config.get_number("constants.ideal_gas_constant");
 
   m_rho_g              = rho * standard_gravity;
@@ -94,13 +143,11 @@ double FlowLaw::flow(double stress, double enthalpy,
 
 double FlowLaw::flow_impl(double stress, double enthalpy,
                           double pressure, double /* gs */) const {
+#if Pism_FIXED_PHYSICAL_CONSTANTS == 1
+  return softness(enthalpy, pressure) * pow_stress(stress);
+#else
   return softness(enthalpy, pressure) * pow(stress, m_n-1);
-}
-
-void FlowLaw::flow_n(const double *stress, const double *enthalpy,
-                     const double *pressure, const double *grainsize,
-                     unsigned int n, double *result) const {
-  this->flow_n_impl(stress, enthalpy, pressure, grainsize, n, result);
+#endif
 }
 
 void FlowLaw::flow_n_impl(const double *stress, const double *enthalpy,
@@ -116,6 +163,18 @@ double FlowLaw::softness(double E, double p) const {
   return this->softness_impl(E, p);
 }
 
+void FlowLaw::softness_n(const double *enthalpy, const double *pressure,
+                         unsigned int n, double *result) const {
+  this->softness_n_impl(enthalpy, pressure, n, result);
+}
+
+void FlowLaw::softness_n_impl(const double *enthalpy, const double *pressure,
+                              unsigned int n, double *result) const {
+  for (unsigned int k = 0; k < n; ++k) {
+    result[k] = this->softness(enthalpy[k], pressure[k]);
+  }
+}
+
 double FlowLaw::hardness(double E, double p) const {
   return this->hardness_impl(E, p);
 }
@@ -139,7 +198,11 @@ double FlowLaw::hardness_impl(double E, double p) const {
     return std::numeric_limits<double>::max();
   }
 #endif
+#if Pism_FIXED_PHYSICAL_CONSTANTS == 1
+  return pow_hardness(A);
+#else
   return pow(A, m_hardness_power);
+#endif
 }
 
 //! \brief Computes the regularized effective viscosity and its derivative with respect to the
@@ -174,8 +237,13 @@ void FlowLaw::effective_viscosity(double hardness, double gamma,
 
 void FlowLaw::effective_viscosity(double hardness, double gamma, double eps,
                                   double *nu, double *dnu) const {
+#if Pism_FIXED_PHYSICAL_CONSTANTS == 1
+  const double
+    my_nu = 0.5 * hardness * pow_viscosity(eps + gamma);
+#else
   const double
     my_nu = 0.5 * hardness * pow(eps + gamma, m_viscosity_power);
+#endif
 
   if (PetscLikely(nu != NULL)) {
     *nu = my_nu;
@@ -186,6 +254,49 @@ void FlowLaw::effective_viscosity(double hardness, double gamma, double eps,
   }
 }
 
+//! Batched version of effective_viscosity() operating on contiguous spans.
+/*!
+ * Evaluates the regularized effective viscosity (and, optionally, its
+ * derivative with respect to @f$ \gamma @f$) at `n` points at once. This
+ * avoids per-point call overhead in FEM assembly loops and lets the compiler
+ * vectorize the power-law evaluation.
+ *
+ * Either one of `nu` and `dnu` can be NULL if the corresponding output is not
+ * needed.
+ */
+void FlowLaw::effective_viscosity_n(const double *hardness, const double *gamma,
+                                    unsigned int n, double *nu, double *dnu) const {
+  const double eps = m_schoofReg;
+
+  if (nu != NULL) {
+    for (unsigned int k = 0; k < n; ++k) {
+#if Pism_FIXED_PHYSICAL_CONSTANTS == 1
+      nu[k] = 0.5 * hardness[k] * pow_viscosity(eps + gamma[k]);
+#else
+      nu[k] = 0.5 * hardness[k] * pow(eps + gamma[k], m_viscosity_power);
+#endif
+    }
+  }
+
+  if (dnu != NULL) {
+    if (nu != NULL) {
+      for (unsigned int k = 0; k < n; ++k) {
+        dnu[k] = m_viscosity_power * nu[k] / (eps + gamma[k]);
+      }
+    } else {
+      for (unsigned int k = 0; k < n; ++k) {
+#if Pism_FIXED_PHYSICAL_CONSTANTS == 1
+        dnu[k] = m_viscosity_power * 0.5 * hardness[k] * pow_viscosity(eps + gamma[k]) /
+                 (eps + gamma[k]);
+#else
+        dnu[k] = m_viscosity_power * 0.5 * hardness[k] * pow(eps + gamma[k], m_viscosity_power) /
+                 (eps + gamma[k]);
+#endif
+      }
+    }
+  }
+}
+
 void averaged_hardness_vec(const FlowLaw &ice,
                            const array::Scalar &thickness,
                            const array::Array3D  &enthalpy,
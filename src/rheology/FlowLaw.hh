@@ -86,6 +86,9 @@ public:
   void effective_viscosity(double hardness, double gamma, double eps,
                            double *nu, double *dnu) const;
 
+  void effective_viscosity_n(const double *hardness, const double *gamma,
+                             unsigned int n, double *nu, double *dnu) const;
+
   std::string name() const;
   double exponent() const;
 
@@ -96,11 +99,22 @@ public:
                   unsigned int n, double *result) const;
 
   double softness(double E, double p) const;
+  void softness_n(const double *enthalpy, const double *pressure,
+                  unsigned int n, double *result) const;
 
   double flow(double stress, double enthalpy, double pressure, double grain_size) const;
+  //! Evaluate the flow law for `n` points at once.
+  /*!
+    Defined in the header so that a call through a pointer or reference with a known
+    concrete type (see the kernel selection in SIAFD) can be devirtualized: if the
+    derived class (or its flow_n_impl()) is `final`, the compiler turns this into a
+    direct call into the derived implementation.
+   */
   void flow_n(const double *stress, const double *E,
               const double *pressure, const double *grainsize,
-              unsigned int n, double *result) const;
+              unsigned int n, double *result) const {
+    this->flow_n_impl(stress, E, pressure, grainsize, n, result);
+  }
 
 protected:
   virtual double flow_impl(double stress, double E,
@@ -112,6 +126,8 @@ protected:
   virtual void hardness_n_impl(const double *enthalpy, const double *pressure,
                                unsigned int n, double *result) const;
   virtual double softness_impl(double E, double p) const = 0;
+  virtual void softness_n_impl(const double *enthalpy, const double *pressure,
+                               unsigned int n, double *result) const;
 
 protected:
   std::string m_name;
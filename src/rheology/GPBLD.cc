@@ -17,8 +17,12 @@
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <algorithm>            // min, max
+#include <cmath>                // floor, fabs
+
 #include "pism/rheology/GPBLD.hh"
 #include "pism/util/Config.hh"
+#include "pism/util/error_handling.hh"
 
 namespace pism {
 namespace rheology {
@@ -35,6 +39,95 @@ GPBLD::GPBLD(double exponent, const Config &config, std::shared_ptr<EnthalpyConv
   m_water_frac_coeff = config.get_number("flow_law.gpbld.water_frac_coeff");
 
   m_water_frac_observed_limit = config.get_number("flow_law.gpbld.water_frac_observed_limit");
+
+  m_softness_T_0 = softness_paterson_budd(m_T_0);
+
+  m_softness_table_T_min  = 0.0;
+  m_softness_table_T_max  = 0.0;
+  m_softness_table_dT_inv = 0.0;
+  if (config.get_flag("flow_law.gpbld.softness_table")) {
+    init_softness_table(config);
+  }
+}
+
+//! Build the Paterson-Budd softness lookup table.
+/*!
+  The only expensive part of the GPBLD softness is the exponential in
+  softness_paterson_budd(), a function of the pressure-adjusted temperature
+  alone; everything else (the cold-temperate transition, the water fraction
+  factor) is linear in enthalpy and pressure. So instead of tabulating softness
+  on an enthalpy-pressure grid we tabulate softness_paterson_budd() on a
+  uniform one-dimensional grid of pressure-adjusted temperatures, which keeps
+  the table small and makes its interpolation error easy to control.
+
+  The table covers temperatures from the lowest allowed ice temperature
+  (shifted down by the melting point depression at the depth
+  `flow_law.gpbld.softness_table.depth_max`) up to the melting temperature;
+  softness_paterson_budd_table() falls back to the exact formula outside this
+  range.
+
+  To make sure the approximation error is negligible we measure the maximum
+  relative interpolation error at interval midpoints and stop with an error
+  message if it exceeds `flow_law.gpbld.softness_table.rtol`.
+*/
+void GPBLD::init_softness_table(const Config &config) {
+  int N            = static_cast<int>(config.get_number("flow_law.gpbld.softness_table.N"));
+  double rtol      = config.get_number("flow_law.gpbld.softness_table.rtol");
+  double depth_max = config.get_number("flow_law.gpbld.softness_table.depth_max");
+  double T_crit    = config.get_number("flow_law.Paterson_Budd.T_critical");
+
+  // Pressure-adjusted temperatures are below actual ice temperatures by up to
+  // the melting point depression at the bottom of the thickest ice column.
+  double T_min = (config.get_number("energy.minimum_allowed_temperature") -
+                  (m_T_0 - m_EC->melting_temperature(m_EC->pressure(depth_max))));
+  double T_max = m_T_0;
+
+  double dT = (T_max - T_min) / (N - 1);
+
+  // Shift the origin so that T_critical falls on a grid node: the
+  // Paterson-Budd softness has a corner there and linear interpolation across
+  // it would not converge to the requested tolerance.
+  T_min += (T_crit - T_min) - dT * std::floor((T_crit - T_min) / dT + 0.5);
+
+  m_softness_table.resize(N);
+  for (int k = 0; k < N; ++k) {
+    m_softness_table[k] = softness_paterson_budd(T_min + k * dT);
+  }
+
+  m_softness_table_T_min  = T_min;
+  m_softness_table_T_max  = T_min + (N - 1) * dT;
+  m_softness_table_dT_inv = 1.0 / dT;
+
+  // Measure the interpolation error at interval midpoints (where the error of
+  // linear interpolation of a smooth function is largest).
+  double max_error = 0.0;
+  for (int k = 0; k < N - 1; ++k) {
+    double exact  = softness_paterson_budd(T_min + (k + 0.5) * dT);
+    double approx = 0.5 * (m_softness_table[k] + m_softness_table[k + 1]);
+
+    max_error = std::max(max_error, std::fabs(approx - exact) / exact);
+  }
+
+  if (max_error > rtol) {
+    throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                  "GPBLD softness table is too coarse: relative error %.2e "
+                                  "exceeds flow_law.gpbld.softness_table.rtol = %.2e "
+                                  "(increase flow_law.gpbld.softness_table.N)",
+                                  max_error, rtol);
+  }
+}
+
+//! Tabulated Paterson-Budd softness (falls back to the exact formula outside the table).
+double GPBLD::softness_paterson_budd_table(double T_pa) const {
+  if (T_pa >= m_softness_table_T_min and T_pa < m_softness_table_T_max) {
+    double a = (T_pa - m_softness_table_T_min) * m_softness_table_dT_inv;
+    size_t k = static_cast<size_t>(a);
+    a -= k;
+
+    return (1.0 - a) * m_softness_table[k] + a * m_softness_table[k + 1];
+  }
+
+  return softness_paterson_budd(T_pa);
 }
 
 //! The softness factor in the Glen-Paterson-Budd-Lliboutry-Duval flow law.  For constitutive law form.
@@ -49,6 +142,9 @@ double GPBLD::softness_impl(double enthalpy, double pressure) const {
   const double E_s = m_EC->enthalpy_cts(pressure);
   if (enthalpy < E_s) {       // cold ice
     double T_pa = m_EC->pressure_adjusted_temperature(enthalpy, pressure);
+    if (not m_softness_table.empty()) {
+      return softness_paterson_budd_table(T_pa);
+    }
     return softness_paterson_budd(T_pa);
   }
 
@@ -57,7 +153,31 @@ double GPBLD::softness_impl(double enthalpy, double pressure) const {
   // as stated in \ref AschwandenBuelerBlatter, cap omega at max of observations:
   omega = std::min(omega, m_water_frac_observed_limit);
   // next line implements eqn (23) in \ref AschwandenBlatter2009
-  return softness_paterson_budd(m_T_0) * (1.0 + m_water_frac_coeff * omega);
+  return m_softness_T_0 * (1.0 + m_water_frac_coeff * omega);
+}
+
+//! Batched softness evaluation.
+/*!
+ * Computes the same softness as softness_impl(), but for `n` points at once,
+ * without going through virtual dispatch per point. The cold/temperate branch
+ * is resolved per point; both branches are simple enough for the compiler to
+ * vectorize.
+ */
+void GPBLD::softness_n_impl(const double *enthalpy, const double *pressure,
+                            unsigned int n, double *result) const {
+  const bool use_table = not m_softness_table.empty();
+
+  for (unsigned int k = 0; k < n; ++k) {
+    const double E_s = m_EC->enthalpy_cts(pressure[k]);
+    if (enthalpy[k] < E_s) { // cold ice
+      double T_pa = m_EC->pressure_adjusted_temperature(enthalpy[k], pressure[k]);
+      result[k]   = use_table ? softness_paterson_budd_table(T_pa) : softness_paterson_budd(T_pa);
+    } else { // temperate ice
+      double omega = m_EC->water_fraction(enthalpy[k], pressure[k]);
+      omega        = std::min(omega, m_water_frac_observed_limit);
+      result[k]    = m_softness_T_0 * (1.0 + m_water_frac_coeff * omega);
+    }
+  }
 }
 
 void GPBLD::flow_n_impl(const double *stress, const double *enthalpy,
@@ -65,8 +185,9 @@ void GPBLD::flow_n_impl(const double *stress, const double *enthalpy,
                         unsigned int n, double *result) const {
   // optimize the common case of Glen n=3
   if (m_n == 3.0) {
+    this->softness_n_impl(enthalpy, pressure, n, result);
     for (unsigned int k = 0; k < n; ++k) {
-      result[k] = this->softness(enthalpy[k], pressure[k]) * (stress[k] * stress[k]);
+      result[k] *= stress[k] * stress[k];
     }
 
     return;
@@ -20,6 +20,8 @@
 #ifndef _GPBLD_H_
 #define _GPBLD_H_
 
+#include <vector>
+
 #include "pism/rheology/FlowLaw.hh"
 
 namespace pism {
@@ -30,15 +32,29 @@ namespace rheology {
   See [\ref AschwandenBlatter]. The basic references are [\ref Glen] and [\ref
   PatersonBudd] and [\ref LliboutryDuval1985].
 */
-class GPBLD : public FlowLaw {
+// `final` so that calls with a statically-known GPBLD type devirtualize (see
+// FlowLaw::flow_n() and the kernel selection in SIAFD)
+class GPBLD final : public FlowLaw {
 public:
   GPBLD(double exponent, const Config &config, std::shared_ptr<EnthalpyConverter> EC);
 protected:
   double softness_impl(double enthalpy, double pressure) const;
+  void softness_n_impl(const double *enthalpy, const double *pressure,
+                       unsigned int n, double *result) const;
   void flow_n_impl(const double *stress, const double *enthalpy,
                    const double *pressure, const double *grainsize,
                    unsigned int n, double *result) const;
   double m_T_0, m_water_frac_coeff, m_water_frac_observed_limit;
+private:
+  void init_softness_table(const Config &config);
+  double softness_paterson_budd_table(double T_pa) const;
+
+  //! Paterson-Budd softness at the melting temperature (used by the temperate branch)
+  double m_softness_T_0;
+  //! softness_paterson_budd() sampled on a uniform grid of pressure-adjusted
+  //! temperatures; empty if flow_law.gpbld.softness_table is not set
+  std::vector<double> m_softness_table;
+  double m_softness_table_T_min, m_softness_table_T_max, m_softness_table_dT_inv;
 };
 
 } // end of namespace rheology
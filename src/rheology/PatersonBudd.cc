@@ -45,6 +45,20 @@ double PatersonBudd::flow_impl(double stress, double E,
   return flow_from_temp(stress, temp, pressure, gs);
 }
 
+//! Batched flow evaluation.
+/*!
+ * Equivalent to calling flow_impl() per point, but processes a contiguous span,
+ * avoiding virtual dispatch per point in the common case (see FlowLaw::flow_n()).
+ */
+void PatersonBudd::flow_n_impl(const double *stress, const double *E,
+                               const double *pressure, const double *grainsize,
+                               unsigned int n, double *result) const {
+  for (unsigned int k = 0; k < n; ++k) {
+    double temp = m_EC->temperature(E[k], pressure[k]);
+    result[k] = this->flow_from_temp(stress[k], temp, pressure[k], grainsize[k]);
+  }
+}
+
 //! The flow law (temperature-dependent version).
 double PatersonBudd::flow_from_temp(double stress, double temp,
                                     double pressure, double /*gs*/) const {
@@ -37,6 +37,12 @@ public:
 protected:
   virtual double flow_impl(double stress, double E,
                            double pressure, double gs) const;
+  // `final` so that calls with a statically-known PatersonBudd type devirtualize (see
+  // FlowLaw::flow_n() and the kernel selection in SIAFD); correct for all derived
+  // classes because it goes through the virtual flow_from_temp().
+  void flow_n_impl(const double *stress, const double *E,
+                   const double *pressure, const double *grainsize,
+                   unsigned int n, double *result) const final;
   // This also takes care of hardness
   virtual double softness_impl(double enthalpy, double pressure) const;
 
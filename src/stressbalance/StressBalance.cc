@@ -154,9 +154,16 @@ void StressBalance::init() {
   m_modifier->init();
 }
 
+std::map<std::string, std::shared_ptr<array::Array> >& StressBalance::diagnostic_cache() const {
+  return m_diagnostic_cache;
+}
+
 //! \brief Performs the shallow stress balance computation.
 void StressBalance::update(const Inputs &inputs, bool full_update) {
 
+  // fields cached for diagnostics describe the state we are about to replace
+  m_diagnostic_cache.clear();
+
   try {
     profiling().begin("stress_balance.shallow");
     m_shallow_stress_balance->update(inputs, full_update);
@@ -171,25 +178,26 @@ void StressBalance::update(const Inputs &inputs, bool full_update) {
       const array::Array3D &u = m_modifier->velocity_u();
       const array::Array3D &v = m_modifier->velocity_v();
 
-      profiling().begin("stress_balance.strain_heat");
-      this->compute_volumetric_strain_heating(inputs);
-      profiling().end("stress_balance.strain_heat");
-
-      profiling().begin("stress_balance.vertical_velocity");
-      this->compute_vertical_velocity(inputs.geometry->cell_type,
-                                      u, v, inputs.basal_melt_rate, m_w);
-      profiling().end("stress_balance.vertical_velocity");
-
-      m_cfl_3d = ::pism::max_timestep_cfl_3d(inputs.geometry->ice_thickness,
+      // one pass over the horizontal velocity columns computes both the strain heating
+      // and the vertical velocity
+      profiling().begin("stress_balance.strain_heat_and_w");
+      this->compute_vertical_velocity_and_strain_heating(inputs);
+      profiling().end("stress_balance.strain_heat_and_w");
+
+      // one pass over the velocity fields and one reduction for both the 2D
+      // and the 3D CFL restrictions
+      ::pism::max_timestep_cfl(inputs.geometry->ice_thickness,
+                               inputs.geometry->cell_type,
+                               inputs.no_model_mask,
+                               m_shallow_stress_balance->velocity(),
+                               u, v, m_w,
+                               m_cfl_2d, m_cfl_3d);
+    } else {
+      m_cfl_2d = ::pism::max_timestep_cfl_2d(inputs.geometry->ice_thickness,
                                              inputs.geometry->cell_type,
                                              inputs.no_model_mask,
-                                             u, v, m_w);
+                                             m_shallow_stress_balance->velocity());
     }
-
-    m_cfl_2d = ::pism::max_timestep_cfl_2d(inputs.geometry->ice_thickness,
-                                           inputs.geometry->cell_type,
-                                           inputs.no_model_mask,
-                                           m_shallow_stress_balance->velocity());
   }
   catch (RuntimeError &e) {
     e.add_context("updating the stress balance");
@@ -237,179 +245,6 @@ const array::Array3D& StressBalance::volumetric_strain_heating() const {
   return m_strain_heating;
 }
 
-//! Compute vertical velocity using incompressibility of the ice.
-/*!
-The vertical velocity \f$w(x,y,z,t)\f$ is the velocity *relative to the
-location of the base of the ice column*.  That is, the vertical velocity
-computed here is identified as \f$\tilde w(x,y,s,t)\f$ in the page
-[]@ref vertchange.
-
-Thus \f$w<0\f$ here means that that
-that part of the ice is getting closer to the base of the ice, and so on.
-The slope of the bed (i.e. relative to the geoid) and/or the motion of the
-bed (i.e. from bed deformation) do not affect the vertical velocity.
-
-In fact the following statement is exactly true if the basal melt rate is zero:
-the vertical velocity at a point in the ice is positive (negative) if and only
-if the average horizontal divergence of the horizontal velocity, in the portion
-of the ice column below that point, is negative (positive).
-In particular, because \f$z=0\f$ is the location of the base of the ice
-always, the only way to have \f$w(x,y,0,t) \ne 0\f$ is to have a basal melt
-rate.
-
-Incompressibility itself says
-   \f[ \nabla\cdot\mathbf{U} + \frac{\partial w}{\partial z} = 0. \f]
-This is immediately equivalent to the integral
-   \f[ w(x,y,z,t) = - \int_{b(x,y,t)}^{z} \nabla\cdot\mathbf{U}\,d\zeta
-                           + w_b(x,y,t). \f]
-Here the value \f$w_b(x,y,t)\f$ is either zero or the negative of the basal melt rate
-according to the value of the flag `geometry.update.use_basal_melt_rate`.
-
-The vertical integral is computed by the trapezoid rule.
- */
-void StressBalance::compute_vertical_velocity(const array::CellType1 &mask,
-                                              const array::Array3D &u,
-                                              const array::Array3D &v,
-                                              const array::Scalar *basal_melt_rate,
-                                              array::Array3D &result) {
-
-  const bool use_upstream_fd = m_config->get_string("stress_balance.vertical_velocity_approximation") == "upstream";
-
-  array::AccessScope list{&u, &v, &mask, &result};
-
-  if (basal_melt_rate) {
-    list.add(*basal_melt_rate);
-  }
-
-  const std::vector<double> &z = m_grid->z();
-  const unsigned int Mz = m_grid->Mz();
-
-  const double
-    dx = m_grid->dx(),
-    dy = m_grid->dy();
-
-  std::vector<double> u_x_plus_v_y(Mz);
-
-  for (auto p : m_grid->points()) {
-    const int i = p.i(), j = p.j();
-
-    double *w_ij = result.get_column(i,j);
-
-    const double
-      *u_w  = u.get_column(i-1,j),
-      *u_ij = u.get_column(i,j),
-      *u_e  = u.get_column(i+1,j);
-    const double
-      *v_s  = v.get_column(i,j-1),
-      *v_ij = v.get_column(i,j),
-      *v_n  = v.get_column(i,j+1);
-
-    double
-      west  = 1.0,
-      east  = 1.0,
-      south = 1.0,
-      north = 1.0;
-    double
-      D_x = 0,                  // 1/(dx), 1/(2dx), or 0
-      D_y = 0;                  // 1/(dy), 1/(2dy), or 0
-
-    // Switch between second-order centered differences in the interior and
-    // first-order one-sided differences at ice margins.
-
-    // x-derivative
-    {
-      // use basal velocity to determine FD direction ("upwind" when it's clear, centered when it's
-      // not)
-      if (use_upstream_fd) {
-        const double
-          uw = 0.5 * (u_w[0] + u_ij[0]),
-          ue = 0.5 * (u_ij[0] + u_e[0]);
-
-        if (uw > 0.0 and ue >= 0.0) {
-          west = 1.0;
-          east = 0.0;
-        } else if (uw <= 0.0 and ue < 0.0) {
-          west = 0.0;
-          east = 1.0;
-        } else {
-          west = 1.0;
-          east = 1.0;
-        }
-      }
-
-      if ((mask.icy(i,j) and mask.ice_free(i+1,j)) or (mask.ice_free(i,j) and mask.icy(i+1,j))) {
-        east = 0;
-      }
-      if ((mask.icy(i,j) and mask.ice_free(i-1,j)) or (mask.ice_free(i,j) and mask.icy(i-1,j))) {
-        west = 0;
-      }
-
-      if (east + west > 0) {
-        D_x = 1.0 / (dx * (east + west));
-      } else {
-        D_x = 0.0;
-      }
-    }
-
-    // y-derivative
-    {
-      // use basal velocity to determine FD direction ("upwind" when it's clear, centered when it's
-      // not)
-      if (use_upstream_fd) {
-        const double
-          vs = 0.5 * (v_s[0] + v_ij[0]),
-          vn = 0.5 * (v_ij[0] + v_n[0]);
-
-        if (vs > 0.0 and vn >= 0.0) {
-          south = 1.0;
-          north = 0.0;
-        } else if (vs <= 0.0 and vn < 0.0) {
-          south = 0.0;
-          north = 1.0;
-        } else {
-          south = 1.0;
-          north = 1.0;
-        }
-      }
-
-      if ((mask.icy(i,j) and mask.ice_free(i,j+1)) or (mask.ice_free(i,j) and mask.icy(i,j+1))) {
-        north = 0;
-      }
-      if ((mask.icy(i,j) and mask.ice_free(i,j-1)) or (mask.ice_free(i,j) and mask.icy(i,j-1))) {
-        south = 0;
-      }
-
-      if (north + south > 0) {
-        D_y = 1.0 / (dy * (north + south));
-      } else {
-        D_y = 0.0;
-      }
-    }
-
-    // compute u_x + v_y using a vectorizable loop
-    for (unsigned int k = 0; k < Mz; ++k) {
-      double
-        u_x = D_x * (west  * (u_ij[k] - u_w[k]) + east  * (u_e[k] - u_ij[k])),
-        v_y = D_y * (south * (v_ij[k] - v_s[k]) + north * (v_n[k] - v_ij[k]));
-      u_x_plus_v_y[k] = u_x + v_y;
-    }
-
-    // at the base: include the basal melt rate
-    if (basal_melt_rate != NULL) {
-      w_ij[0] = - (*basal_melt_rate)(i,j);
-    } else {
-      w_ij[0] = 0.0;
-    }
-
-    // within the ice and above:
-    for (unsigned int k = 1; k < Mz; ++k) {
-      const double dz = z[k] - z[k-1];
-
-      w_ij[k] = w_ij[k - 1] - (0.5 * dz) * (u_x_plus_v_y[k] + u_x_plus_v_y[k - 1]);
-    }
-  }
-}
-
 /**
  * This function computes \f$D^2\f$ defined by
  *
@@ -423,7 +258,7 @@ void StressBalance::compute_vertical_velocity(const array::CellType1 &mask,
  *
  * (note the use of the summation convention). Here \f$D_{ij}\f$ is the
  * strain rate tensor. See
- * StressBalance::compute_volumetric_strain_heating() for details.
+ * StressBalance::compute_vertical_velocity_and_strain_heating() for details.
  *
  * @param u_x,u_y,u_z partial derivatives of \f$u\f$, the x-component of the ice velocity
  * @param v_x,v_y,v_z partial derivatives of \f$v\f$, the y-component of the ice velocity
@@ -435,8 +270,15 @@ static inline double D2(double u_x, double u_y, double u_z, double v_x, double v
 }
 
 /**
-  \brief Computes the volumetric strain heating using horizontal
-  velocity.
+  \brief Computes the volumetric strain heating and the vertical velocity using
+  horizontal velocity.
+
+  Both quantities are derived from the same inputs (columns of `u` and `v` at a grid
+  point and its four neighbors), so they are computed in one traversal of the horizontal
+  velocity fields. Computing them separately would read the two 3D fields twice per time
+  step.
+
+  1. Strain heating.
 
   Following the notation used in [\ref BBssasliding], let \f$u\f$ be a
   three-dimensional *vector* velocity field. Then the strain rate
@@ -489,9 +331,42 @@ static inline double D2(double u_x, double u_y, double u_z, double v_x, double v
        tex('D = D);
        tex('D^2 = 1/2 * mat_trace(D . D));
 
-  @return 0 on success
+  2. Vertical velocity, using incompressibility of the ice.
+
+  The vertical velocity \f$w(x,y,z,t)\f$ is the velocity *relative to the
+  location of the base of the ice column*.  That is, the vertical velocity
+  computed here is identified as \f$\tilde w(x,y,s,t)\f$ in the page
+  []@ref vertchange.
+
+  Thus \f$w<0\f$ here means that that
+  that part of the ice is getting closer to the base of the ice, and so on.
+  The slope of the bed (i.e. relative to the geoid) and/or the motion of the
+  bed (i.e. from bed deformation) do not affect the vertical velocity.
+
+  In fact the following statement is exactly true if the basal melt rate is zero:
+  the vertical velocity at a point in the ice is positive (negative) if and only
+  if the average horizontal divergence of the horizontal velocity, in the portion
+  of the ice column below that point, is negative (positive).
+  In particular, because \f$z=0\f$ is the location of the base of the ice
+  always, the only way to have \f$w(x,y,0,t) \ne 0\f$ is to have a basal melt
+  rate.
+
+  Incompressibility itself says
+     \f[ \nabla\cdot\mathbf{U} + \frac{\partial w}{\partial z} = 0. \f]
+  This is immediately equivalent to the integral
+     \f[ w(x,y,z,t) = - \int_{b(x,y,t)}^{z} \nabla\cdot\mathbf{U}\,d\zeta
+                             + w_b(x,y,t). \f]
+  Here the value \f$w_b(x,y,t)\f$ is either zero or the negative of the basal melt rate
+  according to the value of the flag `geometry.update.use_basal_melt_rate`.
+
+  The vertical integral is computed by the trapezoid rule.
+
+  The horizontal divergence above uses the same margin handling as the strain heating
+  computation, but (unlike the strain heating) it optionally switches to one-sided
+  differences selected using the direction of the flow at the base; see
+  `stress_balance.vertical_velocity_approximation`.
  */
-void StressBalance::compute_volumetric_strain_heating(const Inputs &inputs) {
+void StressBalance::compute_vertical_velocity_and_strain_heating(const Inputs &inputs) {
   PetscErrorCode ierr;
 
   const auto &flow_law = *m_shallow_stress_balance->flow_law();
@@ -506,17 +381,26 @@ void StressBalance::compute_volumetric_strain_heating(const Inputs &inputs) {
 
   const auto &mask = inputs.geometry->cell_type;
 
+  const array::Scalar *basal_melt_rate = inputs.basal_melt_rate;
+
+  const bool use_upstream_fd =
+    m_config->get_string("stress_balance.vertical_velocity_approximation") == "upstream";
+
   double
     enhancement_factor = m_shallow_stress_balance->flow_enhancement_factor(),
     n = flow_law.exponent(),
     exponent = 0.5 * (1.0 / n + 1.0),
     e_to_a_power = pow(enhancement_factor,-1.0/n);
 
-  array::AccessScope list{&mask, enthalpy, &m_strain_heating, &thickness, &u, &v};
+  array::AccessScope list{&mask, enthalpy, &m_strain_heating, &m_w, &thickness, &u, &v};
+
+  if (basal_melt_rate) {
+    list.add(*basal_melt_rate);
+  }
 
   const std::vector<double> &z = m_grid->z();
   const unsigned int Mz = m_grid->Mz();
-  std::vector<double> depth(Mz), pressure(Mz), hardness(Mz);
+  std::vector<double> depth(Mz), pressure(Mz), hardness(Mz), u_x_plus_v_y(Mz);
 
   ParallelSection loop(m_grid->com);
   try {
@@ -625,6 +509,75 @@ void StressBalance::compute_volumetric_strain_heating(const Inputs &inputs) {
 #endif
         PISM_CHK(ierr, "PetscMemzero");
       }
+
+      // Vertical velocity: integrate the horizontal divergence up from the base,
+      // re-using the velocity columns loaded above. The divergence uses the margin
+      // handling computed above, optionally switching to one-sided differences selected
+      // using the direction of the flow at the base.
+      {
+        double west_w = west, east_w = east, south_w = south, north_w = north,
+          D_x_w = D_x, D_y_w = D_y;
+
+        if (use_upstream_fd) {
+          // use basal velocity to determine FD direction ("upwind" when it's clear,
+          // centered when it's not)
+          const double
+            uw = 0.5 * (u_w[0] + u_ij[0]),
+            ue = 0.5 * (u_ij[0] + u_e[0]);
+
+          if (uw > 0.0 and ue >= 0.0) {
+            east_w = 0.0;
+          } else if (uw <= 0.0 and ue < 0.0) {
+            west_w = 0.0;
+          }
+
+          const double
+            vs = 0.5 * (v_s[0] + v_ij[0]),
+            vn = 0.5 * (v_ij[0] + v_n[0]);
+
+          if (vs > 0.0 and vn >= 0.0) {
+            north_w = 0.0;
+          } else if (vs <= 0.0 and vn < 0.0) {
+            south_w = 0.0;
+          }
+
+          if (east_w + west_w > 0) {
+            D_x_w = 1.0 / (m_grid->dx() * (east_w + west_w));
+          } else {
+            D_x_w = 0.0;
+          }
+
+          if (north_w + south_w > 0) {
+            D_y_w = 1.0 / (m_grid->dy() * (north_w + south_w));
+          } else {
+            D_y_w = 0.0;
+          }
+        }
+
+        // compute u_x + v_y using a vectorizable loop
+        for (unsigned int k = 0; k < Mz; ++k) {
+          double
+            u_x = D_x_w * (west_w  * (u_ij[k] - u_w[k]) + east_w  * (u_e[k] - u_ij[k])),
+            v_y = D_y_w * (south_w * (v_ij[k] - v_s[k]) + north_w * (v_n[k] - v_ij[k]));
+          u_x_plus_v_y[k] = u_x + v_y;
+        }
+
+        double *w_ij = m_w.get_column(i, j);
+
+        // at the base: include the basal melt rate
+        if (basal_melt_rate != NULL) {
+          w_ij[0] = - (*basal_melt_rate)(i,j);
+        } else {
+          w_ij[0] = 0.0;
+        }
+
+        // within the ice and above:
+        for (unsigned int k = 1; k < Mz; ++k) {
+          const double dz = z[k] - z[k-1];
+
+          w_ij[k] = w_ij[k - 1] - (0.5 * dz) * (u_x_plus_v_y[k] + u_x_plus_v_y[k - 1]);
+        }
+      }
     }
   } catch (...) {
     loop.failed();
@@ -656,6 +609,101 @@ void StressBalance::write_state_impl(const OutputFile &output) const {
   m_modifier->write_state(output);
 }
 
+//! \brief Compute the gradient of the horizontal velocity at a grid point.
+/*!
+Computes `u_x` (etc) using second-order centered finite differences written as
+weighted sums of first-order one-sided finite differences.
+
+Given the cell layout
+~~~
+*----n----*
+|         |
+|         |
+w         e
+|         |
+|         |
+*----s----*
+~~~
+`east == 0` if the east neighbor of the current cell is ice-free. In
+this case we use the left- (west-) sided difference.
+
+If both neighbors in the east-west (x) direction are ice-free the
+x-derivative is set to zero.
+
+Similarly in other directions.
+ */
+static void weighted_velocity_gradient(const stencils::Star<Vector2d> &U,
+                                       const stencils::Star<int> &m,
+                                       double dx, double dy,
+                                       double &u_x, double &u_y,
+                                       double &v_x, double &v_y) {
+  using mask::ice_free;
+
+  // strain in units s^-1
+  u_x = 0.0;
+  u_y = 0.0;
+  v_x = 0.0;
+  v_y = 0.0;
+
+  double east = 1, west = 1, south = 1, north = 1;
+
+  if (ice_free(m.e)) {
+    east = 0;
+  }
+  if (ice_free(m.w)) {
+    west = 0;
+  }
+  if (ice_free(m.n)) {
+    north = 0;
+  }
+  if (ice_free(m.s)) {
+    south = 0;
+  }
+
+  if (west + east > 0) {
+    u_x = 1.0 / (dx * (west + east)) * (west * (U.c.u - U[West].u) + east * (U[East].u - U.c.u));
+    v_x = 1.0 / (dx * (west + east)) * (west * (U.c.v - U[West].v) + east * (U[East].v - U.c.v));
+  }
+
+  if (south + north > 0) {
+    u_y = 1.0 / (dy * (south + north)) * (south * (U.c.u - U[South].u) + north * (U[North].u - U.c.u));
+    v_y = 1.0 / (dy * (south + north)) * (south * (U.c.v - U[South].v) + north * (U[North].v - U.c.v));
+  }
+}
+
+//! Compute eigenvalues of the strain rate tensor given the velocity gradient.
+static PrincipalStrainRates eigenvalues(double u_x, double u_y, double v_x, double v_y) {
+  const double A = 0.5 * (u_x + v_y),  // A = (1/2) trace(D)
+    B   = 0.5 * (u_x - v_y),
+    Dxy = 0.5 * (v_x + u_y),  // B^2 = A^2 - u_x v_y
+    q   = sqrt(B*B + Dxy*Dxy);
+
+  PrincipalStrainRates result;
+  result.eigen1 = A + q;
+  result.eigen2 = A - q;        // q >= 0 so e1 >= e2
+
+  return result;
+}
+
+//! \brief Compute eigenvalues of the horizontal, vertically-integrated strain rate tensor
+//! at one grid point.
+/*!
+Calculates all components \f$D_{xx}, D_{yy}, D_{xy}=D_{yx}\f$ of the
+vertically-averaged strain rate tensor \f$D\f$ [\ref SchoofStream] and computes its
+eigenvalues (`eigen1` = maximum, `eigen2` = minimum).
+
+Note that `eigen1` >= `eigen2`, but there is no necessary relation between the
+magnitudes, and either principal strain rate could be negative or positive.
+ */
+PrincipalStrainRates principal_strain_rates(const stencils::Star<Vector2d> &U,
+                                            const stencils::Star<int> &m,
+                                            double dx, double dy) {
+  double u_x, u_y, v_x, v_y;
+  weighted_velocity_gradient(U, m, dx, dy, u_x, u_y, v_x, v_y);
+
+  return eigenvalues(u_x, u_y, v_x, v_y);
+}
+
 //! \brief Compute eigenvalues of the horizontal, vertically-integrated strain rate tensor.
 /*!
 Calculates all components \f$D_{xx}, D_{yy}, D_{xy}=D_{yx}\f$ of the
@@ -677,8 +725,6 @@ void compute_2D_principal_strain_rates(const array::Vector1 &V,
                                        const array::CellType1 &mask,
                                        array::Array2D<PrincipalStrainRates> &result) {
 
-  using mask::ice_free;
-
   auto grid = result.grid();
   double dx = grid->dx();
   double dy = grid->dy();
@@ -694,61 +740,7 @@ void compute_2D_principal_strain_rates(const array::Vector1 &V,
       continue;
     }
 
-    auto m = mask.star(i,j);
-    auto U = V.star(i,j);
-
-    // strain in units s^-1
-    double u_x = 0, u_y = 0, v_x = 0, v_y = 0,
-      east = 1, west = 1, south = 1, north = 1;
-
-    // Computes u_x using second-order centered finite differences written as
-    // weighted sums of first-order one-sided finite differences.
-    //
-    // Given the cell layout
-    // *----n----*
-    // |         |
-    // |         |
-    // w         e
-    // |         |
-    // |         |
-    // *----s----*
-    // east == 0 if the east neighbor of the current cell is ice-free. In
-    // this case we use the left- (west-) sided difference.
-    //
-    // If both neighbors in the east-west (x) direction are ice-free the
-    // x-derivative is set to zero (see u_x, v_x initialization above).
-    //
-    // Similarly in other directions.
-    if (ice_free(m.e)) {
-      east = 0;
-    }
-    if (ice_free(m.w)) {
-      west = 0;
-    }
-    if (ice_free(m.n)) {
-      north = 0;
-    }
-    if (ice_free(m.s)) {
-      south = 0;
-    }
-
-    if (west + east > 0) {
-      u_x = 1.0 / (dx * (west + east)) * (west * (U.c.u - U[West].u) + east * (U[East].u - U.c.u));
-      v_x = 1.0 / (dx * (west + east)) * (west * (U.c.v - U[West].v) + east * (U[East].v - U.c.v));
-    }
-
-    if (south + north > 0) {
-      u_y = 1.0 / (dy * (south + north)) * (south * (U.c.u - U[South].u) + north * (U[North].u - U.c.u));
-      v_y = 1.0 / (dy * (south + north)) * (south * (U.c.v - U[South].v) + north * (U[North].v - U.c.v));
-    }
-
-    const double A = 0.5 * (u_x + v_y),  // A = (1/2) trace(D)
-      B   = 0.5 * (u_x - v_y),
-      Dxy = 0.5 * (v_x + u_y),  // B^2 = A^2 - u_x v_y
-      q   = sqrt(B*B + Dxy*Dxy);
-    result(i, j).eigen1 = A + q;
-    result(i, j).eigen2 = A - q; // q >= 0 so e1 >= e2
-
+    result(i, j) = principal_strain_rates(V.star(i, j), mask.star_int(i, j), dx, dy);
   }
 }
 
@@ -759,8 +751,6 @@ void compute_2D_stresses(const rheology::FlowLaw &flow_law,
                          const array::CellType1 &cell_type,
                          array::Array2D<DeviatoricStresses> &result) {
 
-  using mask::ice_free;
-
   auto grid = result.grid();
 
   const double
@@ -779,53 +769,9 @@ void compute_2D_stresses(const rheology::FlowLaw &flow_law,
       continue;
     }
 
-    auto m = cell_type.star(i,j);
-    auto U = velocity.star(i,j);
-
-    // strain in units s^-1
-    double u_x = 0, u_y = 0, v_x = 0, v_y = 0,
-      east = 1, west = 1, south = 1, north = 1;
-
-    // Computes u_x using second-order centered finite differences written as
-    // weighted sums of first-order one-sided finite differences.
-    //
-    // Given the cell layout
-    // *----n----*
-    // |         |
-    // |         |
-    // w         e
-    // |         |
-    // |         |
-    // *----s----*
-    // east == 0 if the east neighbor of the current cell is ice-free. In
-    // this case we use the left- (west-) sided difference.
-    //
-    // If both neighbors in the east-west (x) direction are ice-free the
-    // x-derivative is set to zero (see u_x, v_x initialization above).
-    //
-    // Similarly in y-direction.
-    if (ice_free(m.e)) {
-      east = 0;
-    }
-    if (ice_free(m.w)) {
-      west = 0;
-    }
-    if (ice_free(m.n)) {
-      north = 0;
-    }
-    if (ice_free(m.s)) {
-      south = 0;
-    }
-
-    if (west + east > 0) {
-      u_x = 1.0 / (dx * (west + east)) * (west * (U.c.u - U[West].u) + east * (U[East].u - U.c.u));
-      v_x = 1.0 / (dx * (west + east)) * (west * (U.c.v - U[West].v) + east * (U[East].v - U.c.v));
-    }
-
-    if (south + north > 0) {
-      u_y = 1.0 / (dy * (south + north)) * (south * (U.c.u - U[South].u) + north * (U[North].u - U.c.u));
-      v_y = 1.0 / (dy * (south + north)) * (south * (U.c.v - U[South].v) + north * (U[North].v - U.c.v));
-    }
+    double u_x, u_y, v_x, v_y;
+    weighted_velocity_gradient(velocity.star(i, j), cell_type.star(i, j), dx, dy,
+                               u_x, u_y, v_x, v_y);
 
     double nu = 0.0;
     flow_law.effective_viscosity(hardness(i, j),
@@ -839,6 +785,57 @@ void compute_2D_stresses(const rheology::FlowLaw &flow_law,
   }
 }
 
+//! @brief Compute 2D principal strain rates and deviatoric stresses in one pass.
+/*!
+Equivalent to calling compute_2D_principal_strain_rates() followed by
+compute_2D_stresses(), but evaluates the velocity gradient only once per grid cell and
+traverses the grid once. Used by the fracture density model, which needs both fields
+every time step.
+ */
+void compute_2D_strain_rates_and_stresses(const rheology::FlowLaw &flow_law,
+                                          const array::Vector1 &velocity,
+                                          const array::Scalar &hardness,
+                                          const array::CellType1 &cell_type,
+                                          array::Array2D<PrincipalStrainRates> &strain_rates,
+                                          array::Array2D<DeviatoricStresses> &stresses) {
+
+  auto grid = strain_rates.grid();
+
+  const double
+    dx = grid->dx(),
+    dy = grid->dy();
+
+  array::AccessScope list{&velocity, &hardness, &cell_type, &strain_rates, &stresses};
+
+  for (auto p : grid->points()) {
+    const int i = p.i(), j = p.j();
+
+    if (cell_type.ice_free(i, j)) {
+      strain_rates(i, j).eigen1 = 0.0;
+      strain_rates(i, j).eigen2 = 0.0;
+      stresses(i, j).xx         = 0.0;
+      stresses(i, j).yy         = 0.0;
+      stresses(i, j).xy         = 0.0;
+      continue;
+    }
+
+    double u_x, u_y, v_x, v_y;
+    weighted_velocity_gradient(velocity.star(i, j), cell_type.star(i, j), dx, dy,
+                               u_x, u_y, v_x, v_y);
+
+    strain_rates(i, j) = eigenvalues(u_x, u_y, v_x, v_y);
+
+    double nu = 0.0;
+    flow_law.effective_viscosity(hardness(i, j),
+                                 secondInvariant_2D({u_x, v_x}, {u_y, v_y}),
+                                 &nu, NULL);
+
+    stresses(i, j).xx = 2.0 * nu * u_x;
+    stresses(i, j).yy = 2.0 * nu * v_y;
+    stresses(i, j).xy = nu * (u_y + v_x);
+  }
+}
+
 
 } // end of namespace stressbalance
 } // end of namespace pism
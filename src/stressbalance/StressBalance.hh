@@ -19,10 +19,13 @@
 #ifndef _PISMSTRESSBALANCE_H_
 #define _PISMSTRESSBALANCE_H_
 
+#include <map>                  // std::map (the diagnostic cache)
 #include <memory>               // std::shared_ptr
 
 #include "pism/util/Component.hh"     // derives from Component
+#include "pism/util/Vector2d.hh"
 #include "pism/util/array/Array3D.hh"
+#include "pism/util/stencils.hh"
 #include "pism/stressbalance/timestepping.hh"
 
 namespace pism {
@@ -121,6 +124,12 @@ public:
 
   //! \brief Returns a pointer to a stress balance modifier implementation.
   const SSB_Modifier* modifier() const;
+
+  //! Intermediate fields (vertically-integrated velocity, strain rates, ...) shared by
+  //! several derived diagnostics and cached between diagnostic evaluations; see
+  //! shared_intermediate() in StressBalance_diagnostics.cc. update() drops cached
+  //! fields, so entries always describe the current model state.
+  std::map<std::string, std::shared_ptr<array::Array> >& diagnostic_cache() const;
 protected:
   virtual DiagnosticList spatial_diagnostics_impl() const;
   virtual TSDiagnosticList scalar_diagnostics_impl() const;
@@ -128,12 +137,7 @@ protected:
   virtual std::set<VariableMetadata> state_impl() const;
   virtual void write_state_impl(const OutputFile &output) const;
 
-  virtual void compute_vertical_velocity(const array::CellType1 &mask,
-                                         const array::Array3D &u,
-                                         const array::Array3D &v,
-                                         const array::Scalar *bmr,
-                                         array::Array3D &result);
-  virtual void compute_volumetric_strain_heating(const Inputs &inputs);
+  virtual void compute_vertical_velocity_and_strain_heating(const Inputs &inputs);
 
   CFLData m_cfl_2d, m_cfl_3d;
 
@@ -141,6 +145,9 @@ protected:
 
   std::shared_ptr<ShallowStressBalance> m_shallow_stress_balance;
   std::shared_ptr<SSB_Modifier> m_modifier;
+
+  //! see diagnostic_cache()
+  mutable std::map<std::string, std::shared_ptr<array::Array> > m_diagnostic_cache;
 };
 
 std::shared_ptr<StressBalance> create(const std::string &model_name,
@@ -152,6 +159,10 @@ struct PrincipalStrainRates {
   double eigen2;
 };
 
+PrincipalStrainRates principal_strain_rates(const stencils::Star<Vector2d> &velocity,
+                                            const stencils::Star<int> &cell_type,
+                                            double dx, double dy);
+
 void compute_2D_principal_strain_rates(const array::Vector1 &velocity,
                                        const array::CellType1 &mask,
                                        array::Array2D<PrincipalStrainRates> &result);
@@ -168,6 +179,13 @@ void compute_2D_stresses(const rheology::FlowLaw &flow_law,
                          const array::CellType1 &cell_type,
                          array::Array2D<DeviatoricStresses> &result);
 
+void compute_2D_strain_rates_and_stresses(const rheology::FlowLaw &flow_law,
+                                          const array::Vector1 &velocity,
+                                          const array::Scalar &hardness,
+                                          const array::CellType1 &cell_type,
+                                          array::Array2D<PrincipalStrainRates> &strain_rates,
+                                          array::Array2D<DeviatoricStresses> &stresses);
+
 } // end of namespace stressbalance
 } // end of namespace pism
 
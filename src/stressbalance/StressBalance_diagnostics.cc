@@ -36,6 +36,31 @@
 namespace pism {
 namespace stressbalance {
 
+//! Return an intermediate field shared by several derived diagnostics, computing it at
+//! most once per stress balance update.
+/*!
+  Many diagnostics below are built from the same intermediates (the
+  vertically-integrated velocity, the extrapolated vertical velocity, principal strain
+  rates) and from each other; when several of them appear in an `-extra_vars` list each
+  one used to recompute the whole chain. The cache lives in the StressBalance object (so
+  all diagnostic instances see it) and is dropped by StressBalance::update().
+
+  Consumers must treat the returned field as read-only; a diagnostic that modifies an
+  intermediate has to copy it first.
+ */
+template <class A, class F>
+static std::shared_ptr<const A> shared_intermediate(const StressBalance *model,
+                                                    const std::string &name, F &&compute) {
+  auto &cache = model->diagnostic_cache();
+
+  auto it = cache.find(name);
+  if (it == cache.end()) {
+    it = cache.emplace(name, compute()).first;
+  }
+
+  return array::cast<A>(it->second);
+}
+
 DiagnosticList StressBalance::spatial_diagnostics_impl() const {
   DiagnosticList result = {
     {"bfrict",              Diagnostic::Ptr(new PSB_bfrict(this))},
@@ -105,12 +130,13 @@ std::shared_ptr<array::Array> PSB_velbar::compute_impl() const {
   // get the thickness
   const array::Scalar* thickness = m_grid->variables().get_2d_scalar("land_ice_thickness");
 
-  // Compute the vertically-integrated horizontal ice flux:
-  auto result = array::cast<array::Vector>(PSB_flux(model).compute());
+  // Get the vertically-integrated horizontal ice flux (copy it: the cached field is
+  // shared with the "flux" diagnostic and we modify it below):
+  auto flux = shared_intermediate<array::Vector>(
+      model, "flux", [this] { return PSB_flux(model).compute(); });
 
-  // Override metadata set by the flux computation
-  result->metadata(0) = m_vars[0];
-  result->metadata(1) = m_vars[1];
+  auto result = allocate<array::Vector>("velbar");
+  result->copy_from(*flux);
 
   array::AccessScope list{thickness, result.get()};
 
@@ -149,7 +175,8 @@ std::shared_ptr<array::Array> PSB_velbar_mag::compute_impl() const {
   auto result = allocate<array::Scalar>("velbar_mag");
 
   // compute vertically-averaged horizontal velocity:
-  auto velbar = array::cast<array::Vector>(PSB_velbar(model).compute());
+  auto velbar = shared_intermediate<array::Vector>(
+      model, "velbar", [this] { return PSB_velbar(model).compute(); });
 
   // compute its magnitude:
   compute_magnitude(*velbar, *result);
@@ -294,7 +321,10 @@ PSB_velbase_mag::PSB_velbase_mag(const StressBalance *m)
 std::shared_ptr<array::Array> PSB_velbase_mag::compute_impl() const {
   auto result = allocate<array::Scalar>("velbase_mag");
 
-  compute_magnitude(*array::cast<array::Vector>(PSB_velbase(model).compute()), *result);
+  auto velbase = shared_intermediate<array::Vector>(
+      model, "velbase", [this] { return PSB_velbase(model).compute(); });
+
+  compute_magnitude(*velbase, *result);
 
   double fill_value = to_internal(m_fill_value);
 
@@ -329,7 +359,10 @@ std::shared_ptr<array::Array> PSB_velsurf_mag::compute_impl() const {
 
   auto result = allocate<array::Scalar>("velsurf_mag");
 
-  compute_magnitude(*array::cast<array::Vector>(PSB_velsurf(model).compute()), *result);
+  auto velsurf = shared_intermediate<array::Vector>(
+      model, "velsurf", [this] { return PSB_velsurf(model).compute(); });
+
+  compute_magnitude(*velsurf, *result);
 
   const auto &mask = *m_grid->variables().get_2d_cell_type("mask");
 
@@ -509,7 +542,8 @@ std::shared_ptr<array::Array> PSB_wvelsurf::compute_impl() const {
   auto result = allocate<array::Scalar>("wvelsurf");
 
   // here "false" means "don't fill w3 above the ice surface with zeros"
-  auto w3 = array::cast<array::Array3D>(PSB_wvel(model).compute(false));
+  auto w3 = shared_intermediate<array::Array3D>(
+      model, "wvel", [this] { return PSB_wvel(model).compute(false); });
 
   const array::Scalar *thickness = m_grid->variables().get_2d_scalar("land_ice_thickness");
 
@@ -553,7 +587,8 @@ std::shared_ptr<array::Array> PSB_wvelbase::compute_impl() const {
   auto result = allocate<array::Scalar>("wvelbase");
 
   // here "false" means "don't fill w3 above the ice surface with zeros"
-  auto w3 = array::cast<array::Array3D>(PSB_wvel(model).compute(false));
+  auto w3 = shared_intermediate<array::Array3D>(
+      model, "wvel", [this] { return PSB_wvel(model).compute(false); });
 
   extract_surface(*w3, 0.0, *result);
 
@@ -773,7 +808,8 @@ PSB_strain_rates::PSB_strain_rates(const StressBalance *m) : Diag<StressBalance>
 }
 
 std::shared_ptr<array::Array> PSB_strain_rates::compute_impl() const {
-  auto velbar = array::cast<array::Vector>(PSB_velbar(model).compute());
+  auto velbar = shared_intermediate<array::Vector>(
+      model, "velbar", [this] { return PSB_velbar(model).compute(); });
 
   auto result = std::make_shared<array::Array2D<PrincipalStrainRates> >(m_grid, "strain_rates",
                                                                         array::WITHOUT_GHOSTS);
@@ -823,7 +859,8 @@ std::shared_ptr<array::Array> PSB_deviatoric_stresses::compute_impl() const {
   averaged_hardness_vec(*model->shallow()->flow_law(), *thickness, *enthalpy, hardness);
 
   // copy_from updates ghosts
-  velocity.copy_from(*array::cast<array::Vector>(PSB_velbar(model).compute()));
+  velocity.copy_from(*shared_intermediate<array::Vector>(
+      model, "velbar", [this] { return PSB_velbar(model).compute(); }));
 
   array::CellType1 cell_type(m_grid, "cell_type");
   {
@@ -1003,11 +1040,13 @@ std::shared_ptr<array::Array> PSB_vonmises_stress::compute_impl() const {
 
   array::Scalar &vonmises_stress = *result;
 
-  auto velbar = array::cast<array::Vector>(PSB_velbar(model).compute());
-  array::Vector &velocity = *velbar;
+  auto velbar = shared_intermediate<array::Vector>(
+      model, "velbar", [this] { return PSB_velbar(model).compute(); });
+  const array::Vector &velocity = *velbar;
 
   using StrainRates = array::Array2D<PrincipalStrainRates>;
-  auto eigen12 = array::cast<StrainRates>(PSB_strain_rates(model).compute());
+  auto eigen12 = shared_intermediate<StrainRates>(
+      model, "strain_rates", [this] { return PSB_strain_rates(model).compute(); });
   const auto &strain_rates = *eigen12;
 
   const array::Scalar &ice_thickness = *m_grid->variables().get_2d_scalar("land_ice_thickness");
@@ -336,6 +336,39 @@ Blatter::Blatter(std::shared_ptr<const Grid> grid, int Mz, int coarsening_factor
     hardness = std::pow(softness, -1.0 / m_glen_exponent);
 
   m_scaling = m_rho_ice_g * hardness;
+
+  m_visc_cache_enabled = m_config->get_flag("stress_balance.blatter.viscosity_cache");
+  m_visc_cache_state   = CACHE_OFF;
+  m_visc_cache_valid   = false;
+  m_visc_cache_offset  = 0;
+  m_visc_cache_fingerprint = 0.0;
+  for (int n = 0; n < 6; ++n) {
+    m_visc_cache_dims[n] = -1;
+  }
+}
+
+/*!
+ * Computes a fingerprint of the current iterate (a deterministic function of
+ * locally-owned values of `X`).
+ *
+ * Used to check if the Jacobian is requested at the same iterate the residual
+ * was last evaluated at. (A fingerprint collision would make the solver use a
+ * slightly stale viscosity in the Jacobian; this can only affect the Newton
+ * convergence rate, not the converged solution, which is defined by the
+ * residual alone.)
+ */
+double Blatter::iterate_fingerprint(const DMDALocalInfo &info, const Vector2d ***X) const {
+  double result = 0.0;
+
+  for (int j = info.ys; j < info.ys + info.ym; j++) {
+    for (int i = info.xs; i < info.xs + info.xm; i++) {
+      for (int k = info.zs; k < info.zs + info.zm; k++) {
+        result += X[j][i][k].u + 1.5 * X[j][i][k].v; // STORAGE_ORDER
+      }
+    }
+  }
+
+  return result;
 }
 
 /*!
@@ -522,6 +555,31 @@ PetscErrorCode Blatter::setup(DM pism_da, grid::Periodicity periodicity, int Mz,
 #endif
                                     this); CHKERRQ(ierr);
 
+    // Select the way the Jacobian is applied. The matrix-free modes use
+    // finite differences of the residual to compute the action of the
+    // Jacobian, avoiding the (memory-hungry) sparse matrix assembly every
+    // Newton step:
+    //
+    // - "mf_operator" still assembles a matrix used for preconditioning, so it
+    //   is compatible with the geometric multigrid hierarchy set up above
+    //   (-bp_pc_type mg);
+    //
+    // - "matrix_free" does not assemble anything and requires a
+    //   matrix-free-compatible preconditioner.
+    //
+    // This is set before SNESSetFromOptions() so that -bp_snes_mf and
+    // -bp_snes_mf_operator can override it.
+    {
+      auto jacobian = m_config->get_string("stress_balance.blatter.jacobian");
+
+      if (jacobian == "mf_operator") {
+        ierr = SNESSetUseMatrixFree(m_snes, PETSC_TRUE, PETSC_FALSE); CHKERRQ(ierr);
+      } else if (jacobian == "matrix_free") {
+        ierr = SNESSetUseMatrixFree(m_snes, PETSC_FALSE, PETSC_TRUE); CHKERRQ(ierr);
+      }
+      // "assembled": keep the default set up using DMDASNESSetJacobianLocal() above
+    }
+
     ierr = SNESSetFromOptions(m_snes); CHKERRQ(ierr);
 
 
@@ -19,6 +19,8 @@
 #ifndef PISM_BLATTER_H
 #define PISM_BLATTER_H
 
+#include <vector>
+
 #include "pism/stressbalance/ShallowStressBalance.hh"
 #include "pism/util/petscwrappers/SNES.hh"
 #include "pism/util/petscwrappers/DM.hh"
@@ -103,6 +105,28 @@ protected:
   // True if the Eisenstat-Walker method of adjusting linear solver tolerances is enabled.
   bool m_ksp_use_ew;
 
+  // Cache of (eta, d eta / d gamma) pairs at quadrature points, used to share
+  // the effective viscosity work between residual and Jacobian evaluations
+  // (see stress_balance.blatter.viscosity_cache).
+  //
+  // The residual evaluation fills the cache (m_visc_cache_state == CACHE_FILL)
+  // and records a fingerprint of the current iterate; the Jacobian evaluation
+  // re-uses cached values (CACHE_READ) if it is called with the same iterate
+  // on the same grid level, and falls back to direct evaluation otherwise.
+  enum ViscosityCacheState { CACHE_OFF, CACHE_FILL, CACHE_READ };
+  ViscosityCacheState m_visc_cache_state;
+  bool m_visc_cache_enabled;
+  bool m_visc_cache_valid;
+  std::vector<double> m_visc_cache;
+  // cursor into m_visc_cache (set per element during the traversal)
+  size_t m_visc_cache_offset;
+  // fingerprint of the iterate the cache corresponds to
+  double m_visc_cache_fingerprint;
+  // dimensions of the (level-specific) element traversal the cache corresponds to
+  int m_visc_cache_dims[6];
+
+  double iterate_fingerprint(const DMDALocalInfo &info, const Vector2d ***X) const;
+
   static const int m_Nq = 100;
   static const int m_n_work = 9;
 
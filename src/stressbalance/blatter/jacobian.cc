@@ -48,7 +48,10 @@ void Blatter::jacobian_f(const fem::Q1Element3 &element,
   double *B = m_work[0];
 
   element.evaluate(u_nodal, u, u_x, u_y, u_z);
-  element.evaluate(B_nodal, B);
+  if (m_visc_cache_state != CACHE_READ) {
+    // ice hardness is only used to compute the effective viscosity
+    element.evaluate(B_nodal, B);
+  }
 
   // loop over all quadrature points
   for (unsigned int q = 0; q < element.n_pts(); ++q) {
@@ -62,53 +65,68 @@ void Blatter::jacobian_f(const fem::Q1Element3 &element,
       vy = u_y[q].v,
       vz = u_z[q].v;
 
-    double gamma = (ux * ux + vy * vy + ux * vy +
-                    0.25 * ((uy + vx) * (uy + vx) + uz * uz + vz * vz));
-
     double eta, deta;
-    m_flow_law->effective_viscosity(B[q], gamma, m_viscosity_eps, &eta, &deta);
+    if (m_visc_cache_state == CACHE_READ) {
+      eta  = m_visc_cache[m_visc_cache_offset + 2 * q + 0];
+      deta = m_visc_cache[m_visc_cache_offset + 2 * q + 1];
+    } else {
+      double gamma = (ux * ux + vy * vy + ux * vy +
+                      0.25 * ((uy + vx) * (uy + vx) + uz * uz + vz * vz));
+
+      m_flow_law->effective_viscosity(B[q], gamma, m_viscosity_eps, &eta, &deta);
+    }
 
     // add the enhancement factor
     eta *= m_E_viscosity;
     deta *= m_E_viscosity;
 
+    const fem::Germ *chi_q = element.chi_row(q);
+
+    // Partial derivatives of eta with respect to u_s and v_s (using the chain rule
+    // through gamma). They depend on the trial function index only, so hoist them out
+    // of the test/trial double loop below.
+    double eta_u[fem::q13d::n_chi], eta_v[fem::q13d::n_chi];
+    for (int s = 0; s < Nk; ++s) {
+      auto phi = chi_q[s];
+
+      // partial derivatives of gamma with respect to u_s and v_s
+      double
+        gamma_u = 2.0 * ux * phi.dx + vy * phi.dx + 0.5 * phi.dy * (uy + vx) + 0.5 * uz * phi.dz,
+        gamma_v = 2.0 * vy * phi.dy + ux * phi.dy + 0.5 * phi.dx * (uy + vx) + 0.5 * vz * phi.dz;
+
+      eta_u[s] = deta * gamma_u;
+      eta_v[s] = deta * gamma_v;
+    }
+
     // loop over test and trial functions, computing the upper-triangular part of
     // the element Jacobian
     for (int t = 0; t < Nk; ++t) {
-      auto psi = element.chi(q, t);
-      for (int s = t; s < Nk; ++s) {
-        auto phi = element.chi(q, s);
-
-        // partial derivatives of gamma with respect to u_i and v_i
-        double
-          gamma_u = 2.0 * ux * phi.dx + vy * phi.dx + 0.5 * phi.dy * (uy + vx) + 0.5 * uz * phi.dz,
-          gamma_v = 2.0 * vy * phi.dy + ux * phi.dy + 0.5 * phi.dx * (uy + vx) + 0.5 * vz * phi.dz;
+      auto psi = chi_q[t];
 
-        // partial derivatives of eta with respect to u_i and v_i, using chain rule
-        double
-          eta_u = deta * gamma_u,
-          eta_v = deta * gamma_v;
+      // F_u = grad(psi) . (4ux + 2vy, uy + vx, uz) and
+      // F_v = grad(psi) . (uy + vx, 4vy + 2ux, vz); these depend on the test function
+      // index only
+      double
+        F_u = (psi.dx * (4.0 * ux + 2.0 * vy) + psi.dy * (uy + vx) + psi.dz * uz),
+        F_v = (psi.dx * (uy + vx) + psi.dy * (4.0 * vy + 2.0 * ux) + psi.dz * vz);
 
-        // F_u = grad(psi) . (4ux + 2vy, uy + vx, uz) and
-        // F_v = grad(psi) . (uy + vx, 4vy + 2ux, vz)
-        double
-          F_u = (psi.dx * (4.0 * ux + 2.0 * vy) + psi.dy * (uy + vx) + psi.dz * uz),
-          F_v = (psi.dx * (uy + vx) + psi.dy * (4.0 * vy + 2.0 * ux) + psi.dz * vz);
+      for (int s = t; s < Nk; ++s) {
+        auto phi = chi_q[s];
 
-        // partial derivatives of F_u with respect to u_i and v_i
+        // partial derivatives of F_u with respect to u_s and v_s
         double
           F_uu = 4.0 * psi.dx * phi.dx + psi.dy * phi.dy + psi.dz * phi.dz,
           F_uv = 2.0 * psi.dx * phi.dy + psi.dy * phi.dx;
 
-        // partial derivatives of F_v with respect to u_i and v_i
+        // partial derivatives of F_v with respect to u_s and v_s
         double
           F_vu = 2.0 * psi.dy * phi.dx + psi.dx * phi.dy,
           F_vv = 4.0 * psi.dy * phi.dy + psi.dx * phi.dx + psi.dz * phi.dz;
 
-        K[t * 2 + 0][s * 2 + 0] += W * (eta * F_uu + eta_u * F_u);
-        K[t * 2 + 0][s * 2 + 1] += W * (eta * F_uv + eta_v * F_u);
-        K[t * 2 + 1][s * 2 + 0] += W * (eta * F_vu + eta_u * F_v);
-        K[t * 2 + 1][s * 2 + 1] += W * (eta * F_vv + eta_v * F_v);
+        K[t * 2 + 0][s * 2 + 0] += W * (eta * F_uu + eta_u[s] * F_u);
+        K[t * 2 + 0][s * 2 + 1] += W * (eta * F_uv + eta_v[s] * F_u);
+        K[t * 2 + 1][s * 2 + 0] += W * (eta * F_vu + eta_u[s] * F_v);
+        K[t * 2 + 1][s * 2 + 1] += W * (eta * F_vv + eta_v[s] * F_v);
       }
     }
   } // end of the loop over q
@@ -131,26 +149,34 @@ void Blatter::jacobian_basal(const fem::Q1Element3Face &face,
 
   double
     *tauc       = m_work[0],
-    *floatation = m_work[1];
+    *floatation = m_work[1],
+    *beta_law   = m_work[2],
+    *dbeta_law  = m_work[3];
 
   face.evaluate(u_nodal, u);
   face.evaluate(tauc_nodal, tauc);
   face.evaluate(f_nodal, floatation);
 
+  // basal drag coefficients and their derivatives from the sliding law, for all
+  // quadrature points at once (used at grounded locations only)
+  m_basal_sliding_law->drag_with_derivative_n(tauc, u, face.n_pts(), beta_law, dbeta_law);
+
   for (unsigned int q = 0; q < face.n_pts(); ++q) {
     auto W = face.weight(q) / m_scaling;
 
     bool grounded = floatation[q] <= 0.0;
     double beta = 0.0, dbeta = 0.0;
     if (grounded) {
-      m_basal_sliding_law->drag_with_derivative(tauc[q], u[q].u, u[q].v, &beta, &dbeta);
+      beta  = beta_law[q];
+      dbeta = dbeta_law[q];
     }
 
     // loop over all test functions
+    const double *chi_q = face.chi_row(q);
     for (int t = 0; t < Nk; ++t) {
-      auto psi = face.chi(q, t);
+      auto psi = chi_q[t];
       for (int s = 0; s < Nk; ++s) {
-        auto phi = face.chi(q, s);
+        auto phi = chi_q[s];
 
         double p = psi * phi;
 
@@ -256,6 +282,17 @@ void Blatter::compute_jacobian(DMDALocalInfo *petsc_info,
   array::AccessScope list(m_parameters);
   auto *P = m_parameters.array();
 
+  // Use the viscosity cache filled during the residual evaluation if it
+  // corresponds to the same grid level (on coarser multigrid levels it does
+  // not) and the same iterate.
+  if (m_visc_cache_enabled and m_visc_cache_valid and
+      info.gxs == m_visc_cache_dims[0] and info.gxm == m_visc_cache_dims[1] and
+      info.gys == m_visc_cache_dims[2] and info.gym == m_visc_cache_dims[3] and
+      info.gzs == m_visc_cache_dims[4] and info.gzm == m_visc_cache_dims[5] and
+      iterate_fingerprint(info, X) == m_visc_cache_fingerprint) {
+    m_visc_cache_state = CACHE_READ;
+  }
+
   // loop over all the elements that have at least one owned node
   for (int j = info.gys; j < info.gys + info.gym - 1; j++) {
     for (int i = info.gxs; i < info.gxs + info.gxm - 1; i++) {
@@ -308,6 +345,11 @@ void Blatter::compute_jacobian(DMDALocalInfo *petsc_info,
 
         element.nodal_values((double***)hardness, B_nodal);
 
+        if (m_visc_cache_state == CACHE_READ) {
+          m_visc_cache_offset = (((size_t)(j - info.gys) * (info.gxm - 1) + (i - info.gxs)) *
+                                 (info.gzm - 1) + (k - info.gzs)) * element.n_pts() * 2;
+        }
+
         jacobian_f(element, velocity, B_nodal, K);
 
         // basal boundary
@@ -342,6 +384,8 @@ void Blatter::compute_jacobian(DMDALocalInfo *petsc_info,
     } // end of the loop over j
   } // end of the loop over k
 
+  m_visc_cache_state = CACHE_OFF;
+
   jacobian_dirichlet(info, P, J);
 
   ierr = MatAssemblyBegin(J, MAT_FINAL_ASSEMBLY); PISM_CHK(ierr, "MatAssemblyBegin");
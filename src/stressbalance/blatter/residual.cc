@@ -69,21 +69,34 @@ void Blatter::residual_f(const fem::Q1Element3 &element,
                     0.25 * ((uy + vx) * (uy + vx) + uz * uz + vz * vz));
 
     double eta;
-    m_flow_law->effective_viscosity(B[q], gamma, m_viscosity_eps, &eta, nullptr);
+    if (m_visc_cache_state == CACHE_FILL) {
+      // also compute d eta / d gamma and save both for the Jacobian evaluation
+      double deta;
+      m_flow_law->effective_viscosity(B[q], gamma, m_viscosity_eps, &eta, &deta);
+
+      m_visc_cache[m_visc_cache_offset + 2 * q + 0] = eta;
+      m_visc_cache[m_visc_cache_offset + 2 * q + 1] = deta;
+    } else {
+      m_flow_law->effective_viscosity(B[q], gamma, m_viscosity_eps, &eta, nullptr);
+    }
 
     // add the enhancement factor
     eta *= m_E_viscosity;
 
+    // deviatoric stress combinations entering the weak form; they do not depend on the
+    // test function, so compute them once per quadrature point
+    const double
+      tau_u = 4.0 * ux + 2.0 * vy,
+      tau_v = 2.0 * ux + 4.0 * vy,
+      shear = uy + vx;
+
     // loop over all test functions
+    const fem::Germ *chi_q = element.chi_row(q);
     for (int t = 0; t < element.n_chi(); ++t) {
-      const auto &psi = element.chi(q, t);
-
-      residual[t].u += W * (eta * (psi.dx * (4.0 * ux + 2.0 * vy) +
-                                   psi.dy * (uy + vx) +
-                                   psi.dz * uz));
-      residual[t].v += W * (eta * (psi.dx * (uy + vx) +
-                                   psi.dy * (2.0 * ux + 4.0 * vy) +
-                                   psi.dz * vz));
+      const auto &psi = chi_q[t];
+
+      residual[t].u += W * (eta * (psi.dx * tau_u + psi.dy * shear + psi.dz * uz));
+      residual[t].v += W * (eta * (psi.dx * shear + psi.dy * tau_v + psi.dz * vz));
     }
   }
 }
@@ -148,8 +161,9 @@ void Blatter::residual_source_term(const fem::Q1Element3 &element,
     auto F = m_rho_ice_g * Vector2d(s_x[q], s_y[q]);
 
     // loop over all test functions
+    const fem::Germ *chi_q = element.chi_row(q);
     for (int t = 0; t < element.n_chi(); ++t) {
-      const auto &psi = element.chi(q, t);
+      const auto &psi = chi_q[t];
 
       residual[t] += W * psi.val * F;
     }
@@ -172,21 +186,27 @@ void Blatter::residual_basal(const fem::Q1Element3 &element,
 
   double
     *tauc       = m_work[0],
-    *floatation = m_work[1];
+    *floatation = m_work[1],
+    *beta_law   = m_work[2];
 
   face.evaluate(u_nodal, u);
   face.evaluate(tauc_nodal, tauc);
   face.evaluate(f_nodal, floatation);
 
+  // basal drag coefficients from the sliding law, for all quadrature points at once
+  // (used at grounded locations only)
+  m_basal_sliding_law->drag_n(tauc, u, face.n_pts(), beta_law);
+
   for (unsigned int q = 0; q < face.n_pts(); ++q) {
     auto W = face.weight(q) / m_scaling;
 
     bool grounded = floatation[q] <= 0.0;
-    double beta = grounded ? m_basal_sliding_law->drag(tauc[q], u[q].u, u[q].v) : 0.0;
+    double beta = grounded ? beta_law[q] : 0.0;
 
     // loop over all test functions
+    const double *chi_q = face.chi_row(q);
     for (int t = 0; t < element.n_chi(); ++t) {
-      auto psi = face.chi(q, t);
+      auto psi = chi_q[t];
 
       residual[t] += W * psi * beta * u[q];
     }
@@ -244,8 +264,9 @@ void Blatter::residual_lateral(const fem::Q1Element3 &element,
       p_ocean     = m_rho_ocean_g * water_depth;
 
     // loop over all test functions
+    const double *chi_q = face.chi_row(q);
     for (int t = 0; t < element.n_chi(); ++t) {
-      auto psi = face.chi(q, t);
+      auto psi = chi_q[t];
 
       residual[t] += - W * psi * (p_ice - p_ocean) * N;
     }
@@ -354,6 +375,27 @@ void Blatter::compute_residual(DMDALocalInfo *petsc_info,
   // Compute the residual at Dirichlet nodes and set it to zero elsewhere.
   residual_dirichlet(info, P, X, R);
 
+  // Prepare the viscosity cache: the Jacobian evaluation that follows this
+  // residual evaluation uses the same iterate, so (eta, d eta / d gamma) at
+  // quadrature points can be computed once, here.
+  if (m_visc_cache_enabled) {
+    const size_t n_elements =
+        (size_t)(info.gxm - 1) * (info.gym - 1) * (info.gzm - 1);
+
+    m_visc_cache.resize(n_elements * element.n_pts() * 2);
+
+    m_visc_cache_state       = CACHE_FILL;
+    m_visc_cache_valid       = false; // invalid until this evaluation is complete
+    m_visc_cache_fingerprint = iterate_fingerprint(info, X);
+
+    m_visc_cache_dims[0] = info.gxs;
+    m_visc_cache_dims[1] = info.gxm;
+    m_visc_cache_dims[2] = info.gys;
+    m_visc_cache_dims[3] = info.gym;
+    m_visc_cache_dims[4] = info.gzs;
+    m_visc_cache_dims[5] = info.gzm;
+  }
+
   // loop over all the elements that have at least one owned node
   for (int j = info.gys; j < info.gys + info.gym - 1; j++) {
     for (int i = info.gxs; i < info.gxs + info.gxm - 1; i++) {
@@ -407,6 +449,11 @@ void Blatter::compute_residual(DMDALocalInfo *petsc_info,
         // Get nodal values of ice hardness.
         element.nodal_values((double***)ice_hardness, B);
 
+        if (m_visc_cache_state == CACHE_FILL) {
+          m_visc_cache_offset = (((size_t)(j - info.gys) * (info.gxm - 1) + (i - info.gxs)) *
+                                 (info.gzm - 1) + (k - info.gzs)) * element.n_pts() * 2;
+        }
+
         // "main" part of the residual
         residual_f(element, velocity, B, R_nodal);
 
@@ -453,6 +500,11 @@ void Blatter::compute_residual(DMDALocalInfo *petsc_info,
       } // end of the loop over i
     } // end of the loop over j
   } // end of the loop over k
+
+  if (m_visc_cache_state == CACHE_FILL) {
+    m_visc_cache_state = CACHE_OFF;
+    m_visc_cache_valid = true;
+  }
 }
 
 PetscErrorCode Blatter::function_callback(DMDALocalInfo *info,
@@ -16,7 +16,9 @@
 // along with PISM; if not, write to the Free Software
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
+#include <algorithm>            // std::max
 #include <cassert>
+#include <cmath>                // ceil
 
 #include "pism/stressbalance/sia/BedSmoother.hh"
 #include "pism/util/Context.hh"
@@ -24,6 +26,7 @@
 #include "pism/util/Logger.hh"
 #include "pism/util/array/CellType.hh"
 #include "pism/util/error_handling.hh"
+#include "pism/util/io/File.hh"
 #include "pism/util/petscwrappers/Vec.hh"
 #include "pism/util/pism_utilities.hh"
 #include "pism/util/VariableMetadata.hh"
@@ -38,7 +41,7 @@ BedSmoother::BedSmoother(std::shared_ptr<const Grid> g)
       m_maxtl(m_grid, "maxtl"),
       m_C2(m_grid, "C2bedsmooth"),
       m_C3(m_grid, "C3bedsmooth"),
-      m_C4(m_grid, "C3bedsmooth")
+      m_C4(m_grid, "C4bedsmooth")
 {
 
   const Logger &log = *m_grid->ctx()->log();
@@ -86,6 +89,9 @@ BedSmoother::BedSmoother(std::shared_ptr<const Grid> g)
   // initialized right after construction and users don't have to call preprocess_bed() manually.
   m_Nx = -1;
   m_Ny = -1;
+
+  m_bed_state_counter = -1;
+  m_read_from_file = false;
 }
 
 
@@ -96,6 +102,21 @@ default case.
  */
 void BedSmoother::preprocess_bed(const array::Scalar &topg) {
 
+  if (topg.state_counter() == m_bed_state_counter) {
+    // The bed elevation did not change since the last call: the smoothed bed
+    // and the theta coefficients are up to date, so there is nothing to do.
+    return;
+  }
+  m_bed_state_counter = topg.state_counter();
+
+  if (m_read_from_file) {
+    // The smoothed bed and the theta coefficients were read from an input
+    // file during initialization and correspond to this bed elevation: use
+    // them as is. Later calls (after a bed deformation step, say) recompute.
+    m_read_from_file = false;
+    return;
+  }
+
   if (m_smoothing_range <= 0.0) {
     // smoothing completely inactive.  we transfer the original bed topg,
     //   including ghosts, to public member topgsmooth ...
@@ -123,6 +144,62 @@ const array::Scalar& BedSmoother::smoothed_bed() const {
   return m_topgsmooth;
 }
 
+//! Metadata of the smoothed-bed products saved in output files.
+std::set<VariableMetadata> BedSmoother::state() const {
+  if (m_smoothing_range <= 0.0) {
+    return {};
+  }
+  return array::metadata({ &m_topgsmooth, &m_maxtl, &m_C2, &m_C3, &m_C4 });
+}
+
+//! Write the smoothed bed and the theta coefficients to an output file.
+void BedSmoother::write(const OutputFile &output) const {
+  if (m_smoothing_range <= 0.0) {
+    return;
+  }
+  m_topgsmooth.write(output);
+  m_maxtl.write(output);
+  m_C2.write(output);
+  m_C3.write(output);
+  m_C4.write(output);
+}
+
+//! Read the smoothed bed and the theta coefficients from an input file.
+/*!
+  Returns `true` if all the products were found and read, in which case the
+  next preprocess_bed() call will re-use them instead of recomputing, skipping
+  the startup smoothing. Returns `false` (and leaves this object unmodified)
+  otherwise.
+
+  The products in the file have to correspond to the bed elevation in the same
+  file, which is the case when PISM is re-starting from its own output.
+ */
+bool BedSmoother::read(const File &input_file, unsigned int record) {
+  if (m_smoothing_range <= 0.0) {
+    return false;
+  }
+
+  for (const auto *v : { &m_topgsmooth, &m_maxtl, &m_C2, &m_C3, &m_C4 }) {
+    if (not input_file.variable_exists(v->metadata().get_name())) {
+      return false;
+    }
+  }
+
+  m_topgsmooth.read(input_file, record);
+  m_maxtl.read(input_file, record);
+  m_C2.read(input_file, record);
+  m_C3.read(input_file, record);
+  m_C4.read(input_file, record);
+
+  // set Nx, Ny the way preprocess_bed() would
+  m_Nx = std::max(static_cast<int>(ceil(m_smoothing_range / m_grid->dx())), 1);
+  m_Ny = std::max(static_cast<int>(ceil(m_smoothing_range / m_grid->dy())), 1);
+
+  m_read_from_file = true;
+
+  return true;
+}
+
 /*!
 Inputs Nx,Ny gives half-width in number of grid points, over which to do the
 average.
@@ -28,6 +28,8 @@ namespace pism {
 
 class Grid;
 class Config;
+class File;
+class OutputFile;
 
 namespace array {
 class CellType1;
@@ -56,7 +58,9 @@ namespace stressbalance {
 
   The call to `preprocess_bed()` *must be repeated* any time the "original"
   topography changes, for instance at the start of an IceModel run, or at a bed
-  deformation step in an IceModel run.
+  deformation step in an IceModel run.  Repeated calls with an unchanged bed
+  are cheap: the state counter of the input topography (see array::Array) is
+  used to detect that nothing needs to be recomputed.
 
   BedSmoother then provides three major functionalities, all of which \e must
   \e follow the call to `preprocess_bed()`:
@@ -97,6 +101,12 @@ public:
   void theta(const array::Scalar &usurf, array::Scalar &result) const;
 
   const array::Scalar& smoothed_bed() const;
+
+  std::set<VariableMetadata> state() const;
+
+  void write(const OutputFile &output) const;
+
+  bool read(const File &input_file, unsigned int record);
 protected:
   std::shared_ptr<const Grid> m_grid;
   std::shared_ptr<const Config> m_config;
@@ -111,6 +121,14 @@ protected:
    */
   int m_Nx, m_Ny;
 
+  //! state counter of the bed elevation the current smoothed products
+  //! correspond to; used to skip recomputation when the bed is unchanged
+  int m_bed_state_counter;
+
+  //! true if the smoothed products were read from an input file and the next
+  //! preprocess_bed() call can re-use them
+  bool m_read_from_file;
+
   double m_Glen_exponent, m_smoothing_range;
 
   //! original bed elevation on processor 0
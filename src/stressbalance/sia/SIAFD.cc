@@ -23,6 +23,8 @@
 #include "pism/stressbalance/sia/SIAFD.hh"
 #include "pism/geometry/Geometry.hh"
 #include "pism/rheology/FlowLawFactory.hh"
+#include "pism/rheology/GPBLD.hh"
+#include "pism/rheology/PatersonBudd.hh"
 #include "pism/rheology/grain_size_vostok.hh"
 #include "pism/stressbalance/StressBalance.hh"
 #include "pism/util/EnthalpyConverter.hh"
@@ -32,6 +34,8 @@
 #include "pism/util/array/CellType.hh"
 #include "pism/util/array/Scalar.hh"
 #include "pism/util/error_handling.hh"
+#include "pism/util/io/File.hh"
+#include "pism/util/io/IO_Flags.hh"
 #include "pism/util/pism_utilities.hh"
 #include "pism/util/array/Vector.hh"
 #include "pism/util/Logger.hh"
@@ -39,6 +43,31 @@
 namespace pism {
 namespace stressbalance {
 
+namespace {
+
+//! Fallback batched flow-law kernel: one virtual dispatch per span.
+void flow_n_generic(const rheology::FlowLaw &law, const double *stress, const double *E,
+                    const double *pressure, const double *grainsize, unsigned int n,
+                    double *result) {
+  law.flow_n(stress, E, pressure, grainsize, n, result);
+}
+
+//! Devirtualized batched flow-law kernel.
+/*!
+ * `Law` is the statically-known concrete type of `law`. Combined with the `final`
+ * markers on GPBLD and PatersonBudd::flow_n_impl() and the inline FlowLaw::flow_n(),
+ * instantiations of this template compile to a direct call into the law's batched
+ * implementation, so the flow-law arithmetic can inline and vectorize.
+ */
+template <class Law>
+void flow_n_specialized(const rheology::FlowLaw &law, const double *stress, const double *E,
+                        const double *pressure, const double *grainsize, unsigned int n,
+                        double *result) {
+  static_cast<const Law &>(law).flow_n(stress, E, pressure, grainsize, n, result);
+}
+
+} // end of anonymous namespace
+
 SIAFD::SIAFD(std::shared_ptr<const Grid> g)
     : SSB_Modifier(std::move(g)),
       m_stencil_width(m_config->get_number("grid.max_stencil_width")),
@@ -47,8 +76,8 @@ SIAFD::SIAFD(std::shared_ptr<const Grid> g)
       m_h_x(m_grid, "h_x"),
       m_h_y(m_grid, "h_y"),
       m_D(m_grid, "diffusivity"),
-      m_delta_0(m_grid, "delta_0", array::WITH_GHOSTS, m_grid->z()),
-      m_delta_1(m_grid, "delta_1", array::WITH_GHOSTS, m_grid->z()),
+      m_delta_0(m_grid, "delta_0", m_grid->Mz(), 1),
+      m_delta_1(m_grid, "delta_1", m_grid->Mz(), 1),
       m_work_3d_0(m_grid, "work_3d_0", array::WITH_GHOSTS, m_grid->z()),
       m_work_3d_1(m_grid, "work_3d_1", array::WITH_GHOSTS, m_grid->z()) {
   // bed smoother
@@ -66,6 +95,17 @@ SIAFD::SIAFD(std::shared_ptr<const Grid> g)
                                     m_config->get_number("stress_balance.sia.Glen_exponent"));
   }
 
+  // Select the batched flow-law kernel once, here: the laws we run most (GPBLD and the
+  // Paterson-Budd family) get devirtualized instantiations, everything else falls back
+  // to the virtual call.
+  if (dynamic_cast<const rheology::GPBLD *>(m_flow_law.get()) != nullptr) {
+    m_flow_n = flow_n_specialized<rheology::GPBLD>;
+  } else if (dynamic_cast<const rheology::PatersonBudd *>(m_flow_law.get()) != nullptr) {
+    m_flow_n = flow_n_specialized<rheology::PatersonBudd>;
+  } else {
+    m_flow_n = flow_n_generic;
+  }
+
   const bool compute_grain_size_using_age =
       m_config->get_flag("stress_balance.sia.grain_size_age_coupling");
   const bool age_model_enabled = m_config->get_flag("age.enabled");
@@ -95,6 +135,25 @@ SIAFD::SIAFD(std::shared_ptr<const Grid> g)
   m_eemian_start   = m_config->get_number("time.eemian_start", "seconds");
   m_eemian_end     = m_config->get_number("time.eemian_end", "seconds");
   m_holocene_start = m_config->get_number("time.holocene_start", "seconds");
+
+  // Select the surface gradient scheme once, here: compute_surface_gradient() runs every
+  // time step and should not re-parse the configuration string.
+  {
+    auto method = m_config->get_string("stress_balance.sia.surface_gradient_method");
+
+    if (method == "eta") {
+      m_surface_gradient_method = GRADIENT_ETA;
+    } else if (method == "haseloff") {
+      m_surface_gradient_method = GRADIENT_HASELOFF;
+    } else if (method == "mahaffy") {
+      m_surface_gradient_method = GRADIENT_MAHAFFY;
+    } else {
+      throw RuntimeError::formatted(
+          PISM_ERROR_LOCATION,
+          "value of sia.surface_gradient_method, option '-gradient %s', is not valid",
+          method.c_str());
+    }
+  }
 }
 
 SIAFD::~SIAFD() {
@@ -119,6 +178,20 @@ void SIAFD::init() {
                    "  e=%f for ice accumulated during glacial periods\n",
                    m_e_factor_interglacial, m_e_factor);
   }
+
+  // Check if PISM is being initialized from an output file from a previous
+  // run and re-use the smoothed-bed products saved by BedSmoother (unless
+  // asked not to). This skips the (serial) bed smoothing at startup.
+  InputOptions opts = process_input_options(m_grid->com, m_config);
+  if (opts.type == INIT_RESTART and
+      m_config->get_flag("stress_balance.sia.bed_smoother.read_smoothed_bed")) {
+    File input_file(m_grid->com, opts.filename, io::PISM_GUESS, io::PISM_READONLY);
+
+    if (m_bed_smoother->read(input_file, input_file.nrecords() - 1)) {
+      m_log->message(3, "  re-using the smoothed bed saved in '%s'...\n",
+                     opts.filename.c_str());
+    }
+  }
 }
 
 //! \brief Do the update; if full_update == false skip the update of 3D velocities and strain
@@ -190,26 +263,18 @@ void SIAFD::update(const array::Vector &sliding_velocity, const Inputs &inputs,
 void SIAFD::compute_surface_gradient(const Inputs &inputs, array::Staggered1 &h_x,
                                      array::Staggered1 &h_y) {
 
-  const std::string method = m_config->get_string("stress_balance.sia.surface_gradient_method");
-
-  if (method == "eta") {
-
+  // the scheme is selected (and the configuration string validated) in the constructor
+  switch (m_surface_gradient_method) {
+  case GRADIENT_ETA:
     surface_gradient_eta(inputs.geometry->ice_thickness, inputs.geometry->bed_elevation, h_x, h_y);
-
-  } else if (method == "haseloff") {
-
+    break;
+  case GRADIENT_HASELOFF:
     surface_gradient_haseloff(inputs.geometry->ice_surface_elevation, inputs.geometry->cell_type,
                               h_x, h_y);
-
-  } else if (method == "mahaffy") {
-
+    break;
+  case GRADIENT_MAHAFFY:
     surface_gradient_mahaffy(inputs.geometry->ice_surface_elevation, h_x, h_y);
-
-  } else {
-    throw RuntimeError::formatted(
-        PISM_ERROR_LOCATION,
-        "value of sia.surface_gradient_method, option '-gradient %s', is not valid",
-        method.c_str());
+    break;
   }
 }
 
@@ -233,7 +298,11 @@ void SIAFD::surface_gradient_eta(const array::Scalar2 &ice_thickness,
   for (auto p : m_grid->points_with_ghosts(GHOSTS)) {
     const int i = p.i(), j = p.j();
 
-    eta(i, j) = pow(ice_thickness(i, j), etapow);
+    double H = ice_thickness(i, j);
+
+    // pow(0, etapow) == 0, so the (expensive) pow() call can be skipped in ice-free
+    // cells, which usually make up most of the domain
+    eta(i, j) = H > 0.0 ? pow(H, etapow) : 0.0;
   }
 
   // now use Mahaffy on eta to get grad h on staggered;
@@ -243,7 +312,9 @@ void SIAFD::surface_gradient_eta(const array::Scalar2 &ice_thickness,
   assert(h_x.stencil_width() >= 1);
   assert(h_y.stencil_width() >= 1);
 
-  for (auto p : m_grid->points_with_ghosts(1)) {
+  // this is a point-wise stencil pass touching four fields, so use the
+  // cache-blocked traversal
+  for (auto p : m_grid->tiled_points(1)) {
     const int i = p.i(), j = p.j();
 
     auto b = bed_elevation.box(i, j);
@@ -300,7 +371,7 @@ void SIAFD::surface_gradient_mahaffy(const array::Scalar &ice_surface_elevation,
   // surface elevation needs more ghosts
   assert(h.stencil_width() >= 2);
 
-  for (auto p : m_grid->points_with_ghosts(1)) {
+  for (auto p : m_grid->tiled_points(1)) {
     const int i = p.i(), j = p.j();
 
     // I-offset
@@ -452,6 +523,14 @@ void SIAFD::surface_gradient_haseloff(const array::Scalar2 &ice_surface_elevatio
         }
       }
     } // end of "x-derivative, j-offset"
+  }
+
+  // h_x is complete: post its halo exchange and let it proceed while we
+  // average the y-components
+  h_x.update_ghosts_begin();
+
+  for (auto p : m_grid->points()) {
+    const int i = p.i(), j = p.j();
 
     // y-derivative, i-offset
     {
@@ -483,7 +562,9 @@ void SIAFD::surface_gradient_haseloff(const array::Scalar2 &ice_surface_elevatio
     } // end of "y-derivative, i-offset"
   }
 
-  h_x.update_ghosts();
+  // Note: h_x and h_y use the same DM (and so the same scatter context), so
+  // their exchanges cannot be in flight at the same time.
+  h_x.update_ghosts_end();
   h_y.update_ghosts();
 }
 
@@ -532,9 +613,15 @@ void SIAFD::compute_diffusivity(bool full_update, const Geometry &geometry,
                                 const array::Array3D *enthalpy, const array::Array3D *age,
                                 const array::Staggered1 &h_x, const array::Staggered1 &h_y,
                                 array::Staggered1 &result) {
+
+  if (m_config->get_flag("stress_balance.sia.vectorized_diffusivity")) {
+    compute_diffusivity_batched(full_update, geometry, enthalpy, age, h_x, h_y, result);
+    return;
+  }
+
   array::Scalar2 &thk_smooth = m_work_2d_0, &theta = m_work_2d_1;
 
-  array::Array3D *delta[] = { &m_delta_0, &m_delta_1 };
+  array::Float3D *delta[] = { &m_delta_0, &m_delta_1 };
 
   result.set(0.0);
 
@@ -565,7 +652,6 @@ void SIAFD::compute_diffusivity(bool full_update, const Geometry &geometry,
   }
 
   if (full_update) {
-    list.add({ delta[0], delta[1] });
     assert(m_delta_0.stencil_width() >= 1);
     assert(m_delta_1.stencil_width() >= 1);
   }
@@ -659,8 +745,8 @@ void SIAFD::compute_diffusivity(bool full_update, const Geometry &geometry,
           stress[k] = alpha * pressure[k];
         }
 
-        m_flow_law->flow_n(stress.data(), E.data(), pressure.data(), ice_grain_size.data(), ks + 1,
-                           flow.data());
+        m_flow_n(*m_flow_law, stress.data(), E.data(), pressure.data(), ice_grain_size.data(),
+                 ks + 1, flow.data());
 
         const double theta_local = 0.5 * (theta(i, j) + theta(i + oi, j + oj));
         for (int k = 0; k <= ks; ++k) {
@@ -747,6 +833,252 @@ void SIAFD::compute_diffusivity(bool full_update, const Geometry &geometry,
   }
 }
 
+//! \brief Row-batched variant of compute_diffusivity().
+/*!
+ * Computes the same quantities as compute_diffusivity(), but gathers inputs of
+ * the flow law (stress, enthalpy, pressure, grain size) for a whole grid row
+ * into contiguous buffers and makes *one* FlowLaw::flow_n() call per row
+ * instead of one call per staggered point. This amortizes virtual dispatch and
+ * gives flow law implementations long contiguous spans that auto-vectorize
+ * well (see GPBLD::flow_n_impl()).
+ *
+ * Selected at runtime using stress_balance.sia.vectorized_diffusivity.
+ */
+void SIAFD::compute_diffusivity_batched(bool full_update, const Geometry &geometry,
+                                        const array::Array3D *enthalpy, const array::Array3D *age,
+                                        const array::Staggered1 &h_x, const array::Staggered1 &h_y,
+                                        array::Staggered1 &result) {
+  array::Scalar2 &thk_smooth = m_work_2d_0, &theta = m_work_2d_1;
+
+  array::Float3D *delta[] = { &m_delta_0, &m_delta_1 };
+
+  result.set(0.0);
+
+  const double current_time = time().current(),
+               D_limit      = m_config->get_number("stress_balance.sia.max_diffusivity");
+
+  const bool compute_grain_size_using_age =
+                 m_config->get_flag("stress_balance.sia.grain_size_age_coupling"),
+             e_age_coupling    = m_config->get_flag("stress_balance.sia.e_age_coupling"),
+             limit_diffusivity = m_config->get_flag("stress_balance.sia.limit_diffusivity"),
+             use_age           = compute_grain_size_using_age or e_age_coupling;
+
+  rheology::grain_size_vostok gs_vostok;
+
+  m_bed_smoother->theta(geometry.ice_surface_elevation, theta);
+
+  m_bed_smoother->smoothed_thk(geometry.ice_surface_elevation, geometry.ice_thickness,
+                               geometry.cell_type, thk_smooth);
+
+  array::AccessScope list{ &result, &theta, &thk_smooth, &h_x, &h_y, enthalpy };
+
+  if (use_age) {
+    assert(age->stencil_width() >= 2);
+    list.add(*age);
+  }
+
+  if (full_update) {
+    assert(m_delta_0.stencil_width() >= 1);
+    assert(m_delta_1.stencil_width() >= 1);
+  }
+
+  assert(theta.stencil_width() >= 2);
+  assert(thk_smooth.stencil_width() >= 2);
+  assert(result.stencil_width() >= 1);
+  assert(h_x.stencil_width() >= 1);
+  assert(h_y.stencil_width() >= 1);
+  assert(enthalpy->stencil_width() >= 2);
+
+  const std::vector<double> &z = m_grid->z();
+  const unsigned int Mx = m_grid->Mx(), My = m_grid->My(), Mz = m_grid->Mz();
+
+  // rows include one ghost point on each side:
+  const int i_first = m_grid->xs() - 1, i_last = m_grid->xs() + m_grid->xm(),
+            j_first = m_grid->ys() - 1, j_last = m_grid->ys() + m_grid->ym();
+
+  const unsigned int row_width = i_last - i_first + 1;
+
+  const double gs_default = m_config->get_number("constants.ice.grain_size", "m");
+
+  // contiguous per-row buffers: each staggered point in a row contributes
+  // ks+1 levels, packed back to back
+  std::vector<double> depth(row_width * Mz), stress(row_width * Mz), pressure(row_width * Mz),
+      E(row_width * Mz), flow(row_width * Mz), ice_grain_size(row_width * Mz, gs_default),
+      e_factor(row_width * Mz, m_e_factor);
+  // per-point bookkeeping for the integration pass:
+  std::vector<unsigned int> offset(row_width), n_levels(row_width);
+  std::vector<double> thk_row(row_width);
+
+  std::vector<double> delta_ij(Mz);
+
+  double D_max                 = 0.0;
+  int high_diffusivity_counter = 0;
+  for (int o = 0; o < 2; o++) {
+    const int oi = 1 - o, oj = o;
+
+    ParallelSection loop(m_grid->com);
+    try {
+      for (int j = j_first; j <= j_last; ++j) {
+
+        // Gather pass: pack flow law inputs for the whole row into contiguous
+        // buffers.
+        unsigned int N = 0; // number of levels gathered so far
+        for (int i = i_first; i <= i_last; ++i) {
+          const unsigned int r = i - i_first;
+
+          const double thk = 0.5 * (thk_smooth(i, j) + thk_smooth(i + oi, j + oj));
+
+          thk_row[r]  = thk;
+          offset[r]   = N;
+          n_levels[r] = 0;
+
+          if (thk == 0.0) {
+            continue;
+          }
+
+          const int ks = m_grid->kBelowHeight(thk);
+          n_levels[r]  = ks + 1;
+
+          double *depth_r = &depth[N], *pressure_r = &pressure[N], *stress_r = &stress[N],
+                 *E_r = &E[N];
+
+          for (int k = 0; k <= ks; ++k) {
+            depth_r[k] = thk - z[k];
+          }
+
+          // pressure added by the ice (i.e. pressure difference between the
+          // current level and the top of the column)
+          for (int k = 0; k <= ks; ++k) {
+            pressure_r[k] = m_EC->pressure(depth_r[k]);
+          }
+
+          {
+            const double *E_ij     = enthalpy->get_column(i, j),
+                         *E_offset = enthalpy->get_column(i + oi, j + oj);
+            for (int k = 0; k <= ks; ++k) {
+              E_r[k] = 0.5 * (E_ij[k] + E_offset[k]);
+            }
+          }
+
+          if (use_age) {
+            const double *age_ij     = age->get_column(i, j),
+                         *age_offset = age->get_column(i + oi, j + oj);
+
+            for (int k = 0; k <= ks; ++k) {
+              const double A = 0.5 * (age_ij[k] + age_offset[k]);
+
+              if (compute_grain_size_using_age) {
+                // convert age from seconds to years:
+                ice_grain_size[N + k] = gs_vostok(A * m_seconds_per_year);
+              }
+
+              if (e_age_coupling) {
+                e_factor[N + k] = interglacial(current_time - A) ? m_e_factor_interglacial
+                                                                 : m_e_factor;
+              }
+            }
+          }
+
+          const double alpha = sqrt(PetscSqr(h_x(i, j, o)) + PetscSqr(h_y(i, j, o)));
+          for (int k = 0; k <= ks; ++k) {
+            stress_r[k] = alpha * pressure_r[k];
+          }
+
+          N += ks + 1;
+        } // end of the gather pass
+
+        // one flow law call for the whole row:
+        m_flow_n(*m_flow_law, stress.data(), E.data(), pressure.data(), ice_grain_size.data(), N,
+                 flow.data());
+
+        // Integration pass: compute D and (optionally) delta columns.
+        for (int i = i_first; i <= i_last; ++i) {
+          const unsigned int r = i - i_first;
+
+          const double thk = thk_row[r];
+
+          if (thk == 0.0) {
+            result(i, j, o) = 0.0;
+            if (full_update) {
+              delta[o]->set_column(i, j, 0.0);
+            }
+            continue;
+          }
+
+          const unsigned int off = offset[r];
+          const int ks           = n_levels[r] - 1;
+
+          const double theta_local = 0.5 * (theta(i, j) + theta(i + oi, j + oj));
+          for (int k = 0; k <= ks; ++k) {
+            delta_ij[k] = e_factor[off + k] * theta_local * 2.0 * pressure[off + k] * flow[off + k];
+          }
+
+          double D = 0.0; // diffusivity for deformational SIA flow
+          {
+            for (int k = 1; k <= ks; ++k) {
+              // trapezoidal rule
+              const double dz = z[k] - z[k - 1];
+              D += 0.5 * dz * ((depth[off + k] + dz) * delta_ij[k - 1] + depth[off + k] * delta_ij[k]);
+            }
+            // finish off D with (1/2) dz (0 + (H-z[ks])*delta_ij[ks]), but dz=H-z[ks]:
+            const double dz = thk - z[ks];
+            D += 0.5 * dz * dz * delta_ij[ks];
+          }
+
+          // Override diffusivity at the edges of the domain (see
+          // compute_diffusivity() for the rationale).
+          {
+            if ((i < 0 or i >= (int)Mx - 1) and not(m_grid->periodicity() & grid::X_PERIODIC)) {
+              D = 0.0;
+            }
+            if ((j < 0 or j >= (int)My - 1) and not(m_grid->periodicity() & grid::Y_PERIODIC)) {
+              D = 0.0;
+            }
+          }
+
+          if (limit_diffusivity and D >= D_limit) {
+            D = D_limit;
+            high_diffusivity_counter += 1;
+          }
+
+          D_max = std::max(D_max, D);
+
+          result(i, j, o) = D;
+
+          if (full_update) {
+            for (unsigned int k = ks + 1; k < Mz; ++k) {
+              delta_ij[k] = 0.0;
+            }
+            delta[o]->set_column(i, j, delta_ij.data());
+          }
+        } // end of the integration pass
+      }   // j-loop
+    } catch (...) {
+      loop.failed();
+    }
+    loop.check();
+  } // o-loop
+
+  m_D_max = GlobalMax(m_grid->com, D_max);
+
+  high_diffusivity_counter = GlobalSum(m_grid->com, high_diffusivity_counter);
+
+  if (m_D_max > D_limit) {
+    throw RuntimeError::formatted(
+        PISM_ERROR_LOCATION,
+        "Maximum diffusivity of SIA flow (%f m2/s) is too high.\n"
+        "This probably means that the bed elevation or the ice thickness is "
+        "too rough.\n"
+        "Increase stress_balance.sia.max_diffusivity to suppress this message.",
+        m_D_max);
+  }
+
+  if (high_diffusivity_counter > 0) {
+    m_log->message(2, "  SIA diffusivity was capped at %.2f m2/s at %d locations.\n", D_limit,
+                   high_diffusivity_counter);
+  }
+}
+
 void SIAFD::compute_diffusive_flux(const array::Staggered &h_x, const array::Staggered &h_y,
                                    const array::Staggered &diffusivity, array::Staggered &result) {
 
@@ -785,7 +1117,7 @@ void SIAFD::compute_I(const Geometry &geometry) {
 
   array::Scalar &thk_smooth = m_work_2d_0;
   array::Array3D *I[]       = { &m_work_3d_0, &m_work_3d_1 };
-  array::Array3D *delta[]   = { &m_delta_0, &m_delta_1 };
+  array::Float3D *delta[]   = { &m_delta_0, &m_delta_1 };
 
   const array::Scalar &h = geometry.ice_surface_elevation, &H = geometry.ice_thickness;
 
@@ -793,7 +1125,7 @@ void SIAFD::compute_I(const Geometry &geometry) {
 
   m_bed_smoother->smoothed_thk(h, H, mask, thk_smooth);
 
-  array::AccessScope list{ delta[0], delta[1], I[0], I[1], &thk_smooth };
+  array::AccessScope list{ I[0], I[1], &thk_smooth };
 
   assert(I[0]->stencil_width() >= 1);
   assert(I[1]->stencil_width() >= 1);
@@ -803,7 +1135,7 @@ void SIAFD::compute_I(const Geometry &geometry) {
 
   const unsigned int Mz = m_grid->Mz();
 
-  std::vector<double> dz(Mz);
+  std::vector<double> dz(Mz), delta_ij(Mz);
   for (unsigned int k = 1; k < Mz; ++k) {
     dz[k] = m_grid->z(k) - m_grid->z(k - 1);
   }
@@ -817,8 +1149,8 @@ void SIAFD::compute_I(const Geometry &geometry) {
         const int oi = 1 - o, oj = o;
         const double thk = 0.5 * (thk_smooth(i, j) + thk_smooth(i + oi, j + oj));
 
-        const double *delta_ij = delta[o]->get_column(i, j);
-        double *I_ij           = I[o]->get_column(i, j);
+        delta[o]->get_column(i, j, delta_ij.data());
+        double *I_ij = I[o]->get_column(i, j);
 
         const unsigned int ks = m_grid->kBelowHeight(thk);
 
@@ -949,6 +1281,14 @@ const BedSmoother& SIAFD::bed_smoother() const {
   return *m_bed_smoother;
 }
 
+std::set<VariableMetadata> SIAFD::state_impl() const {
+  return m_bed_smoother->state();
+}
+
+void SIAFD::write_state_impl(const OutputFile &output) const {
+  m_bed_smoother->write(output);
+}
+
 
 } // end of namespace stressbalance
 } // end of namespace pism
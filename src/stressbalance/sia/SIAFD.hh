@@ -20,6 +20,7 @@
 #define _SIAFD_H_
 
 #include "pism/stressbalance/SSB_Modifier.hh"      // derives from SSB_Modifier
+#include "pism/util/array/Float3D.hh"
 
 namespace pism {
 
@@ -69,6 +70,9 @@ public:
 protected:
   virtual DiagnosticList spatial_diagnostics_impl() const;
 
+  virtual std::set<VariableMetadata> state_impl() const;
+  virtual void write_state_impl(const OutputFile &output) const;
+
   virtual void compute_surface_gradient(const Inputs &inputs,
                                         array::Staggered1 &h_x,
                                         array::Staggered1 &h_y);
@@ -93,6 +97,14 @@ protected:
                                    const array::Staggered1 &h_y,
                                    array::Staggered1 &result);
 
+  virtual void compute_diffusivity_batched(bool full_update,
+                                           const Geometry &geometry,
+                                           const array::Array3D *enthalpy,
+                                           const array::Array3D *age,
+                                           const array::Staggered1 &h_x,
+                                           const array::Staggered1 &h_y,
+                                           array::Staggered1 &result);
+
   virtual void compute_diffusive_flux(const array::Staggered &h_x, const array::Staggered &h_y,
                                       const array::Staggered &diffusivity,
                                       array::Staggered &result);
@@ -114,13 +126,24 @@ protected:
   array::Scalar2 m_work_2d_1;
   //! temporary storage for the surface gradient and the diffusivity
   array::Staggered1 m_h_x, m_h_y, m_D;
-  //! temporary storage for delta on the staggered grid
-  array::Array3D m_delta_0;
-  array::Array3D m_delta_1;
+  //! temporary storage for delta on the staggered grid (single precision: delta is
+  //! integrated using the trapezoid rule before it is used, so float is enough)
+  array::Float3D m_delta_0;
+  array::Float3D m_delta_1;
   //! temporary storage used to store I and strain_heating on the staggered grid
   array::Array3D m_work_3d_0;
   array::Array3D m_work_3d_1;
 
+  //! batched flow-law kernel, selected once in the constructor so that the laws we run
+  //! most use devirtualized instantiations (see flow_n_specialized() in SIAFD.cc)
+  void (*m_flow_n)(const rheology::FlowLaw &, const double *, const double *,
+                   const double *, const double *, unsigned int, double *);
+
+  //! surface gradient scheme (stress_balance.sia.surface_gradient_method), parsed once
+  //! in the constructor instead of per time step
+  enum SurfaceGradientMethod { GRADIENT_ETA, GRADIENT_HASELOFF, GRADIENT_MAHAFFY };
+  SurfaceGradientMethod m_surface_gradient_method;
+
   BedSmoother *m_bed_smoother;
 
   // profiling
@@ -335,7 +335,7 @@ int main(int argc, char *argv[]) {
 
     // We use SIA_Nonsliding and not SIAFD here because we need the z-component
     // of the ice velocity, which is computed using incompressibility of ice in
-    // StressBalance::compute_vertical_velocity().
+    // StressBalance::compute_vertical_velocity_and_strain_heating().
     std::shared_ptr<SIAFD> sia(new SIAFD(grid));
     std::shared_ptr<ZeroSliding> no_sliding(new ZeroSliding(grid));
 
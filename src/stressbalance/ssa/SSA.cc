@@ -111,23 +111,30 @@ void SSA::init_impl() {
 
   InputOptions opts = process_input_options(m_grid->com, m_config);
 
+  m_velocity.set(0.0); // default initial guess
+
   // Check if PISM is being initialized from an output file from a previous run
-  // and read the initial guess (unless asked not to).
-  if (opts.type == INIT_RESTART) {
-    if (m_config->get_flag("stress_balance.ssa.read_initial_guess")) {
-      File input_file(m_grid->com, opts.filename, io::PISM_GUESS, io::PISM_READONLY);
-      bool u_ssa_found = input_file.variable_exists("u_ssa");
-      bool v_ssa_found = input_file.variable_exists("v_ssa");
-      unsigned int start = input_file.nrecords() - 1;
-
-      if (u_ssa_found and v_ssa_found) {
+  // and read the initial guess (unless asked not to). When bootstrapping (e.g.
+  // re-starting on a refined grid) interpolate the old solution instead: a
+  // stale-but-close guess saves many Picard iterations during the first few
+  // time steps.
+  if ((opts.type == INIT_RESTART or opts.type == INIT_BOOTSTRAP) and
+      m_config->get_flag("stress_balance.ssa.read_initial_guess")) {
+    File input_file(m_grid->com, opts.filename, io::PISM_GUESS, io::PISM_READONLY);
+    bool u_ssa_found = input_file.variable_exists("u_ssa");
+    bool v_ssa_found = input_file.variable_exists("v_ssa");
+
+    if (u_ssa_found and v_ssa_found) {
+      if (opts.type == INIT_RESTART) {
         m_log->message(3, "Reading u_ssa and v_ssa...\n");
 
-        m_velocity.read(input_file, start);
+        m_velocity.read(input_file, input_file.nrecords() - 1);
+      } else {
+        m_log->message(3, "Interpolating u_ssa and v_ssa...\n");
+
+        m_velocity.regrid(input_file, io::Default(0.0));
       }
     }
-  } else {
-    m_velocity.set(0.0); // default initial guess
   }
 }
 
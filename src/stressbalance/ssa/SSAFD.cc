@@ -17,6 +17,7 @@
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include <cassert>
+#include <cmath>
 #include <memory>
 #include <stdexcept>
 
@@ -54,7 +55,9 @@ where \f$x\f$ (= Vec m_velocity_global).  A PETSc SNES object is never created.
 SSAFD::SSAFD(std::shared_ptr<const Grid> grid, bool regional_mode)
     : SSAFDBase(grid, regional_mode),
       m_nuH_old(grid, "nuH_old"),
-      m_velocity_old(grid, "velocity_old") {
+      m_velocity_old(grid, "velocity_old"),
+      m_picard_dnuH(grid, "ssafd_picard_dnuH"),
+      m_picard_unconverged(grid, "ssafd_picard_unconverged") {
 
   m_velocity_old.metadata(0)
       .long_name("old SSA velocity field; used for re-trying with a different epsilon")
@@ -64,6 +67,16 @@ SSAFD::SSAFD(std::shared_ptr<const Grid> grid, bool regional_mode)
       .long_name("ice thickness times effective viscosity (before an update)")
       .units("Pa s m");
 
+  m_instrument_cells = m_config->get_flag("stress_balance.ssa.fd.instrument_cells");
+
+  m_picard_dnuH.metadata(0)
+      .long_name("relative change of nuH, accumulated over the Picard iterations of the last SSAFD solve")
+      .units("1");
+
+  m_picard_unconverged.metadata(0)
+      .long_name("number of Picard iterations of the last SSAFD solve in which nuH at this cell changed by more than the convergence tolerance")
+      .units("count");
+
   // The nuH viewer:
   m_nuh_viewer = nullptr;
 
@@ -71,13 +84,24 @@ SSAFD::SSAFD(std::shared_ptr<const Grid> grid, bool regional_mode)
   {
     auto dm = m_velocity_global.dm();
 
+    auto matrix_type = m_config->get_string("stress_balance.ssa.fd.matrix_type");
+    m_device_solve   = (matrix_type != MATAIJ);
+
     PetscErrorCode ierr;
-    ierr = DMSetMatType(*dm, MATAIJ);
+    ierr = DMSetMatType(*dm, matrix_type.c_str());
     PISM_CHK(ierr, "DMSetMatType");
 
     ierr = DMCreateMatrix(*dm, m_A.rawptr());
     PISM_CHK(ierr, "DMCreateMatrix");
 
+    if (m_device_solve) {
+      // Vectors of the type matching the matrix (GPU-resident for device back-ends).
+      // PISM's DMDA vectors stay on the host; see picard_manager() for the copies
+      // connecting the two.
+      ierr = MatCreateVecs(m_A, m_solution_solver.rawptr(), m_rhs_solver.rawptr());
+      PISM_CHK(ierr, "MatCreateVecs");
+    }
+
     ierr = KSPCreate(m_grid->com, m_KSP.rawptr());
     PISM_CHK(ierr, "KSPCreate");
 
@@ -100,8 +124,16 @@ void SSAFD::pc_setup_bjacobi() {
   PetscErrorCode ierr;
   PC pc;
 
-  ierr = KSPSetType(m_KSP, KSPGMRES);
-  PISM_CHK(ierr, "KSPSetType");
+  // LGMRES augments the Krylov space with approximate error vectors from
+  // previous restart cycles; this pays off when consecutive solves use
+  // nearby operators, as in Picard iterations.
+  if (m_config->get_flag("stress_balance.ssa.fd.recycle_krylov_subspace")) {
+    ierr = KSPSetType(m_KSP, KSPLGMRES);
+    PISM_CHK(ierr, "KSPSetType");
+  } else {
+    ierr = KSPSetType(m_KSP, KSPGMRES);
+    PISM_CHK(ierr, "KSPSetType");
+  }
 
   ierr = KSPSetOperators(m_KSP, m_A, m_A);
   PISM_CHK(ierr, "KSPSetOperators");
@@ -359,13 +391,23 @@ void SSAFD::picard_manager(const Inputs &inputs, double nuH_regularization,
       static_cast<int>(m_config->get_number("stress_balance.ssa.fd.max_iterations"));
   double ssa_relative_tolerance =
       m_config->get_number("stress_balance.ssa.fd.relative_convergence");
+  double pc_lag_rtol = m_config->get_number("stress_balance.ssa.fd.lag_preconditioner_rtol");
   bool verbose = m_log->get_threshold() >= 2, very_verbose = m_log->get_threshold() > 2;
 
+  // relative change of nuH in the previous Picard iteration; negative means
+  // "not available yet"
+  double previous_nuH_change = -1.0;
+
   // set the initial guess:
   m_velocity_global.copy_from(m_velocity);
 
   m_stdout_ssa.clear();
 
+  if (m_instrument_cells) {
+    m_picard_dnuH.set(0.0);
+    m_picard_unconverged.set(0.0);
+  }
+
   {
     array::AccessScope scope{ &m_velocity };
     compute_nuH(inputs.geometry->ice_thickness, m_cell_type, m_velocity.array(), m_hardness,
@@ -394,8 +436,42 @@ void SSAFD::picard_manager(const Inputs &inputs, double nuH_regularization,
     ierr = KSPSetOperators(m_KSP, m_A, m_A);
     PISM_CHK(ierr, "KSPSetOperator");
 
-    ierr = KSPSolve(m_KSP, m_rhs.vec(), m_velocity_global.vec());
-    PISM_CHK(ierr, "KSPSolve");
+    // If the viscosity barely changed in the previous iteration the operator is
+    // nearly the same and the old preconditioner is still a good one: skip the
+    // (expensive) preconditioner setup and reuse it.
+    {
+      bool reuse_pc = (pc_lag_rtol > 0.0 and previous_nuH_change >= 0.0 and
+                       previous_nuH_change < pc_lag_rtol);
+
+      ierr = KSPSetReusePreconditioner(m_KSP, reuse_pc ? PETSC_TRUE : PETSC_FALSE);
+      PISM_CHK(ierr, "KSPSetReusePreconditioner");
+
+      if (very_verbose and reuse_pc) {
+        m_stdout_ssa += "pc-reused:";
+      }
+    }
+
+    if (m_device_solve) {
+      // Copy the right-hand side and the initial guess into the solver's vectors
+      // (moving them to the device if the matrix type calls for it), solve, and copy
+      // the solution back. Together with the matrix assembly above these copies are the
+      // only host-device transfers in a Picard iteration; the Krylov iteration itself
+      // runs where the matrix lives.
+      ierr = VecCopy(m_rhs.vec(), m_rhs_solver);
+      PISM_CHK(ierr, "VecCopy");
+
+      ierr = VecCopy(m_velocity_global.vec(), m_solution_solver);
+      PISM_CHK(ierr, "VecCopy");
+
+      ierr = KSPSolve(m_KSP, m_rhs_solver, m_solution_solver);
+      PISM_CHK(ierr, "KSPSolve");
+
+      ierr = VecCopy(m_solution_solver, m_velocity_global.vec());
+      PISM_CHK(ierr, "VecCopy");
+    } else {
+      ierr = KSPSolve(m_KSP, m_rhs.vec(), m_velocity_global.vec());
+      PISM_CHK(ierr, "KSPSolve");
+    }
 
     // Check if diverged; report to standard out about iteration
     ierr = KSPGetConvergedReason(m_KSP, &reason);
@@ -472,6 +548,29 @@ void SSAFD::picard_manager(const Inputs &inputs, double nuH_regularization,
       auto norm       = compute_nuH_norm(m_nuH, m_nuH_old);
       nuH_norm        = norm[0];
       nuH_norm_change = norm[1];
+
+      previous_nuH_change = nuH_norm > 0.0 ? nuH_norm_change / nuH_norm : 0.0;
+
+      // Per-cell instrumentation: attribute the cost of this Picard iteration to the
+      // cells whose viscosity is still changing.
+      if (m_instrument_cells) {
+        array::AccessScope list{ &m_nuH, &m_nuH_old, &m_picard_dnuH, &m_picard_unconverged };
+
+        for (auto p : m_grid->points()) {
+          const int i = p.i(), j = p.j();
+
+          double d = (std::fabs(m_nuH(i, j, 0) - m_nuH_old(i, j, 0)) +
+                      std::fabs(m_nuH(i, j, 1) - m_nuH_old(i, j, 1))),
+                 n = std::fabs(m_nuH(i, j, 0)) + std::fabs(m_nuH(i, j, 1));
+
+          double change = n > 0.0 ? d / n : 0.0;
+
+          m_picard_dnuH(i, j) += change;
+          if (change > ssa_relative_tolerance) {
+            m_picard_unconverged(i, j) += 1.0;
+          }
+        }
+      }
     }
 
     if (m_nuh_viewer != nullptr) {
@@ -645,5 +744,71 @@ void SSAFD::write_system_petsc(const std::string &namepart) {
   PISM_CHK(ierr, "VecView");
 }
 
+const array::Scalar &SSAFD::picard_dnuH() const {
+  return m_picard_dnuH;
+}
+
+const array::Scalar &SSAFD::picard_unconverged() const {
+  return m_picard_unconverged;
+}
+
+//! @brief Reports the relative change of nuH at a cell, accumulated over the Picard
+//! iterations of the last solve. Large values mark the cells (typically shear margins)
+//! that drive the non-linear iteration.
+class SSAFD_picard_dnuH : public Diag<SSAFD> {
+public:
+  SSAFD_picard_dnuH(const SSAFD *m) : Diag<SSAFD>(m) {
+    m_vars = { { m_sys, "ssafd_picard_dnuH", *m_grid } };
+
+    m_vars[0]
+        .long_name("relative change of nuH, accumulated over the Picard iterations of the last SSAFD solve")
+        .units("1");
+  }
+
+protected:
+  virtual std::shared_ptr<array::Array> compute_impl() const {
+    auto result = allocate<array::Scalar>("ssafd_picard_dnuH");
+    result->metadata(0) = m_vars[0];
+
+    result->copy_from(model->picard_dnuH());
+
+    return result;
+  }
+};
+
+//! @brief Reports the number of Picard iterations of the last solve in which nuH at a
+//! cell changed by more than the convergence tolerance.
+class SSAFD_picard_unconverged : public Diag<SSAFD> {
+public:
+  SSAFD_picard_unconverged(const SSAFD *m) : Diag<SSAFD>(m) {
+    m_vars = { { m_sys, "ssafd_picard_unconverged", *m_grid } };
+
+    m_vars[0]
+        .long_name("number of Picard iterations of the last SSAFD solve in which nuH at this cell changed by more than the convergence tolerance")
+        .units("count");
+  }
+
+protected:
+  virtual std::shared_ptr<array::Array> compute_impl() const {
+    auto result = allocate<array::Scalar>("ssafd_picard_unconverged");
+    result->metadata(0) = m_vars[0];
+
+    result->copy_from(model->picard_unconverged());
+
+    return result;
+  }
+};
+
+DiagnosticList SSAFD::spatial_diagnostics_impl() const {
+  DiagnosticList result = SSAFDBase::spatial_diagnostics_impl();
+
+  if (m_instrument_cells) {
+    result["ssafd_picard_dnuH"]        = Diagnostic::Ptr(new SSAFD_picard_dnuH(this));
+    result["ssafd_picard_unconverged"] = Diagnostic::Ptr(new SSAFD_picard_unconverged(this));
+  }
+
+  return result;
+}
+
 } // end of namespace stressbalance
 } // end of namespace pism
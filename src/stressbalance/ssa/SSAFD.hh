@@ -26,6 +26,8 @@
 #include "pism/util/petscwrappers/Viewer.hh"
 #include "pism/util/petscwrappers/KSP.hh"
 #include "pism/util/petscwrappers/Mat.hh"
+#include "pism/util/petscwrappers/Vec.hh"
+#include "pism/util/array/Scalar.hh"
 #include "pism/util/array/Staggered.hh"
 
 namespace pism {
@@ -38,8 +40,14 @@ public:
   SSAFD(std::shared_ptr<const Grid> g, bool regional_mode);
   virtual ~SSAFD() = default;
 
+  const array::Scalar &picard_dnuH() const;
+
+  const array::Scalar &picard_unconverged() const;
+
 protected:
 
+  DiagnosticList spatial_diagnostics_impl() const;
+
   void init_impl();
 
   void pc_setup_bjacobi();
@@ -71,8 +79,26 @@ protected:
   petsc::KSP m_KSP;
   petsc::Mat m_A;
 
+  //! True if stress_balance.ssa.fd.matrix_type selects a non-default (e.g. GPU) matrix
+  //! type; the KSP then solves using the vectors below instead of PISM's DMDA vectors.
+  bool m_device_solve;
+  //! Right-hand side and solution vectors matching the matrix type (and therefore
+  //! resident on the device when a GPU back-end is selected); see picard_manager().
+  petsc::Vec m_rhs_solver, m_solution_solver;
+
   array::Vector1 m_velocity_old;
 
+  //! If true, record per-cell Picard iteration costs during each solve; see
+  //! stress_balance.ssa.fd.instrument_cells.
+  bool m_instrument_cells;
+  //! Relative change of nuH at a cell, accumulated over the Picard iterations of the
+  //! last solve. Large values mark cells (typically shear margins) that drive the
+  //! non-linear iteration.
+  array::Scalar m_picard_dnuH;
+  //! Number of Picard iterations of the last solve in which the relative change of nuH
+  //! at a cell exceeded the convergence tolerance.
+  array::Scalar m_picard_unconverged;
+
   unsigned int m_default_pc_failure_count;
   unsigned int m_default_pc_failure_max_count;
   
@@ -111,6 +111,21 @@ SSAFD_SNES::SSAFD_SNES(std::shared_ptr<const Grid> grid, bool regional_mode)
   ierr = SNESSetTolerances(m_snes, 0.0, 0.0, 0.0, 500, -1);
   PISM_CHK(ierr, "SNESSetTolerances");
 
+  {
+    int lag = static_cast<int>(m_config->get_number("stress_balance.ssa.fd.snes.lag_jacobian"));
+    if (lag > 1) {
+      ierr = SNESSetLagJacobian(m_snes, lag);
+      PISM_CHK(ierr, "SNESSetLagJacobian");
+
+      if (m_config->get_flag("stress_balance.ssa.fd.snes.lag_jacobian_persists")) {
+        // keep the lag counter (and so the assembled Jacobian) across
+        // SNESSolve() calls, i.e. across time steps
+        ierr = SNESSetLagJacobianPersists(m_snes, PETSC_TRUE);
+        PISM_CHK(ierr, "SNESSetLagJacobianPersists");
+      }
+    }
+  }
+
   ierr = SNESSetFromOptions(m_snes);
   PISM_CHK(ierr, "SNESSetFromOptions");
 }
@@ -130,6 +145,33 @@ void SSAFD_SNES::solve(const Inputs &inputs) {
     SNESConvergedReason reason;
     ierr = SNESGetConvergedReason(m_snes, &reason);
     PISM_CHK(ierr, "SNESGetConvergedReason");
+
+    PetscInt lag = 1;
+    ierr = SNESGetLagJacobian(m_snes, &lag);
+    PISM_CHK(ierr, "SNESGetLagJacobian");
+
+    if (reason < 0 and lag > 1) {
+      // The solve stagnated with a lagged Jacobian: fall back to
+      // reassembling every iteration and try again.
+      m_log->message(2,
+                     "SSA: lagged-Jacobian solve failed (%s); retrying with the Jacobian\n"
+                     "     rebuilt every iteration\n",
+                     SNESConvergedReasons[reason]);
+
+      ierr = SNESSetLagJacobian(m_snes, 1);
+      PISM_CHK(ierr, "SNESSetLagJacobian");
+
+      ierr = SNESSolve(m_snes, NULL, m_velocity_global.vec());
+      PISM_CHK(ierr, "SNESSolve");
+
+      ierr = SNESGetConvergedReason(m_snes, &reason);
+      PISM_CHK(ierr, "SNESGetConvergedReason");
+
+      // restore the lag for the next time step
+      ierr = SNESSetLagJacobian(m_snes, lag);
+      PISM_CHK(ierr, "SNESSetLagJacobian");
+    }
+
     if (reason < 0) {
       throw RuntimeError::formatted(PISM_ERROR_LOCATION,
                                     "SSAFD_SNES solve failed to converge (SNES reason %s)",
@@ -16,6 +16,15 @@
 // along with PISM; if not, write to the Free Software
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
+#include <exception>            // std::exception_ptr
+#include <vector>
+
+#include "pism/pism_config.hh"  // Pism_USE_OPENMP
+
+#if Pism_USE_OPENMP
+#include <omp.h>
+#endif
+
 #include "pism/util/Grid.hh"
 #include "pism/stressbalance/ssa/SSAFEM.hh"
 #include "pism/util/fem/Quadrature.hh"
@@ -62,9 +71,6 @@ SSAFEM::SSAFEM(std::shared_ptr<const Grid> grid)
   m_alpha                  = 1 - ice_density / m_config->get_number("constants.sea_water.density");
   m_rho_g                  = ice_density * m_config->get_number("constants.standard_gravity");
 
-  m_driving_stress_x = NULL;
-  m_driving_stress_y = NULL;
-
   PetscErrorCode ierr;
 
   m_dirichletScale        = 1.0;
@@ -132,8 +138,8 @@ void SSAFEM::init_impl() {
   // Use explicit driving stress if provided.
   if (m_grid->variables().is_available("ssa_driving_stress_x") and
       m_grid->variables().is_available("ssa_driving_stress_y")) {
-    m_driving_stress_x = m_grid->variables().get_2d_scalar("ssa_driving_stress_x");
-    m_driving_stress_y = m_grid->variables().get_2d_scalar("ssa_driving_stress_y");
+    m_driving_stress_x = m_grid->variables().handle<array::Scalar>("ssa_driving_stress_x");
+    m_driving_stress_y = m_grid->variables().handle<array::Scalar>("ssa_driving_stress_y");
   }
 
   m_log->message(2, "  [using the SNES-based finite element method implementation]\n");
@@ -285,9 +291,9 @@ void SSAFEM::cache_inputs(const Inputs &inputs) {
       &inputs.geometry->sea_level_elevation,
       inputs.basal_yield_stress};
 
-  bool use_explicit_driving_stress = (m_driving_stress_x != NULL) && (m_driving_stress_y != NULL);
+  bool use_explicit_driving_stress = m_driving_stress_x and m_driving_stress_y;
   if (use_explicit_driving_stress) {
-    list.add({m_driving_stress_x, m_driving_stress_y});
+    list.add({m_driving_stress_x.get(), m_driving_stress_y.get()});
   }
 
   ParallelSection loop(m_grid->com);
@@ -333,13 +339,121 @@ void SSAFEM::cache_inputs(const Inputs &inputs) {
     // Note: the call below uses ghosts of inputs.geometry->ice_thickness.
     compute_node_types(inputs.geometry->ice_thickness,
                        m_config->get_number("stress_balance.ice_free_thickness_standard"),
-                       m_node_type);
+                       m_node_type, m_icy_flags);
   } else {
     m_node_type.set(NODE_INTERIOR);
   }
 
   cache_residual_cfbc(inputs);
 
+  cache_quadrature_values();
+}
+
+//! Linear index of the quadrature-data cache block of the element (i, j).
+size_t SSAFEM::element_cache_offset(int i, int j) const {
+  return ((size_t)(j - m_element_index.ys) * m_element_index.xm +
+          (size_t)(i - m_element_index.xs)) * fem::MAX_QUADRATURE_SIZE;
+}
+
+//! Pre-compute coefficient values at quadrature points of all owned elements.
+/*!
+  The geometry is frozen within a time step, so values of the solution-independent
+  coefficients (cell type mask, thickness, basal yield stress, hardness, driving
+  stress) at quadrature points do not change between nonlinear iterations. This
+  method evaluates them once per cache_inputs() call and stores them in
+  per-element SoA blocks; compute_local_function() and compute_local_jacobian()
+  then only re-evaluate the velocity-dependent parts.
+
+  The choice of the element type (Q1 vs P1) depends on node types only, so it
+  is also fixed within a time step and the cached values stay consistent with
+  the element selection in the residual and Jacobian evaluations.
+*/
+void SSAFEM::cache_quadrature_values() {
+  const bool use_explicit_driving_stress =
+      m_driving_stress_x and m_driving_stress_y;
+  const bool use_cfbc = m_config->get_flag("stress_balance.calving_front_stress_bc");
+
+  const unsigned int Nk     = fem::q1::n_chi;
+  const unsigned int Nq_max = fem::MAX_QUADRATURE_SIZE;
+
+  using fem::P1Element2;
+  fem::P1Quadrature3 Q_p1;
+  P1Element2 p1_element[Nk] = {P1Element2(*m_grid, Q_p1, 0),
+                               P1Element2(*m_grid, Q_p1, 1),
+                               P1Element2(*m_grid, Q_p1, 2),
+                               P1Element2(*m_grid, Q_p1, 3)};
+
+  const size_t n_elements = (size_t)m_element_index.xm * m_element_index.ym;
+
+  m_cached_mask.resize(n_elements * Nq_max);
+  m_cached_thickness.resize(n_elements * Nq_max);
+  m_cached_tauc.resize(n_elements * Nq_max);
+  m_cached_hardness.resize(n_elements * Nq_max);
+  m_cached_tau_d.resize(n_elements * Nq_max);
+
+  array::AccessScope list{&m_node_type, &m_coefficients};
+
+  const int
+    xs = m_element_index.xs,
+    xm = m_element_index.xm,
+    ys = m_element_index.ys,
+    ym = m_element_index.ym;
+
+  ParallelSection loop(m_grid->com);
+  try {
+    for (int j = ys; j < ys + ym; j++) {
+      for (int i = xs; i < xs + xm; i++) {
+
+        fem::Element2 *E = nullptr;
+        {
+          m_q1_element.reset(i, j);
+
+          int node_type[Nk];
+          m_q1_element.nodal_values(m_node_type, node_type);
+
+          auto type = fem::element_type(node_type);
+
+          if (use_cfbc) {
+            if (type == fem::ELEMENT_EXTERIOR) {
+              // skip exterior elements
+              continue;
+            }
+
+            if (type == fem::ELEMENT_Q) {
+              E = &m_q1_element;
+            } else {
+              E = &p1_element[type];
+
+              E->reset(i, j);
+            }
+          } else {
+            // if use_cfbc == false all elements are interior and Q1
+            E = &m_q1_element;
+          }
+        }
+
+        const size_t offset = element_cache_offset(i, j);
+
+        Coefficients coeffs[Nk];
+        E->nodal_values(m_coefficients.array(), coeffs);
+
+        quad_point_values(*E, coeffs,
+                          &m_cached_mask[offset],
+                          &m_cached_thickness[offset],
+                          &m_cached_tauc[offset],
+                          &m_cached_hardness[offset]);
+
+        if (use_explicit_driving_stress) {
+          explicit_driving_stress(*E, coeffs, &m_cached_tau_d[offset]);
+        } else {
+          driving_stress(*E, coeffs, &m_cached_tau_d[offset]);
+        }
+      } // i-loop
+    } // j-loop
+  } catch (...) {
+    loop.failed();
+  }
+  loop.check();
 }
 
 //! Compute quadrature point values of various coefficients given a quadrature `Q` and nodal values.
@@ -361,8 +475,9 @@ void SSAFEM::quad_point_values(const fem::Element &E,
     tauc[q]      = 0.0;
     hardness[q]  = 0.0;
 
+    const fem::Germ *chi_q = E.chi_row(q);
     for (int k = 0; k < E.n_chi(); k++) {
-      const fem::Germ &psi  = E.chi(q, k);
+      const fem::Germ &psi  = chi_q[k];
 
       thickness[q] += psi.val * x[k].thickness;
       bed          += psi.val * x[k].bed;
@@ -385,8 +500,9 @@ void SSAFEM::explicit_driving_stress(const fem::Element &E,
   for (unsigned int q = 0; q < n; q++) {
     result[q] = 0.0;
 
+    const fem::Germ *chi_q = E.chi_row(q);
     for (int k = 0; k < E.n_chi(); k++) {
-      const fem::Germ &psi  = E.chi(q, k);
+      const fem::Germ &psi  = chi_q[k];
       result[q]  += psi.val * x[k].driving_stress;
     }
   }
@@ -454,8 +570,9 @@ void SSAFEM::driving_stress(const fem::Element &E,
 
     result[q] = 0.0;
 
+    const fem::Germ *chi_q = E.chi_row(q);
     for (int k = 0; k < E.n_chi(); k++) {
-      const fem::Germ &psi  = E.chi(q, k);
+      const fem::Germ &psi  = chi_q[k];
 
       b   += psi.val * x[k].bed;
       b_x += psi.dx * x[k].bed;
@@ -482,34 +599,23 @@ void SSAFEM::driving_stress(const fem::Element &E,
 }
 
 
-/** @brief Compute the "(regularized effective viscosity) x (ice thickness)" and effective viscous
- *  bed strength from the current solution, at a single quadrature point.
+/** @brief Compute the "(regularized effective viscosity) x (ice thickness)" from the
+ *  current solution, at a single quadrature point.
  *
  * @param[in] thickness ice thickness
  * @param[in] hardness ice hardness
- * @param[in] mask cell type mask
- * @param[in] tauc basal yield stress
- * @param[in] U the value of the solution
  * @param[in] U_x x-derivatives of velocity components
  * @param[in] U_y y-derivatives of velocity components
  * @param[out] nuH product of the ice viscosity and thickness @f$ \nu H @f$
  * @param[out] dnuH derivative of @f$ \nu H @f$ with respect to the
  *                  second invariant @f$ \gamma @f$. Set to NULL if
  *                  not desired.
- * @param[out] beta basal drag coefficient @f$ \beta @f$
- * @param[out] dbeta derivative of @f$ \beta @f$ with respect to the
- *                   second invariant @f$ \gamma @f$. Set to NULL if
- *                   not desired.
  */
-void SSAFEM::PointwiseNuHAndBeta(double thickness,
-                                 double hardness,
-                                 int mask,
-                                 double tauc,
-                                 const Vector2d &U,
-                                 const Vector2d &U_x,
-                                 const Vector2d &U_y,
-                                 double *nuH, double *dnuH,
-                                 double *beta, double *dbeta) {
+void SSAFEM::PointwiseNuH(double thickness,
+                          double hardness,
+                          const Vector2d &U_x,
+                          const Vector2d &U_y,
+                          double *nuH, double *dnuH) const {
 
   if (thickness < strength_extension->get_min_thickness()) {
     *nuH = strength_extension->get_notional_strength();
@@ -526,19 +632,33 @@ void SSAFEM::PointwiseNuHAndBeta(double thickness,
       *dnuH *= thickness;
     }
   }
+}
 
+/** @brief Adjust the basal drag coefficient computed using the sliding law for the cell
+ *  type at a quadrature point.
+ *
+ * The sliding law applies to grounded ice only: `beta` (and `dbeta`, if not NULL) are
+ * kept where the ice is grounded and replaced with zero elsewhere, except on ice-free
+ * bedrock, which gets the constant `beta_ice_free_bedrock` to improve behavior at
+ * margins.
+ *
+ * This is the mask-dependent part of the basal drag evaluation; the smooth part is
+ * evaluated for whole elements at a time using
+ * IceBasalResistancePlasticLaw::drag_with_derivative_n() and friends.
+ */
+void SSAFEM::adjust_beta(int mask, double *beta, double *dbeta) const {
   if (mask::grounded_ice(mask)) {
-    m_basal_sliding_law->drag_with_derivative(tauc, U.u, U.v, beta, dbeta);
-  } else {
-    *beta = 0;
+    return;
+  }
 
-    if (mask::ice_free_land(mask)) {
-      *beta = m_beta_ice_free_bedrock;
-    }
+  *beta = 0;
 
-    if (dbeta != nullptr) {
-      *dbeta = 0;
-    }
+  if (mask::ice_free_land(mask)) {
+    *beta = m_beta_ice_free_bedrock;
+  }
+
+  if (dbeta != nullptr) {
+    *dbeta = 0;
   }
 }
 
@@ -736,8 +856,6 @@ void SSAFEM::cache_residual_cfbc(const Inputs &inputs) {
 void SSAFEM::compute_local_function(Vector2d const *const *const velocity_global,
                                     Vector2d **residual_global) {
 
-  const bool use_explicit_driving_stress = (m_driving_stress_x != NULL) && (m_driving_stress_y != NULL);
-
   const bool use_cfbc = m_config->get_flag("stress_balance.calving_front_stress_bc");
 
   const unsigned int Nk = fem::q1::n_chi;
@@ -745,12 +863,21 @@ void SSAFEM::compute_local_function(Vector2d const *const *const velocity_global
 
   using fem::P1Element2;
   fem::P1Quadrature3 Q_p1;
-  P1Element2 p1_element[Nk] = {P1Element2(*m_grid, Q_p1, 0),
-                               P1Element2(*m_grid, Q_p1, 1),
-                               P1Element2(*m_grid, Q_p1, 2),
-                               P1Element2(*m_grid, Q_p1, 3)};
 
-  array::AccessScope list{&m_node_type, &m_coefficients, &m_boundary_integral};
+#if Pism_USE_OPENMP
+  const int n_threads = omp_get_max_threads();
+#else
+  const int n_threads = 1;
+#endif
+
+  // Elements carry per-traversal state (see Element::reset()), so each thread needs its
+  // own copies.
+  std::vector<fem::Q1Element2> q1_elements(n_threads, m_q1_element);
+  std::vector<std::vector<P1Element2> > p1_elements(
+      n_threads, {P1Element2(*m_grid, Q_p1, 0), P1Element2(*m_grid, Q_p1, 1),
+                  P1Element2(*m_grid, Q_p1, 2), P1Element2(*m_grid, Q_p1, 3)});
+
+  array::AccessScope list{&m_node_type, &m_boundary_integral};
 
   // Set the boundary contribution of the residual. This is computed at the nodes, so we don't want
   // to set it using Element::add_contribution() because that would lead to
@@ -764,9 +891,6 @@ void SSAFEM::compute_local_function(Vector2d const *const *const velocity_global
   // Start access to Dirichlet data if present.
   fem::DirichletData_Vector dirichlet_data(&m_bc_mask, &m_bc_values, m_dirichletScale);
 
-  // Storage for the current solution and its derivatives at quadrature points.
-  Vector2d U[Nq_max], U_x[Nq_max], U_y[Nq_max];
-
   // Iterate over the elements.
   const int
     xs = m_element_index.xs,
@@ -776,119 +900,156 @@ void SSAFEM::compute_local_function(Vector2d const *const *const velocity_global
 
   ParallelSection loop(m_grid->com);
   try {
-    for (int j = ys; j < ys + ym; j++) {
-      for (int i = xs; i < xs + xm; i++) {
-
-        fem::Element2 *E = nullptr;
-        {
-          m_q1_element.reset(i, j);
-
-          int node_type[Nk];
-          m_q1_element.nodal_values(m_node_type, node_type);
+    // Elements in element-rows j and j+1 share nodes, while elements two rows apart do
+    // not. Processing even-numbered rows first and odd-numbered rows second ("red-black"
+    // coloring by row) guarantees that within one sweep no two rows write to the same
+    // entries of residual_global, so rows of a sweep can be assembled concurrently
+    // without locks or atomics.
+    //
+    // Exceptions must not propagate out of an OpenMP parallel region: stash the first
+    // one thrown by a thread and re-throw it after the loop.
+    std::exception_ptr exception = nullptr;
+
+    for (int sweep = 0; sweep < 2; ++sweep) {
+#if Pism_USE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (int j = ys + sweep; j < ys + ym; j += 2) {
+#if Pism_USE_OPENMP
+        const int thread = omp_get_thread_num();
+#else
+        const int thread = 0;
+#endif
+        fem::Q1Element2 &q1_element = q1_elements[thread];
+        P1Element2 *p1_element = p1_elements[thread].data();
 
-          auto type = fem::element_type(node_type);
+        // Storage for the current solution and its derivatives at quadrature points.
+        Vector2d U[Nq_max], U_x[Nq_max], U_y[Nq_max];
 
-          if (use_cfbc) {
-            if (type == fem::ELEMENT_EXTERIOR) {
-              // skip exterior elements
-              continue;
-            }
+        try {
+          for (int i = xs; i < xs + xm; i++) {
 
-            if (type == fem::ELEMENT_Q) {
-              E = &m_q1_element;
-            } else {
-              E = &p1_element[type];
+            fem::Element2 *E = nullptr;
+            {
+              q1_element.reset(i, j);
 
-              E->reset(i, j);
-            }
-          } else {
-            // if use_cfbc == false all elements are interior and Q1
-            E = &m_q1_element;
-          }
-        }
+              int node_type[Nk];
+              q1_element.nodal_values(m_node_type, node_type);
 
-        // Number of quadrature points.
-        const unsigned int Nq = E->n_pts();
+              auto type = fem::element_type(node_type);
 
-        // Storage for the solution and residuals at element nodes.
-        Vector2d residual[Nk];
+              if (use_cfbc) {
+                if (type == fem::ELEMENT_EXTERIOR) {
+                  // skip exterior elements
+                  continue;
+                }
 
-        int    mask[Nq_max];
-        double thickness[Nq_max];
-        double tauc[Nq_max];
-        double hardness[Nq_max];
-        Vector2d tau_d[Nq_max];
+                if (type == fem::ELEMENT_Q) {
+                  E = &q1_element;
+                } else {
+                  E = &p1_element[type];
 
-        {
-          Coefficients coeffs[Nk];
-          E->nodal_values(m_coefficients.array(), coeffs);
+                  E->reset(i, j);
+                }
+              } else {
+                // if use_cfbc == false all elements are interior and Q1
+                E = &q1_element;
+              }
+            }
 
-          quad_point_values(*E, coeffs, mask, thickness, tauc, hardness);
+            // Number of quadrature points.
+            const unsigned int Nq = E->n_pts();
+
+            // Storage for the solution and residuals at element nodes.
+            Vector2d residual[Nk];
+
+            // Coefficient values at quadrature points, cached by
+            // cache_quadrature_values():
+            const size_t offset = element_cache_offset(i, j);
+
+            const int      *mask      = &m_cached_mask[offset];
+            const double   *thickness = &m_cached_thickness[offset];
+            const double   *tauc      = &m_cached_tauc[offset];
+            const double   *hardness  = &m_cached_hardness[offset];
+            const Vector2d *tau_d     = &m_cached_tau_d[offset];
+
+            {
+              // Obtain the value of the solution at the nodes
+              Vector2d velocity_nodal[Nk];
+              E->nodal_values(velocity_global, velocity_nodal);
+
+              // These values now need to be adjusted if some nodes in the element have Dirichlet data.
+              if (dirichlet_data) {
+                // Set elements of velocity_nodal that correspond to Dirichlet nodes to
+                // prescribed values and mark those nodes in E so that they are not touched
+                // by add_contribution() below.
+                dirichlet_data.enforce_and_constrain(*E, velocity_nodal);
+              }
 
-          if (use_explicit_driving_stress) {
-            explicit_driving_stress(*E, coeffs, tau_d);
-          } else {
-            driving_stress(*E, coeffs, tau_d);
-          }
-        }
+              // Compute the solution values and its gradient at the quadrature points.
+              E->evaluate(velocity_nodal, // input
+                          U, U_x, U_y);   // outputs
+            }
 
-        {
-          // Obtain the value of the solution at the nodes
-          Vector2d velocity_nodal[Nk];
-          E->nodal_values(velocity_global, velocity_nodal);
+            // Zero out the element-local residual in preparation for updating it.
+            for (unsigned int k = 0; k < Nk; k++) {
+              residual[k] = 0;
+            }
 
-          // These values now need to be adjusted if some nodes in the element have Dirichlet data.
-          if (dirichlet_data) {
-            // Set elements of velocity_nodal that correspond to Dirichlet nodes to prescribed
-            // values.
-            dirichlet_data.enforce(*E, velocity_nodal);
-            // mark Dirichlet nodes in E so that they are not touched by
-            // add_contribution() below
-            dirichlet_data.constrain(*E);
+            // Basal drag coefficients at the quadrature points of this element, computed
+            // for the whole element at once (adjusted for the cell type below).
+            double beta[Nq_max];
+            m_basal_sliding_law->drag_n(tauc, U, Nq, beta);
+
+            // loop over quadrature points:
+            for (unsigned int q = 0; q < Nq; q++) {
+
+              auto W = E->weight(q);
+
+              double eta = 0.0;
+              PointwiseNuH(thickness[q], hardness[q],
+                           U_x[q], U_y[q], // inputs
+                           &eta, NULL);    // outputs
+              adjust_beta(mask[q], &beta[q], NULL);
+
+              // The next few lines compute the actual residual for the element.
+              const Vector2d tau_b = U[q] * (- beta[q]); // basal shear stress
+
+              const double
+                u_x          = U_x[q].u,
+                v_y          = U_y[q].v,
+                u_y_plus_v_x = U_y[q].u + U_x[q].v;
+
+              // Loop over test functions.
+              const fem::Germ *chi_q = E->chi_row(q);
+              for (int k = 0; k < E->n_chi(); k++) {
+                const fem::Germ &psi = chi_q[k];
+
+                residual[k].u += W * (eta * (psi.dx * (4.0 * u_x + 2.0 * v_y) + psi.dy * u_y_plus_v_x)
+                                       - psi.val * (tau_b.u + tau_d[q].u));
+                residual[k].v += W * (eta * (psi.dx * u_y_plus_v_x + psi.dy * (2.0 * u_x + 4.0 * v_y))
+                                       - psi.val * (tau_b.v + tau_d[q].v));
+              } // k (test functions)
+            }   // q (quadrature points)
+
+            E->add_contribution(residual, residual_global);
+          } // i-loop
+        } catch (...) {
+#if Pism_USE_OPENMP
+#pragma omp critical (pism_ssafem_residual_exception)
+#endif
+          {
+            if (exception == nullptr) {
+              exception = std::current_exception();
+            }
           }
-
-          // Compute the solution values and its gradient at the quadrature points.
-          E->evaluate(velocity_nodal, // input
-                      U, U_x, U_y);   // outputs
         }
+      } // j-loop
+    } // sweeps
 
-        // Zero out the element-local residual in preparation for updating it.
-        for (unsigned int k = 0; k < Nk; k++) {
-          residual[k] = 0;
-        }
-
-        // loop over quadrature points:
-        for (unsigned int q = 0; q < Nq; q++) {
-
-          auto W = E->weight(q);
-
-          double eta = 0.0, beta = 0.0;
-          PointwiseNuHAndBeta(thickness[q], hardness[q], mask[q], tauc[q],
-                              U[q], U_x[q], U_y[q], // inputs
-                              &eta, NULL, &beta, NULL);              // outputs
-
-          // The next few lines compute the actual residual for the element.
-          const Vector2d tau_b = U[q] * (- beta); // basal shear stress
-
-          const double
-            u_x          = U_x[q].u,
-            v_y          = U_y[q].v,
-            u_y_plus_v_x = U_y[q].u + U_x[q].v;
-
-          // Loop over test functions.
-          for (int k = 0; k < E->n_chi(); k++) {
-            const fem::Germ &psi = E->chi(q, k);
-
-            residual[k].u += W * (eta * (psi.dx * (4.0 * u_x + 2.0 * v_y) + psi.dy * u_y_plus_v_x)
-                                   - psi.val * (tau_b.u + tau_d[q].u));
-            residual[k].v += W * (eta * (psi.dx * u_y_plus_v_x + psi.dy * (2.0 * u_x + 4.0 * v_y))
-                                   - psi.val * (tau_b.v + tau_d[q].v));
-          } // k (test functions)
-        }   // q (quadrature points)
-
-        E->add_contribution(residual, residual_global);
-      } // i-loop
-    } // j-loop
+    if (exception != nullptr) {
+      std::rethrow_exception(exception);
+    }
   } catch (...) {
     loop.failed();
   }
@@ -973,7 +1134,7 @@ void SSAFEM::compute_local_jacobian(Vector2d const *const *const velocity_global
   PetscErrorCode ierr = MatZeroEntries(Jac);
   PISM_CHK(ierr, "MatZeroEntries");
 
-  array::AccessScope list{&m_node_type, &m_coefficients};
+  array::AccessScope list{&m_node_type};
 
   // Start access to Dirichlet data if present.
   fem::DirichletData_Vector dirichlet_data(&m_bc_mask, &m_bc_values, m_dirichletScale);
@@ -1026,18 +1187,14 @@ void SSAFEM::compute_local_jacobian(Vector2d const *const *const velocity_global
           Nq = E->n_pts(),
           n_chi = E->n_chi();
 
-        int    mask[Nq_max];
-        double thickness[Nq_max];
-        double tauc[Nq_max];
-        double hardness[Nq_max];
-
-        {
-          Coefficients coeffs[Nk];
-          E->nodal_values(m_coefficients.array(), coeffs);
+        // Coefficient values at quadrature points, cached by
+        // cache_quadrature_values():
+        const size_t offset = element_cache_offset(i, j);
 
-          quad_point_values(*E, coeffs,
-                            mask, thickness, tauc, hardness);
-        }
+        const int    *mask      = &m_cached_mask[offset];
+        const double *thickness = &m_cached_thickness[offset];
+        const double *tauc      = &m_cached_tauc[offset];
+        const double *hardness  = &m_cached_hardness[offset];
 
         {
           // Values of the solution at the nodes of the current element.
@@ -1047,8 +1204,7 @@ void SSAFEM::compute_local_jacobian(Vector2d const *const *const velocity_global
           // These values now need to be adjusted if some nodes in the element have
           // Dirichlet data.
           if (dirichlet_data) {
-            dirichlet_data.enforce(*E, velocity_nodal);
-            dirichlet_data.constrain(*E);
+            dirichlet_data.enforce_and_constrain(*E, velocity_nodal);
           }
           // Compute the values of the solution at the quadrature points.
           E->evaluate(velocity_nodal, U, U_x, U_y);
@@ -1062,6 +1218,12 @@ void SSAFEM::compute_local_jacobian(Vector2d const *const *const velocity_global
         ierr = PetscMemzero(K, sizeof(K));
         PISM_CHK(ierr, "PetscMemzero");
 
+        // Basal drag coefficients and their derivatives at the quadrature points of this
+        // element, computed for the whole element at once (adjusted for the cell type
+        // below).
+        double beta_q[Nq_max], dbeta_q[Nq_max];
+        m_basal_sliding_law->drag_with_derivative_n(tauc, U, Nq, beta_q, dbeta_q);
+
         for (unsigned int q = 0; q < Nq; q++) {
 
           const double
@@ -1072,15 +1234,20 @@ void SSAFEM::compute_local_jacobian(Vector2d const *const *const velocity_global
             v_y          = U_y[q].v,
             u_y_plus_v_x = U_y[q].u + U_x[q].v;
 
-          double eta = 0.0, deta = 0.0, beta = 0.0, dbeta = 0.0;
-          PointwiseNuHAndBeta(thickness[q], hardness[q], mask[q], tauc[q],
-                              U[q], U_x[q], U_y[q],
-                              &eta, &deta, &beta, &dbeta);
+          double eta = 0.0, deta = 0.0;
+          PointwiseNuH(thickness[q], hardness[q],
+                       U_x[q], U_y[q],
+                       &eta, &deta);
+          adjust_beta(mask[q], &beta_q[q], &dbeta_q[q]);
+
+          const double beta = beta_q[q], dbeta = dbeta_q[q];
+
+          const fem::Germ *chi_q = E->chi_row(q);
 
           for (unsigned int l = 0; l < n_chi; l++) { // Trial functions
 
             // Current trial function and its derivatives:
-            const fem::Germ &phi = E->chi(q, l);
+            const fem::Germ &phi = chi_q[l];
 
             // Derivatives of \gamma with respect to u_l and v_l:
             const double
@@ -1103,7 +1270,7 @@ void SSAFEM::compute_local_jacobian(Vector2d const *const *const velocity_global
 
               // Current test function and its derivatives:
 
-              const fem::Germ &psi = E->chi(q, k);
+              const fem::Germ &psi = chi_q[k];
 
               if (eta == 0) {
                 ierr = PetscPrintf(PETSC_COMM_SELF, "eta=0 i %d j %d q %d k %d\n", i, j, q, k);
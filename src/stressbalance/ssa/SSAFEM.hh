@@ -19,7 +19,10 @@
 #ifndef _SSAFEM_H_
 #define _SSAFEM_H_
 
+#include <vector>
+
 #include "pism/stressbalance/ssa/SSA.hh"
+#include "pism/util/Vars.hh"
 #include "pism/util/fem/Element.hh"
 #include "pism/util/fem/ElementIterator.hh"
 #include "pism/util/petscwrappers/SNES.hh"
@@ -73,6 +76,26 @@ protected:
 
   array::Array2D<Coefficients> m_coefficients;
 
+  //! Per-element cache of coefficient values at quadrature points.
+  /*!
+    Filled once per time step by cache_quadrature_values(), called from
+    cache_inputs(). Geometry, yield stress, and hardness are frozen within a
+    time step, so repeated residual and Jacobian evaluations inside a SNES
+    solve read these values instead of re-interpolating nodal coefficients.
+
+    Stored SoA: one block of fem::MAX_QUADRATURE_SIZE entries per owned
+    element, indexed using element_cache_offset().
+  */
+  std::vector<int> m_cached_mask;
+  std::vector<double> m_cached_thickness;
+  std::vector<double> m_cached_tauc;
+  std::vector<double> m_cached_hardness;
+  std::vector<Vector2d> m_cached_tau_d;
+
+  size_t element_cache_offset(int i, int j) const;
+
+  void cache_quadrature_values();
+
   void quad_point_values(const fem::Element &E,
                          const Coefficients *x,
                          int *mask,
@@ -86,15 +109,13 @@ protected:
 
   void driving_stress(const fem::Element &E, const Coefficients *x, Vector2d *result) const;
 
-  void PointwiseNuHAndBeta(double thickness,
-                           double hardness,
-                           int mask,
-                           double tauc,
-                           const Vector2d &U,
-                           const Vector2d &U_x,
-                           const Vector2d &U_y,
-                           double *nuH, double *dnuH,
-                           double *beta, double *dbeta);
+  void PointwiseNuH(double thickness,
+                    double hardness,
+                    const Vector2d &U_x,
+                    const Vector2d &U_y,
+                    double *nuH, double *dnuH) const;
+
+  void adjust_beta(int mask, double *beta, double *dbeta) const;
 
   void compute_local_function(Vector2d const *const * velocity,
                               Vector2d **residual);
@@ -125,6 +146,9 @@ protected:
 
   //! Storage for node types (interior, boundary, exterior).
   array::Scalar1 m_node_type;
+  //! Cached "icy" node flags used by the incremental compute_node_types(), so that
+  //! repeated calls with an unchanged ice extent cost next to nothing.
+  std::vector<char> m_icy_flags;
   //! Boundary integral (CFBC contribution to the residual).
   array::Vector1 m_boundary_integral;
 
@@ -139,8 +163,8 @@ protected:
   // Support for direct specification of driving stress to the FEM SSA solver. This helps
   // with certain test cases where the grid is periodic but the driving stress cannot be the
   // gradient of a periodic function. (See commit ffb4be16.)
-  const array::Scalar *m_driving_stress_x;
-  const array::Scalar *m_driving_stress_y;
+  Vars::Handle<array::Scalar> m_driving_stress_x;
+  Vars::Handle<array::Scalar> m_driving_stress_y;
 private:
   void cache_residual_cfbc(const Inputs &inputs);
   void monitor_jacobian(Mat Jac);
@@ -66,6 +66,22 @@ CFLData max_timestep_cfl_2d(const array::Scalar &ice_thickness,
                             const array::Scalar1 *no_model_mask,
                             const array::Vector &velocity);
 
+/*! @brief Compute both the 2D and the 3D CFL time step restrictions in one pass. */
+/*!
+ * Equivalent to calling max_timestep_cfl_2d() and max_timestep_cfl_3d(), but
+ * sweeps the velocity fields once and uses one combined reduction instead of
+ * four.
+ */
+void max_timestep_cfl(const array::Scalar &ice_thickness,
+                      const array::CellType &cell_type,
+                      const array::Scalar1 *no_model_mask,
+                      const array::Vector &velocity,
+                      const array::Array3D &u3,
+                      const array::Array3D &v3,
+                      const array::Array3D &w3,
+                      CFLData &cfl_2d,
+                      CFLData &cfl_3d);
+
 /*!
  * Compute the max. time step according to the max. diffusivity of the SIA flow
  */
@@ -52,22 +52,26 @@ void ColumnInterpolation::coarse_to_fine_linear(const double *input, unsigned in
   const unsigned int Mzfine = Mz_fine();
   const unsigned int Mzcoarse = Mz_coarse();
 
-  for (unsigned int k = 0; k < Mzfine; ++k) {
-    if (k > k_max_result) {
-      result[k] = input[m_coarse2fine[k]];
-      continue;
-    }
+  // interpolated levels: a flat gather-multiply using pre-computed indexes and weights
+  unsigned int k_end = std::min(Mzfine, m_coarse2fine_top);
+  if (k_max_result + 1 < k_end) {
+    k_end = k_max_result + 1;
+  }
 
-    unsigned int m = m_coarse2fine[k];
+  unsigned int k = 0;
+  for (; k < k_end; ++k) {
+    const unsigned int m = m_coarse2fine[k];
+    result[k] = input[m] + m_coarse2fine_w[k] * (input[m + 1] - input[m]);
+  }
 
-    // extrapolate (if necessary):
-    if (m == Mzcoarse - 1) {
-      result[k] = input[Mzcoarse - 1];
-      continue;
-    }
+  // constant extrapolation above the top of the coarse grid
+  for (; k < Mzfine and k <= k_max_result; ++k) {
+    result[k] = input[Mzcoarse - 1];
+  }
 
-    const double incr = (m_z_fine[k] - m_z_coarse[m]) / (m_z_coarse[m + 1] - m_z_coarse[m]);
-    result[k] = input[m] + incr * (input[m + 1] - input[m]);
+  // above k_max_result: copy the value at the bracketing coarse level
+  for (; k < Mzfine; ++k) {
+    result[k] = input[m_coarse2fine[k]];
   }
 }
 
@@ -132,16 +136,47 @@ std::vector<double> ColumnInterpolation::fine_to_coarse(const std::vector<double
 void ColumnInterpolation::fine_to_coarse(const double *input, double *result) const {
   const unsigned int N = Mz_coarse();
 
+  // a flat gather-multiply using pre-computed indexes and weights
   for (unsigned int k = 0; k < N - 1; ++k) {
-    const auto &m = m_fine2coarse[k];
+    const unsigned int m = m_fine2coarse[k];
 
-    const double increment = (m_z_coarse[k] - m_z_fine[m]) / (m_z_fine[m + 1] - m_z_fine[m]);
-    result[k] = input[m] + increment * (input[m + 1] - input[m]);
+    result[k] = input[m] + m_fine2coarse_w[k] * (input[m + 1] - input[m]);
   }
 
   result[N - 1] = input[m_fine2coarse[N - 1]];
 }
 
+/*! Version of fine_to_coarse() that reads only fine-grid levels `0, ..., k_max`.
+
+  Coarse levels sampled above `k_max` are set to `fill_value` instead. This is
+  equivalent to setting `input[k] = fill_value` for all `k > k_max` and calling the
+  two-argument version, but it avoids filling the (possibly much longer) part of the
+  fine column above the ice: per-column cost is proportional to the number of coarse
+  levels, not to the height of the fine grid.
+*/
+void ColumnInterpolation::fine_to_coarse(const double *input, unsigned int k_max,
+                                         double fill_value, double *result) const {
+  const unsigned int N = Mz_coarse();
+
+  for (unsigned int k = 0; k < N - 1; ++k) {
+    const unsigned int m = m_fine2coarse[k];
+
+    if (m > k_max) {
+      result[k] = fill_value;
+      continue;
+    }
+
+    const double
+      v_m = input[m],
+      v_p = m + 1 > k_max ? fill_value : input[m + 1];
+
+    result[k] = v_m + m_fine2coarse_w[k] * (v_p - v_m);
+  }
+
+  const unsigned int m = m_fine2coarse[N - 1];
+  result[N - 1] = m > k_max ? fill_value : input[m];
+}
+
 unsigned int ColumnInterpolation::Mz_coarse() const {
   return m_z_coarse.size();
 }
@@ -239,6 +274,33 @@ void ColumnInterpolation::init_interpolation() {
     }
   }
 
+  // Pre-compute interpolation weights: both grids are fixed, so the weights (and not
+  // just the bracketing indexes) can be computed once and then applied to every column.
+  {
+    m_coarse2fine_w.resize(Mz_fine());
+    m_coarse2fine_top = Mz_fine();
+    for (unsigned int k = 0; k < Mz_fine(); ++k) {
+      const unsigned int m = m_coarse2fine[k];
+
+      if (m == Mz_coarse() - 1) {
+        // constant extrapolation above the top of the coarse grid: fine levels with
+        // this property form a contiguous block at the top
+        m_coarse2fine_top = std::min(m_coarse2fine_top, k);
+        m_coarse2fine_w[k] = 0.0;
+        continue;
+      }
+
+      m_coarse2fine_w[k] = (m_z_fine[k] - m_z_coarse[m]) / (m_z_coarse[m + 1] - m_z_coarse[m]);
+    }
+
+    m_fine2coarse_w.resize(Mz_coarse());
+    for (unsigned int k = 0; k < Mz_coarse() - 1; ++k) {
+      const unsigned int m = m_fine2coarse[k];
+
+      m_fine2coarse_w[k] = (m_z_coarse[k] - m_z_fine[m]) / (m_z_fine[m + 1] - m_z_fine[m]);
+    }
+    m_fine2coarse_w[Mz_coarse() - 1] = 0.0; // not used
+  }
 }
 
 } // end of namespace pism
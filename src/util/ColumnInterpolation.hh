@@ -31,6 +31,8 @@ public:
 
   void coarse_to_fine(const double *input, unsigned int k_max_result, double *result) const;
   void fine_to_coarse(const double *input, double *result) const;
+  void fine_to_coarse(const double *input, unsigned int k_max,
+                      double fill_value, double *result) const;
 
   // These two methods allocate fresh storage for the output.
   std::vector<double> coarse_to_fine(const std::vector<double> &input, unsigned int k_max_result) const;
@@ -53,6 +55,19 @@ private:
   std::vector<unsigned int> m_coarse2fine, m_fine2coarse;
   bool m_use_linear_interpolation;
 
+  // Pre-computed interpolation weights: both vertical grids are fixed at startup, so
+  // interpolation can be applied as a flat gather-multiply using these tables and the
+  // index arrays above.
+  //
+  // weights of the linear coarse -> fine interpolation (zero at levels using constant
+  // extrapolation)
+  std::vector<double> m_coarse2fine_w;
+  // index of the first fine level at or above the top of the coarse grid (fine levels
+  // above it use constant extrapolation)
+  unsigned int m_coarse2fine_top;
+  // weights of the fine -> coarse interpolation (the last one is not used)
+  std::vector<double> m_fine2coarse_w;
+
   void init_interpolation();
   void coarse_to_fine_linear(const double *input, unsigned int k_max_result, double *result) const;
   void coarse_to_fine_quadratic(const double *input, unsigned int k_max_result, double *result) const;
@@ -240,6 +240,118 @@ void TridiagonalSystem::solve(unsigned int system_size, double *result) {
   }
 }
 
+//! Allocate a batch of `width` tridiagonal systems of maximum size `max_size`.
+TridiagonalSystemBatch::TridiagonalSystemBatch(unsigned int max_size, unsigned int width)
+  : m_max_system_size(max_size), m_width(width) {
+  const unsigned int huge = 1e6;
+  assert(max_size >= 1 && max_size < huge);
+  assert(width >= 1);
+
+  size_t N = (size_t)m_max_system_size * m_width;
+  m_L.resize(N);
+  m_D.resize(N);
+  m_U.resize(N);
+  m_rhs.resize(N);
+  m_work.resize(N);
+  m_x.resize(N);
+
+  m_size.resize(m_width, 0);
+  m_b.resize(m_width);
+}
+
+unsigned int TridiagonalSystemBatch::width() const {
+  return m_width;
+}
+
+//! Set the size of the system in lane `lane`; zero marks an unused lane.
+void TridiagonalSystemBatch::set_size(unsigned int lane, unsigned int size) {
+  assert(lane < m_width);
+  assert(size <= m_max_system_size);
+  m_size[lane] = size;
+}
+
+unsigned int TridiagonalSystemBatch::size(unsigned int lane) const {
+  assert(lane < m_width);
+  return m_size[lane];
+}
+
+//! Solve all systems in the batch with one pair of Thomas-algorithm sweeps.
+/*!
+  The sweeps run to the size of the largest system in the batch; shorter
+  systems (and unused lanes) are padded with trivial equations \f$ x_k = 0 \f$
+  so that the inner loops over lanes are uniform and branch-free.
+ */
+void TridiagonalSystemBatch::solve() {
+  unsigned int N = 0;           // size of the largest system in the batch
+  for (unsigned int lane = 0; lane < m_width; ++lane) {
+    N = std::max(N, m_size[lane]);
+  }
+  assert(N >= 1);
+
+  // pad shorter systems (and unused lanes) with trivial equations
+  for (unsigned int lane = 0; lane < m_width; ++lane) {
+    unsigned int size = m_size[lane];
+    if (size > 0 and size < N) {
+      // U at the last row of a system is outside of the matrix and may be
+      // uninitialized; it is read (multiplied by zero) in the padded sweep
+      U(size - 1, lane) = 0.0;
+    }
+    for (unsigned int k = size; k < N; ++k) {
+      L(k, lane)   = 0.0;
+      D(k, lane)   = 1.0;
+      U(k, lane)   = 0.0;
+      RHS(k, lane) = 0.0;
+    }
+  }
+
+  for (unsigned int lane = 0; lane < m_width; ++lane) {
+    m_b[lane] = D(0, lane);
+    m_x[lane] = m_rhs[lane] / m_b[lane];
+  }
+  for (unsigned int lane = 0; lane < m_width; ++lane) {
+    if (m_b[lane] == 0.0) {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                    "zero pivot at row 1 (batch lane %d)", lane);
+    }
+  }
+
+  for (unsigned int k = 1; k < N; ++k) {
+    double
+      *work_k  = &m_work[k * m_width],
+      *x_k     = &m_x[k * m_width];
+    const double
+      *U_km1   = &m_U[(k - 1) * m_width],
+      *L_k     = &m_L[k * m_width],
+      *D_k     = &m_D[k * m_width],
+      *rhs_k   = &m_rhs[k * m_width],
+      *x_km1   = &m_x[(k - 1) * m_width];
+
+    for (unsigned int lane = 0; lane < m_width; ++lane) {
+      work_k[lane] = U_km1[lane] / m_b[lane];
+      m_b[lane]    = D_k[lane] - L_k[lane] * work_k[lane];
+      x_k[lane]    = (rhs_k[lane] - L_k[lane] * x_km1[lane]) / m_b[lane];
+    }
+
+    for (unsigned int lane = 0; lane < m_width; ++lane) {
+      if (m_b[lane] == 0.0) {
+        throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                      "zero pivot at row %d (batch lane %d)", k + 1, lane);
+      }
+    }
+  }
+
+  for (int k = static_cast<int>(N) - 2; k >= 0; --k) {
+    double *x_k = &m_x[(size_t)k * m_width];
+    const double
+      *work_kp1 = &m_work[((size_t)k + 1) * m_width],
+      *x_kp1    = &m_x[((size_t)k + 1) * m_width];
+
+    for (unsigned int lane = 0; lane < m_width; ++lane) {
+      x_k[lane] -= work_kp1[lane] * x_kp1[lane];
+    }
+  }
+}
+
 std::string TridiagonalSystem::prefix() const {
   return m_prefix;
 }
@@ -289,6 +401,21 @@ void columnSystemCtx::fine_to_coarse(const std::vector<double> &input, int i, in
   m_interp->fine_to_coarse(input.data(), output.get_column(i, j));
 }
 
+/*! Version of fine_to_coarse() that reads only the active part of the fine column.
+
+  Only fine-grid levels `0, ..., k_max` of `input` are used (`k_max` is usually ks(); it
+  is an explicit argument so that this can be used after processing a batch of columns,
+  when the context holds the state of the last column of the batch). Coarse levels
+  sampled above `k_max` are set to `above_ice_value`. With this the caller does not need
+  to fill the fine column above the ice, so the per-column cost scales with the ice
+  thickness instead of the height of the computational domain.
+*/
+void columnSystemCtx::fine_to_coarse(const std::vector<double> &input, int i, int j,
+                                     unsigned int k_max, double above_ice_value,
+                                     array::Array3D& output) const {
+  m_interp->fine_to_coarse(input.data(), k_max, above_ice_value, output.get_column(i, j));
+}
+
 void columnSystemCtx::coarse_to_fine(const array::Array3D &input, int i, int j,
                                      double* output) const {
   m_interp->coarse_to_fine(input.get_column(i, j), m_ks, output);
@@ -339,6 +466,26 @@ void columnSystemCtx::init_column(int i, int j,
 #endif
 }
 
+/*! Copy the velocity columns interpolated onto the fine grid by `source` instead of
+  interpolating them again.
+
+  This makes it possible to feed several column systems set up in the same column from a
+  single load of the velocity columns: `source` has to use the same fine vertical grid and
+  has to be initialized using the same column indexes.
+*/
+void columnSystemCtx::copy_velocity_columns(const columnSystemCtx &source) {
+  if (source.m_z.size() != m_z.size() or
+      source.m_i != m_i or source.m_j != m_j) {
+    throw RuntimeError(PISM_ERROR_LOCATION,
+                       "cannot re-use velocity columns: fine vertical grids"
+                       " or column indexes do not match");
+  }
+
+  m_u = source.m_u;
+  m_v = source.m_v;
+  m_w = source.m_w;
+}
+
 //! Write system matrix and right-hand-side into an Python script.  The file name contains ZERO_PIVOT_ERROR.
 void columnSystemCtx::reportColumnZeroPivotErrorMFile(unsigned int M) {
 
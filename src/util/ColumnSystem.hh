@@ -135,6 +135,55 @@ private:
   std::string m_prefix;
 };
 
+//! A batch of independent tridiagonal systems in a structure-of-arrays layout.
+/*!
+  Stores the coefficients of up to width() systems of the kind solved by
+  TridiagonalSystem side by side ("lanes"), so that the sweeps of the Thomas
+  algorithm traverse contiguous memory and can be vectorized by the compiler
+  across the batch: the loop-carried dependence of the algorithm is in the row
+  index, while lanes are independent of each other.
+
+  Systems in a batch may have different sizes (set per lane using set_size();
+  size zero marks an unused lane). solve() pads shorter systems with trivial
+  equations up to the size of the largest system in the batch so that the
+  sweeps are uniform. For each lane the sequence of arithmetic operations is
+  the same as in TridiagonalSystem::solve(), so results do not depend on the
+  batch width.
+*/
+class TridiagonalSystemBatch {
+public:
+  TridiagonalSystemBatch(unsigned int max_size, unsigned int width);
+
+  unsigned int width() const;
+
+  void set_size(unsigned int lane, unsigned int size);
+  unsigned int size(unsigned int lane) const;
+
+  double& L(size_t k, size_t lane) {
+    return m_L[k * m_width + lane];
+  }
+  double& D(size_t k, size_t lane) {
+    return m_D[k * m_width + lane];
+  }
+  double& U(size_t k, size_t lane) {
+    return m_U[k * m_width + lane];
+  }
+  double& RHS(size_t k, size_t lane) {
+    return m_rhs[k * m_width + lane];
+  }
+
+  //! Solution of the system in lane `lane` at row `k`; valid after a solve() call.
+  double x(size_t k, size_t lane) const {
+    return m_x[k * m_width + lane];
+  }
+
+  void solve();
+private:
+  unsigned int m_max_system_size, m_width;
+  std::vector<unsigned int> m_size;
+  std::vector<double> m_L, m_D, m_U, m_rhs, m_work, m_x, m_b;
+};
+
 class ColumnInterpolation;
 
 //! Base class for tridiagonal systems in the ice.
@@ -156,6 +205,9 @@ public:
   const std::vector<double>& z() const;
   void fine_to_coarse(const std::vector<double> &input, int i, int j,
                       array::Array3D& output) const;
+  void fine_to_coarse(const std::vector<double> &input, int i, int j,
+                      unsigned int k_max, double above_ice_value,
+                      array::Array3D& output) const;
 protected:
   TridiagonalSystem *m_solver;
 
@@ -182,6 +234,8 @@ protected:
 
   void init_column(int i, int j, double ice_thickness);
 
+  void copy_velocity_columns(const columnSystemCtx &source);
+
   void reportColumnZeroPivotErrorMFile(unsigned int M);
 
   void init_fine_grid(const std::vector<double>& storage_grid);
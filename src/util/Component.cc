@@ -20,6 +20,7 @@
 
 #include "pism/util/Component.hh"
 #include "pism/util/Profiling.hh"
+#include "pism/util/array/Array.hh"
 #include "pism/util/io/File.hh"
 #include "pism/util/Grid.hh"
 #include "pism/util/pism_utilities.hh"
@@ -80,6 +81,27 @@ InputOptions process_input_options(MPI_Comm com, std::shared_ptr<const Config> c
   return InputOptions(type, input_filename, record);
 }
 
+/*!
+ * Return true if any of `inputs` changed since the last call (or if this is the first
+ * call) and record current revisions for use by the next one.
+ *
+ * All calls should use the same list of inputs. Null entries are allowed (an optional
+ * input that is not provided) and treated as unchanged.
+ */
+bool InputRevisions::changed(const std::vector<const array::Array *> &inputs) {
+  std::vector<int> revisions(inputs.size());
+  for (size_t k = 0; k < inputs.size(); ++k) {
+    revisions[k] = inputs[k] != nullptr ? inputs[k]->state_counter() : -1;
+  }
+
+  if (revisions == m_revisions) {
+    return false;
+  }
+
+  m_revisions = revisions;
+  return true;
+}
+
 Component::Component(std::shared_ptr<const Grid> g)
     : m_grid(g),
       m_config(g->ctx()->config()),
@@ -182,5 +204,16 @@ MaxTimestep Component::max_timestep_impl(double t) const {
   return MaxTimestep();
 }
 
+void Component::prefetch(double t, double dt) const {
+  this->prefetch_impl(t, dt);
+}
+
+//! The default implementation does nothing: most components read all their input during
+//! initialization.
+void Component::prefetch_impl(double t, double dt) const {
+  (void) t;
+  (void) dt;
+}
+
 
 } // end of namespace pism
@@ -20,6 +20,7 @@
 #define PISM_COMPONENT_H
 
 #include <string>
+#include <vector>
 
 #include "pism/util/VariableMetadata.hh"
 #include "pism/util/Units.hh"
@@ -67,6 +68,24 @@ struct InputOptions {
 
 InputOptions process_input_options(MPI_Comm com, std::shared_ptr<const Config> config);
 
+//! @brief Tracks revisions (state counters; see array::Array) of a set of input fields.
+/*!
+ * Used by "modifier" components that can treat an update as a no-op when none of their
+ * inputs changed since the last time they ran.
+ *
+ * A field that is re-computed in place gets a new revision even if its values did not
+ * change, so this test is conservative: work is skipped only when input models report
+ * (via state counters) that their outputs are unchanged.
+ */
+class InputRevisions {
+public:
+  bool changed(const std::vector<const array::Array *> &inputs);
+
+private:
+  //! revisions of the inputs at the time of the last changed() call
+  std::vector<int> m_revisions;
+};
+
 //! \brief A class defining a common interface for most PISM sub-models.
 /*!
   \section pism_components PISM's model components and their interface
@@ -137,9 +156,16 @@ public:
   //! Reports the maximum time-step the model can take at time t.
   MaxTimestep max_timestep(double t) const;
 
+  //! @brief Hint about the upcoming time interval `(t, t + dt)`, allowing components
+  //! with file-backed inputs to start reading required records ahead of time (see
+  //! input.forcing.prefetch).
+  void prefetch(double t, double dt) const;
+
 protected:
   virtual MaxTimestep max_timestep_impl(double t) const;
 
+  virtual void prefetch_impl(double t, double dt) const;
+
   virtual std::set<VariableMetadata> state_impl() const;
   virtual void write_state_impl(const OutputFile &output) const;
 
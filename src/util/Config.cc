@@ -42,12 +42,15 @@ namespace pism {
 
 struct Config::Impl {
   Impl(units::System::Ptr sys)
-    : unit_system(sys) {
+    : unit_system(sys), state_counter(0) {
     // empty
   }
 
   units::System::Ptr unit_system;
 
+  //! incremented every time the database is modified (see Config::state_counter())
+  unsigned int state_counter;
+
   std::string filename;
 
   //! @brief Set of parameters set by the user. Used to warn about parameters that were set but were
@@ -81,6 +84,24 @@ void Config::read(const File &file) {
   this->read_impl(file);
 
   m_impl->filename = file.name();
+
+  m_impl->state_counter++;
+}
+
+unsigned int Config::state_counter() const {
+  return m_impl->state_counter;
+}
+
+Config::Number Config::cached_number(const std::string &name) const {
+  return Number(this, name, "");
+}
+
+Config::Number Config::cached_number(const std::string &name, const std::string &units) const {
+  return Number(this, name, units);
+}
+
+Config::Flag Config::cached_flag(const std::string &name) const {
+  return Flag(this, name);
 }
 
 //! \brief Returns the name of the file used to initialize the database.
@@ -295,6 +316,8 @@ void Config::set_number(const std::string &name, double value,
   }
 
   this->set_number_impl(name, value);
+
+  m_impl->state_counter++;
 }
 
 void Config::set_numbers(const std::string &name,
@@ -313,6 +336,8 @@ void Config::set_numbers(const std::string &name,
   }
 
   this->set_numbers_impl(name, values);
+
+  m_impl->state_counter++;
 }
 
 Config::Strings Config::all_strings() const {
@@ -342,6 +367,8 @@ void Config::set_string(const std::string &name,
   }
 
   this->set_string_impl(name, value);
+
+  m_impl->state_counter++;
 }
 
 Config::Flags Config::all_flags() const {
@@ -370,6 +397,8 @@ void Config::set_flag(const std::string& name, bool value,
   }
 
   this->set_flag_impl(name, value);
+
+  m_impl->state_counter++;
 }
 
 static bool special_parameter(const std::string &name) {
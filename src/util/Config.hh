@@ -31,6 +31,7 @@
 
 #include "pism/util/VariableMetadata.hh"
 #include "pism/util/Units.hh"
+#include "pism/util/error_handling.hh" // RuntimeError (used by cached parameter handles)
 
 namespace pism {
 
@@ -92,6 +93,92 @@ public:
   //! range.
   bool is_valid_number(const std::string &name) const;
 
+  //! Cached numeric parameter (see Config::cached_number()).
+  /*!
+    Stores a copy of a parameter's value along with the state counter of the
+    configuration database at the time the copy was made. Reading the value compares
+    state counters and re-reads the parameter if the database was modified since, so hot
+    code pays for an integer comparison instead of a map lookup using a string key.
+
+    Resolve once at initialization:
+
+    \code
+    m_tillwat_max = m_config->cached_number("hydrology.tillwat_max");
+    \endcode
+
+    then use `m_tillwat_max` as a `double`.
+  */
+  class Number {
+  public:
+    Number() : m_config(nullptr), m_value(0.0), m_state_counter(0) {}
+
+    operator double() const {
+      if (m_config == nullptr) {
+        throw RuntimeError(PISM_ERROR_LOCATION, "reading an empty Config::Number handle");
+      }
+      if (m_state_counter != m_config->state_counter()) {
+        refresh();
+      }
+      return m_value;
+    }
+  private:
+    friend class Config;
+    Number(const Config *config, const std::string &name, const std::string &units)
+      : m_config(config), m_name(name), m_units(units), m_value(0.0), m_state_counter(0) {
+      refresh();
+    }
+
+    void refresh() const {
+      m_value = m_units.empty() ?
+        m_config->get_number(m_name) :
+        m_config->get_number(m_name, m_units);
+      m_state_counter = m_config->state_counter();
+    }
+
+    const Config *m_config;
+    std::string m_name;
+    std::string m_units;
+    mutable double m_value;
+    mutable unsigned int m_state_counter;
+  };
+
+  //! Cached flag parameter (see Config::cached_flag() and Config::Number).
+  class Flag {
+  public:
+    Flag() : m_config(nullptr), m_value(false), m_state_counter(0) {}
+
+    operator bool() const {
+      if (m_config == nullptr) {
+        throw RuntimeError(PISM_ERROR_LOCATION, "reading an empty Config::Flag handle");
+      }
+      if (m_state_counter != m_config->state_counter()) {
+        m_value         = m_config->get_flag(m_name);
+        m_state_counter = m_config->state_counter();
+      }
+      return m_value;
+    }
+  private:
+    friend class Config;
+    Flag(const Config *config, const std::string &name)
+      : m_config(config), m_name(name), m_value(false), m_state_counter(0) {
+      m_value         = m_config->get_flag(m_name);
+      m_state_counter = m_config->state_counter();
+    }
+
+    const Config *m_config;
+    std::string m_name;
+    mutable bool m_value;
+    mutable unsigned int m_state_counter;
+  };
+
+  Number cached_number(const std::string &name) const;
+  Number cached_number(const std::string &name, const std::string &units) const;
+  Flag cached_flag(const std::string &name) const;
+
+  //! Incremented every time the database is modified; used to invalidate cached
+  //! parameter values.
+  unsigned int state_counter() const;
+
   // doubles
   typedef std::map<std::string, std::vector<double> > Doubles;
   Doubles all_doubles() const;
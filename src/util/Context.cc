@@ -23,6 +23,7 @@
 #include "pism/util/Time.hh"
 #include "pism/util/Logger.hh"
 #include "pism/util/EnthalpyConverter.hh"
+#include "pism/util/io/File.hh"
 #include <memory>
 
 namespace pism {
@@ -38,9 +39,27 @@ public:
        const std::string &p)
     : com(c), unit_system(sys), config(conf), enthalpy_converter(EC), time(t), prefix(p),
       logger(log) {
-    // empty
+    MPI_Comm_split_type(com, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &com_intra_node);
+
+    int node_rank = 0;
+    MPI_Comm_rank(com_intra_node, &node_rank);
+
+    // one rank per node ("node leaders"); MPI_COMM_NULL on the others
+    MPI_Comm_split(com, node_rank == 0 ? 0 : MPI_UNDEFINED, 0, &com_inter_node);
+
+    input_file_cache = std::make_shared<FileCache>(
+        com, (unsigned int)config->get_number("input.file_cache.capacity"));
+  }
+  ~Impl() {
+    if (com_inter_node != MPI_COMM_NULL) {
+      MPI_Comm_free(&com_inter_node);
+    }
+    MPI_Comm_free(&com_intra_node);
   }
   MPI_Comm com;
+  MPI_Comm com_intra_node;
+  MPI_Comm com_inter_node;
+  std::shared_ptr<FileCache> input_file_cache;
   std::shared_ptr<units::System> unit_system;
   std::shared_ptr<Config> config;
   std::shared_ptr<EnthalpyConverter> enthalpy_converter;
@@ -66,6 +85,18 @@ MPI_Comm Context::com() const {
   return m_impl->com;
 }
 
+MPI_Comm Context::com_intra_node() const {
+  return m_impl->com_intra_node;
+}
+
+MPI_Comm Context::com_inter_node() const {
+  return m_impl->com_inter_node;
+}
+
+std::shared_ptr<FileCache> Context::input_file_cache() const {
+  return m_impl->input_file_cache;
+}
+
 int Context::size() const {
   int S = 0;
   MPI_Comm_size(m_impl->com, &S);
@@ -139,6 +170,7 @@ std::shared_ptr<Context> context_from_config(MPI_Comm com,
   auto logger = std::make_shared<Logger>(com, 1);
 
   logger->set_threshold(static_cast<int>(config->get_number("output.runtime.verbosity")));
+  logger->set_buffer_size(static_cast<size_t>(config->get_number("output.runtime.log_buffer_size")));
 
   // time manager
   auto time = std::make_shared<Time>(com, config, *logger, sys);
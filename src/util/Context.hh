@@ -33,6 +33,7 @@ class System;
 
 class Config;
 class EnthalpyConverter;
+class FileCache;
 class Time;
 class Profiling;
 class Logger;
@@ -45,6 +46,12 @@ public:
   ~Context();
 
   MPI_Comm com() const;
+  //! Communicator containing the ranks of com() sharing a compute node.
+  MPI_Comm com_intra_node() const;
+  //! Communicator containing one rank per compute node; MPI_COMM_NULL on the other
+  //! ranks. Together with com_intra_node() this supports hierarchical reductions; see
+  //! ReductionBatch::reduce().
+  MPI_Comm com_inter_node() const;
   int size() const;
   int rank() const;
   std::shared_ptr<units::System> unit_system() const;
@@ -53,6 +60,9 @@ public:
   std::shared_ptr<const Time> time() const;
   const std::string& prefix() const;
   const Profiling& profiling() const;
+  //! Pool of open read-only input files shared by regridding and forcing code (see
+  //! FileCache). Sized using input.file_cache.capacity.
+  std::shared_ptr<FileCache> input_file_cache() const;
 
   std::shared_ptr<const Logger> log() const;
   std::shared_ptr<Logger> log();
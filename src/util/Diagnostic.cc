@@ -28,6 +28,7 @@
 #include "pism/util/error_handling.hh"
 #include "pism/util/io/OutputWriter.hh"
 #include "pism/util/pism_utilities.hh"
+#include "pism/util/pism_utilities.hh"
 
 namespace pism {
 
@@ -146,6 +147,10 @@ TSDiagnostic::TSDiagnostic(std::shared_ptr<const Grid> grid, const std::string &
   m_current_time = 0;
   m_start        = 0;
 
+  m_batchable     = false;
+  m_batched       = false;
+  m_batched_value = 0.0;
+
   m_buffer_size = static_cast<size_t>(m_config->get_number("output.scalar.buffer_size"));
 
   m_variable["ancillary_variables"] = name + "_aux";
@@ -153,7 +158,10 @@ TSDiagnostic::TSDiagnostic(std::shared_ptr<const Grid> grid, const std::string &
 }
 
 TSDiagnostic::~TSDiagnostic() {
-  flush();
+  if (not m_time.empty()) {
+    flush();
+    m_output_file->sync();
+  }
 }
 
 void TSDiagnostic::set_units(const std::string &units,
@@ -278,10 +286,58 @@ void TSDiagnostic::update(double t0, double t1) {
   this->update_impl(t0, t1);
 }
 
-void TSSnapshotDiagnostic::update_impl(double t0, double t1) {
-  static const double epsilon = 1e-4; // seconds
+void TSDiagnostic::update(double t0, double t1, ReductionBatch &batch) {
+  if (m_batchable and this->will_compute(t0, t1)) {
+    m_batched_value = this->compute_local();
+    batch.sum(&m_batched_value);
+    m_batched = true;
+  }
+}
 
-  if (fabs(t1 - t0) < epsilon) {
+void TSDiagnostic::finish_update(double t0, double t1) {
+  this->update_impl(t0, t1);
+  m_batched = false;
+}
+
+double TSDiagnostic::compute() {
+  if (m_batched) {
+    return m_batched_value;
+  }
+  return GlobalSum(m_grid->com, this->compute_local());
+}
+
+double TSDiagnostic::compute_local() {
+  throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                "scalar diagnostic %s does not define a per-rank contribution",
+                                m_variable.get_name().c_str());
+}
+
+bool TSDiagnostic::will_compute(double t0, double t1) const {
+  (void) t0;
+  (void) t1;
+  return true;
+}
+
+bool TSDiagnostic::needs_value(double t0, double t1) const {
+  for (auto k = m_current_time; k < m_requested_times->size(); ++k) {
+    double t = (*m_requested_times)[k];
+
+    if (t > t1) {
+      break;
+    }
+
+    // the first requested time only marks the start of a reporting interval
+    if (t >= t0 and k > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void TSSnapshotDiagnostic::update_impl(double t0, double t1) {
+  if (not will_compute(t0, t1)) {
+    // between reporting times a snapshot contributes nothing: skip the (possibly
+    // expensive) computation
     return;
   }
 
@@ -290,6 +346,16 @@ void TSSnapshotDiagnostic::update_impl(double t0, double t1) {
   evaluate(t0, t1, this->compute());
 }
 
+bool TSSnapshotDiagnostic::will_compute(double t0, double t1) const {
+  static const double epsilon = 1e-4; // seconds
+
+  if (fabs(t1 - t0) < epsilon) {
+    return false;
+  }
+
+  return needs_value(t0, t1);
+}
+
 void TSRateDiagnostic::update_impl(double t0, double t1) {
   const double v = this->compute();
 
@@ -303,9 +369,7 @@ void TSRateDiagnostic::update_impl(double t0, double t1) {
 }
 
 void TSFluxDiagnostic::update_impl(double t0, double t1) {
-  static const double epsilon = 1e-4; // seconds
-
-  if (fabs(t1 - t0) < epsilon) {
+  if (not will_compute(t0, t1)) {
     return;
   }
 
@@ -314,6 +378,13 @@ void TSFluxDiagnostic::update_impl(double t0, double t1) {
   evaluate(t0, t1, this->compute());
 }
 
+bool TSFluxDiagnostic::will_compute(double t0, double t1) const {
+  static const double epsilon = 1e-4; // seconds
+
+  // fluxes are accumulated every time step (but a zero-length step contributes nothing)
+  return fabs(t1 - t0) >= epsilon;
+}
+
 void TSDiagnostic::flush() {
 
   if (m_time.empty()) {
@@ -368,8 +439,6 @@ void TSDiagnostic::flush() {
   file.write_timeseries(m_variable.get_name(), { m_start }, { (unsigned int)m_values.size() },
                         m_values);
 
-  file.sync();
-
   m_start += m_time.size();
 
   {
@@ -379,6 +448,10 @@ void TSDiagnostic::flush() {
   }
 }
 
+bool TSDiagnostic::buffer_full() const {
+  return m_time.size() >= m_buffer_size;
+}
+
 void TSDiagnostic::init(std::shared_ptr<OutputFile> output_file,
                         std::shared_ptr<std::vector<double>> requested_times) {
   m_output_file = output_file;
@@ -22,6 +22,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "pism/util/Config.hh"
 #include "pism/util/VariableMetadata.hh"
@@ -104,16 +105,36 @@ protected:
 
   /*!
    * Allocate storage for an array of type `T` and copy metadata from `m_vars`.
+   *
+   * Extra arguments (ghostedness, vertical levels, ...) are forwarded to the constructor
+   * of `T` and must be the same in every call.
+   *
+   * The array allocated by the previous compute() call is reused when possible:
+   * diagnostics are re-computed at every reporting time, and with a long `-extra_vars`
+   * list the repeated allocation of result arrays is measurable. Reuse is skipped if the
+   * caller still holds the previous result, so it never aliases data the caller can see.
    */
-  template<typename T>
-  std::shared_ptr<T> allocate(const std::string &name) const {
-    auto result = std::make_shared<T>(m_grid, name);
+  template<typename T, typename... Args>
+  std::shared_ptr<T> allocate(const std::string &name, Args&&... args) const {
+    auto result = cached_array<T>(m_result_cache, name, std::forward<Args>(args)...);
     for (unsigned int k = 0; k < result->ndof(); ++k) {
       result->metadata(k) = m_vars.at(k);
     }
     return result;
   }
 
+  /*!
+   * Return a scratch array of type `T` for temporaries needed by compute_impl(),
+   * allocated lazily on the first call and reused by subsequent calls.
+   *
+   * Extra arguments are forwarded to the constructor of `T` and must be the same in
+   * every call. Like a freshly-allocated array, the result is filled with zeros.
+   */
+  template<typename T, typename... Args>
+  std::shared_ptr<T> scratch(const std::string &name, Args&&... args) const {
+    return cached_array<T>(m_scratch_cache, name, std::forward<Args>(args)...);
+  }
+
   //! the grid
   std::shared_ptr<const Grid> m_grid;
   //! the unit system
@@ -124,6 +145,34 @@ protected:
   std::vector<VariableMetadata> m_vars;
   //! fill value (used often enough to justify storing it)
   double m_fill_value;
+
+private:
+  /*!
+   * Return the array stored in `slot` if it has the requested type and no other owners;
+   * allocate a new one (and store it in `slot`) otherwise.
+   */
+  template<typename T, typename... Args>
+  std::shared_ptr<T> cached_array(std::shared_ptr<array::Array> &slot, const std::string &name,
+                                  Args&&... args) const {
+    if (slot != nullptr and slot.use_count() == 1) {
+      auto cached = std::dynamic_pointer_cast<T>(slot);
+      if (cached != nullptr) {
+        cached->set_name(name);
+        // match the state of a freshly-allocated array
+        cached->set(0.0);
+        return cached;
+      }
+    }
+
+    auto result = std::make_shared<T>(m_grid, name, std::forward<Args>(args)...);
+    slot = result;
+    return result;
+  }
+
+  //! the result of the previous compute() call, kept for reuse (see allocate())
+  mutable std::shared_ptr<array::Array> m_result_cache;
+  //! a temporary used by compute_impl(), kept for reuse (see scratch())
+  mutable std::shared_ptr<array::Array> m_scratch_cache;
 };
 
 typedef std::map<std::string, Diagnostic::Ptr> DiagnosticList;
@@ -273,6 +322,8 @@ protected:
   }
 };
 
+class ReductionBatch;
+
 //! @brief PISM's scalar time-series diagnostics.
 class TSDiagnostic {
 public:
@@ -288,11 +339,38 @@ public:
    */
   void update(double t0, double t1);
 
+  /*!
+   * Begin a batched update: if this diagnostic defines a per-rank contribution (see
+   * compute_local()) and will need its value during this time step, compute the
+   * contribution and register it with `batch`.
+   *
+   * Call this for all scalar diagnostics, then `batch.reduce()`, then finish_update()
+   * for all of them: the reductions of all batchable diagnostics are packed into one
+   * allreduce instead of paying per-message latency in every compute() call.
+   */
+  void update(double t0, double t1, ReductionBatch &batch);
+
+  /*!
+   * Finish an update started by update(t0, t1, batch); has to be called after
+   * `batch.reduce()`.
+   */
+  void finish_update(double t0, double t1);
+
   /*!
    * Flush the buffer to an output file.
+   *
+   * Does not sync the file: callers flush groups of diagnostics and sync once per group
+   * (see IceModel::scalar_diagnostics_flush_buffers()).
    */
   void flush();
 
+  /*!
+   * True when the buffer holds `output.scalar.buffer_size` records or more, i.e. it is
+   * time to flush. All scalar diagnostics share requested times and the buffer size, so
+   * their buffers fill up in lockstep and can be flushed as one batch.
+   */
+  bool buffer_full() const;
+
   /*!
    * Initialize a scalar diagnostic.
    */
@@ -308,8 +386,33 @@ protected:
    * Compute the diagnostic. Regular (snapshot) quantity should be computed here; for rates of
    * change, compute() should return the total change during the time step from t0 to t1. The rate
    * itself is computed in evaluate_rate().
+   *
+   * The default implementation serves diagnostics that define compute_local(): it
+   * returns the value reduced by a batched update, or performs the (un-batched)
+   * reduction itself.
    */
-  virtual double compute() = 0;
+  virtual double compute();
+
+  /*!
+   * Return this rank's contribution to a quantity summed over all ranks.
+   *
+   * Diagnostics whose compute() boils down to "loop over the sub-domain, then one
+   * GlobalSum()" should override this method instead of compute() and set `m_batchable`,
+   * letting the caller pack the reductions of all scalar diagnostics into a single
+   * allreduce; see update(t0, t1, batch).
+   */
+  virtual double compute_local();
+
+  /*!
+   * Return true if update_impl() will need the value of this diagnostic for the time
+   * step `[t0, t1]`. Snapshot quantities are only needed when a requested reporting time
+   * falls within the step; rates and fluxes are accumulated every step.
+   */
+  virtual bool will_compute(double t0, double t1) const;
+
+  //! True if the time step `[t0, t1]` contains a requested reporting time (the first
+  //! requested time only marks the start of a reporting interval).
+  bool needs_value(double t0, double t1) const;
 
   /*!
    * Set internal (MKS) and "output" units.
@@ -342,6 +445,16 @@ protected:
   unsigned int m_start;
   //! size of the buffer used to store data
   size_t m_buffer_size;
+
+  //! true if this diagnostic implements compute_local() and can participate in batched
+  //! reductions
+  bool m_batchable;
+  //! true between update(t0, t1, batch) and finish_update(); compute() returns
+  //! m_batched_value in this state
+  bool m_batched;
+  //! the value registered with a ReductionBatch; holds the global sum once the batch is
+  //! reduced
+  double m_batched_value;
 };
 
 typedef std::map<std::string, TSDiagnostic::Ptr> TSDiagnosticList;
@@ -357,6 +470,7 @@ public:
 private:
   void update_impl(double t0, double t1);
   void evaluate(double t0, double t1, double v);
+  bool will_compute(double t0, double t1) const;
 };
 
 //! Scalar diagnostic reporting the rate of change of a quantity modeled by PISM.
@@ -402,6 +516,7 @@ public:
 
 private:
   void update_impl(double t0, double t1);
+  bool will_compute(double t0, double t1) const;
 };
 
 template <class D, class M>
@@ -123,136 +123,6 @@ void EnthalpyConverter::validate_E_P(double E, double P) const {
 }
 
 
-//! Get pressure in ice from depth below surface using the hydrostatic assumption.
-/*! If \f$d\f$ is the depth then
-     \f[ p = p_{\text{air}}  + \rho_i g d. \f]
-Frequently \f$d\f$ is computed from the thickess minus a level in the ice,
-something like `ice_thickness(i, j) - z[k]`.  The input depth to this routine is allowed to
-be negative, representing a position above the surface of the ice.
- */
-double EnthalpyConverter::pressure(double depth) const {
-  if (depth >= 0.0) {
-    return m_p_air + m_rho_i * m_g * depth;
-  }
-
-  return m_p_air; // at or above surface of ice
-}
-
-//! Compute pressure in a column of ice. Does not check validity of `depth`.
-void EnthalpyConverter::pressure(const std::vector<double> &depth,
-                                 unsigned int ks,
-                                 std::vector<double> &result) const {
-  for (unsigned int k = 0; k <= ks; ++k) {
-    result[k] = m_p_air + m_rho_i * m_g * depth[k];
-  }
-}
-
-//! Get melting temperature from pressure p.
-/*!
-     \f[ T_m(p) = T_{melting} - \beta p. \f]
- */
-double EnthalpyConverter::melting_temperature(double P) const {
-  return m_T_melting - m_beta * P;
-}
-
-
-//! @brief Compute the maximum allowed value of ice enthalpy
-//! (corresponds to @f$ \omega = 1 @f$).
-double EnthalpyConverter::enthalpy_liquid(double P) const {
-  return enthalpy_cts(P) + L(melting_temperature(P));
-}
-
-
-//! Get absolute (not pressure-adjusted) ice temperature (K) from enthalpy and pressure.
-/*! From \ref AschwandenBuelerKhroulevBlatter,
-     \f[ T= T(E,p) = \begin{cases}
-                       c_i^{-1} E + T_0,  &  E < E_s(p), \\
-                       T_m(p),            &  E_s(p) \le E < E_l(p).
-                     \end{cases} \f]
-
-We do not allow liquid water (%i.e. water fraction \f$\omega=1.0\f$) so we
-throw an exception if \f$E \ge E_l(p)\f$.
- */
-double EnthalpyConverter::temperature(double E, double P) const {
-#if (Pism_DEBUG==1)
-  validate_E_P(E, P);
-#endif
-
-  if (E < enthalpy_cts(P)) {
-    return temperature_cold(E);
-  }
-
-  return melting_temperature(P);
-}
-
-
-//! Get pressure-adjusted ice temperature, in kelvin, from enthalpy and pressure.
-/*!
-The pressure-adjusted temperature is:
-     \f[ T_{pa}(E,p) = T(E,p) - T_m(p) + T_{melting}. \f]
- */
-double EnthalpyConverter::pressure_adjusted_temperature(double E, double P) const {
-  return temperature(E, P) - melting_temperature(P) + m_T_melting;
-}
-
-
-//! Get liquid water fraction from enthalpy and pressure.
-/*!
-  From [@ref AschwandenBuelerKhroulevBlatter],
-   @f[
-   \omega(E,p) =
-   \begin{cases}
-     0.0, & E \le E_s(p), \\
-     (E-E_s(p)) / L, & E_s(p) < E < E_l(p).
-   \end{cases}
-   @f]
-
-   We do not allow liquid water (i.e. water fraction @f$ \omega=1.0 @f$).
- */
-double EnthalpyConverter::water_fraction(double E, double P) const {
-#if (Pism_DEBUG==1)
-  validate_E_P(E, P);
-#endif
-
-  double E_s = enthalpy_cts(P);
-  if (E <= E_s) {
-    return 0.0;
-  }
-
-  return (E - E_s) / L(melting_temperature(P));
-}
-
-
-//! Compute enthalpy from absolute temperature, liquid water fraction, and pressure.
-/*! This is an inverse function to the functions \f$T(E,p)\f$ and
-\f$\omega(E,p)\f$ [\ref AschwandenBuelerKhroulevBlatter].  It returns:
-  \f[E(T,\omega,p) =
-       \begin{cases}
-         c_i (T - T_0),     & T < T_m(p) \quad\text{and}\quad \omega = 0, \\
-         E_s(p) + \omega L, & T = T_m(p) \quad\text{and}\quad \omega \ge 0.
-       \end{cases} \f]
-Certain cases are not allowed and throw exceptions:
-- \f$T<=0\f$ (error code 1)
-- \f$\omega < 0\f$ or \f$\omega > 1\f$ (error code 2)
-- \f$T>T_m(p)\f$ (error code 3)
-- \f$T<T_m(p)\f$ and \f$\omega > 0\f$ (error code 4)
-These inequalities may be violated in the sixth digit or so, however.
- */
-double EnthalpyConverter::enthalpy(double T, double omega, double P) const {
-#if (Pism_DEBUG==1)
-  validate_T_omega_P(T, omega, P);
-#endif
-
-  const double T_melting = melting_temperature(P);
-
-  if (T < T_melting) {
-    return enthalpy_cold(T);
-  }
-
-  return enthalpy_cts(P) + omega * L(T_melting);
-}
-
-
 //! Compute enthalpy more permissively than enthalpy().
 /*! Computes enthalpy from absolute temperature, liquid water fraction, and
 pressure.  Use this form of enthalpy() when outside sources (e.g. information
@@ -298,94 +168,4 @@ ColdEnthalpyConverter::ColdEnthalpyConverter(const Config &config)
   m_beta = 0.0;
 }
 
-//! Latent heat of fusion of water as a function of pressure melting
-//! temperature.
-/*!
-
-  Following a re-interpretation of [@ref
-  AschwandenBuelerKhroulevBlatter], we require that @f$ \Diff{H}{p} =
-  0 @f$:
-
-  @f[
-  \Diff{H}{p} = \diff{H_w}{p} + \diff{H_w}{p}\Diff{T}{p}
-  @f]
-
-  We assume that water is incompressible, so @f$ \Diff{T}{p} = 0 @f$
-  and the second term vanishes.
-
-  As for the first term, equation (5) of [@ref
-  AschwandenBuelerKhroulevBlatter] defines @f$ H_w @f$ as follows:
-
-  @f[
-  H_w = \int_{T_0}^{T_m(p)} C_i(t) dt + L + \int_{T_m(p)}^T C_w(t)dt
-  @f]
-
-  Using the fundamental theorem of Calculus, we get
-  @f[
-  \diff{H_w}{p} = (C_i(T_m(p)) - C_w(T_m(p))) \diff{T_m(p)}{p} + \diff{L}{p}
-  @f]
-
-  Assuming that @f$ C_i(T) = c_i @f$ and @f$ C_w(T) = c_w @f$ (i.e. specific heat
-  capacities of ice and water do not depend on temperature) and using
-  the Clausius-Clapeyron relation
-  @f[
-  T_m(p) = T_m(p_{\text{air}}) - \beta p,
-  @f]
-
-  we get
-  @f{align}{
-  \Diff{H}{p} &= (c_i - c_w)\diff{T_m(p)}{p} + \diff{L}{p}\\
-  &= \beta(c_w - c_i) + \diff{L}{p}\\
-  @f}
-  Requiring @f$ \Diff{H}{p} = 0 @f$ implies
-  @f[
-  \diff{L}{p} = -\beta(c_w - c_i),
-  @f]
-  and so
-  @f{align}{
-  L(p) &= -\beta p (c_w - c_i) + C\\
-  &= (T_m(p) - T_m(p_{\text{air}})) (c_w - c_i) + C.
-  @f}
-
-  Letting @f$ p = p_{\text{air}} @f$ we find @f$ C = L(p_\text{air}) = L_0 @f$, so
-  @f[
-  L(p) = (T_m(p) - T_m(p_{\text{air}})) (c_w - c_i) + L_0,
-  @f]
-  where @f$ L_0 @f$ is the latent heat of fusion of water at atmospheric
-  pressure.
-
-  Therefore a consistent interpretation of [@ref
-  AschwandenBuelerKhroulevBlatter] requires the temperature-dependent
-  approximation of the latent heat of fusion of water given above.
-
-  Note that this form of @f$ L(p) @f$ also follows from Kirchhoff's
-  law of thermochemistry.
-*/
-double EnthalpyConverter::L(double T_pm) const {
-  return m_L + (m_c_w - m_c_i) * (T_pm - 273.15);
-}
-
-//! Specific heat capacity of ice.
-double EnthalpyConverter::c() const {
-  return m_c_i;
-}
-
-//! Get enthalpy E_s(p) at cold-temperate transition point from pressure p.
-/*! Returns
-     \f[ E_s(p) = c_i (T_m(p) - T_0), \f]
- */
-double EnthalpyConverter::enthalpy_cts(double P) const {
-  return m_c_i * (melting_temperature(P) - m_T_0);
-}
-
-//! Convert temperature into enthalpy (cold case).
-double EnthalpyConverter::enthalpy_cold(double T) const {
-  return m_c_i * (T - m_T_0);
-}
-
-//! Convert enthalpy into temperature (cold case).
-double EnthalpyConverter::temperature_cold(double E) const {
-  return (E / m_c_i) + m_T_0;
-}
-
 } // end of namespace pism
@@ -61,6 +61,10 @@ struct Grid::Impl : public grid::DistributedGridInfo {
 
   std::shared_ptr<const Context> ctx;
 
+  //! Communicator used to create DMs. Equal to ctx->com() unless ranks were re-ordered
+  //! to improve the placement of sub-domains on compute nodes (see Grid::Grid()).
+  MPI_Comm dm_com;
+
   VariableMetadata mapping_info;
 
   //! @brief array containing lenghts (in the x-direction) of processor sub-domains
@@ -68,7 +72,14 @@ struct Grid::Impl : public grid::DistributedGridInfo {
   //! @brief array containing lenghts (in the y-direction) of processor sub-domains
   std::vector<PetscInt> procs_y;
 
-  std::map<std::array<unsigned int, 2>, std::weak_ptr<petsc::DM> > dms;
+  //! Cache of DMs, keyed by (dof, stencil width). Entries are strong references: a DM
+  //! owns its local-to-local and local-to-global scatters (set up once, by PETSc, when
+  //! first used) as well as a pool of work vectors, so keeping DMs alive for the
+  //! lifetime of the grid turns these into persistent "communication channels". (With
+  //! weak references the DMs requested by halo exchanges -- which are usually not held
+  //! by any array::Array -- would be destroyed and re-created, scatters and all, on
+  //! every call.)
+  std::map<std::array<unsigned int, 2>, std::shared_ptr<petsc::DM> > dms;
 
   // This DM is used for I/O operations and is not owned by any
   // array::Array (so far, anyway). We keep a pointer to it here to
@@ -83,7 +94,12 @@ struct Grid::Impl : public grid::DistributedGridInfo {
   //! GSL binary search accelerator used to speed up kBelowHeight().
   gsl_interp_accel *bsearch_accel;
 
-  std::map<std::string, std::shared_ptr<InputInterpolation>> regridding_2d;
+  //! tile (cache block) size used by tiled_points(); set by grid.tile_size
+  int tile_size;
+
+  //! Interpolation weights (2D and 3D) cached between regridding calls, keyed by the
+  //! input grid description; see Grid::get_interpolation().
+  std::map<std::string, std::shared_ptr<InputInterpolation>> regridding;
 
   //! z coordinates within the ice
   std::vector<double> z;
@@ -120,9 +136,98 @@ std::shared_ptr<Grid> Grid::Shallow(std::shared_ptr<const Context> ctx, double L
   }
 }
 
+//! Re-order MPI ranks so that neighboring sub-domains share compute nodes.
+/*!
+  With the usual block placement of ranks on nodes (consecutive ranks on the same node)
+  and PETSc's default rank-to-sub-domain assignment, neighbors in the process grid often
+  end up on different nodes and halo exchanges go over the network. Returns a
+  communicator in which tiles of neighboring sub-domains map to consecutive ranks (and
+  so, with block placement, to the same node), to be used in place of `ctx->com()` when
+  creating DMs. Returns `ctx->com()` unchanged if grid.node_aware_placement is not set
+  or re-ordering cannot help (one node, one rank per node, etc).
+*/
+static MPI_Comm node_aware_communicator(std::shared_ptr<const Context> ctx,
+                                        const grid::Parameters &p) {
+  MPI_Comm com = ctx->com();
+
+  if (not ctx->config()->get_flag("grid.node_aware_placement")) {
+    return com;
+  }
+
+  const int
+    size = (int)ctx->size(),
+    Nx   = (int)p.procs_x.size(),
+    Ny   = (int)p.procs_y.size();
+
+  if (size < 2 or Nx * Ny != size) {
+    return com;
+  }
+
+  // the number of ranks sharing a node (use the smallest one if nodes are not full)
+  int ppn = 0;
+  {
+    MPI_Comm node_com;
+    MPI_Comm_split_type(com, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_com);
+    MPI_Comm_size(node_com, &ppn);
+    MPI_Comm_free(&node_com);
+
+    MPI_Allreduce(MPI_IN_PLACE, &ppn, 1, MPI_INT, MPI_MIN, com);
+  }
+
+  if (ppn < 2 or ppn >= size) {
+    // one rank per node or all the ranks on one node: nothing to gain
+    return com;
+  }
+
+  // Choose a tile of the process grid containing ppn sub-domains, as close to square as
+  // possible (a square tile has the shortest boundary, i.e. the least inter-node halo
+  // traffic).
+  int tx = (int)std::sqrt((double)ppn);
+  while (ppn % tx != 0) {
+    tx -= 1;
+  }
+  const int ty = ppn / tx;
+
+  // Enumerate sub-domains tile by tile (tiles in row-major order, sub-domains within a
+  // tile in row-major order) and assign the k-th sub-domain in this ordering to rank k
+  // of ctx->com(), so that each tile of neighboring sub-domains lands on one node.
+  int rank = 0;
+  MPI_Comm_rank(com, &rank);
+
+  int px = 0, py = 0;
+  {
+    // rows of tiles are complete (Nx * ty sub-domains each) except possibly the last one
+    const int tj = rank / (Nx * ty);
+    int r        = rank - tj * (Nx * ty);
+
+    const int h = std::min(ty, Ny - tj * ty);
+
+    // tiles within a row contain tx * h sub-domains each except possibly the last one
+    const int ti = r / (tx * h);
+    r -= ti * (tx * h);
+
+    const int w = std::min(tx, Nx - ti * tx);
+
+    px = ti * tx + r % w;
+    py = tj * ty + r / w;
+  }
+
+  // DMDACreate2d() assigns the sub-domain (px, py) to the rank py * Nx + px of the
+  // communicator it is given:
+  MPI_Comm result;
+  MPI_Comm_split(com, 0, py * Nx + px, &result);
+
+  ctx->log()->message(2,
+                      "* Re-ordered MPI ranks: %d x %d tiles of the %d x %d sub-domain grid\n"
+                      "  share compute nodes (%d ranks per node).\n",
+                      tx, ty, Nx, Ny, ppn);
+
+  return result;
+}
+
 //! @brief Create a PISM distributed computational grid.
 Grid::Grid(std::shared_ptr<const Context> context, const grid::Parameters &p)
-    : com(context->com()), m_impl(new Impl(context)) {
+    : com(node_aware_communicator(context, p)), m_impl(new Impl(context)) {
 
   try {
     m_impl->bsearch_accel = gsl_interp_accel_alloc();
@@ -130,8 +235,11 @@ Grid::Grid(std::shared_ptr<const Context> context, const grid::Parameters &p)
       throw RuntimeError(PISM_ERROR_LOCATION, "Failed to allocate a GSL interpolation accelerator");
     }
 
-    m_impl->rank = context->rank();
-    m_impl->size = context->size();
+    // Note: `com` may be a re-ordered version of `context->com()` (see
+    // node_aware_communicator()), so the rank has to come from `com`.
+    MPI_Comm_rank(com, &m_impl->rank);
+    m_impl->size   = context->size();
+    m_impl->dm_com = com;
 
     p.validate();
 
@@ -148,6 +256,8 @@ Grid::Grid(std::shared_ptr<const Context> context, const grid::Parameters &p)
 
     m_impl->compute_horizontal_coordinates();
 
+    m_impl->tile_size = (int)context->config()->get_number("grid.tile_size");
+
     {
       int stencil_width = (int)context->config()->get_number("grid.max_stencil_width");
 
@@ -181,6 +291,132 @@ Grid::Grid(std::shared_ptr<const Context> context, const grid::Parameters &p)
   }
 }
 
+//! Compute sub-domain widths splitting `weights` into `N` contiguous parts of roughly
+//! equal total weight (each at least two grid points wide).
+static std::vector<unsigned int> weighted_ownership_ranges(const std::vector<double> &weights,
+                                                           size_t N) {
+  const size_t M = weights.size();
+
+  double total = 0.0;
+  for (auto w : weights) {
+    total += w;
+  }
+
+  std::vector<unsigned int> result(N, 0);
+
+  size_t i   = 0;
+  double cum = 0.0;
+  for (size_t k = 0; k < N; ++k) {
+    // leave at least two grid points for each of the remaining sub-domains
+    const size_t max_size = M - i - 2 * (N - 1 - k);
+    const double target   = (total * (double)(k + 1)) / (double)N;
+
+    size_t n = 0;
+    while (n < max_size and (n < 2 or cum < target)) {
+      cum += weights[i];
+      i += 1;
+      n += 1;
+    }
+    result[k] = (unsigned int)n;
+  }
+
+  return result;
+}
+
+//! Re-compute sub-domain widths so that every rank gets a similar amount of work.
+/*!
+  Most per-step work (SIA diffusivity, enthalpy columns, hydrology) happens at icy
+  cells, so with the default uniform split ranks owning open ocean idle every step.
+  Weight each cell by grid.ice_cover_weight if the ice thickness read from `file` is
+  positive (and by 1 otherwise) and split each direction so that sub-domains carry
+  roughly equal total weight. The split along x uses column totals and the split along
+  y uses row totals: the decomposition stays a tensor product of 1D splits, as required
+  by the DMDA, so this balances marginal (not per-sub-domain) work.
+
+  No-op if explicit sub-domain widths were requested, if `file` contains no ice
+  thickness, or if its grid does not match `P` (e.g. when bootstrapping with -Mx/-My).
+  On restart the same weights are re-derived from the thickness in the restart file.
+*/
+static void balance_ownership_ranges(grid::Parameters &P, const Config &config,
+                                     std::shared_ptr<units::System> unit_system,
+                                     const File &file, const Logger &log) {
+  if (not (config.get_string("grid.procs_x").empty() and
+           config.get_string("grid.procs_y").empty())) {
+    // explicit sub-domain widths take precedence
+    return;
+  }
+
+  auto var = file.find_variable("thk", "land_ice_thickness");
+  if (not var.exists) {
+    log.message(2,
+                "WARNING: cannot balance the domain decomposition using ice cover:\n"
+                "         no ice thickness in '%s'\n",
+                file.name().c_str());
+    return;
+  }
+
+  const unsigned int Mx = P.Mx, My = P.My;
+
+  // the relative computational cost of a cell carrying ice
+  const double icy_weight = config.get_number("grid.ice_cover_weight");
+
+  std::vector<double> wx(Mx, 0.0), wy(My, 0.0);
+  {
+    auto dims = file.dimensions(var.name);
+
+    std::vector<unsigned int> start(dims.size(), 0), count(dims.size(), 1);
+
+    int x_index = -1, y_index = -1;
+    for (size_t d = 0; d < dims.size(); ++d) {
+      switch (file.dimension_type(dims[d], unit_system)) {
+      case T_AXIS:
+        // use the last record
+        start[d] = file.dimension_length(dims[d]) - 1;
+        break;
+      case X_AXIS:
+        x_index = (int)d;
+        break;
+      case Y_AXIS:
+        y_index = (int)d;
+        break;
+      default:
+        break;
+      }
+    }
+
+    if (x_index < 0 or y_index < 0 or
+        file.dimension_length(dims[x_index]) != Mx or
+        file.dimension_length(dims[y_index]) != My) {
+      log.message(2,
+                  "WARNING: cannot balance the domain decomposition using ice cover:\n"
+                  "         the grid of '%s' in '%s' does not match the computational grid\n",
+                  var.name.c_str(), file.name().c_str());
+      return;
+    }
+
+    // Read the ice thickness one row at a time to keep the memory footprint small
+    // (this is done once, during initialization).
+    count[x_index] = Mx;
+    std::vector<double> row(Mx);
+    for (unsigned int j = 0; j < My; ++j) {
+      start[y_index] = j;
+      file.read_variable(var.name, start, count, row.data());
+
+      for (unsigned int i = 0; i < Mx; ++i) {
+        double w = row[i] > 0.0 ? icy_weight : 1.0;
+        wx[i] += w;
+        wy[j] += w;
+      }
+    }
+  }
+
+  P.procs_x = weighted_ownership_ranges(wx, P.procs_x.size());
+  P.procs_y = weighted_ownership_ranges(wy, P.procs_y.size());
+
+  log.message(3, "  computed ice-cover-weighted sub-domain widths using '%s' in '%s'\n",
+              var.name.c_str(), file.name().c_str());
+}
+
 //! Create a grid from a file, get information from variable `var_name`.
 static std::shared_ptr<Grid> Grid_FromFile(std::shared_ptr<const Context> ctx, const File &file,
                                            const std::string &var_name, grid::Registration r) {
@@ -189,7 +425,10 @@ static std::shared_ptr<Grid> Grid_FromFile(std::shared_ptr<const Context> ctx, c
 
     // The following call may fail because var_name does not exist. (And this is fatal!)
     // Note that this sets defaults using configuration parameters, too.
-    grid::Parameters p(ctx->unit_system(), file, var_name, r);
+    //
+    // Grid information is read on one rank per compute node and broadcast to the rest;
+    // see InputGridInfo.
+    grid::Parameters p(ctx, file.name(), var_name, r);
 
     // if we have no vertical grid information, create a fake 2-level vertical grid.
     if (p.z.size() < 2) {
@@ -204,6 +443,10 @@ static std::shared_ptr<Grid> Grid_FromFile(std::shared_ptr<const Context> ctx, c
 
     p.ownership_ranges_from_options(*ctx->config(), ctx->size());
 
+    if (ctx->config()->get_flag("grid.balance_by_ice_cover")) {
+      balance_ownership_ranges(p, *ctx->config(), ctx->unit_system(), file, log);
+    }
+
     return std::make_shared<Grid>(ctx, p);
   } catch (RuntimeError &e) {
     e.add_context("initializing computational grid from variable \"%s\" in \"%s\"",
@@ -233,6 +476,12 @@ std::shared_ptr<Grid> Grid::FromFile(std::shared_ptr<const Context> ctx,
 Grid::~Grid() {
   gsl_interp_accel_free(m_impl->bsearch_accel);
 
+  if (com != m_impl->ctx->com()) {
+    // free the re-ordered communicator created by node_aware_communicator()
+    MPI_Comm tmp = com;
+    MPI_Comm_free(&tmp);
+  }
+
   delete m_impl;
 }
 
@@ -478,20 +727,11 @@ std::shared_ptr<petsc::DM> Grid::get_dm(unsigned int dm_dof, unsigned int stenci
 
   std::array<unsigned int, 2> key{ dm_dof, stencil_width };
 
-  if (m_impl->dms[key].expired()) {
-    // note: here "result" is needed because m_impl->dms is a std::map of weak_ptr
-    //
-    // m_impl->dms[j] = m_impl->create_dm(dm_dof, stencil_width);
-    //
-    // would create a shared_ptr, then assign it to a weak_ptr. At this point the
-    // shared_ptr (the right hand side) will be destroyed and the corresponding weak_ptr
-    // will be a nullptr.
-    auto result      = m_impl->create_dm(dm_dof, stencil_width);
-    m_impl->dms[key] = result;
-    return result;
+  if (not m_impl->dms[key]) {
+    m_impl->dms[key] = m_impl->create_dm(dm_dof, stencil_width);
   }
 
-  return m_impl->dms[key].lock();
+  return m_impl->dms[key];
 }
 
 //! Return grid periodicity.
@@ -512,6 +752,10 @@ const grid::DistributedGridInfo& Grid::info() const {
   return *m_impl;
 }
 
+TiledGridPoints Grid::tiled_points(unsigned int stencil_width) const {
+  return {*m_impl, static_cast<unsigned int>(m_impl->tile_size), stencil_width};
+}
+
 //! @brief Create a DM with the given number of `dof` (degrees of freedom per grid point) and
 //! stencil width.
 std::shared_ptr<petsc::DM> Grid::Impl::create_dm(unsigned int da_dof, unsigned int stencil_width) const {
@@ -521,7 +765,7 @@ std::shared_ptr<petsc::DM> Grid::Impl::create_dm(unsigned int da_dof, unsigned i
 
   DM result;
   PetscErrorCode ierr = DMDACreate2d(
-      ctx->com(), DM_BOUNDARY_PERIODIC, DM_BOUNDARY_PERIODIC, DMDA_STENCIL_BOX, (PetscInt)Mx,
+      dm_com, DM_BOUNDARY_PERIODIC, DM_BOUNDARY_PERIODIC, DMDA_STENCIL_BOX, (PetscInt)Mx,
       (PetscInt)My, (PetscInt)procs_x.size(), (PetscInt)procs_y.size(), (PetscInt)da_dof,
       (PetscInt)stencil_width, procs_x.data(), procs_y.data(), // lx, ly
       &result);
@@ -1001,6 +1245,112 @@ InputGridInfo::InputGridInfo(const File &file, const std::string &variable,
   }
 }
 
+//! Get grid information from `filename`, reading on one rank per compute node.
+/*!
+  Gathering grid information issues many small metadata reads (dimension lengths,
+  attributes, coordinate variables). On a shared parallel file system the cost of these
+  reads grows with the number of ranks accessing the file, which adds up at startup,
+  especially when many ensemble members share the file system.
+
+  Here only the first rank on each compute node reads from the file (using the purely
+  serial NetCDF-3 backend, which can read all supported formats); the result is
+  published to the other ranks of the node with intra-node broadcasts, which go through
+  shared memory and do not touch the file system.
+ */
+InputGridInfo::InputGridInfo(std::shared_ptr<const Context> ctx, const std::string &filename,
+                             const std::string &variable, Registration registration) {
+  reset();
+
+  MPI_Comm com = ctx->com_intra_node();
+
+  int rank = 0;
+  {
+    int err = MPI_Comm_rank(com, &rank);
+    PISM_C_CHK(err, 0, "MPI_Comm_rank");
+  }
+
+  ParallelSection leader(com);
+  try {
+    if (rank == 0) {
+      File file(MPI_COMM_SELF, filename, io::PISM_NETCDF3, io::PISM_READONLY);
+
+      *this = InputGridInfo(file, variable, ctx->unit_system(), registration);
+    }
+  } catch (...) {
+    leader.failed();
+  }
+  leader.check();
+
+  // publish the result within the node
+  {
+    // pack numbers and names (the sets of dimension types and names have to stay in
+    // the same order; any order will do)
+    std::vector<double> numbers;
+    std::string names;
+    if (rank == 0) {
+      numbers = { x0,
+                  y0,
+                  Lx,
+                  Ly,
+                  (double)t_len,
+                  longitude_latitude ? 1.0 : 0.0,
+                  (double)x.size(),
+                  (double)y.size(),
+                  (double)z.size() };
+      for (const auto *coordinate : { &x, &y, &z }) {
+        numbers.insert(numbers.end(), coordinate->begin(), coordinate->end());
+      }
+
+      names = variable_name;
+      for (const auto &d : dimension_types) {
+        numbers.push_back((double)d.second);
+        names += "\n" + d.first;
+      }
+    }
+
+    unsigned long sizes[2] = { numbers.size(), names.size() };
+    int err = MPI_Bcast(sizes, 2, MPI_UNSIGNED_LONG, 0, com);
+    PISM_C_CHK(err, 0, "MPI_Bcast");
+
+    numbers.resize(sizes[0]);
+    names.resize(sizes[1]);
+
+    err = MPI_Bcast(numbers.data(), (int)sizes[0], MPI_DOUBLE, 0, com);
+    PISM_C_CHK(err, 0, "MPI_Bcast");
+    err = MPI_Bcast(&names[0], (int)sizes[1], MPI_CHAR, 0, com);
+    PISM_C_CHK(err, 0, "MPI_Bcast");
+
+    if (rank != 0) {
+      x0                 = numbers[0];
+      y0                 = numbers[1];
+      Lx                 = numbers[2];
+      Ly                 = numbers[3];
+      t_len              = (unsigned int)numbers[4];
+      longitude_latitude = numbers[5] > 0.5;
+
+      size_t Mx = (size_t)numbers[6];
+      size_t My = (size_t)numbers[7];
+      size_t Mz = (size_t)numbers[8];
+
+      size_t k = 9;
+      x.assign(&numbers[k], &numbers[k] + Mx);
+      k += Mx;
+      y.assign(&numbers[k], &numbers[k] + My);
+      k += My;
+      z.assign(&numbers[k], &numbers[k] + Mz);
+      k += Mz;
+
+      auto tokens = split(names, '\n');
+      variable_name = tokens[0];
+      for (size_t n = 1; n < tokens.size(); ++n) {
+        dimension_types[tokens[n]] = (AxisType)(int)numbers[k + (n - 1)];
+      }
+    }
+  }
+
+  this->filename = filename;
+}
+
 //! Get a list of dimensions from a grid definition file
 std::string get_domain_variable(const File &file) {
   auto n_variables = file.nvariables();
@@ -1269,6 +1619,24 @@ Parameters::Parameters(std::shared_ptr<units::System> unit_system, const File &f
   variable_name = variable;
 }
 
+Parameters::Parameters(std::shared_ptr<const Context> ctx, const std::string &filename,
+                       const std::string &variable, Registration r)
+  : Parameters() {
+  // read grid information on one rank per compute node (see the corresponding
+  // InputGridInfo constructor)
+  InputGridInfo input_grid(ctx, filename, variable, r);
+
+  Lx            = input_grid.Lx;
+  Ly            = input_grid.Ly;
+  x0            = input_grid.x0;
+  y0            = input_grid.y0;
+  Mx            = input_grid.x.size();
+  My            = input_grid.y.size();
+  registration  = r;
+  z             = input_grid.z;
+  variable_name = variable;
+}
+
 //! Set `output` if the parameter `name` is set to a "valid" number, otherwise leave
 //! `output` unchanged.
 template <typename T>
@@ -1516,6 +1884,10 @@ std::shared_ptr<Grid> Grid::FromOptions(std::shared_ptr<const Context> ctx) {
       // process configuration parameters controlling grid ownership ranges
       input_grid.ownership_ranges_from_options(*config, ctx->size());
 
+      if (config->get_flag("grid.balance_by_ice_cover")) {
+        balance_ownership_ranges(input_grid, *config, unit_system, input_file, *log);
+      }
+
       auto result = std::make_shared<Grid>(ctx, input_grid);
 
       units::Converter km(unit_system, "m", "km");
@@ -1580,20 +1952,53 @@ std::shared_ptr<InputInterpolation> Grid::get_interpolation(const std::vector<do
 
   auto name = grid_name(input_file, variable_name, ctx()->unit_system(), type == PIECEWISE_CONSTANT);
 
-  if (levels.size() < 2) {
-    if (m_impl->regridding_2d[name] == nullptr) {
-      m_impl->regridding_2d[name] =
-        InputInterpolation::create(*this, levels, input_file, variable_name, type);
+  // Include the interpolation type in the key: contexts are shared by all the variables
+  // defined on the same input grid (this is what makes bootstrapping with many 2D
+  // variables compute interpolation weights once), but weights depend on the type, so
+  // variables read with nearest-neighbor interpolation (e.g. masks) must not reuse a
+  // context built for linear interpolation, and vice versa.
+  switch (type) {
+  case LINEAR:
+    name += ":linear";
+    break;
+  case NEAREST:
+    name += ":nearest";
+    break;
+  case PIECEWISE_CONSTANT:
+    // grid_name() appended ":piecewise_constant" above
+    break;
+  }
+
+  if (levels.size() >= 2) {
+    // Include the vertical axes in the key: interpolation weights can be shared by 3D
+    // variables defined on the same input and target vertical grids (e.g. enthalpy and
+    // age during a grid refinement restart), but not by variables using different
+    // vertical axes (e.g. ice and bedrock columns).
+    for (const auto &d : input_file.dimensions(variable_name)) {
+      if (input_file.dimension_type(d, ctx()->unit_system()) == Z_AXIS) {
+        name += ":";
+        name += d;
+      }
+    }
+
+    double sum = 0.0;
+    for (double z : levels) {
+      sum += z;
     }
+    name += pism::printf(":z:%d:%.12g:%.12g:%.12g",
+                         (int)levels.size(), levels.front(), levels.back(), sum);
+  }
 
-    return m_impl->regridding_2d[name];
+  if (m_impl->regridding[name] == nullptr) {
+    m_impl->regridding[name] =
+      InputInterpolation::create(*this, levels, input_file, variable_name, type);
   }
 
-  return InputInterpolation::create(*this, levels, input_file, variable_name, type);
+  return m_impl->regridding[name];
 }
 
 void Grid::forget_interpolations() {
-  m_impl->regridding_2d.clear();
+  m_impl->regridding.clear();
 }
 
 GridPoints::GridPoints(const Grid &grid, unsigned int stencil_width)
@@ -1616,5 +2021,22 @@ GridPoints::GridPoints(const grid::DistributedGridInfo &grid, unsigned int stenc
   m_end   = GridPoint(i_first, j_last + 1, i_first, i_last);
 }
 
+TiledGridPoints::TiledGridPoints(const grid::DistributedGridInfo &grid, unsigned int tile_size,
+                                 unsigned int stencil_width)
+  : m_begin(grid.xs - static_cast<int>(stencil_width),
+            grid.xs + grid.xm + static_cast<int>(stencil_width) - 1,
+            grid.ys - static_cast<int>(stencil_width),
+            grid.ys + grid.ym + static_cast<int>(stencil_width) - 1,
+            static_cast<int>(tile_size)),
+    // the "end" sentinel: i == i_first, j == j_last + 1 (see
+    // TiledGridPoint::operator++())
+    m_end(grid.xs - static_cast<int>(stencil_width),
+          grid.xs + grid.xm + static_cast<int>(stencil_width) - 1,
+          grid.ys + grid.ym + static_cast<int>(stencil_width),
+          grid.ys + grid.ym + static_cast<int>(stencil_width) - 1,
+          static_cast<int>(tile_size)) {
+  // empty
+}
+
 
 } // end of namespace pism
@@ -21,6 +21,7 @@
 
 #include "VariableMetadata.hh"
 #include "io/File.hh"
+#include <algorithm>            // std::min
 #include <cassert>
 #include <memory> // shared_ptr
 #include <string>
@@ -62,6 +63,11 @@ public:
   InputGridInfo(const File &file, const std::string &variable,
                 std::shared_ptr<units::System> unit_system, Registration registration);
 
+  //! Same, but reading `filename` on one rank per compute node and broadcasting the
+  //! result to the other ranks of each node.
+  InputGridInfo(std::shared_ptr<const Context> ctx, const std::string &filename,
+                const std::string &variable, Registration registration);
+
   void report(const Logger &log, int threshold, std::shared_ptr<units::System> s) const;
 
   // dimension lengths
@@ -109,6 +115,11 @@ public:
   Parameters(std::shared_ptr<units::System> unit_system, const File &file,
              const std::string &variable_name, Registration r);
 
+  //! Same, but reading grid information on one rank per compute node (see
+  //! InputGridInfo).
+  Parameters(std::shared_ptr<const Context> ctx, const std::string &filename,
+             const std::string &variable_name, Registration r);
+
   static Parameters FromGridDefinition(std::shared_ptr<units::System> unit_system, const File &file,
                                        const std::string &variable_name, Registration registration);
 
@@ -223,6 +234,106 @@ private:
   GridPoint m_end;
 };
 
+class TiledGridPoint {
+public:
+  TiledGridPoint(int i_first, int i_last, int j_first, int j_last, int tile_size)
+    : m_i(i_first), m_j(j_first),
+      m_i_first(i_first), m_i_last(i_last),
+      m_j_first(j_first), m_j_last(j_last),
+      m_tile_size(tile_size) {
+    m_tile_i_last = std::min(m_i_first + m_tile_size - 1, m_i_last);
+    m_tile_j_last = std::min(m_j_first + m_tile_size - 1, m_j_last);
+    m_tile_i_first = m_i_first;
+    m_tile_j_first = m_j_first;
+  }
+
+  inline TiledGridPoint &operator++() {
+    m_i += 1;
+    if (m_i <= m_tile_i_last) {
+      return *this;
+    }
+
+    // wrap around to the next row of the current tile
+    m_i = m_tile_i_first;
+    m_j += 1;
+    if (m_j <= m_tile_j_last) {
+      return *this;
+    }
+
+    // move to the next tile in the i direction
+    m_tile_i_first = m_tile_i_last + 1;
+    if (m_tile_i_first <= m_i_last) {
+      m_tile_i_last = std::min(m_tile_i_first + m_tile_size - 1, m_i_last);
+      m_i = m_tile_i_first;
+      m_j = m_tile_j_first;
+      return *this;
+    }
+
+    // move to the next row of tiles
+    m_tile_i_first = m_i_first;
+    m_tile_i_last  = std::min(m_tile_i_first + m_tile_size - 1, m_i_last);
+    m_tile_j_first = m_tile_j_last + 1;
+    m_tile_j_last  = std::min(m_tile_j_first + m_tile_size - 1, m_j_last);
+    m_i = m_tile_i_first;
+    m_j = m_tile_j_first;
+    // note: after the last tile m_j == m_j_last + 1 and m_i == m_i_first, matching the
+    // "end" sentinel used by TiledGridPoints
+
+    return *this;
+  }
+
+  inline TiledGridPoint& operator*() {
+    return *this;
+  }
+
+  inline bool operator!=(TiledGridPoint &other) const {
+    return (m_j != other.m_j) or (m_i != other.m_i);
+  }
+
+  inline int i() const {
+    return m_i;
+  }
+
+  inline int j() const {
+    return m_j;
+  }
+
+private:
+  int m_i, m_j;
+  int m_i_first, m_i_last;
+  int m_j_first, m_j_last;
+  int m_tile_i_first, m_tile_i_last;
+  int m_tile_j_first, m_tile_j_last;
+  int m_tile_size;
+};
+
+/** Iterator class traversing the grid (and possibly ghost points) in square tiles.
+ *
+ * Visits the same points as GridPoints, but in cache-blocked order: stencil passes
+ * reading several rows of several fields stay within the L2 cache even on wide
+ * sub-domains. Loop bodies are identical to the ones used with GridPoints:
+ *
+ * `for (auto p : grid.tiled_points()) { ... }`
+ *
+ * Do *not* use this traversal order when the loop body has loop-carried dependencies
+ * (e.g. sweeps accumulating along a row).
+ */
+class TiledGridPoints {
+public:
+  TiledGridPoints(const grid::DistributedGridInfo &grid, unsigned int tile_size,
+                  unsigned int stencil_width = 0);
+
+  TiledGridPoint &begin() {
+    return m_begin;
+  }
+  TiledGridPoint &end() {
+    return m_end;
+  }
+private:
+  TiledGridPoint m_begin;
+  TiledGridPoint m_end;
+};
+
 //! Describes the PISM grid and the distribution of data across processors.
 /*!
   This class holds parameters describing the grid, including the vertical
@@ -377,6 +488,10 @@ public:
     return {*this, stencil_width};
   }
 
+  //! Cache-blocked counterpart of points() and points_with_ghosts(); uses the tile size
+  //! set by grid.tile_size. See TiledGridPoints.
+  TiledGridPoints tiled_points(unsigned int stencil_width = 0) const;
+
 private:
   struct Impl;
   Impl *m_impl;
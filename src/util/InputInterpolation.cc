@@ -32,6 +32,8 @@
 #include "pism/util/projection.hh"
 #include "pism/util/Logger.hh"
 #include "pism/util/Config.hh"
+#include "pism/util/error_handling.hh"
+#include <mpi.h>
 #include <string>
 #include <vector>
 
@@ -55,6 +57,36 @@ double InputInterpolation::regrid(const VariableMetadata &metadata, const pism::
   return regrid_impl(metadata, file, record_index, grid, output);
 }
 
+bool InputInterpolation::buffered_regrid_supported() const {
+  return false;
+}
+
+double InputInterpolation::regrid_buffered(const VariableMetadata &metadata,
+                                           const pism::File &file, int record_index,
+                                           const Grid &grid, double *output) const {
+  if (record_index == -1) {
+    auto nrecords =
+      file.nrecords(metadata.get_name(), metadata["standard_name"], metadata.unit_system());
+
+    record_index = (int)nrecords - 1;
+  }
+
+  return regrid_buffered_impl(metadata, file, record_index, grid, output);
+}
+
+double InputInterpolation::regrid_buffered_impl(const VariableMetadata &metadata,
+                                                const pism::File &file, int record_index,
+                                                const Grid &grid, double *output) const {
+  (void) metadata;
+  (void) file;
+  (void) record_index;
+  (void) grid;
+  (void) output;
+
+  throw RuntimeError(PISM_ERROR_LOCATION,
+                     "buffered regridding is not supported by this interpolation type");
+}
+
 InputInterpolation::InputInterpolation() {
   // empty
 }
@@ -99,14 +131,42 @@ double InputInterpolation3D::regrid_impl(const VariableMetadata &metadata,
     context.start[T_AXIS] = record_index;
 
     io::regrid_spatial_variable(metadata, target_grid, context, file,
-                                *target_grid.ctx()->log(),
-                                output_array.get());
+                                *target_grid.ctx()->log(), m_buffer,
+                                output_array.get(), true);
   }
   double end = get_time(target_grid.com);
 
   return end - start;
 }
 
+bool InputInterpolation3D::buffered_regrid_supported() const {
+  return true;
+}
+
+double InputInterpolation3D::regrid_buffered_impl(const VariableMetadata &metadata,
+                                                  const pism::File &file,
+                                                  int record_index,
+                                                  const Grid &target_grid,
+                                                  double *output) const {
+  // Note: this may run on a background thread, so we use MPI_Wtime() instead of
+  // get_time() and tell io::regrid_spatial_variable() to skip profiling (PETSc's
+  // profiling is not thread-safe). The scratch buffer is local because interpolation
+  // objects are shared (see Grid::get_interpolation()) and may be used by several
+  // threads at the same time.
+  double start = MPI_Wtime();
+  {
+    LocalInterpCtx context = *m_interp_context;
+    context.start[T_AXIS] = record_index;
+
+    std::vector<double> buffer;
+    io::regrid_spatial_variable(metadata, target_grid, context, file,
+                                *target_grid.ctx()->log(), buffer, output, false);
+  }
+  double end = MPI_Wtime();
+
+  return end - start;
+}
+
 
 std::shared_ptr<InputInterpolation>
 InputInterpolation::create(const Grid &target_grid,
@@ -58,10 +58,29 @@ public:
   double regrid(const VariableMetadata &metadata, const pism::File &file, int record_index,
                 const Grid &grid, petsc::Vec &output) const;
 
+  /*! True if regrid_buffered() is supported by this implementation. */
+  virtual bool buffered_regrid_supported() const;
+
+  /*!
+   * Same as regrid(), but stores results in a plain array `output` (`grid.xm() *
+   * grid.ym() * N_levels` values, in the (y, x, z) storage order) and makes no PETSc
+   * calls.
+   *
+   * This makes it safe to call from a background thread (see record prefetching in
+   * array::Forcing), provided that no other thread uses `file` or makes MPI calls on its
+   * communicator.
+   */
+  double regrid_buffered(const VariableMetadata &metadata, const pism::File &file,
+                         int record_index, const Grid &grid, double *output) const;
+
 protected:
   InputInterpolation();
   virtual double regrid_impl(const VariableMetadata &metadata, const pism::File &file,
                              int record_index, const Grid &grid, petsc::Vec &output) const = 0;
+
+  //! The default implementation stops with an error message.
+  virtual double regrid_buffered_impl(const VariableMetadata &metadata, const pism::File &file,
+                                      int record_index, const Grid &grid, double *output) const;
 };
 
 /*!
@@ -74,11 +93,19 @@ public:
                        const File &input_file, const std::string &variable_name,
                        InterpolationType type);
 
+  bool buffered_regrid_supported() const;
+
 private:
   double regrid_impl(const VariableMetadata &metadata, const pism::File &file,
                      int record_index, const Grid &grid, petsc::Vec &output) const;
 
+  double regrid_buffered_impl(const VariableMetadata &metadata, const pism::File &file,
+                              int record_index, const Grid &grid, double *output) const;
+
   std::shared_ptr<LocalInterpCtx> m_interp_context;
+
+  //! scratch space re-used by regrid_impl() calls (see io::regrid_spatial_variable())
+  mutable std::vector<double> m_buffer;
 };
 
 } // namespace pism
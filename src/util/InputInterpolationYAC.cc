@@ -18,6 +18,7 @@
  */
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <cmath>
@@ -34,6 +35,8 @@
 #include "pism/util/array/Scalar.hh"
 #include "pism/util/InputInterpolationYAC.hh"
 #include "pism/util/pism_utilities.hh" // GlobalMin()
+#include "pism/util/Config.hh"
+#include "pism/util/io/io_helpers.hh" // io::file_exists()
 
 #if (Pism_USE_PROJ == 0)
 #error "This code requires PROJ"
@@ -196,6 +199,40 @@ static double dy_min(const std::string &proj_string,
   return dy;
 }
 
+/*!
+ * Name of the on-disk file caching interpolation weights for a (source grid, target
+ * grid, method) combination; see input.interpolation.weight_file_prefix.
+ *
+ * Sizes, centers, extents and projection parameters of both grids plus the
+ * interpolation method selector are folded into a fingerprint that becomes a part of
+ * the file name, so a saved file is re-used only for the exact combination it was
+ * computed for: any mismatch is a cache miss (weights are re-computed and saved under a
+ * different name), not an error.
+ */
+static std::string weight_file_name(const std::string &prefix,
+                                    const grid::InputGridInfo &source_grid,
+                                    const std::string &source_projection,
+                                    const Grid &target_grid,
+                                    const std::string &target_projection,
+                                    InterpolationType type) {
+  auto description = pism::printf(
+      "source: %d %d %.12g %.12g %.12g %.12g '%s' "
+      "target: %d %d %.12g %.12g %.12g %.12g '%s' piecewise_constant: %d",
+      (int)source_grid.x.size(), (int)source_grid.y.size(), source_grid.x0, source_grid.y0,
+      source_grid.Lx, source_grid.Ly, source_projection.c_str(), (int)target_grid.Mx(),
+      (int)target_grid.My(), target_grid.x0(), target_grid.y0(), target_grid.Lx(),
+      target_grid.Ly(), target_projection.c_str(), (int)(type == PIECEWISE_CONSTANT));
+
+  // FNV-1a (64 bit)
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (char c : description) {
+    hash ^= (uint64_t)(unsigned char)c;
+    hash *= 0x100000001b3ULL;
+  }
+
+  return pism::printf("%s-%016llx.nc", prefix.c_str(), (unsigned long long)hash);
+}
+
 InputInterpolationYAC::InputInterpolationYAC(const pism::Grid &target_grid,
                                              const pism::File &input_file,
                                              const std::string &variable_name,
@@ -259,6 +296,22 @@ InputInterpolationYAC::InputInterpolationYAC(const pism::Grid &target_grid,
 
     m_buffer = std::make_shared<pism::array::Scalar>(source_grid, variable_name);
 
+    // If requested, cache computed interpolation weights on disk. The fingerprint in
+    // the file name ties a weight file to this exact (source grid, target grid, method)
+    // combination.
+    std::string weight_file;
+    bool weights_on_disk = false;
+    {
+      auto prefix = ctx->config()->get_string("input.interpolation.weight_file_prefix");
+
+      if (not prefix.empty()) {
+        weight_file = weight_file_name(prefix, source_grid_info, source_proj_params,
+                                       target_grid, target_proj_params, type);
+
+        weights_on_disk = io::file_exists(ctx->com(), weight_file);
+      }
+    }
+
     std::string target_grid_name = "internal for " + source_grid_name;
     {
       // Initialize YAC:
@@ -317,7 +370,14 @@ InputInterpolationYAC::InputInterpolationYAC(const pism::Grid &target_grid,
         int interp_stack_id = 0;
         yac_cget_interp_stack_config(&interp_stack_id);
 
-        if (type == PIECEWISE_CONSTANT) {
+        if (weights_on_disk) {
+          // Load pre-computed weights instead of repeating the search. The weight file
+          // records the complete interpolation (including fallbacks), so no other
+          // methods are needed in the stack.
+          method = "weights read from " + weight_file;
+
+          yac_cadd_interp_stack_config_user_file(interp_stack_id, weight_file.c_str());
+        } else if (type == PIECEWISE_CONSTANT) {
           method = "nearest neighbor";
 
           // use nearest neighbor interpolation to interpolate integer fields:
@@ -361,18 +421,44 @@ InputInterpolationYAC::InputInterpolationYAC(const pism::Grid &target_grid,
         // Define the coupling between fields:
         const int src_lag = 0;
         const int tgt_lag = 0;
-        yac_cdef_couple_instance(m_instance_id,
-                                 "source_component",       // source component name
-                                 source_grid_name.c_str(), // source grid name
-                                 source_grid_name.c_str(), // source field name
-                                 "target_component",       // target component name
-                                 target_grid_name.c_str(), // target grid name
-                                 target_grid_name.c_str(), // target field name
-                                 "1",                      // time step length in units below
-                                 YAC_TIME_UNIT_SECOND,     // time step length units
-                                 YAC_REDUCTION_TIME_NONE,  // reduction in time (for
-                                                           // asynchronous coupling)
-                                 interp_stack_id, src_lag, tgt_lag);
+        if (not weight_file.empty() and not weights_on_disk) {
+          // Save the computed weights so that later runs using the same grid pair can
+          // load them instead of repeating the search.
+          log->message(2, "Saving interpolation weights to '%s'.\n", weight_file.c_str());
+
+          int ext_couple_config_id = 0;
+          yac_cget_ext_couple_config(&ext_couple_config_id);
+          yac_cset_ext_couple_config_weight_file(ext_couple_config_id, weight_file.c_str());
+
+          yac_cdef_couple_custom_instance(m_instance_id,
+                                          "source_component",       // source component name
+                                          source_grid_name.c_str(), // source grid name
+                                          source_grid_name.c_str(), // source field name
+                                          "target_component",       // target component name
+                                          target_grid_name.c_str(), // target grid name
+                                          target_grid_name.c_str(), // target field name
+                                          "1",                  // time step length in units below
+                                          YAC_TIME_UNIT_SECOND, // time step length units
+                                          YAC_REDUCTION_TIME_NONE, // reduction in time (for
+                                                                   // asynchronous coupling)
+                                          interp_stack_id, src_lag, tgt_lag,
+                                          ext_couple_config_id);
+
+          yac_cfree_ext_couple_config(ext_couple_config_id);
+        } else {
+          yac_cdef_couple_instance(m_instance_id,
+                                   "source_component",       // source component name
+                                   source_grid_name.c_str(), // source grid name
+                                   source_grid_name.c_str(), // source field name
+                                   "target_component",       // target component name
+                                   target_grid_name.c_str(), // target grid name
+                                   target_grid_name.c_str(), // target field name
+                                   "1",                      // time step length in units below
+                                   YAC_TIME_UNIT_SECOND,     // time step length units
+                                   YAC_REDUCTION_TIME_NONE,  // reduction in time (for
+                                                             // asynchronous coupling)
+                                   interp_stack_id, src_lag, tgt_lag);
+        }
 
         // free the interpolation stack config now that we defined the coupling
         yac_cfree_interp_stack_config(interp_stack_id);
@@ -171,6 +171,37 @@ void Interpolation1D::interpolate(const double *input, double *output) const {
   }
 }
 
+/*!
+ * Interpolate `n_columns` columns in one call.
+ *
+ * Input columns are `input_stride` values apart (an input column may be longer than the
+ * part used for interpolation); output columns are packed, n_output() values each.
+ *
+ * This applies the precomputed indexes and weights to a whole contiguous block (e.g. all
+ * columns of a 3D input slab during regridding) in a single bandwidth-bound pass instead
+ * of a call per column.
+ */
+void Interpolation1D::interpolate_batch(const double *input, size_t input_stride,
+                                        size_t n_columns, double *output) const {
+  size_t n = m_alpha.size();
+
+  const int *left     = m_left.data();
+  const int *right    = m_right.data();
+  const double *alpha = m_alpha.data();
+
+  for (size_t c = 0; c < n_columns; ++c) {
+    const double *in = input + c * input_stride;
+    double *out      = output + c * n;
+
+    for (size_t k = 0; k < n; ++k) {
+      const int
+        L = left[k],
+        R = right[k];
+      out[k] = in[L] + alpha[k] * (in[R] - in[L]);
+    }
+  }
+}
+
 void Interpolation1D::init_nearest(const double *input_x, unsigned int input_x_size,
                                  const double *output_x, unsigned int output_x_size) {
 
@@ -108,6 +108,12 @@ public:
    */
   void interpolate(const double *input, double *output) const;
 
+  /*!
+   * Batch version of interpolate(): process `n_columns` columns in one pass.
+   */
+  void interpolate_batch(const double *input, size_t input_stride, size_t n_columns,
+                         double *output) const;
+
 private:
   //! Interpolation indexes
   std::vector<int> m_left, m_right;
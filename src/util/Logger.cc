@@ -33,6 +33,10 @@ struct Logger::Impl {
   MPI_Comm com;
   bool enabled;
   int threshold;
+  //! buffer capacity in bytes; zero means "no buffering"
+  size_t buffer_size;
+  //! messages accumulated since the last flush()
+  std::string buffer;
 };
 
 Logger::Logger(MPI_Comm com, int threshold)
@@ -41,12 +45,39 @@ Logger::Logger(MPI_Comm com, int threshold)
   m_impl->com = com;
   m_impl->enabled = true;
   m_impl->threshold = threshold;
+  m_impl->buffer_size = 0;
 }
 
 Logger::~Logger() {
+  try {
+    flush();
+  } catch (...) {
+    // suppress exceptions: this is a destructor
+  }
   delete m_impl;
 }
 
+void Logger::set_buffer_size(size_t capacity) {
+  if (capacity < m_impl->buffer_size) {
+    flush();
+  }
+  m_impl->buffer_size = capacity;
+}
+
+void Logger::flush() const {
+  if (m_impl->buffer.empty()) {
+    return;
+  }
+
+  // clear the buffer *before* printing: if the print fails we do not want the
+  // destructor to try (and fail) again
+  std::string content;
+  content.swap(m_impl->buffer);
+
+  PetscErrorCode ierr = PetscFPrintf(m_impl->com, PETSC_STDOUT, "%s", content.c_str());
+  PISM_CHK(ierr, "PetscFPrintf");
+}
+
 void Logger::message(int threshold, const char format[], ...) const {
   if ((not m_impl->enabled) or threshold > m_impl->threshold) {
     return;
@@ -71,6 +102,14 @@ void Logger::message(int threshold, const std::string &text) const {
 }
 
 void Logger::message_impl(const char buffer[]) const {
+  if (m_impl->buffer_size > 0) {
+    m_impl->buffer += buffer;
+    if (m_impl->buffer.size() >= m_impl->buffer_size) {
+      flush();
+    }
+    return;
+  }
+
   PetscErrorCode ierr = PetscFPrintf(m_impl->com, PETSC_STDOUT, "%s", buffer);
   PISM_CHK(ierr, "PetscFPrintf");
 }
@@ -87,6 +126,9 @@ void Logger::error(const char format[], ...) const {
 }
 
 void Logger::error_impl(const char buffer[]) const {
+  // keep buffered messages ordered with respect to the error
+  flush();
+
   PetscErrorCode ierr = PetscFPrintf(m_impl->com, stderr, "%s", buffer);
   PISM_CHK(ierr, "PetscFPrintf");
 }
@@ -55,6 +55,21 @@ public:
    */
   void error(const char format[], ...) const __attribute__((format(printf, 2, 3)));
 
+  //! Buffer messages instead of writing them out one by one.
+  /**
+   * Sets the buffer capacity in bytes; the buffer is written out (in one call) when it
+   * fills up, when an error message arrives, when flush() is called and when the logger
+   * is destroyed. A capacity of zero (the default) keeps the synchronous behavior.
+   *
+   * Per-message output flushes serialize ranks on `stdout` in verbose runs; buffering
+   * trades promptness of the log for time stepping speed. See
+   * output.runtime.log_buffer_size.
+   */
+  void set_buffer_size(size_t capacity);
+
+  //! Write out buffered messages, if any.
+  void flush() const;
+
   //! Set verbosity threshold.
   void set_threshold(int level);
 
@@ -24,6 +24,58 @@
 
 namespace pism {
 
+namespace mask {
+
+/*!
+ * Compute the interval list (run length encoding) of the owned cells at which the
+ * integer value of `mask` satisfies `selected`.
+ *
+ * Loops restricted to one class of cells (icy cells, ocean cells, cells of one basin,
+ * ...) can iterate the returned runs instead of scanning the whole sub-domain and
+ * testing every cell: the selected class is often a small fraction of the domain and
+ * runs are contiguous in memory, so such loops touch exactly the data they need.
+ * Building the list costs one scan of the mask; it pays off when several passes reuse
+ * it before the mask changes.
+ *
+ * The list is a snapshot: it is *not* updated when the mask changes (see
+ * Array::state_counter()).
+ */
+std::vector<Run> compute_runs(const array::Scalar &mask,
+                              const std::function<bool(int)> &selected) {
+  array::AccessScope list{ &mask };
+
+  const Grid &grid = *mask.grid();
+
+  const int
+    i_first = grid.xs(), i_end = grid.xs() + grid.xm(),
+    j_first = grid.ys(), j_end = grid.ys() + grid.ym();
+
+  std::vector<Run> result;
+
+  for (int j = j_first; j < j_end; ++j) {
+    int i = i_first;
+    while (i < i_end) {
+      // skip cells that are not selected
+      while (i < i_end and not selected(mask.as_int(i, j))) {
+        ++i;
+      }
+      if (i == i_end) {
+        break;
+      }
+      // `i` is selected: scan to the end of this run
+      const int start = i;
+      while (i < i_end and selected(mask.as_int(i, j))) {
+        ++i;
+      }
+      result.push_back({j, start, i - 1});
+    }
+  }
+
+  return result;
+}
+
+} // namespace mask
+
 void GeometryCalculator::compute(const array::Scalar& sea_level,
                                  const array::Scalar& bed,
                                  const array::Scalar& thickness,
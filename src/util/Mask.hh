@@ -19,6 +19,9 @@
 #ifndef _MASK_H_
 #define _MASK_H_
 
+#include <functional>
+#include <vector>
+
 // the following three includes are needed here because of inlined code
 #include "pism/util/Config.hh"
 #include "pism/util/error_handling.hh"
@@ -64,6 +67,20 @@ inline bool ice_free_ocean(int M) {
 inline bool ice_free_land(int M) {
   return grounded(M) && ice_free(M);
 }
+
+//! A run of consecutive cells (within one row of the owned sub-domain) selected from a
+//! mask; see compute_runs().
+struct Run {
+  //! global y ("row") index
+  int j;
+  //! global x index of the first cell of the run
+  int i_first;
+  //! global x index of the last cell of the run (inclusive)
+  int i_last;
+};
+
+std::vector<Run> compute_runs(const array::Scalar &mask,
+                              const std::function<bool(int)> &selected);
 } // namespace mask
 
 class GeometryCalculator {
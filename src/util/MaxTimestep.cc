@@ -25,12 +25,12 @@ namespace pism {
 
 // Time step restrictions
 MaxTimestep::MaxTimestep()
-  : m_finite(false), m_value(0.0) {
+  : m_finite(false), m_value(0.0), m_description_literal(nullptr) {
   // empty
 }
 
 MaxTimestep::MaxTimestep(double v)
-  : m_finite(true), m_value(v) {
+  : m_finite(true), m_value(v), m_description_literal(nullptr) {
   assert(v > 0.0);
 }
 
@@ -44,6 +44,16 @@ MaxTimestep::MaxTimestep(double v, const std::string &description)
   m_description = description;
 }
 
+MaxTimestep::MaxTimestep(const char *description)
+  : MaxTimestep() {
+  m_description_literal = description;
+}
+
+MaxTimestep::MaxTimestep(double v, const char *description)
+  : MaxTimestep(v) {
+  m_description_literal = description;
+}
+
 bool MaxTimestep::finite() const {
   return m_finite;
 }
@@ -57,6 +67,9 @@ double MaxTimestep::value() const {
 }
 
 std::string MaxTimestep::description() const {
+  if (m_description_literal != nullptr) {
+    return m_description_literal;
+  }
   return m_description;
 }
 
@@ -39,6 +39,15 @@ public:
   MaxTimestep(const std::string &new_description);
   //! Create an instance and provide a description.
   MaxTimestep(double value, const std::string &new_description);
+
+  //! @brief Same, for string literals. These overloads store the pointer instead of
+  //! copying the string, avoiding a heap allocation for every restriction object created
+  //! during time step selection; the `std::string` is built lazily, in description(),
+  //! i.e. only when a report is printed. The pointer has to remain valid for the lifetime
+  //! of this instance (string literals always are).
+  MaxTimestep(const char *new_description);
+  MaxTimestep(double value, const char *new_description);
+
   //! Convert to `bool` to check if a time step restriction is "active".
   bool finite() const;
   bool infinite() const;
@@ -50,6 +59,9 @@ public:
 private:
   bool m_finite;
   double m_value;
+  //! description provided as a string literal (not owned); NULL if m_description is used
+  const char *m_description_literal;
+  //! description copied from a `std::string`
   std::string m_description;
 };
 
@@ -0,0 +1,55 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "pism/util/OrderedAccumulator.hh"
+
+#include <cassert>
+
+namespace pism {
+
+//! A common cache line size (64 bytes), in doubles.
+static const size_t line = 64 / sizeof(double);
+
+OrderedAccumulator::OrderedAccumulator(size_t n_buckets, size_t n_sums)
+  : m_n_sums(n_sums),
+    m_stride(((n_sums + line - 1) / line) * line),
+    m_n_buckets(n_buckets),
+    m_data(n_buckets * m_stride, 0.0) {
+  assert(n_sums > 0);
+}
+
+double* OrderedAccumulator::bucket(size_t k) {
+  assert(k < m_n_buckets);
+  return &m_data[k * m_stride];
+}
+
+void OrderedAccumulator::total(double *result) const {
+  for (size_t s = 0; s < m_n_sums; ++s) {
+    result[s] = 0.0;
+  }
+
+  for (size_t k = 0; k < m_n_buckets; ++k) {
+    const double *b = &m_data[k * m_stride];
+    for (size_t s = 0; s < m_n_sums; ++s) {
+      result[s] += b[s];
+    }
+  }
+}
+
+} // end of namespace pism
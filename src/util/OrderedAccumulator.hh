@@ -0,0 +1,71 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef PISM_ORDEREDACCUMULATOR_H
+#define PISM_ORDEREDACCUMULATOR_H
+
+#include <cstddef>              // size_t
+#include <vector>
+
+namespace pism {
+
+/*!
+ * Partial sums for threaded loops, combined in a fixed order.
+ *
+ * A loop parallelized over threads cannot accumulate floating point sums into a shared
+ * variable: an `omp critical` (or atomic) accumulator serializes threads, and -- because
+ * floating point addition is not associative -- produces sums that depend on the order in
+ * which threads arrive, i.e. results that change from run to run.
+ *
+ * Keeping one partial sum per *thread* fixes the data race but not the reproducibility:
+ * with dynamic scheduling the set of iterations a thread processes changes between runs
+ * and with the number of threads.
+ *
+ * This class keeps partial sums in buckets indexed by a deterministic quantity instead --
+ * usually the index of the loop being parallelized (e.g. the grid row) -- so each bucket
+ * gets the same value no matter which thread computed it. total() combines buckets in
+ * index order, making the result bitwise identical for any number of threads, including
+ * one. Buckets are padded to the cache line size so that threads writing to adjacent
+ * buckets do not share a line.
+ *
+ * Each bucket holds `n_sums` values: loops accumulating several quantities (counts,
+ * volumes, ...) use one accumulator for all of them.
+ */
+class OrderedAccumulator {
+public:
+  OrderedAccumulator(size_t n_buckets, size_t n_sums);
+
+  //! Pointer to the `n_sums` partial sums of the bucket `k` (initialized to zero).
+  double* bucket(size_t k);
+
+  //! Combine buckets in index order. `result` has to have room for `n_sums` values.
+  void total(double *result) const;
+
+private:
+  size_t m_n_sums;
+  //! distance between consecutive buckets, in doubles (`n_sums` rounded up to a whole
+  //! number of cache lines)
+  size_t m_stride;
+  size_t m_n_buckets;
+  std::vector<double> m_data;
+};
+
+} // end of namespace pism
+
+#endif /* PISM_ORDEREDACCUMULATOR_H */
@@ -23,6 +23,7 @@
 #include "pism/util/petscwrappers/DM.hh"
 #include "pism/util/petscwrappers/Vec.hh"
 #include "pism/util/Interpolation1D.hh"
+#include "pism/util/pism_utilities.hh"
 
 namespace pism {
 
@@ -31,7 +32,8 @@ Poisson::Poisson(std::shared_ptr<const Grid> grid)
     m_log(grid->ctx()->log()),
     m_b(grid, "poisson_rhs"),
     m_x(grid, "poisson_x"),
-    m_mask(grid, "poisson_mask") {
+    m_mask(grid, "poisson_mask"),
+    m_assembled(false) {
 
   m_da = m_x.dm();
   m_mask.set_interpolation_type(NEAREST);
@@ -51,28 +53,84 @@ Poisson::Poisson(std::shared_ptr<const Grid> grid)
     ierr = KSPSetOptionsPrefix(m_KSP, "poisson_");
     PISM_CHK(ierr, "KSPSetOptionsPrefix");
 
-    // Process options:
+    // Use algebraic multigrid preconditioning by default: the hierarchy is built once
+    // per assemble() call and re-used by repeated solves with the same operator.
+    PC pc;
+    ierr = KSPGetPC(m_KSP, &pc);
+    PISM_CHK(ierr, "KSPGetPC");
+
+    ierr = PCSetType(pc, PCGAMG);
+    PISM_CHK(ierr, "PCSetType");
+
+    // Process options (this makes it possible to override the preconditioner choice
+    // above using -poisson_pc_type):
     ierr = KSPSetFromOptions(m_KSP);
     PISM_CHK(ierr, "KSPSetFromOptions");
   }
 }
 
+/*!
+ * Assemble the matrix approximating the Laplacian on the domain defined by `mask == 1`
+ * (see solve() for the interpretation of other mask values) and set it as the operator
+ * used by subsequent solve(bc, rhs) calls.
+ *
+ * The preconditioner is set up once per assemble() call, so solving with several right
+ * hand sides on a fixed domain pays the setup cost only once.
+ */
+void Poisson::assemble(const array::Scalar &mask) {
+  // make a ghosted copy of the mask
+  m_mask.copy_from(mask);
+
+  assemble_matrix(m_mask, m_A);
+
+  PetscErrorCode ierr = KSPSetOperators(m_KSP, m_A, m_A);
+  PISM_CHK(ierr, "KSPSetOperators");
+
+  m_assembled = true;
+}
+
+/*!
+ * Return true if `mask` differs from the one used by the last assemble() call (or if
+ * assemble() was never called).
+ */
+bool Poisson::mask_changed(const array::Scalar &mask) const {
+  if (not m_assembled) {
+    return true;
+  }
+
+  int changed = 0;
+
+  array::AccessScope list{&mask, &m_mask};
+
+  for (auto p : m_grid->points()) {
+    const int i = p.i(), j = p.j();
+
+    if (mask.as_int(i, j) != m_mask.as_int(i, j)) {
+      changed = 1;
+      break;
+    }
+  }
+
+  return GlobalMax(m_grid->com, changed) == 1;
+}
+
 /*!
  * Solve the Poisson equation on the domain defined by `mask == 1` with Dirichlet BC
  * provided in `bc` (used only where `mask == 0`, possibly redundant away from the domain)
  * with the constant right hand side `rhs`.
  *
  * Set the mask to 2 to use zero Neumann BC.
+ *
+ * The matrix is re-assembled only if the mask changed since the previous call (or if this
+ * is the first call); `reuse_matrix == true` skips even the mask comparison, asserting
+ * that the domain did not change.
  */
 int Poisson::solve(const array::Scalar& mask, const array::Scalar& bc, double rhs,
                    bool reuse_matrix) {
 
   PetscErrorCode ierr;
 
-  // make a ghosted copy of the mask
-  m_mask.copy_from(mask);
-
-  if (reuse_matrix) {
+  if ((reuse_matrix and m_assembled) or not mask_changed(mask)) {
     // Use non-zero initial guess. I assume that re-using the matrix means that the BC and
     // RHS provided are close to the ones used in the previous call and the solution
     // stored in m_x is a good initial guess for the current problem.
@@ -82,15 +140,34 @@ int Poisson::solve(const array::Scalar& mask, const array::Scalar& bc, double rh
     ierr = KSPSetInitialGuessNonzero(m_KSP, PETSC_FALSE);
     PISM_CHK(ierr, "KSPSetInitialGuessNonzero");
 
-    assemble_matrix(m_mask, m_A);
+    assemble(mask);
   }
 
+  return solve_impl(bc, rhs);
+}
+
+/*!
+ * Solve with the operator built by the last assemble() call and the previous solution as
+ * the initial guess. Use this to solve on a fixed domain with several right hand sides.
+ */
+int Poisson::solve(const array::Scalar &bc, double rhs) {
+  if (not m_assembled) {
+    throw RuntimeError(PISM_ERROR_LOCATION,
+                       "Poisson::assemble() has to be called before Poisson::solve(bc, rhs)");
+  }
+
+  PetscErrorCode ierr = KSPSetInitialGuessNonzero(m_KSP, PETSC_TRUE);
+  PISM_CHK(ierr, "KSPSetInitialGuessNonzero");
+
+  return solve_impl(bc, rhs);
+}
+
+int Poisson::solve_impl(const array::Scalar &bc, double rhs) {
+  PetscErrorCode ierr;
+
   assemble_rhs(rhs, m_mask, bc, m_b);
 
   // Call PETSc to solve linear system by iterative method.
-  ierr = KSPSetOperators(m_KSP, m_A, m_A);
-  PISM_CHK(ierr, "KSPSetOperator");
-
   ierr = KSPSolve(m_KSP, m_b.vec(), m_x.vec());
   PISM_CHK(ierr, "KSPSolve");
 
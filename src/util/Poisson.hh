@@ -30,11 +30,17 @@ class Poisson {
 public:
   Poisson(std::shared_ptr<const Grid> grid);
 
+  void assemble(const array::Scalar &mask);
+
+  int solve(const array::Scalar &bc, double rhs);
+
   int solve(const array::Scalar& mask, const array::Scalar& bc, double rhs,
             bool reuse_matrix = false);
 
   const array::Scalar &solution() const;
 private:
+  bool mask_changed(const array::Scalar &mask) const;
+  int solve_impl(const array::Scalar &bc, double rhs);
   void assemble_matrix(const array::Scalar1 &mask, Mat A);
   void assemble_rhs(double rhs,
                     const array::Scalar &mask,
@@ -49,6 +55,8 @@ private:
   array::Scalar m_b;
   array::Scalar m_x;
   array::Scalar1 m_mask;
+  //! true if assemble() was called at least once
+  bool m_assembled;
 };
 
 } // end of namespace pism
@@ -17,17 +17,23 @@
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
 #include <petsclog.h>
 #include <petscviewer.h>
 
 #include "pism/util/Profiling.hh"
 #include "pism/util/error_handling.hh"
+#include "pism/util/pism_utilities.hh"
 
 namespace pism {
 
 // PETSc profiling events
 
-Profiling::Profiling() {
+Profiling::Profiling()
+  : m_trace_enabled(false), m_trace_start_time(0.0) {
   PetscErrorCode ierr = PetscClassIdRegister("PISM", &m_classid);
   PISM_CHK(ierr, "PetscClassIdRegister");
 }
@@ -84,6 +90,11 @@ void Profiling::begin(const char * name) const {
   } else {
     event = m_events[name];
   }
+
+  if (m_trace_enabled) {
+    m_trace.push_back({name, MPI_Wtime() - m_trace_start_time, 'B'});
+  }
+
   ierr = PetscLogEventBegin(event, 0, 0, 0, 0);
   PISM_CHK(ierr, "PetscLogEventBegin");
 }
@@ -96,6 +107,10 @@ void Profiling::end(const char * name) const {
                                   name);
   }
 
+  if (m_trace_enabled) {
+    m_trace.push_back({name, MPI_Wtime() - m_trace_start_time, 'E'});
+  }
+
   PetscErrorCode ierr = PetscLogEventEnd(m_events[name], 0, 0, 0, 0);
   PISM_CHK(ierr, "PetscLogEventEnd");
 }
@@ -112,14 +127,153 @@ void Profiling::stage_begin(const char * name) const {
   } else {
     stage = m_stages[name];
   }
+
+  if (m_trace_enabled) {
+    m_trace.push_back({name, MPI_Wtime() - m_trace_start_time, 'B'});
+  }
+
   ierr = PetscLogStagePush(stage);
   PISM_CHK(ierr, "PetscLogStagePush");
 }
 
 void Profiling::stage_end(const char * name) const {
-  (void) name;
+  if (m_trace_enabled) {
+    m_trace.push_back({name, MPI_Wtime() - m_trace_start_time, 'E'});
+  }
+
   PetscErrorCode ierr = PetscLogStagePop();
   PISM_CHK(ierr, "PetscLogStagePop");
 }
 
+//! Start recording begin and end times of profiling events and stages.
+void Profiling::trace_start() const {
+  m_trace_enabled    = true;
+  m_trace_start_time = MPI_Wtime();
+  m_trace.reserve(1024);
+}
+
+//! Save the recorded trace.
+/*!
+  Writes
+
+  - one Chrome trace-event JSON file per rank (`<prefix>-<rank>.json`), loadable in
+    chrome://tracing or Perfetto; each rank uses its rank number as the "thread" ID, so
+    concatenated files line up in one view and load imbalance and per-stage jitter are
+    visible directly;
+  - one plain-text summary (`<prefix>-summary.txt`, written by rank 0) giving, for each
+    event, the minimum, mean and maximum of the per-rank total times and the
+    max-to-mean ratio (the usual load imbalance measure).
+
+  Event nesting is preserved: begin/end pairs appear in recording order, which is what
+  the trace-event format expects for nested durations.
+ */
+void Profiling::trace_report(const std::string &prefix) const {
+  if (not m_trace_enabled) {
+    return;
+  }
+
+  MPI_Comm com = PETSC_COMM_WORLD;
+  int rank = 0, size = 1;
+  MPI_Comm_rank(com, &rank);
+  MPI_Comm_size(com, &size);
+
+  // per-rank Chrome trace
+  {
+    auto filename = pism::printf("%s-%04d.json", prefix.c_str(), rank);
+    std::ofstream output(filename.c_str());
+    if (not output) {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                    "failed to open '%s'", filename.c_str());
+    }
+
+    output << "[\n";
+    for (size_t k = 0; k < m_trace.size(); ++k) {
+      const TraceEntry &e = m_trace[k];
+      output << pism::printf("{\"name\": \"%s\", \"cat\": \"pism\", \"ph\": \"%c\","
+                             " \"ts\": %.3f, \"pid\": 0, \"tid\": %d}%s\n",
+                             e.name.c_str(), e.phase, e.time * 1e6, rank,
+                             k + 1 < m_trace.size() ? "," : "");
+    }
+    output << "]\n";
+  }
+
+  // total duration of each event on this rank; a stack per name pairs each end with
+  // the latest unmatched begin, handling nested and repeated events
+  std::map<std::string, double> totals;
+  {
+    std::map<std::string, std::vector<double> > open;
+    for (const auto &e : m_trace) {
+      if (e.phase == 'B') {
+        open[e.name].push_back(e.time);
+      } else {
+        auto &stack = open[e.name];
+        if (not stack.empty()) {
+          totals[e.name] += e.time - stack.back();
+          stack.pop_back();
+        }
+      }
+    }
+  }
+
+  // gather per-rank totals to rank 0 as text (event sets may differ between ranks)
+  std::string local;
+  for (const auto &t : totals) {
+    local += pism::printf("%s %f\n", t.first.c_str(), t.second);
+  }
+
+  int local_size = (int)local.size();
+  std::vector<int> sizes(size), offsets(size);
+  MPI_Gather(&local_size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, com);
+
+  std::string all;
+  if (rank == 0) {
+    int total_size = 0;
+    for (int r = 0; r < size; ++r) {
+      offsets[r] = total_size;
+      total_size += sizes[r];
+    }
+    all.resize(total_size);
+  }
+  MPI_Gatherv(local.c_str(), local_size, MPI_CHAR,
+              rank == 0 ? &all[0] : nullptr, sizes.data(), offsets.data(),
+              MPI_CHAR, 0, com);
+
+  if (rank == 0) {
+    std::map<std::string, std::vector<double> > merged;
+    {
+      std::istringstream input(all);
+      std::string name;
+      double value = 0.0;
+      while (input >> name >> value) {
+        merged[name].push_back(value);
+      }
+    }
+
+    auto filename = prefix + "-summary.txt";
+    std::ofstream output(filename.c_str());
+    if (not output) {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                    "failed to open '%s'", filename.c_str());
+    }
+
+    output << pism::printf("# per-rank total event times over %d ranks (seconds)\n"
+                           "# %-30s %12s %12s %12s %10s\n",
+                           size, "event", "min", "mean", "max", "max/mean");
+    for (const auto &m : merged) {
+      // ranks that never recorded an event contribute zero
+      double v_min = m.second.size() < (size_t)size ? 0.0 : m.second.front(),
+             v_max = 0.0, sum = 0.0;
+      for (double v : m.second) {
+        v_min = std::min(v_min, v);
+        v_max = std::max(v_max, v);
+        sum += v;
+      }
+      double mean = sum / size;
+      output << pism::printf("%-32s %12.6f %12.6f %12.6f %10.2f\n",
+                             m.first.c_str(), v_min, mean, v_max,
+                             mean > 0.0 ? v_max / mean : 0.0);
+    }
+  }
+}
+
 } // end of namespace pism
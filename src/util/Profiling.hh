@@ -22,6 +22,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 #include <petsclog.h>
 
 namespace pism {
@@ -35,10 +36,23 @@ public:
   void end(const char *name) const;
   void stage_begin(const char *name) const;
   void stage_end(const char *name) const;
+  void trace_start() const;
+  void trace_report(const std::string &prefix) const;
 private:
   PetscClassId m_classid;
   mutable std::map<std::string, PetscLogEvent> m_events;
   mutable std::map<std::string, PetscLogStage> m_stages;
+
+  //! One record of the trace: a begin (phase 'B') or end (phase 'E') of an event or
+  //! stage. `time` is in seconds since trace_start().
+  struct TraceEntry {
+    std::string name;
+    double time;
+    char phase;
+  };
+  mutable bool m_trace_enabled;
+  mutable double m_trace_start_time;
+  mutable std::vector<TraceEntry> m_trace;
 };
 
 } // end of namespace pism
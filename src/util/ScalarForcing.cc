@@ -85,7 +85,10 @@ void ScalarForcing::initialize(const Context &ctx,
                          "  reading %s (%s) from file '%s'...\n",
                          long_name.c_str(), variable_name.c_str(), filename.c_str());
 
-      File file(ctx.com(), filename, io::PISM_NETCDF3, io::PISM_READONLY);
+      // several forcing components often read (different variables of) one file, so the
+      // pooled handle is likely to be reused right away
+      auto file_ptr = ctx.input_file_cache()->get(filename);
+      const File &file = *file_ptr;
 
       // Read forcing data. The read_1d_variable() call will ensure that variable_name is a
       // scalar variable.
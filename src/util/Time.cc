@@ -442,6 +442,28 @@ void Time::init_calendar(const std::string &calendar_string) {
     // use the ~365.2524-day year
     m_year_length = convert(m_unit_system, 1.0, "year", "seconds");
   }
+
+  // Pre-compute month start offsets for calendars with fixed month lengths (used by the
+  // fast path in date()).
+  m_month_start.clear();
+  if (set_member(calendar_string, {"360_day", "365_day", "noleap"})) {
+    const int month_length_360[12] = {30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30};
+    const int month_length_365[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+    const int *month_length =
+      calendar_string == "360_day" ? month_length_360 : month_length_365;
+
+    double offset = 0.0;
+    for (int k = 0; k < 12; ++k) {
+      m_month_start.push_back(offset);
+      offset += month_length[k] * seconds_per_day;
+    }
+    m_month_start.push_back(offset); // == m_year_length
+  }
+
+  // changing the calendar invalidates cached conversion results
+  m_year_cache.valid = false;
+  m_interval_cache.clear();
 }
 
 //! \brief Sets the current time (in seconds since the reference time).
@@ -556,10 +578,26 @@ std::vector<double> Time::parse_list(const std::string &spec) const {
 /**
  * Parses an interval specification string.
  *
+ * Results are memoized: reporting code re-parses the same handful of specifications
+ * over and over again.
+ *
  * @param[in] spec specification string
  *
  */
 auto Time::parse_interval_length(const std::string &spec) const -> Interval {
+  auto cached = m_interval_cache.find(spec);
+  if (cached != m_interval_cache.end()) {
+    return cached->second;
+  }
+
+  auto result = parse_interval_length_impl(spec);
+
+  m_interval_cache[spec] = result;
+
+  return result;
+}
+
+auto Time::parse_interval_length_impl(const std::string &spec) const -> Interval {
 
   // check if it is a keyword
   if (spec == "hourly") {
@@ -805,6 +843,9 @@ void Time::init_from_file(MPI_Comm com,
                                                          "irrelevant (not used)",
                                                          stop_on_error);
       m_time_units = units::Unit(m_unit_system, "seconds since " + date_string);
+
+      // changing the reference date invalidates cached conversion results
+      m_year_cache.valid = false;
     }
 
     // Read time information from the file.
@@ -832,7 +873,13 @@ void Time::init_from_file(MPI_Comm com,
   }
 }
 
-double Time::year_fraction(double T) const {
+//! Return cached bounds of the calendar year containing the time `T`, updating the cache
+//! if necessary.
+auto Time::year_cache(double T) const -> const YearCache& {
+  if (m_year_cache.valid and
+      T >= m_year_cache.year_start and T < m_year_cache.next_year_start) {
+    return m_year_cache;
+  }
 
   auto D = m_time_units.date(T, m_calendar_string);
 
@@ -843,24 +890,56 @@ double Time::year_fraction(double T) const {
   D2.year += 1;
   auto next_year_start = m_time_units.time(D2, m_calendar_string);
 
-  return (T - year_start) / (next_year_start - year_start);
+  m_year_cache = {true, D.year, year_start, next_year_start};
+
+  return m_year_cache;
+}
+
+double Time::year_fraction(double T) const {
+  const auto &Y = year_cache(T);
+
+  return (T - Y.year_start) / (Y.next_year_start - Y.year_start);
 }
 
 std::string Time::date(double T) const {
-  auto date = m_time_units.date(T, m_calendar_string);
+  int year = 0, month = 0, day = 0;
+  double hour = 0.0;
 
-  double hour = date.hour + date.minute / 60.0 + date.second / 3600.0;
+  if (not m_month_start.empty()) {
+    // Fixed month lengths: get the year bounds from the cache and the month from the
+    // pre-computed table instead of doing calendar arithmetic.
+    const auto &Y = year_cache(T);
 
-  return pism::printf("%04d-%02d-%02d %06.3fh",
-                      date.year, date.month, date.day, hour);
-}
+    const double day_length = 86400.0;
 
-double Time::calendar_year_start(double T) const {
-  auto D = m_time_units.date(T, m_calendar_string);
+    double offset = T - Y.year_start;
 
-  units::DateTime D2{D.year, 1, 1, 0, 0, 0.0};
+    month = 1;
+    while (month < 12 and offset >= m_month_start[month]) {
+      month += 1;
+    }
+    offset -= m_month_start[month - 1];
 
-  return m_time_units.time(D2, m_calendar_string);
+    day = static_cast<int>(offset / day_length);
+    offset -= day * day_length;
+
+    year = Y.year;
+    day += 1;                   // days are one-based
+    hour = offset / 3600.0;
+  } else {
+    auto date = m_time_units.date(T, m_calendar_string);
+
+    year  = date.year;
+    month = date.month;
+    day   = date.day;
+    hour  = date.hour + date.minute / 60.0 + date.second / 3600.0;
+  }
+
+  return pism::printf("%04d-%02d-%02d %06.3fh", year, month, day, hour);
+}
+
+double Time::calendar_year_start(double T) const {
+  return year_cache(T).year_start;
 }
 
 
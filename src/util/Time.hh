@@ -19,8 +19,9 @@
 #ifndef _PISMTIME_H_
 #define _PISMTIME_H_
 
-#include <vector>
+#include <map>
 #include <memory>
+#include <vector>
 
 #include "VariableMetadata.hh"
 #include "pism/util/pism_utilities.hh"
@@ -143,6 +144,8 @@ protected:
 
   Interval parse_interval_length(const std::string &spec) const;
 
+  Interval parse_interval_length_impl(const std::string &spec) const;
+
   //! Convert time interval length in years into seconds using the year length
   //! corresponding to the chosen calendar.
   double years_to_seconds(double input) const;
@@ -178,6 +181,32 @@ protected:
   // True if the calendar has constant year lengths (360_day, 365_day)
   bool m_simple_calendar;
 
+  //! Cached bounds of one calendar year.
+  /*!
+    Date conversions are called every time step by reporting and forcing code, and the
+    model time stays within one calendar year for many consecutive calls, so year_fraction()
+    and friends re-use these bounds instead of repeating calendar arithmetic.
+  */
+  struct YearCache {
+    bool valid;
+    //! the calendar year containing the time of the last conversion
+    int year;
+    //! model time of the start of `year`, in seconds
+    double year_start;
+    //! model time of the start of the following year, in seconds
+    double next_year_start;
+  };
+  mutable YearCache m_year_cache;
+
+  const YearCache& year_cache(double T) const;
+
+  //! Month start offsets from the beginning of a year, in seconds; used by the date()
+  //! fast path. Empty unless the calendar has fixed month lengths.
+  std::vector<double> m_month_start;
+
+  //! Cache of parsed interval specifications (cleared when the calendar changes).
+  mutable std::map<std::string, Interval> m_interval_cache;
+
   void init_from_file(MPI_Comm com, const std::string &filename, const Logger &log,
                       bool set_start_time);
 
@@ -19,6 +19,9 @@
 
 #include "pism/util/Units.hh"
 
+#include <map>
+#include <tuple>
+
 #include <udunits2.h>
 
 #include "pism/external/calcalcs/utCalendar2_cal.h"
@@ -231,17 +234,50 @@ struct Converter::Impl {
   cv_converter *converter;
 };
 
+//! Return the converter for a (from, to) unit string pair, creating it if necessary.
+/*!
+  Creating a converter parses both unit strings with UDUNITS; call sites such as
+  per-record forcing reads and metadata handling create converters for the same few
+  pairs over and over, so completed converters are kept in a process-wide cache.
+  Sharing is safe: conversion does not modify the underlying cv_converter. Each cache
+  entry holds a reference to the unit system it was created with, so an entry never
+  outlives its system (and a recycled System address cannot alias a stale entry).
+
+  Failed constructions (unknown units, incompatible pairs) are not cached and throw as
+  before.
+ */
+std::shared_ptr<Converter::Impl> Converter::shared_impl(System::Ptr sys,
+                                                        const std::string &spec1,
+                                                        const std::string &spec2) {
+  typedef std::tuple<const void*, std::string, std::string> Key;
+  static std::map<Key, std::pair<System::Ptr, std::shared_ptr<Impl> > > cache;
+
+  Key key(sys.get(), spec1, spec2);
+
+  auto it = cache.find(key);
+  if (it == cache.end()) {
+    auto impl = std::make_shared<Impl>(sys, spec1, spec2);
+    it = cache.emplace(key, std::make_pair(sys, impl)).first;
+  }
+
+  return it->second.second;
+}
+
 Converter::Converter() {
   m_impl.reset(new Impl());
 }
 
 Converter::Converter(System::Ptr sys,
                      const std::string &spec1, const std::string &spec2) {
-  m_impl.reset(new Impl(sys, spec1, spec2));
+  m_impl = shared_impl(sys, spec1, spec2);
 }
 
 Converter::Converter(const Unit &u1, const Unit &u2) {
-  m_impl.reset(new Impl(u1, u2));
+  if (u1.system().get() == u2.system().get()) {
+    m_impl = shared_impl(u1.system(), u1.string(), u2.string());
+  } else {
+    m_impl.reset(new Impl(u1, u2));
+  }
 }
 
 bool are_convertible(const Unit &u1, const Unit &u2) {
@@ -256,6 +292,10 @@ void Converter::convert_doubles(double *data, size_t length) const {
   cv_convert_doubles(m_impl->converter, data, length, data);
 }
 
+void Converter::convert_doubles(const double *input, size_t length, double *output) const {
+  cv_convert_doubles(m_impl->converter, input, length, output);
+}
+
 } // end of namespace units
 
 } // end of namespace pism
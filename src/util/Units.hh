@@ -112,12 +112,27 @@ public:
    * @param length length of the array
    */
   void convert_doubles(double *data, size_t length) const;
+
+  /** Convert an array of doubles, writing results to `output`
+   *
+   * This makes it possible to convert in one pass while filling an output buffer,
+   * avoiding a separate copy. `output` may be equal to `input`.
+   *
+   * @param[in] input array to process
+   * @param length length of the array
+   * @param[out] output array holding converted values
+   */
+  void convert_doubles(const double *input, size_t length, double *output) const;
   double operator()(double input) const;
 private:
 
   struct Impl;
   std::shared_ptr<Impl> m_impl;
 
+  static std::shared_ptr<Impl> shared_impl(System::Ptr sys,
+                                           const std::string &spec1,
+                                           const std::string &spec2);
+
   // hide copy constructor and the assignment operator
   Converter(const Converter &);
   Converter& operator=(Converter const &);
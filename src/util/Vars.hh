@@ -24,6 +24,8 @@
 #include <string>
 #include <memory>
 
+#include "pism/util/error_handling.hh" // RuntimeError (used by Vars::Handle)
+
 namespace pism {
 
 
@@ -47,6 +49,79 @@ public:
   void remove(const std::string &name);
   bool is_available(const std::string &name) const;
 
+  //! Typed handle referring to a variable in a Vars dictionary.
+  /*!
+    Resolve a name once (paying for map lookups and a dynamic cast), then access the
+    field in O(1) in code executed every step:
+
+    \code
+    Vars::Handle<array::Scalar> thickness = vars.handle<array::Scalar>("land_ice_thickness");
+    // ...
+    double H = (*thickness)(i, j);
+    \endcode
+
+    In debug builds every access checks that the variable is still in the dictionary
+    (and is still the same field); de-referencing a stale or empty handle throws.
+  */
+  template <class A>
+  class Handle {
+  public:
+    Handle() : m_array(nullptr), m_vars(nullptr) {}
+
+    const A& operator*() const {
+      check();
+      return *m_array;
+    }
+    const A* operator->() const {
+      check();
+      return m_array;
+    }
+    const A* get() const {
+      check();
+      return m_array;
+    }
+    //! true if this handle refers to a variable
+    explicit operator bool() const {
+      return m_array != nullptr;
+    }
+  private:
+    friend class Vars;
+    Handle(const A *array, const Vars *vars, const std::string &name)
+      : m_array(array), m_vars(vars), m_name(name) {}
+
+    void check() const {
+#if (Pism_DEBUG==1)
+      if (m_array == nullptr) {
+        throw RuntimeError(PISM_ERROR_LOCATION, "de-referencing an empty Vars::Handle");
+      }
+      if (m_vars->get_internal(m_name) != static_cast<const array::Array*>(m_array)) {
+        throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                      "de-referencing a stale Vars::Handle:"
+                                      " '%s' was removed or replaced",
+                                      m_name.c_str());
+      }
+#endif
+    }
+
+    const A *m_array;
+    const Vars *m_vars;
+    std::string m_name;
+  };
+
+  //! Resolve `name` into a typed handle (see Vars::Handle).
+  template <class A>
+  Handle<A> handle(const std::string &name) const {
+    const A *tmp = dynamic_cast<const A*>(this->get(name));
+
+    if (tmp == nullptr) {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                    "variable '%s' is not of the requested type",
+                                    name.c_str());
+    }
+
+    return Handle<A>(tmp, this, name);
+  }
+
   const array::Array* get(const std::string &name) const;
   const array::Scalar* get_2d_scalar(const std::string &name) const;
   const array::Scalar1* get_2d_scalar1(const std::string &name) const;
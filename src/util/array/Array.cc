@@ -20,6 +20,7 @@
 
 #include <cmath>
 #include <cstddef>
+#include <cstring>              // memcpy
 #include <memory>
 #include <petscdraw.h>
 #include <string>
@@ -107,6 +108,32 @@ Array::Array(std::shared_ptr<const Grid> grid, const std::string &name, Kind gho
 Array::~Array() {
   assert(m_impl->access_counter == 0);
 
+  // Perform the restore deferred by the last end_access(), if any. Cannot use
+  // flush_access_cache() here: it throws on failure and this is a destructor.
+  if (m_impl->access_cached) {
+    PetscErrorCode ierr = 0;
+    if (m_impl->begin_access_use_dof) {
+      ierr = DMDAVecRestoreArrayDOF(*m_impl->da, m_impl->v, &m_array);
+    } else {
+      ierr = DMDAVecRestoreArray(*m_impl->da, m_impl->v, &m_array);
+    }
+    CHKERRCONTINUE(ierr);
+    m_impl->access_cached = false;
+  }
+
+  // Return the underlying vector to the pool maintained by the DM (see vec()). PETSc
+  // resets the raw pointer, turning the destructor of the petsc::Vec wrapper into a
+  // no-op.
+  if (m_impl->v.get() != nullptr) {
+    PetscErrorCode ierr = 0;
+    if (m_impl->ghosted) {
+      ierr = DMRestoreLocalVector(*m_impl->da, m_impl->v.rawptr());
+    } else {
+      ierr = DMRestoreGlobalVector(*m_impl->da, m_impl->v.rawptr());
+    }
+    CHKERRCONTINUE(ierr);
+  }
+
   if (m_impl->bsearch_accel != nullptr) {
     gsl_interp_accel_free(m_impl->bsearch_accel);
     m_impl->bsearch_accel = nullptr;
@@ -311,15 +338,30 @@ unsigned int Array::stencil_width() const {
 }
 
 petsc::Vec &Array::vec() const {
+  // Every direct use of the Vec (PETSc linear algebra, ghost updates, I/O) goes through
+  // this method, making it the one place where the array access cached by end_access()
+  // has to be released.
+  flush_access_cache();
+
   if (m_impl->v.get() == nullptr) {
     PetscErrorCode ierr = 0;
+    // Get a vector from the pool maintained by the DM (shared by all the fields on this
+    // grid with the same dof and stencil width) instead of creating a new one:
+    // temporaries allocated by diagnostics come and go many times over a run and
+    // repeated create/destroy cycles fragment memory. The vector is returned to the
+    // pool in ~Array().
     if (m_impl->ghosted) {
-      ierr = DMCreateLocalVector(*dm(), m_impl->v.rawptr());
-      PISM_CHK(ierr, "DMCreateLocalVector");
+      ierr = DMGetLocalVector(*dm(), m_impl->v.rawptr());
+      PISM_CHK(ierr, "DMGetLocalVector");
     } else {
-      ierr = DMCreateGlobalVector(*dm(), m_impl->v.rawptr());
-      PISM_CHK(ierr, "DMCreateGlobalVector");
+      ierr = DMGetGlobalVector(*dm(), m_impl->v.rawptr());
+      PISM_CHK(ierr, "DMGetGlobalVector");
     }
+
+    // Unlike freshly-created vectors, pooled vectors may contain data left by a
+    // previous user:
+    ierr = VecSet(m_impl->v, 0.0);
+    PISM_CHK(ierr, "VecSet");
   }
   return m_impl->v;
 }
@@ -483,12 +525,13 @@ void Array::write_impl(const OutputFile &file) const {
   auto log  = grid()->ctx()->log();
   auto time = timestamp(m_impl->grid->com);
 
-  // get the unit converter from internal to output units
-  auto unit_converter = [this](unsigned int j) {
+  // get the unit converter from internal to output units (NULL if no conversion is
+  // needed)
+  auto unit_converter = [this](unsigned int j) -> std::shared_ptr<units::Converter> {
     auto ctx = grid()->ctx();
     if (ctx->config()->get_flag("output.use_MKS")) {
       // use internal units
-      return std::make_shared<units::Converter>();
+      return nullptr;
     }
 
     std::string units        = metadata(j)["units"];
@@ -501,7 +544,7 @@ void Array::write_impl(const OutputFile &file) const {
       return std::make_shared<units::Converter>(ctx->unit_system(), units, output_units);
     }
 
-    return std::make_shared<units::Converter>();
+    return nullptr;
   };
 
   // 3D arrays have one or more levels, collections of fields have 0 levels.
@@ -512,13 +555,38 @@ void Array::write_impl(const OutputFile &file) const {
   if (ndof() == 1) {
     log->message(3, "[%s] Writing %s...\n", time.c_str(), metadata(0).get_name().c_str());
 
+    auto converter = unit_converter(0);
+
+    if (not m_impl->ghosted) {
+      // The array's own storage is a global Vec with the layout expected by the output
+      // code, so we can avoid copying it into a temporary Vec: write it directly (no
+      // conversion) or convert in one pass into the I/O buffer.
+      petsc::VecArray v_array(vec());
+
+      if (converter == nullptr) {
+        file.write_distributed_array(metadata(0).get_name(), v_array.get());
+      } else {
+        petsc::TemporaryGlobalVec tmp(dm());
+        petsc::VecArray tmp_array(tmp);
+
+        converter->convert_doubles(v_array.get(), local_array_size, tmp_array.get());
+
+        file.write_distributed_array(metadata(0).get_name(), tmp_array.get());
+      }
+
+      return;
+    }
+
+    // A ghosted array: gather owned values into a temporary global Vec first.
     petsc::TemporaryGlobalVec tmp(dm());
 
     this->copy_to_vec(dm(), tmp);
 
     petsc::VecArray tmp_array(tmp);
 
-    unit_converter(0)->convert_doubles(tmp_array.get(), local_array_size);
+    if (converter != nullptr) {
+      converter->convert_doubles(tmp_array.get(), local_array_size);
+    }
 
     file.write_distributed_array(metadata(0).get_name(), tmp_array.get());
 
@@ -543,7 +611,10 @@ void Array::write_impl(const OutputFile &file) const {
 
       log->message(3, "[%s] Writing %s...\n", time.c_str(), metadata(j).get_name().c_str());
 
-      unit_converter(j)->convert_doubles(tmp_array.get(), local_array_size);
+      auto converter = unit_converter(j);
+      if (converter != nullptr) {
+        converter->convert_doubles(tmp_array.get(), local_array_size);
+      }
 
       file.write_distributed_array(metadata(j).get_name(), tmp_array.get());
     }
@@ -595,6 +666,12 @@ void Array::checkCompatibility(const char* func, const Array &other) const {
 }
 
 //! Checks if an Array is allocated and calls DAVecGetArray.
+/*!
+  If the previous end_access() left a cached pointer behind (see the deferred restore
+  there), re-use it instead of calling into PETSc: tight loops in diagnostics and
+  couplers set up access to the same group of arrays thousands of times per run, and
+  DMDAVecGetArray() rebuilds the multi-dimensional indexing structure on every call.
+ */
 void  Array::begin_access() const {
 
   if (m_impl->access_counter < 0) {
@@ -602,23 +679,33 @@ void  Array::begin_access() const {
   }
 
   if (m_impl->access_counter == 0) {
-    PetscErrorCode ierr;
-    if (m_impl->begin_access_use_dof) {
-      ierr = DMDAVecGetArrayDOF(*dm(), vec(), &m_array);
-      PISM_CHK(ierr, "DMDAVecGetArrayDOF");
+    if (m_impl->access_cached) {
+      // m_array is still valid: nothing touched the underlying Vec since the last
+      // end_access() (every direct use of the Vec goes through vec(), which performs the
+      // deferred restore).
+      m_impl->access_cached = false;
     } else {
-      ierr = DMDAVecGetArray(*dm(), vec(), &m_array);
-      PISM_CHK(ierr, "DMDAVecGetArray");
+      PetscErrorCode ierr;
+      if (m_impl->begin_access_use_dof) {
+        ierr = DMDAVecGetArrayDOF(*dm(), vec(), &m_array);
+        PISM_CHK(ierr, "DMDAVecGetArrayDOF");
+      } else {
+        ierr = DMDAVecGetArray(*dm(), vec(), &m_array);
+        PISM_CHK(ierr, "DMDAVecGetArray");
+      }
     }
   }
 
   m_impl->access_counter++;
 }
 
-//! Checks if an Array is allocated and calls DAVecRestoreArray.
+//! Marks the end of a begin_access()..end_access() pair.
+/*!
+  The DMDAVecRestoreArray() call is deferred: `m_array` is kept so that the next
+  begin_access() can re-use it. The deferred restore is performed by
+  flush_access_cache() as soon as the underlying Vec is used directly (see vec()).
+ */
 void  Array::end_access() const {
-  PetscErrorCode ierr;
-
   if (m_array == NULL) {
     throw RuntimeError(PISM_ERROR_LOCATION,
                        "Array::end_access(): a == NULL (looks like begin_access() was not called)");
@@ -630,19 +717,246 @@ void  Array::end_access() const {
 
   m_impl->access_counter--;
   if (m_impl->access_counter == 0) {
-    if (m_impl->begin_access_use_dof) {
-      ierr = DMDAVecRestoreArrayDOF(*dm(), vec(), &m_array);
-      PISM_CHK(ierr, "DMDAVecRestoreArrayDOF");
-    } else {
-      ierr = DMDAVecRestoreArray(*dm(), vec(), &m_array);
-      PISM_CHK(ierr, "DMDAVecRestoreArray");
-    }
-    m_array = NULL;
+    m_impl->access_cached = true;
   }
 }
 
+//! Performs the DMDAVecRestoreArray() call deferred by end_access(), if any.
+/*!
+  Called by vec() before handing out the underlying Vec, so that PETSc operations on it
+  (VecAXPY(), DMLocalToLocalBegin(), I/O, etc) never run with an outstanding
+  DMDAVecGetArray(). A no-op while the array is actively accessed: `access_cached` is
+  set only once the access counter drops to zero.
+ */
+void Array::flush_access_cache() const {
+  if (not m_impl->access_cached) {
+    return;
+  }
+
+  m_impl->access_cached = false;
+
+  // Use m_impl->v and m_impl->da directly: both are initialized (the cached pointer
+  // came from a successful begin_access()) and calling vec() here would recurse.
+  PetscErrorCode ierr;
+  if (m_impl->begin_access_use_dof) {
+    ierr = DMDAVecRestoreArrayDOF(*m_impl->da, m_impl->v, &m_array);
+    PISM_CHK(ierr, "DMDAVecRestoreArrayDOF");
+  } else {
+    ierr = DMDAVecRestoreArray(*m_impl->da, m_impl->v, &m_array);
+    PISM_CHK(ierr, "DMDAVecRestoreArray");
+  }
+  m_array = NULL;
+}
+
 //! Updates ghost points.
 void  Array::update_ghosts() {
+  if (m_impl->reduced_precision_halo) {
+    update_ghosts_packed_float(m_impl->da_stencil_width);
+    return;
+  }
+
+  update_ghosts_begin();
+  update_ghosts_end();
+}
+
+//! Updates the innermost `width` rows of ghost points.
+/*!
+  Like update_ghosts(), but exchanges a halo of the requested width instead of the full
+  declared stencil width. Halo volume is roughly proportional to the width, so use this
+  before passes that read a narrower stencil than the one the array was allocated with
+  (e.g. a width-1 pass over a field allocated with width 2) to move proportionally less
+  data. Ghost values outside the requested width are left unchanged and may be stale.
+*/
+void Array::update_ghosts(unsigned int width) {
+  if ((not m_impl->ghosted) or width == 0) {
+    return;
+  }
+
+  if (m_impl->reduced_precision_halo) {
+    update_ghosts_packed_float(std::min(width, m_impl->da_stencil_width));
+    return;
+  }
+
+  if (width >= m_impl->da_stencil_width) {
+    update_ghosts();
+    return;
+  }
+
+  auto grid = m_impl->grid;
+
+  // use the DM dof (for 3D arrays ndof() == 1 and the dof of the underlying DM is the
+  // number of vertical levels)
+  auto dof = std::max(levels().size(), (size_t)ndof());
+
+  auto da = grid->get_dm(dof, width);
+
+  petsc::TemporaryLocalVec work(da);
+
+  petsc::DMDAVecArrayDOF work_array(da, work);
+  double ***buffer = static_cast<double ***>(work_array.get());
+
+  petsc::DMDAVecArrayDOF tmp(dm(), vec());
+  double ***data = static_cast<double ***>(tmp.get());
+
+  const int
+    xs = grid->xs(), xm = grid->xm(),
+    ys = grid->ys(), ym = grid->ym(),
+    w  = static_cast<int>(width),
+    n  = static_cast<int>(dof);
+
+  // Pack owned values and the innermost `width` rows of ghosts. Ghost values at the
+  // edge of the computational domain are not exchanged: copying them here and back
+  // below leaves them unchanged, just like update_ghosts().
+  for (int j = ys - w; j < ys + ym + w; ++j) {
+    for (int i = xs - w; i < xs + xm + w; ++i) {
+      for (int k = 0; k < n; ++k) {
+        buffer[j][i][k] = data[j][i][k];
+      }
+    }
+  }
+
+  {
+    PetscErrorCode ierr = DMLocalToLocalBegin(*da, work, INSERT_VALUES, work);
+    PISM_CHK(ierr, "DMLocalToLocalBegin");
+
+    ierr = DMLocalToLocalEnd(*da, work, INSERT_VALUES, work);
+    PISM_CHK(ierr, "DMLocalToLocalEnd");
+  }
+
+  for (int j = ys - w; j < ys + ym + w; ++j) {
+    for (int i = xs - w; i < xs + xm + w; ++i) {
+      for (int k = 0; k < n; ++k) {
+        data[j][i][k] = buffer[j][i][k];
+      }
+    }
+  }
+
+  log_halo_exchange(width);
+}
+
+//! Select the reduced-precision halo exchange mode for this field.
+/*!
+  When enabled, update_ghosts() (both versions) rounds exchanged values to float32 and
+  packs pairs of them into each double sent, halving the amount of data moved by this
+  field's halo exchanges; see update_ghosts_packed_float(). Opt in per field, and only
+  for fields whose use of ghost values tolerates a relative error of about `1e-7` (wide
+  halos of 3D fields are the intended use case: their exchanges dominate communication
+  volume at scale).
+
+  Split-phase updates (update_ghosts_begin() and update_ghosts_end()) are not affected
+  and keep full precision.
+*/
+void Array::set_reduced_precision_halo(bool flag) {
+  m_impl->reduced_precision_halo = flag;
+}
+
+//! Exchange ghosts in reduced (float32) precision; see set_reduced_precision_halo().
+/*!
+  Works like update_ghosts(width), but rounds values to float32 and packs pairs of them
+  into each exchanged double, i.e. moves half as much data. The exchange itself still
+  goes through the regular PETSc DMDA scatter, just on a DM with half the degrees of
+  freedom, so no new communication code is involved.
+
+  Owned values are never modified. Values in the ghost region (including ghosts at the
+  edge of the computational domain, which update_ghosts() leaves untouched) are rounded
+  to float32 precision.
+*/
+void Array::update_ghosts_packed_float(unsigned int width) {
+  if ((not m_impl->ghosted) or width == 0) {
+    return;
+  }
+
+  auto grid = m_impl->grid;
+
+  // use the DM dof (for 3D arrays ndof() == 1 and the dof of the underlying DM is the
+  // number of vertical levels)
+  auto dof = std::max(levels().size(), (size_t)ndof());
+
+  // two float32 values are packed into each exchanged double
+  auto dof_packed = (dof + 1) / 2;
+
+  auto da = grid->get_dm(dof_packed, width);
+
+  petsc::TemporaryLocalVec work(da);
+
+  petsc::DMDAVecArrayDOF work_array(da, work);
+  double ***buffer = static_cast<double ***>(work_array.get());
+
+  petsc::DMDAVecArrayDOF tmp(dm(), vec());
+  double ***data = static_cast<double ***>(tmp.get());
+
+  const int
+    xs = grid->xs(), xm = grid->xm(),
+    ys = grid->ys(), ym = grid->ym(),
+    w  = static_cast<int>(width),
+    n  = static_cast<int>(dof);
+
+  // Pack owned values and the innermost `width` rows of ghosts.
+  for (int j = ys - w; j < ys + ym + w; ++j) {
+    for (int i = xs - w; i < xs + xm + w; ++i) {
+      for (int k = 0; k < n; k += 2) {
+        float pair[2] = { (float)data[j][i][k],
+                          k + 1 < n ? (float)data[j][i][k + 1] : 0.0f };
+        memcpy(&buffer[j][i][k / 2], pair, sizeof(pair));
+      }
+    }
+  }
+
+  {
+    PetscErrorCode ierr = DMLocalToLocalBegin(*da, work, INSERT_VALUES, work);
+    PISM_CHK(ierr, "DMLocalToLocalBegin");
+
+    ierr = DMLocalToLocalEnd(*da, work, INSERT_VALUES, work);
+    PISM_CHK(ierr, "DMLocalToLocalEnd");
+  }
+
+  // Unpack into the ghost region only, so that owned values keep full precision.
+  for (int j = ys - w; j < ys + ym + w; ++j) {
+    for (int i = xs - w; i < xs + xm + w; ++i) {
+      if (i >= xs and i < xs + xm and j >= ys and j < ys + ym) {
+        continue;
+      }
+
+      for (int k = 0; k < n; k += 2) {
+        float pair[2];
+        memcpy(pair, &buffer[j][i][k / 2], sizeof(pair));
+
+        data[j][i][k] = pair[0];
+        if (k + 1 < n) {
+          data[j][i][k + 1] = pair[1];
+        }
+      }
+    }
+  }
+
+  log_halo_exchange(width);
+}
+
+//! Reports the per-rank size of a halo exchange (instrumentation; verbosity 5).
+void Array::log_halo_exchange(unsigned int width) const {
+  auto log = m_impl->grid->ctx()->log();
+
+  const int
+    xm = m_impl->grid->xm(),
+    ym = m_impl->grid->ym(),
+    w  = static_cast<int>(width);
+
+  size_t dof   = std::max(levels().size(), (size_t)ndof());
+  size_t bytes = ((xm + 2 * w) * (ym + 2 * w) - xm * ym) * dof * sizeof(double);
+
+  log->message(5, "  halo exchange: %s (width %d, %lu bytes per rank)\n",
+               get_name().c_str(), w, (unsigned long)bytes);
+}
+
+//! Starts a ghost point update (split-phase version of update_ghosts()).
+/*!
+  Posts the halo exchange and returns without waiting for it to complete,
+  making it possible to overlap communication with computations that do not
+  use this array's ghosts. Between update_ghosts_begin() and
+  update_ghosts_end() owned values of this array may be read but not modified
+  and ghost values are undefined.
+ */
+void Array::update_ghosts_begin() {
   PetscErrorCode ierr;
   if (not m_impl->ghosted) {
     return;
@@ -651,10 +965,127 @@ void  Array::update_ghosts() {
   ierr = DMLocalToLocalBegin(*dm(), vec(), INSERT_VALUES, vec());
   PISM_CHK(ierr, "DMLocalToLocalBegin");
 
+  log_halo_exchange(m_impl->da_stencil_width);
+}
+
+//! Completes a ghost point update started by update_ghosts_begin().
+void Array::update_ghosts_end() {
+  PetscErrorCode ierr;
+  if (not m_impl->ghosted) {
+    return;
+  }
+
   ierr = DMLocalToLocalEnd(*dm(), vec(), INSERT_VALUES, vec());
   PISM_CHK(ierr, "DMLocalToLocalEnd");
 }
 
+//! Updates ghost points of several arrays using one aggregated halo exchange.
+/*!
+  Equivalent to calling update_ghosts() for each array in `arrays`, but packs all the
+  fields into a vector managed by a DM with `dof` equal to the total number of degrees of
+  freedom and performs *one* exchange, so each pair of neighboring ranks exchanges one
+  message instead of one message per field. Use this in code that updates ghosts of
+  several fields back to back: with many small sub-domains the cost of a halo exchange is
+  dominated by per-message latency, not by the amount of data moved.
+
+  All the arrays have to be allocated on the same grid. Arrays without ghosts are skipped.
+*/
+void update_ghosts(const std::vector<Array *> &arrays) {
+
+  // Skip arrays that have no ghosts to update.
+  std::vector<Array *> ghosted;
+  for (auto *array : arrays) {
+    if (array->stencil_width() > 0) {
+      ghosted.push_back(array);
+    }
+  }
+
+  if (ghosted.empty()) {
+    return;
+  }
+
+  if (ghosted.size() == 1) {
+    // nothing to aggregate
+    ghosted[0]->update_ghosts();
+    return;
+  }
+
+  auto grid = ghosted[0]->grid();
+
+  unsigned int dof_total = 0;
+  unsigned int stencil   = 0;
+  for (auto *array : ghosted) {
+    if (array->grid() != grid) {
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                    "cannot update ghosts of '%s':"
+                                    " it is allocated on a different grid",
+                                    array->get_name().c_str());
+    }
+    dof_total += array->ndof();
+    stencil = std::max(stencil, array->stencil_width());
+  }
+
+  auto da = grid->get_dm(dof_total, stencil);
+
+  petsc::TemporaryLocalVec work(da);
+
+  petsc::DMDAVecArrayDOF work_array(da, work);
+  double ***buffer = static_cast<double ***>(work_array.get());
+
+  const int
+    xs = grid->xs(), xm = grid->xm(),
+    ys = grid->ys(), ym = grid->ym();
+
+  // Pack each field (owned values *and* current ghosts) into its range of degrees of
+  // freedom. Ghost values at the edge of the computational domain are not exchanged:
+  // copying them here and back below leaves them unchanged, just like update_ghosts().
+  unsigned int offset = 0;
+  for (auto *array : ghosted) {
+    petsc::DMDAVecArrayDOF tmp(array->dm(), array->vec());
+    double ***source = static_cast<double ***>(tmp.get());
+
+    const int s   = static_cast<int>(array->stencil_width()),
+              dof = static_cast<int>(array->ndof());
+
+    for (int j = ys - s; j < ys + ym + s; ++j) {
+      for (int i = xs - s; i < xs + xm + s; ++i) {
+        for (int k = 0; k < dof; ++k) {
+          buffer[j][i][offset + k] = source[j][i][k];
+        }
+      }
+    }
+    offset += dof;
+  }
+
+  // one halo exchange for all the fields
+  {
+    PetscErrorCode ierr = DMLocalToLocalBegin(*da, work, INSERT_VALUES, work);
+    PISM_CHK(ierr, "DMLocalToLocalBegin");
+
+    ierr = DMLocalToLocalEnd(*da, work, INSERT_VALUES, work);
+    PISM_CHK(ierr, "DMLocalToLocalEnd");
+  }
+
+  // unpack
+  offset = 0;
+  for (auto *array : ghosted) {
+    petsc::DMDAVecArrayDOF tmp(array->dm(), array->vec());
+    double ***destination = static_cast<double ***>(tmp.get());
+
+    const int s   = static_cast<int>(array->stencil_width()),
+              dof = static_cast<int>(array->ndof());
+
+    for (int j = ys - s; j < ys + ym + s; ++j) {
+      for (int i = xs - s; i < xs + xm + s; ++i) {
+        for (int k = 0; k < dof; ++k) {
+          destination[j][i][k] = buffer[j][i][offset + k];
+        }
+      }
+    }
+    offset += dof;
+  }
+}
+
 //! Result: v[j] <- c for all j.
 void  Array::set(const double c) {
   PetscErrorCode ierr = VecSet(vec(),c);
@@ -751,13 +1182,13 @@ std::vector<double> Array::norm(int n) const {
 }
 
 void Array::read(const std::string &filename, unsigned int time) {
-  File file(m_impl->grid->com, filename, io::PISM_GUESS, io::PISM_READONLY);
-  this->read(file, time);
+  auto file = m_impl->grid->ctx()->input_file_cache()->get(filename);
+  this->read(*file, time);
 }
 
 void Array::regrid(const std::string &filename, io::Default default_value) {
-  File file(m_impl->grid->com, filename, io::PISM_GUESS, io::PISM_READONLY);
-  this->regrid(file, default_value);
+  auto file = m_impl->grid->ctx()->input_file_cache()->get(filename);
+  this->regrid(*file, default_value);
 }
 
 static void check_range(petsc::Vec &v,
@@ -858,6 +1289,19 @@ void Array::read(const File &file, const unsigned int time) {
 
 void Array::write(const OutputFile &file) const {
 
+  // Incremental mode (see OutputFile::set_state_counters()): skip this array if it was
+  // not modified since it was last written to this file.
+  const auto &counters = file.state_counters();
+  if (counters != nullptr) {
+    auto it = counters->find(m_impl->name);
+    if (it != counters->end() and it->second == m_impl->state_counter) {
+      m_impl->grid->ctx()->log()->message(4, "  skipping %s (unchanged since the last write)\n",
+                                          m_impl->name.c_str());
+      return;
+    }
+    (*counters)[m_impl->name] = m_impl->state_counter;
+  }
+
   MPI_Comm com = m_impl->grid->com;
   double start_time = get_time(com);
   write_impl(file);
@@ -242,6 +242,10 @@ public:
   virtual void begin_access() const;
   virtual void end_access() const;
   void update_ghosts();
+  void update_ghosts(unsigned int width);
+  void update_ghosts_begin();
+  void update_ghosts_end();
+  void set_reduced_precision_halo(bool flag);
 
   std::shared_ptr<petsc::Vec> allocate_proc0_copy() const;
   void put_on_proc0(petsc::Vec &onp0) const;
@@ -277,6 +281,8 @@ protected:
 
   void set_begin_access_use_dof(bool flag);
 
+  void flush_access_cache() const;
+
   void read_impl(const File &file, unsigned int time);
   virtual void regrid_impl(const File &file, io::Default default_value);
   void write_impl(const OutputFile &file) const;
@@ -286,6 +292,10 @@ protected:
   //! @brief Check array indices and warn if they are out of range.
   void check_array_indices(int i, int j, unsigned int k) const;
 
+  void log_halo_exchange(unsigned int width) const;
+
+  void update_ghosts_packed_float(unsigned int width);
+
   void copy_to_vec(std::shared_ptr<petsc::DM> destination_da, petsc::Vec &destination) const;
   void get_dof(std::shared_ptr<petsc::DM> da_result, petsc::Vec &result, unsigned int start,
                unsigned int count=1) const;
@@ -325,6 +335,8 @@ static typename std::shared_ptr<T> cast(std::shared_ptr<Array> input) {
 
 std::set<VariableMetadata> metadata(std::initializer_list<const Array *> vecs);
 
+void update_ghosts(const std::vector<Array *> &arrays);
+
 } // end of namespace array
 
 /**
@@ -138,6 +138,34 @@ const double *Array3D::get_column(int i, int j) const {
   return ((double ***)m_array)[j][i];
 }
 
+Array3D::Block Array3D::block() {
+  const int w = m_impl->ghosted ? (int)stencil_width() : 0;
+
+  Block result;
+  result.i_first = grid()->xs() - w;
+  result.j_first = grid()->ys() - w;
+  result.nx      = grid()->xm() + 2 * w;
+  result.ny      = grid()->ym() + 2 * w;
+  result.Mz      = (unsigned int)levels().size();
+  result.data    = get_column(result.i_first, result.j_first);
+
+  return result;
+}
+
+Array3D::ConstBlock Array3D::block() const {
+  const int w = m_impl->ghosted ? (int)stencil_width() : 0;
+
+  ConstBlock result;
+  result.i_first = grid()->xs() - w;
+  result.j_first = grid()->ys() - w;
+  result.nx      = grid()->xm() + 2 * w;
+  result.ny      = grid()->ym() + 2 * w;
+  result.Mz      = (unsigned int)levels().size();
+  result.data    = get_column(result.i_first, result.j_first);
+
+  return result;
+}
+
 //! Copies a horizontal slice at level z of an Array3D into `output`.
 void extract_surface(const Array3D &data, double z, Scalar &output) {
   array::AccessScope list{ &data, &output };
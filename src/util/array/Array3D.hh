@@ -20,6 +20,8 @@
 #ifndef PISM_ARRAY3D_H
 #define PISM_ARRAY3D_H
 
+#include <cstddef>              // size_t
+
 #include "pism/util/array/Array.hh"
 
 namespace pism {
@@ -51,6 +53,58 @@ public:
   double* get_column(int i, int j);
   const double* get_column(int i, int j) const;
 
+  /*!
+   * Raw layout of the storage accessed by get_column() and set_column().
+   *
+   * Column values (the `k` index) are contiguous; columns at consecutive `i` are
+   * adjacent; rows of columns at consecutive `j` are `nx * Mz` doubles apart. In other
+   * words, `data` points to the start of a dense `[j][i][k]` array covering the local
+   * sub-domain, including the ghost margin if the array is ghosted.
+   *
+   * This is the layout set up by PETSc's DMDA with "dof" equal to the number of vertical
+   * levels; column-batched and SIMD kernels can rely on it. Pointers are valid only while
+   * the array is accessed (see AccessScope).
+   */
+  struct Block {
+    double *data;               //!< the column at (i_first, j_first)
+    int i_first;                //!< i-index of the first column
+    int j_first;                //!< j-index of the first column
+    int nx;                     //!< number of columns in the i-direction
+    int ny;                     //!< number of columns in the j-direction
+    unsigned int Mz;            //!< column length (number of vertical levels)
+
+    //! The column at (i, j); same as get_column(i, j).
+    double* column(int i, int j) const {
+      return data + ((size_t)(j - j_first) * (size_t)nx + (size_t)(i - i_first)) * Mz;
+    }
+
+    //! The row of `nx` contiguous columns at (i_first, j); `nx * Mz` doubles.
+    double* row(int j) const {
+      return data + (size_t)(j - j_first) * (size_t)nx * Mz;
+    }
+  };
+
+  //! Read-only version of Block (see above for the layout contract).
+  struct ConstBlock {
+    const double *data;
+    int i_first;
+    int j_first;
+    int nx;
+    int ny;
+    unsigned int Mz;
+
+    const double* column(int i, int j) const {
+      return data + ((size_t)(j - j_first) * (size_t)nx + (size_t)(i - i_first)) * Mz;
+    }
+
+    const double* row(int j) const {
+      return data + (size_t)(j - j_first) * (size_t)nx * Mz;
+    }
+  };
+
+  Block block();
+  ConstBlock block() const;
+
   double interpolate(int i, int j, double z) const;
 
   void copy_from(const Array3D &input);
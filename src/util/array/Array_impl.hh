@@ -38,6 +38,7 @@ namespace array {
 struct Array::Impl {
   Impl() {
     access_counter = 0;
+    access_cached  = false;
 
     da.reset();
 
@@ -47,6 +48,8 @@ struct Array::Impl {
 
     ghosted = true;
 
+    reduced_precision_halo = false;
+
     report_range = true;
 
     name = "uninitialized variable";
@@ -85,6 +88,11 @@ struct Array::Impl {
   //! true if this Array is ghosted
   bool ghosted;
 
+  //! If true, update_ghosts() rounds exchanged values to float32 and packs pairs of
+  //! them into each double sent, halving halo traffic; see
+  //! Array::set_reduced_precision_halo().
+  bool reduced_precision_halo;
+
   //! distributed mesh manager (DM)
   //!
   //! Note: do not access this directly (via `m_impl->da`). Use `dm()` instead.
@@ -100,6 +108,13 @@ struct Array::Impl {
   // used in begin_access() and end_access()
   int access_counter;
 
+  //! If true, `m_array` holds a valid pointer left over from a previous
+  //! begin_access()..end_access() pair: the DMDAVecRestoreArray() call was deferred so
+  //! that the next begin_access() can re-use the pointer instead of crossing into PETSc
+  //! again. Invalidated (and the deferred restore performed) by vec(); see
+  //! Array::flush_access_cache().
+  bool access_cached;
+
   //! Internal array::Array "revision number"
   int state_counter;
 
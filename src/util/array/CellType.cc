@@ -18,6 +18,7 @@
  */
 
 #include "pism/util/array/CellType.hh"
+#include "pism/util/Grid.hh"
 #include "pism/util/Interpolation1D.hh"
 
 namespace pism {
@@ -48,5 +49,62 @@ CellType2::CellType2(std::shared_ptr<const Grid> grid, const std::string &name)
   // empty
 }
 
+CellTypeBits::CellTypeBits()
+  : m_i0(0), m_j0(0), m_stride(0) {
+  // empty
+}
+
+//! Re-build the packed snapshot from `mask` (owned cells and ghosts).
+void CellTypeBits::reset(const CellType &mask) {
+  auto grid = mask.grid();
+
+  const int w = (int)mask.stencil_width();
+
+  m_i0     = grid->xs() - w;
+  m_j0     = grid->ys() - w;
+  m_stride = grid->xm() + 2 * w;
+
+  size_t size = (size_t)m_stride * (size_t)(grid->ym() + 2 * w);
+  m_bits.resize(size);
+  m_star.assign(size, 0);
+
+  // predicate bits for each valid mask value, indexed by `value + 1` (to make room for
+  // MASK_UNKNOWN == -1)
+  uint8_t table[MASK_ICE_FREE_OCEAN + 2];
+  for (int M = MASK_UNKNOWN; M <= MASK_ICE_FREE_OCEAN; ++M) {
+    uint8_t b = 0;
+
+    b |= mask::icy(M)            ? ICY : 0;
+    b |= mask::grounded(M)       ? GROUNDED : 0;
+    b |= mask::ocean(M)          ? OCEAN : 0;
+    b |= mask::ice_free(M)       ? ICE_FREE : 0;
+    b |= mask::grounded_ice(M)   ? GROUNDED_ICE : 0;
+    b |= mask::floating_ice(M)   ? FLOATING_ICE : 0;
+    b |= mask::ice_free_land(M)  ? ICE_FREE_LAND : 0;
+    b |= mask::ice_free_ocean(M) ? ICE_FREE_OCEAN : 0;
+
+    table[M + 1] = b;
+  }
+
+  AccessScope scope{&mask};
+
+  for (auto p : grid->points_with_ghosts(w)) {
+    const int i = p.i(), j = p.j();
+
+    m_bits[index(i, j)] = table[mask.as_int(i, j) + 1];
+  }
+
+  // four-neighbor summaries are available one cell closer to the subdomain interior than
+  // point-wise bits
+  if (w > 0) {
+    for (auto p : grid->points_with_ghosts(w - 1)) {
+      const int i = p.i(), j = p.j();
+
+      m_star[index(i, j)] = (m_bits[index(i + 1, j)] | m_bits[index(i - 1, j)] |
+                             m_bits[index(i, j + 1)] | m_bits[index(i, j - 1)]);
+    }
+  }
+}
+
 } // end of namespace array
 } // end of namespace pism
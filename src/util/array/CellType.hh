@@ -20,6 +20,9 @@
 #ifndef PISM_ARRAY_CELLTYPE_H
 #define PISM_ARRAY_CELLTYPE_H
 
+#include <cstdint>              // uint8_t
+#include <vector>
+
 #include "pism/util/array/Scalar.hh"
 #include "pism/util/Mask.hh"
 
@@ -119,6 +122,121 @@ public:
   CellType2(std::shared_ptr<const Grid> grid, const std::string &name);
 };
 
+//! Packed read-only snapshot of a cell type mask.
+/*!
+ * Mask queries above read `double` values from PETSc storage and re-derive cell
+ * categories using floating point comparisons; neighborhood queries (next_to_ice(),
+ * etc) repeat this for each of the four neighbors. In loops dominated by mask queries
+ * this is a lot of memory traffic for one bit of information.
+ *
+ * This class mirrors a mask using one byte per cell, with every predicate pre-computed
+ * as a bit (using a small table indexed by the mask value), plus a second byte per cell
+ * containing the bit-wise "or" over the four neighbors. Each query then costs one byte
+ * load and a bit test, and the compact storage is cache-friendly.
+ *
+ * The snapshot covers owned cells and ghosts of the mask it was created from;
+ * neighborhood queries are supported up to `stencil_width - 1` cells away from the owned
+ * subdomain. It is *not* updated when the mask changes: call reset() after each mask
+ * update.
+ */
+class CellTypeBits {
+public:
+  CellTypeBits();
+
+  void reset(const CellType &mask);
+
+  inline bool ocean(int i, int j) const {
+    return (bits(i, j) & OCEAN) != 0;
+  }
+
+  inline bool grounded(int i, int j) const {
+    return (bits(i, j) & GROUNDED) != 0;
+  }
+
+  inline bool icy(int i, int j) const {
+    return (bits(i, j) & ICY) != 0;
+  }
+
+  inline bool grounded_ice(int i, int j) const {
+    return (bits(i, j) & GROUNDED_ICE) != 0;
+  }
+
+  inline bool floating_ice(int i, int j) const {
+    return (bits(i, j) & FLOATING_ICE) != 0;
+  }
+
+  inline bool ice_free(int i, int j) const {
+    return (bits(i, j) & ICE_FREE) != 0;
+  }
+
+  inline bool ice_free_ocean(int i, int j) const {
+    return (bits(i, j) & ICE_FREE_OCEAN) != 0;
+  }
+
+  inline bool ice_free_land(int i, int j) const {
+    return (bits(i, j) & ICE_FREE_LAND) != 0;
+  }
+
+  //! \brief Ice margin (ice-filled with at least one of four neighbors ice-free).
+  inline bool ice_margin(int i, int j) const {
+    return (bits(i, j) & ICY) != 0 and (star(i, j) & ICE_FREE) != 0;
+  }
+
+  //! \brief Ice-free margin (at least one of four neighbors has ice).
+  inline bool next_to_ice(int i, int j) const {
+    return (star(i, j) & ICY) != 0;
+  }
+
+  inline bool next_to_floating_ice(int i, int j) const {
+    return (star(i, j) & FLOATING_ICE) != 0;
+  }
+
+  inline bool next_to_grounded_ice(int i, int j) const {
+    return (star(i, j) & GROUNDED_ICE) != 0;
+  }
+
+  inline bool next_to_ice_free_land(int i, int j) const {
+    return (star(i, j) & ICE_FREE_LAND) != 0;
+  }
+
+  inline bool next_to_ice_free_ocean(int i, int j) const {
+    return (star(i, j) & ICE_FREE_OCEAN) != 0;
+  }
+
+private:
+  enum Bit {
+    ICY            = 1,
+    GROUNDED       = 2,
+    OCEAN          = 4,
+    ICE_FREE       = 8,
+    GROUNDED_ICE   = 16,
+    FLOATING_ICE   = 32,
+    ICE_FREE_LAND  = 64,
+    ICE_FREE_OCEAN = 128
+  };
+
+  inline size_t index(int i, int j) const {
+    return (size_t)(j - m_j0) * (size_t)m_stride + (size_t)(i - m_i0);
+  }
+
+  inline uint8_t bits(int i, int j) const {
+    return m_bits[index(i, j)];
+  }
+
+  inline uint8_t star(int i, int j) const {
+    return m_star[index(i, j)];
+  }
+
+  //! global indexes of the "lower left" corner of the mirrored block (including ghosts)
+  int m_i0, m_j0;
+  //! number of cells in a row of the mirrored block
+  int m_stride;
+  //! per-cell predicate bits
+  std::vector<uint8_t> m_bits;
+  //! bit-wise "or" of `m_bits` over the four neighbors of a cell
+  std::vector<uint8_t> m_star;
+};
+
 } // end of namespace array
 } // end of namespace pism
 
@@ -0,0 +1,114 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <cassert>
+
+#include "pism/util/array/Float3D.hh"
+
+#include "pism/util/Grid.hh"
+#include "pism/util/error_handling.hh"
+
+namespace pism {
+namespace array {
+
+Float3D::Float3D(std::shared_ptr<const Grid> grid, const std::string &name,
+                 unsigned int n_levels, unsigned int stencil_width)
+    : m_grid(grid), m_name(name), m_n_levels(n_levels), m_stencil_width(stencil_width) {
+
+  if (n_levels < 1) {
+    throw RuntimeError::formatted(
+        PISM_ERROR_LOCATION,
+        "pism::array::Float3D '%s' has to have at least one \"vertical\" level", name.c_str());
+  }
+
+  const int W = static_cast<int>(stencil_width);
+
+  m_i_first    = grid->xs() - W;
+  m_j_first    = grid->ys() - W;
+  m_row_length = grid->xm() + 2 * W;
+
+  const int n_rows = grid->ym() + 2 * W;
+
+  m_data.resize((size_t)m_row_length * (size_t)n_rows * (size_t)n_levels, 0.0f);
+}
+
+float *Float3D::column(int i, int j) {
+#if (Pism_DEBUG == 1)
+  assert(i >= m_i_first and i < m_i_first + m_row_length);
+  assert(j >= m_j_first);
+#endif
+  return &m_data[((size_t)(j - m_j_first) * (size_t)m_row_length +
+                  (size_t)(i - m_i_first)) * (size_t)m_n_levels];
+}
+
+const float *Float3D::column(int i, int j) const {
+#if (Pism_DEBUG == 1)
+  assert(i >= m_i_first and i < m_i_first + m_row_length);
+  assert(j >= m_j_first);
+#endif
+  return &m_data[((size_t)(j - m_j_first) * (size_t)m_row_length +
+                  (size_t)(i - m_i_first)) * (size_t)m_n_levels];
+}
+
+void Float3D::set(double c) {
+  const float value = static_cast<float>(c);
+  for (auto &v : m_data) {
+    v = value;
+  }
+}
+
+void Float3D::set_column(int i, int j, double c) {
+  float *data = column(i, j);
+
+  const float value = static_cast<float>(c);
+  for (unsigned int k = 0; k < m_n_levels; ++k) {
+    data[k] = value;
+  }
+}
+
+void Float3D::set_column(int i, int j, const double *input) {
+  float *data = column(i, j);
+
+  for (unsigned int k = 0; k < m_n_levels; ++k) {
+    data[k] = static_cast<float>(input[k]);
+  }
+}
+
+void Float3D::get_column(int i, int j, double *output) const {
+  const float *data = column(i, j);
+
+  for (unsigned int k = 0; k < m_n_levels; ++k) {
+    output[k] = static_cast<double>(data[k]);
+  }
+}
+
+unsigned int Float3D::n_levels() const {
+  return m_n_levels;
+}
+
+unsigned int Float3D::stencil_width() const {
+  return m_stencil_width;
+}
+
+const std::string &Float3D::get_name() const {
+  return m_name;
+}
+
+} // end of namespace array
+} // end of namespace pism
@@ -0,0 +1,99 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef PISM_FLOAT3D_H
+#define PISM_FLOAT3D_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pism {
+
+class Grid;
+
+namespace array {
+
+//! \brief A 3D array storing values in single precision.
+/*!
+  Unlike Array3D, which is backed by a PETSc Vec and so stores doubles, this class owns
+  a plain float buffer covering the local sub-domain (plus an optional "ghost" ring).
+  This halves the memory footprint, which matters for 3D work arrays in runs with many
+  vertical levels. Values are converted to and from double at the access boundary:
+  callers read and write whole columns of doubles.
+
+  Restrictions compared to Array3D (by design, to stay off the PETSc Vec machinery):
+
+  - no communication: the ghost ring, if any, has to be filled by computing values there
+    redundantly (the way SIAFD fills its staggered-grid columns);
+  - no I/O and no metadata: this is storage for intermediate quantities only;
+  - does not participate in array::AccessScope.
+
+  Use it for fields that do not need 53 bits of precision: quantities that are
+  integrated or averaged before use, or are purely diagnostic. Do not use it for model
+  state.
+*/
+class Float3D {
+public:
+  Float3D(std::shared_ptr<const Grid> grid, const std::string &name,
+          unsigned int n_levels, unsigned int stencil_width = 0);
+
+  //! Fill the whole array (including the ghost ring) with a constant.
+  void set(double c);
+
+  //! Fill the column at (i, j) with a constant.
+  void set_column(int i, int j, double c);
+
+  //! Copy `input` (n_levels doubles) into the column at (i, j).
+  void set_column(int i, int j, const double *input);
+
+  //! Copy the column at (i, j) into `output` (n_levels doubles).
+  void get_column(int i, int j, double *output) const;
+
+  unsigned int n_levels() const;
+  unsigned int stencil_width() const;
+
+  const std::string &get_name() const;
+
+private:
+  float *column(int i, int j);
+  const float *column(int i, int j) const;
+
+  std::shared_ptr<const Grid> m_grid;
+  std::string m_name;
+
+  unsigned int m_n_levels;
+  unsigned int m_stencil_width;
+
+  //! index of the first column in the buffer (i direction; includes the ghost ring)
+  int m_i_first;
+  //! index of the first column in the buffer (j direction; includes the ghost ring)
+  int m_j_first;
+  //! number of columns in one row of the buffer
+  int m_row_length;
+
+  //! column-contiguous storage: the column at (i, j) starts at
+  //! ((j - m_j_first) * m_row_length + (i - m_i_first)) * m_n_levels
+  std::vector<float> m_data;
+};
+
+} // end of namespace array
+} // end of namespace pism
+
+#endif /* PISM_FLOAT3D_H */
@@ -19,7 +19,17 @@
 #include <petsc.h>
 #include <cassert>
 #include <cmath>                // std::floor
+#include <algorithm>            // std::max
 #include <array>
+#include <limits>               // std::numeric_limits
+#include <condition_variable>
+#include <cstdio>               // fprintf
+#include <deque>
+#include <exception>            // std::exception_ptr
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>              // std::move
 
 #include "pism/util/array/Forcing.hh"
 #include "pism/util/io/File.hh"
@@ -29,6 +39,7 @@
 
 #include "pism/util/error_handling.hh"
 #include "pism/util/io/io_helpers.hh"
+#include "pism/util/pism_utilities.hh" // GlobalMax
 #include "pism/util/Logger.hh"
 #include "pism/util/Interpolation1D.hh"
 #include "pism/util/Context.hh"
@@ -47,7 +58,9 @@ struct Forcing::Data {
       first(-1),
       n_records(0),
       period(0.0),
-      period_start(0.0) {
+      period_start(0.0),
+      prefetch_com(MPI_COMM_NULL),
+      prefetch_done(false) {
     // empty
   }
   //! all the times available in filename
@@ -59,6 +72,10 @@ struct Forcing::Data {
   //! name of the file to read (regrid) from
   std::string filename;
 
+  //! the file to read from, kept open for the duration of the run to avoid re-opening it
+  //! and re-parsing its header every time the buffer is refilled
+  std::shared_ptr<File> file;
+
   //! DM with dof equal to buffer_size
   std::shared_ptr<petsc::DM> da;
 
@@ -90,8 +107,50 @@ struct Forcing::Data {
   //! start of the period, in seconds
   double period_start;
 
+  //! integration weights for one complete period (periodic case only; they depend on the
+  //! forcing data but not on the averaging interval, so they are computed once and
+  //! re-used; see Forcing::average())
+  std::map<size_t, double> period_weights;
+
   //! minimum time step length in max_timestep(), in seconds
   double dt_min;
+
+  //! global maxima of absolute values of the records read so far, keyed by in-file
+  //! record indices; see max_change()
+  std::map<int, double> record_norms;
+
+  // Members used for asynchronous prefetching of records (see input.forcing.prefetch).
+
+  //! spatial interpolation used by the prefetch thread
+  std::shared_ptr<InputInterpolation> spatial_interp;
+
+  //! communicator the file is opened on when prefetching is enabled (a duplicate of the
+  //! grid's communicator; MPI_COMM_NULL otherwise)
+  MPI_Comm prefetch_com;
+
+  //! the thread reading records ahead of time; see Forcing::prefetch_loop()
+  std::thread prefetch_thread;
+
+  //! protects the members below
+  std::mutex mutex;
+
+  //! signaled when requests are added to `requested` or `prefetch_done` is set
+  std::condition_variable work_available;
+
+  //! signaled when a record is added to `ready` or `failure` is set
+  std::condition_variable record_ready;
+
+  //! in-file indices of the records the prefetch thread should load, in FIFO order
+  std::deque<int> requested;
+
+  //! loaded records (subdomain-sized arrays) keyed by their in-file indices
+  std::map<int, std::vector<double> > ready;
+
+  //! tells the prefetch thread to stop
+  bool prefetch_done;
+
+  //! the first error reported by the prefetch thread
+  std::exception_ptr failure;
 };
 
 /*!
@@ -203,6 +262,35 @@ void Forcing::allocate(unsigned int buffer_size, InterpolationType interpolation
 }
 
 Forcing::~Forcing() {
+  if (m_data->prefetch_thread.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(m_data->mutex);
+      m_data->prefetch_done = true;
+    }
+    m_data->work_available.notify_all();
+    m_data->prefetch_thread.join();
+
+    if (m_data->failure != nullptr) {
+      // A destructor cannot throw: report the error and move on.
+      try {
+        std::rethrow_exception(m_data->failure);
+      } catch (std::exception &e) {
+        fprintf(stderr, "PISM ERROR: prefetching records of '%s' failed: %s\n",
+                m_impl->name.c_str(), e.what());
+      } catch (...) {
+        fprintf(stderr, "PISM ERROR: prefetching records of '%s' failed\n",
+                m_impl->name.c_str());
+      }
+    }
+  }
+
+  // close the file before freeing the communicator it may have been opened on
+  m_data->file.reset();
+
+  if (m_data->prefetch_com != MPI_COMM_NULL) {
+    MPI_Comm_free(&m_data->prefetch_com);
+  }
+
   delete m_data;
 }
 
@@ -242,7 +330,18 @@ void Forcing::init(const std::string &filename, bool periodic) {
 
     m_data->filename = filename;
 
-    File file(m_impl->grid->com, m_data->filename, io::PISM_GUESS, io::PISM_READONLY);
+    MPI_Comm com = m_impl->grid->com;
+    if (ctx->config()->get_flag("input.forcing.prefetch")) {
+      // The prefetch thread makes collective MPI calls. Opening the file on a duplicate
+      // of the grid's communicator ensures that these calls cannot interfere with MPI
+      // calls made by the main thread.
+      MPI_Comm_dup(com, &m_data->prefetch_com);
+      com = m_data->prefetch_com;
+    }
+
+    m_data->file.reset(new File(com, m_data->filename,
+                                io::PISM_GUESS, io::PISM_READONLY));
+    File &file = *m_data->file;
     auto var = file.find_variable(m_impl->metadata[0].get_name(),
                                   m_impl->metadata[0]["standard_name"]);
     if (not var.exists) {
@@ -299,6 +398,9 @@ void Forcing::init(const std::string &filename, bool periodic) {
     if (periodic) {
       // read periodic data right away (we need to hold it all in memory anyway)
       init_periodic_data(file);
+    } else if (m_data->time.size() > 1 and
+               ctx->config()->get_flag("input.forcing.prefetch")) {
+      init_prefetch(file, var.name);
     }
   } catch (RuntimeError &e) {
     e.add_context("reading '%s' (%s) from '%s'",
@@ -420,6 +522,218 @@ void Forcing::init_periodic_data(const File &file) {
   }
 }
 
+/*!
+ * Start the thread used to read records of this forcing field ahead of time (see
+ * input.forcing.prefetch).
+ *
+ * The spatial interpolation is set up here, on the main thread: once the prefetch thread
+ * is running, `file` is used by that thread only.
+ */
+void Forcing::init_prefetch(const File &file, const std::string &variable_name) {
+  auto ctx = m_impl->grid->ctx();
+
+  int provided = MPI_THREAD_SINGLE;
+  MPI_Query_thread(&provided);
+  if (provided < MPI_THREAD_MULTIPLE) {
+    throw RuntimeError::formatted(
+        PISM_ERROR_LOCATION,
+        "cannot prefetch forcing records: this MPI implementation provides thread support"
+        " level %d,\nbut MPI_THREAD_MULTIPLE (%d) is required. Use an MPI implementation"
+        " supporting\nMPI_THREAD_MULTIPLE or set input.forcing.prefetch to 'false'",
+        provided, MPI_THREAD_MULTIPLE);
+  }
+
+  m_data->spatial_interp =
+      grid()->get_interpolation({ 0.0 }, file, variable_name, m_impl->interpolation_type);
+
+  if (not m_data->spatial_interp->buffered_regrid_supported()) {
+    ctx->log()->message(2,
+                        "PISM WARNING: cannot prefetch records of '%s':"
+                        " not supported by this interpolation type\n",
+                        m_impl->name.c_str());
+    m_data->spatial_interp.reset();
+    return;
+  }
+
+  m_data->prefetch_done   = false;
+  m_data->prefetch_thread = std::thread(&Forcing::prefetch_loop, this);
+}
+
+//! The body of the prefetch thread: loads requested records in FIFO order.
+/*!
+ * Reads are collective on the communicator the file was opened on (a duplicate of the
+ * grid's communicator; see init()), so this thread can run concurrently with MPI calls
+ * made by the main thread. All ranks build identical request queues (see
+ * take_prefetched_record() and schedule_prefetch()), and the queue is drained before
+ * stopping, so ranks always agree on the collective reads performed here.
+ */
+void Forcing::prefetch_loop() {
+  const auto &variable = m_impl->metadata[0];
+  size_t record_size = (size_t)grid()->xm() * (size_t)grid()->ym();
+
+  std::unique_lock<std::mutex> lock(m_data->mutex);
+
+  while (true) {
+    m_data->work_available.wait(
+        lock, [this] { return m_data->prefetch_done or not m_data->requested.empty(); });
+
+    if (m_data->requested.empty()) {
+      // m_data->prefetch_done is set and the queue is drained
+      return;
+    }
+
+    int index = m_data->requested.front();
+    m_data->requested.pop_front();
+
+    if (m_data->ready.count(index) > 0) {
+      continue;
+    }
+
+    lock.unlock();
+
+    std::vector<double> record(record_size);
+    std::exception_ptr failure = nullptr;
+    try {
+      m_data->spatial_interp->regrid_buffered(variable, *m_data->file, index, *grid(),
+                                              record.data());
+    } catch (...) {
+      failure = std::current_exception();
+    }
+
+    lock.lock();
+
+    if (failure != nullptr) {
+      if (m_data->failure == nullptr) {
+        m_data->failure = failure;
+      }
+      // I/O errors are reported on all ranks at once (error codes are broadcast by the
+      // I/O backends), so clearing the queue here keeps ranks in sync.
+      m_data->requested.clear();
+    } else {
+      m_data->ready[index] = std::move(record);
+    }
+
+    m_data->record_ready.notify_all();
+  }
+}
+
+//! Wait for a record loaded by the prefetch thread, requesting it first if necessary.
+std::vector<double> Forcing::take_prefetched_record(unsigned int index) {
+  int k = (int)index;
+
+  std::unique_lock<std::mutex> lock(m_data->mutex);
+
+  bool known = m_data->ready.count(k) > 0;
+  for (int r : m_data->requested) {
+    if (r == k) {
+      known = true;
+    }
+  }
+  if (not known) {
+    m_data->requested.push_back(k);
+    m_data->work_available.notify_all();
+  }
+
+  m_data->record_ready.wait(lock, [this, k] {
+    return m_data->failure != nullptr or m_data->ready.count(k) > 0;
+  });
+
+  if (m_data->failure != nullptr) {
+    std::rethrow_exception(m_data->failure);
+  }
+
+  std::vector<double> result = std::move(m_data->ready[k]);
+
+  // Remove this record along with any earlier ones: records are consumed in
+  // increasing-index order, so records "before" this one are stale.
+  m_data->ready.erase(m_data->ready.begin(), m_data->ready.upper_bound(k));
+
+  return result;
+}
+
+//! Ask the prefetch thread to load records `first`, ..., `first + count - 1` (clipped to
+//! the records present in the file).
+/*!
+ * All ranks call this at the same points of the run with the same arguments, so the
+ * threads' request queues (and therefore the collective reads they perform) match across
+ * ranks.
+ */
+void Forcing::schedule_prefetch(unsigned int first, unsigned int count) {
+  auto time_size = m_data->time.size();
+
+  std::lock_guard<std::mutex> lock(m_data->mutex);
+
+  bool added = false;
+  for (unsigned int j = first; j < first + count and j < time_size; ++j) {
+    int k = (int)j;
+
+    bool known = m_data->ready.count(k) > 0;
+    for (int r : m_data->requested) {
+      if (r == k) {
+        known = true;
+      }
+    }
+
+    if (not known) {
+      m_data->requested.push_back(k);
+      added = true;
+    }
+  }
+
+  if (added) {
+    m_data->work_available.notify_all();
+  }
+}
+
+//! Check if the records currently in memory cover the interval (t, t + dt).
+bool Forcing::buffer_covers(double t, double dt) {
+  if (m_data->n_records == 0) {
+    return false;
+  }
+
+  // in-file index of the last record currently in memory
+  unsigned int last = m_data->first + (m_data->n_records - 1);
+
+  double t0{}, t1{};
+  if (m_data->interp_type == LINEAR) {
+    t0 = m_data->time[m_data->first];
+    t1 = m_data->time[last];
+  } else {
+    // piece-wise constant
+    t0 = m_data->time[m_data->first];
+    if (last + 1 < m_data->time.size()) {
+      t1 = m_data->time[last + 1];
+    } else {
+      t1 = m_data->time_range[1];
+    }
+  }
+
+  return t >= t0 and t + dt <= t1;
+}
+
+//! Non-blocking counterpart of update(): ask the prefetch thread to start loading
+//! records covering the interval (t, t + dt).
+/*!
+ * Call this before an expensive computation (e.g. the stress balance solve) so that
+ * reads overlap with it; see Component::prefetch(). The interval is a hint and does not
+ * need to be exact. This method does nothing if prefetching is not enabled for this
+ * field or the required records are in memory already.
+ */
+void Forcing::prefetch(double t, double dt) {
+  if (m_data->filename.empty() or
+      m_data->period > 0.0 or
+      not m_data->prefetch_thread.joinable() or
+      buffer_covers(t, dt)) {
+    return;
+  }
+
+  // Note: ranks agree on buffer contents (refills are collective), so the requests made
+  // here are identical across ranks; see schedule_prefetch().
+  Interpolation1D I(m_data->interp_type, m_data->time, { t, t + dt });
+
+  schedule_prefetch(I.left(0), buffer_size());
+}
+
 //! Read some data to make sure that the interval (t, t + dt) is covered.
 void Forcing::update(double t, double dt) {
 
@@ -433,28 +747,9 @@ void Forcing::update(double t, double dt) {
     return;
   }
 
-  if (m_data->n_records > 0) {
-    // in-file index of the last record currently in memory
-    unsigned int last = m_data->first + (m_data->n_records - 1);
-
-    double t0{}, t1{};
-    if (m_data->interp_type == LINEAR) {
-      t0 = m_data->time[m_data->first];
-      t1 = m_data->time[last];
-    } else {
-      // piece-wise constant
-      t0 = m_data->time[m_data->first];
-      if (last + 1 < m_data->time.size()) {
-        t1 = m_data->time[last + 1];
-      } else {
-        t1 = m_data->time_range[1];
-      }
-    }
-
-    // just return if we have all the data we need:
-    if (t >= t0 and t + dt <= t1) {
-      return;
-    }
+  // just return if we have all the data we need:
+  if (buffer_covers(t, dt)) {
+    return;
   }
 
   Interpolation1D I(m_data->interp_type, m_data->time, { t, t + dt });
@@ -524,7 +819,35 @@ void Forcing::update(unsigned int start) {
                  t->date(m_data->time[start + missing - 1]).c_str());
   }
 
-  File file(m_impl->grid->com, m_data->filename, io::PISM_GUESS, io::PISM_READONLY);
+  if (m_data->prefetch_thread.joinable()) {
+    // Records are loaded by the prefetch thread; the main thread must not touch the file
+    // (see prefetch_loop()).
+    try {
+      for (unsigned int j = 0; j < missing; ++j) {
+        auto record = take_prefetched_record(start + j);
+
+        log->message(5, " %s: reading entry #%02d, year %s...\n", m_impl->name.c_str(),
+                     start + j, t->date(m_data->time[start + j]).c_str());
+
+        set_record(kept + j, record.data());
+
+        m_data->record_norms[(int)(start + j)] = record_norm(kept + j);
+      }
+    } catch (RuntimeError &e) {
+      e.add_context("regridding '%s' from '%s'", this->get_name().c_str(),
+                    m_data->filename.c_str());
+      throw;
+    }
+
+    // Ask for the records following the current buffer contents: the prefetch thread
+    // will load them while the model is running.
+    schedule_prefetch(start + missing, buffer_size());
+
+    return;
+  }
+
+  // the file is opened in init() and kept open between refills
+  File &file = *m_data->file;
 
   auto variable = m_impl->metadata[0];
 
@@ -540,6 +863,8 @@ void Forcing::update(unsigned int start) {
                    t->date(m_data->time[start + j]).c_str());
 
       set_record(kept + j);
+
+      m_data->record_norms[(int)(start + j)] = record_norm(kept + j);
     }
   } catch (RuntimeError &e) {
     e.add_context("regridding '%s' from '%s'", this->get_name().c_str(), m_data->filename.c_str());
@@ -568,6 +893,100 @@ void Forcing::discard(int number) {
   }
 }
 
+//! Global maximum of the absolute value of the record in buffer slot `n`; saved (keyed
+//! by the in-file record index) when records are read. See max_change().
+double Forcing::record_norm(int n) {
+  double result = 0.0;
+
+  {
+    array::AccessScope l{this};
+    double ***a3 = array3();
+
+    for (auto p : m_impl->grid->points()) {
+      const int i = p.i(), j = p.j();
+
+      result = std::max(result, std::fabs(a3[j][i][n]));
+    }
+  }
+
+  return GlobalMax(m_impl->grid->com, result);
+}
+
+//! Upper bound on the point-wise change of the average of this forcing over the interval
+//! `(t1, t1 + dt1)` relative to its average over `(t0, t0 + dt0)`, in the units of the
+//! field.
+/*!
+ * Averages computed by average() are linear combinations of the records read from the
+ * file, so the difference of two averages is bounded by the sum (over records) of the
+ * absolute difference of the averaging weights times the maximum absolute value of the
+ * record. Both factors are scalars (weights depend on the time axis only; record norms
+ * are saved when records are read), so evaluating this bound does not touch the forcing
+ * data and does not require any records to be in memory.
+ *
+ * Use it to skip update() and average() calls when a slowly-varying forcing is
+ * guaranteed to have changed by less than a tolerance; see Delta_SL_2D.
+ *
+ * Returns infinity when a bound cannot be computed cheaply: periodic forcing,
+ * zero-length intervals, intervals reaching outside the time range of the file, or
+ * intervals requiring records that have not been read yet.
+ */
+double Forcing::max_change(double t0, double dt0, double t1, double dt1) const {
+  const auto &time = m_data->time;
+
+  if (time.size() == 1) {
+    // only one record: the forcing does not depend on time
+    return 0.0;
+  }
+
+  if (m_data->period > 0.0 or dt0 <= 0.0 or dt1 <= 0.0 or
+      t0 < m_data->time_range[0] or t0 + dt0 > m_data->time_range[1] or
+      t1 < m_data->time_range[0] or t1 + dt1 > m_data->time_range[1]) {
+    return std::numeric_limits<double>::infinity();
+  }
+
+  auto w0 = integration_weights(time, m_data->interp_type, t0, t0 + dt0);
+  auto w1 = integration_weights(time, m_data->interp_type, t1, t1 + dt1);
+
+  // difference of the weights defining the two averages (average() divides integration
+  // weights by the length of the interval)
+  std::map<size_t, double> difference;
+  for (const auto &w : w1) {
+    difference[w.first] += w.second / dt1;
+  }
+  for (const auto &w : w0) {
+    difference[w.first] -= w.second / dt0;
+  }
+
+  double result = 0.0;
+  for (const auto &d : difference) {
+    auto norm = m_data->record_norms.find((int)d.first);
+
+    if (norm == m_data->record_norms.end()) {
+      // this record has not been read yet
+      return std::numeric_limits<double>::infinity();
+    }
+
+    result += std::fabs(d.second) * norm->second;
+  }
+
+  return result;
+}
+
+//! Sets the record number n to the contents of `data` (a subdomain-sized array in the
+//! (y, x) storage order used by InputInterpolation::regrid_buffered()).
+void Forcing::set_record(int n, const double *data) {
+
+  const int xs = grid()->xs(), xm = grid()->xm(), ys = grid()->ys();
+
+  array::AccessScope l{this};
+
+  double ***a3 = array3();
+  for (auto p : grid()->points()) {
+    const int i = p.i(), j = p.j();
+    a3[j][i][n] = data[(j - ys) * xm + (i - xs)];
+  }
+}
+
 //! Sets the record number n to the contents of the (internal) Vec v.
 void Forcing::set_record(int n) {
 
@@ -700,14 +1119,6 @@ void Forcing::average(double t, double dt) {
       assert(t0 + delta < t0 + P);
       auto W1 = integration_weights(data, data_size, type, t0 + delta, t0 + P);
 
-      std::map<size_t, double> W2{};
-      if (N_periods > 0) {
-        // note: we know that t0 < t0 + P because P > 0
-        W2 = integration_weights(data, data_size, type, t0, t0 + P);
-      } else {
-        W2 = {};
-      }
-
       std::map<size_t, double> W3{};
       if (gamma > 0.0) {
         W3 = integration_weights(data, data_size, type, t0, t0 + gamma);
@@ -718,8 +1129,17 @@ void Forcing::average(double t, double dt) {
       // before the first complete period:
       weights = W1;
       // an integer number of complete periods:
-      for (const auto &w : W2) {
-        weights[w.first] += N_periods * w.second;
+      if (N_periods > 0) {
+        if (m_data->period_weights.empty()) {
+          // All periodic records stay in memory for the duration of the run (see
+          // init_periodic_data()), so these weights never change: compute them once.
+          //
+          // note: we know that t0 < t0 + P because P > 0
+          m_data->period_weights = integration_weights(data, data_size, type, t0, t0 + P);
+        }
+        for (const auto &w : m_data->period_weights) {
+          weights[w.first] += N_periods * w.second;
+        }
       }
       // after the last complete period:
       for (const auto &w : W3) {
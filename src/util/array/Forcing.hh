@@ -59,8 +59,11 @@ public:
   void init(const std::string &filename, bool periodic);
 
   void update(double t, double dt);
+  void prefetch(double t, double dt);
   MaxTimestep max_timestep(double t) const;
 
+  double max_change(double t0, double dt0, double t1, double dt1) const;
+
   void interp(double t);
 
   void interp(int i, int j, std::vector<double> &results);
@@ -83,10 +86,19 @@ private:
   void allocate(unsigned int buffer_size, InterpolationType interpolation_type);
 
   double*** array3();
+  bool buffer_covers(double t, double dt);
   void update(unsigned int start);
   void discard(int N);
+  double record_norm(int n);
   void set_record(int n);
+  void set_record(int n, const double *data);
   void init_periodic_data(const File &file);
+
+  // Asynchronous prefetching of records (see input.forcing.prefetch):
+  void init_prefetch(const File &file, const std::string &variable_name);
+  void prefetch_loop();
+  std::vector<double> take_prefetched_record(unsigned int index);
+  void schedule_prefetch(unsigned int first, unsigned int count);
 };
 
 } // end of namespace array
@@ -66,6 +66,17 @@ Staggered1::Staggered1(std::shared_ptr<const Grid> grid, const std::string &name
   // empty
 }
 
+Staggered1::Staggered1(std::shared_ptr<const Grid> grid, const std::string &name,
+                       unsigned int stencil_width)
+    : Staggered(grid, name, stencil_width) {
+  // empty
+}
+
+Staggered2::Staggered2(std::shared_ptr<const Grid> grid, const std::string &name)
+    : Staggered1(grid, name, 2) {
+  // empty
+}
+
 std::array<double,2> absmax(const array::Staggered &input) {
 
   double z[2] = {0.0, 0.0};
@@ -87,6 +98,7 @@ std::array<double,2> absmax(const array::Staggered &input) {
 void staggered_to_regular(const array::CellType1 &cell_type,
                           const array::Staggered1 &input,
                           bool include_floating_ice,
+                          double scale,
                           array::Scalar &result) {
 
   using mask::grounded_ice;
@@ -118,7 +130,7 @@ void staggered_to_regular(const array::CellType1 &cell_type,
       }
 
       if (n + e + s + w > 0) {
-        result(i, j) = (n * F.n + e * F.e + s * F.s + w * F.w) / (n + e + s + w);
+        result(i, j) = scale * ((n * F.n + e * F.e + s * F.s + w * F.w) / (n + e + s + w));
       } else {
         result(i, j) = 0.0;
       }
@@ -131,6 +143,7 @@ void staggered_to_regular(const array::CellType1 &cell_type,
 void staggered_to_regular(const array::CellType1 &cell_type,
                           const array::Staggered1 &input,
                           bool include_floating_ice,
+                          double scale,
                           array::Vector &result) {
 
   using mask::grounded_ice;
@@ -163,13 +176,13 @@ void staggered_to_regular(const array::CellType1 &cell_type,
     }
 
     if (e + w > 0) {
-      result(i, j).u = (e * F.e + w * F.w) / (e + w);
+      result(i, j).u = scale * ((e * F.e + w * F.w) / (e + w));
     } else {
       result(i, j).u = 0.0;
     }
 
     if (n + s > 0) {
-      result(i, j).v = (n * F.n + s * F.s) / (n + s);
+      result(i, j).v = scale * ((n * F.n + s * F.s) / (n + s));
     } else {
       result(i, j).v = 0.0;
     }
@@ -70,6 +70,17 @@ public:
     this context.
   */
   inline stencils::Star<double> star(int i, int j) const;
+protected:
+  Staggered1(std::shared_ptr<const Grid> grid, const std::string &name,
+             unsigned int stencil_width);
+};
+
+/*!
+ * Staggered-grid 2D array supporting width=2 stencil computations
+ */
+class Staggered2 : public Staggered1 {
+public:
+  Staggered2(std::shared_ptr<const Grid> grid, const std::string &name);
 };
 
 inline stencils::Star<double> Staggered1::star(int i, int j) const {
@@ -97,10 +108,15 @@ std::array<double,2> absmax(const array::Staggered &input);
  *
  * If `include_floating_ice` is true, include floating ice, otherwise consider grounded
  * icy cells only.
+ *
+ * Averages are multiplied by `scale`: callers converting accumulated fluxes into rates
+ * fold the division by the time step into this pass instead of scaling `result` in a
+ * separate pass over the grid.
  */
 void staggered_to_regular(const array::CellType1 &cell_type,
                           const array::Staggered1 &input,
                           bool include_floating_ice,
+                          double scale,
                           array::Scalar &result);
 
 /*!
@@ -109,10 +125,13 @@ void staggered_to_regular(const array::CellType1 &cell_type,
  *
  * If `include_floating_ice` is true, include floating ice, otherwise consider grounded
  * icy cells only.
+ *
+ * As above, averages are multiplied by `scale`.
  */
 void staggered_to_regular(const array::CellType1 &cell_type,
                           const array::Staggered1 &input,
                           bool include_floating_ice,
+                          double scale,
                           array::Vector &result);
 
 } // end of namespace array
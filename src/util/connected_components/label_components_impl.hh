@@ -55,7 +55,8 @@ std::map<int, int> final_labels(array::Scalar1 &input, bool subdomain_is_not_emp
  *
  * 3. Gather graph description on all sub-domains that have at least one patch.
  *
- * 4. Use breadth-first search to traverse this graph and compute final labels.
+ * 4. Resolve label equivalences using the disjoint-set data structure (union-find) and
+ *    compute final labels.
  *
  * 5. Apply final labels.
  *
@@ -25,7 +25,6 @@
 #include <cmath>  // pow, ceil, log10
 #include <map>
 #include <mpi.h>
-#include <queue>
 #include <set>
 
 namespace pism {
@@ -125,29 +124,13 @@ static std::vector<int> pack_data(const std::map<int, std::set<int> > &graph) {
 }
 
 /*!
- * Unpack data gathered from all the ranks that contain connected components.
- */
-static std::map<int, std::set<int> > unpack_data(const std::vector<int> &buffer) {
-  std::map<int, std::set<int> > result;
-  for (size_t n = 0; n < buffer.size() / 2; ++n) {
-    int a = buffer[2 * n + 0];
-    int b = buffer[2 * n + 1];
-
-    // insert *both* (a,b) and (b,a) because we want to be able to easily get a list
-    // of nodes adjacent to a given node
-    result[a].insert(b);
-    result[b].insert(a);
-  }
-
-  return result;
-}
-
-/*!
- * Assemble complete graph info by gathering edges from all MPI ranks that have at least
- * one patch.
+ * Gather the complete list of graph edges from all MPI ranks that have at least one
+ * patch.
+ *
+ * The result contains pairs of labels: `(result[2n], result[2n+1])` is the n-th edge.
  */
-static std::map<int, std::set<int> > assemble_graph(MPI_Comm comm,
-                                                    const std::map<int, std::set<int> > &subgraph) {
+static std::vector<int> gather_edges(MPI_Comm comm,
+                                     const std::map<int, std::set<int> > &subgraph) {
   int size = 0;
   MPI_Comm_size(comm, &size);
   int rank = 0;
@@ -175,13 +158,54 @@ static std::map<int, std::set<int> > assemble_graph(MPI_Comm comm,
   MPI_Allgatherv(message.data(), (int)message.size(), MPI_INT, buffer.data(), message_length.data(),
                  offsets.data(), MPI_INT, comm);
 
-  // unpack messages:
-  return unpack_data(buffer);
+  return buffer;
+}
+
+/*!
+ * Find the representative of the set containing the node `k` in a disjoint-set forest,
+ * compressing the path along the way.
+ */
+static int find_root(std::map<int, int> &parent, int k) {
+  int root = k;
+  while (parent[root] != root) {
+    root = parent[root];
+  }
+
+  // path compression: make all the nodes on the path from `k` to `root` point to `root`
+  while (parent[k] != root) {
+    int next  = parent[k];
+    parent[k] = root;
+    k         = next;
+  }
+
+  return root;
+}
+
+/*!
+ * Merge the sets containing the nodes `a` and `b` in a disjoint-set forest.
+ *
+ * The smaller of the two representatives becomes the representative of the merged set, so
+ * the representative of a set is the smallest label in it.
+ */
+static void merge(std::map<int, int> &parent, int a, int b) {
+  a = find_root(parent, a);
+  b = find_root(parent, b);
+
+  if (a < b) {
+    parent[b] = a;
+  } else {
+    parent[a] = b;
+  }
 }
 
 /*!
- * Traverse the `graph` using a version of the "breadth first search" algorithm and find
- * final labels for all of its nodes.
+ * Process the list of graph `edges` (label equivalences) and find final labels for all of
+ * its nodes.
+ *
+ * Uses the disjoint-set data structure
+ * (https://en.wikipedia.org/wiki/Disjoint-set_data_structure): all equivalences are
+ * resolved in a single pass over the edge list, with cost nearly linear in its length and
+ * independent of the diameter of connected components.
  *
  * If `mark_isolated_patches` is true, isolated patches get labeled with `1`, the rest
  * with `0`.
@@ -189,62 +213,46 @@ static std::map<int, std::set<int> > assemble_graph(MPI_Comm comm,
  * If `mark_isolated_patches` is false, each connected component in the graph gets a
  * unique label starting from `1` and using consecutive integers.
  */
-static std::map<int, int> resolve_labels(const std::map<int, std::set<int> > &graph,
+static std::map<int, int> resolve_labels(const std::vector<int> &edges,
                                          bool mark_isolated_patches) {
 
-  // visited[X] == true if we already visited the node with the ID equal to X
-  std::map<int, bool> visited;
+  // parent[X]: the parent of the node X in the disjoint-set forest
+  std::map<int, int> parent;
   // map from node IDs to labels
   std::map<int, int> result;
 
   // label used for "attached" cells
   const int attached = 1;
 
-  // Loop over all edges in the graph and start the breadth-first search starting from the
-  // first node of each edge. This is sufficient since if (a,b) is in the graph then (b,a)
-  // is also in the graph (by construction).
-  for (const auto &edge : graph) {
-    int u = edge.first;
-
-    if (visited[u]) {
-      continue;
-    }
-
-    // select a provisional label:
-    int label = u;
-
-    std::set<int> equivalent{};
-
-    std::queue<int> queue;
-    queue.push(u);
-    while (not queue.empty()) {
-      int v = queue.front();
-      queue.pop();
-
-      if (visited[v]) {
-        continue;
-      }
-
-      // Odd labels are used to mark "attached" cells; replace this label with "1". Note
-      // that this is the smallest label we use, so `min(label, v)` will preserve it.
-      label = (v % 2 == 1) ? attached : std::min(label, v);
+  // Every node appears in at least one edge (see detect_connections()), so this
+  // initializes the forest with each node in a set of its own:
+  for (int k : edges) {
+    parent.emplace(k, k);
+  }
 
-      equivalent.insert(v);
-      visited[v] = true;
+  // merge sets connected by edges (cross-subdomain edges appear in the lists sent by both
+  // ranks involved; merging a second time is a cheap no-op):
+  size_t n_edges = edges.size() / 2;
+  for (size_t n = 0; n < n_edges; ++n) {
+    merge(parent, edges[2 * n + 0], edges[2 * n + 1]);
+  }
 
-      auto it = graph.find(v);
-      if (it != graph.end()) {
-        for (int w : it->second) {
-          queue.push(w);
-        }
-      }
+  // Odd labels are used to mark "attached" cells: find components containing them. Note
+  // that a component's representative may be even (a smaller label from another rank)
+  // even if the component is attached, so parity of the representative is not enough.
+  std::set<int> attached_roots;
+  for (const auto &p : parent) {
+    if (p.first % 2 == 1) {
+      attached_roots.insert(find_root(parent, p.first));
     }
+  }
 
-    // record the label for all the "equivalent" nodes (i.e. all the nodes in a particular
-    // connected component)
-    for (int v : equivalent) {
-      result[v] = label;
-    }
+  // Record the label for all the nodes: the smallest label in a connected component, or
+  // "1" if the component is attached (this is the smallest label we use).
+  for (const auto &p : parent) {
+    int root = find_root(parent, p.first);
+
+    result[p.first] = (attached_roots.count(root) > 0) ? attached : root;
   }
 
   if (mark_isolated_patches) {
@@ -326,9 +334,9 @@ std::map<int, int> final_labels(array::Scalar1 &input, bool subdomain_is_not_emp
 
     // the following block is executed by ranks that have at least one patch
     if (subdomain_is_not_empty) {
-      auto graph = details::assemble_graph(comm, edges);
+      auto all_edges = details::gather_edges(comm, edges);
 
-      labels = details::resolve_labels(graph, mark_isolated_patches);
+      labels = details::resolve_labels(all_edges, mark_isolated_patches);
     }
 
     MPI_Comm_free(&comm);
@@ -30,9 +30,7 @@ namespace fem {
 
 DirichletData::DirichletData()
   : m_indices(NULL), m_weight(1.0) {
-  for (unsigned int k = 0; k < q1::n_chi; ++k) {
-    m_indices_e[k] = 0;
-  }
+  // empty
 }
 
 DirichletData::~DirichletData() {
@@ -76,11 +74,14 @@ void DirichletData::finish(const array::Array *values) {
 }
 
 //! @brief Constrain `element`, i.e. ensure that quadratures do not contribute to Dirichlet nodes by marking corresponding rows and columns as "invalid".
+/*! The mask extraction below (and in the enforce() methods) uses a local buffer so that
+one DirichletData can be shared by threads assembling different elements. */
 void DirichletData::constrain(Element2 &element) {
-  element.nodal_values(m_indices->array(), m_indices_e);
+  double indices_e[q1::n_chi];
+  element.nodal_values(m_indices->array(), indices_e);
   auto n_chi = element.n_chi();
   for (int k = 0; k < n_chi; k++) {
-    if (m_indices_e[k] > 0.5) { // Dirichlet node
+    if (indices_e[k] > 0.5) { // Dirichlet node
       // Mark any kind of Dirichlet node as not to be touched
       element.mark_row_invalid(k);
       element.mark_col_invalid(k);
@@ -100,9 +101,10 @@ DirichletData_Scalar::DirichletData_Scalar(const array::Scalar *indices,
 void DirichletData_Scalar::enforce(const Element2 &element, double* x_nodal) {
   assert(m_values != NULL);
 
-  element.nodal_values(m_indices->array(), m_indices_e);
+  double indices_e[q1::n_chi];
+  element.nodal_values(m_indices->array(), indices_e);
   for (int k = 0; k < element.n_chi(); k++) {
-    if (m_indices_e[k] > 0.5) { // Dirichlet node
+    if (indices_e[k] > 0.5) { // Dirichlet node
       int i = 0, j = 0;
       element.local_to_global(k, i, j);
       x_nodal[k] = (*m_values)(i, j);
@@ -111,9 +113,10 @@ void DirichletData_Scalar::enforce(const Element2 &element, double* x_nodal) {
 }
 
 void DirichletData_Scalar::enforce_homogeneous(const Element2 &element, double* x_nodal) {
-  element.nodal_values(m_indices->array(), m_indices_e);
+  double indices_e[q1::n_chi];
+  element.nodal_values(m_indices->array(), indices_e);
   for (int k = 0; k < element.n_chi(); k++) {
-    if (m_indices_e[k] > 0.5) { // Dirichlet node
+    if (indices_e[k] > 0.5) { // Dirichlet node
       x_nodal[k] = 0.0;
     }
   }
@@ -196,20 +199,45 @@ DirichletData_Vector::DirichletData_Vector(const array::Scalar *indices,
 void DirichletData_Vector::enforce(const Element2 &element, Vector2d* x_nodal) {
   assert(m_values != NULL);
 
-  element.nodal_values(m_indices->array(), m_indices_e);
+  double indices_e[q1::n_chi];
+  element.nodal_values(m_indices->array(), indices_e);
+  for (int k = 0; k < element.n_chi(); k++) {
+    if (indices_e[k] > 0.5) { // Dirichlet node
+      int i = 0, j = 0;
+      element.local_to_global(k, i, j);
+      x_nodal[k] = (*m_values)(i, j);
+    }
+  }
+}
+
+//! Set Dirichlet values in `x_nodal` and mark the corresponding element rows and columns
+//! as invalid in one pass.
+/*! Equivalent to enforce() followed by constrain(), but reads the element's mask values
+once instead of twice. Assembly loops test every element against the mask, so this
+halves those reads. */
+void DirichletData_Vector::enforce_and_constrain(Element2 &element, Vector2d* x_nodal) {
+  assert(m_values != NULL);
+
+  double indices_e[q1::n_chi];
+  element.nodal_values(m_indices->array(), indices_e);
   for (int k = 0; k < element.n_chi(); k++) {
-    if (m_indices_e[k] > 0.5) { // Dirichlet node
+    if (indices_e[k] > 0.5) { // Dirichlet node
       int i = 0, j = 0;
       element.local_to_global(k, i, j);
       x_nodal[k] = (*m_values)(i, j);
+
+      // Make sure that quadratures do not contribute to this node.
+      element.mark_row_invalid(k);
+      element.mark_col_invalid(k);
     }
   }
 }
 
 void DirichletData_Vector::enforce_homogeneous(const Element2 &element, Vector2d* x_nodal) {
-  element.nodal_values(m_indices->array(), m_indices_e);
+  double indices_e[q1::n_chi];
+  element.nodal_values(m_indices->array(), indices_e);
   for (int k = 0; k < element.n_chi(); k++) {
-    if (m_indices_e[k] > 0.5) { // Dirichlet node
+    if (indices_e[k] > 0.5) { // Dirichlet node
       x_nodal[k] = 0.0;
     }
   }
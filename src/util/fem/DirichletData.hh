@@ -51,7 +51,6 @@ protected:
   void finish(const array::Array *values);
 
   const array::Scalar *m_indices;
-  double m_indices_e[q1::n_chi];
   double m_weight;
 };
 
@@ -77,6 +76,7 @@ public:
   ~DirichletData_Vector();
 
   void enforce(const Element2 &element, Vector2d* x_e);
+  void enforce_and_constrain(Element2 &element, Vector2d* x_e);
   void enforce_homogeneous(const Element2 &element, Vector2d* x_e);
   void fix_residual(Vector2d const *const * x_global, Vector2d **r_global);
   void fix_residual_homogeneous(Vector2d **r);
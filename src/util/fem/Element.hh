@@ -76,6 +76,17 @@ public:
     return m_germs[q * m_n_chi + k];
   }
 
+  /*!
+   * `chi_row(q)` returns all `n_chi()` shape function values and derivatives at the
+   * quadrature point `q` as one contiguous row. Hoisting the row pointer out of a loop
+   * over shape functions avoids re-computing the index in chi() on every iteration and
+   * makes the consecutive loads visible to the vectorizer.
+   */
+  const Germ* chi_row(unsigned int q) const {
+    assert(q < m_Nq);
+    return &m_germs[q * m_n_chi];
+  }
+
   //! Number of quadrature points
   unsigned int n_pts() const {
     return m_Nq;
@@ -90,13 +101,36 @@ public:
   /*! @brief Given nodal values, compute the values at quadrature points.*/
   //! The output array `result` should have enough elements to hold values at all
   //! quadrature points.
+  //!
+  //! Accumulation uses a local variable so that the sum stays in a register: the
+  //! compiler cannot assume that `result` does not alias the shape function table.
   template <typename T>
   void evaluate(const T *x, T *result) const {
+    const Germ *germs = m_germs.data();
+    const unsigned int n_chi = m_n_chi;
     for (unsigned int q = 0; q < m_Nq; q++) {
-      result[q] = 0.0;
-      for (unsigned int k = 0; k < m_n_chi; k++) {
-        result[q] += m_germs[q * m_n_chi + k].val * x[k];
+      T sum = 0.0;
+      for (unsigned int k = 0; k < n_chi; k++) {
+        sum += germs[q * n_chi + k].val * x[k];
+      }
+      result[q] = sum;
+    }
+  }
+
+  /*! @brief Version of evaluate() with compile-time sizes. */
+  //! Use this when the element type and quadrature are known at the call site (e.g. Q1
+  //! elements with the 2x2 Gaussian quadrature: `evaluate<4, 4>(...)`). The fixed trip
+  //! counts let the compiler fully unroll and vectorize the accumulation.
+  template <unsigned int Nq_, unsigned int Nk_, typename T>
+  void evaluate(const T *x, T *result) const {
+    assert(Nq_ == m_Nq and Nk_ == m_n_chi);
+    const Germ *germs = m_germs.data();
+    for (unsigned int q = 0; q < Nq_; q++) {
+      T sum = 0.0;
+      for (unsigned int k = 0; k < Nk_; k++) {
+        sum += germs[q * Nk_ + k].val * x[k];
       }
+      result[q] = sum;
     }
   }
 
@@ -191,25 +225,49 @@ public:
   /*! @brief Given nodal values, compute the values and partial derivatives at the
    *  quadrature points.*/
   //! Output arrays should have enough elements to hold values at all quadrature points.`
+  //!
+  //! Local accumulators keep the sums in registers; see Element::evaluate().
   template <typename T>
   void evaluate(const T *x, T *vals, T *dx, T *dy) {
+    const Germ *germs = m_germs.data();
+    const unsigned int n_chi = m_n_chi;
     for (unsigned int q = 0; q < m_Nq; q++) {
-      vals[q] = 0.0;
-      dx[q]   = 0.0;
-      dy[q]   = 0.0;
-      for (unsigned int k = 0; k < m_n_chi; k++) {
-        const Germ &psi = m_germs[q * m_n_chi + k];
+      T val_q = 0.0, dx_q = 0.0, dy_q = 0.0;
+      for (unsigned int k = 0; k < n_chi; k++) {
+        const Germ &psi = germs[q * n_chi + k];
 #ifdef __clang_analyzer__
         // suppress false positive Clang static analyzer warnings about x[k] below being
         // garbage
         [[clang::suppress]]
 #endif
         {
-          vals[q] += psi.val * x[k];
-          dx[q] += psi.dx * x[k];
-          dy[q] += psi.dy * x[k];
+          val_q += psi.val * x[k];
+          dx_q += psi.dx * x[k];
+          dy_q += psi.dy * x[k];
         }
       }
+      vals[q] = val_q;
+      dx[q]   = dx_q;
+      dy[q]   = dy_q;
+    }
+  }
+
+  /*! @brief Version of evaluate() with compile-time sizes; see Element::evaluate(). */
+  template <unsigned int Nq_, unsigned int Nk_, typename T>
+  void evaluate(const T *x, T *vals, T *dx, T *dy) {
+    assert(Nq_ == m_Nq and Nk_ == m_n_chi);
+    const Germ *germs = m_germs.data();
+    for (unsigned int q = 0; q < Nq_; q++) {
+      T val_q = 0.0, dx_q = 0.0, dy_q = 0.0;
+      for (unsigned int k = 0; k < Nk_; k++) {
+        const Germ &psi = germs[q * Nk_ + k];
+        val_q += psi.val * x[k];
+        dx_q += psi.dx * x[k];
+        dy_q += psi.dy * x[k];
+      }
+      vals[q] = val_q;
+      dx[q]   = dx_q;
+      dy[q]   = dy_q;
     }
   }
 
@@ -281,20 +339,25 @@ public:
   /*! @brief Given nodal values, compute the values and partial derivatives at the
    *  quadrature points.*/
   //! Output arrays should have enough elements to hold values at all quadrature points.`
+  //!
+  //! Local accumulators keep the sums in registers; see Element::evaluate().
   template <typename T>
   void evaluate(const T *x, T *vals, T *dx, T *dy, T *dz) const {
+    const Germ *germs = m_germs.data();
+    const unsigned int n_chi = m_n_chi;
     for (unsigned int q = 0; q < m_Nq; q++) {
-      vals[q] = 0.0;
-      dx[q]   = 0.0;
-      dy[q]   = 0.0;
-      dz[q]   = 0.0;
-      for (unsigned int k = 0; k < m_n_chi; k++) {
-        const Germ &psi = m_germs[q * m_n_chi + k];
-        vals[q] += psi.val * x[k];
-        dx[q]   += psi.dx  * x[k];
-        dy[q]   += psi.dy  * x[k];
-        dz[q]   += psi.dz  * x[k];
+      T val_q = 0.0, dx_q = 0.0, dy_q = 0.0, dz_q = 0.0;
+      for (unsigned int k = 0; k < n_chi; k++) {
+        const Germ &psi = germs[q * n_chi + k];
+        val_q += psi.val * x[k];
+        dx_q  += psi.dx  * x[k];
+        dy_q  += psi.dy  * x[k];
+        dz_q  += psi.dz  * x[k];
       }
+      vals[q] = val_q;
+      dx[q]   = dx_q;
+      dy[q]   = dy_q;
+      dz[q]   = dz_q;
     }
   }
 
@@ -422,6 +485,13 @@ public:
     return m_chi[q * m_n_chi + k];
   }
 
+  //! Shape function values at the quadrature point `q` (`n_chi` consecutive values);
+  //! see Element::chi_row().
+  const double* chi_row(unsigned int q) const {
+    assert(q < m_Nq);
+    return &m_chi[q * m_n_chi];
+  }
+
   // outward pointing unit normal vector to an element face at the quadrature point q
   const Vector3& normal(unsigned int q) const {
     return m_normals[q];
@@ -432,11 +502,14 @@ public:
 
   template <typename T>
   void evaluate(const T *x, T *result) const {
+    const double *chi = m_chi.data();
+    const unsigned int n_chi = m_n_chi;
     for (unsigned int q = 0; q < m_Nq; q++) {
-      result[q] = 0.0;
-      for (unsigned int k = 0; k < m_n_chi; k++) {
-        result[q] += m_chi[q * m_n_chi + k] * x[k];
+      T sum = 0.0;
+      for (unsigned int k = 0; k < n_chi; k++) {
+        sum += chi[q * n_chi + k] * x[k];
       }
+      result[q] = sum;
     }
   }
 protected:
@@ -18,8 +18,10 @@
 
 #include <cassert>
 #include <cstdio>
+#include <list>
 #include <memory>
 #include <map>
+#include <utility>              // std::pair, std::make_pair
 
 #include <petscvec.h>
 #include <set>
@@ -51,6 +53,37 @@ struct File::Impl {
   std::shared_ptr<io::NCFile> nc;
 
   std::set<std::string> written_variables;
+
+  /*! Cached results of metadata inquiries.
+   *
+   * Every inquiry is answered by the backend using one or more collective MPI calls, so
+   * code paths that re-run the same lookups for every variable or record (finding
+   * variables by their standard_name, Array::regrid(), reading forcing data) pay
+   * per-inquiry latencies many times over. The cache is populated lazily and cleared by
+   * calls that may modify metadata (see clear_metadata_cache()).
+   *
+   * The length of the unlimited dimension is *not* cached: it grows as records are
+   * written, without any define-mode call.
+   */
+  struct MetadataCache {
+    std::map<std::string, bool> variable_exists;
+    std::map<std::string, bool> dimension_exists;
+    std::map<std::string, std::vector<std::string> > dimensions;
+    std::map<std::string, unsigned int> dimension_length;
+    std::map<std::pair<std::string, std::string>, VariableLookupData> variables;
+    std::map<std::pair<std::string, std::string>, io::Type> attribute_type;
+    std::map<std::pair<std::string, std::string>, std::string> text_attributes;
+    std::map<std::pair<std::string, std::string>, std::vector<double> > double_attributes;
+    //! name of the unlimited dimension ("" if there is none); valid if unlimdim_known
+    std::string unlimdim;
+    bool unlimdim_known = false;
+
+    void clear() {
+      *this = MetadataCache();
+    }
+  };
+
+  MetadataCache cache;
 };
 
 io::Backend string_to_backend(const std::string &backend) {
@@ -190,6 +223,35 @@ void File::set_compression_level(int level) const {
   m_impl->nc->set_compression_level(level);
 }
 
+//! Select the compression filter ("deflate" or "zstd") applied to 2D and 3D variables.
+/*! This is a no-op unless the backend writes NetCDF-4 (HDF5) files. */
+void File::set_compression_algorithm(const std::string &algorithm) const {
+  m_impl->nc->set_compression_algorithm(algorithm);
+}
+
+//! Set the number of significant decimal digits kept by (lossy) BitGroom quantization.
+/*! Zero disables quantization. This is a no-op unless the backend writes NetCDF-4
+    (HDF5) files. */
+void File::set_quantization(int significant_digits) const {
+  m_impl->nc->set_quantization(significant_digits);
+}
+
+//! Set the HDF5 chunk cache parameters of a variable.
+/*!
+ * This is a no-op unless the backend reads or writes NetCDF-4 (HDF5) files; see the
+ * output.netcdf4.chunk_cache_size configuration parameter.
+ */
+void File::set_variable_chunk_cache(const std::string &variable_name, size_t n_bytes,
+                                    size_t n_slots, double preemption) const {
+  try {
+    m_impl->nc->set_var_chunk_cache(variable_name, n_bytes, n_slots, preemption);
+  } catch (RuntimeError &e) {
+    e.add_context("setting the chunk cache of variable '%s' in '%s'",
+                  variable_name.c_str(), name().c_str());
+    throw;
+  }
+}
+
 void File::open(const std::string &filename, io::Mode mode) {
   try {
 
@@ -227,6 +289,7 @@ void File::open(const std::string &filename, io::Mode mode) {
 
 void File::remove_attribute(const std::string &variable_name, const std::string &att_name) const {
   try {
+    m_impl->cache.clear();
     m_impl->nc->del_att(variable_name, att_name);
   } catch (RuntimeError &e) {
     e.add_context("deleting the attribute %s:%s", variable_name.c_str(), att_name.c_str());
@@ -254,6 +317,8 @@ void File::sync() const {
 
 void File::redef() const {
   try {
+    // entering define mode usually precedes metadata modifications
+    m_impl->cache.clear();
     m_impl->nc->redef();
   } catch (RuntimeError &e) {
     e.add_context("switching to define mode; file \"" + name() + "\"");
@@ -328,6 +393,12 @@ unsigned int File::nrecords(const std::string &variable_name, const std::string
 VariableLookupData File::find_variable(const std::string &short_name, const std::string &std_name) const {
   VariableLookupData result;
   try {
+    auto key = std::make_pair(short_name, std_name);
+    auto cached = m_impl->cache.variables.find(key);
+    if (cached != m_impl->cache.variables.end()) {
+      return cached->second;
+    }
+
     result.exists = false;
 
     if (not std_name.empty()) {
@@ -366,6 +437,8 @@ VariableLookupData File::find_variable(const std::string &short_name, const std:
       }
     }
 
+    m_impl->cache.variables[key] = result;
+
   } catch (RuntimeError &e) {
     e.add_context("searching for variable '%s' ('%s') in '%s'", short_name.c_str(), std_name.c_str(), name().c_str());
     throw;
@@ -377,8 +450,14 @@ VariableLookupData File::find_variable(const std::string &short_name, const std:
 //! \brief Checks if a variable exists.
 bool File::variable_exists(const std::string &variable_name) const {
   try {
+    auto cached = m_impl->cache.variable_exists.find(variable_name);
+    if (cached != m_impl->cache.variable_exists.end()) {
+      return cached->second;
+    }
+
     bool exists = false;
     m_impl->nc->inq_varid(variable_name, exists);
+    m_impl->cache.variable_exists[variable_name] = exists;
     return exists;
   } catch (RuntimeError &e) {
     e.add_context("searching for variable '%s' in '%s'", variable_name.c_str(),
@@ -389,8 +468,14 @@ bool File::variable_exists(const std::string &variable_name) const {
 
 std::vector<std::string> File::dimensions(const std::string &variable_name) const {
   try {
+    auto cached = m_impl->cache.dimensions.find(variable_name);
+    if (cached != m_impl->cache.dimensions.end()) {
+      return cached->second;
+    }
+
     std::vector<std::string> result;
     m_impl->nc->inq_vardimid(variable_name, result);
+    m_impl->cache.dimensions[variable_name] = result;
     return result;
   } catch (RuntimeError &e) {
     e.add_context("getting dimensions of variable '%s' in '%s'", variable_name.c_str(),
@@ -403,8 +488,14 @@ std::vector<std::string> File::dimensions(const std::string &variable_name) cons
 //! \brief Checks if a dimension exists.
 bool File::dimension_exists(const std::string &dimension_name) const {
   try {
+    auto cached = m_impl->cache.dimension_exists.find(dimension_name);
+    if (cached != m_impl->cache.dimension_exists.end()) {
+      return cached->second;
+    }
+
     bool exists = false;
     m_impl->nc->inq_dimid(dimension_name, exists);
+    m_impl->cache.dimension_exists[dimension_name] = exists;
     return exists;
   } catch (RuntimeError &e) {
     e.add_context("searching for dimension '%s' in '%s'", dimension_name.c_str(),
@@ -420,8 +511,29 @@ bool File::dimension_exists(const std::string &dimension_name) const {
 unsigned int File::dimension_length(const std::string &dimension_name) const {
   try {
     if (dimension_exists(dimension_name)) {
+      auto &cache = m_impl->cache;
+
+      if (not cache.unlimdim_known) {
+        m_impl->nc->inq_unlimdim(cache.unlimdim);
+        cache.unlimdim_known = true;
+      }
+
+      if (dimension_name == cache.unlimdim) {
+        // the length of the unlimited dimension grows as records are written: do not
+        // cache it
+        unsigned int result = 0;
+        m_impl->nc->inq_dimlen(dimension_name, result);
+        return result;
+      }
+
+      auto cached = cache.dimension_length.find(dimension_name);
+      if (cached != cache.dimension_length.end()) {
+        return cached->second;
+      }
+
       unsigned int result = 0;
       m_impl->nc->inq_dimlen(dimension_name, result);
+      cache.dimension_length[dimension_name] = result;
       return result;
     }
 
@@ -536,6 +648,7 @@ AxisType File::dimension_type(const std::string &dimension_name,
 
 void File::define_dimension(const std::string &dimension_name, size_t length) const {
   try {
+    m_impl->cache.clear();
     m_impl->nc->def_dim(dimension_name, length);
   } catch (RuntimeError &e) {
     e.add_context("defining dimension '%s' in '%s'", dimension_name.c_str(),
@@ -544,30 +657,102 @@ void File::define_dimension(const std::string &dimension_name, size_t length) co
   }
 }
 
+//! Compute chunk sizes for a spatial variable.
+/*!
+ * Chunks are aligned with PISM's default domain decomposition (see grid::nprocs()): one
+ * record of the record (time) dimension, `Ny` by `Nx` blocks in the horizontal
+ * directions, and the full extent of the remaining (vertical) dimension, if any. This
+ * way each rank's subdomain maps to a small number of chunks and HDF5 can avoid slow
+ * partial-chunk collective I/O when writing in parallel.
+ *
+ * Returns an empty vector if `dims` does not look like dimensions of a spatial variable
+ * or if the grid is too small to split.
+ */
+static std::vector<size_t> chunk_dimensions(MPI_Comm com, const std::vector<std::string> &dims,
+                                            const std::string &record_dimension,
+                                            const std::vector<size_t> &dim_lengths) {
+  std::vector<size_t> result(dims.size(), 0);
+
+  // lengths of non-record dimensions, in the storage order (y, x[, z]):
+  std::vector<size_t> lengths;
+  for (size_t k = 0; k < dims.size(); ++k) {
+    if (dims[k] != record_dimension) {
+      lengths.push_back(dim_lengths[k]);
+    }
+  }
+
+  if (lengths.size() < 2) {
+    // not a spatial variable (e.g. time bounds)
+    return {};
+  }
+
+  int size = 1;
+  MPI_Comm_size(com, &size);
+
+  size_t My = lengths[0];
+  size_t Mx = lengths[1];
+
+  size_t chunk_x = 0;
+  size_t chunk_y = 0;
+  try {
+    auto N = grid::nprocs((unsigned int)size, (unsigned int)Mx, (unsigned int)My);
+
+    chunk_x = (Mx + N[0] - 1) / N[0];
+    chunk_y = (My + N[1] - 1) / N[1];
+  } catch (RuntimeError &) {
+    // grid::nprocs() refuses to split a grid into patches that are too small; fall back
+    // to the default storage layout in this case
+    return {};
+  }
+
+  size_t n = 0;
+  for (size_t k = 0; k < dims.size(); ++k) {
+    if (dims[k] == record_dimension) {
+      result[k] = 1;
+    } else {
+      switch (n) {
+      case 0:
+        result[k] = chunk_y;
+        break;
+      case 1:
+        result[k] = chunk_x;
+        break;
+      default:
+        result[k] = dim_lengths[k];
+      }
+      n += 1;
+    }
+  }
+
+  return result;
+}
+
 //! \brief Define a variable.
 void File::define_variable(const std::string &variable_name, io::Type nctype,
                            const std::vector<std::string> &dims) const {
   try {
+    m_impl->cache.clear();
     m_impl->nc->def_var(variable_name, nctype, dims);
 
-    // FIXME: I need to write and tune chunk_dimensions that would be called below before we use
-    // this.
-    //
-    /*
     // if it's not a spatial variable, we're done
     if (dims.size() < 2) {
       return;
     }
 
     std::vector<size_t> dim_lengths;
-    for (unsigned int k = 0; k < dims.size(); ++k) {
-      dim_lengths.push_back(this->dimension_length(dims[k]));
+    for (const auto &d : dims) {
+      dim_lengths.push_back(this->dimension_length(d));
     }
 
-    std::vector<size_t> chunk_dims = chunk_dimensions(nctype, dim_lengths);
+    std::string record_dimension;
+    m_impl->nc->inq_unlimdim(record_dimension);
+
+    auto chunk_dims = chunk_dimensions(m_impl->com, dims, record_dimension, dim_lengths);
 
-    m_impl->nc->def_var_chunking(name, chunk_dims);
-    */
+    // Note: this is a no-op unless the backend writes NetCDF-4 (HDF5) files.
+    if (not chunk_dims.empty()) {
+      m_impl->nc->def_var_chunking(variable_name, chunk_dims);
+    }
 
   } catch (RuntimeError &e) {
     e.add_context("defining variable '%s' in '%s'", variable_name.c_str(),
@@ -636,8 +821,15 @@ std::vector<double> File::read_double_attribute(const std::string &var_name, con
 
     // In this case att_type might be io::PISM_NAT (if an attribute does not
     // exist), but read_double_attribute can handle that.
+    auto key = std::make_pair(var_name, att_name);
+    auto cached = m_impl->cache.double_attributes.find(key);
+    if (cached != m_impl->cache.double_attributes.end()) {
+      return cached->second;
+    }
+
     std::vector<double> result;
     m_impl->nc->get_att_double(var_name, att_name, result);
+    m_impl->cache.double_attributes[key] = result;
     return result;
   } catch (RuntimeError &e) {
     e.add_context("reading double attribute '%s:%s' from '%s'",
@@ -656,8 +848,15 @@ std::string File::read_text_attribute(const std::string &var_name, const std::st
                                     "attribute %s is not a string", att_name.c_str());
     }
 
+    auto key = std::make_pair(var_name, att_name);
+    auto cached = m_impl->cache.text_attributes.find(key);
+    if (cached != m_impl->cache.text_attributes.end()) {
+      return cached->second;
+    }
+
     std::string result;
     m_impl->nc->get_att_text(var_name, att_name, result);
+    m_impl->cache.text_attributes[key] = result;
     return result;
   } catch (RuntimeError &e) {
     e.add_context("reading text attribute '%s:%s' from %s", var_name.c_str(), att_name.c_str(), name().c_str());
@@ -691,8 +890,15 @@ std::string File::attribute_name(const std::string &var_name, unsigned int n) co
 
 io::Type File::attribute_type(const std::string &var_name, const std::string &att_name) const {
   try {
+    auto key = std::make_pair(var_name, att_name);
+    auto cached = m_impl->cache.attribute_type.find(key);
+    if (cached != m_impl->cache.attribute_type.end()) {
+      return cached->second;
+    }
+
     io::Type result;
     m_impl->nc->inq_atttype(var_name, att_name, result);
+    m_impl->cache.attribute_type[key] = result;
     return result;
   } catch (RuntimeError &e) {
     e.add_context("getting the type of an attribute of variable '%s' in '%s'", var_name.c_str(), name().c_str());
@@ -789,4 +995,62 @@ bool File::get_variable_was_written(const std::string &name) const {
   return set_member(name, m_impl->written_variables);
 }
 
+struct FileCache::Impl {
+  MPI_Comm com;
+  unsigned int capacity;
+  //! open files, most recently used first
+  std::list<std::pair<std::string, std::shared_ptr<File> > > files;
+};
+
+FileCache::FileCache(MPI_Comm com, unsigned int capacity)
+  : m_impl(new Impl) {
+  m_impl->com      = com;
+  m_impl->capacity = capacity;
+}
+
+FileCache::~FileCache() {
+  delete m_impl;
+}
+
+/*!
+ * Return an open read-only file corresponding to `filename`, re-using a pooled handle if
+ * this file was opened recently.
+ *
+ * Collective: see the class-level comment.
+ */
+std::shared_ptr<File> FileCache::get(const std::string &filename) {
+  auto &files = m_impl->files;
+
+  for (auto it = files.begin(); it != files.end(); ++it) {
+    if (it->first == filename) {
+      // mark as most recently used
+      files.splice(files.begin(), files, it);
+      return files.front().second;
+    }
+  }
+
+  auto result = std::make_shared<File>(m_impl->com, filename,
+                                       io::PISM_GUESS, io::PISM_READONLY);
+
+  // capacity == 0 disables pooling: behave like a plain File constructor call
+  if (m_impl->capacity > 0) {
+    files.push_front(std::make_pair(filename, result));
+
+    // Evict the least recently used files. Note: this releases the pool's reference; each
+    // file is closed once its last remaining user lets go of the handle.
+    while (files.size() > m_impl->capacity) {
+      files.pop_back();
+    }
+  }
+
+  return result;
+}
+
+/*!
+ * Release all pooled handles (files with no other users are closed).
+ */
+void FileCache::clear() {
+  m_impl->files.clear();
+}
+
 } // end of namespace pism
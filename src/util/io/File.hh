@@ -21,6 +21,7 @@
 
 #include <vector>
 #include <string>
+#include <memory>
 #include <mpi.h>
 
 #include "pism/util/Units.hh"
@@ -128,6 +129,13 @@ public:
 
   void set_compression_level(int level) const;
 
+  void set_compression_algorithm(const std::string &algorithm) const;
+
+  void set_quantization(int significant_digits) const;
+
+  void set_variable_chunk_cache(const std::string &variable_name, size_t n_bytes,
+                                size_t n_slots, double preemption) const;
+
   // attributes
 
   void remove_attribute(const std::string &variable_name, const std::string &att_name) const;
@@ -159,6 +167,41 @@ private:
   File & operator=(const File &);
 };
 
+//! \brief Bounded pool of open read-only files.
+/*!
+ * Opening a NetCDF file is expensive on parallel file systems (every open and close is at
+ * least one file system metadata round-trip) and PISM's regridding and forcing code paths
+ * open the same input files many times over. This pool keeps up to `capacity` recently
+ * used files open, evicting the least recently used one when it is full; see
+ * `input.file_cache.capacity`.
+ *
+ * An evicted file is closed when the last user releases its handle, so eviction never
+ * invalidates a `File` some caller is still reading from.
+ *
+ * Like the `File` constructor, `get()` is collective: call it on all ranks of `com`, in
+ * the same order, with the same arguments. (All the lookups and evictions are then
+ * identical on all ranks and every file operation remains collective.)
+ *
+ * Use it for *input* files only: cached handles are read-only and a file modified by
+ * another process while it is in the pool may be seen in its old state.
+ */
+class FileCache {
+public:
+  FileCache(MPI_Comm com, unsigned int capacity);
+  ~FileCache();
+
+  std::shared_ptr<File> get(const std::string &filename);
+
+  void clear();
+private:
+  struct Impl;
+  Impl *m_impl;
+
+  // disable copying and assignments
+  FileCache(const FileCache &other);
+  FileCache & operator=(const FileCache &);
+};
+
 } // end of namespace pism
 
 #endif /* _PISM_FILE_ACCESS_H_ */
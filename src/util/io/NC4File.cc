@@ -26,6 +26,11 @@
 #define MPI_INCLUDED 1
 #endif
 #include <netcdf.h>
+#include <netcdf_meta.h>
+
+#if NC_HAS_ZSTD
+#include <netcdf_filter.h>
+#endif
 
 #include "pism/util/io/pism_type_conversion.hh"
 #include "pism/util/pism_utilities.hh"
@@ -42,10 +47,31 @@ static void check(const ErrorLocation &where, int return_code) {
 }
 
 NC4File::NC4File(MPI_Comm c, unsigned int compression_level)
-  : NCFile(c), m_compression_level(compression_level) {
+  : NCFile(c), m_compression_level(compression_level),
+    m_compression_algorithm("deflate"), m_quantization_digits(0) {
   // empty
 }
 
+void NC4File::set_compression_algorithm_impl(const std::string &algorithm) const {
+#if (NC_HAS_ZSTD == 0)
+  if (algorithm == "zstd") {
+    throw RuntimeError(PISM_ERROR_LOCATION,
+                       "this PISM build uses a NetCDF library without Zstandard support");
+  }
+#endif
+  m_compression_algorithm = algorithm;
+}
+
+void NC4File::set_quantization_impl(int significant_digits) const {
+#if (NC_HAS_QUANTIZE == 0)
+  if (significant_digits > 0) {
+    throw RuntimeError(PISM_ERROR_LOCATION,
+                       "this PISM build uses a NetCDF library without quantization support");
+  }
+#endif
+  m_quantization_digits = significant_digits;
+}
+
 // open/create/close
 
 void NC4File::sync_impl() const {
@@ -135,7 +161,15 @@ void NC4File::def_var_impl(const std::string &name,
   // Compress 2D and 3D variables
   if (m_compression_level > 0 and dims.size() > 1) {
     stat = nc_inq_varid(m_file_id, name.c_str(), &varid); check(PISM_ERROR_LOCATION, stat);
+#if NC_HAS_ZSTD
+    if (m_compression_algorithm == "zstd") {
+      stat = nc_def_var_zstandard(m_file_id, varid, m_compression_level);
+    } else {
+      stat = nc_def_var_deflate(m_file_id, varid, 0, 1, m_compression_level);
+    }
+#else
     stat = nc_def_var_deflate(m_file_id, varid, 0, 1, m_compression_level);
+#endif
 
     // The NetCDF version used by PISM may not support compression.
     if (stat == NC_EINVAL) {
@@ -144,6 +178,18 @@ void NC4File::def_var_impl(const std::string &name,
 
     check(PISM_ERROR_LOCATION, stat);
   }
+
+#if NC_HAS_QUANTIZE
+  // Quantize floating-point 2D and 3D variables (lossy: keeps m_quantization_digits
+  // significant decimal digits). Quantization creates runs of zero bits that make the
+  // compression applied above much more effective.
+  if (m_quantization_digits > 0 and dims.size() > 1 and
+      (nctype == io::PISM_FLOAT or nctype == io::PISM_DOUBLE)) {
+    stat = nc_inq_varid(m_file_id, name.c_str(), &varid); check(PISM_ERROR_LOCATION, stat);
+    stat = nc_def_var_quantize(m_file_id, varid, NC_QUANTIZE_BITGROOM, m_quantization_digits);
+    check(PISM_ERROR_LOCATION, stat);
+  }
+#endif
 }
 
 void NC4File::def_var_chunking_impl(const std::string &name,
@@ -157,6 +203,17 @@ void NC4File::def_var_chunking_impl(const std::string &name,
   check(PISM_ERROR_LOCATION, stat);
 }
 
+void NC4File::set_var_chunk_cache_impl(const std::string &name, size_t n_bytes,
+                                       size_t n_slots, double preemption) const {
+  int stat = 0, varid = 0;
+
+  stat = nc_inq_varid(m_file_id, name.c_str(), &varid);
+  check(PISM_ERROR_LOCATION, stat);
+
+  stat = nc_set_var_chunk_cache(m_file_id, varid, n_bytes, n_slots, preemption);
+  check(PISM_ERROR_LOCATION, stat);
+}
+
 void NC4File::get_vara_double_impl(const std::string &variable_name,
                                   const std::vector<unsigned int> &start,
                                   const std::vector<unsigned int> &count,
@@ -231,10 +288,17 @@ int NC4File::get_varid(const std::string &variable_name) const {
     return NC_GLOBAL;
   }
 
+  auto cached = m_varid_cache.find(variable_name);
+  if (cached != m_varid_cache.end()) {
+    return cached->second;
+  }
+
   int result = 0;
   int stat = nc_inq_varid(m_file_id, variable_name.c_str(), &result);
   check(PISM_ERROR_LOCATION, stat);
 
+  m_varid_cache[variable_name] = result;
+
   return result;
 }
 
@@ -244,6 +308,11 @@ void NC4File::inq_varnatts_impl(const std::string &variable_name, int &result) c
 }
 
 void NC4File::inq_varid_impl(const std::string &variable_name, bool &exists) const {
+  if (m_varid_cache.find(variable_name) != m_varid_cache.end()) {
+    exists = true;
+    return;
+  }
+
   int varid = -1;
 
   int stat = nc_inq_varid(m_file_id, variable_name.c_str(), &varid);
@@ -56,6 +56,13 @@ protected:
   virtual void def_var_chunking_impl(const std::string &name,
                                     std::vector<size_t> &dimensions) const;
 
+  virtual void set_var_chunk_cache_impl(const std::string &name, size_t n_bytes,
+                                        size_t n_slots, double preemption) const;
+
+  virtual void set_compression_algorithm_impl(const std::string &algorithm) const;
+
+  virtual void set_quantization_impl(int significant_digits) const;
+
   virtual void def_var_impl(const std::string &name,
                            io::Type nctype, const std::vector<std::string> &dims) const;
 
@@ -108,6 +115,8 @@ protected:
                                   bool get) const;
 
   mutable unsigned int m_compression_level;
+  mutable std::string m_compression_algorithm;
+  mutable int m_quantization_digits;
 
   int get_varid(const std::string &variable_name) const;
 };
@@ -24,8 +24,14 @@
 #define MPI_INCLUDED 1
 #endif
 #include <netcdf.h>
+#include <netcdf_meta.h>
+
+#if NC_HAS_ZSTD
+#include <netcdf_filter.h>
+#endif
 
 #include "pism/util/error_handling.hh"
+#include "pism/util/io/IO_Flags.hh"
 #include "pism/util/pism_utilities.hh"
 
 namespace pism {
@@ -39,7 +45,8 @@ static void check(const ErrorLocation &where, int return_code) {
 }
 
 NC4_Serial::NC4_Serial(MPI_Comm c)
-  : NC_Serial(c), m_compression_level(0) {
+  : NC_Serial(c), m_compression_level(0), m_compression_algorithm("deflate"),
+    m_quantization_digits(0) {
   // empty
 }
 
@@ -61,6 +68,26 @@ void NC4_Serial::set_compression_level_impl(int level) const {
   m_compression_level = pism::clip(level, 0, 9);
 }
 
+void NC4_Serial::set_compression_algorithm_impl(const std::string &algorithm) const {
+#if (NC_HAS_ZSTD == 0)
+  if (algorithm == "zstd") {
+    throw RuntimeError(PISM_ERROR_LOCATION,
+                       "this PISM build uses a NetCDF library without Zstandard support");
+  }
+#endif
+  m_compression_algorithm = algorithm;
+}
+
+void NC4_Serial::set_quantization_impl(int significant_digits) const {
+#if (NC_HAS_QUANTIZE == 0)
+  if (significant_digits > 0) {
+    throw RuntimeError(PISM_ERROR_LOCATION,
+                       "this PISM build uses a NetCDF library without quantization support");
+  }
+#endif
+  m_quantization_digits = significant_digits;
+}
+
 void NC4_Serial::def_var_impl(const std::string &name,
                               io::Type nctype,
                               const std::vector<std::string> &dims) const {
@@ -75,7 +102,15 @@ void NC4_Serial::def_var_impl(const std::string &name,
     if (m_rank == 0) {
       int varid = get_varid(name);
 
+#if NC_HAS_ZSTD
+      if (m_compression_algorithm == "zstd") {
+        stat = nc_def_var_zstandard(m_file_id, varid, m_compression_level);
+      } else {
+        stat = nc_def_var_deflate(m_file_id, varid, 0, 1, m_compression_level);
+      }
+#else
       stat = nc_def_var_deflate(m_file_id, varid, 0, 1, m_compression_level);
+#endif
 
       // The NetCDF version used by PISM may not support compression.
       if (stat == NC_EINVAL) {
@@ -88,6 +123,24 @@ void NC4_Serial::def_var_impl(const std::string &name,
   MPI_Bcast(&stat, 1, MPI_INT, 0, m_com);
 
   check(PISM_ERROR_LOCATION, stat);
+
+#if NC_HAS_QUANTIZE
+  // Quantize floating-point 2D and 3D variables (lossy: keeps m_quantization_digits
+  // significant decimal digits), making the compression applied above much more
+  // effective.
+  if (m_quantization_digits > 0 and dims.size() > 1 and
+      (nctype == io::PISM_FLOAT or nctype == io::PISM_DOUBLE)) {
+    if (m_rank == 0) {
+      stat = nc_def_var_quantize(m_file_id, get_varid(name), NC_QUANTIZE_BITGROOM,
+                                 m_quantization_digits);
+    }
+
+    MPI_Barrier(m_com);
+    MPI_Bcast(&stat, 1, MPI_INT, 0, m_com);
+
+    check(PISM_ERROR_LOCATION, stat);
+  }
+#endif
 }
 
 } // end of namespace io
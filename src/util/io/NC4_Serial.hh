@@ -33,12 +33,18 @@ public:
 protected:
   void set_compression_level_impl(int level) const;
 
+  void set_compression_algorithm_impl(const std::string &algorithm) const;
+
+  void set_quantization_impl(int significant_digits) const;
+
   void create_impl(const std::string &filename);
 
   void def_var_impl(const std::string &name, io::Type nctype,
                     const std::vector<std::string> &dims) const;
 
   mutable int m_compression_level;
+  mutable std::string m_compression_algorithm;
+  mutable int m_quantization_digits;
 };
 
 } // end of namespace io
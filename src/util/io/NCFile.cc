@@ -44,6 +44,24 @@ void NCFile::set_compression_level(int level) const {
   set_compression_level_impl(level);
 }
 
+void NCFile::set_compression_algorithm(const std::string &algorithm) const {
+  set_compression_algorithm_impl(algorithm);
+}
+
+void NCFile::set_compression_algorithm_impl(const std::string &algorithm) const {
+  (void) algorithm;
+  // the default implementation does nothing
+}
+
+void NCFile::set_quantization(int significant_digits) const {
+  set_quantization_impl(significant_digits);
+}
+
+void NCFile::set_quantization_impl(int significant_digits) const {
+  (void) significant_digits;
+  // the default implementation does nothing
+}
+
 void NCFile::set_compression_level_impl(int level) const {
   (void) level;
   // the default implementation does nothing
@@ -56,17 +74,28 @@ void NCFile::def_var_chunking_impl(const std::string &name,
   // the default implementation does nothing
 }
 
+void NCFile::set_var_chunk_cache_impl(const std::string &name, size_t n_bytes,
+                                      size_t n_slots, double preemption) const {
+  (void) name;
+  (void) n_bytes;
+  (void) n_slots;
+  (void) preemption;
+  // the default implementation does nothing
+}
+
 
 void NCFile::open(const std::string &filename, io::Mode mode) {
   this->open_impl(filename, mode);
   m_filename = filename;
   m_define_mode = false;
+  m_varid_cache.clear();
 }
 
 void NCFile::create(const std::string &filename) {
   this->create_impl(filename);
   m_filename = filename;
   m_define_mode = true;
+  m_varid_cache.clear();
 }
 
 void NCFile::sync() const {
@@ -78,6 +107,7 @@ void NCFile::close() {
   this->close_impl();
   m_filename.clear();
   m_file_id = -1;
+  m_varid_cache.clear();
 }
 
 void NCFile::enddef() const {
@@ -122,6 +152,11 @@ void NCFile::def_var_chunking(const std::string &name,
   this->def_var_chunking_impl(name, dimensions);
 }
 
+void NCFile::set_var_chunk_cache(const std::string &name, size_t n_bytes, size_t n_slots,
+                                 double preemption) const {
+  this->set_var_chunk_cache_impl(name, n_bytes, n_slots, preemption);
+}
+
 
 void NCFile::get_vara_double(const std::string &variable_name,
                             const std::vector<unsigned int> &start,
@@ -19,6 +19,7 @@
 #ifndef PISM_NCFILE_H
 #define PISM_NCFILE_H
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -92,6 +93,9 @@ public:
 
   void def_var_chunking(const std::string &name, std::vector<size_t> &dimensions) const;
 
+  void set_var_chunk_cache(const std::string &name, size_t n_bytes, size_t n_slots,
+                           double preemption) const;
+
   void get_vara_double(const std::string &variable_name, const std::vector<unsigned int> &start,
                        const std::vector<unsigned int> &count, double *ip) const;
 
@@ -117,6 +121,10 @@ public:
 
   void set_compression_level(int level) const;
 
+  void set_compression_algorithm(const std::string &algorithm) const;
+
+  void set_quantization(int significant_digits) const;
+
   // att
   void get_att_double(const std::string &variable_name, const std::string &att_name,
                       std::vector<double> &result) const;
@@ -172,6 +180,9 @@ protected:
   virtual void def_var_chunking_impl(const std::string &name,
                                      std::vector<size_t> &dimensions) const;
 
+  virtual void set_var_chunk_cache_impl(const std::string &name, size_t n_bytes,
+                                        size_t n_slots, double preemption) const;
+
   virtual void get_vara_double_impl(const std::string &variable_name,
                                     const std::vector<unsigned int> &start,
                                     const std::vector<unsigned int> &count, double *ip) const = 0;
@@ -202,6 +213,10 @@ protected:
 
   virtual void set_compression_level_impl(int level) const = 0;
 
+  virtual void set_compression_algorithm_impl(const std::string &algorithm) const;
+
+  virtual void set_quantization_impl(int significant_digits) const;
+
   // att
   virtual void get_att_double_impl(const std::string &variable_name, const std::string &att_name,
                                    std::vector<double> &result) const = 0;
@@ -231,6 +246,14 @@ protected:                      // data members
   MPI_Comm m_com;
   int m_file_id;
   std::string m_filename;
+
+  //! Cached variable name to variable ID mapping, maintained by get_varid() in derived
+  //! classes. NetCDF assigns variable IDs at definition time and never re-numbers them,
+  //! so cached values stay valid until the file is closed; the cache is cleared by
+  //! open(), create() and close(). Looking a variable up by name is a linear scan inside
+  //! NetCDF, which adds up in files with many variables (-extra_file with a long
+  //! -extra_vars list) where every attribute or data access repeats the lookup.
+  mutable std::map<std::string, int> m_varid_cache;
 private:
   mutable bool m_define_mode;
 };
@@ -27,6 +27,7 @@
 #endif
 #include <netcdf.h>
 
+#include <algorithm>            // min, max
 #include <cstdio>               // stderr, fprintf
 
 #include "pism/util/pism_utilities.hh" // join
@@ -278,6 +279,47 @@ void NC_Serial::def_var_impl(const std::string &name, io::Type nctype,
   check(PISM_ERROR_LOCATION, stat);
 }
 
+//! \brief Choose the shape of the blocks used to stream a subdomain to or from rank 0.
+/*!
+ * A subdomain is split along its first dimension with more than one row (`dim`; -1 if
+ * there is no such dimension), `rows_per_block` rows at a time. All dimensions before
+ * `dim` have length 1, so each block is a contiguous part of the subdomain.
+ *
+ * Blocks are bounded in size, so rank 0 never needs to buffer a full subdomain, which at
+ * high grid resolutions may be several gigabytes for 3D variables.
+ *
+ * Rank 0 and the rank that owns a subdomain compute block shapes independently; they
+ * agree because the computation depends on `count` only.
+ */
+static void block_shape(int ndims, const unsigned int *count, int &dim,
+                        unsigned int &rows_per_block, unsigned int &row_size) {
+  // maximum block size, in values (64 MiB of doubles)
+  const unsigned int max_block_size = (64 * 1024 * 1024) / sizeof(double);
+
+  dim = -1;
+  for (int k = 0; k < ndims; ++k) {
+    if (count[k] > 1) {
+      dim = k;
+      break;
+    }
+  }
+
+  // the number of values in one row of the dimension we split along
+  row_size = 1;
+  for (int k = dim + 1; k < ndims; ++k) {
+    row_size *= count[k];
+  }
+
+  if (dim == -1 or row_size == 0) {
+    // nothing to split (at most one value) or a zero-size subdomain: use one block
+    rows_per_block = dim == -1 ? 1 : count[dim];
+    return;
+  }
+
+  rows_per_block = std::max(1u, max_block_size / row_size);
+  rows_per_block = std::min(rows_per_block, count[dim]);
+}
+
 void NC_Serial::get_vara_double_impl(const std::string &variable_name,
                                      const std::vector<unsigned int> &start,
                                      const std::vector<unsigned int> &count, double *op) const {
@@ -285,6 +327,12 @@ void NC_Serial::get_vara_double_impl(const std::string &variable_name,
 }
 
 //! \brief Get variable data.
+/*!
+ * Subdomains are read on rank 0 and sent to the ranks that requested them in bounded
+ * row-block chunks (see block_shape()) instead of a full subdomain at a time. On rank 0
+ * the send of one block overlaps with the nc_get_vara_double() call reading the next
+ * one.
+ */
 void NC_Serial::get_var_double(const std::string &variable_name,
                                const std::vector<unsigned int> &start_input,
                                const std::vector<unsigned int> &count_input,
@@ -292,79 +340,111 @@ void NC_Serial::get_var_double(const std::string &variable_name,
   std::vector<unsigned int> start = start_input;
   std::vector<unsigned int> count = count_input;
 
-  const int start_tag = 1, count_tag = 2, data_tag = 3, chunk_size_tag = 4;
+  const int start_tag = 1, count_tag = 2, data_tag = 3;
   int stat = NC_NOERR, com_size, ndims = static_cast<int>(start.size());
-  MPI_Status mpi_stat;
-  unsigned int local_chunk_size = 1, processor_0_chunk_size = 0;
 
   // get the size of the communicator
   MPI_Comm_size(m_com, &com_size);
 
-  // compute the size of a local chunk
-  for (int k = 0; k < ndims; ++k) {
-    local_chunk_size *= count[k];
-  }
-
-  // compute the maximum and send it to processor 0; this is the size of the
-  // buffer processor 0 will need
-  MPI_Reduce(&local_chunk_size, &processor_0_chunk_size, 1, MPI_UNSIGNED, MPI_MAX, 0, m_com);
-
   // now we need to send start and count data to processor 0 and receive data
   if (m_rank == 0) {
-    std::vector<double> processor_0_buffer;
-    // Note: this could be optimized: if processor_0_chunk_size <=
-    // max(local_chunk_size) we can avoid allocating this buffer. The inner for
-    // loop will have to be re-ordered, though.
-    processor_0_buffer.resize(processor_0_chunk_size);
+    // two send buffers, so that sending one block can overlap with reading the other
+    std::vector<double> buffer[2];
+    MPI_Request requests[2] = { MPI_REQUEST_NULL, MPI_REQUEST_NULL };
 
     // MPI calls below require C datatypes (so that we don't have to worry about sizes of
     // size_t and ptrdiff_t), so we make local copies of start and count to use in the
     // nc_get_vara_double() call.
     std::vector<size_t> nc_start(ndims), nc_count(ndims);
-    int varid;
 
-    stat = nc_inq_varid(m_file_id, variable_name.c_str(), &varid);
+    int varid = get_varid(variable_name);
+    stat      = varid >= NC_GLOBAL ? NC_NOERR : varid;
     check_and_abort(m_com, PISM_ERROR_LOCATION, stat);
 
     for (int r = 0; r < com_size; ++r) {
 
       if (r != 0) {
-        // Note: start, count, and local_chunk_size on processor zero are
-        // used *before* they get overwritten by these calls
-        MPI_Recv(start.data(), ndims, MPI_UNSIGNED, r, start_tag, m_com, &mpi_stat);
-        MPI_Recv(count.data(), ndims, MPI_UNSIGNED, r, count_tag, m_com, &mpi_stat);
-        MPI_Recv(&local_chunk_size, 1, MPI_UNSIGNED, r, chunk_size_tag, m_com, &mpi_stat);
+        // Note: start and count on processor zero are used *before* they get overwritten
+        // by these calls
+        MPI_Recv(start.data(), ndims, MPI_UNSIGNED, r, start_tag, m_com, MPI_STATUS_IGNORE);
+        MPI_Recv(count.data(), ndims, MPI_UNSIGNED, r, count_tag, m_com, MPI_STATUS_IGNORE);
       }
 
-      // This for loop uses start and count passed in as arguments when r == 0. For r > 0
-      // they are overwritten by MPI_Recv calls above.
-      for (int k = 0; k < ndims; ++k) {
-        nc_start[k]  = start[k];
-        nc_count[k]  = count[k];
-      }
+      int dim = -1;
+      unsigned int rows_per_block = 0, row_size = 0;
+      block_shape(ndims, count.data(), dim, rows_per_block, row_size);
 
-      stat = nc_get_vara_double(m_file_id, varid, nc_start.data(), nc_count.data(),
-                                processor_0_buffer.data());
-      check(PISM_ERROR_LOCATION, stat);
+      unsigned int n_rows = dim >= 0 ? count[dim] : 1;
 
       if (r != 0) {
-        MPI_Send(processor_0_buffer.data(), (int)local_chunk_size, MPI_DOUBLE, r, data_tag, m_com);
-      } else {
-        for (unsigned int k = 0; k < local_chunk_size; ++k) {
-          ip[k] = processor_0_buffer[k];
-        }
+        buffer[0].resize(rows_per_block * row_size);
+        buffer[1].resize(rows_per_block * row_size);
       }
+
+      for (unsigned int row = 0, b = 0; row < n_rows; row += rows_per_block, ++b) {
+        unsigned int block_rows = std::min(rows_per_block, n_rows - row);
+        unsigned int block_size = block_rows * row_size;
+
+        double *block_data = NULL;
+        if (r != 0) {
+          // make sure the send re-using this buffer is complete
+          MPI_Wait(&requests[b % 2], MPI_STATUS_IGNORE);
+          block_data = buffer[b % 2].data();
+        } else {
+          // rank 0 reads its own subdomain directly, without buffering
+          block_data = ip + (size_t)row * row_size;
+        }
+
+        // This uses start and count passed in as arguments when r == 0. For r > 0 they
+        // are overwritten by MPI_Recv calls above.
+        for (int k = 0; k < ndims; ++k) {
+          nc_start[k] = start[k];
+          nc_count[k] = count[k];
+        }
+        if (dim >= 0) {
+          nc_start[dim] = start[dim] + row;
+          nc_count[dim] = block_rows;
+        }
+
+        stat = nc_get_vara_double(m_file_id, varid, nc_start.data(), nc_count.data(),
+                                  block_data);
+        check(PISM_ERROR_LOCATION, stat);
+
+        if (r != 0) {
+          MPI_Isend(block_data, (int)block_size, MPI_DOUBLE, r, data_tag, m_com,
+                    &requests[b % 2]);
+        }
+      } // end of the loop over blocks
+
+      // wait for the sends to complete before re-sizing buffers for the next rank
+      MPI_Waitall(2, requests, MPI_STATUSES_IGNORE);
     } // end of the for loop
 
   } else {
     MPI_Send(start.data(), ndims, MPI_UNSIGNED, 0, start_tag, m_com);
     MPI_Send(count.data(), ndims, MPI_UNSIGNED, 0, count_tag, m_com);
-    MPI_Send(&local_chunk_size, 1, MPI_UNSIGNED, 0, chunk_size_tag, m_com);
 
-    MPI_Recv(ip, (int)local_chunk_size, MPI_DOUBLE, 0, data_tag, m_com, &mpi_stat);
+    int dim = -1;
+    unsigned int rows_per_block = 0, row_size = 0;
+    block_shape(ndims, count.data(), dim, rows_per_block, row_size);
+
+    unsigned int n_rows = dim >= 0 ? count[dim] : 1;
+
+    for (unsigned int row = 0; row < n_rows; row += rows_per_block) {
+      unsigned int block_size = std::min(rows_per_block, n_rows - row) * row_size;
+
+      MPI_Recv(ip + (size_t)row * row_size, (int)block_size, MPI_DOUBLE, 0, data_tag, m_com,
+               MPI_STATUS_IGNORE);
+    }
   }
 }
 
+//! \brief Write variable data.
+/*!
+ * Subdomains are gathered on rank 0 and written there in bounded row-block chunks (see
+ * block_shape()) instead of a full subdomain at a time. On rank 0 the receive of the
+ * next block overlaps with the nc_put_vara_double() call writing the current one.
+ */
 void NC_Serial::put_vara_double_impl(const std::string &variable_name,
                                      const std::vector<unsigned int> &start_input,
                                      const std::vector<unsigned int> &count_input,
@@ -374,72 +454,105 @@ void NC_Serial::put_vara_double_impl(const std::string &variable_name,
   std::vector<unsigned int> count = count_input;
   const int start_tag = 1, count_tag = 2, data_tag = 3;
   int stat = NC_NOERR, com_size = 0, ndims = static_cast<int>(start.size());
-  int local_chunk_size = 1, processor_0_chunk_size = 0;
 
   // get the size of the communicator
   MPI_Comm_size(m_com, &com_size);
 
-  // compute the size of a local chunk
-  for (int k = 0; k < ndims; ++k) {
-    local_chunk_size *= (int)count[k];
-  }
-
-  // compute the maximum and send it to processor 0; this is the size of the
-  // buffer processor 0 will need
-  MPI_Reduce(&local_chunk_size, &processor_0_chunk_size, 1, MPI_INT, MPI_MAX, 0, m_com);
-
   // now we need to send start and count data to processor 0 and receive data
   if (m_rank == 0) {
-    std::vector<double> processor_0_buffer;
-    processor_0_buffer.resize(processor_0_chunk_size);
+    // two receive buffers, so that receiving one block can overlap with writing the other
+    std::vector<double> buffer[2];
 
-    int varid;
-
-    stat = nc_inq_varid(m_file_id, variable_name.c_str(), &varid);
+    int varid = get_varid(variable_name);
+    stat      = varid >= NC_GLOBAL ? NC_NOERR : varid;
     check_and_abort(m_com, PISM_ERROR_LOCATION, stat);
 
+    // MPI_Send/Recv calls require C datatypes, so we make local copies of start and
+    // count to use in the nc_put_vara_double() call so that we don't have to worry
+    // about sizes of size_t and ptrdiff_t.
+    std::vector<size_t> nc_start(ndims), nc_count(ndims);
+
     for (int r = 0; r < com_size; ++r) {
 
       if (r != 0) {
-        // Note: start, count, and local_chunk_size on processor zero are used *before*
-        // they get overwritten by these calls
+        // Note: start and count on processor zero are used *before* they get overwritten
+        // by these calls
         MPI_Recv(start.data(), ndims, MPI_UNSIGNED, r, start_tag, m_com, MPI_STATUS_IGNORE);
         MPI_Recv(count.data(), ndims, MPI_UNSIGNED, r, count_tag, m_com, MPI_STATUS_IGNORE);
+      }
 
-        // get the size of the array sent by rank `r`:
-        MPI_Status mpi_stat;
-        MPI_Probe(r, data_tag, m_com, &mpi_stat);
-        MPI_Get_count(&mpi_stat, MPI_DOUBLE, &local_chunk_size);
+      int dim = -1;
+      unsigned int rows_per_block = 0, row_size = 0;
+      block_shape(ndims, count.data(), dim, rows_per_block, row_size);
 
-        MPI_Recv(processor_0_buffer.data(), local_chunk_size, MPI_DOUBLE, r, data_tag, m_com,
-                 MPI_STATUS_IGNORE);
-      } else {
-        for (int k = 0; k < local_chunk_size; ++k) {
-          processor_0_buffer[k] = op[k];
-        }
-      }
+      unsigned int n_rows = dim >= 0 ? count[dim] : 1;
 
-      // MPI_Send/Recv calls require C datatypes, so we make local copies of start and
-      // count to use in the nc_get_vara_double() call so that we don't have to worry
-      // about sizes of size_t and ptrdiff_t.
-      //
-      // This for loop uses start and count passed in as arguments when r == 0. For r > 0
-      // they are overwritten by MPI_Recv calls above.
-      std::vector<size_t> nc_start(ndims), nc_count(ndims);
-      for (int k = 0; k < ndims; ++k) {
-        nc_start[k]  = start[k];
-        nc_count[k]  = count[k];
+      if (r != 0) {
+        buffer[0].resize(rows_per_block * row_size);
+        buffer[1].resize(rows_per_block * row_size);
       }
 
-      stat = nc_put_vara_double(m_file_id, varid, nc_start.data(), nc_count.data(),
-                                processor_0_buffer.data());
-      check(PISM_ERROR_LOCATION, stat);
+      MPI_Request request = MPI_REQUEST_NULL;
+
+      for (unsigned int row = 0, b = 0; row < n_rows; row += rows_per_block, ++b) {
+        unsigned int block_rows = std::min(rows_per_block, n_rows - row);
+        unsigned int block_size = block_rows * row_size;
+
+        const double *block_data = NULL;
+        if (r != 0) {
+          if (row == 0) {
+            MPI_Recv(buffer[b % 2].data(), (int)block_size, MPI_DOUBLE, r, data_tag, m_com,
+                     MPI_STATUS_IGNORE);
+          } else {
+            MPI_Wait(&request, MPI_STATUS_IGNORE);
+          }
+
+          // post the receive of the next block before writing the current one
+          if (row + block_rows < n_rows) {
+            unsigned int next_size =
+                std::min(rows_per_block, n_rows - (row + block_rows)) * row_size;
+            MPI_Irecv(buffer[(b + 1) % 2].data(), (int)next_size, MPI_DOUBLE, r, data_tag,
+                      m_com, &request);
+          }
+
+          block_data = buffer[b % 2].data();
+        } else {
+          // rank 0 writes its own subdomain directly, without buffering
+          block_data = op + (size_t)row * row_size;
+        }
+
+        // This uses start and count passed in as arguments when r == 0. For r > 0 they
+        // are overwritten by MPI_Recv calls above.
+        for (int k = 0; k < ndims; ++k) {
+          nc_start[k] = start[k];
+          nc_count[k] = count[k];
+        }
+        if (dim >= 0) {
+          nc_start[dim] = start[dim] + row;
+          nc_count[dim] = block_rows;
+        }
+
+        stat = nc_put_vara_double(m_file_id, varid, nc_start.data(), nc_count.data(),
+                                  block_data);
+        check(PISM_ERROR_LOCATION, stat);
+      } // end of the loop over blocks
     } // end of the for loop
   } else {
     MPI_Send(start.data(), ndims, MPI_UNSIGNED, 0, start_tag, m_com);
     MPI_Send(count.data(), ndims, MPI_UNSIGNED, 0, count_tag, m_com);
 
-    MPI_Send(const_cast<double *>(op), local_chunk_size, MPI_DOUBLE, 0, data_tag, m_com);
+    int dim = -1;
+    unsigned int rows_per_block = 0, row_size = 0;
+    block_shape(ndims, count.data(), dim, rows_per_block, row_size);
+
+    unsigned int n_rows = dim >= 0 ? count[dim] : 1;
+
+    for (unsigned int row = 0; row < n_rows; row += rows_per_block) {
+      unsigned int block_size = std::min(rows_per_block, n_rows - row) * row_size;
+
+      MPI_Send(const_cast<double *>(op) + (size_t)row * row_size, (int)block_size,
+               MPI_DOUBLE, 0, data_tag, m_com);
+    }
   }
 }
 
@@ -494,7 +607,8 @@ void NC_Serial::inq_vardimid_impl(const std::string &variable_name,
   std::vector<int> dimids;
 
   if (m_rank == 0) {
-    stat = nc_inq_varid(m_file_id, variable_name.c_str(), &varid);
+    varid = get_varid(variable_name);
+    stat  = varid >= NC_GLOBAL ? NC_NOERR : varid;
 
     if (stat == NC_NOERR) {
       stat = nc_inq_varndims(m_file_id, varid, &ndims);
@@ -569,9 +683,13 @@ void NC_Serial::inq_varid_impl(const std::string &variable_name, bool &exists) c
   int stat, flag = -1;
 
   if (m_rank == 0) {
-    stat = nc_inq_varid(m_file_id, variable_name.c_str(), &flag);
+    if (m_varid_cache.find(variable_name) != m_varid_cache.end()) {
+      flag = 1;
+    } else {
+      stat = nc_inq_varid(m_file_id, variable_name.c_str(), &flag);
 
-    flag = (stat == NC_NOERR) ? 1 : 0;
+      flag = (stat == NC_NOERR) ? 1 : 0;
+    }
   }
   MPI_Barrier(m_com);
   MPI_Bcast(&flag, 1, MPI_INT, 0, m_com);
@@ -923,10 +1041,16 @@ int NC_Serial::get_varid(const std::string &variable_name) const {
   }
 
   if (m_rank == 0) {
+    auto cached = m_varid_cache.find(variable_name);
+    if (cached != m_varid_cache.end()) {
+      return cached->second;
+    }
+
     int varid = -2;
     int stat  = nc_inq_varid(m_file_id, variable_name.c_str(), &varid);
 
     if (stat == NC_NOERR) {
+      m_varid_cache[variable_name] = varid;
       return varid;
     }
 
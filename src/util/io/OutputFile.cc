@@ -95,4 +95,21 @@ const std::string &OutputFile::name() const {
   return m_file_name;
 }
 
+//! Enable incremental writing of model state arrays.
+/*!
+ * `counters` maps variable names to Array state counter values recorded when these
+ * arrays were last written to this file. Array::write() uses (and updates) this map to
+ * skip arrays that did not change since then; see output.checkpoint.incremental.
+ */
+void OutputFile::set_state_counters(
+    const std::shared_ptr<std::map<std::string, int> > &counters) {
+  m_state_counters = counters;
+}
+
+//! State counters set using set_state_counters(); NULL if incremental writing is not
+//! requested.
+const std::shared_ptr<std::map<std::string, int> > &OutputFile::state_counters() const {
+  return m_state_counters;
+}
+
 } // namespace pism
@@ -423,6 +423,14 @@ void OutputWriter::close(const std::string &file_name) {
   close_impl(file_name);
 }
 
+void OutputWriter::flush() {
+  flush_impl();
+}
+
+void OutputWriter::flush_impl() {
+  // no-op: synchronous implementations have nothing to wait for
+}
+
 unsigned int OutputWriter::time_dimension_length(const std::string &file_name) {
   return time_dimension_length_impl(file_name);
 }
@@ -212,6 +212,14 @@ public:
    */
   void close(const std::string &file_name);
 
+  /*!
+   * Wait until all previously requested operations (for all files) are complete.
+   *
+   * A no-op for synchronous implementations. Asynchronous implementations block until
+   * their queues drain, re-throwing errors reported by the writer thread.
+   */
+  void flush();
+
   /*!
    * Return the length of the time dimension (possibly cached to avoid reading from the
    * file or communication).
@@ -389,6 +397,12 @@ protected:
    */
   virtual void close_impl(const std::string &file_name) = 0;
 
+  /*!
+   * Implementation of flush(). Synchronous implementations have nothing to wait for, so
+   * the default implementation is a no-op.
+   */
+  virtual void flush_impl();
+
   const std::string &experiment_id() const;
 
   /*!
@@ -448,9 +462,18 @@ public:
 
   const std::string &name() const;
 
+  void set_state_counters(const std::shared_ptr<std::map<std::string, int> > &counters);
+
+  const std::shared_ptr<std::map<std::string, int> > &state_counters() const;
+
 private:
   std::string m_file_name;
   std::shared_ptr<OutputWriter> m_writer;
+
+  //! Array state counters recorded when arrays were last written to this file; see
+  //! set_state_counters() and Array::write(). NULL unless incremental writing is
+  //! requested.
+  std::shared_ptr<std::map<std::string, int> > m_state_counters;
 };
 
 } // namespace pism
@@ -16,6 +16,7 @@
 // along with PISM; if not, write to the Free Software
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
+#include <algorithm>            // max
 #include <pnetcdf.h>
 #include <sstream>
 #include <cstring>              // memset
@@ -31,7 +32,7 @@ namespace pism {
 namespace io {
 
 PNCFile::PNCFile(MPI_Comm c)
-  : NCFile(c) {
+  : NCFile(c), m_record_count(0) {
   MPI_Info_create(&m_mpi_info);
 }
 
@@ -68,6 +69,7 @@ void PNCFile::create_impl(const std::string &fname) {
 }
 
 void PNCFile::sync_impl() const {
+  flush_writes();
 
   int stat = ncmpi_sync(m_file_id);
   check(PISM_ERROR_LOCATION, stat);
@@ -75,6 +77,8 @@ void PNCFile::sync_impl() const {
 
 
 void PNCFile::close_impl() {
+  flush_writes();
+
   int stat = ncmpi_close(m_file_id);
   check(PISM_ERROR_LOCATION, stat);
 
@@ -90,6 +94,8 @@ void PNCFile::enddef_impl() const {
 
 
 void PNCFile::redef_impl() const {
+  // Pending writes have to be flushed before entering define mode.
+  flush_writes();
 
   int stat = ncmpi_redef(m_file_id);
   check(PISM_ERROR_LOCATION, stat);
@@ -128,6 +134,19 @@ void PNCFile::inq_dimlen_impl(const std::string &dimension_name, unsigned int &r
   check(PISM_ERROR_LOCATION, stat);
 
   result = static_cast<unsigned int>(len);
+
+  // Account for records appended by pending nonblocking writes (see
+  // put_vara_double_impl()): the on-disk length of the record dimension is updated when
+  // these writes are flushed.
+  if (m_record_count > len) {
+    int unlimdimid = -1;
+    stat = ncmpi_inq_unlimdim(m_file_id, &unlimdimid);
+    check(PISM_ERROR_LOCATION, stat);
+
+    if (dimid == unlimdimid) {
+      result = static_cast<unsigned int>(m_record_count);
+    }
+  }
 }
 
 
@@ -173,6 +192,14 @@ void PNCFile::get_vara_double_impl(const std::string &variable_name,
 }
 
 
+//! Write an array, queuing the write instead of performing it right away.
+/*!
+ * Queued writes are performed (and the queue is emptied) by flush_writes(), which is
+ * called by sync_impl(), close_impl(), redef_impl() and get_var_double(). This way all
+ * the variables of one output record are usually written by one ncmpi_wait_all() call
+ * instead of one blocking collective write per variable, which is significantly faster
+ * for files containing many 2D fields.
+ */
 void PNCFile::put_vara_double_impl(const std::string &variable_name,
                                    const std::vector<unsigned int> &start,
                                    const std::vector<unsigned int> &count, const double *op) const {
@@ -183,13 +210,45 @@ void PNCFile::put_vara_double_impl(const std::string &variable_name,
   stat = ncmpi_inq_varid(m_file_id, variable_name.c_str(), &varid);
   check(PISM_ERROR_LOCATION, stat);
 
+  size_t size = 1;
   for (int j = 0; j < ndims; ++j) {
     nc_start[j]  = start[j];
     nc_count[j]  = count[j];
+    size *= count[j];
+  }
+
+  if (size == 0) {
+    // Nothing to write. Note: ncmpi_iput_vara_double() is not collective, so it is safe
+    // to return here even if some other ranks do have data to write.
+    return;
   }
 
-  stat = ncmpi_put_vara_double_all(m_file_id, varid, nc_start.data(), nc_count.data(), op);
+  // PnetCDF reads from the provided buffer when the write is flushed, so we have to keep
+  // a copy:
+  m_buffers.push_back(std::vector<double>(op, op + size));
+
+  int request = NC_REQ_NULL;
+  stat = ncmpi_iput_vara_double(m_file_id, varid, nc_start.data(), nc_count.data(),
+                                m_buffers.back().data(), &request);
   check(PISM_ERROR_LOCATION, stat);
+
+  m_requests.push_back(request);
+
+  // If this is a record variable, keep track of the number of records in the file,
+  // including the ones to be appended by pending writes (see inq_dimlen_impl()):
+  if (ndims > 0) {
+    int unlimdimid = -1;
+    stat = ncmpi_inq_unlimdim(m_file_id, &unlimdimid);
+    check(PISM_ERROR_LOCATION, stat);
+
+    std::vector<int> dimids(ndims);
+    stat = ncmpi_inq_vardimid(m_file_id, varid, dimids.data());
+    check(PISM_ERROR_LOCATION, stat);
+
+    if (unlimdimid != -1 and dimids[0] == unlimdimid) {
+      m_record_count = std::max(m_record_count, nc_start[0] + nc_count[0]);
+    }
+  }
 }
 
 void PNCFile::put_vara_text_impl(const std::string &variable_name,
@@ -258,10 +317,17 @@ int PNCFile::get_varid(const std::string &variable_name) const {
     return NC_GLOBAL;
   }
 
+  auto cached = m_varid_cache.find(variable_name);
+  if (cached != m_varid_cache.end()) {
+    return cached->second;
+  }
+
   int varid = -1;
   int stat  = ncmpi_inq_varid(m_file_id, variable_name.c_str(), &varid);
   check(PISM_ERROR_LOCATION, stat);
 
+  m_varid_cache[variable_name] = varid;
+
   return varid;
 }
 
@@ -273,6 +339,11 @@ void PNCFile::inq_varnatts_impl(const std::string &variable_name, int &result) c
 
 
 void PNCFile::inq_varid_impl(const std::string &variable_name, bool &exists) const {
+  if (m_varid_cache.find(variable_name) != m_varid_cache.end()) {
+    exists = true;
+    return;
+  }
+
   int stat, flag = -1;
 
   stat = ncmpi_inq_varid(m_file_id, variable_name.c_str(), &flag);
@@ -415,6 +486,9 @@ void PNCFile::set_fill_impl(int fillmode, int &old_modep) const {
 void PNCFile::get_var_double(const std::string &variable_name,
                              const std::vector<unsigned int> &start,
                              const std::vector<unsigned int> &count, double *ip) const {
+  // ensure read-after-write consistency
+  flush_writes();
+
   int stat, varid, ndims = static_cast<int>(start.size());
 
   std::vector<MPI_Offset> nc_start(ndims), nc_count(ndims);
@@ -454,6 +528,27 @@ void PNCFile::init_hints() {
   }
 }
 
+//! Perform all pending (queued) writes; see put_vara_double_impl().
+void PNCFile::flush_writes() const {
+  int n_requests = static_cast<int>(m_requests.size());
+
+  // allocate at least one element so that statuses.data() is not NULL
+  std::vector<int> statuses(n_requests + 1, NC_NOERR);
+
+  // Note: ncmpi_wait_all() is collective, so we cannot skip this call on ranks that have
+  // no pending writes.
+  int stat = ncmpi_wait_all(m_file_id, n_requests, m_requests.data(), statuses.data());
+  check(PISM_ERROR_LOCATION, stat);
+
+  for (int j = 0; j < n_requests; ++j) {
+    check(PISM_ERROR_LOCATION, statuses[j]);
+  }
+
+  m_requests.clear();
+  m_buffers.clear();
+  m_record_count = 0;
+}
+
 void PNCFile::set_compression_level_impl(int level) const {
   (void) level;
   // NetCDF-3 does not support compression.
@@ -19,6 +19,8 @@
 #ifndef _PISMPNCFILE_H_
 #define _PISMPNCFILE_H_
 
+#include <deque>
+
 #include "pism/util/io/NCFile.hh"
 
 namespace pism {
@@ -121,7 +123,20 @@ private:
 
   int get_varid(const std::string &variable_name) const;
 
+  void flush_writes() const;
+
   MPI_Info m_mpi_info;            // MPI hints
+
+  //! Pending nonblocking write requests; see put_vara_double_impl().
+  mutable std::vector<int> m_requests;
+
+  //! Copies of data to be written by pending requests. We use a std::deque because
+  //! adding an element must not move existing elements: PnetCDF reads from these buffers
+  //! when flush_writes() is called.
+  mutable std::deque<std::vector<double> > m_buffers;
+
+  //! The length of the record dimension, including pending writes.
+  mutable MPI_Offset m_record_count;
 };
 
 } // end of namespace io
@@ -0,0 +1,381 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <algorithm> // std::max
+#include <cstddef>   // size_t
+#include <mpi.h>
+
+#include "pism/util/Config.hh"
+#include "pism/util/GridInfo.hh"
+#include "pism/util/VariableMetadata.hh"
+#include "pism/util/error_handling.hh"
+#include "pism/util/io/IO_Flags.hh"
+#include "pism/util/io/ServerOutputWriter.hh"
+#include "pism/util/io/output_server.hh"
+
+namespace pism {
+
+/*!
+ * Store variable attributes from `attributes` in a JSON object `output`.
+ *
+ * The output server tells text attributes and numeric attributes apart using JSON types.
+ */
+static void attributes_to_json(const std::map<std::string, std::string> &strings,
+                               const std::map<std::string, std::vector<double> > &numbers,
+                               nlohmann::json &output) {
+  for (const auto &attribute : strings) {
+    output[attribute.first] = attribute.second;
+  }
+
+  for (const auto &attribute : numbers) {
+    output[attribute.first] = attribute.second;
+  }
+}
+
+ServerOutputWriter::ServerOutputWriter(MPI_Comm comm, const Config &config)
+    : OutputWriter(comm, config) {
+
+  set_is_async(true);
+
+  {
+    int rank = -1;
+    MPI_Comm_rank(comm, &rank);
+    m_leader = (rank == 0);
+  }
+
+  // tell all server ranks which I/O backend to use
+  nlohmann::json info;
+  info["format"]                = config.get_string("output.format");
+  info["compression_level"]     = (int)config.get_number("output.compression_level");
+  info["compression_algorithm"] = config.get_string("output.compression_algorithm");
+  info["quantization_digits"]   = (int)config.get_number("output.quantization_digits");
+  info["time_name"]             = config.get_string("time.dimension_name");
+
+  int world_size = 0;
+  MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+  for (int server = world_size - io::output_server_size(); server < world_size; ++server) {
+    send_action(io::CONFIGURE, info, server);
+  }
+}
+
+ServerOutputWriter::~ServerOutputWriter() {
+  // tell all server ranks to close their files and stop
+  int world_size = 0;
+  MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+  for (int server = world_size - io::output_server_size(); server < world_size; ++server) {
+    send_action(io::FINISH, {}, server);
+  }
+
+  try {
+    waitall();
+  } catch (RuntimeError &e) {
+    // ignore failures: we should not let exceptions escape a destructor
+  }
+}
+
+void ServerOutputWriter::send_action(int action, const nlohmann::json &info, int server) {
+  // Only the leader process sends actions to the server
+  if (not m_leader) {
+    return;
+  }
+
+  nlohmann::json message;
+  message["action"] = action;
+  message["info"]   = info;
+
+  m_text_buffers.push_back(message.dump());
+  const auto &message_string = m_text_buffers.back();
+
+  m_mpi_requests.emplace_back();
+  MPI_Isend((void *)message_string.data(), (int)message_string.length(), MPI_CHAR, server,
+            io::ACTION_TAG, MPI_COMM_WORLD, &m_mpi_requests.back());
+}
+
+void ServerOutputWriter::waitall() {
+  int error_code =
+      MPI_Waitall((int)m_mpi_requests.size(), m_mpi_requests.data(), MPI_STATUSES_IGNORE);
+  if (error_code != MPI_SUCCESS) {
+    throw RuntimeError::formatted(PISM_ERROR_LOCATION, "Fatal error in MPI_Waitall()");
+  }
+
+  m_mpi_requests.clear();
+  m_text_buffers.clear();
+  m_header_buffers.clear();
+  m_data_buffers.clear();
+}
+
+void ServerOutputWriter::initialize_impl(const std::set<VariableMetadata> & /*array_variables*/) {
+  // empty: the server receives explicit start and count arrays with every patch, so no
+  // grid setup is needed
+}
+
+void ServerOutputWriter::define_dimension_impl(const std::string &file_name,
+                                               const std::string &name, unsigned int length) {
+  // If this dimension has been defined already for this file, return
+  if (m_defined_dimension[file_name][name]) {
+    return;
+  }
+
+  {
+    nlohmann::json info;
+    info["file_name"] = file_name;
+    info["name"]      = name;
+    info["length"]    = length;
+    send_action(io::DEFINE_DIMENSION, info, io::output_server_rank(file_name));
+  }
+
+  m_defined_dimension[file_name][name] = true;
+}
+
+void ServerOutputWriter::define_variable_impl(const std::string &file_name,
+                                              const std::string &variable_name,
+                                              const std::vector<std::string> &dims, io::Type type,
+                                              const VariableAttributes &attributes) {
+  // If this variable was already defined for this file, return
+  if (m_defined_variable[file_name][variable_name]) {
+    return;
+  }
+
+  {
+    nlohmann::json info, nc_attributes;
+    attributes_to_json(attributes.strings, attributes.numbers, nc_attributes);
+    info["attributes"]    = nc_attributes;
+    info["dimensions"]    = dims;
+    info["type"]          = (int)type;
+    info["file_name"]     = file_name;
+    info["variable_name"] = variable_name;
+
+    send_action(io::DEFINE_VARIABLE, info, io::output_server_rank(file_name));
+  }
+
+  m_defined_variable[file_name][variable_name] = true;
+}
+
+void ServerOutputWriter::set_global_attributes_impl(
+    const std::string &file_name, const std::map<std::string, std::string> &strings,
+    const std::map<std::string, std::vector<double> > &numbers) {
+
+  nlohmann::json info, attributes;
+  attributes_to_json(strings, numbers, attributes);
+  info["file_name"]  = file_name;
+  info["attributes"] = attributes;
+
+  send_action(io::SET_FILE_ATTRIBUTES, info, io::output_server_rank(file_name));
+}
+
+void ServerOutputWriter::append_time_impl(const std::string &file_name, double time_seconds) {
+  // Note: these values are updated *without* communication with the output server.
+  unsigned int t_length = m_time_length[file_name];
+
+  write_array_impl(file_name, time_name(), { t_length }, { 1 }, &time_seconds);
+
+  m_time_length[file_name] = t_length + 1;
+  m_last_time[file_name]   = time_seconds;
+}
+
+void ServerOutputWriter::append_history_impl(const std::string &file_name,
+                                             const std::string &text) {
+  nlohmann::json info;
+  info["file_name"] = file_name;
+  info["history"]   = text;
+  send_action(io::APPEND_HISTORY, info, io::output_server_rank(file_name));
+}
+
+void ServerOutputWriter::append_impl(const std::string &file_name) {
+  nlohmann::json info;
+  info["file_name"] = file_name;
+  send_action(io::APPEND_FILE, info, io::output_server_rank(file_name));
+
+  // get file information from the output server
+  unsigned int time_length = 0;
+  double last_time         = 0.0;
+  if (m_leader) {
+    MPI_Status status;
+    int t_length = -1;
+    MPI_Recv(&t_length, 1, MPI_INT, io::output_server_rank(file_name), io::ACTION_TAG,
+             MPI_COMM_WORLD, &status);
+    MPI_Recv(&last_time, 1, MPI_DOUBLE, io::output_server_rank(file_name), io::ACTION_TAG,
+             MPI_COMM_WORLD, &status);
+    time_length = (unsigned int)t_length;
+  }
+
+  // scatter to other ranks in `comm()`:
+  MPI_Bcast(&time_length, 1, MPI_UNSIGNED, 0, comm());
+  MPI_Bcast(&last_time, 1, MPI_DOUBLE, 0, comm());
+
+  m_time_length[file_name] = time_length;
+  m_last_time[file_name]   = last_time;
+}
+
+unsigned int ServerOutputWriter::time_dimension_length_impl(const std::string &file_name) {
+  return m_time_length[file_name];
+}
+
+double ServerOutputWriter::last_time_value_impl(const std::string &file_name) {
+  return m_last_time[file_name];
+}
+
+void ServerOutputWriter::write_array_impl(const std::string &file_name,
+                                          const std::string &variable_name,
+                                          const std::vector<unsigned int> &start,
+                                          const std::vector<unsigned int> &count,
+                                          const double *data) {
+  nlohmann::json info;
+  info["file_name"]     = file_name;
+  info["variable_name"] = variable_name;
+  info["start"]         = start;
+  info["count"]         = count;
+
+  int server = io::output_server_rank(file_name);
+
+  send_action(io::WRITE_VARIABLE, info, server);
+
+  // Non-gridded variables are sent by the leader process
+  if (m_leader) {
+    size_t size = 1;
+    for (auto c : count) {
+      size *= c;
+    }
+
+    m_data_buffers.push_back(std::vector<double>(data, data + size));
+    m_mpi_requests.emplace_back();
+    MPI_Isend((void *)m_data_buffers.back().data(), (int)size, MPI_DOUBLE, server, io::DATA_TAG,
+              MPI_COMM_WORLD, &m_mpi_requests.back());
+  }
+}
+
+void ServerOutputWriter::write_text_impl(const std::string &file_name,
+                                         const std::string &variable_name,
+                                         const std::vector<unsigned int> &start,
+                                         const std::vector<unsigned int> &count,
+                                         const std::string &input) {
+  // info["text"] = true indicates that this is a text variable and data should be
+  // received using the MPI_CHAR type instead of MPI_DOUBLE
+  nlohmann::json info;
+  info["file_name"]     = file_name;
+  info["variable_name"] = variable_name;
+  info["start"]         = start;
+  info["count"]         = count;
+  info["text"]          = true;
+
+  int server = io::output_server_rank(file_name);
+
+  send_action(io::WRITE_VARIABLE, info, server);
+
+  // Text variables are sent by the leader process
+  if (m_leader) {
+    size_t size = 1;
+    for (auto c : count) {
+      size *= c;
+    }
+
+    // Note: `size` may exceed input.size() by one (a terminating zero byte);
+    // std::string::data() is guaranteed to be null-terminated.
+    m_text_buffers.push_back(input);
+    m_mpi_requests.emplace_back();
+    MPI_Isend((void *)m_text_buffers.back().data(), (int)size, MPI_CHAR, server, io::DATA_TAG,
+              MPI_COMM_WORLD, &m_mpi_requests.back());
+  }
+}
+
+void ServerOutputWriter::write_distributed_array_impl(const std::string &file_name,
+                                                      const std::string &variable_name,
+                                                      const double *data) {
+  const auto &metadata = variable_info(variable_name);
+
+  if (metadata.grid_info() == nullptr) {
+    throw RuntimeError::formatted(PISM_ERROR_LOCATION, "variable '%s' has no grid info",
+                                  variable_name.c_str());
+  }
+
+  const auto &grid = *metadata.grid_info();
+
+  unsigned int n_levels = std::max(metadata.levels().size(), (std::size_t)1);
+
+  // Compute the start and count of the local patch. The length of the time dimension
+  // comes from the cache maintained by this class: the file on disk may be several
+  // records behind.
+  std::vector<unsigned int> start = { grid.ys, grid.xs, 0 };
+  std::vector<unsigned int> count = { grid.ym, grid.xm, n_levels };
+
+  if (metadata.get_time_dependent()) {
+    auto t_length = time_dimension_length(file_name);
+    auto t_start  = t_length > 0 ? t_length - 1 : 0;
+
+    start.insert(start.cbegin(), t_start);
+    count.insert(count.cbegin(), 1);
+  }
+
+  if (not experiment_id().empty()) {
+    start.insert(start.cbegin(), 0);
+    count.insert(count.cbegin(), 1);
+  }
+
+  int server = io::output_server_rank(file_name);
+
+  {
+    nlohmann::json info;
+    info["file_name"]     = file_name;
+    info["variable_name"] = variable_name;
+    send_action(io::WRITE_GRIDDED, info, server);
+  }
+
+  // *Every* computational rank sends the start and count of its patch followed by the
+  // data.
+  {
+    std::vector<unsigned int> header = start;
+    header.insert(header.end(), count.begin(), count.end());
+
+    m_header_buffers.push_back(header);
+    m_mpi_requests.emplace_back();
+    MPI_Isend((void *)m_header_buffers.back().data(), (int)header.size(), MPI_UNSIGNED, server,
+              io::DATA_TAG, MPI_COMM_WORLD, &m_mpi_requests.back());
+  }
+
+  {
+    size_t size = (size_t)grid.ym * (size_t)grid.xm * (size_t)n_levels;
+
+    m_data_buffers.push_back(std::vector<double>(data, data + size));
+    m_mpi_requests.emplace_back();
+    MPI_Isend((void *)m_data_buffers.back().data(), (int)size, MPI_DOUBLE, server, io::DATA_TAG,
+              MPI_COMM_WORLD, &m_mpi_requests.back());
+  }
+}
+
+void ServerOutputWriter::sync_impl(const std::string &file_name) {
+  nlohmann::json info;
+  info["file_name"] = file_name;
+  send_action(io::SYNC_FILE, info, io::output_server_rank(file_name));
+
+  waitall();
+}
+
+void ServerOutputWriter::close_impl(const std::string &file_name) {
+  nlohmann::json info;
+  info["file_name"] = file_name;
+  send_action(io::CLOSE_FILE, info, io::output_server_rank(file_name));
+
+  // If this file is re-created later it has to be set up from scratch.
+  m_time_length.erase(file_name);
+  m_last_time.erase(file_name);
+  m_defined_variable.erase(file_name);
+  m_defined_dimension.erase(file_name);
+}
+
+} // namespace pism
@@ -0,0 +1,133 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef PISM_SERVEROUTPUTWRITER_H
+#define PISM_SERVEROUTPUTWRITER_H
+
+#include <deque>
+#include <map>
+#include <mpi.h>
+#include <string>
+#include <vector>
+
+#include "pism/util/io/OutputWriter.hh"
+#include "pism/external/nlohmann/json.hpp"
+
+namespace pism {
+
+/*!
+ * OutputWriter implementation using the generic (MPI-only) output server.
+ *
+ * Sends all metadata and data to reserved I/O server ranks (see output_server.hh) using
+ * asynchronous (MPI_Isend()) messages, so computational ranks never block on file system
+ * operations. Data buffers are kept until the corresponding sends complete; sync()
+ * releases them (after an MPI_Waitall()).
+ *
+ * The length of the time dimension and the last time value are tracked on computational
+ * ranks (the file on disk may be several records behind), so these queries require no
+ * communication.
+ */
+class ServerOutputWriter : public OutputWriter {
+public:
+  ServerOutputWriter(MPI_Comm comm, const Config &config);
+  ~ServerOutputWriter();
+
+private:
+  //! True if the current MPI process is responsible for sending actions and non-gridded
+  //! data.
+  bool m_leader;
+
+  //! Length of the time dimension in a file
+  std::map<std::string, unsigned int> m_time_length;
+
+  //! Last time value in an output file
+  std::map<std::string, double> m_last_time;
+
+  //! List of all variables defined in a given file (used to avoid defining a variable
+  //! more than once)
+  std::map<std::string, std::map<std::string, bool> > m_defined_variable;
+
+  //! List of all dimensions defined in a given file (used to avoid defining a dimension
+  //! more than once)
+  std::map<std::string, std::map<std::string, bool> > m_defined_dimension;
+
+  // --- Buffers ---
+  //
+  // Buffers hold on to data passed to MPI_Isend() until the sends complete; they are
+  // released in sync_impl() and the destructor. Deques are used (instead of vectors)
+  // because adding an element to a deque does not move existing elements.
+
+  //! Buffers used to send JSON messages and text variables
+  std::deque<std::string> m_text_buffers;
+
+  //! Buffers used to send patch start and count arrays
+  std::deque<std::vector<unsigned int> > m_header_buffers;
+
+  //! Buffers used to send arrays of double
+  std::deque<std::vector<double> > m_data_buffers;
+
+  std::vector<MPI_Request> m_mpi_requests;
+
+  //! Call MPI_Waitall() and release all send buffers.
+  void waitall();
+
+  //! Send an action request to the server rank `server` (leader only).
+  void send_action(int action, const nlohmann::json &info, int server);
+
+  // --- Interface implementation ---
+  void initialize_impl(const std::set<VariableMetadata> &array_variables);
+
+  void define_dimension_impl(const std::string &file_name, const std::string &name,
+                             unsigned int length);
+
+  void define_variable_impl(const std::string &file_name, const std::string &variable_name,
+                            const std::vector<std::string> &dims, io::Type type,
+                            const VariableAttributes &attributes);
+
+  void set_global_attributes_impl(const std::string &file_name,
+                                  const std::map<std::string, std::string> &strings,
+                                  const std::map<std::string, std::vector<double> > &numbers);
+
+  void append_time_impl(const std::string &file_name, double time_seconds);
+
+  void append_history_impl(const std::string &file_name, const std::string &text);
+
+  unsigned int time_dimension_length_impl(const std::string &file_name);
+
+  double last_time_value_impl(const std::string &file_name);
+
+  void write_array_impl(const std::string &file_name, const std::string &variable_name,
+                        const std::vector<unsigned int> &start,
+                        const std::vector<unsigned int> &count, const double *data);
+
+  void write_text_impl(const std::string &file_name, const std::string &variable_name,
+                       const std::vector<unsigned int> &start,
+                       const std::vector<unsigned int> &count, const std::string &input);
+
+  void write_distributed_array_impl(const std::string &file_name,
+                                    const std::string &variable_name, const double *data);
+
+  void append_impl(const std::string &file_name);
+  void sync_impl(const std::string &file_name);
+  void close_impl(const std::string &file_name);
+};
+
+} // namespace pism
+
+#endif /* PISM_SERVEROUTPUTWRITER_H */
@@ -33,6 +33,8 @@ const File &SynchronousOutputWriter::file(const std::string &file_name) {
     auto file = std::make_shared<File>(comm(), file_name, m_backend, io::PISM_READWRITE_MOVE);
 
     file->set_compression_level(m_compression_level);
+    file->set_compression_algorithm(m_compression_algorithm);
+    file->set_quantization(m_quantization_digits);
 
     m_files[file_name] = file;
   }
@@ -48,6 +50,10 @@ void SynchronousOutputWriter::initialize_impl(
 SynchronousOutputWriter::SynchronousOutputWriter(MPI_Comm comm, const Config &config)
     : OutputWriter(comm, config) {
   m_compression_level = static_cast<int>(config.get_number("output.compression_level"));
+  m_compression_algorithm = config.get_string("output.compression_algorithm");
+  m_quantization_digits = static_cast<int>(config.get_number("output.quantization_digits"));
+  m_chunk_cache_size =
+      static_cast<size_t>(config.get_number("output.netcdf4.chunk_cache_size") * 1024.0 * 1024.0);
   m_backend = string_to_backend(config.get_string("output.format"));
   set_is_async(false);
 }
@@ -65,6 +71,12 @@ void SynchronousOutputWriter::define_variable_impl(const std::string &file_name,
 
   output_file.define_variable(variable_name, type, dims);
 
+  if (m_chunk_cache_size > 0 and dims.size() > 1) {
+    // 521 slots and the preemption value of 0.75 are the HDF5 defaults. This call is a
+    // no-op unless output.format selects a NetCDF-4 (HDF5) backend.
+    output_file.set_variable_chunk_cache(variable_name, m_chunk_cache_size, 521, 0.75);
+  }
+
   write_attributes(file_name, variable_name, attributes.strings, attributes.numbers, type);
 }
 
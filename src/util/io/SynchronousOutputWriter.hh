@@ -44,10 +44,20 @@ public:
 private:
   std::map<std::string, std::shared_ptr<File> > m_files;
   int m_compression_level;
+  std::string m_compression_algorithm;
+  //! number of significant digits kept by lossy quantization (zero: disabled)
+  int m_quantization_digits;
+  //! HDF5 chunk cache size (bytes) for spatial variables; zero means "use the library
+  //! default"
+  size_t m_chunk_cache_size;
   io::Backend m_backend;
 
   const File &file(const std::string &file_name);
 
+protected:
+  // The methods below are protected, not private, so that ThreadedOutputWriter can call
+  // them to perform queued operations from its writer thread.
+
   void initialize_impl(const std::set<VariableMetadata> &array_variables);
 
   void define_dimension_impl(const std::string &file_name, const std::string &name,
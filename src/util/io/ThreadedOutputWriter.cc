@@ -0,0 +1,339 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <algorithm> // std::max
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "pism/util/io/ThreadedOutputWriter.hh"
+#include "pism/util/Config.hh"
+#include "pism/util/GridInfo.hh"
+#include "pism/util/VariableMetadata.hh"
+#include "pism/util/error_handling.hh"
+
+namespace pism {
+
+ThreadedOutputWriter::ThreadedOutputWriter(MPI_Comm comm, const Config &config)
+    : SynchronousOutputWriter(comm, config) {
+
+  m_capacity = (size_t)(config.get_number("output.threaded_writer.buffer_capacity") *
+                        1024.0 * 1024.0);
+  m_queued_bytes = 0;
+  m_busy         = false;
+  m_done         = false;
+  m_failure      = nullptr;
+
+  // Both the writer thread and "computational" threads make MPI calls, so we need the
+  // highest level of MPI thread support. See pism::initialize(), which requests it.
+  int provided = MPI_THREAD_SINGLE;
+  MPI_Query_thread(&provided);
+  if (provided < MPI_THREAD_MULTIPLE) {
+    throw RuntimeError::formatted(
+        PISM_ERROR_LOCATION,
+        "cannot use the threaded output writer: the MPI library provides thread support"
+        " level %d, but MPI_THREAD_MULTIPLE (%d) is required.\n"
+        "Use an MPI library supporting MPI_THREAD_MULTIPLE or set"
+        " 'output.threaded_writer.enabled' to 'no'",
+        provided, MPI_THREAD_MULTIPLE);
+  }
+
+  set_is_async(true);
+
+  m_thread = std::thread(&ThreadedOutputWriter::run, this);
+}
+
+ThreadedOutputWriter::~ThreadedOutputWriter() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_done = true;
+  }
+  m_work_available.notify_all();
+
+  // the writer thread drains the queue before stopping
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+
+  if (m_failure != nullptr) {
+    // Cannot throw from a destructor: report the error and move on.
+    try {
+      std::rethrow_exception(m_failure);
+    } catch (std::exception &e) {
+      fprintf(stderr, "PISM ERROR: the output writer thread failed: %s\n", e.what());
+    } catch (...) {
+      fprintf(stderr, "PISM ERROR: the output writer thread failed\n");
+    }
+  }
+}
+
+//! Body of the writer thread: perform queued tasks in FIFO order.
+void ThreadedOutputWriter::run() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  while (true) {
+    m_work_available.wait(lock, [this] { return m_done or not m_queue.empty(); });
+
+    if (m_queue.empty()) {
+      // m_done is set and all queued tasks are complete
+      return;
+    }
+
+    Task task = std::move(m_queue.front());
+    m_queue.pop_front();
+    m_busy = true;
+
+    lock.unlock();
+
+    std::exception_ptr failure = nullptr;
+    try {
+      task.work();
+    } catch (...) {
+      failure = std::current_exception();
+    }
+
+    lock.lock();
+
+    m_busy = false;
+    m_queued_bytes -= task.size;
+
+    if (failure != nullptr and m_failure == nullptr) {
+      m_failure = failure;
+      // There is no point in writing more after a failure: drop remaining tasks. The
+      // error is re-thrown by the next enqueue() or flush_impl() call on the main thread.
+      m_queue.clear();
+      m_queued_bytes = 0;
+    }
+
+    m_work_done.notify_all();
+  }
+}
+
+//! Add a task to the queue.
+/*! Blocks until the size of queued data drops below `output.threaded_writer.buffer_capacity`
+    (back-pressure). A task bigger than the whole buffer is accepted once the queue is
+    empty. */
+void ThreadedOutputWriter::enqueue(size_t size, const std::function<void()> &work) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  m_work_done.wait(lock, [this, size] {
+    return (m_failure != nullptr or
+            m_queued_bytes + size <= m_capacity or
+            m_queued_bytes == 0);
+  });
+
+  if (m_failure != nullptr) {
+    auto failure = m_failure;
+    m_failure    = nullptr;
+    std::rethrow_exception(failure);
+  }
+
+  m_queued_bytes += size;
+  m_queue.push_back({ size, work });
+
+  m_work_available.notify_one();
+}
+
+//! Wait until all queued tasks are complete.
+void ThreadedOutputWriter::flush_impl() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  m_work_done.wait(lock, [this] {
+    return m_failure != nullptr or (m_queue.empty() and not m_busy);
+  });
+
+  if (m_failure != nullptr) {
+    auto failure = m_failure;
+    m_failure    = nullptr;
+    std::rethrow_exception(failure);
+  }
+}
+
+void ThreadedOutputWriter::define_dimension_impl(const std::string &file_name,
+                                                 const std::string &name, unsigned int length) {
+  enqueue(0, [this, file_name, name, length]() {
+    SynchronousOutputWriter::define_dimension_impl(file_name, name, length);
+  });
+}
+
+void ThreadedOutputWriter::define_variable_impl(const std::string &file_name,
+                                                const std::string &variable_name,
+                                                const std::vector<std::string> &dims, io::Type type,
+                                                const VariableAttributes &attributes) {
+  enqueue(0, [this, file_name, variable_name, dims, type, attributes]() {
+    SynchronousOutputWriter::define_variable_impl(file_name, variable_name, dims, type, attributes);
+  });
+}
+
+void ThreadedOutputWriter::set_global_attributes_impl(
+    const std::string &file_name, const std::map<std::string, std::string> &strings,
+    const std::map<std::string, std::vector<double> > &numbers) {
+  enqueue(0, [this, file_name, strings, numbers]() {
+    SynchronousOutputWriter::set_global_attributes_impl(file_name, strings, numbers);
+  });
+}
+
+void ThreadedOutputWriter::append_time_impl(const std::string &file_name, double time_seconds) {
+  // Calls the time_dimension_length_impl() below, which uses the cached length (if
+  // available), so this does not wait for the queue to drain in the common case.
+  unsigned int t_length = time_dimension_length(file_name);
+
+  std::vector<unsigned int> start = { t_length };
+  std::vector<unsigned int> count = { 1 };
+  auto buffer = std::make_shared<std::vector<double> >(1, time_seconds);
+
+  enqueue(sizeof(double), [this, file_name, start, count, buffer]() {
+    SynchronousOutputWriter::write_array_impl(file_name, time_name(), start, count,
+                                              buffer->data());
+  });
+
+  m_time_length[file_name] = t_length + 1;
+  m_last_time[file_name]   = time_seconds;
+}
+
+void ThreadedOutputWriter::append_history_impl(const std::string &file_name,
+                                               const std::string &text) {
+  enqueue(text.size(), [this, file_name, text]() {
+    SynchronousOutputWriter::append_history_impl(file_name, text);
+  });
+}
+
+unsigned int ThreadedOutputWriter::time_dimension_length_impl(const std::string &file_name) {
+  auto cached = m_time_length.find(file_name);
+
+  if (cached == m_time_length.end()) {
+    // This file was opened for appending (or not written to, yet): wait for queued tasks
+    // and read from the file itself.
+    flush_impl();
+    auto length = SynchronousOutputWriter::time_dimension_length_impl(file_name);
+
+    cached = m_time_length.insert({ file_name, length }).first;
+  }
+
+  return cached->second;
+}
+
+double ThreadedOutputWriter::last_time_value_impl(const std::string &file_name) {
+  auto cached = m_last_time.find(file_name);
+
+  if (cached == m_last_time.end()) {
+    flush_impl();
+    double last_time = SynchronousOutputWriter::last_time_value_impl(file_name);
+
+    cached = m_last_time.insert({ file_name, last_time }).first;
+  }
+
+  return cached->second;
+}
+
+void ThreadedOutputWriter::write_array_impl(const std::string &file_name,
+                                            const std::string &variable_name,
+                                            const std::vector<unsigned int> &start,
+                                            const std::vector<unsigned int> &count,
+                                            const double *data) {
+  size_t size = 1;
+  for (auto c : count) {
+    size *= c;
+  }
+  auto buffer = std::make_shared<std::vector<double> >(data, data + size);
+
+  enqueue(size * sizeof(double), [this, file_name, variable_name, start, count, buffer]() {
+    SynchronousOutputWriter::write_array_impl(file_name, variable_name, start, count,
+                                              buffer->data());
+  });
+}
+
+void ThreadedOutputWriter::write_text_impl(const std::string &file_name,
+                                           const std::string &variable_name,
+                                           const std::vector<unsigned int> &start,
+                                           const std::vector<unsigned int> &count,
+                                           const std::string &input) {
+  enqueue(input.size(), [this, file_name, variable_name, start, count, input]() {
+    SynchronousOutputWriter::write_text_impl(file_name, variable_name, start, count, input);
+  });
+}
+
+void ThreadedOutputWriter::write_distributed_array_impl(const std::string &file_name,
+                                                        const std::string &variable_name,
+                                                        const double *data) {
+  const auto &metadata = variable_info(variable_name);
+
+  if (metadata.grid_info() == nullptr) {
+    throw RuntimeError::formatted(PISM_ERROR_LOCATION, "variable '%s' has no grid info",
+                                  variable_name.c_str());
+  }
+
+  const auto &grid = *metadata.grid_info();
+
+  unsigned int n_levels = std::max(metadata.levels().size(), (std::size_t)1);
+
+  // Compute `start` and `count` here (instead of queueing a call to
+  // SynchronousOutputWriter::write_distributed_array_impl()) because the length of the
+  // time dimension has to come from the cache maintained by this class: the file on disk
+  // may be several records behind.
+  std::vector<unsigned int> start = { grid.ys, grid.xs, 0 };
+  std::vector<unsigned int> count = { grid.ym, grid.xm, n_levels };
+
+  if (metadata.get_time_dependent()) {
+    auto t_length = time_dimension_length(file_name);
+    auto t_start  = t_length > 0 ? t_length - 1 : 0;
+
+    start.insert(start.cbegin(), t_start);
+    count.insert(count.cbegin(), 1);
+  }
+
+  if (not experiment_id().empty()) {
+    start.insert(start.cbegin(), 0);
+    count.insert(count.cbegin(), 1);
+  }
+
+  // copy the data into a second buffer so that the caller can re-use its buffer
+  // immediately
+  size_t size = (size_t)grid.ym * (size_t)grid.xm * (size_t)n_levels;
+  auto buffer = std::make_shared<std::vector<double> >(data, data + size);
+
+  enqueue(size * sizeof(double), [this, file_name, variable_name, start, count, buffer]() {
+    SynchronousOutputWriter::write_array_impl(file_name, variable_name, start, count,
+                                              buffer->data());
+  });
+}
+
+void ThreadedOutputWriter::append_impl(const std::string &file_name) {
+  enqueue(0, [this, file_name]() {
+    SynchronousOutputWriter::append_impl(file_name);
+  });
+}
+
+void ThreadedOutputWriter::sync_impl(const std::string &file_name) {
+  enqueue(0, [this, file_name]() {
+    SynchronousOutputWriter::sync_impl(file_name);
+  });
+}
+
+void ThreadedOutputWriter::close_impl(const std::string &file_name) {
+  enqueue(0, [this, file_name]() {
+    SynchronousOutputWriter::close_impl(file_name);
+  });
+
+  // If this file is re-opened later these have to be re-read.
+  m_time_length.erase(file_name);
+  m_last_time.erase(file_name);
+}
+
+} // end of namespace pism
@@ -0,0 +1,159 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef PISM_THREADEDOUTPUTWRITER_H
+#define PISM_THREADEDOUTPUTWRITER_H
+
+#include "pism/util/io/SynchronousOutputWriter.hh"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace pism {
+
+/*!
+ * Asynchronous implementation of OutputWriter.
+ *
+ * Copies data passed to it into an in-memory queue and performs all file operations from a
+ * background thread, allowing time stepping to continue while diagnostic fields are
+ * written to disk.
+ *
+ * The total amount of data held by queued operations is limited by
+ * `output.threaded_writer.buffer_capacity`; once this limit is reached new requests block
+ * until the writer thread catches up (back-pressure). This bounds memory use when the
+ * writer falls behind.
+ *
+ * Queued operations are performed in the order they were requested, so the resulting
+ * files are identical to ones written by SynchronousOutputWriter. Queries
+ * (time_dimension_length(), last_time_value()) are answered using cached values when
+ * possible and wait for the queue to drain otherwise.
+ *
+ * Errors detected by the writer thread are re-thrown by the next call into this class, so
+ * an I/O failure may be reported "late", i.e. in the context of an operation requested
+ * *after* the one that failed.
+ *
+ * Since both the writer thread and "computational" threads make MPI calls, this class
+ * requires an MPI library providing the MPI_THREAD_MULTIPLE threading level. The
+ * constructor checks this and fails with an error message if the available level of
+ * thread support is not sufficient.
+ */
+class ThreadedOutputWriter : public SynchronousOutputWriter {
+public:
+  ThreadedOutputWriter(MPI_Comm comm, const Config &config);
+  virtual ~ThreadedOutputWriter();
+
+private:
+  //! A unit of work for the writer thread and the size (in bytes) of the data it holds on
+  //! to (used to implement back-pressure).
+  struct Task {
+    size_t size;
+    std::function<void()> work;
+  };
+
+  void enqueue(size_t size, const std::function<void()> &work);
+
+  void run();
+
+  //! Cached length of the time dimension in output files (accessed from the main thread
+  //! only)
+  std::map<std::string, unsigned int> m_time_length;
+
+  //! Cached last value of the time variable in output files (accessed from the main
+  //! thread only)
+  std::map<std::string, double> m_last_time;
+
+  //! Maximum total size (in bytes) of the data held by queued tasks
+  size_t m_capacity;
+
+  // The variables below are guarded by m_mutex.
+
+  //! Total size (in bytes) of the data held by queued tasks
+  size_t m_queued_bytes;
+
+  std::deque<Task> m_queue;
+
+  //! True if the writer thread is performing a task
+  bool m_busy;
+
+  //! Set to true to tell the writer thread to drain the queue and stop
+  bool m_done;
+
+  //! First error reported by the writer thread (re-thrown by the next enqueue() or
+  //! flush() call)
+  std::exception_ptr m_failure;
+
+  std::mutex m_mutex;
+
+  //! Signaled when a task is added to the queue or m_done is set
+  std::condition_variable m_work_available;
+
+  //! Signaled when the writer thread completes a task or fails
+  std::condition_variable m_work_done;
+
+  std::thread m_thread;
+
+  // interface implementation
+
+  void define_dimension_impl(const std::string &file_name, const std::string &name,
+                             unsigned int length);
+
+  void define_variable_impl(const std::string &file_name, const std::string &variable_name,
+                            const std::vector<std::string> &dims, io::Type type,
+                            const VariableAttributes &attributes);
+
+  void set_global_attributes_impl(const std::string &file_name,
+                                  const std::map<std::string, std::string> &strings,
+                                  const std::map<std::string, std::vector<double> > &numbers);
+
+  void append_time_impl(const std::string &file_name, double time_seconds);
+
+  void append_history_impl(const std::string &file_name, const std::string &text);
+
+  unsigned int time_dimension_length_impl(const std::string &file_name);
+
+  double last_time_value_impl(const std::string &file_name);
+
+  void write_array_impl(const std::string &file_name, const std::string &variable_name,
+                        const std::vector<unsigned int> &start,
+                        const std::vector<unsigned int> &count, const double *data);
+
+  void write_text_impl(const std::string &file_name, const std::string &variable_name,
+                       const std::vector<unsigned int> &start,
+                       const std::vector<unsigned int> &count, const std::string &input);
+
+  void write_distributed_array_impl(const std::string &file_name,
+                                    const std::string &variable_name, const double *data);
+
+  void append_impl(const std::string &file_name);
+  void sync_impl(const std::string &file_name);
+  void close_impl(const std::string &file_name);
+  //! Wait until all queued tasks are complete.
+  void flush_impl();
+};
+
+} // namespace pism
+
+#endif /* PISM_THREADEDOUTPUTWRITER_H */
@@ -18,6 +18,9 @@
  */
 
 #include <cmath>
+#include <cstdio>               // rename()
+#include <fstream>
+#include <sys/stat.h>           // stat()
 
 #include "pism/util/Grid.hh"
 #include "pism/util/io/LocalInterpCtx.hh"
@@ -73,7 +76,60 @@ static void interpolate(const grid::DistributedGridInfo &grid, const LocalInterp
 
   unsigned int nlevels = lic.z->n_output();
 
-  int x_count = lic.count[X_AXIS], z_count = lic.count[Z_AXIS];
+  int
+    x_count = lic.count[X_AXIS],
+    y_count = lic.count[Y_AXIS],
+    z_count = lic.count[Z_AXIS];
+
+  if (nlevels > 1) {
+    // The 3D case is split into two bandwidth-bound passes.
+    //
+    // Pass 1: interpolate *all* columns of the input slab from the input vertical grid
+    // to the output one in one batch. (The slab is the bounding box of this rank's
+    // subdomain, so nearly every column is needed.)
+    std::vector<double> columns((size_t)y_count * x_count * nlevels);
+    lic.z->interpolate_batch(input_array, z_count, (size_t)y_count * x_count, columns.data());
+
+    auto column = [&columns, x_count, nlevels](int X, int Y) {
+      return &columns[(size_t)(Y * x_count + X) * nlevels];
+    };
+
+    // Pass 2: bilinear interpolation in the map plane. The four source columns and the
+    // output column are contiguous, so the loop over levels vectorizes.
+    for (auto p : GridPoints(grid)) {
+      const int i = p.i() - grid.xs, j = p.j() - grid.ys;
+
+      // Indices of neighboring points.
+      const int X_m = lic.x->left(i), X_p = lic.x->right(i);
+      const int Y_m = lic.y->left(j), Y_p = lic.y->right(j);
+
+      const double
+        *c_mm = column(X_m, Y_m),
+        *c_pm = column(X_p, Y_m),
+        *c_mp = column(X_m, Y_p),
+        *c_pp = column(X_p, Y_p);
+
+      // interpolation coefficients in the x and y directions
+      const double x_alpha = lic.x->alpha(i);
+      const double y_alpha = lic.y->alpha(j);
+
+      const double
+        w_mm = (1.0 - x_alpha) * (1.0 - y_alpha),
+        w_pm = x_alpha * (1.0 - y_alpha),
+        w_mp = (1.0 - x_alpha) * y_alpha,
+        w_pp = x_alpha * y_alpha;
+
+      double *out = &output_array[(size_t)(j * grid.xm + i) * nlevels];
+
+      for (unsigned int k = 0; k < nlevels; k++) {
+        out[k] = w_mm * c_mm[k] + w_pm * c_pm[k] + w_mp * c_mp[k] + w_pp * c_pp[k];
+      }
+    }
+
+    return;
+  }
+
+  // the 2-D case: no interpolation in Z
   auto input = [input_array, x_count, z_count](int X, int Y, int Z) {
     // the map from logical to linear indices for the input array
     int index = (Y * x_count + X) * z_count + Z;
@@ -81,64 +137,29 @@ static void interpolate(const grid::DistributedGridInfo &grid, const LocalInterp
   };
 
   for (auto p : GridPoints(grid)) {
-    const int i_global = p.i(), j_global = p.j();
-
-    const int i = i_global - grid.xs, j = j_global - grid.ys;
+    const int i = p.i() - grid.xs, j = p.j() - grid.ys;
 
     // Indices of neighboring points.
     const int X_m = lic.x->left(i), X_p = lic.x->right(i);
     const int Y_m = lic.y->left(j), Y_p = lic.y->right(j);
 
-    for (unsigned int k = 0; k < nlevels; k++) {
-
-      double a_mm = 0.0, a_mp = 0.0, a_pm = 0.0, a_pp = 0.0;
-
-      if (nlevels > 1) {
-        const int Z_m = lic.z->left(k), Z_p = lic.z->right(k);
-
-        const double alpha_z = lic.z->alpha(k);
-
-        // We pretend that there are always 8 neighbors (4 in the map plane,
-        // 2 vertical levels). And compute the indices into the input_array for
-        // those neighbors.
-        const double
-          mmm = input(X_m, Y_m, Z_m),
-          mmp = input(X_m, Y_m, Z_p),
-          pmm = input(X_p, Y_m, Z_m),
-          pmp = input(X_p, Y_m, Z_p),
-          mpm = input(X_m, Y_p, Z_m),
-          mpp = input(X_m, Y_p, Z_p),
-          ppm = input(X_p, Y_p, Z_m),
-          ppp = input(X_p, Y_p, Z_p);
-
-        // linear interpolation in the z-direction
-        a_mm = mmm * (1.0 - alpha_z) + mmp * alpha_z;
-        a_mp = pmm * (1.0 - alpha_z) + pmp * alpha_z;
-        a_pm = mpm * (1.0 - alpha_z) + mpp * alpha_z;
-        a_pp = ppm * (1.0 - alpha_z) + ppp * alpha_z;
-      } else {
-        // no interpolation in Z in the 2-D case
-        a_mm = input(X_m, Y_m, 0);
-        a_mp = input(X_p, Y_m, 0);
-        a_pm = input(X_m, Y_p, 0);
-        a_pp = input(X_p, Y_p, 0);
-      }
+    const double
+      a_mm = input(X_m, Y_m, 0),
+      a_mp = input(X_p, Y_m, 0),
+      a_pm = input(X_m, Y_p, 0),
+      a_pp = input(X_p, Y_p, 0);
 
-      // interpolation coefficient in the x direction
-      const double x_alpha = lic.x->alpha(i);
-      // interpolation coefficient in the y direction
-      const double y_alpha = lic.y->alpha(j);
+    // interpolation coefficient in the x direction
+    const double x_alpha = lic.x->alpha(i);
+    // interpolation coefficient in the y direction
+    const double y_alpha = lic.y->alpha(j);
 
-      // interpolate in x direction
-      const double a_m = a_mm * (1.0 - x_alpha) + a_mp * x_alpha;
-      const double a_p = a_pm * (1.0 - x_alpha) + a_pp * x_alpha;
+    // interpolate in x direction
+    const double a_m = a_mm * (1.0 - x_alpha) + a_mp * x_alpha;
+    const double a_p = a_pm * (1.0 - x_alpha) + a_pp * x_alpha;
 
-      auto index = (j * grid.xm + i) * nlevels + k;
-
-      // index into the new array and interpolate in y direction
-      output_array[index] = a_m * (1.0 - y_alpha) + a_p * y_alpha;
-      // done with the point at (x,y,z)
-    } // end of the loop over vertical levels
+    // index into the new array and interpolate in y direction
+    output_array[j * grid.xm + i] = a_m * (1.0 - y_alpha) + a_p * y_alpha;
   }
 }
 
@@ -372,28 +393,170 @@ static StartCountInfo compute_start_and_count(std::vector<AxisType> &dim_types,
 }
 
 //! \brief Read an array distributed according to the grid.
+/*!
+ * Read this rank's part of a variable.
+ *
+ * `start` and `count` (in the T,X,Y,Z order) select the smallest hyperslab covering the
+ * rank's subdomain (for regridding: the bounding box computed by LocalInterpCtx). They
+ * are re-arranged to match the variable's dimension order and passed unchanged to the
+ * backend, so each rank's read volume is proportional to its subdomain in every backend,
+ * including variables stored with transposed or permuted axes (which are read as the
+ * same hyperslab and re-ordered in memory here).
+ */
+//! "Input fork" used by ensemble runs (see the -ensemble option of pism.cc): when set,
+//! bulk reads in read_distributed_array() are performed by the first ensemble member only
+//! and broadcast to the corresponding ranks of all other members over this communicator.
+//!
+//! Thread-local so that reads issued by background prefetching threads (see
+//! array::Forcing) are not affected: their timing differs between members, so they cannot
+//! participate in collective operations and read from the file system instead.
+static thread_local MPI_Comm input_fork_comm = MPI_COMM_NULL;
+
+/*!
+ * Enable (or, with `MPI_COMM_NULL`, disable) the "input fork".
+ *
+ * `peer_comm` has to connect the ranks owning one and the same sub-domain in all ensemble
+ * members, with the rank of the member performing file reads equal to zero.
+ *
+ * While the fork is active every participating member has to issue *identical* sequences
+ * of distributed reads (a mismatch leads to a deadlock or garbled data), so this is
+ * enabled only around model initialization, where the sequence of reads is determined by
+ * the configuration.
+ */
+void set_input_fork(MPI_Comm peer_comm) {
+  input_fork_comm = peer_comm;
+}
+
+/*!
+ * Copy `filename` into `staging_dir` and return the name of the copy. See
+ * input.staging_dir.
+ *
+ * One rank per shared-memory node performs the copy; all ranks on a node then read the
+ * same local file, so the data is fetched from the parallel file system once per node and
+ * served from the OS page cache after that.
+ *
+ * The size and the modification time of the source are saved next to the copy and a copy
+ * left behind by a previous run is re-used if they still match, so restarting a job does
+ * not repeat the transfer.
+ *
+ * This is a collective operation: all ranks in `com` have to call it, with one and the
+ * same `filename`.
+ */
+std::string stage_input_file(MPI_Comm com, const std::string &filename,
+                             const std::string &staging_dir) {
+
+  std::string local_name       = staging_dir + "/" + filename.substr(filename.rfind('/') + 1);
+  std::string fingerprint_name = local_name + ".fingerprint";
+
+  // connects the ranks sharing a node with this one
+  MPI_Comm node_com = MPI_COMM_NULL;
+  MPI_Comm_split_type(com, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_com);
+
+  int node_rank = 0;
+  MPI_Comm_rank(node_com, &node_rank);
+
+  int stat = 0;
+  std::string message;
+  if (node_rank == 0) {
+    try {
+      struct ::stat info;
+      if (::stat(filename.c_str(), &info) != 0) {
+        throw RuntimeError::formatted(PISM_ERROR_LOCATION, "cannot stat '%s'",
+                                      filename.c_str());
+      }
+
+      std::string fingerprint = pism::printf("%lld %lld",
+                                             (long long)info.st_size,
+                                             (long long)info.st_mtime);
+
+      std::string old_fingerprint;
+      {
+        std::ifstream f(fingerprint_name);
+        std::getline(f, old_fingerprint);
+      }
+
+      if (old_fingerprint != fingerprint) {
+        std::string tmp_name = local_name + ".tmp";
+        {
+          std::ifstream input(filename, std::ios::binary);
+          std::ofstream output(tmp_name, std::ios::binary | std::ios::trunc);
+          output << input.rdbuf();
+          if (not (input.good() and output.good())) {
+            throw RuntimeError::formatted(PISM_ERROR_LOCATION, "cannot copy '%s' to '%s'",
+                                          filename.c_str(), tmp_name.c_str());
+          }
+        }
+
+        struct ::stat copy_info;
+        if (::stat(tmp_name.c_str(), &copy_info) != 0 or copy_info.st_size != info.st_size) {
+          throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                        "the copy of '%s' in '%s' is incomplete",
+                                        filename.c_str(), staging_dir.c_str());
+        }
+
+        if (rename(tmp_name.c_str(), local_name.c_str()) != 0) {
+          throw RuntimeError::formatted(PISM_ERROR_LOCATION, "cannot rename '%s' to '%s'",
+                                        tmp_name.c_str(), local_name.c_str());
+        }
+
+        std::ofstream f(fingerprint_name, std::ios::trunc);
+        f << fingerprint << "\n";
+      }
+    } catch (RuntimeError &e) {
+      stat    = 1;
+      message = e.what();
+    }
+  } // end of "if (node_rank == 0)"
+
+  MPI_Comm_free(&node_com);
+
+  int global_stat = 0;
+  MPI_Allreduce(&stat, &global_stat, 1, MPI_INT, MPI_SUM, com);
+
+  if (global_stat != 0) {
+    throw RuntimeError::formatted(PISM_ERROR_LOCATION, "failed to stage '%s' in '%s'%s%s",
+                                  filename.c_str(), staging_dir.c_str(),
+                                  message.empty() ? "" : ": ", message.c_str());
+  }
+
+  return local_name;
+}
+
 static void read_distributed_array(const File &file, const std::string &variable_name,
                                    std::shared_ptr<units::System> unit_system,
                                    const std::array<int,4> &start,
                                    const std::array<int,4> &count,
                                    double *output) {
   try {
-    auto dim_types = dimension_types(file, variable_name, unit_system);
+    auto size = count[X_AXIS] * count[Y_AXIS] * count[Z_AXIS];
 
-    auto sc = compute_start_and_count(dim_types, start, count);
+    int fork_rank = 0;
+    if (input_fork_comm != MPI_COMM_NULL) {
+      MPI_Comm_rank(input_fork_comm, &fork_rank);
+    }
 
-    auto size = count[X_AXIS] * count[Y_AXIS] * count[Z_AXIS];
+    // with an active input fork all ranks of the members other than the first one skip
+    // the file read and receive the data below
+    if (fork_rank == 0) {
+      auto dim_types = dimension_types(file, variable_name, unit_system);
 
-    if (transpose(dim_types)) {
-      std::vector<double> tmp(size);
-      file.read_variable(variable_name, sc.start, sc.count, tmp.data());
-      transpose(tmp.data(), dim_types, count, output);
-    } else {
-      file.read_variable(variable_name, sc.start, sc.count, output);
+      auto sc = compute_start_and_count(dim_types, start, count);
+
+      if (transpose(dim_types)) {
+        std::vector<double> tmp(size);
+        file.read_variable(variable_name, sc.start, sc.count, tmp.data());
+        transpose(tmp.data(), dim_types, count, output);
+      } else {
+        file.read_variable(variable_name, sc.start, sc.count, output);
+      }
+
+      // Stop with an error message if some values match the _FillValue attribute:
+      check_for_missing_values(file, variable_name, 1e-12, output, size);
     }
 
-    // Stop with an error message if some values match the _FillValue attribute:
-    check_for_missing_values(file, variable_name, 1e-12, output, size);
+    if (input_fork_comm != MPI_COMM_NULL) {
+      MPI_Bcast(output, size, MPI_DOUBLE, 0, input_fork_comm);
+    }
 
   } catch (RuntimeError &e) {
     e.add_context("reading variable '%s' from '%s'", variable_name.c_str(), file.name().c_str());
@@ -410,27 +573,45 @@ static void read_distributed_array(const File &file, const std::string &variable
   - sets `v` to `default_value` if `flag` is `OPTIONAL` and the
   variable was not found in the input file
   - uses the last record in the file
+
+  The `buffer` argument is scratch space used to hold the source-file hyperslab before
+  interpolation. It is re-sized as needed; passing the same vector to repeated calls (e.g.
+  when reading consecutive records of a forcing field) avoids allocating and freeing this
+  buffer for every record.
+
+  Set `profile` to false when calling from a background thread (see record prefetching in
+  array::Forcing): profiling uses PETSc's logging, which is not thread-safe.
 */
 void regrid_spatial_variable(const VariableMetadata &variable,
                              const Grid &target_grid,
                              const LocalInterpCtx &interp_context, const File &file,
                              const Logger &log,
-                             double *output) {
+                             std::vector<double> &buffer,
+                             double *output,
+                             bool profile) {
 
   auto var = file.find_variable(variable.get_name(), variable["standard_name"]);
 
   const auto &profiling = target_grid.ctx()->profiling();
 
-  profiling.begin("io.regridding.read");
-  std::vector<double> buffer(interp_context.buffer_size());
+  if (profile) {
+    profiling.begin("io.regridding.read");
+  }
+  buffer.resize(interp_context.buffer_size());
   read_distributed_array(file, var.name, variable.unit_system(), interp_context.start,
                          interp_context.count, buffer.data());
-  profiling.end("io.regridding.read");
+  if (profile) {
+    profiling.end("io.regridding.read");
+  }
 
   // interpolate
-  profiling.begin("io.regridding.interpolate");
+  if (profile) {
+    profiling.begin("io.regridding.interpolate");
+  }
   interpolate(target_grid.info(), interp_context, buffer.data(), output);
-  profiling.end("io.regridding.interpolate");
+  if (profile) {
+    profiling.end("io.regridding.interpolate");
+  }
 
   // Get the units string from the file and convert the units:
   {
@@ -63,12 +63,19 @@ void regrid_spatial_variable(const VariableMetadata &variable,
                              const LocalInterpCtx &lic,
                              const File &file,
                              const Logger &log,
-                             double *output);
+                             std::vector<double> &buffer,
+                             double *output,
+                             bool profile = true);
 
 void read_spatial_variable(const VariableMetadata &variable,
                            const Grid& grid, const File &file,
                            unsigned int time, double *output);
 
+void set_input_fork(MPI_Comm peer_comm);
+
+std::string stage_input_file(MPI_Comm com, const std::string &filename,
+                             const std::string &staging_dir);
+
 std::vector<double> read_1d_variable(const File &file, const std::string &name,
                                      const std::string &units,
                                      std::shared_ptr<units::System> unit_system);
@@ -0,0 +1,369 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <cstdint> // uint32_t
+#include <map>
+#include <memory>
+#include <mpi.h>
+#include <string>
+#include <vector>
+
+#include "pism/util/io/output_server.hh"
+#include "pism/util/io/File.hh"
+#include "pism/util/io/IO_Flags.hh"
+#include "pism/util/error_handling.hh"
+#include "pism/external/nlohmann/json.hpp"
+
+namespace pism {
+namespace io {
+
+//! Number of reserved server ranks (zero: server not enabled)
+static int s_n_ranks = 0;
+
+//! True if the current rank is a server rank
+static bool s_is_server = false;
+
+//! Computational sub-communicator on computational ranks, server sub-communicator on
+//! server ranks
+static MPI_Comm s_local_comm = MPI_COMM_NULL;
+
+void output_server_init(int n_ranks) {
+  int size = 0, rank = 0;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  if (n_ranks < 1 or n_ranks >= size) {
+    throw RuntimeError::formatted(
+        PISM_ERROR_LOCATION,
+        "'-io_server %d' requires at least %d MPI processes (%d found)",
+        n_ranks, n_ranks + 1, size);
+  }
+
+  s_is_server = (rank >= size - n_ranks);
+  s_n_ranks   = n_ranks;
+
+  MPI_Comm_split(MPI_COMM_WORLD, s_is_server ? 1 : 0, rank, &s_local_comm);
+}
+
+void output_server_finalize() {
+  if (s_local_comm != MPI_COMM_NULL) {
+    MPI_Comm_free(&s_local_comm);
+    s_local_comm = MPI_COMM_NULL;
+  }
+}
+
+bool output_server_enabled() {
+  return s_n_ranks > 0;
+}
+
+bool is_output_server_rank() {
+  return s_is_server;
+}
+
+int output_server_size() {
+  return s_n_ranks;
+}
+
+MPI_Comm output_server_local_comm() {
+  return s_local_comm;
+}
+
+int output_server_rank(const std::string &file_name) {
+  int size = 0;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  // FNV-1a: a simple hash that is guaranteed to give the same result on all ranks
+  // (unlike std::hash)
+  uint32_t hash = 2166136261u;
+  for (char c : file_name) {
+    hash ^= (uint32_t)(unsigned char)c;
+    hash *= 16777619u;
+  }
+
+  return size - s_n_ranks + (int)(hash % (uint32_t)s_n_ranks);
+}
+
+//! State of one output server rank.
+struct ServerState {
+  ServerState() {
+    backend               = PISM_NETCDF3;
+    compression_level     = 0;
+    compression_algorithm = "deflate";
+    quantization_digits   = 0;
+    time_name             = "time";
+
+    int size = 0;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    n_compute = size - s_n_ranks;
+  }
+
+  io::Backend backend;
+  int compression_level;
+  std::string compression_algorithm;
+  int quantization_digits;
+  std::string time_name;
+
+  //! Number of computational ranks (each sends one patch of a distributed array)
+  int n_compute;
+
+  //! Files owned by this server rank
+  std::map<std::string, std::shared_ptr<File> > files;
+};
+
+//! Return the file `file_name`, opening (and possibly overwriting) it if necessary.
+/*! Mirrors SynchronousOutputWriter::file(): an existing file is moved to a backup name
+    unless it was opened using the APPEND_FILE action first. */
+static const File &server_file(ServerState &state, const std::string &file_name) {
+  if (state.files[file_name] == nullptr) {
+    auto file = std::make_shared<File>(MPI_COMM_SELF, file_name, state.backend,
+                                       io::PISM_READWRITE_MOVE);
+
+    file->set_compression_level(state.compression_level);
+    file->set_compression_algorithm(state.compression_algorithm);
+    file->set_quantization(state.quantization_digits);
+
+    state.files[file_name] = file;
+  }
+
+  return *state.files[file_name];
+}
+
+//! Receive a string of *a priori* unknown length.
+static std::string receive_string(int source, int tag) {
+  MPI_Status status;
+  MPI_Probe(source, tag, MPI_COMM_WORLD, &status);
+
+  int length = 0;
+  MPI_Get_count(&status, MPI_CHAR, &length);
+
+  std::string result(length, '\0');
+  MPI_Recv(&result[0], length, MPI_CHAR, source, tag, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+  return result;
+}
+
+static size_t product(const std::vector<unsigned int> &count) {
+  size_t result = 1;
+  for (auto c : count) {
+    result *= c;
+  }
+  return result;
+}
+
+//! Write variable attributes stored in a JSON object.
+/*! JSON strings become text attributes; everything else is interpreted as an array of
+    doubles. Mirrors SynchronousOutputWriter::write_attributes(), including the treatment
+    of numeric attributes of text variables. */
+static void write_attributes(const File &file, const std::string &var_name,
+                             const nlohmann::json &attributes, io::Type output_type) {
+  if (output_type == io::PISM_CHAR) {
+    // save attributes of a character variable as "double"
+    output_type = io::PISM_DOUBLE;
+  }
+
+  for (auto a = attributes.begin(); a != attributes.end(); ++a) {
+    const auto &name = a.key();
+
+    if (a.value().is_string()) {
+      std::string value = a.value();
+      if (not value.empty()) {
+        file.write_attribute(var_name, name, value);
+      }
+    } else {
+      auto values = a.value().get<std::vector<double> >();
+      if (not values.empty()) {
+        file.write_attribute(var_name, name, output_type, values);
+      }
+    }
+  }
+}
+
+static void server_loop() {
+  ServerState state;
+
+  // The compute leader (rank 0 of MPI_COMM_WORLD) sends all actions; messages with the
+  // same source and tag arrive in the order they were sent, so actions are performed in
+  // the order they were requested.
+  const int leader = 0;
+
+  while (true) {
+    auto message = nlohmann::json::parse(receive_string(leader, ACTION_TAG));
+
+    int action       = message["action"];
+    const auto &info = message["info"];
+
+    switch (action) {
+    case CONFIGURE: {
+      state.backend               = string_to_backend(info["format"]);
+      state.compression_level     = info["compression_level"];
+      state.compression_algorithm = info["compression_algorithm"];
+      state.quantization_digits   = info["quantization_digits"];
+      state.time_name             = info["time_name"];
+      break;
+    }
+    case APPEND_FILE: {
+      std::string file_name = info["file_name"];
+
+      if (state.files[file_name] == nullptr) {
+        state.files[file_name] =
+            std::make_shared<File>(MPI_COMM_SELF, file_name, io::PISM_GUESS, io::PISM_READWRITE);
+      }
+
+      // report the length of the time dimension and the last time value to the leader
+      int t_length     = (int)state.files[file_name]->dimension_length(state.time_name);
+      double last_time = 0.0;
+      if (t_length > 0) {
+        state.files[file_name]->read_variable(state.time_name,
+                                              { (unsigned int)t_length - 1 }, { 1 },
+                                              &last_time);
+      }
+      MPI_Send(&t_length, 1, MPI_INT, leader, ACTION_TAG, MPI_COMM_WORLD);
+      MPI_Send(&last_time, 1, MPI_DOUBLE, leader, ACTION_TAG, MPI_COMM_WORLD);
+      break;
+    }
+    case DEFINE_DIMENSION: {
+      const auto &file = server_file(state, info["file_name"]);
+
+      std::string name = info["name"];
+      if (not file.dimension_exists(name)) {
+        file.define_dimension(name, (size_t)info["length"]);
+      }
+      break;
+    }
+    case DEFINE_VARIABLE: {
+      const auto &file = server_file(state, info["file_name"]);
+
+      std::string variable_name = info["variable_name"];
+      if (not file.variable_exists(variable_name)) {
+        auto dims = info["dimensions"].get<std::vector<std::string> >();
+        auto type = (io::Type)(int)info["type"];
+
+        file.define_variable(variable_name, type, dims);
+
+        write_attributes(file, variable_name, info["attributes"], type);
+      }
+      break;
+    }
+    case SET_FILE_ATTRIBUTES: {
+      const auto &file = server_file(state, info["file_name"]);
+
+      write_attributes(file, "PISM_GLOBAL", info["attributes"], io::PISM_DOUBLE);
+      break;
+    }
+    case APPEND_HISTORY: {
+      const auto &file = server_file(state, info["file_name"]);
+
+      auto old_history = file.read_text_attribute("PISM_GLOBAL", "history");
+      std::string text = info["history"];
+
+      file.write_attribute("PISM_GLOBAL", "history", old_history + text);
+      break;
+    }
+    case WRITE_VARIABLE: {
+      const auto &file = server_file(state, info["file_name"]);
+
+      std::string variable_name = info["variable_name"];
+      auto start                = info["start"].get<std::vector<unsigned int> >();
+      auto count                = info["count"].get<std::vector<unsigned int> >();
+
+      int size = (int)product(count);
+
+      if (info.value("text", false)) {
+        std::string data(size, '\0');
+        MPI_Recv(&data[0], size, MPI_CHAR, leader, DATA_TAG, MPI_COMM_WORLD,
+                 MPI_STATUS_IGNORE);
+        file.write_text_variable(variable_name, start, count, data);
+      } else {
+        std::vector<double> data(size);
+        MPI_Recv(data.data(), size, MPI_DOUBLE, leader, DATA_TAG, MPI_COMM_WORLD,
+                 MPI_STATUS_IGNORE);
+        file.write_variable(variable_name, start, count, data.data());
+      }
+      break;
+    }
+    case WRITE_GRIDDED: {
+      const auto &file = server_file(state, info["file_name"]);
+
+      std::string variable_name = info["variable_name"];
+
+      // Each computational rank sends the start and count of its patch, followed by the
+      // data. Messages from one rank arrive in order, so the header and the data cannot
+      // get separated.
+      for (int r = 0; r < state.n_compute; ++r) {
+        MPI_Status status;
+        MPI_Probe(r, DATA_TAG, MPI_COMM_WORLD, &status);
+
+        int header_length = 0;
+        MPI_Get_count(&status, MPI_UNSIGNED, &header_length);
+
+        std::vector<unsigned int> header(header_length);
+        MPI_Recv(header.data(), header_length, MPI_UNSIGNED, r, DATA_TAG, MPI_COMM_WORLD,
+                 MPI_STATUS_IGNORE);
+
+        int ndims = header_length / 2;
+        std::vector<unsigned int> start(header.begin(), header.begin() + ndims);
+        std::vector<unsigned int> count(header.begin() + ndims, header.end());
+
+        std::vector<double> data(product(count));
+        MPI_Recv(data.data(), (int)data.size(), MPI_DOUBLE, r, DATA_TAG, MPI_COMM_WORLD,
+                 MPI_STATUS_IGNORE);
+
+        file.write_variable(variable_name, start, count, data.data());
+      }
+      break;
+    }
+    case SYNC_FILE: {
+      std::string file_name = info["file_name"];
+      if (state.files[file_name] != nullptr) {
+        state.files[file_name]->sync();
+      }
+      break;
+    }
+    case CLOSE_FILE: {
+      std::string file_name = info["file_name"];
+      if (state.files[file_name] != nullptr) {
+        state.files[file_name]->close();
+      }
+      state.files.erase(file_name);
+      break;
+    }
+    case FINISH: {
+      // files are closed by File destructors
+      return;
+    }
+    default:
+      throw RuntimeError::formatted(PISM_ERROR_LOCATION,
+                                    "output server received an unknown action (%d)", action);
+    }
+  }
+}
+
+void run_output_server() {
+  try {
+    server_loop();
+  } catch (...) {
+    handle_fatal_errors(MPI_COMM_SELF);
+    // A dead server rank would make computational ranks hang; take the whole run down
+    // instead.
+    MPI_Abort(MPI_COMM_WORLD, 1);
+  }
+}
+
+} // namespace io
+} // namespace pism
@@ -0,0 +1,113 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef PISM_OUTPUT_SERVER_H
+#define PISM_OUTPUT_SERVER_H
+
+#include <mpi.h>
+#include <string>
+
+namespace pism {
+namespace io {
+
+/*! @file Generic (MPI-only) output server.
+ *
+ * The command-line option "-io_server N" reserves the last N ranks of MPI_COMM_WORLD as
+ * "I/O server" ranks: they receive field data from "computational" ranks via asynchronous
+ * sends and perform all file writes, so computational ranks never touch the filesystem.
+ * Output files are distributed among server ranks; each server rank writes "its" files
+ * serially.
+ *
+ * This is similar to the YAC-based output server (see YacOutputWriter), but does not
+ * require YAC, an MPMD launch, or a separate server executable: server ranks run a
+ * receive loop (run_output_server()) inside the `pism` executable itself.
+ *
+ * See ServerOutputWriter for the client (compute rank) side.
+ */
+
+//! Actions performed by the output server. A client requests an action by sending a JSON
+//! message `{"action": <action>, "info": {...}}` to the server rank owning the output
+//! file.
+enum ServerAction : int {
+  CONFIGURE = 1,        //!< set the I/O backend, compression level, etc
+  APPEND_FILE = 2,      //!< open an existing file for appending and report its time info
+  DEFINE_DIMENSION = 3, //!< define a dimension
+  DEFINE_VARIABLE = 4,  //!< define a variable and write its attributes
+  SET_FILE_ATTRIBUTES = 5, //!< write global attributes
+  APPEND_HISTORY = 6,   //!< append to the "history" global attribute
+  WRITE_VARIABLE = 7,   //!< write data held by the compute leader (scalars, coordinates)
+  WRITE_GRIDDED = 8,    //!< write a distributed array (one patch per compute rank)
+  SYNC_FILE = 9,        //!< flush a file to disk
+  CLOSE_FILE = 10,      //!< close a file
+  FINISH = 11           //!< close all files and stop the server loop
+};
+
+//! Tag of JSON action messages and of server replies.
+const int ACTION_TAG = 0;
+//! Tag of messages containing variable data (and patch start/count headers).
+const int DATA_TAG = 1;
+
+/*!
+ * Reserve the last `n_ranks` ranks of MPI_COMM_WORLD for the output server and split
+ * MPI_COMM_WORLD into "computational" and "server" parts.
+ *
+ * Called by pism::initialize() *before* PETSc initialization (PETSC_COMM_WORLD is set to
+ * the communicator returned by output_server_local_comm()).
+ */
+void output_server_init(int n_ranks);
+
+//! De-allocate resources allocated by output_server_init(). Called by pism::finalize().
+void output_server_finalize();
+
+//! True if output server ranks were reserved using output_server_init().
+bool output_server_enabled();
+
+//! True if the current MPI process is an output server rank.
+bool is_output_server_rank();
+
+//! Number of reserved output server ranks (zero if the server is not enabled).
+int output_server_size();
+
+/*!
+ * The part of MPI_COMM_WORLD the current rank belongs to: the communicator of
+ * computational ranks on computational ranks and the communicator of server ranks on
+ * server ranks.
+ */
+MPI_Comm output_server_local_comm();
+
+/*!
+ * Rank (in MPI_COMM_WORLD) of the server responsible for the file `file_name`.
+ *
+ * Files are distributed among server ranks using a hash of the file name, so all ranks
+ * agree on the owner of a file without communication.
+ */
+int output_server_rank(const std::string &file_name);
+
+/*!
+ * Receive and perform output requests until all clients are done (the FINISH action).
+ *
+ * Called on server ranks (and only on server ranks) instead of setting up and running the
+ * model.
+ */
+void run_output_server();
+
+} // namespace io
+} // namespace pism
+
+#endif /* PISM_OUTPUT_SERVER_H */
@@ -23,6 +23,7 @@
 #include "pism/util/array/Scalar.hh"
 #include "pism/util/Grid.hh"
 #include "pism/util/error_handling.hh"
+#include "pism/util/pism_utilities.hh"
 
 namespace pism {
 
@@ -62,32 +63,112 @@ Cell layout:
 void compute_node_types(const array::Scalar1 &ice_thickness,
                         double thickness_threshold,
                         array::Scalar &result) {
+  std::vector<char> icy_flags;
+  compute_node_types(ice_thickness, thickness_threshold, result, icy_flags);
+}
+
+/**
+   Incremental version of compute_node_types().
+
+   `icy_flags` is a cache owned by the caller and holds the "icy" flag of every node
+   (including width=1 ghosts) from the previous call; pass an empty vector to force a full
+   classification. On every call the flags are re-computed from `ice_thickness` and
+   compared to the cached values:
+
+   - if no flag changed on any rank, `result` is up to date and the call returns without
+     touching it (and without the ghost update);
+
+   - otherwise only the nodes with a changed flag somewhere in their box stencil are
+     reclassified, so the cost of the classification is proportional to the length of the
+     moving ice margin, not to the domain size.
+
+   This relies on `result` keeping its values between calls: do not modify it elsewhere.
+ */
+void compute_node_types(const array::Scalar1 &ice_thickness,
+                        double thickness_threshold,
+                        array::Scalar &result,
+                        std::vector<char> &icy_flags) {
 
   auto grid = ice_thickness.grid();
 
   const double &H_min = thickness_threshold;
 
+  // extent of the local subdomain in index space, including width=1 ghosts
+  const int
+    x_first = grid->xs() - 1,
+    y_first = grid->ys() - 1,
+    nx      = grid->xm() + 2,
+    ny      = grid->ym() + 2;
+
+  auto flag_index = [x_first, y_first, nx](int i, int j) {
+    return (j - y_first) * nx + (i - x_first);
+  };
+
+  const bool have_old_flags = ((int)icy_flags.size() == nx * ny);
+
+  std::vector<char> old_flags;
+  if (have_old_flags) {
+    old_flags.swap(icy_flags);
+  }
+  icy_flags.resize((size_t)nx * ny);
+
   array::AccessScope list{&ice_thickness, &result};
 
+  // Re-compute icy flags of all the nodes, including ghosts, and detect changes. Ghosts
+  // of ice_thickness are assumed to be up to date, so every rank sees changes affecting
+  // the nodes it owns.
+  int flags_changed = 0;
+  for (auto p : grid->points_with_ghosts(1)) {
+    const int i = p.i(), j = p.j(), k = flag_index(i, j);
+
+    char flag = static_cast<char>(ice_thickness(i, j) >= H_min);
+
+    icy_flags[k] = flag;
+    if (not have_old_flags or old_flags[k] != flag) {
+      flags_changed = 1;
+    }
+  }
+
+  if (GlobalMax(grid->com, flags_changed) == 0) {
+    // The icy pattern did not change anywhere: node types (and their ghosts) are up to
+    // date.
+    return;
+  }
+
   ParallelSection loop(grid->com);
   try {
     for (auto p : grid->points()) {
       const int i = p.i(), j = p.j();
 
-      auto H = ice_thickness.box(i, j);
+      if (have_old_flags) {
+        // the node type depends on the icy flags in the box stencil only: skip nodes with
+        // no changes there
+        bool box_changed = false;
+        for (int jj = j - 1; jj <= j + 1; ++jj) {
+          for (int ii = i - 1; ii <= i + 1; ++ii) {
+            const int k = flag_index(ii, jj);
+            if (old_flags[k] != icy_flags[k]) {
+              box_changed = true;
+            }
+          }
+        }
+        if (not box_changed) {
+          continue;
+        }
+      }
 
       // flags indicating whether the current node and its neighbors are "icy"
       stencils::Box<int> icy;
 
-      icy.c  = static_cast<int>(H.c >= H_min);
-      icy.nw = static_cast<int>(H.nw >= H_min);
-      icy.n  = static_cast<int>(H.n  >= H_min);
-      icy.ne = static_cast<int>(H.ne >= H_min);
-      icy.e  = static_cast<int>(H.e  >= H_min);
-      icy.se = static_cast<int>(H.se >= H_min);
-      icy.s  = static_cast<int>(H.s  >= H_min);
-      icy.sw = static_cast<int>(H.sw >= H_min);
-      icy.w  = static_cast<int>(H.w  >= H_min);
+      icy.c  = icy_flags[flag_index(i, j)];
+      icy.nw = icy_flags[flag_index(i - 1, j + 1)];
+      icy.n  = icy_flags[flag_index(i, j + 1)];
+      icy.ne = icy_flags[flag_index(i + 1, j + 1)];
+      icy.e  = icy_flags[flag_index(i + 1, j)];
+      icy.se = icy_flags[flag_index(i + 1, j - 1)];
+      icy.s  = icy_flags[flag_index(i, j - 1)];
+      icy.sw = icy_flags[flag_index(i - 1, j - 1)];
+      icy.w  = icy_flags[flag_index(i - 1, j)];
 
       // flags indicating whether neighboring elements are "icy" (an element is icy if at
       // least three of its nodes are icy)
@@ -20,6 +20,8 @@
 #ifndef _NODE_TYPES_H_
 #define _NODE_TYPES_H_
 
+#include <vector>
+
 namespace pism {
 
 //! Node types (in the map plane). These are used to implement boundary conditions in the Q1 FEM
@@ -45,6 +47,11 @@ void compute_node_types(const array::Scalar1 &ice_thickness,
                         double thickness_threshold,
                         array::Scalar &result);
 
+void compute_node_types(const array::Scalar1 &ice_thickness,
+                        double thickness_threshold,
+                        array::Scalar &result,
+                        std::vector<char> &icy_flags);
+
 } // end of namespace pism
 
 
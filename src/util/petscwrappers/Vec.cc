@@ -125,6 +125,20 @@ TemporaryGlobalVec::~TemporaryGlobalVec() {
   }
 }
 
+TemporaryLocalVec::TemporaryLocalVec(std::shared_ptr<DM> dm) {
+  m_dm = dm;
+  PetscErrorCode ierr = DMGetLocalVector(*m_dm, &m_value);
+  PISM_CHK(ierr, "DMGetLocalVector");
+}
+
+TemporaryLocalVec::~TemporaryLocalVec() {
+  // See ~TemporaryGlobalVec() above.
+  if (m_value != NULL) {
+    PetscErrorCode ierr = DMRestoreLocalVector(*m_dm, &m_value); CHKERRCONTINUE(ierr);
+    m_value = NULL;
+  }
+}
+
 
 } // end of namespace petsc
 } // end of namespace pism
@@ -100,6 +100,14 @@ private:
   std::shared_ptr<DM> m_dm;
 };
 
+class TemporaryLocalVec : public Vec {
+public:
+  TemporaryLocalVec(std::shared_ptr<DM> dm);
+  ~TemporaryLocalVec();
+private:
+  std::shared_ptr<DM> m_dm;
+};
+
 } // end of namespace petsc
 } // end of namespace pism
 
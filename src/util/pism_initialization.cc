@@ -17,12 +17,15 @@
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <cstdlib> // atoi
+#include <cstring> // strcmp
 #include <mpi.h>
 #include <petscsys.h>
 
 #include "pism/util/pism_initialization.hh"
 
 #include "pism/util/error_handling.hh"
+#include "pism/util/io/output_server.hh"
 
 #if (Pism_USE_YAC == 1)
 #include "pism/util/yaxt_wrapper.h"
@@ -58,7 +61,12 @@ void initialize(int argc, char **argv, const char *help) {
     MPI_Initialized(&flag);
 
     if (flag == 0) {
-      MPI_Init(&argc, &argv);
+      // Request support for calling MPI from multiple threads: this is required by the
+      // threaded output writer (see output.threaded_writer.enabled). An MPI library is
+      // free to provide a lower level of thread support; ThreadedOutputWriter checks the
+      // provided level at run time.
+      int provided = 0;
+      MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
       s_pism_finalize_mpi = true;
     } else {
       s_pism_finalize_mpi = false;
@@ -71,6 +79,31 @@ void initialize(int argc, char **argv, const char *help) {
     PISM_CHK(ierr, "PetscInitialized");
   }
 
+  // Reserve MPI ranks for the generic output server, if requested.
+  //
+  // This has to happen *before* PETSc initialization so that PETSC_COMM_WORLD can be set
+  // to the sub-communicator excluding server ranks. We cannot use the usual option
+  // processing mechanism here (it requires an initialized PETSc), so we scan argv "by
+  // hand".
+  {
+    int n_io_ranks = 0;
+    for (int j = 1; j < argc; ++j) {
+      if (strcmp(argv[j], "-io_server") == 0 and j + 1 < argc) {
+        n_io_ranks = atoi(argv[j + 1]);
+      }
+    }
+
+    if (n_io_ranks > 0) {
+      io::output_server_init(n_io_ranks);
+
+      // make sure we don't mess with PETSC_COMM_WORLD if someone else initialized PETSc
+      // already:
+      if (petsc_initialized == PETSC_FALSE) {
+        PETSC_COMM_WORLD = io::output_server_local_comm();
+      }
+    }
+  }
+
 
 #if (Pism_USE_YAC == 1)
   // YAXT
@@ -173,6 +206,9 @@ void finalize() {
   }
 #endif
 
+  // output server
+  io::output_server_finalize();
+
   // MPI
   if (s_pism_finalize_mpi) {
     MPI_Finalize();
@@ -234,6 +234,115 @@ double GlobalSum(MPI_Comm comm, double local) {
   return result;
 }
 
+void ReductionBatch::sum(double *value) {
+  m_sum.push_back(value);
+}
+
+void ReductionBatch::min(double *value) {
+  m_min.push_back(value);
+}
+
+void ReductionBatch::max(double *value) {
+  m_max.push_back(value);
+}
+
+//! Reduce `count` doubles in place, either with one flat all-reduce or (if
+//! `hierarchical` is set) with a reduction within each node followed by one inter-node
+//! all-reduce and a broadcast within each node.
+static void reduce_in_place(MPI_Comm com, MPI_Comm inter_node, bool hierarchical,
+                            double *data, int count, MPI_Op op) {
+  int err = 0;
+
+  if (not hierarchical) {
+    err = MPI_Allreduce(MPI_IN_PLACE, data, count, MPI_DOUBLE, op, com);
+    PISM_C_CHK(err, 0, "MPI_Allreduce");
+    return;
+  }
+
+  // Here `com` contains the ranks sharing a compute node and `inter_node` one rank per
+  // node (MPI_COMM_NULL on the others).
+
+  int node_size = 0, node_rank = 0;
+  MPI_Comm_size(com, &node_size);
+  MPI_Comm_rank(com, &node_rank);
+
+  if (node_size == 1) {
+    // one rank per node: `inter_node` contains all ranks
+    err = MPI_Allreduce(MPI_IN_PLACE, data, count, MPI_DOUBLE, op, inter_node);
+    PISM_C_CHK(err, 0, "MPI_Allreduce");
+    return;
+  }
+
+  // combine contributions of the ranks sharing a node...
+  if (node_rank == 0) {
+    err = MPI_Reduce(MPI_IN_PLACE, data, count, MPI_DOUBLE, op, 0, com);
+  } else {
+    err = MPI_Reduce(data, NULL, count, MPI_DOUBLE, op, 0, com);
+  }
+  PISM_C_CHK(err, 0, "MPI_Reduce");
+
+  // ...then combine per-node results...
+  if (inter_node != MPI_COMM_NULL) {
+    err = MPI_Allreduce(MPI_IN_PLACE, data, count, MPI_DOUBLE, op, inter_node);
+    PISM_C_CHK(err, 0, "MPI_Allreduce");
+  }
+
+  // ...and give every rank of a node the result.
+  err = MPI_Bcast(data, count, MPI_DOUBLE, 0, com);
+  PISM_C_CHK(err, 0, "MPI_Bcast");
+}
+
+void ReductionBatch::reduce(MPI_Comm com) {
+  reduce_impl(com, MPI_COMM_NULL, false);
+}
+
+void ReductionBatch::reduce(MPI_Comm intra_node, MPI_Comm inter_node) {
+  reduce_impl(intra_node, inter_node, true);
+}
+
+void ReductionBatch::reduce_impl(MPI_Comm com, MPI_Comm inter_node, bool hierarchical) {
+  if (not m_sum.empty()) {
+    std::vector<double> values(m_sum.size());
+
+    for (size_t k = 0; k < m_sum.size(); ++k) {
+      values[k] = *m_sum[k];
+    }
+
+    reduce_in_place(com, inter_node, hierarchical, values.data(), (int)values.size(), MPI_SUM);
+
+    for (size_t k = 0; k < m_sum.size(); ++k) {
+      *m_sum[k] = values[k];
+    }
+  }
+
+  if (not (m_min.empty() and m_max.empty())) {
+    // minima and maxima share one reduction: max(x) = -min(-x)
+    std::vector<double> values;
+    values.reserve(m_min.size() + m_max.size());
+
+    for (auto *value : m_min) {
+      values.push_back(*value);
+    }
+    for (auto *value : m_max) {
+      values.push_back(-*value);
+    }
+
+    reduce_in_place(com, inter_node, hierarchical, values.data(), (int)values.size(), MPI_MIN);
+
+    size_t k = 0;
+    for (auto *value : m_min) {
+      *value = values[k++];
+    }
+    for (auto *value : m_max) {
+      *value = -values[k++];
+    }
+  }
+
+  m_sum.clear();
+  m_min.clear();
+  m_max.clear();
+}
+
 static const int TEMPORARY_STRING_LENGTH = 32768;
 
 std::string version() {
@@ -149,6 +149,54 @@ unsigned int GlobalSum(MPI_Comm comm, unsigned int input);
 
 int GlobalSum(MPI_Comm comm, int input);
 
+//! A batch of global reductions performed together.
+/*!
+  Each GlobalSum() (etc) call issues its own MPI_Allreduce() and one model step performs
+  dozens, paying per-message latency every time. Code that needs several reductions at
+  the same synchronization point should register values in a batch and call reduce()
+  once instead:
+
+  @code
+  ReductionBatch batch;
+  batch.sum(&total);
+  batch.max(&speed);
+  batch.min(&dt);
+  batch.reduce(com);            // total, speed, dt now hold global values
+  @endcode
+
+  reduce() replaces registered values with reduction results (and clears the batch, so a
+  batch can be re-used). Sums are combined into one MPI_Allreduce(); minima and maxima
+  are combined into another one (using max(x) = -min(-x)), so a batch costs at most two
+  messages. Registered pointers have to remain valid until the reduce() call.
+*/
+class ReductionBatch {
+public:
+  //! Register a value to be summed over all ranks.
+  void sum(double *value);
+  //! Register a value to be replaced by its minimum over all ranks.
+  void min(double *value);
+  //! Register a value to be replaced by its maximum over all ranks.
+  void max(double *value);
+
+  //! Perform registered reductions in place and clear the batch.
+  void reduce(MPI_Comm com);
+
+  //! Hierarchical version of reduce(): reduce within each compute node first, then
+  //! perform one all-reduce among the nodes and broadcast the result within each node.
+  /*!
+    At large rank counts this replaces a machine-wide all-reduce (latency grows with the
+    number of ranks) by one involving one rank per node. `intra_node` has to contain the
+    ranks sharing a node and `inter_node` one rank per node (`MPI_COMM_NULL` on the
+    others); see Context::com_intra_node() and Context::com_inter_node().
+  */
+  void reduce(MPI_Comm intra_node, MPI_Comm inter_node);
+
+private:
+  void reduce_impl(MPI_Comm com, MPI_Comm inter_node, bool hierarchical);
+
+  std::vector<double*> m_sum, m_min, m_max;
+};
+
 std::string version();
 
 //! return NetCDF version as an integer
@@ -399,37 +399,48 @@ void compute_cell_areas(const std::string &projection, array::Scalar &result) {
 // +-----------+
 // (sw)        (se)
 
-  double dx2 = 0.5 * grid->dx(), dy2 = 0.5 * grid->dy();
-
-  array::AccessScope list(result);
-
-  for (auto p : grid->points()) {
-    const int i = p.i(), j = p.j();
-
-    const double
-      x = grid->x(i),
-      y = grid->y(j);
-    double
-      x_nw = x - dx2, y_nw = y + dy2,
-      x_ne = x + dx2, y_ne = y + dy2,
-      x_se = x + dx2, y_se = y - dy2,
-      x_sw = x - dx2, y_sw = y - dy2;
+  const int xs = grid->xs(), xm = grid->xm(), ys = grid->ys(), ym = grid->ym();
 
-    PJ_COORD out;
+  double dx2 = 0.5 * grid->dx(), dy2 = 0.5 * grid->dy();
 
-    out = proj_trans(pism_to_geocent, PJ_FWD, proj_coord(x_nw, y_nw, 0, 0));
-    double nw[3] = {out.xyz.x, out.xyz.y, out.xyz.z};
+  // Gather coordinates of all four cell corners for the owned part of the grid and
+  // transform them with one PROJ call instead of a call per corner. (Per-point
+  // proj_trans() calls dominate the cost of this computation on large grids.)
+  const size_t N = (size_t)xm * ym * 4;
+  std::vector<double> x(N), y(N), z(N, 0.0);
+  {
+    size_t k = 0;
+    for (int j = ys; j < ys + ym; ++j) {
+      for (int i = xs; i < xs + xm; ++i, k += 4) {
+        const double x0 = grid->x(i), y0 = grid->y(j);
+
+        // nw, ne, se, sw
+        x[k + 0] = x0 - dx2; y[k + 0] = y0 + dy2;
+        x[k + 1] = x0 + dx2; y[k + 1] = y0 + dy2;
+        x[k + 2] = x0 + dx2; y[k + 2] = y0 - dy2;
+        x[k + 3] = x0 - dx2; y[k + 3] = y0 - dy2;
+      }
+    }
+  }
 
-    out = proj_trans(pism_to_geocent, PJ_FWD, proj_coord(x_ne, y_ne, 0, 0));
-    double ne[3] = {out.xyz.x, out.xyz.y, out.xyz.z};
+  proj_trans_generic(pism_to_geocent, PJ_FWD,
+                     x.data(), sizeof(double), N,
+                     y.data(), sizeof(double), N,
+                     z.data(), sizeof(double), N,
+                     NULL, 0, 0);
 
-    out = proj_trans(pism_to_geocent, PJ_FWD, proj_coord(x_se, y_se, 0, 0));
-    double se[3] = {out.xyz.x, out.xyz.y, out.xyz.z};
+  array::AccessScope list(result);
 
-    out = proj_trans(pism_to_geocent, PJ_FWD, proj_coord(x_sw, y_sw, 0, 0));
-    double sw[3] = {out.xyz.x, out.xyz.y, out.xyz.z};
+  size_t k = 0;
+  for (int j = ys; j < ys + ym; ++j) {
+    for (int i = xs; i < xs + xm; ++i, k += 4) {
+      double nw[3] = {x[k + 0], y[k + 0], z[k + 0]};
+      double ne[3] = {x[k + 1], y[k + 1], z[k + 1]};
+      double se[3] = {x[k + 2], y[k + 2], z[k + 2]};
+      double sw[3] = {x[k + 3], y[k + 3], z[k + 3]};
 
-    result(i, j) = triangle_area(sw, se, ne) + triangle_area(ne, nw, sw);
+      result(i, j) = triangle_area(sw, se, ne) + triangle_area(ne, nw, sw);
+    }
   }
 }
 
@@ -438,32 +449,40 @@ static void compute_lon_lat(const std::string &projection,
 
   Proj crs(projection, "EPSG:4326");
 
-// Cell layout:
-// (nw)        (ne)
-// +-----------+
-// |           |
-// |           |
-// |     o     |
-// |           |
-// |           |
-// +-----------+
-// (sw)        (se)
-
   auto grid = result.grid();
 
-  array::AccessScope list{&result};
+  const int xs = grid->xs(), xm = grid->xm(), ys = grid->ys(), ym = grid->ym();
+
+  // Gather coordinates of the owned part of the grid and transform them with one PROJ
+  // call instead of a call per point. The transformation is normalized for
+  // visualization (see the Proj wrapper), so after the call `x` holds longitudes and
+  // `y` holds latitudes.
+  const size_t N = (size_t)xm * ym;
+  std::vector<double> x(N), y(N);
+  {
+    size_t k = 0;
+    for (int j = ys; j < ys + ym; ++j) {
+      for (int i = xs; i < xs + xm; ++i, ++k) {
+        x[k] = grid->x(i);
+        y[k] = grid->y(j);
+      }
+    }
+  }
+
+  proj_trans_generic(crs, PJ_FWD,
+                     x.data(), sizeof(double), N,
+                     y.data(), sizeof(double), N,
+                     NULL, 0, 0,
+                     NULL, 0, 0);
 
-  for (auto p : grid->points()) {
-    const int i = p.i(), j = p.j();
+  const std::vector<double> &values = (which == LONGITUDE) ? x : y;
 
-    PJ_COORD out = proj_trans(crs, PJ_FWD, proj_coord(grid->x(i), grid->y(j), 0, 0));
+  array::AccessScope list{&result};
 
-    if (which == LONGITUDE) {
-      // longitude: lambda
-      result(i, j) = out.lp.lam;
-    } else {
-      // latitude: phi
-      result(i, j) = out.lp.phi;
+  size_t k = 0;
+  for (int j = ys; j < ys + ym; ++j) {
+    for (int i = xs; i < xs + xm; ++i, ++k) {
+      result(i, j) = values[k];
     }
   }
 }
@@ -476,32 +495,48 @@ static void compute_lon_lat_bounds(const std::string &projection,
 
   auto grid = result.grid();
 
+  const int xs = grid->xs(), xm = grid->xm(), ys = grid->ys(), ym = grid->ym();
+
   double dx2 = 0.5 * grid->dx(), dy2 = 0.5 * grid->dy();
   double x_offsets[] = {-dx2, dx2, dx2, -dx2};
   double y_offsets[] = {-dy2, -dy2, dy2, dy2};
 
-  array::AccessScope list{&result};
-
-  for (auto p : grid->points()) {
-    const int i = p.i(), j = p.j();
-
-    double x0 = grid->x(i), y0 = grid->y(j);
+  // Gather coordinates of all four cell corners for the owned part of the grid and
+  // transform them with one PROJ call instead of a call per corner; see
+  // compute_lon_lat() above.
+  const size_t N = (size_t)xm * ym * 4;
+  std::vector<double> x(N), y(N);
+  {
+    size_t n = 0;
+    for (int j = ys; j < ys + ym; ++j) {
+      for (int i = xs; i < xs + xm; ++i) {
+        const double x0 = grid->x(i), y0 = grid->y(j);
+
+        for (int k = 0; k < 4; ++k, ++n) {
+          x[n] = x0 + x_offsets[k];
+          y[n] = y0 + y_offsets[k];
+        }
+      }
+    }
+  }
 
-    double *values = result.get_column(i, j);
+  proj_trans_generic(crs, PJ_FWD,
+                     x.data(), sizeof(double), N,
+                     y.data(), sizeof(double), N,
+                     NULL, 0, 0,
+                     NULL, 0, 0);
 
-    for (int k = 0; k < 4; ++k) {
+  const std::vector<double> &coords = (which == LONGITUDE) ? x : y;
 
-      PJ_COORD out;
+  array::AccessScope list{&result};
 
-      // compute lon,lat coordinates:
-      out = proj_trans(crs, PJ_FWD, proj_coord(x0 + x_offsets[k], y0 + y_offsets[k], 0, 0));
+  size_t n = 0;
+  for (int j = ys; j < ys + ym; ++j) {
+    for (int i = xs; i < xs + xm; ++i, n += 4) {
+      double *values = result.get_column(i, j);
 
-      if (which == LONGITUDE) {
-        // longitude: lambda
-        values[k] = out.lp.lam;
-      } else {
-        // latitude: phi
-        values[k] = out.lp.phi;
+      for (int k = 0; k < 4; ++k) {
+        values[k] = coords[n + k];
       }
     }
   }
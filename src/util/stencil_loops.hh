@@ -0,0 +1,97 @@
+/* Copyright (C) 2026 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef PISM_STENCIL_LOOPS_HH
+#define PISM_STENCIL_LOOPS_HH
+
+#include <utility>              // std::forward
+
+#include "pism/util/Grid.hh"
+
+namespace pism {
+namespace stencils {
+
+namespace details {
+
+// C++11 replacement for a fold expression: apply every kernel at (i, j), in the order
+// the kernels were passed to fused_pass().
+template <typename Kernel>
+inline void apply_all(int i, int j, Kernel &&kernel) {
+  kernel(i, j);
+}
+
+template <typename Kernel, typename... Rest>
+inline void apply_all(int i, int j, Kernel &&kernel, Rest &&...rest) {
+  kernel(i, j);
+  apply_all(i, j, std::forward<Rest>(rest)...);
+}
+
+} // end of namespace details
+
+/*!
+ * Run one or more per-cell kernels over the grid in a single cache-blocked sweep.
+ *
+ * Each kernel is a callable taking grid indices `(int i, int j)`; kernels typically
+ * capture the fields they read and write. All kernels are applied at a grid point
+ * before the sweep moves on to the next point, so values a kernel loads (or stores)
+ * are still cache-resident when the kernels following it run -- several logically
+ * separate passes over the same fields cost one traversal of memory instead of one
+ * each. The traversal order is the one of Grid::tiled_points(), i.e. owned points
+ * plus `stencil_width` rows of ghosts, visited tile by tile.
+ *
+ * Usage:
+ *
+ * \code
+ * array::AccessScope scope{ &a, &b, &c };
+ *
+ * stencils::fused_pass(*grid, 0,
+ *                      [&](int i, int j) { b(i, j) = f(a.star(i, j)); },
+ *                      [&](int i, int j) { c(i, j) = g(a(i, j), b(i, j)); });
+ * \endcode
+ *
+ * Requirements and limitations:
+ *
+ * - The caller manages ghosts and access (array::AccessScope), exactly as with a
+ *   hand-written loop: inputs need enough ghosts for the widest stencil used by any
+ *   kernel, and a kernel reading a *neighbor* of a value written by an earlier kernel
+ *   in the same call would see a mix of old and new values -- such passes must stay
+ *   separate (with a ghost update in between).
+ *
+ * - Kernels must be independent across grid points. Sweeps with loop-carried
+ *   dependencies (e.g. accumulation along a row) cannot use the tiled traversal; see
+ *   TiledGridPoints.
+ *
+ * - Kernels computing global reductions should accumulate into captured local
+ *   variables; perform the (collective) reduction after the sweep.
+ *
+ * Hand-fused sweeps whose stages share intermediate values at a point (e.g.
+ * Routing::compute_fluxes()) cannot be split into independent kernels without
+ * recomputing those values; they are better left as explicit loops.
+ */
+template <typename... Kernels>
+void fused_pass(const Grid &grid, unsigned int stencil_width, Kernels &&...kernels) {
+  for (auto p : grid.tiled_points(stencil_width)) {
+    details::apply_all(p.i(), p.j(), std::forward<Kernels>(kernels)...);
+  }
+}
+
+} // end of namespace stencils
+} // end of namespace pism
+
+#endif /* PISM_STENCIL_LOOPS_HH */
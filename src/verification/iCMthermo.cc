@@ -17,6 +17,7 @@
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include <cmath>
+#include <map>
 
 #include "pism/verification/tests/exactTestsFG.hh"
 #include "pism/verification/tests/exactTestK.h"
@@ -82,14 +83,18 @@ void IceCompModel::energy_step(double t, double dt) {
   }
 
   if ((m_testname == 'F') || (m_testname == 'G')) {
-    // Compute compensatory strain heating (fills strain_heating3_comp).
+    // Compute compensatory strain heating (fills strain_heating3_comp). In test F the
+    // compensatory sources are time-independent, so this is a no-op after the first
+    // step.
     getCompSourcesTestFG();
 
-    // Add computed strain heating to the compensatory part.
-    m_strain_heating3_comp.add(1.0, *inputs.volumetric_heating_rate);
+    // Add computed strain heating to the compensatory part, using separate storage so
+    // that strain_heating3_comp remains valid for the next step.
+    m_strain_heating3_sum.copy_from(m_strain_heating3_comp);
+    m_strain_heating3_sum.add(1.0, *inputs.volumetric_heating_rate);
 
     // Use the result.
-    inputs.volumetric_heating_rate = &m_strain_heating3_comp;
+    inputs.volumetric_heating_rate = &m_strain_heating3_sum;
   }
 
   m_energy_model->update(t, dt, inputs);
@@ -104,6 +109,9 @@ void IceCompModel::initTestFG() {
   const double time = m_testname == 'F' ? 0.0 : m_time->current();
   const double A    = m_testname == 'F' ? 0.0 : m_ApforG;
 
+  // see the discussion of this cache in getCompSourcesTestFG()
+  std::map<double, double> thickness_cache;
+
   for (auto p : m_grid->points()) {
     const int i = p.i(), j = p.j();
 
@@ -113,7 +121,11 @@ void IceCompModel::initTestFG() {
     if (r > m_LforFG - 1.0) { // if (essentially) outside of sheet
       m_geometry.ice_thickness(i, j) = 0.0;
     } else {
-      m_geometry.ice_thickness(i, j) = exactFG(time, r, m_grid->z(), A).H;
+      auto it = thickness_cache.find(r);
+      if (it == thickness_cache.end()) {
+        it = thickness_cache.emplace(r, exactFG(time, r, m_grid->z(), A).H).first;
+      }
+      m_geometry.ice_thickness(i, j) = it->second;
     }
   }
 
@@ -153,6 +165,11 @@ void IceCompModel::initTestsKO() {
 
 void IceCompModel::getCompSourcesTestFG() {
 
+  if (m_testname == 'F' and m_comp_sources_computed) {
+    // Test F is steady: strain_heating3_comp still holds the correct values.
+    return;
+  }
+
   const double
     ice_rho   = m_config->get_number("constants.ice.density"),
     ice_c     = m_config->get_number("constants.ice.specific_heat_capacity");
@@ -164,6 +181,12 @@ void IceCompModel::getCompSourcesTestFG() {
   const double time = m_testname == 'F' ? 0.0 : m_time->current();
   const double A    = m_testname == 'F' ? 0.0 : m_ApforG;
 
+  // The exact solution depends on the horizontal coordinates through the distance from
+  // the origin only, and the verification grids are symmetric about the origin, so cache
+  // evaluations by radius: typically only about one column in eight requires evaluating
+  // the special functions in exactFG().
+  std::map<double, TestFGParameters> cache;
+
   for (auto p : m_grid->points()) {
     const int i = p.i(), j = p.j();
 
@@ -172,7 +195,11 @@ void IceCompModel::getCompSourcesTestFG() {
     if (r > m_LforFG - 1.0) {  // outside of sheet
       m_strain_heating3_comp.set_column(i, j, 0.0);
     } else {
-      TestFGParameters P = exactFG(time, r, m_grid->z(), A);
+      auto it = cache.find(r);
+      if (it == cache.end()) {
+        it = cache.emplace(r, exactFG(time, r, m_grid->z(), A)).first;
+      }
+      const TestFGParameters &P = it->second;
 
       m_strain_heating3_comp.set_column(i, j, (P.Sigc).data());
     }
@@ -180,6 +207,8 @@ void IceCompModel::getCompSourcesTestFG() {
 
   // scale strain_heating to J/(s m^3)
   m_strain_heating3_comp.scale(ice_rho * ice_c);
+
+  m_comp_sources_computed = true;
 }
 
 void IceCompModel::computeTemperatureErrors(double &gmaxTerr,
@@ -62,6 +62,8 @@ IceCompModel::IceCompModel(std::shared_ptr<Grid> grid, std::shared_ptr<Context>
       m_testname(test),
       m_HexactL(m_grid, "HexactL"),
       m_strain_heating3_comp(m_grid, "strain_heating_comp", array::WITHOUT_GHOSTS, m_grid->z()),
+      m_strain_heating3_sum(m_grid, "strain_heating_sum", array::WITHOUT_GHOSTS, m_grid->z()),
+      m_comp_sources_computed(false),
       m_bedrock_is_ice_forK(false) {
 
   m_log->message(2, "starting Test %c ...\n", m_testname);
@@ -157,6 +159,10 @@ void IceCompModel::allocate_storage() {
   m_strain_heating3_comp.metadata(0)
       .long_name("rate of compensatory strain heating in ice")
       .units("W m^-3");
+
+  m_strain_heating3_sum.metadata(0)
+      .long_name("sum of modeled and compensatory strain heating in ice")
+      .units("W m^-3");
 }
 
 void IceCompModel::allocate_bedrock_thermal_unit() {
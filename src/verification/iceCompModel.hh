@@ -81,6 +81,12 @@ protected:
                                               double &gmaxWerr, double &gavWerr); // scalar errors
   
   array::Array3D m_strain_heating3_comp;
+  // Sum of modeled and compensatory strain heating, used as the energy model input in
+  // tests F and G. Separate storage keeps m_strain_heating3_comp intact between steps.
+  array::Array3D m_strain_heating3_sum;
+  // True if m_strain_heating3_comp is up to date. In test F the compensatory sources are
+  // time-independent, so they are computed once and re-used.
+  bool m_comp_sources_computed;
 
   // related to tests K and O; see iCMthermo.cc
   void initTestsKO();
@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+
+"""Performance regression checks for PISM.
+
+Runs the short scenarios described in scenarios.json, records per-stage
+timings from PISM's profiling subsystem (the Chrome trace written by
+-profile_trace) into JSON, and compares them to stored baselines, failing if
+any stage slowed down by more than the configured tolerance.
+
+This script is behind the 'perf-check' make target; see README.md in this
+directory for how to record baselines and provide input data for the
+scenarios that need it.
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+# Stages shorter than this (in seconds) are too noisy to compare.
+MINIMUM_STAGE_TIME = 0.5
+
+
+def stage_totals(trace_filename):
+    """Compute the total duration of each profiling stage (seconds) from a
+    Chrome trace-event file written by 'pism -profile_trace'.
+
+    A stack per stage name pairs each end event with the latest unmatched
+    begin event, handling nested and repeated stages."""
+    with open(trace_filename) as f:
+        events = json.load(f)
+
+    totals = {}
+    open_events = {}
+    for e in events:
+        name = e["name"]
+        t = e["ts"] * 1e-6      # microseconds to seconds
+        if e["ph"] == "B":
+            open_events.setdefault(name, []).append(t)
+        else:
+            stack = open_events.get(name)
+            if stack:
+                totals[name] = totals.get(name, 0.0) + (t - stack.pop())
+
+    return totals
+
+
+def run_scenario(name, scenario, args):
+    """Run one scenario and return its per-stage timings (or None if the
+    scenario was skipped because its input data is missing)."""
+    input_file = None
+    if "input" in scenario:
+        input_file = os.path.join(args.data_dir, scenario["input"])
+        if not os.path.exists(input_file):
+            print("{}: SKIPPED (input file '{}' not found; see README.md)".
+                  format(name, input_file))
+            return None
+
+    with tempfile.TemporaryDirectory(prefix="pism-perf-") as tmp:
+        trace_prefix = os.path.join(tmp, "trace")
+
+        command = []
+        if scenario.get("processes", 1) > 1:
+            command += [args.mpiexec, "-n", str(scenario["processes"])]
+        command += [args.pism]
+        if args.config is not None:
+            command += ["-config", args.config]
+        command += [option.replace("{input}", input_file or "")
+                    for option in scenario["options"]]
+        command += ["-o", os.path.join(tmp, "output.nc"),
+                    "-profile_trace", trace_prefix]
+
+        print("{}: running...".format(name))
+        start = time.time()
+        result = subprocess.run(command, stdout=subprocess.PIPE,
+                                stderr=subprocess.STDOUT)
+        wall_clock = time.time() - start
+
+        if result.returncode != 0:
+            sys.stdout.buffer.write(result.stdout)
+            raise RuntimeError("{}: PISM failed (exit code {})".
+                               format(name, result.returncode))
+
+        totals = stage_totals(trace_prefix + "-0000.json")
+        totals["wall_clock"] = wall_clock
+
+    return totals
+
+
+def compare(name, baseline, result, tolerance):
+    """Compare per-stage timings to the baseline. Returns the list of
+    regressions; prints a report."""
+    regressions = []
+
+    print("{}: stage timings (tolerance {:.0%}):".format(name, tolerance))
+    print("  {:30} {:>10} {:>10} {:>7}".format("stage", "baseline", "now", "ratio"))
+    for stage in sorted(baseline.keys()):
+        old = baseline[stage]
+        new = result.get(stage)
+        if new is None:
+            continue
+
+        ratio = new / old if old > 0 else float("inf")
+        flag = ""
+        if old >= MINIMUM_STAGE_TIME and new > old * (1.0 + tolerance):
+            regressions.append(stage)
+            flag = " REGRESSION"
+        print("  {:30} {:>9.2f}s {:>9.2f}s {:>6.2f}x{}".
+              format(stage, old, new, ratio, flag))
+
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--pism", default="pism",
+                        help="the PISM executable to benchmark")
+    parser.add_argument("--scenarios",
+                        default=os.path.join(os.path.dirname(__file__),
+                                             "scenarios.json"),
+                        help="JSON file describing scenarios")
+    parser.add_argument("--baselines",
+                        default=os.path.join(os.path.dirname(__file__),
+                                             "baselines"),
+                        help="directory containing baseline timings")
+    parser.add_argument("--config", default=None,
+                        help="PISM configuration file (pism_config.nc)")
+    parser.add_argument("--data-dir",
+                        default=os.environ.get("PISM_PERF_DATA", "."),
+                        help="directory containing scenario input files"
+                        " (default: $PISM_PERF_DATA or '.')")
+    parser.add_argument("--mpiexec", default="mpiexec",
+                        help="MPI launcher for multi-process scenarios")
+    parser.add_argument("--tolerance", type=float, default=None,
+                        help="override the per-scenario relative tolerance")
+    parser.add_argument("--output", default=None,
+                        help="save recorded timings to this JSON file")
+    parser.add_argument("--update-baselines", action="store_true",
+                        help="record timings as new baselines instead of comparing")
+    args = parser.parse_args()
+
+    with open(args.scenarios) as f:
+        scenarios = json.load(f)
+
+    all_results = {}
+    failures = []
+    for name, scenario in scenarios.items():
+        result = run_scenario(name, scenario, args)
+        if result is None:
+            continue
+        all_results[name] = result
+
+        baseline_file = os.path.join(args.baselines, name + ".json")
+
+        if args.update_baselines:
+            os.makedirs(args.baselines, exist_ok=True)
+            with open(baseline_file, "w") as f:
+                json.dump(result, f, indent=2, sort_keys=True)
+                f.write("\n")
+            print("{}: wrote baseline '{}'".format(name, baseline_file))
+            continue
+
+        if not os.path.exists(baseline_file):
+            print("{}: no baseline found; run with --update-baselines to record one".
+                  format(name))
+            continue
+
+        with open(baseline_file) as f:
+            baseline = json.load(f)
+
+        tolerance = args.tolerance
+        if tolerance is None:
+            tolerance = scenario.get("tolerance", 0.25)
+
+        regressions = compare(name, baseline, result, tolerance)
+        failures += ["{}: {}".format(name, stage) for stage in regressions]
+
+    if args.output is not None:
+        with open(args.output, "w") as f:
+            json.dump(all_results, f, indent=2, sort_keys=True)
+            f.write("\n")
+
+    if failures:
+        print("Performance regressions detected:")
+        for failure in failures:
+            print("  " + failure)
+        return 1
+
+    print("No performance regressions detected.")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())